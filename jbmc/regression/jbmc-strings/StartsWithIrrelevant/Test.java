@@ -0,0 +1,11 @@
+public class Test {
+  public static void check(String s, String t) {
+    if(s == null || t == null)
+      return;
+    boolean ignored = s.startsWith(t);
+    boolean prefix = t.startsWith(s);
+    if(prefix)
+      assert s.length() <= t.length();
+    assert !prefix;
+  }
+}
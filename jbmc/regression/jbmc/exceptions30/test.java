@@ -0,0 +1,29 @@
+class A extends RuntimeException {}
+class B extends A {}
+class C extends B {}
+class D extends A {}
+
+public class test {
+  public static void test(boolean unknown) {
+    B b = unknown ? new B() : new C();
+    try {
+      throw b;
+    } catch (D e) {
+      assert false;
+    } catch (C e) {
+      assert !unknown;
+    } catch (A e) {
+      assert unknown;
+    }
+
+    A a = unknown ? new B() : new D();
+    try {
+      throw a;
+    } catch (B e) {
+      assert unknown;
+    } catch (D e) {
+      assert !unknown;
+    }
+    assert false;
+  }
+}
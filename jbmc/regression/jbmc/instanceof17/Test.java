@@ -0,0 +1,26 @@
+public class Test {
+  public static void test(int choice) {
+    B b = choice == 0 ? new B() : choice == 1 ? new C() : new E();
+    D d = new D();
+    assert b instanceof A;
+    if (choice == 1)
+      assert b instanceof C;
+    else
+      assert !(b instanceof C);
+    if (choice == 0 || choice == 1)
+      assert !(b instanceof I);
+    else
+      assert b instanceof I;
+    assert !(d instanceof I);
+    B n = null;
+    assert !(n instanceof A);
+    assert b instanceof C;
+  }
+}
+
+class A {}
+class B extends A {}
+class C extends B {}
+class D extends A {}
+interface I {}
+class E extends B implements I {}
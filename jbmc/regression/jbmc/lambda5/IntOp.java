@@ -0,0 +1,3 @@
+public interface IntOp {
+  int apply(int x);
+}
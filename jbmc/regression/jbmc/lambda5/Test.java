@@ -0,0 +1,11 @@
+public class Test {
+  // Test.class was assembled by hand: both lambda expressions below use the
+  // same invokedynamic constant (bootstrap method and lambda$test$0), which
+  // javac does not emit for two separate expressions.
+  public static void test(int x) {
+    IntOp a = y -> y + 1;
+    IntOp b = y -> y + 1;
+    assert a.apply(x) == b.apply(x);
+    assert a.apply(x) != x + 1;
+  }
+}
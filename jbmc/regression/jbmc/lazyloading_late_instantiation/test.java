@@ -0,0 +1,20 @@
+class Base
+{
+  Base next() { return new Derived(); }
+  void f() { }
+}
+
+class Derived extends Base
+{
+  void f() { }
+}
+
+public class test {
+
+  public static void test(Base b) {
+    if(b != null) {
+      b.next().f();
+    }
+  }
+
+}
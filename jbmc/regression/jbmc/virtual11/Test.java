@@ -0,0 +1,23 @@
+class A {
+  int f() { return 1; }
+}
+class B extends A {
+  int f() { return 2; }
+}
+class C extends A {
+  int f() { return 3; }
+}
+class D extends C {
+  int f() { return super.f() + 1; }
+}
+
+public class Test {
+  public static void test(boolean unknown) {
+    A a = unknown ? new B() : new D();
+    int r = a.f();
+    if (unknown)
+      assert r == 2;
+    else
+      assert r == 4;
+  }
+}
@@ -12,6 +12,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "janalyzer_parse_options.h"
 
 #include <cstdlib> // exit()
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <memory>
@@ -48,6 +49,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/config.h>
 #include <util/exit_codes.h>
 #include <util/options.h>
+#include <util/string2int.h>
+#include <util/string_utils.h>
 #include <util/unicode.h>
 #include <util/version.h>
 
@@ -73,6 +76,20 @@ void janalyzer_parse_optionst::register_languages()
   register_language(new_java_bytecode_language);
 }
 
+/// Match \p identifier literally in a pattern of
+/// `--lazy-methods-extra-entry-point`
+static std::string escape_regex(const std::string &identifier)
+{
+  std::string result;
+  for(const char c : identifier)
+  {
+    if(std::strchr("\\^$.|?*+()[]{}", c) != nullptr)
+      result += '\\';
+    result += c;
+  }
+  return result;
+}
+
 void janalyzer_parse_optionst::get_command_line_options(optionst &options)
 {
   if(config.set(cmdline))
@@ -84,6 +101,14 @@ void janalyzer_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("function"))
     options.set_option("function", cmdline.get_value("function"));
 
+  // Only convert the methods that appear to be reachable, unless all methods
+  // are needed to tell which of them are not.
+  options.set_option(
+    "lazy-methods",
+    !cmdline.isset("no-lazy-methods") &&
+      !cmdline.isset("unreachable-instructions") &&
+      !cmdline.isset("unreachable-functions"));
+
   parse_java_language_options(cmdline, options);
 
   // check assertions
@@ -247,6 +272,28 @@ void janalyzer_parse_optionst::get_command_line_options(optionst &options)
       options.set_option("domain set", true);
     }
 
+    if(cmdline.isset("entry-points"))
+    {
+      const auto entry_points =
+        split_string(cmdline.get_value("entry-points"), ',', true, true);
+      options.set_option(
+        "entry-points",
+        optionst::value_listt(entry_points.begin(), entry_points.end()));
+
+      // make sure that lazy loading converts the entry points
+      auto extra_entry_points =
+        options.get_list_option("lazy-methods-extra-entry-point");
+      for(const auto &entry_point : entry_points)
+        extra_entry_points.push_back(escape_regex(entry_point));
+      options.set_option("lazy-methods-extra-entry-point", extra_entry_points);
+    }
+
+    if(cmdline.isset("parallel-analyses"))
+    {
+      options.set_option(
+        "parallel-analyses", cmdline.get_value("parallel-analyses"));
+    }
+
     // Reachability questions, when given with a domain swap from specific
     // to general tasks so that they can use the domain & parameterisations.
     if(reachability_task)
@@ -543,6 +590,19 @@ int janalyzer_parse_optionst::perform_analysis(const optionst &options)
       return CPROVER_EXIT_INTERNAL_ERROR;
     }
 
+    if(
+      options.is_set("entry-points") || options.is_set("parallel-analyses"))
+    {
+      if(!options.get_bool_option("verify"))
+      {
+        log.error() << "Entry points or parallel analyses are only supported "
+                    << "with --verify" << messaget::eom;
+        return CPROVER_EXIT_USAGE_ERROR;
+      }
+
+      return combined_verification(options, out);
+    }
+
     // Build analyzer
     log.status() << "Selecting abstract domain" << messaget::eom;
     namespacet ns(goto_model.symbol_table); // Must live as long as the domain.
@@ -608,6 +668,57 @@ int janalyzer_parse_optionst::perform_analysis(const optionst &options)
   return CPROVER_EXIT_USAGE_ERROR;
 }
 
+/// Check the assertions from each of the selected entry points, in several
+/// processes if requested, and report the combined results
+int janalyzer_parse_optionst::combined_verification(
+  const optionst &options,
+  std::ostream &out)
+{
+  // get_command_line_options selects exactly one domain
+  std::string domain;
+  for(const char *d :
+      {"constants", "dependence-graph", "intervals", "non-null"})
+  {
+    if(options.get_bool_option(d))
+    {
+      domain = d;
+      break;
+    }
+  }
+
+  std::vector<irep_idt> entry_points;
+  for(const auto &entry_point : options.get_list_option("entry-points"))
+    entry_points.push_back(entry_point);
+
+  const std::size_t parallel_analyses =
+    options.is_set("parallel-analyses")
+      ? safe_string2size_t(options.get_option("parallel-analyses"))
+      : 1;
+
+  const auto build = [&](const std::string &, const namespacet &ns) {
+    return std::unique_ptr<ai_baset>(build_analyzer(options, ns));
+  };
+
+  std::vector<static_verifier_resultt> results;
+  if(combined_static_verifier_results(
+       goto_model,
+       {domain},
+       entry_points,
+       parallel_analyses,
+       build,
+       ui_message_handler,
+       results))
+  {
+    return CPROVER_EXIT_USAGE_ERROR;
+  }
+
+  log.status() << "Performing task" << messaget::eom;
+
+  static_verifier_report(goto_model, results, options, ui_message_handler, out);
+
+  return CPROVER_EXIT_VERIFICATION_SAFE;
+}
+
 bool janalyzer_parse_optionst::process_goto_program(const optionst &options)
 {
   try
@@ -711,6 +822,12 @@ void janalyzer_parse_optionst::help()
     // NOLINTNEXTLINE(whitespace/line_length)
     " --location-sensitive         use location-sensitive abstract interpreter\n"
     " --concurrent                 use concurrency-aware abstract interpreter\n"
+    " --entry-points m,n,...       with --verify, analyze the program from\n"
+    "                              each of the given methods, named as by\n"
+    "                              --list-goto-functions, and combine the\n"
+    "                              results\n"
+    " --parallel-analyses n        with --verify, run the analyses for the\n"
+    "                              entry points in n processes\n"
     "\n"
     "Domain options:\n"
     " --constants                  constant domain\n"
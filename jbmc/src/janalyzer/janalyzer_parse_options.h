@@ -146,6 +146,7 @@ class optionst;
   "(dependence-graph)" \
   "(show)(verify)(simplify):" \
   "(location-sensitive)(concurrent)" \
+  "(entry-points):(parallel-analyses):" \
   "(no-simplify-slicing)" \
   JAVA_BYTECODE_LANGUAGE_OPTIONS
 // clang-format on
@@ -170,6 +171,8 @@ protected:
   virtual int perform_analysis(const optionst &options);
 
   ai_baset *build_analyzer(const optionst &, const namespacet &ns);
+
+  int combined_verification(const optionst &options, std::ostream &out);
 };
 
 #endif // CPROVER_JANALYZER_JANALYZER_PARSE_OPTIONS_H
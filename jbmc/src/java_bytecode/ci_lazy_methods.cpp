@@ -115,6 +115,9 @@ bool ci_lazy_methodst::operator()(
   }
 
   std::unordered_set<irep_idt> instantiated_classes;
+  // Classes added to instantiated_classes whose effect on the targets of
+  // virtual callsites has not been taken into account yet
+  std::vector<irep_idt> new_classes;
 
   {
     std::unordered_set<irep_idt> initial_callable_methods;
@@ -123,6 +126,7 @@ bool ci_lazy_methodst::operator()(
       instantiated_classes,
       symbol_table,
       pointer_type_selector);
+    initial_lazy_methods.notify_new_classes(new_classes);
     initialize_instantiated_classes(
       methods_to_convert_later, namespacet(symbol_table), initial_lazy_methods);
     methods_to_convert_later.insert(
@@ -132,15 +136,26 @@ bool ci_lazy_methodst::operator()(
   std::unordered_set<irep_idt> methods_already_populated;
   std::unordered_set<class_method_descriptor_exprt, irep_hash>
     called_virtual_functions;
+  // Virtual callsites by the class they are aimed at, such that a newly
+  // instantiated class is only checked against the callsites aimed at it or
+  // its ancestors
+  std::unordered_map<irep_idt, std::vector<class_method_descriptor_exprt>>
+    virtual_functions_by_class;
+  std::unordered_set<class_method_descriptor_exprt, irep_hash>
+    virtual_functions_without_targets;
   bool class_initializer_seen = false;
 
+  // Rapid type analysis: rather than recomputing the targets of all virtual
+  // callsites after each round of conversions, the targets are extended
+  // whenever a callsite or an instantiated class is found, so that each
+  // pair of callsite and class is considered at most once.
   bool any_new_classes = true;
   while(any_new_classes)
   {
-    bool any_new_methods = true;
-    while(any_new_methods)
+    while(!methods_to_convert_later.empty() || !new_classes.empty())
     {
-      any_new_methods = false;
+      std::vector<class_method_descriptor_exprt> new_virtual_functions;
+
       while(!methods_to_convert_later.empty())
       {
         std::unordered_set<irep_idt> methods_to_convert;
@@ -155,34 +170,86 @@ bool ci_lazy_methodst::operator()(
             symbol_table,
             methods_to_convert_later,
             instantiated_classes,
-            called_virtual_functions);
-          any_new_methods |= conversion_result.new_method_seen;
+            new_classes,
+            called_virtual_functions,
+            new_virtual_functions);
           class_initializer_seen |= conversion_result.class_initializer_seen;
         }
       }
 
-      // Given the object types we now know may be created, populate more
-      // possible virtual function call targets:
-
-      debug() << "CI lazy methods: add virtual method targets ("
-              << called_virtual_functions.size() << " callsites)" << eom;
-
+      // Targets of new callsites among the classes instantiated so far
       for(const class_method_descriptor_exprt &called_virtual_function :
-          called_virtual_functions)
+          new_virtual_functions)
       {
+        virtual_functions_by_class[called_virtual_function.get_class_name()]
+          .push_back(called_virtual_function);
+
+        std::unordered_set<irep_idt> targets;
         get_virtual_method_targets(
           called_virtual_function,
           instantiated_classes,
-          methods_to_convert_later,
+          targets,
           symbol_table);
+
+        if(targets.empty())
+          virtual_functions_without_targets.insert(called_virtual_function);
+        else
+          methods_to_convert_later.insert(targets.begin(), targets.end());
+      }
+
+      // Targets in new classes of the callsites seen so far
+      std::vector<irep_idt> classes;
+      std::swap(classes, new_classes);
+      for(const irep_idt &class_name : classes)
+      {
+        class_hierarchyt::idst self_and_parent_classes =
+          class_hierarchy.get_parents_trans(class_name);
+        self_and_parent_classes.push_back(class_name);
+
+        for(const irep_idt &parent : self_and_parent_classes)
+        {
+          const auto callsites = virtual_functions_by_class.find(parent);
+          if(callsites == virtual_functions_by_class.end())
+            continue;
+
+          for(const auto &called_virtual_function : callsites->second)
+          {
+            const irep_idt method_name = get_virtual_method_target(
+              instantiated_classes,
+              called_virtual_function.get_component_name(),
+              class_name,
+              symbol_table);
+            if(!method_name.empty())
+            {
+              methods_to_convert_later.insert(method_name);
+              virtual_functions_without_targets.erase(called_virtual_function);
+            }
+          }
+        }
       }
     }
 
+    debug() << "CI lazy methods: " << called_virtual_functions.size()
+            << " virtual callsites, "
+            << virtual_functions_without_targets.size() << " without targets"
+            << eom;
+
     any_new_classes = handle_virtual_methods_with_no_callees(
       methods_to_convert_later,
       instantiated_classes,
-      called_virtual_functions,
+      new_classes,
+      virtual_functions_without_targets,
       symbol_table);
+    virtual_functions_without_targets.clear();
+  }
+
+  // Record the classes that may have instances, such that virtual dispatch
+  // can later ignore the others
+  for(const irep_idt &class_name : instantiated_classes)
+  {
+    symbolt *class_symbol = symbol_table.get_writeable(class_name);
+    if(class_symbol != nullptr && class_symbol->type.id() == ID_struct)
+      to_java_class_type(class_symbol->type).set_is_instantiated(true);
   }
 
   // Remove symbols for methods that were declared but never used:
@@ -233,6 +300,7 @@ bool ci_lazy_methodst::operator()(
 bool ci_lazy_methodst::handle_virtual_methods_with_no_callees(
   std::unordered_set<irep_idt> &methods_to_convert_later,
   std::unordered_set<irep_idt> &instantiated_classes,
+  std::vector<irep_idt> &new_classes,
   const std::unordered_set<class_method_descriptor_exprt, irep_hash>
     &virtual_functions,
   symbol_tablet &symbol_table)
@@ -242,6 +310,7 @@ bool ci_lazy_methodst::handle_virtual_methods_with_no_callees(
     instantiated_classes,
     symbol_table,
     pointer_type_selector);
+  lazy_methods_loader.notify_new_classes(new_classes);
 
   bool any_new_classes = false;
   for(const class_method_descriptor_exprt &virtual_function : virtual_functions)
@@ -304,8 +373,9 @@ bool ci_lazy_methodst::handle_virtual_methods_with_no_callees(
 }
 
 /// Convert a method, add it to the populated set, add needed methods to
-/// methods_to_convert_later and add virtual calls from the method to
-/// virtual_functions
+/// methods_to_convert_later, newly instantiated classes to new_classes, and
+/// virtual calls from the method to called_virtual_functions, of which those
+/// not seen before are also added to new_virtual_functions
 /// \return structure containing two Booleans:
 ///     * class_initializer_seen which is true if the class_initializer_seen
 ///       argument was false and the class_model is referenced in
@@ -321,8 +391,10 @@ ci_lazy_methodst::convert_and_analyze_method(
   symbol_tablet &symbol_table,
   std::unordered_set<irep_idt> &methods_to_convert_later,
   std::unordered_set<irep_idt> &instantiated_classes,
+  std::vector<irep_idt> &new_classes,
   std::unordered_set<class_method_descriptor_exprt, irep_hash>
-    &called_virtual_functions)
+    &called_virtual_functions,
+  std::vector<class_method_descriptor_exprt> &new_virtual_functions)
 {
   convert_method_resultt result;
   if(!methods_already_populated.insert(method_name).second)
@@ -337,12 +409,19 @@ ci_lazy_methodst::convert_and_analyze_method(
     instantiated_classes,
     symbol_table,
     pointer_type_selector);
+  needed_methods.notify_new_classes(new_classes);
 
   if(method_converter(method_name, needed_methods))
     return result;
 
   const exprt &method_body = symbol_table.lookup_ref(method_name).value;
-  gather_virtual_callsites(method_body, called_virtual_functions);
+  std::unordered_set<class_method_descriptor_exprt, irep_hash> callsites;
+  gather_virtual_callsites(method_body, callsites);
+  for(const auto &callsite : callsites)
+  {
+    if(called_virtual_functions.insert(callsite).second)
+      new_virtual_functions.push_back(callsite);
+  }
 
   if(!class_initializer_already_seen && references_class_model(method_body))
   {
@@ -559,3 +638,47 @@ irep_idt ci_lazy_methodst::get_virtual_method_target(
   else
     return irep_idt();
 }
+
+/// Get the classes that \ref ci_lazy_methodst found cannot have instances.
+/// Abstract classes, interfaces, stubs and arrays are never included, as
+/// they can be instantiated where the analysis does not look, for example by
+/// the object factory or by the bodies of stub methods.
+/// \param symbol_table: symbol table after context-insensitive lazy loading
+/// \return class identifiers, or an empty set if no class was found
+///   instantiated, which means that lazy loading did not run
+std::unordered_set<irep_idt>
+get_uninstantiated_classes(const symbol_tablet &symbol_table)
+{
+  std::unordered_set<irep_idt> uninstantiated_classes;
+  bool any_instantiated = false;
+
+  for(const auto &symbol_pair : symbol_table.symbols)
+  {
+    const symbolt &symbol = symbol_pair.second;
+    if(!symbol.is_type || symbol.mode != ID_java)
+      continue;
+    if(symbol.type.id() != ID_struct)
+      continue;
+
+    const java_class_typet &class_type = to_java_class_type(symbol.type);
+    if(class_type.get_is_instantiated())
+    {
+      any_instantiated = true;
+      continue;
+    }
+
+    if(
+      class_type.get_abstract() || class_type.get_interface() ||
+      class_type.get_is_stub() || is_java_array_tag(symbol.name))
+    {
+      continue;
+    }
+
+    uninstantiated_classes.insert(symbol.name);
+  }
+
+  if(!any_instantiated)
+    uninstantiated_classes.clear();
+
+  return uninstantiated_classes;
+}
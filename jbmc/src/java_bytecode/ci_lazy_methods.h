@@ -171,15 +171,21 @@ private:
     symbol_tablet &symbol_table,
     std::unordered_set<irep_idt> &methods_to_convert_later,
     std::unordered_set<irep_idt> &instantiated_classes,
+    std::vector<irep_idt> &new_classes,
     std::unordered_set<class_method_descriptor_exprt, irep_hash>
-      &called_virtual_functions);
+      &called_virtual_functions,
+    std::vector<class_method_descriptor_exprt> &new_virtual_functions);
 
   bool handle_virtual_methods_with_no_callees(
     std::unordered_set<irep_idt> &methods_to_convert_later,
     std::unordered_set<irep_idt> &instantiated_classes,
+    std::vector<irep_idt> &new_classes,
     const std::unordered_set<class_method_descriptor_exprt, irep_hash>
       &virtual_functions,
     symbol_tablet &symbol_table);
 };
 
+std::unordered_set<irep_idt>
+get_uninstantiated_classes(const symbol_tablet &symbol_table);
+
 #endif // CPROVER_JAVA_BYTECODE_GATHER_METHODS_LAZILY_H
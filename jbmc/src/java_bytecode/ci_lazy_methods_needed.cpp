@@ -27,6 +27,9 @@ Author: Chris Smowton, chris.smowton@diffblue.com
 void ci_lazy_methods_neededt::add_needed_method(
   const irep_idt &method_symbol_name)
 {
+  if(record)
+    record->methods.push_back(method_symbol_name);
+
   callable_methods.insert(method_symbol_name);
 }
 
@@ -71,9 +74,15 @@ void ci_lazy_methods_neededt::add_cprover_nondet_initialize_if_it_exists(
 bool ci_lazy_methods_neededt::add_needed_class(
   const irep_idt &class_symbol_name)
 {
+  if(record)
+    record->classes.push_back(class_symbol_name);
+
   if(!instantiated_classes.insert(class_symbol_name).second)
     return false;
 
+  if(new_classes)
+    new_classes->push_back(class_symbol_name);
+
   add_cprover_nondet_initialize_if_it_exists(class_symbol_name);
 
   // Special case for enums. We may want to generalise this, the comment in
@@ -93,6 +102,9 @@ bool ci_lazy_methods_neededt::add_needed_class(
 void ci_lazy_methods_neededt::add_all_needed_classes(
   const pointer_typet &pointer_type)
 {
+  if(record)
+    record->pointer_types.push_back(pointer_type);
+
   namespacet ns{symbol_table};
 
   initialize_instantiated_classes_from_pointer(pointer_type, ns);
@@ -108,6 +120,17 @@ void ci_lazy_methods_neededt::add_all_needed_classes(
   }
 }
 
+void ci_lazy_methods_neededt::replay(const recordt &calls)
+{
+  // All of the above add to sets, so the order does not matter
+  for(const auto &method : calls.methods)
+    add_needed_method(method);
+  for(const auto &class_name : calls.classes)
+    add_needed_class(class_name);
+  for(const auto &pointer_type : calls.pointer_types)
+    add_all_needed_classes(to_pointer_type(pointer_type));
+}
+
 /// Build up list of methods for types for a specific pointer type. See
 /// `add_all_needed_classes` for more details.
 /// \param pointer_type: The type to gather methods for.
@@ -41,6 +41,31 @@ public:
 
   void add_all_needed_classes(const pointer_typet &pointer_type);
 
+  /// The arguments of calls to the above, such that their effect can be
+  /// repeated by \ref replay
+  struct recordt
+  {
+    std::vector<irep_idt> methods;
+    std::vector<irep_idt> classes;
+    std::vector<typet> pointer_types;
+  };
+
+  /// Record the arguments of all further calls to the above in \p _record
+  void start_recording(recordt &_record)
+  {
+    record = &_record;
+  }
+
+  /// Repeat the calls in \p calls
+  void replay(const recordt &calls);
+
+  /// Append each class that is newly added to the instantiated classes from
+  /// now on to \p worklist
+  void notify_new_classes(std::vector<irep_idt> &worklist)
+  {
+    new_classes = &worklist;
+  }
+
 private:
   // callable_methods is a vector because it's used as a work-list
   // which is periodically cleared. It can't be relied upon to
@@ -56,6 +81,9 @@ private:
 
   const select_pointer_typet &pointer_type_selector;
 
+  recordt *record = nullptr;
+  std::vector<irep_idt> *new_classes = nullptr;
+
   void add_clinit_call(const irep_idt &class_id);
   void add_cprover_nondet_initialize_if_it_exists(const irep_idt &class_id);
 
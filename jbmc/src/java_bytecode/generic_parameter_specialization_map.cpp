@@ -2,6 +2,8 @@
 
 #include "generic_parameter_specialization_map.h"
 
+#include <algorithm>
+
 std::size_t generic_parameter_specialization_mapt::insert(
   const std::vector<java_generic_parametert> &parameters,
   std::vector<reference_typet> types)
@@ -65,3 +67,13 @@ generic_parameter_specialization_mapt::pop(const irep_idt &parameter_name)
   stack.pop();
   return result;
 }
+
+bool generic_parameter_specialization_mapt::empty() const
+{
+  return std::all_of(
+    container_to_specializations.begin(),
+    container_to_specializations.end(),
+    [](const std::stack<std::vector<reference_typet>> &stack) {
+      return stack.empty();
+    });
+}
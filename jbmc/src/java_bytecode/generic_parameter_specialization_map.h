@@ -56,6 +56,9 @@ public:
   ///   one before the pop, or an empty optionalt if the stack was empty
   optionalt<reference_typet> pop(const irep_idt &parameter_name);
 
+  /// \return True iff no type parameter is currently specialized
+  bool empty() const;
+
   /// A wrapper for a generic_parameter_specialization_mapt and a namespacet
   /// that can be output to a stream
   struct printert
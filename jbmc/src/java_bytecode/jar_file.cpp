@@ -47,7 +47,10 @@ jar_filet::jar_filet(
 
 jar_filet::jar_filet(jar_filet &&other)
   : m_zip_archive(std::move(other.m_zip_archive)),
-    m_name_to_index(std::move(other.m_name_to_index))
+    m_name_to_index(std::move(other.m_name_to_index)),
+    m_cache(std::move(other.m_cache)),
+    m_cache_index(std::move(other.m_cache_index)),
+    m_cache_size(other.m_cache_size)
 {
 }
 
@@ -55,6 +58,9 @@ jar_filet &jar_filet::operator=(jar_filet &&other)
 {
   m_zip_archive=std::move(other.m_zip_archive);
   m_name_to_index=std::move(other.m_name_to_index);
+  m_cache = std::move(other.m_cache);
+  m_cache_index = std::move(other.m_cache_index);
+  m_cache_size = other.m_cache_size;
   return *this;
 }
 
@@ -66,7 +72,7 @@ optionalt<std::string> jar_filet::get_entry(const std::string &name)
 
   try
   {
-    return m_zip_archive.extract(entry->second);
+    return *inflate(entry->second);
   }
   catch(const std::runtime_error &)
   {
@@ -74,6 +80,99 @@ optionalt<std::string> jar_filet::get_entry(const std::string &name)
   }
 }
 
+optionalt<std::uint32_t>
+jar_filet::get_entry_crc32(const std::string &name)
+{
+  const auto entry = m_name_to_index.find(name);
+  if(entry == m_name_to_index.end())
+    return {};
+
+  try
+  {
+    return m_zip_archive.get_crc32(entry->second);
+  }
+  catch(const std::runtime_error &)
+  {
+    return {};
+  }
+}
+
+/// Read-only stream buffer over memory that is owned elsewhere
+class memory_streambuft : public std::streambuf
+{
+public:
+  memory_streambuft(const char *data, size_t size)
+  {
+    // the get area is never written to
+    char *begin = const_cast<char *>(data);
+    setg(begin, begin, begin + size);
+  }
+};
+
+bool jar_filet::read_entry(
+  const std::string &name,
+  const std::function<void(std::istream &)> &reader)
+{
+  const auto entry = m_name_to_index.find(name);
+  if(entry == m_name_to_index.end())
+    return false;
+
+  size_t size;
+  const char *data = m_zip_archive.get_stored_data(entry->second, size);
+  if(data != nullptr)
+  {
+    memory_streambuft buffer(data, size);
+    std::istream in(&buffer);
+    reader(in);
+    return true;
+  }
+
+  std::shared_ptr<const std::string> contents;
+  try
+  {
+    contents = inflate(entry->second);
+  }
+  catch(const std::runtime_error &)
+  {
+    return false;
+  }
+
+  memory_streambuft buffer(contents->data(), contents->size());
+  std::istream in(&buffer);
+  reader(in);
+  return true;
+}
+
+std::shared_ptr<const std::string> jar_filet::inflate(size_t index)
+{
+  const auto cached = m_cache_index.find(index);
+  if(cached != m_cache_index.end())
+  {
+    m_cache.splice(m_cache.begin(), m_cache, cached->second);
+    return cached->second->second;
+  }
+
+  auto contents =
+    std::make_shared<const std::string>(m_zip_archive.extract(index));
+
+  // Files that would take up much of the cache are not worth keeping
+  if(contents->size() <= max_cache_size / 4)
+  {
+    m_cache.emplace_front(index, contents);
+    m_cache_index.emplace(index, m_cache.begin());
+    m_cache_size += contents->size();
+
+    while(m_cache_size > max_cache_size)
+    {
+      m_cache_size -= m_cache.back().second->size();
+      m_cache_index.erase(m_cache.back().first);
+      m_cache.pop_back();
+    }
+  }
+
+  return contents;
+}
+
 /// Wrapper for `std::isspace` from `cctype`
 /// \param ch: the character to check
 /// \return true if the parameter is considered to be a space in the current
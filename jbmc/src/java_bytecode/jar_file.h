@@ -9,6 +9,9 @@ Author: Diffblue Ltd
 #ifndef CPROVER_JAVA_BYTECODE_JAR_FILE_H
 #define CPROVER_JAVA_BYTECODE_JAR_FILE_H
 
+#include <functional>
+#include <istream>
+#include <list>
 #include <unordered_map>
 #include <memory>
 #include <string>
@@ -19,7 +22,9 @@ Author: Diffblue Ltd
 #include "mz_zip_archive.h"
 
 /// Class representing a .jar archive. Uses miniz to decompress and index
-/// archive.
+/// archive. Archives opened from a file are mapped into memory where
+/// possible, so that entries stored without compression can be read in place,
+/// and recently inflated entries are kept in a cache of bounded size.
 class jar_filet final
 {
 public:
@@ -45,6 +50,21 @@ public:
   /// \param filename: Name of the file in the archive
   optionalt<std::string> get_entry(const std::string &filename);
 
+  /// Call \p reader with a stream over the contents of a file in the jar
+  /// archive, which does not copy the contents if the file is stored without
+  /// compression in an archive held in memory.
+  /// \param filename: Name of the file in the archive
+  /// \param reader: Function to consume the stream
+  /// \return False if the file doesn't exist or cannot be extracted
+  bool read_entry(
+    const std::string &filename,
+    const std::function<void(std::istream &)> &reader);
+
+  /// Get the CRC-32 checksum of a file in the jar archive.
+  /// Returns nullopt if file doesn't exist.
+  /// \param filename: Name of the file in the archive
+  optionalt<std::uint32_t> get_entry_crc32(const std::string &filename);
+
   /// Get contents of the Manifest file in the jar archive as a key-value map
   /// (both as strings)
   std::unordered_map<std::string, std::string> get_manifest();
@@ -57,10 +77,25 @@ private:
   /// indices.
   void initialize_file_index();
 
+  /// Get the inflated contents of the file with the given index, from the
+  /// cache if possible
+  /// \throw Throws std::runtime_error if file cannot be extracted
+  std::shared_ptr<const std::string> inflate(size_t index);
+
   mz_zip_archivet m_zip_archive;
 
   /// Map of filename to the file index in the zip archive.
   std::unordered_map<std::string, size_t> m_name_to_index;
+
+  /// Recently inflated files by index, most recently used first
+  typedef std::list<std::pair<size_t, std::shared_ptr<const std::string>>>
+    cachet;
+  cachet m_cache;
+  std::unordered_map<size_t, cachet::iterator> m_cache_index;
+  /// Total size of the files in \ref m_cache
+  size_t m_cache_size = 0;
+  /// Upper bound of \ref m_cache_size
+  static const size_t max_cache_size = 8 * 1024 * 1024;
 };
 
 #endif // CPROVER_JAVA_BYTECODE_JAR_FILE_H
@@ -28,6 +28,7 @@ jar_filet &jar_poolt::add_jar(
   {
     // VS: Can't construct in place
     auto file = jar_filet(pmem, size);
+    m_in_memory.insert(buffer_name);
     return m_archives.emplace(buffer_name, std::move(file)).first->second;
   }
   else
@@ -10,6 +10,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_JAVA_BYTECODE_JAR_POOL_H
 
 #include <map>
+#include <set>
 #include <string>
 
 class jar_filet;
@@ -32,9 +33,17 @@ public:
   jar_filet &
   add_jar(const std::string &buffer_name, const void *pmem, size_t size);
 
+  /// \return True iff \p jar_path names a jar archive added by \ref add_jar
+  bool is_in_memory(const std::string &jar_path) const
+  {
+    return m_in_memory.count(jar_path) != 0;
+  }
+
 protected:
   /// Jar files that have been loaded
   std::map<std::string, jar_filet> m_archives;
+  /// Names of the jar files that were added from memory
+  std::set<std::string> m_in_memory;
 };
 
 #endif // CPROVER_JAVA_BYTECODE_JAVA_CLASS_LOADER_H
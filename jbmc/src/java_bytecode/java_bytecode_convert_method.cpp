@@ -1319,9 +1319,7 @@ java_bytecode_convert_methodt::convert_instructions(const methodt &method)
     }
     else if(bytecode == BC_invokedynamic)
     {
-      if(
-        const auto res =
-          convert_invoke_dynamic(i_it->source_location, i_it->address, arg0, c))
+      if(const auto res = convert_invoke_dynamic(i_it->source_location, arg0, c))
       {
         results.resize(1);
         results[0] = *res;
@@ -3034,7 +3032,6 @@ code_blockt java_bytecode_convert_methodt::convert_astore(
 
 optionalt<exprt> java_bytecode_convert_methodt::convert_invoke_dynamic(
   const source_locationt &location,
-  std::size_t instruction_address,
   const exprt &arg0,
   codet &result_code)
 {
@@ -3046,10 +3043,10 @@ optionalt<exprt> java_bytecode_convert_methodt::convert_invoke_dynamic(
   // method or not
   code_function_callt::argumentst arguments = pop(parameters.size());
 
-  irep_idt synthetic_class_name =
-    lambda_synthetic_class_name(method_id, instruction_address);
+  const optionalt<irep_idt> lambda_class_name =
+    lambda_synthetic_class_name(symbol_table, method_id, method_type);
 
-  if(!symbol_table.has_symbol(synthetic_class_name))
+  if(!lambda_class_name || !symbol_table.has_symbol(*lambda_class_name))
   {
     // We failed to parse the invokedynamic handle as a Java 8+ lambda;
     // give up and return null.
@@ -3065,6 +3062,7 @@ optionalt<exprt> java_bytecode_convert_methodt::convert_invoke_dynamic(
 
   // Construct an instance of the synthetic class created for this invokedynamic
   // site:
+  const irep_idt &synthetic_class_name = *lambda_class_name;
 
   irep_idt constructor_name = id2string(synthetic_class_name) + ".<init>";
 
@@ -350,7 +350,6 @@ protected:
 
   optionalt<exprt> convert_invoke_dynamic(
     const source_locationt &location,
-    std::size_t instruction_address,
     const exprt &arg0,
     codet &result_code);
 
@@ -72,6 +72,18 @@ void parse_java_language_options(const cmdlinet &cmd, optionst &options)
       "java-max-vla-length", cmd.get_value("java-max-vla-length"));
   }
 
+  if(cmd.isset("java-load-threads"))
+  {
+    options.set_option(
+      "java-load-threads", cmd.get_value("java-load-threads"));
+  }
+
+  if(cmd.isset("java-method-cache"))
+  {
+    options.set_option(
+      "java-method-cache", cmd.get_value("java-method-cache"));
+  }
+
   options.set_option(
     "symex-driven-lazy-loading", cmd.isset("symex-driven-lazy-loading"));
 
@@ -156,6 +168,8 @@ java_bytecode_language_optionst::java_bytecode_language_optionst(
   threading_support = options.get_bool_option("java-threading");
   max_user_array_length =
     options.get_unsigned_int_option("java-max-vla-length");
+  if(options.is_set("java-load-threads"))
+    load_threads = options.get_unsigned_int_option("java-load-threads");
 
   if(options.get_bool_option("symex-driven-lazy-loading"))
     lazy_methods_mode=LAZY_METHODS_MODE_EXTERNAL_DRIVER;
@@ -261,6 +275,11 @@ void java_bytecode_languaget::set_language_options(const optionst &options)
 {
   object_factory_parameters.set(options);
   language_options = java_bytecode_language_optionst{options, *this};
+  if(options.is_set("java-method-cache"))
+  {
+    method_cache = util_make_unique<java_method_cachet>(
+      options.get_option("java-method-cache"), options);
+  }
   const auto &new_points = build_extra_entry_points(options);
   language_options->extra_methods.insert(
     language_options->extra_methods.end(),
@@ -312,6 +331,7 @@ bool java_bytecode_languaget::parse(
   java_class_loader.set_java_cp_include_files(
     language_options->java_cp_include_files);
   java_class_loader.add_load_classes(language_options->java_load_classes);
+  java_class_loader.set_number_of_threads(language_options->load_threads);
   if(language_options->string_refinement_enabled)
   {
     string_preprocess.initialize_known_type_table();
@@ -761,6 +781,21 @@ bool java_bytecode_languaget::typecheck(
   java_internal_additions(symbol_table);
   create_java_initialize(symbol_table);
 
+  if(method_cache)
+  {
+    const auto &checksums = java_class_loader.get_class_file_checksums();
+    std::map<irep_idt, std::vector<std::uint32_t>> loaded_classes;
+    for(const auto &class_trees :
+        java_class_loader.get_class_with_overlays_map())
+    {
+      const auto class_checksums = checksums.find(class_trees.first);
+      loaded_classes[class_trees.first] = class_checksums == checksums.end()
+                                            ? std::vector<std::uint32_t>()
+                                            : class_checksums->second;
+    }
+    method_cache->set_loaded_classes(loaded_classes);
+  }
+
   if(language_options->string_refinement_enabled)
     string_preprocess.initialize_conversion_table();
 
@@ -1289,6 +1324,37 @@ bool java_bytecode_languaget::convert_single_method_code(
   {
     // Synthetic method (i.e. one generated by the Java frontend and which
     // doesn't occur in the source bytecode):
+    if(
+      method_cache &&
+      (synthetic_method_it->second ==
+         synthetic_method_typet::INVOKEDYNAMIC_CAPTURE_CONSTRUCTOR ||
+       synthetic_method_it->second ==
+         synthetic_method_typet::INVOKEDYNAMIC_METHOD))
+    {
+      // There is one of these per lambda class, so many of them in programs
+      // that make heavy use of lambdas: keep them with the converted methods
+      if(method_cache->load(function_id, symbol_table, needed_lazy_methods))
+        return false;
+
+      ci_lazy_methods_neededt::recordt needs;
+      if(needed_lazy_methods)
+        needed_lazy_methods->start_recording(needs);
+      journalling_symbol_tablet journal =
+        journalling_symbol_tablet::wrap(symbol_table);
+
+      codet body = synthetic_method_it->second ==
+                       synthetic_method_typet::INVOKEDYNAMIC_METHOD
+                     ? invokedynamic_synthetic_method(
+                         function_id, journal, get_message_handler())
+                     : invokedynamic_synthetic_constructor(
+                         function_id, journal, get_message_handler());
+      notify_static_method_calls(body, needed_lazy_methods);
+      journal.get_writeable_ref(function_id).value = std::move(body);
+
+      method_cache->store(function_id, journal, needs);
+      return false;
+    }
+
     symbolt &writable_symbol = symbol_table.get_writeable_ref(function_id);
     switch(synthetic_method_it->second)
     {
@@ -1372,10 +1438,39 @@ bool java_bytecode_languaget::convert_single_method_code(
   // check if have bytecode for it
   if(cmb)
   {
+    if(!method_cache)
+    {
+      java_bytecode_convert_method(
+        symbol_table.lookup_ref(cmb->get().class_id),
+        cmb->get().method,
+        symbol_table,
+        get_message_handler(),
+        language_options->max_user_array_length,
+        language_options->throw_assertion_error,
+        std::move(needed_lazy_methods),
+        string_preprocess,
+        class_hierarchy,
+        language_options->threading_support,
+        language_options->method_context,
+        language_options->assert_no_exceptions_thrown);
+      return false;
+    }
+
+    if(method_cache->load(function_id, symbol_table, needed_lazy_methods))
+      return false;
+
+    // Convert with a journal of the changes, and a record of the needed
+    // methods and classes, to be stored in the cache
+    ci_lazy_methods_neededt::recordt needs;
+    if(needed_lazy_methods)
+      needed_lazy_methods->start_recording(needs);
+    journalling_symbol_tablet journal =
+      journalling_symbol_tablet::wrap(symbol_table);
+
     java_bytecode_convert_method(
-      symbol_table.lookup_ref(cmb->get().class_id),
+      journal.lookup_ref(cmb->get().class_id),
       cmb->get().method,
-      symbol_table,
+      journal,
       get_message_handler(),
       language_options->max_user_array_length,
       language_options->throw_assertion_error,
@@ -1385,6 +1480,8 @@ bool java_bytecode_languaget::convert_single_method_code(
       language_options->threading_support,
       language_options->method_context,
       language_options->assert_no_exceptions_thrown);
+
+    method_cache->store(function_id, journal, needs);
     return false;
   }
 
@@ -1417,6 +1514,13 @@ bool java_bytecode_languaget::convert_single_method_code(
 bool java_bytecode_languaget::final(symbol_table_baset &)
 {
   PRECONDITION(language_options.has_value());
+
+  if(method_cache)
+  {
+    debug() << "Method cache: " << method_cache->hits << " hits, "
+            << method_cache->misses << " misses" << eom;
+  }
+
   return false;
 }
 
@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "ci_lazy_methods_needed.h"
 #include "code_with_references.h"
 #include "java_class_loader.h"
+#include "java_method_cache.h"
 #include "java_object_factory_parameters.h"
 #include "java_static_initializers.h"
 #include "java_string_library_preprocess.h"
@@ -37,11 +38,14 @@ Author: Daniel Kroening, kroening@kroening.com
   "(java-assume-inputs-non-null)" \
   "(java-assume-inputs-interval):" \
   "(java-assume-inputs-integral)" \
+  "(java-share-nondet-initializers)" \
   "(throw-runtime-exceptions)" \
   "(max-nondet-array-length):" \
   "(max-nondet-tree-depth):" \
   "(java-max-vla-length):" \
   "(java-cp-include-files):" \
+  "(java-load-threads):" \
+  "(java-method-cache):" \
   "(ignore-manifest-main-class)" \
   "(context-include):" \
   "(context-exclude):" \
@@ -77,9 +81,16 @@ Author: Daniel Kroening, kroening@kroening.com
   " --java-assume-inputs-integral\n" \
   "                              force float and double inputs to have integer values;\n" /* NOLINT(*) */ \
   "                              does not work for arrays;\n" /* NOLINT(*) */ \
+  " --java-share-nondet-initializers\n" \
+  "                              initialize nondet objects by functions shared\n" /* NOLINT(*) */ \
+  "                              by all objects of the same type and depth\n" /* NOLINT(*) */ \
   " --java-max-vla-length N      limit the length of user-code-created arrays\n" /* NOLINT(*) */ \
   " --java-cp-include-files r    regexp or JSON list of files to load\n" \
   "                              (with '@' prefix)\n" \
+  " --java-load-threads N        read and decompress class files on N threads\n" /* NOLINT(*) */ \
+  " --java-method-cache dir      keep converted method bodies in directory dir\n" /* NOLINT(*) */ \
+  "                              and reuse them in runs that load the same\n" /* NOLINT(*) */ \
+  "                              class files with the same options\n" \
   " --ignore-manifest-main-class ignore Main-Class entries in JAR manifest files.\n" /* NOLINT(*) */ \
   "                              If this option is specified and the options\n" /* NOLINT(*) */ \
   "                              --function and --main-class are not, we can be\n" /* NOLINT(*) */ \
@@ -190,6 +201,8 @@ struct java_bytecode_language_optionst
   /// list of classes to force load even without reference from the entry point
   std::vector<irep_idt> java_load_classes;
   std::string java_cp_include_files;
+  /// number of threads for reading class files
+  std::size_t load_threads = 1;
   /// JSON which contains initial values of static fields (right
   /// after the static initializer of the class was run). This is read from the
   /// file specified by the --static-values command-line option.
@@ -319,6 +332,8 @@ protected:
   java_object_factory_parameterst object_factory_parameters;
   method_bytecodet method_bytecode;
   java_string_library_preprocesst string_preprocess;
+  /// Set if converted methods are cached across runs
+  std::unique_ptr<java_method_cachet> method_cache;
 
 private:
   virtual std::vector<load_extra_methodst>
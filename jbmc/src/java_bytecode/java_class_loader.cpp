@@ -8,7 +8,6 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "java_class_loader.h"
 
-#include <stack>
 #include <fstream>
 
 #include <util/suffix.h>
@@ -19,30 +18,48 @@ Author: Daniel Kroening, kroening@kroening.com
 java_class_loadert::parse_tree_with_overlayst &java_class_loadert::operator()(
   const irep_idt &class_name)
 {
-  std::stack<irep_idt> queue;
+  // Used as a stack; the topmost `unread` entries have been pushed since
+  // their class files were last read ahead
+  std::vector<irep_idt> queue;
   // Always require java.lang.Object, as it is the base of
   // internal classes such as array types.
-  queue.push("java.lang.Object");
+  queue.push_back("java.lang.Object");
   // java.lang.String
-  queue.push("java.lang.String");
+  queue.push_back("java.lang.String");
   // add java.lang.Class
-  queue.push("java.lang.Class");
+  queue.push_back("java.lang.Class");
   // Require java.lang.Throwable as the catch-type used for
   // universal exception handlers:
-  queue.push("java.lang.Throwable");
-  queue.push(class_name);
+  queue.push_back("java.lang.Throwable");
+  queue.push_back(class_name);
 
   // Require user provided classes to be loaded even without explicit reference
   for(const auto &id : java_load_classes)
-    queue.push(id);
+    queue.push_back(id);
+
+  std::size_t unread = queue.size();
 
   java_class_loader_limitt class_loader_limit(
     get_message_handler(), java_cp_include_files);
 
   while(!queue.empty())
   {
-    irep_idt c=queue.top();
-    queue.pop();
+    if(number_of_threads > 1 && unread > 0)
+    {
+      // Read the class files of all newly queued classes at once, so that
+      // they are decompressed in parallel
+      std::vector<irep_idt> to_read;
+      for(auto it = queue.end() - unread; it != queue.end(); ++it)
+      {
+        if(class_map.count(*it) == 0)
+          to_read.push_back(*it);
+      }
+      read_class_files(to_read, number_of_threads);
+    }
+
+    irep_idt c = queue.back();
+    queue.pop_back();
+    unread = 0;
 
     if(class_map.count(c) != 0)
       continue;
@@ -52,17 +69,21 @@ java_class_loadert::parse_tree_with_overlayst &java_class_loadert::operator()(
     parse_tree_with_overlayst &parse_trees =
       get_parse_tree(class_loader_limit, c);
 
+    const std::size_t queue_size = queue.size();
+
     // Add any dependencies to queue
     for(const java_bytecode_parse_treet &parse_tree : parse_trees)
       for(const irep_idt &class_ref : parse_tree.class_refs)
-        queue.push(class_ref);
+        queue.push_back(class_ref);
 
     // Add any extra dependencies provided by our caller:
     if(get_extra_class_refs)
     {
       for(const irep_idt &id : get_extra_class_refs(c))
-        queue.push(id);
+        queue.push_back(id);
     }
+
+    unread = queue.size() - queue_size;
   }
 
   return class_map.at(class_name);
@@ -116,6 +137,15 @@ java_class_loadert::get_parse_tree(
   parse_tree_with_overlayst &parse_trees = class_map[class_name];
   PRECONDITION(parse_trees.empty());
 
+  // take the class files that were read ahead, if any
+  std::vector<class_file_contentst> read_ahead;
+  const auto class_file = class_files.find(class_name);
+  if(class_file != class_files.end())
+  {
+    read_ahead = std::move(class_file->second);
+    class_files.erase(class_file);
+  }
+
   // do we refuse to load?
   if(!class_loader_limit.load_class_file(class_name_to_jar_file(class_name)))
   {
@@ -125,9 +155,14 @@ java_class_loadert::get_parse_tree(
   }
 
   // Rummage through the class path
+  std::size_t index = 0;
   for(const auto &cp_entry : classpath_entries)
   {
-    auto parse_tree = load_class(class_name, cp_entry);
+    auto parse_tree =
+      index < read_ahead.size() && read_ahead[index].read
+        ? parse_class_file(class_name, cp_entry, read_ahead[index])
+        : load_class(class_name, cp_entry);
+    ++index;
     if(parse_tree.has_value())
       parse_trees.emplace_back(std::move(*parse_tree));
   }
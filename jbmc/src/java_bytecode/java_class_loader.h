@@ -10,6 +10,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_JAVA_BYTECODE_JAVA_CLASS_LOADER_H
 #define CPROVER_JAVA_BYTECODE_JAVA_CLASS_LOADER_H
 
+#include <algorithm>
 #include <map>
 #include <regex>
 #include <set>
@@ -70,6 +71,14 @@ public:
       java_load_classes.push_back(id);
   }
 
+  /// Read and decompress class files on up to \p threads threads while
+  /// loading classes, where 1 means that each class file is read only when
+  /// it is parsed
+  void set_number_of_threads(std::size_t threads)
+  {
+    number_of_threads = std::max<std::size_t>(threads, 1);
+  }
+
   std::vector<irep_idt> load_entire_jar(const std::string &jar_path);
 
   /// Map from class names to the bytecode parse trees
@@ -96,6 +105,9 @@ private:
   std::vector<irep_idt> java_load_classes;
   get_extra_class_refs_functiont get_extra_class_refs;
 
+  /// Number of threads for reading class files ahead of parsing them
+  std::size_t number_of_threads = 1;
+
   /// Map from class names to the bytecode parse trees
   parse_tree_with_overridest_mapt class_map;
 
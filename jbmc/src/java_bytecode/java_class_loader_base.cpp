@@ -11,11 +11,15 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "jar_file.h"
 #include "java_bytecode_parser.h"
 
+#include <miniz/miniz.h>
+
 #include <util/file_util.h>
 #include <util/prefix.h>
 #include <util/suffix.h>
 
 #include <fstream>
+#include <thread>
+#include <unordered_set>
 
 void java_class_loader_baset::add_classpath_entry(const std::string &path)
 {
@@ -108,6 +112,136 @@ java_class_loader_baset::class_name_to_os_file(const irep_idt &class_name)
   return result;
 }
 
+void java_class_loader_baset::read_class_files(
+  const std::vector<irep_idt> &class_names,
+  std::size_t number_of_threads)
+{
+  PRECONDITION(number_of_threads >= 1);
+
+  // entries are copied out of the list to be indexed by the threads
+  const std::vector<classpath_entryt> entries(
+    classpath_entries.begin(), classpath_entries.end());
+
+  struct jobt
+  {
+    irep_idt class_name;
+    std::string jar_file;
+    std::string os_file;
+    std::vector<class_file_contentst> contents;
+  };
+
+  std::vector<jobt> jobs;
+  std::unordered_set<irep_idt> seen;
+  for(const auto &class_name : class_names)
+  {
+    if(class_files.count(class_name) != 0 || !seen.insert(class_name).second)
+      continue;
+
+    jobs.push_back(
+      {class_name,
+       class_name_to_jar_file(class_name),
+       class_name_to_os_file(class_name),
+       std::vector<class_file_contentst>(entries.size())});
+  }
+
+  if(jobs.empty())
+    return;
+
+  number_of_threads = std::min(number_of_threads, jobs.size());
+  while(thread_jar_pools.size() < number_of_threads)
+    thread_jar_pools.push_back(std::unique_ptr<jar_poolt>(new jar_poolt()));
+
+  // Thread t reads the class files of jobs t, t + number_of_threads, ...
+  const auto read = [&](std::size_t t) {
+    jar_poolt &thread_jar_pool = *thread_jar_pools[t];
+    for(std::size_t j = t; j < jobs.size(); j += number_of_threads)
+    {
+      for(std::size_t e = 0; e < entries.size(); ++e)
+      {
+        class_file_contentst &contents = jobs[j].contents[e];
+        if(entries[e].kind == classpath_entryt::JAR)
+        {
+          // JARs added from memory are left to be read when parsing
+          if(jar_pool.is_in_memory(entries[e].path))
+            continue;
+
+          try
+          {
+            contents.contents =
+              thread_jar_pool(entries[e].path).get_entry(jobs[j].jar_file);
+            contents.read = true;
+          }
+          catch(const std::runtime_error &)
+          {
+            // left to be reported when parsing
+          }
+        }
+        else
+        {
+          std::ifstream in(
+            concat_dir_file(entries[e].path, jobs[j].os_file),
+            std::ios::binary);
+          if(in)
+          {
+            std::ostringstream data;
+            data << in.rdbuf();
+            contents.contents = data.str();
+          }
+          contents.read = true;
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for(std::size_t t = 1; t < number_of_threads; ++t)
+    threads.emplace_back(read, t);
+  read(0);
+  for(auto &thread : threads)
+    thread.join();
+
+  for(auto &job : jobs)
+    class_files.emplace(job.class_name, std::move(job.contents));
+}
+
+/// Parse a class file that was read by \ref read_class_files
+/// \param class_name: name of class to load in Java source format
+/// \param cp_entry: the classpath entry the class file was read from
+/// \param class_file: the class file as read from \p cp_entry
+/// \return optional value of parse tree, empty if the entry does not contain
+///   the class
+optionalt<java_bytecode_parse_treet> java_class_loader_baset::parse_class_file(
+  const irep_idt &class_name,
+  const classpath_entryt &cp_entry,
+  const class_file_contentst &class_file)
+{
+  PRECONDITION(class_file.read);
+
+  if(!class_file.contents.has_value())
+    return {};
+
+  if(cp_entry.kind == classpath_entryt::JAR)
+  {
+    debug() << "Getting class '" << class_name << "' from JAR "
+            << cp_entry.path << eom;
+  }
+  else
+  {
+    debug() << "Getting class '" << class_name << "' from file "
+            << concat_dir_file(cp_entry.path, class_name_to_os_file(class_name))
+            << eom;
+  }
+
+  const std::string &contents = *class_file.contents;
+  class_file_checksums[class_name].push_back(mz_crc32(
+    MZ_CRC32_INIT,
+    reinterpret_cast<const unsigned char *>(contents.data()),
+    contents.size()));
+
+  std::istringstream istream(contents);
+  return java_bytecode_parse(istream, get_message_handler());
+}
+
 /// attempt to load a class from a classpath_entry
 optionalt<java_bytecode_parse_treet> java_class_loader_baset::load_class(
   const irep_idt &class_name,
@@ -137,16 +271,23 @@ java_class_loader_baset::get_class_from_jar(
   try
   {
     auto &jar = jar_pool(jar_file);
-    auto data = jar.get_entry(class_name_to_jar_file(class_name));
+    const std::string entry = class_name_to_jar_file(class_name);
+    optionalt<java_bytecode_parse_treet> parse_tree;
 
-    if(!data.has_value())
-      return {};
+    const bool found =
+      jar.read_entry(entry, [&](std::istream &istream) {
+        debug() << "Getting class '" << class_name << "' from JAR "
+                << jar_file << eom;
+        parse_tree = java_bytecode_parse(istream, get_message_handler());
+      });
 
-    debug() << "Getting class '" << class_name << "' from JAR " << jar_file
-            << eom;
+    if(found)
+    {
+      class_file_checksums[class_name].push_back(
+        jar.get_entry_crc32(entry).value_or(0));
+    }
 
-    std::istringstream istream(*data);
-    return java_bytecode_parse(istream, get_message_handler());
+    return parse_tree;
   }
   catch(const std::runtime_error &)
   {
@@ -168,11 +309,22 @@ java_class_loader_baset::get_class_from_directory(
   const std::string class_file = class_name_to_os_file(class_name);
   const std::string full_path = concat_dir_file(path, class_file);
 
-  if(std::ifstream(full_path))
+  std::ifstream in(full_path, std::ios::binary);
+  if(in)
   {
     debug() << "Getting class '" << class_name << "' from file " << full_path
             << eom;
-    return java_bytecode_parse(full_path, get_message_handler());
+
+    std::ostringstream data;
+    data << in.rdbuf();
+    const std::string contents = data.str();
+    class_file_checksums[class_name].push_back(mz_crc32(
+      MZ_CRC32_INIT,
+      reinterpret_cast<const unsigned char *>(contents.data()),
+      contents.size()));
+
+    std::istringstream istream(contents);
+    return java_bytecode_parse(istream, get_message_handler());
   }
   else
     return {};
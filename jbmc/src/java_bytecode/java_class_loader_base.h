@@ -11,6 +11,10 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/message.h>
 
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
 #include "jar_pool.h"
 #include "java_bytecode_parse_tree.h"
 
@@ -22,6 +26,7 @@ public:
   void clear_classpath()
   {
     classpath_entries.clear();
+    class_files.clear();
   }
 
   /// Appends an entry to the class path, used for loading classes.  The
@@ -37,6 +42,14 @@ public:
   /// a cache for jar_filet, by path name
   jar_poolt jar_pool;
 
+  /// CRC-32 checksums of the class files that were found for each class, in
+  /// the order of the classpath
+  const std::unordered_map<irep_idt, std::vector<std::uint32_t>> &
+  get_class_file_checksums() const
+  {
+    return class_file_checksums;
+  }
+
 protected:
   /// An entry in the classpath
   struct classpath_entryt
@@ -54,6 +67,41 @@ protected:
   /// List of entries in the classpath
   std::list<classpath_entryt> classpath_entries;
 
+  std::unordered_map<irep_idt, std::vector<std::uint32_t>>
+    class_file_checksums;
+
+  /// Contents of a class file in each classpath entry, as read ahead of
+  /// parsing by \ref read_class_files
+  struct class_file_contentst
+  {
+    /// Set once the entry has been searched for the class file
+    bool read = false;
+    /// Empty if the entry does not contain the class file
+    optionalt<std::string> contents;
+  };
+
+  /// Class files read by \ref read_class_files that have not been parsed
+  /// yet, with one element per classpath entry
+  std::unordered_map<irep_idt, std::vector<class_file_contentst>> class_files;
+
+  /// One cache for jar_filet per thread of \ref read_class_files, as a
+  /// jar_filet must not be used by several threads at once
+  std::vector<std::unique_ptr<jar_poolt>> thread_jar_pools;
+
+  /// Read the class files of \p class_names from all classpath entries into
+  /// \ref class_files, using up to \p number_of_threads threads for reading
+  /// and decompressing them. Parsing stays with the calling thread.
+  void read_class_files(
+    const std::vector<irep_idt> &class_names,
+    std::size_t number_of_threads);
+
+  /// parse a class file that \ref read_class_files read from a
+  /// classpath_entry
+  optionalt<java_bytecode_parse_treet> parse_class_file(
+    const irep_idt &class_name,
+    const classpath_entryt &,
+    const class_file_contentst &);
+
   /// attempt to load a class from a classpath_entry
   optionalt<java_bytecode_parse_treet>
   load_class(const irep_idt &class_name, const classpath_entryt &);
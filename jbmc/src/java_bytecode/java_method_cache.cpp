@@ -0,0 +1,329 @@
+/*******************************************************************\
+
+Module: Cache of Converted Java Methods
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// An on-disk cache of the results of converting Java methods to code
+
+#include "java_method_cache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#include <util/file_util.h>
+#include <util/invariant.h>
+#include <util/irep_serialization.h>
+#include <util/options.h>
+#include <util/string_hash.h>
+
+/// Version of the format of the cache files
+static const std::size_t format_version = 1;
+
+/// Conversions that touch more symbols than this are not cached, as they
+/// would likely be cheaper to repeat than to read
+static const std::size_t max_symbols_per_entry = 1000;
+
+/// Options that are read by the Java front-end while converting methods
+static const char *const conversion_options[] = {
+  "assert-no-exceptions-thrown",
+  "context-exclude",
+  "context-include",
+  "java-assume-inputs-integral",
+  "java-assume-inputs-interval",
+  "java-assume-inputs-non-null",
+  "java-cp-include-files",
+  "java-lift-clinit-calls",
+  "java-load-class",
+  "java-max-vla-length",
+  "java-no-load-class",
+  "java-share-nondet-initializers",
+  "java-threading",
+  "lazy-methods",
+  "lazy-methods-extra-entry-point",
+  "max-nondet-array-length",
+  "max-nondet-string-length",
+  "max-nondet-tree-depth",
+  "min-nondet-string-length",
+  "min-null-tree-depth",
+  "nondet-static",
+  "refine-strings",
+  "static-values",
+  "string-input-value",
+  "string-printable",
+  "symex-driven-lazy-loading",
+  "throw-assertion-error",
+  "throw-runtime-exceptions",
+  "uncaught-exception-check"};
+
+static std::string to_hex(std::size_t value)
+{
+  std::ostringstream out;
+  out << std::hex << value;
+  return out.str();
+}
+
+java_method_cachet::java_method_cachet(
+  std::string _directory,
+  const optionst &options)
+  : directory(std::move(_directory))
+{
+  std::ostringstream key;
+  key << format_version << '\n';
+
+  for(const char *option : conversion_options)
+  {
+    key << option;
+    for(const auto &value : options.get_list_option(option))
+      key << ' ' << value;
+    key << '\n';
+  }
+
+  options_key = key.str();
+
+  create_directory(directory);
+}
+
+void java_method_cachet::set_loaded_classes(
+  const std::map<irep_idt, std::vector<std::uint32_t>> &class_file_checksums)
+{
+  std::ostringstream key;
+  key << options_key;
+
+  for(const auto &class_checksums : class_file_checksums)
+  {
+    key << class_checksums.first;
+    for(const auto checksum : class_checksums.second)
+      key << ' ' << checksum;
+    key << '\n';
+  }
+
+  // Two hashes of different construction make accidental collisions of
+  // fingerprints unlikely enough
+  const std::string key_string = key.str();
+  fingerprint = to_hex(hash_string(key_string)) + "-" +
+                to_hex(std::hash<std::string>{}(key_string));
+}
+
+std::string java_method_cachet::file_name(const irep_idt &method_id) const
+{
+  PRECONDITION(!fingerprint.empty());
+  return concat_dir_file(
+    directory,
+    fingerprint + "-" + to_hex(hash_string(id2string(method_id))) + ".jmc");
+}
+
+static void write_symbol(
+  std::ostream &out,
+  const symbolt &symbol,
+  irep_serializationt &irepconverter)
+{
+  irepconverter.reference_convert(symbol.type, out);
+  irepconverter.reference_convert(symbol.value, out);
+  irepconverter.reference_convert(symbol.location, out);
+
+  irepconverter.write_string_ref(out, symbol.name);
+  irepconverter.write_string_ref(out, symbol.module);
+  irepconverter.write_string_ref(out, symbol.base_name);
+  irepconverter.write_string_ref(out, symbol.mode);
+  irepconverter.write_string_ref(out, symbol.pretty_name);
+
+  std::size_t flags = 0;
+  flags = (flags << 1) | static_cast<std::size_t>(symbol.is_weak);
+  flags = (flags << 1) | static_cast<std::size_t>(symbol.is_type);
+  flags = (flags << 1) | static_cast<std::size_t>(symbol.is_property);
+  flags = (flags << 1) | static_cast<std::size_t>(symbol.is_macro);
+  flags = (flags << 1) | static_cast<std::size_t>(symbol.is_exported);
+  flags = (flags << 1) | static_cast<std::size_t>(symbol.is_input);
+  flags = (flags << 1) | static_cast<std::size_t>(symbol.is_output);
+  flags = (flags << 1) | static_cast<std::size_t>(symbol.is_state_var);
+  flags = (flags << 1) | static_cast<std::size_t>(symbol.is_parameter);
+  flags = (flags << 1) | static_cast<std::size_t>(symbol.is_auxiliary);
+  flags = (flags << 1) | static_cast<std::size_t>(symbol.is_lvalue);
+  flags = (flags << 1) | static_cast<std::size_t>(symbol.is_static_lifetime);
+  flags = (flags << 1) | static_cast<std::size_t>(symbol.is_thread_local);
+  flags = (flags << 1) | static_cast<std::size_t>(symbol.is_file_local);
+  flags = (flags << 1) | static_cast<std::size_t>(symbol.is_extern);
+  flags = (flags << 1) | static_cast<std::size_t>(symbol.is_volatile);
+  write_gb_word(out, flags);
+}
+
+static symbolt read_symbol(std::istream &in, irep_serializationt &irepconverter)
+{
+  symbolt symbol;
+
+  symbol.type = static_cast<const typet &>(irepconverter.reference_convert(in));
+  symbol.value =
+    static_cast<const exprt &>(irepconverter.reference_convert(in));
+  symbol.location =
+    static_cast<const source_locationt &>(irepconverter.reference_convert(in));
+
+  symbol.name = irepconverter.read_string_ref(in);
+  symbol.module = irepconverter.read_string_ref(in);
+  symbol.base_name = irepconverter.read_string_ref(in);
+  symbol.mode = irepconverter.read_string_ref(in);
+  symbol.pretty_name = irepconverter.read_string_ref(in);
+
+  const std::size_t flags = irep_serializationt::read_gb_word(in);
+  symbol.is_weak = (flags & (1 << 15)) != 0;
+  symbol.is_type = (flags & (1 << 14)) != 0;
+  symbol.is_property = (flags & (1 << 13)) != 0;
+  symbol.is_macro = (flags & (1 << 12)) != 0;
+  symbol.is_exported = (flags & (1 << 11)) != 0;
+  symbol.is_input = (flags & (1 << 10)) != 0;
+  symbol.is_output = (flags & (1 << 9)) != 0;
+  symbol.is_state_var = (flags & (1 << 8)) != 0;
+  symbol.is_parameter = (flags & (1 << 7)) != 0;
+  symbol.is_auxiliary = (flags & (1 << 6)) != 0;
+  symbol.is_lvalue = (flags & (1 << 5)) != 0;
+  symbol.is_static_lifetime = (flags & (1 << 4)) != 0;
+  symbol.is_thread_local = (flags & (1 << 3)) != 0;
+  symbol.is_file_local = (flags & (1 << 2)) != 0;
+  symbol.is_extern = (flags & (1 << 1)) != 0;
+  symbol.is_volatile = (flags & 1) != 0;
+
+  return symbol;
+}
+
+bool java_method_cachet::load(
+  const irep_idt &method_id,
+  symbol_table_baset &symbol_table,
+  optionalt<ci_lazy_methods_neededt> &needed_lazy_methods)
+{
+  std::ifstream in(file_name(method_id), std::ios::binary);
+  if(!in)
+  {
+    ++misses;
+    return false;
+  }
+
+  irep_serializationt::ireps_containert ireps_container;
+  irep_serializationt irepconverter(ireps_container);
+
+  // Reject files of other fingerprints or methods whose names collide
+  if(
+    irepconverter.read_gb_string(in) != fingerprint ||
+    irepconverter.read_gb_string(in) != method_id)
+  {
+    ++misses;
+    return false;
+  }
+
+  ci_lazy_methods_neededt::recordt needs;
+  needs.methods.resize(irep_serializationt::read_gb_word(in));
+  for(auto &method : needs.methods)
+    method = irepconverter.read_string_ref(in);
+  needs.classes.resize(irep_serializationt::read_gb_word(in));
+  for(auto &class_name : needs.classes)
+    class_name = irepconverter.read_string_ref(in);
+  needs.pointer_types.resize(irep_serializationt::read_gb_word(in));
+  for(auto &pointer_type : needs.pointer_types)
+  {
+    pointer_type =
+      static_cast<const typet &>(irepconverter.reference_convert(in));
+  }
+
+  std::vector<symbolt> symbols(irep_serializationt::read_gb_word(in));
+  for(auto &symbol : symbols)
+    symbol = read_symbol(in, irepconverter);
+
+  if(!in)
+  {
+    ++misses;
+    return false;
+  }
+
+  // The conversion must start from the same state as the cached one: the
+  // method has no body yet, and none of the symbols it inserted exist
+  for(const auto &symbol : symbols)
+  {
+    const symbolt *existing = symbol_table.lookup(symbol.name);
+    if(
+      symbol.name == method_id
+        ? existing == nullptr || existing->value.is_not_nil()
+        : existing != nullptr)
+    {
+      ++misses;
+      return false;
+    }
+  }
+
+  for(auto &symbol : symbols)
+  {
+    if(symbol.name == method_id)
+      symbol_table.get_writeable_ref(method_id) = std::move(symbol);
+    else
+      symbol_table.insert(std::move(symbol));
+  }
+
+  if(needed_lazy_methods)
+    needed_lazy_methods->replay(needs);
+
+  ++hits;
+  return true;
+}
+
+void java_method_cachet::store(
+  const irep_idt &method_id,
+  const journalling_symbol_tablet &journal,
+  const ci_lazy_methods_neededt::recordt &needs)
+{
+  // Only conversions that do not change any other existing symbol can be
+  // repeated independently of the order in which methods are converted
+  if(!journal.get_removed().empty())
+    return;
+  for(const auto &updated : journal.get_updated())
+  {
+    if(updated != method_id && journal.get_inserted().count(updated) == 0)
+      return;
+  }
+  const auto &inserted_symbols = journal.get_inserted();
+  PRECONDITION(inserted_symbols.count(method_id) == 0);
+  if(inserted_symbols.size() + 1 > max_symbols_per_entry)
+    return;
+
+  std::ostringstream out;
+  irep_serializationt::ireps_containert ireps_container;
+  irep_serializationt irepconverter(ireps_container);
+
+  write_gb_string(out, fingerprint);
+  write_gb_string(out, id2string(method_id));
+
+  write_gb_word(out, needs.methods.size());
+  for(const auto &method : needs.methods)
+    irepconverter.write_string_ref(out, method);
+  write_gb_word(out, needs.classes.size());
+  for(const auto &class_name : needs.classes)
+    irepconverter.write_string_ref(out, class_name);
+  write_gb_word(out, needs.pointer_types.size());
+  for(const auto &pointer_type : needs.pointer_types)
+    irepconverter.reference_convert(pointer_type, out);
+
+  write_gb_word(out, inserted_symbols.size() + 1);
+  write_symbol(out, journal.lookup_ref(method_id), irepconverter);
+  for(const auto &inserted : inserted_symbols)
+    write_symbol(out, journal.lookup_ref(inserted), irepconverter);
+
+  // Write to a file of a unique name first, such that concurrent runs never
+  // read a partially written entry
+  const std::string target = file_name(method_id);
+  const std::string temporary =
+    target + "." + to_hex(std::random_device{}()) + ".tmp";
+  {
+    std::ofstream file(temporary, std::ios::binary);
+    file << out.str();
+    if(!file)
+    {
+      std::remove(temporary.c_str());
+      return;
+    }
+  }
+
+  if(std::rename(temporary.c_str(), target.c_str()) != 0)
+    std::remove(temporary.c_str());
+}
@@ -0,0 +1,88 @@
+/*******************************************************************\
+
+Module: Cache of Converted Java Methods
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// An on-disk cache of the results of converting Java methods to code
+
+#ifndef CPROVER_JAVA_BYTECODE_JAVA_METHOD_CACHE_H
+#define CPROVER_JAVA_BYTECODE_JAVA_METHOD_CACHE_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <util/journalling_symbol_table.h>
+#include <util/optional.h>
+
+#include "ci_lazy_methods_needed.h"
+
+class optionst;
+
+/// Keeps the effects of converting method bodies in files in a directory, such
+/// that later runs can repeat them instead of converting the method again.
+///
+/// The effects of a conversion are the symbols it inserted or updated,
+/// including the method symbol and its body, and the methods and classes it
+/// reported as needed to lazy loading. Conversion is deterministic, but it
+/// reads more than the bytecode of the method itself, for example whether
+/// other classes have static initializers. Hence entries are keyed by a
+/// fingerprint of the conversion options and of all loaded class files, so
+/// that they are only used by runs that load the same classes with the same
+/// options, and in which the symbol table is therefore in the same state when
+/// the method is converted.
+class java_method_cachet
+{
+public:
+  /// \param _directory: directory of the cache files, which is created if it
+  ///   does not exist
+  /// \param options: command-line options of the run
+  java_method_cachet(std::string _directory, const optionst &options);
+
+  /// Complete the fingerprint once all classes have been loaded, which must
+  /// happen before any call to \ref load or \ref store
+  /// \param class_file_checksums: checksums of the class files of all loaded
+  ///   classes, which are empty for classes that were not found
+  void set_loaded_classes(
+    const std::map<irep_idt, std::vector<std::uint32_t>> &class_file_checksums);
+
+  /// Repeat the conversion of \p method_id if it is in the cache
+  /// \param method_id: the method to be converted
+  /// \param symbol_table: the symbol table to update
+  /// \param needed_lazy_methods: receives the methods and classes that the
+  ///   conversion reported as needed
+  /// \return True iff the method was found in the cache
+  bool load(
+    const irep_idt &method_id,
+    symbol_table_baset &symbol_table,
+    optionalt<ci_lazy_methods_neededt> &needed_lazy_methods);
+
+  /// Store the effects of converting \p method_id
+  /// \param method_id: the method that was converted
+  /// \param journal: the symbol table that the method was converted in
+  /// \param needs: the methods and classes that the conversion reported as
+  ///   needed
+  void store(
+    const irep_idt &method_id,
+    const journalling_symbol_tablet &journal,
+    const ci_lazy_methods_neededt::recordt &needs);
+
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+
+protected:
+  std::string directory;
+  /// The options that conversion depends on
+  std::string options_key;
+  /// Digest of the options and class files that conversion depends on
+  std::string fingerprint;
+
+  std::string file_name(const irep_idt &method_id) const;
+};
+
+#endif // CPROVER_JAVA_BYTECODE_JAVA_METHOD_CACHE_H
@@ -24,6 +24,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "java_string_literals.h"
 #include "java_utils.h"
 
+#include <algorithm>
+#include <set>
+#include <sstream>
+
 class java_object_factoryt
 {
   const java_object_factory_parameterst object_factory_parameters;
@@ -138,6 +142,14 @@ private:
     const typet &element_type,
     size_t depth,
     const source_locationt &location);
+
+  bool can_share_initializer(const typet &target_type, lifetimet lifetime)
+    const;
+
+  symbol_exprt gen_shared_initializer(
+    const struct_tag_typet &target_type,
+    size_t depth,
+    const source_locationt &location);
 };
 
 /// Initializes the pointer-typed lvalue expression `expr` to point to an object
@@ -235,6 +247,16 @@ void java_object_factoryt::gen_pointer_target_init(
   {
     init_expr = allocate_objects.allocate_object(
       assignments, expr, target_type, lifetime, "tmp_object_factory");
+
+    if(can_share_initializer(target_type, lifetime))
+    {
+      const symbol_exprt initializer = gen_shared_initializer(
+        to_struct_tag_type(target_type), depth + 1, location);
+      code_function_callt call{initializer, {address_of_exprt{init_expr}}};
+      call.add_source_location() = location;
+      assignments.add(std::move(call));
+      return;
+    }
   }
   else
   {
@@ -258,6 +280,134 @@ void java_object_factoryt::gen_pointer_target_init(
     location);
 }
 
+/// Decide whether a new object of type \p target_type can be initialized by
+/// a call to a function generated by \ref gen_shared_initializer. This is
+/// only the case for objects that are allocated afresh on each call, and
+/// when no type arguments are in scope that the initialization of the fields
+/// would depend on.
+bool java_object_factoryt::can_share_initializer(
+  const typet &target_type,
+  lifetimet lifetime) const
+{
+  return object_factory_parameters.share_nondet_initializers &&
+         lifetime == lifetimet::DYNAMIC &&
+         target_type.id() == ID_struct_tag &&
+         generic_parameter_specialization_map.empty();
+}
+
+/// Get the function that nondet-initializes an object of type
+/// \p target_type, generating it if it does not exist yet. The function
+/// takes a pointer to the object, and its body is the code that
+/// \ref gen_nondet_init would otherwise emit inline:
+///
+/// \code
+///   void java::A.<nondet_init>:...(A *this)
+///   {
+///     *this = { .@class_identifier = "java::A", ... };
+///     this->x = NONDET(int);
+///     this->next = ... // allocation and initialization of another object
+///   }
+/// \endcode
+///
+/// That code only depends on the type, on the depth (up to the point beyond
+/// which the tree-depth limits all apply) and on the set of types that the
+/// object is nested in. Objects that agree on these share the function, which
+/// keeps the code for object trees with repeated or recursive types linear
+/// in the depth of the tree rather than in its size.
+/// \param target_type: type of the object to initialize
+/// \param depth: number of times that a pointer has been dereferenced from
+///   the root of the object tree to reach the object
+/// \param location: source location associated with nondet-initialization
+/// \return The symbol of the function
+symbol_exprt java_object_factoryt::gen_shared_initializer(
+  const struct_tag_typet &target_type,
+  size_t depth,
+  const source_locationt &location)
+{
+  // Beyond this depth, the limits on the depth of the tree all apply
+  depth = std::min(
+    depth,
+    std::max(
+      object_factory_parameters.max_nondet_tree_depth,
+      object_factory_parameters.min_null_tree_depth + 1));
+
+  std::ostringstream key;
+  for(const auto &tag : std::set<irep_idt>(
+        recursion_set.begin(), recursion_set.end()))
+  {
+    key << tag << ';';
+  }
+  key << '\n'
+      << object_factory_parameters.max_nondet_array_length << ' '
+      << object_factory_parameters.max_nondet_string_length << ' '
+      << object_factory_parameters.min_nondet_string_length << ' '
+      << object_factory_parameters.string_printable << ' '
+      << object_factory_parameters.assume_inputs_interval.to_string() << ' '
+      << object_factory_parameters.assume_inputs_integral << '\n';
+  for(const auto &value : object_factory_parameters.string_input_values)
+    key << value << '\n';
+
+  std::ostringstream function_name;
+  function_name << id2string(target_type.get_identifier()) << ".<nondet_init>:"
+                << depth << ':' << std::hex
+                << std::hash<std::string>{}(key.str());
+  const irep_idt function_id = function_name.str();
+
+  if(const symbolt *existing = symbol_table.lookup(function_id))
+    return existing->symbol_expr();
+
+  java_method_typet::parametert this_param{pointer_type(target_type)};
+  this_param.set_base_name("this");
+  this_param.set_identifier(id2string(function_id) + "::this");
+
+  parameter_symbolt this_symbol;
+  this_symbol.name = this_param.get_identifier();
+  this_symbol.base_name = this_param.get_base_name();
+  this_symbol.mode = ID_java;
+  this_symbol.type = this_param.type();
+  symbol_table.add(this_symbol);
+
+  symbolt function_symbol;
+  function_symbol.name = function_id;
+  function_symbol.pretty_name = function_id;
+  function_symbol.base_name = "<nondet_init>";
+  function_symbol.mode = ID_java;
+  function_symbol.location = location;
+  function_symbol.type = java_method_typet{{this_param}, java_void_type()};
+  // Add the symbol before generating the body, such that generating the body
+  // never starts on the same function again
+  symbol_table.add(function_symbol);
+
+  java_object_factory_parameterst parameters = object_factory_parameters;
+  parameters.function_id = function_id;
+  java_object_factoryt state(
+    location,
+    parameters,
+    symbol_table,
+    pointer_type_selector,
+    log.get_message_handler());
+  state.recursion_set = recursion_set;
+
+  code_blockt assignments;
+  state.gen_nondet_init(
+    assignments,
+    dereference_exprt{this_symbol.symbol_expr()},
+    false, // is_sub
+    false, // skip_classid
+    lifetimet::DYNAMIC,
+    {}, // no override_type
+    depth,
+    update_in_placet::NO_UPDATE_IN_PLACE,
+    location);
+
+  code_blockt body;
+  state.declare_created_symbols(body);
+  body.append(assignments);
+  symbol_table.get_writeable_ref(function_id).value = std::move(body);
+
+  return function_symbol.symbol_expr();
+}
+
 /// Recursion-set entry owner class. If a recursion-set entry is added
 /// in a particular scope, ensures that it is erased on leaving
 /// that scope.
@@ -39,6 +39,8 @@ void java_object_factory_parameterst::set(const optionst &options)
     assume_inputs_interval = *interval;
   }
   assume_inputs_integral = options.is_set("java-assume-inputs-integral");
+  share_nondet_initializers =
+    options.is_set("java-share-nondet-initializers");
 }
 
 void parse_java_object_factory_options(
@@ -57,4 +59,8 @@ void parse_java_object_factory_options(
   {
     options.set_option("java-assume-inputs-integral", true);
   }
+  if(cmdline.isset("java-share-nondet-initializers"))
+  {
+    options.set_option("java-share-nondet-initializers", true);
+  }
 }
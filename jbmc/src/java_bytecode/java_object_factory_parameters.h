@@ -29,6 +29,11 @@ struct java_object_factory_parameterst final : public object_factory_parameterst
   /// Force double and float inputs to be integral
   bool assume_inputs_integral;
 
+  /// Initialize each kind of dynamically allocated object by a call to a
+  /// generated function, which is shared by all objects of the same kind,
+  /// rather than by inline code
+  bool share_nondet_initializers = false;
+
   /// Assigns the parameters from given options
   void set(const optionst &);
 };
@@ -390,6 +390,19 @@ public:
     return get_bool(ID_incomplete_class);
   }
 
+  /// may the class have instances, as found by context-insensitive lazy
+  /// method loading?
+  bool get_is_instantiated() const
+  {
+    return get_bool(ID_C_java_instantiated);
+  }
+
+  /// marks class as possibly having instances
+  void set_is_instantiated(bool is_instantiated)
+  {
+    set(ID_C_java_instantiated, is_instantiated);
+  }
+
   /// is class an enumeration?
   bool get_is_enumeration() const
   {
@@ -34,16 +34,6 @@ static std::string escape_symbol_special_chars(std::string input)
   return input;
 }
 
-irep_idt lambda_synthetic_class_name(
-  const irep_idt &method_identifier,
-  std::size_t instruction_address)
-{
-  return "java::lambda_synthetic_class$" +
-         escape_symbol_special_chars(
-           id2string(strip_java_namespace_prefix(method_identifier))) +
-         "$" + std::to_string(instruction_address);
-}
-
 /// Retrieves the symbol of the lambda method associated with the given
 /// lambda method handle (bootstrap method).
 /// \param symbol_table: global symbol table
@@ -71,7 +61,7 @@ static optionalt<symbolt> get_lambda_method_symbol(
 }
 
 static optionalt<irep_idt> lambda_method_name(
-  const symbol_tablet &symbol_table,
+  const symbol_table_baset &symbol_table,
   const irep_idt &method_identifier,
   const java_method_typet &dynamic_method_type)
 {
@@ -91,6 +81,34 @@ static optionalt<irep_idt> lambda_method_name(
   return {};
 }
 
+optionalt<irep_idt> lambda_synthetic_class_name(
+  const symbol_table_baset &symbol_table,
+  const irep_idt &method_identifier,
+  const java_method_typet &dynamic_method_type)
+{
+  const auto lambda_method_name =
+    ::lambda_method_name(symbol_table, method_identifier, dynamic_method_type);
+  if(!lambda_method_name)
+    return {};
+
+  const auto &functional_interface_tag = to_struct_tag_type(
+    to_java_reference_type(dynamic_method_type.return_type()).subtype());
+
+  // Sites that implement the same interface by the same method with captures
+  // of the same types share the class, whose name must hence only depend on
+  // these.
+  std::string name =
+    "java::lambda_synthetic_class$" +
+    escape_symbol_special_chars(
+      id2string(strip_java_namespace_prefix(*lambda_method_name))) +
+    "$" +
+    escape_symbol_special_chars(id2string(
+      strip_java_namespace_prefix(functional_interface_tag.get_identifier())));
+  for(const auto &parameter : dynamic_method_type.parameters())
+    name += "$" + escape_symbol_special_chars(pretty_java_type(parameter.type()));
+  return irep_idt(name);
+}
+
 static optionalt<irep_idt> interface_method_id(
   const symbol_tablet &symbol_table,
   const struct_tag_typet &functional_interface_tag,
@@ -318,6 +336,15 @@ void create_invokedynamic_synthetic_classes(
                   << " with unknown handle type" << messaget::eom;
       continue;
     }
+    const irep_idt synthetic_class_name = *lambda_synthetic_class_name(
+      symbol_table, method_identifier, dynamic_method_type);
+    if(symbol_table.has_symbol(synthetic_class_name))
+    {
+      log.debug() << "reusing " << synthetic_class_name
+                  << " for invokedynamic at " << method_identifier
+                  << " address " << instruction.address << messaget::eom;
+      continue;
+    }
     const auto &functional_interface_tag = to_struct_tag_type(
       to_java_reference_type(dynamic_method_type.return_type()).subtype());
     const auto interface_method_id = ::interface_method_id(
@@ -331,8 +358,6 @@ void create_invokedynamic_synthetic_classes(
     log.debug() << "identified invokedynamic at " << method_identifier
                 << " address " << instruction.address
                 << " for lambda: " << *lambda_method_name << messaget::eom;
-    const irep_idt synthetic_class_name =
-      lambda_synthetic_class_name(method_identifier, instruction.address);
     symbol_table.add(constructor_symbol(
       synthetic_methods, synthetic_class_name, dynamic_method_type));
     symbol_table.add(implemented_method_symbol(
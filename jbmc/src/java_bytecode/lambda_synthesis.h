@@ -15,15 +15,27 @@ Author: Diffblue Ltd.
 #include <java_bytecode/java_bytecode_parse_tree.h>
 #include <java_bytecode/synthetic_methods_map.h>
 #include <util/irep.h>
+#include <util/optional.h>
 
 class message_handlert;
 class codet;
+class java_method_typet;
 class symbol_table_baset;
 class symbol_tablet;
 
-irep_idt lambda_synthetic_class_name(
+/// The name of the synthetic class that implements the functional interface
+/// for an invokedynamic instruction. Sites that implement the same interface
+/// by the same lambda method and capture values of the same types share the
+/// class, and its methods are only converted once.
+/// \param symbol_table: global symbol table
+/// \param method_identifier: the method that contains the instruction
+/// \param dynamic_method_type: the type of the instruction's call site
+/// \return the name of the class, or nothing if the lambda method handle is
+///   not understood
+optionalt<irep_idt> lambda_synthetic_class_name(
+  const symbol_table_baset &symbol_table,
   const irep_idt &method_identifier,
-  std::size_t instruction_address);
+  const java_method_typet &dynamic_method_type);
 
 void create_invokedynamic_synthetic_classes(
   const irep_idt &method_identifier,
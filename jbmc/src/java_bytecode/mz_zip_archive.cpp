@@ -14,6 +14,13 @@ Author: Diffblue Ltd
 #define _LARGEFILE64_SOURCE 1
 #include <miniz/miniz.h>
 
+#ifndef _WIN32
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
 // Original struct is an anonymous struct with a typedef, This is
 // required to remove internals from the header file
 class mz_zip_archive_statet final:public mz_zip_archive
@@ -22,6 +29,40 @@ public:
   explicit mz_zip_archive_statet(const std::string &filename):
     mz_zip_archive({ })
   {
+#ifndef _WIN32
+    // Map the archive into memory, such that miniz reads the central
+    // directory and entries from the page cache rather than through stdio,
+    // and stored entries can be accessed in place
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if(fd >= 0)
+    {
+      struct stat file_stat;
+      if(fstat(fd, &file_stat) == 0 && file_stat.st_size > 0)
+      {
+        const size_t size = static_cast<size_t>(file_stat.st_size);
+        void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(mapping != MAP_FAILED)
+        {
+          m_mapping = mapping;
+          m_mapping_size = size;
+        }
+      }
+      close(fd);
+    }
+
+    if(m_mapping != nullptr)
+    {
+      if(MZ_TRUE != mz_zip_reader_init_mem(this, m_mapping, m_mapping_size, 0))
+      {
+        munmap(m_mapping, m_mapping_size);
+        throw std::runtime_error("MZT: Could not load a file: " + filename);
+      }
+      m_data = static_cast<const unsigned char *>(m_mapping);
+      m_size = m_mapping_size;
+      return;
+    }
+#endif
+
     if(MZ_TRUE!=mz_zip_reader_init_file(this, filename.data(), 0))
       throw std::runtime_error("MZT: Could not load a file: "+filename);
   }
@@ -31,6 +72,8 @@ public:
   {
     if(MZ_TRUE!=mz_zip_reader_init_mem(this, data, size, 0))
       throw std::runtime_error("MZT: Could not load data from memory");
+    m_data = static_cast<const unsigned char *>(data);
+    m_size = size;
   }
 
   mz_zip_archive_statet(const mz_zip_archive_statet &)=delete;
@@ -40,7 +83,19 @@ public:
   ~mz_zip_archive_statet()
   {
     mz_zip_reader_end(this);
+#ifndef _WIN32
+    if(m_mapping != nullptr)
+      munmap(m_mapping, m_mapping_size);
+#endif
   }
+
+  /// The archive, if it is held in memory, else nullptr
+  const unsigned char *m_data = nullptr;
+  size_t m_size = 0;
+
+private:
+  void *m_mapping = nullptr;
+  size_t m_mapping_size = 0;
 };
 
 static_assert(sizeof(mz_uint)<=sizeof(size_t),
@@ -104,6 +159,65 @@ std::string mz_zip_archivet::extract(const size_t index)
   throw std::runtime_error("Could not extract the file");
 }
 
+std::uint32_t mz_zip_archivet::get_crc32(const size_t index)
+{
+  const auto id = static_cast<mz_uint>(index);
+  mz_zip_archive_file_stat file_stat = {};
+  if(mz_zip_reader_file_stat(m_state.get(), id, &file_stat) != MZ_TRUE)
+    throw std::runtime_error("Could not read the file's checksum");
+  return file_stat.m_crc32;
+}
+
+const char *mz_zip_archivet::get_stored_data(const size_t index, size_t &size)
+{
+  const mz_zip_archive_statet &state = *m_state;
+  if(state.m_data == nullptr)
+    return nullptr;
+
+  const auto id = static_cast<mz_uint>(index);
+  mz_zip_archive_file_stat file_stat = {};
+  if(
+    mz_zip_reader_file_stat(m_state.get(), id, &file_stat) != MZ_TRUE ||
+    file_stat.m_method != 0 || file_stat.m_is_encrypted ||
+    file_stat.m_comp_size != file_stat.m_uncomp_size)
+  {
+    return nullptr;
+  }
+
+  // The data follows the local header, whose name and extra field may
+  // differ in length from those in the central directory
+  const size_t local_header_size = 30;
+  const mz_uint64 header = file_stat.m_local_header_ofs;
+  if(header + local_header_size > state.m_size)
+    return nullptr;
+
+  const unsigned char *local_header = state.m_data + header;
+  const auto read_le16 = [local_header](size_t offset) {
+    return static_cast<mz_uint64>(local_header[offset]) |
+           static_cast<mz_uint64>(local_header[offset + 1]) << 8;
+  };
+  const mz_uint32 signature = 0x04034b50;
+  if(
+    read_le16(0) != (signature & 0xffff) ||
+    read_le16(2) != (signature >> 16))
+  {
+    return nullptr;
+  }
+
+  const mz_uint64 offset =
+    header + local_header_size + read_le16(26) + read_le16(28);
+  if(offset + file_stat.m_comp_size > state.m_size)
+    return nullptr;
+
+  const unsigned char *data = state.m_data + offset;
+  const size_t data_size = static_cast<size_t>(file_stat.m_comp_size);
+  if(mz_crc32(MZ_CRC32_INIT, data, data_size) != file_stat.m_crc32)
+    return nullptr;
+
+  size = data_size;
+  return reinterpret_cast<const char *>(data);
+}
+
 void mz_zip_archivet::extract_to_file(
   const size_t index,
   const std::string &path)
@@ -9,6 +9,7 @@ Author: Diffblue Ltd
 #ifndef CPROVER_JAVA_BYTECODE_MZ_ZIP_ARCHIVE_H
 #define CPROVER_JAVA_BYTECODE_MZ_ZIP_ARCHIVE_H
 
+#include <cstdint>
 #include <string>
 #include <memory>
 
@@ -51,6 +52,19 @@ public:
   /// \throw Throws std::runtime_error if file cannot be extracted
   /// \return Contents of the file in the archive
   std::string extract(size_t index);
+  /// Get contents of nth file in the archive without copying them, which is
+  /// possible if the archive is held in memory, for example because it was
+  /// mapped from a file, and the file is stored without compression
+  /// \param index: id of the file in the archive
+  /// \param [out] size: size of the contents
+  /// \return Pointer to the contents, valid as long as this object, or
+  ///   nullptr if the contents cannot be accessed in place
+  const char *get_stored_data(size_t index, size_t &size);
+  /// Get the CRC-32 checksum of the contents of nth file in the archive, as
+  /// recorded in the central directory
+  /// \param index: id of the file in the archive
+  /// \throw Throws std::runtime_error if the file does not exist
+  std::uint32_t get_crc32(size_t index);
   /// Write contents of nth file in the archive to a file
   /// \param index: id of the file in the archive
   /// \param path:  path to which to write the contents of the file
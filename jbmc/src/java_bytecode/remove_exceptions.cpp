@@ -149,7 +149,8 @@ protected:
     goto_programt &goto_program,
     const goto_programt::targett &instr_it,
     const stack_catcht &stack_catch,
-    const std::vector<symbol_exprt> &locals);
+    const std::vector<symbol_exprt> &locals,
+    const typet &exception_type);
 
   bool instrument_throw(
     const irep_idt &function_identifier,
@@ -321,12 +322,15 @@ goto_programt::targett remove_exceptionst::find_universal_exception(
 ///   exception source
 /// \param stack_catch: exception handlers currently registered
 /// \param locals: local variables to kill on a function-exit edge
+/// \param exception_type: static type of the in-flight exception, which lets
+///   instanceof checks skip the handlers that cannot match
 void remove_exceptionst::add_exception_dispatch_sequence(
   const irep_idt &function_identifier,
   goto_programt &goto_program,
   const goto_programt::targett &instr_it,
   const remove_exceptionst::stack_catcht &stack_catch,
-  const std::vector<symbol_exprt> &locals)
+  const std::vector<symbol_exprt> &locals,
+  const typet &exception_type)
 {
   // Jump to the universal handler or function end, as appropriate.
   // This will appear after the GOTO-based dynamic dispatch below
@@ -368,7 +372,11 @@ void remove_exceptionst::add_exception_dispatch_sequence(
         // use instanceof to check that this is the correct handler
         struct_tag_typet type(stack_catch[i][j].first);
 
-        java_instanceof_exprt check(exc_thrown, type);
+        const exprt thrown =
+          exception_type == exc_thrown.type()
+            ? static_cast<const exprt &>(exc_thrown)
+            : typecast_exprt(exc_thrown, exception_type);
+        java_instanceof_exprt check(thrown, type);
         t_exc->guard=check;
 
         if(remove_added_instanceof)
@@ -410,8 +418,15 @@ bool remove_exceptionst::instrument_throw(
   const exprt &exc_expr=
     uncaught_exceptions_domaint::get_exception_symbol(instr_it->code);
 
+  // The thrown object is a subtype of the static type of the thrown
+  // expression, hence handlers for unrelated types cannot catch it
   add_exception_dispatch_sequence(
-    function_identifier, goto_program, instr_it, stack_catch, locals);
+    function_identifier,
+    goto_program,
+    instr_it,
+    stack_catch,
+    locals,
+    exc_expr.type());
 
   // find the symbol where the thrown exception should be stored:
   symbol_exprt exc_thrown =
@@ -471,7 +486,12 @@ remove_exceptionst::instrument_function_call(
     else
     {
       add_exception_dispatch_sequence(
-        function_identifier, goto_program, instr_it, stack_catch, locals);
+        function_identifier,
+        goto_program,
+        instr_it,
+        stack_catch,
+        locals,
+        get_inflight_exception_global().type());
 
       // add a null check (so that instanceof can be applied)
       goto_program.insert_after(
@@ -20,6 +20,7 @@ Author: Chris Smowton, chris.smowton@diffblue.com
 
 #include <util/arith_tools.h>
 
+#include <algorithm>
 #include <sstream>
 
 class remove_instanceoft
@@ -61,20 +62,54 @@ protected:
 /// Produce an expression of the form
 /// `classid_field == "A" || classid_field == "B" || ...`
 /// where A, B, ... are the possible subtypes of \p target_type.
+/// If \p static_type is given, the runtime type is known to be one of its
+/// subtypes, so that only those subtypes of \p target_type that are also
+/// subtypes of \p static_type need to be tested for. In particular the test is
+/// trivially true when \p static_type is itself a subtype of \p target_type.
 /// \param classid_field: field to compare, usually a `@class_identifier` field
 ///   denoting an object's runtime type
 /// \param target_type: the type all of whose subtypes (including itself) should
 ///   be accepted
+/// \param static_type: the static type of the object whose runtime type is
+///   tested, or the empty string if it is unknown
 /// \param class_hierarchy: class hierarchy
 /// \return disjunction of the possible matched subtypes
 static exprt subtype_expr(
   const exprt &classid_field,
   const irep_idt &target_type,
+  const irep_idt &static_type,
   const class_hierarchyt &class_hierarchy)
 {
   std::vector<irep_idt> children =
     class_hierarchy.get_children_trans(target_type);
   children.push_back(target_type);
+
+  if(
+    !static_type.empty() &&
+    class_hierarchy.class_map.find(static_type) !=
+      class_hierarchy.class_map.end())
+  {
+    if(
+      std::find(children.begin(), children.end(), static_type) !=
+      children.end())
+    {
+      return true_exprt();
+    }
+
+    std::vector<irep_idt> static_subtypes =
+      class_hierarchy.get_children_trans(static_type);
+    std::sort(static_subtypes.begin(), static_subtypes.end());
+    children.erase(
+      std::remove_if(
+        children.begin(),
+        children.end(),
+        [&static_subtypes](const irep_idt &class_name) {
+          return !std::binary_search(
+            static_subtypes.begin(), static_subtypes.end(), class_name);
+        }),
+      children.end());
+  }
+
   // Sort alphabetically to make order of generated disjuncts
   // independent of class loading order
   std::sort(
@@ -174,6 +209,15 @@ bool remove_instanceoft::lower_instanceof(
 
   auto jlo = to_struct_tag_type(java_lang_object_type().subtype());
 
+  // The static type of the checked pointer bounds its runtime type, as in
+  // remove_virtual_functions, which allows dropping impossible subtypes
+  const typet &pointed_type = check_ptr.type().subtype();
+  const irep_idt static_type =
+    pointed_type.id() == ID_struct_tag &&
+        to_struct_tag_type(pointed_type) != jlo
+      ? to_struct_tag_type(pointed_type).get_identifier()
+      : irep_idt();
+
   exprt object_class_identifier_field =
     get_class_identifier_field(check_ptr, jlo, ns);
 
@@ -202,15 +246,19 @@ bool remove_instanceoft::lower_instanceof(
       test_conjuncts.push_back(subtype_expr(
         get_array_element_type_field(check_ptr),
         underlying_type.get_identifier(),
+        irep_idt(),
         class_hierarchy));
     }
   }
   else if(target_type != jlo)
   {
-    test_conjuncts.push_back(subtype_expr(
+    exprt subtype_test = subtype_expr(
       get_class_identifier_field(check_ptr, jlo, ns),
       target_type.get_identifier(),
-      class_hierarchy));
+      static_type,
+      class_hierarchy);
+    if(!subtype_test.is_true())
+      test_conjuncts.push_back(std::move(subtype_test));
   }
 
   expr = conjunction(test_conjuncts);
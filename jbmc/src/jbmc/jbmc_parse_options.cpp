@@ -61,6 +61,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <langapi/mode.h>
 
+#include <java_bytecode/ci_lazy_methods.h>
 #include <java_bytecode/convert_java_nondet.h>
 #include <java_bytecode/java_bytecode_language.h>
 #include <java_bytecode/java_enum_static_init_unwind_handler.h>
@@ -203,6 +204,27 @@ void jbmc_parse_optionst::get_command_line_options(optionst &options)
       "symex-complexity-limit", cmdline.get_value("symex-complexity-limit"));
   }
 
+  if(cmdline.isset("simplify-cache-size"))
+  {
+    options.set_option(
+      "simplify-cache-size", cmdline.get_value("simplify-cache-size"));
+  }
+
+  if(cmdline.isset("symex-cache-dereferences"))
+    options.set_option("symex-cache-dereferences", true);
+
+  if(cmdline.isset("allocation-site-bound"))
+  {
+    options.set_option(
+      "allocation-site-bound", cmdline.get_value("allocation-site-bound"));
+  }
+
+  if(cmdline.isset("symex-guard-bdd-nodes"))
+  {
+    options.set_option(
+      "symex-guard-bdd-nodes", cmdline.get_value("symex-guard-bdd-nodes"));
+  }
+
   if(cmdline.isset("symex-complexity-failed-child-loops-limit"))
   {
     options.set_option(
@@ -210,6 +232,13 @@ void jbmc_parse_optionst::get_command_line_options(optionst &options)
       cmdline.get_value("symex-complexity-failed-child-loops-limit"));
   }
 
+  if(cmdline.isset("symex-complexity-cost-limit"))
+  {
+    options.set_option(
+      "symex-complexity-cost-limit",
+      cmdline.get_value("symex-complexity-cost-limit"));
+  }
+
   if(cmdline.isset("unwind"))
     options.set_option("unwind", cmdline.get_value("unwind"));
 
@@ -268,6 +297,30 @@ void jbmc_parse_optionst::get_command_line_options(optionst &options)
     "slice-formula",
     cmdline.isset("slice-formula"));
 
+  options.set_option(
+    "propagate-assignments", cmdline.isset("propagate-assignments"));
+
+  if(cmdline.isset("cube-depth"))
+    options.set_option("cube-depth", cmdline.get_value("cube-depth"));
+
+  if(cmdline.isset("sat-hot-spots"))
+    options.set_option("sat-hot-spots", cmdline.get_value("sat-hot-spots"));
+
+  if(cmdline.isset("paths-merge-regions"))
+  {
+    options.set_option(
+      "paths-merge-regions", cmdline.get_value("paths-merge-regions"));
+  }
+
+  if(cmdline.isset("unwind-max"))
+    options.set_option("unwind-max", cmdline.get_value("unwind-max"));
+
+  if(cmdline.isset("omit-constant-assignments"))
+    options.set_option("omit-constant-assignments", true);
+
+  if(cmdline.isset("symex-slice"))
+    options.set_option("symex-slice", true);
+
   // simplify if conditions and branches
   if(cmdline.isset("no-simplify-if"))
     options.set_option("simplify-if", false);
@@ -325,11 +378,33 @@ void jbmc_parse_optionst::get_command_line_options(optionst &options)
       "--max-nondet-string-length");
   }
 
+  if(cmdline.isset("max-string-refinement-rounds"))
+  {
+    options.set_option(
+      "max-string-refinement-rounds",
+      cmdline.get_value("max-string-refinement-rounds"));
+  }
+
+  if(cmdline.isset("string-refinement-time-limit"))
+  {
+    options.set_option(
+      "string-refinement-time-limit",
+      cmdline.get_value("string-refinement-time-limit"));
+  }
+
   if(cmdline.isset("max-node-refinement"))
     options.set_option(
       "max-node-refinement",
       cmdline.get_value("max-node-refinement"));
 
+  if(cmdline.isset("refine-schedule"))
+    options.set_option("refine-schedule", cmdline.get_value("refine-schedule"));
+
+  if(cmdline.isset("max-refinements-per-iteration"))
+    options.set_option(
+      "max-refinements-per-iteration",
+      cmdline.get_value("max-refinements-per-iteration"));
+
   // SMT Options
 
   if(cmdline.isset("smt1"))
@@ -376,6 +451,9 @@ void jbmc_parse_optionst::get_command_line_options(optionst &options)
     options.set_option("smt2", true);
   }
 
+  if(cmdline.isset("smt2-incremental"))
+    options.set_option("smt2-incremental", true);
+
   if(cmdline.isset("smt2") && !solver_set)
   {
     if(cmdline.isset("outfile"))
@@ -410,6 +488,13 @@ void jbmc_parse_optionst::get_command_line_options(optionst &options)
     options.set_option("trace", true);
   }
 
+  if(cmdline.isset("binary-trace"))
+  {
+    options.set_option("binary-trace", cmdline.get_value("binary-trace"));
+    options.set_option("stop-on-fail", true);
+    options.set_option("trace", true);
+  }
+
   if(cmdline.isset("symex-coverage-report"))
     options.set_option(
       "symex-coverage-report",
@@ -711,6 +796,8 @@ int jbmc_parse_optionst::get_goto_program(
 
   class_hierarchy =
     util_make_unique<class_hierarchyt>(lazy_goto_model.symbol_table);
+  uninstantiated_classes =
+    get_uninstantiated_classes(lazy_goto_model.symbol_table);
 
   // Show the class hierarchy
   if(cmdline.isset("show-class-hierarchy"))
@@ -797,7 +884,7 @@ void jbmc_parse_optionst::process_goto_function(
     *class_hierarchy,
     ui_message_handler);
   // Java virtual functions -> explicit dispatch tables:
-  remove_virtual_functions(function, *class_hierarchy);
+  remove_virtual_functions(function, *class_hierarchy, uninstantiated_classes);
 
   auto function_is_stub = [&symbol_table, &model](const irep_idt &id) {
     return symbol_table.lookup_ref(id).value.is_nil() &&
@@ -1133,7 +1220,11 @@ void jbmc_parse_optionst::help()
     " --cvc4                       use CVC4\n"
     " --yices                      use Yices\n"
     " --z3                         use Z3\n"
+    " --smt2-incremental           keep one SMT2 solver process for all queries\n" // NOLINT(*)
     " --refine                     use refinement procedure (experimental)\n"
+    " --refine-schedule s          refine in-order (default) or cheapest-first\n" // NOLINT(*)
+    " --max-refinements-per-iteration n\n"
+    "                              refine at most n operations per iteration\n" // NOLINT(*)
     HELP_STRING_REFINEMENT
     " --outfile filename           output formula to given file\n"
     " --arrays-uf-never            never turn arrays into uninterpreted functions\n" // NOLINT(*)
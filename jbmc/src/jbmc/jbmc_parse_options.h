@@ -12,6 +12,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_JBMC_JBMC_PARSE_OPTIONS_H
 #define CPROVER_JBMC_JBMC_PARSE_OPTIONS_H
 
+#include <unordered_set>
+
 #include <util/parse_options.h>
 #include <util/timestamper.h>
 #include <util/ui_message.h>
@@ -55,9 +57,11 @@ class optionst;
   OPT_XML_INTERFACE \
   OPT_JSON_INTERFACE \
   "(smt1)(smt2)(fpa)(cvc3)(cvc4)(boolector)(yices)(z3)(mathsat)" \
+  "(smt2-incremental)" \
   "(no-sat-preprocessor)" \
   "(beautify)" \
   "(dimacs)(refine)(max-node-refinement):(refine-arrays)(refine-arithmetic)"\
+  "(refine-schedule):(max-refinements-per-iteration):" \
   OPT_STRING_REFINEMENT \
   "(16)(32)(64)(LP64)(ILP64)(LLP64)(ILP32)(LP32)" \
   OPT_SHOW_GOTO_FUNCTIONS \
@@ -126,6 +130,9 @@ protected:
   bool stub_objects_are_not_null;
 
   std::unique_ptr<class_hierarchyt> class_hierarchy;
+  /// Classes that lazy method loading found cannot have instances, which are
+  /// left out of virtual dispatch tables
+  std::unordered_set<irep_idt> uninstantiated_classes;
 
   void get_command_line_options(optionst &);
   int get_goto_program(
@@ -0,0 +1,66 @@
+/*******************************************************************\
+
+Module: Class-File-Level Diff of JAR Files
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Class-File-Level Diff of JAR Files
+
+#include "java_class_file_diff.h"
+
+#include <util/suffix.h>
+
+#include <java_bytecode/jar_file.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+std::vector<std::string>
+unchanged_classes(const std::string &old_jar, const std::string &new_jar)
+{
+  if(!has_suffix(old_jar, ".jar") || !has_suffix(new_jar, ".jar"))
+    return {};
+
+  try
+  {
+    jar_filet old_file(old_jar);
+    jar_filet new_file(new_jar);
+
+    std::vector<std::string> result;
+    for(const auto &filename : new_file.filenames())
+    {
+      if(!has_suffix(filename, ".class"))
+        continue;
+
+      const auto old_crc32 = old_file.get_entry_crc32(filename);
+      const auto new_crc32 = new_file.get_entry_crc32(filename);
+      if(!old_crc32.has_value() || old_crc32 != new_crc32)
+        continue;
+
+      const auto old_contents = old_file.get_entry(filename);
+      if(
+        !old_contents.has_value() ||
+        old_contents != new_file.get_entry(filename))
+      {
+        continue;
+      }
+
+      // org/cprover/A.class -> org.cprover.A., the trailing dot making sure
+      // that only the methods of this very class match
+      std::string class_name =
+        filename.substr(0, filename.size() - std::string(".class").size());
+      std::replace(class_name.begin(), class_name.end(), '/', '.');
+      result.push_back(class_name + '.');
+    }
+
+    return result;
+  }
+  catch(const std::runtime_error &)
+  {
+    // not a JAR file after all, which the front end will report
+    return {};
+  }
+}
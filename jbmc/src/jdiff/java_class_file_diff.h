@@ -0,0 +1,30 @@
+/*******************************************************************\
+
+Module: Class-File-Level Diff of JAR Files
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Class-File-Level Diff of JAR Files
+
+#ifndef CPROVER_JDIFF_JAVA_CLASS_FILE_DIFF_H
+#define CPROVER_JDIFF_JAVA_CLASS_FILE_DIFF_H
+
+#include <string>
+#include <vector>
+
+/// Finds the classes whose class files are identical in two JAR files, such
+/// that only the other classes need to be converted and compared. The class
+/// files whose CRC-32 checksums in the archives differ are known to have
+/// changed without being extracted; the others are compared byte by byte.
+/// \param old_jar: the JAR file of the old version
+/// \param new_jar: the JAR file of the new version
+/// \return the names of the unchanged classes in the format of
+///   `--context-exclude`, e.g. `org.cprover.A.`, or nothing if either file is
+///   not a JAR file
+std::vector<std::string>
+unchanged_classes(const std::string &old_jar, const std::string &new_jar);
+
+#endif // CPROVER_JDIFF_JAVA_CLASS_FILE_DIFF_H
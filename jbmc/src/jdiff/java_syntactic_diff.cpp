@@ -14,6 +14,41 @@ Author: Peter Schrammel
 #include <goto-programs/goto_model.h>
 #include <java_bytecode/java_utils.h>
 
+bool java_syntactic_difft::class_access_changed(const irep_idt &class_name)
+{
+  const auto entry = access_changed.find(class_name);
+  if(entry != access_changed.end())
+    return entry->second;
+
+  const symbolt *class1 = goto_model1.symbol_table.lookup(class_name);
+  CHECK_RETURN(class1 != nullptr);
+  const symbolt *class2 = goto_model2.symbol_table.lookup(class_name);
+  CHECK_RETURN(class2 != nullptr);
+
+  bool changed = class1->type.get(ID_access) != class2->type.get(ID_access);
+  if(!changed)
+  {
+    std::unordered_map<irep_idt, irep_idt> field_access2;
+    for(const auto &field2 : to_class_type(class2->type).components())
+      field_access2.emplace(field2.get_name(), field2.get_access());
+
+    for(const auto &field1 : to_class_type(class1->type).components())
+    {
+      const auto field2 = field_access2.find(field1.get_name());
+      if(
+        field2 != field_access2.end() &&
+        field1.get_access() != field2->second)
+      {
+        changed = true;
+        break;
+      }
+    }
+  }
+
+  access_changed.emplace(class_name, changed);
+  return changed;
+}
+
 bool java_syntactic_difft::operator()()
 {
   forall_goto_functions(it, goto_model1.goto_functions)
@@ -39,33 +74,9 @@ bool java_syntactic_difft::operator()()
     const optionalt<irep_idt> class_name = declaring_class(*fun1);
     bool function_access_changed =
       fun1->type.get(ID_access) != fun2->type.get(ID_access);
-    bool class_access_changed = false;
-    bool field_access_changed = false;
-    if(class_name)
-    {
-      const symbolt *class1 = goto_model1.symbol_table.lookup(*class_name);
-      CHECK_RETURN(class1 != nullptr);
-      const symbolt *class2 = goto_model2.symbol_table.lookup(*class_name);
-      CHECK_RETURN(class2 != nullptr);
-      class_access_changed =
-        class1->type.get(ID_access) != class2->type.get(ID_access);
-      const class_typet &class_type1 = to_class_type(class1->type);
-      const class_typet &class_type2 = to_class_type(class2->type);
-      for(const auto &field1 : class_type1.components())
-      {
-        for(const auto &field2 : class_type2.components())
-        {
-          if(field1.get_name() == field2.get_name())
-          {
-            field_access_changed = field1.get_access() != field2.get_access();
-            break;
-          }
-        }
-        if(field_access_changed)
-          break;
-      }
-    }
-    if(function_access_changed || class_access_changed || field_access_changed)
+    if(
+      function_access_changed ||
+      (class_name && class_access_changed(*class_name)))
     {
       modified_functions.insert(it->first);
       continue;
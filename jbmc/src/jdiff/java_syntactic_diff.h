@@ -14,6 +14,8 @@ Author: Peter Schrammel
 
 #include <goto-diff/goto_diff.h>
 
+#include <unordered_map>
+
 class java_syntactic_difft : public goto_difft
 {
 public:
@@ -27,6 +29,12 @@ public:
   }
 
   virtual bool operator()();
+
+protected:
+  /// Whether the access of \p class_name or of one of its fields differs
+  /// between the two versions, which is the same for all its methods
+  bool class_access_changed(const irep_idt &class_name);
+  std::unordered_map<irep_idt, bool> access_changed;
 };
 
 #endif // CPROVER_JDIFF_JAVA_SYNTACTIC_DIFF_H
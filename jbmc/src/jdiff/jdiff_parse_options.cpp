@@ -56,6 +56,7 @@ Author: Peter Schrammel
 
 #include <langapi/mode.h>
 
+#include "java_class_file_diff.h"
 #include "java_syntactic_diff.h"
 #include <goto-diff/change_impact.h>
 #include <goto-diff/goto_diff.h>
@@ -206,6 +207,29 @@ int jdiff_parse_optionst::doit()
 
   register_languages();
 
+  if(cmdline.isset("compare-class-files"))
+  {
+    if(
+      cmdline.isset("change-impact") || cmdline.isset("forward-impact") ||
+      cmdline.isset("backward-impact") || cmdline.isset("unified") ||
+      cmdline.isset('u'))
+    {
+      log.error() << "--compare-class-files is only supported with the "
+                  << "syntactic diff" << messaget::eom;
+      return CPROVER_EXIT_USAGE_ERROR;
+    }
+
+    // do not convert the methods of classes that are the same in both
+    // versions, which leaves them without a body and hence not compared
+    const auto unchanged = unchanged_classes(cmdline.args[0], cmdline.args[1]);
+    log.statistics() << "Not converting the methods of " << unchanged.size()
+                     << " unchanged classes" << messaget::eom;
+    auto context_exclude = options.get_list_option("context-exclude");
+    context_exclude.insert(
+      context_exclude.end(), unchanged.begin(), unchanged.end());
+    options.set_option("context-exclude", context_exclude);
+  }
+
   goto_modelt goto_model1 =
     initialize_goto_model({cmdline.args[0]}, ui_message_handler, options);
   if(process_goto_program(options, goto_model1))
@@ -364,6 +388,8 @@ void jdiff_parse_optionst::help()
     // NOLINTNEXTLINE(whitespace/line_length)
     "  --backward-impact           output unified diff with forward&backward/forward/backward dependencies\n"
     " --compact-output             output dependencies in compact mode\n"
+    " --compare-class-files        only convert and compare the classes whose\n"
+    "                              class files differ between the JAR files\n"
     "\n"
     "Program instrumentation options:\n"
     HELP_GOTO_CHECK
@@ -37,7 +37,7 @@ class goto_modelt;
   "(no-refine-strings)" /* should go away */ \
   OPT_TIMESTAMP \
   "u(unified)(change-impact)(forward-impact)(backward-impact)" \
-  "(compact-output)"
+  "(compact-output)(compare-class-files)"
 // clang-format on
 
 class jdiff_parse_optionst : public parse_options_baset
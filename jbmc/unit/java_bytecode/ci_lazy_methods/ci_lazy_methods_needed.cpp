@@ -0,0 +1,59 @@
+/*******************************************************************\
+
+Module: Unit tests for ci_lazy_methods_neededt
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <java_bytecode/ci_lazy_methods_needed.h>
+#include <java_bytecode/java_types.h>
+#include <java_bytecode/select_pointer_type.h>
+#include <testing-utils/use_catch.h>
+#include <util/symbol_table.h>
+
+SCENARIO(
+  "ci_lazy_methods_neededt reports new classes",
+  "[core][java_bytecode][ci_lazy_methods]")
+{
+  symbol_tablet symbol_table;
+  for(const irep_idt &class_name : {"java::A", "java::B"})
+  {
+    symbolt class_symbol;
+    class_symbol.name = class_name;
+    class_symbol.is_type = true;
+    class_symbol.mode = ID_java;
+    java_class_typet class_type;
+    class_type.set_tag(class_name);
+    class_symbol.type = class_type;
+    symbol_table.insert(std::move(class_symbol));
+  }
+
+  std::unordered_set<irep_idt> callable_methods;
+  std::unordered_set<irep_idt> instantiated_classes{"java::A"};
+  const select_pointer_typet pointer_type_selector;
+  ci_lazy_methods_neededt needed(
+    callable_methods,
+    instantiated_classes,
+    symbol_table,
+    pointer_type_selector);
+
+  GIVEN("A worklist of new classes")
+  {
+    std::vector<irep_idt> new_classes;
+    needed.notify_new_classes(new_classes);
+
+    WHEN("Classes are added, some of them instantiated before")
+    {
+      REQUIRE_FALSE(needed.add_needed_class("java::A"));
+      REQUIRE(needed.add_needed_class("java::B"));
+      REQUIRE_FALSE(needed.add_needed_class("java::B"));
+
+      THEN("Only the classes that are new are reported, once each")
+      {
+        REQUIRE(new_classes == std::vector<irep_idt>{"java::B"});
+        REQUIRE(instantiated_classes.count("java::B") == 1);
+      }
+    }
+  }
+}
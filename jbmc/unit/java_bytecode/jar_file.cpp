@@ -0,0 +1,104 @@
+/*******************************************************************\
+
+Module: Unit tests for jar_filet
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <java_bytecode/jar_file.h>
+#include <java_bytecode/mz_zip_archive.h>
+#include <testing-utils/use_catch.h>
+#include <util/tempdir.h>
+
+#include <fstream>
+#include <iterator>
+
+#define _LARGEFILE64_SOURCE 1
+#include <miniz/miniz.h>
+
+/// Add a file with the given contents to the zip archive at \p path, creating
+/// the archive if needed
+static void add_to_zip(
+  const std::string &path,
+  const std::string &name,
+  const std::string &contents,
+  mz_uint level)
+{
+  REQUIRE(
+    mz_zip_add_mem_to_archive_file_in_place(
+      path.c_str(),
+      name.c_str(),
+      contents.data(),
+      contents.size(),
+      nullptr,
+      0,
+      level) == MZ_TRUE);
+}
+
+static std::string read_entry(jar_filet &jar, const std::string &name)
+{
+  std::string contents;
+  const bool found = jar.read_entry(name, [&contents](std::istream &in) {
+    contents.assign(std::istreambuf_iterator<char>(in), {});
+  });
+  REQUIRE(found);
+  return contents;
+}
+
+SCENARIO("Reading stored and deflated jar entries", "[core][java_bytecode]")
+{
+  temp_dirt temp_dir("testXXXXXX");
+  const std::string path = temp_dir("test.jar");
+  const std::string stored = "stored contents";
+  const std::string deflated(1000, 'x');
+  add_to_zip(path, "Stored.class", stored, MZ_NO_COMPRESSION);
+  add_to_zip(path, "Deflated.class", deflated, MZ_BEST_COMPRESSION);
+
+  GIVEN("The archive opened from its file")
+  {
+    jar_filet jar(path);
+
+    THEN("Both entries can be read")
+    {
+      REQUIRE(jar.get_entry("Stored.class") == stored);
+      REQUIRE(read_entry(jar, "Stored.class") == stored);
+      REQUIRE(jar.get_entry("Deflated.class") == deflated);
+      REQUIRE(read_entry(jar, "Deflated.class") == deflated);
+      // served from the cache of inflated entries
+      REQUIRE(read_entry(jar, "Deflated.class") == deflated);
+    }
+
+    THEN("Missing entries are not found")
+    {
+      REQUIRE_FALSE(jar.get_entry("Missing.class").has_value());
+      REQUIRE_FALSE(jar.read_entry("Missing.class", [](std::istream &) {}));
+    }
+  }
+
+  GIVEN("The archive loaded into memory")
+  {
+    std::ifstream file(path, std::ios::binary);
+    const std::string data(std::istreambuf_iterator<char>(file), {});
+    mz_zip_archivet archive(data.data(), data.size());
+    REQUIRE(archive.get_num_files() == 2);
+
+    THEN("Only the stored entry is accessed in place")
+    {
+      for(std::size_t index = 0; index < archive.get_num_files(); ++index)
+      {
+        std::size_t size = 0;
+        const char *contents = archive.get_stored_data(index, size);
+        if(archive.get_filename(index) == "Stored.class")
+        {
+          REQUIRE(contents != nullptr);
+          REQUIRE(contents >= data.data());
+          REQUIRE(contents + size <= data.data() + data.size());
+          REQUIRE(std::string(contents, size) == stored);
+        }
+        else
+          REQUIRE(contents == nullptr);
+      }
+    }
+  }
+}
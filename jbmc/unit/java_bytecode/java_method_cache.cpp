@@ -0,0 +1,214 @@
+/*******************************************************************\
+
+Module: Unit tests for java_method_cachet
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <java_bytecode/java_method_cache.h>
+#include <testing-utils/use_catch.h>
+#include <util/options.h>
+#include <util/std_code.h>
+#include <util/std_types.h>
+#include <util/symbol_table.h>
+#include <util/tempdir.h>
+
+/// Add a method symbol without a body to \p symbol_table
+static void add_method(symbol_tablet &symbol_table, const irep_idt &method_id)
+{
+  symbolt method;
+  method.name = method_id;
+  method.base_name = method_id;
+  method.mode = ID_java;
+  method.type = code_typet({}, empty_typet());
+  symbol_table.add(method);
+}
+
+/// Give \p method_id a body and insert a local variable, as converting the
+/// method does, recording the effect in \p cache
+static void convert_method(
+  java_method_cachet &cache,
+  symbol_tablet &symbol_table,
+  const irep_idt &method_id)
+{
+  journalling_symbol_tablet journal =
+    journalling_symbol_tablet::wrap(symbol_table);
+
+  symbolt local;
+  local.name = id2string(method_id) + "::x";
+  local.base_name = "x";
+  local.mode = ID_java;
+  local.type = signedbv_typet(32);
+  journal.add(local);
+
+  journal.get_writeable_ref(method_id).value =
+    code_declt(local.symbol_expr());
+
+  ci_lazy_methods_neededt::recordt needs;
+  cache.store(method_id, journal, needs);
+}
+
+SCENARIO("java_method_cachet", "[core][java_bytecode][java_method_cache]")
+{
+  temp_dirt temp_dir("testXXXXXX");
+  const irep_idt method_id = "java::A.f:()V";
+  const std::map<irep_idt, std::vector<std::uint32_t>> classes{
+    {"java::A", {1, 2, 3}}};
+  optionst options;
+  optionalt<ci_lazy_methods_neededt> needed_lazy_methods;
+
+  GIVEN("An empty cache")
+  {
+    java_method_cachet cache(temp_dir.path, options);
+    cache.set_loaded_classes(classes);
+
+    symbol_tablet symbol_table;
+    add_method(symbol_table, method_id);
+
+    THEN("Loading a method misses and leaves the symbol table unchanged")
+    {
+      REQUIRE_FALSE(cache.load(method_id, symbol_table, needed_lazy_methods));
+      REQUIRE(cache.misses == 1);
+      REQUIRE(cache.hits == 0);
+      REQUIRE(symbol_table.lookup_ref(method_id).value.is_nil());
+      REQUIRE(symbol_table.symbols.size() == 1);
+    }
+  }
+
+  GIVEN("A cache that a conversion was stored in")
+  {
+    {
+      java_method_cachet cache(temp_dir.path, options);
+      cache.set_loaded_classes(classes);
+      symbol_tablet symbol_table;
+      add_method(symbol_table, method_id);
+      convert_method(cache, symbol_table, method_id);
+    }
+
+    symbol_tablet symbol_table;
+    add_method(symbol_table, method_id);
+
+    WHEN("A run with the same options and classes loads the method")
+    {
+      java_method_cachet cache(temp_dir.path, options);
+      cache.set_loaded_classes(classes);
+
+      THEN("It hits and restores the body and the inserted symbols")
+      {
+        REQUIRE(cache.load(method_id, symbol_table, needed_lazy_methods));
+        REQUIRE(cache.hits == 1);
+        REQUIRE(cache.misses == 0);
+        REQUIRE(
+          symbol_table.lookup_ref(method_id).value.get(ID_statement) ==
+          ID_decl);
+        const symbolt &local =
+          symbol_table.lookup_ref(id2string(method_id) + "::x");
+        REQUIRE(local.type == signedbv_typet(32));
+        REQUIRE(local.base_name == "x");
+      }
+    }
+
+    WHEN("A run loads a class file with a different checksum")
+    {
+      java_method_cachet cache(temp_dir.path, options);
+      cache.set_loaded_classes({{"java::A", {1, 2, 4}}});
+
+      THEN("It misses")
+      {
+        REQUIRE_FALSE(cache.load(method_id, symbol_table, needed_lazy_methods));
+        REQUIRE(cache.misses == 1);
+        REQUIRE(symbol_table.lookup_ref(method_id).value.is_nil());
+      }
+    }
+
+    WHEN("A run loads an additional class")
+    {
+      java_method_cachet cache(temp_dir.path, options);
+      cache.set_loaded_classes({{"java::A", {1, 2, 3}}, {"java::B", {}}});
+
+      THEN("It misses")
+      {
+        REQUIRE_FALSE(cache.load(method_id, symbol_table, needed_lazy_methods));
+        REQUIRE(cache.misses == 1);
+      }
+    }
+
+    WHEN("A run uses different conversion options")
+    {
+      optionst other_options;
+      other_options.set_option("throw-runtime-exceptions", true);
+      java_method_cachet cache(temp_dir.path, other_options);
+      cache.set_loaded_classes(classes);
+
+      THEN("It misses")
+      {
+        REQUIRE_FALSE(cache.load(method_id, symbol_table, needed_lazy_methods));
+        REQUIRE(cache.misses == 1);
+      }
+    }
+
+    WHEN("The method already has a body")
+    {
+      java_method_cachet cache(temp_dir.path, options);
+      cache.set_loaded_classes(classes);
+      symbol_table.get_writeable_ref(method_id).value = code_skipt();
+
+      THEN("It misses and keeps the body")
+      {
+        REQUIRE_FALSE(cache.load(method_id, symbol_table, needed_lazy_methods));
+        REQUIRE(cache.misses == 1);
+        REQUIRE(
+          symbol_table.lookup_ref(method_id).value.get(ID_statement) ==
+          ID_skip);
+      }
+    }
+
+    WHEN("A symbol that the conversion inserted already exists")
+    {
+      java_method_cachet cache(temp_dir.path, options);
+      cache.set_loaded_classes(classes);
+      symbolt local;
+      local.name = id2string(method_id) + "::x";
+      local.type = bool_typet();
+      symbol_table.add(local);
+
+      THEN("It misses and keeps the existing symbol")
+      {
+        REQUIRE_FALSE(cache.load(method_id, symbol_table, needed_lazy_methods));
+        REQUIRE(cache.misses == 1);
+        REQUIRE(
+          symbol_table.lookup_ref(id2string(method_id) + "::x").type ==
+          bool_typet());
+        REQUIRE(symbol_table.lookup_ref(method_id).value.is_nil());
+      }
+    }
+  }
+
+  GIVEN("A conversion that updates another existing symbol")
+  {
+    java_method_cachet cache(temp_dir.path, options);
+    cache.set_loaded_classes(classes);
+
+    symbol_tablet symbol_table;
+    add_method(symbol_table, method_id);
+    add_method(symbol_table, "java::A.g:()V");
+
+    {
+      journalling_symbol_tablet journal =
+        journalling_symbol_tablet::wrap(symbol_table);
+      journal.get_writeable_ref(method_id).value = code_skipt();
+      journal.get_writeable_ref("java::A.g:()V").value = code_skipt();
+      cache.store(method_id, journal, ci_lazy_methods_neededt::recordt{});
+    }
+
+    THEN("It is not stored")
+    {
+      symbol_tablet fresh_symbol_table;
+      add_method(fresh_symbol_table, method_id);
+      REQUIRE_FALSE(
+        cache.load(method_id, fresh_symbol_table, needed_lazy_methods));
+      REQUIRE(cache.misses == 1);
+    }
+  }
+}
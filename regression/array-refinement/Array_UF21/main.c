@@ -0,0 +1,14 @@
+int main()
+{
+  int a[100];
+  unsigned i, j, k;
+  __CPROVER_assume(i < 100 && j < 100 && k < 100);
+
+  a[i] = 1;
+  a[j] = 2;
+
+  __CPROVER_assert(i == j || a[i] == 1, "distinct cells");
+  __CPROVER_assert(k != j || a[k] == 2, "same cell");
+  __CPROVER_assert(a[i] == 1, "i may equal j");
+  return 0;
+}
@@ -0,0 +1,21 @@
+int x;
+
+void writer()
+{
+  x = 3;
+}
+
+int main()
+{
+  __CPROVER_ASYNC_1: writer();
+
+  x = 1;
+  x = 2;
+  int a = x;
+  // the write of 1 is hidden by the write of 2, the other thread may
+  // have written 3 in between
+  assert(a == 2 || a == 3);
+  assert(a == 2);
+
+  return 0;
+}
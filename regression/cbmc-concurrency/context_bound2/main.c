@@ -0,0 +1,19 @@
+int x;
+
+void thread()
+{
+  x = 1;
+  x = 2;
+}
+
+int main()
+{
+  __CPROVER_ASYNC_1: thread();
+
+  // seeing the intermediate value requires a context switch into the
+  // thread and back, i.e., a second round
+  int r = x;
+  assert(r != 1);
+
+  return 0;
+}
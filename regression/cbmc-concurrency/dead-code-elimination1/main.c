@@ -0,0 +1,23 @@
+#include <assert.h>
+
+int flag = 0;
+
+void set_flag()
+{
+  flag = 1;
+}
+
+void flag_was_set()
+{
+}
+
+int main()
+{
+__CPROVER_ASYNC_1:
+  set_flag();
+
+  if(flag)
+    flag_was_set();
+
+  return 0;
+}
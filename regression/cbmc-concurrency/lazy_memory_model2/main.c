@@ -0,0 +1,24 @@
+int x, y;
+int r1, r2;
+_Bool done;
+
+void thread()
+{
+  y = 1;
+  r2 = x;
+  done = 1;
+}
+
+int main()
+{
+  __CPROVER_ASYNC_1: thread();
+
+  x = 1;
+  r1 = y;
+
+  __CPROVER_assume(done);
+  // store buffering: sequential consistency rules out both reads seeing 0
+  assert(r1 == 1 || r2 == 1);
+
+  return 0;
+}
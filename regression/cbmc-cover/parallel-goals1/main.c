@@ -0,0 +1,20 @@
+int main()
+{
+  int input1, input2;
+
+  __CPROVER_input("input1", input1);
+  __CPROVER_input("input2", input2);
+
+  if(input1)
+  {
+    if(input1) // dependent
+    {
+    }
+  }
+  else
+  {
+    if(input2) // independent
+    {
+    }
+  }
+}
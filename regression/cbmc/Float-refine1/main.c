@@ -0,0 +1,19 @@
+#include <assert.h>
+#include <math.h>
+
+int main()
+{
+  float x, y;
+  __CPROVER_assume(!isnan(x) && !isnan(y));
+
+  float product = x * 1.0f;
+  assert(product == x);
+
+  float quotient = x / y;
+  assert(isnan(quotient) || !signbit(quotient) == (!signbit(x) == !signbit(y)));
+
+  float sum = x + y;
+  assert(sum != 3.0f);
+
+  return 0;
+}
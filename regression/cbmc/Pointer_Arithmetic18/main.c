@@ -0,0 +1,22 @@
+struct S
+{
+  int a;
+  int b;
+  int c;
+};
+
+int main()
+{
+  struct S s = {1, 2, 3};
+  unsigned i;
+  __CPROVER_assume(i < 3);
+
+  int *p = &s.a;
+  p += i;
+  __CPROVER_assert(*p == i + 1, "in-range member");
+  *p = 0;
+  __CPROVER_assert(s.a + s.b + s.c == 5 - i, "write to member");
+  __CPROVER_assert(*p == 1, "should fail");
+
+  return 0;
+}
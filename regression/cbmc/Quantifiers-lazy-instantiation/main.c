@@ -0,0 +1,19 @@
+int main()
+{
+  unsigned n;
+  __CPROVER_assume(n > 0 && n < 100000);
+  int a[n];
+  unsigned j;
+  __CPROVER_assume(j < n);
+
+  // clang-format off
+  // clang-format would rewrite the "==>" as "== >"
+  __CPROVER_assume(__CPROVER_forall { unsigned i; i < n ==> a[i] == 0 });
+  // clang-format on
+
+  __CPROVER_assert(a[j] == 0, "instance for j: successful");
+  __CPROVER_assert(a[0] == 0, "instance for 0: successful");
+  __CPROVER_assert(a[j] == 1, "contradicts the instance for j: failed");
+
+  return 0;
+}
@@ -0,0 +1,29 @@
+#include <assert.h>
+#include <stdlib.h>
+
+struct node
+{
+  int value;
+  struct node *next;
+};
+
+int main()
+{
+  struct node *list = NULL;
+
+  for(int i = 0; i < 5; ++i)
+  {
+    struct node *n = malloc(sizeof(struct node));
+    n->value = i;
+    n->next = list;
+    list = n;
+  }
+
+  // the two concrete objects are precise
+  assert(list->value == 4);
+  assert(list->next->value == 3);
+  // the summary object may hold any of the values written to it
+  assert(list->next->next->value == 2);
+
+  return 0;
+}
@@ -0,0 +1,15 @@
+int main()
+{
+  int x;
+
+  __CPROVER_assert(x != 5, "before the assumptions");
+  __CPROVER_assume(x > 10);
+  __CPROVER_assert(x != 5, "after the first assumption");
+  __CPROVER_assert(x != 11, "after the first assumption, too");
+  __CPROVER_assume(x > 20);
+  __CPROVER_assume(x < 30);
+  __CPROVER_assert(x > 20, "after all assumptions");
+  __CPROVER_assert(x != 21, "after all assumptions, too");
+
+  return 0;
+}
@@ -0,0 +1,20 @@
+#include <assert.h>
+
+void safe(int x)
+{
+  if(x > 0)
+    assert(x != 0);
+}
+
+void unsafe(int x)
+{
+  assert(x != 42);
+}
+
+void bounded(void)
+{
+  int i = 0;
+  while(i < 10)
+    ++i;
+  assert(i == 10);
+}
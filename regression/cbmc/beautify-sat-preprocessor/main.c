@@ -0,0 +1,11 @@
+int main()
+{
+  int x;
+  int y;
+  int z = x * y;
+
+  if(x > 10 && y < x && z != 0)
+    __CPROVER_assert(0, "reachable");
+
+  return 0;
+}
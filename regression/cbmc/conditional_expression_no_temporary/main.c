@@ -0,0 +1,22 @@
+#include <assert.h>
+
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+
+int main()
+{
+  int a[4] = {3, 1, 4, 1};
+  unsigned i;
+  int *p;
+
+  // the out-of-bounds access is only evaluated when i < 4
+  int x = i < 4 ? a[i] : 0;
+  assert(x <= 4);
+
+  // the dereference is only evaluated when p is not null
+  int y = p == 0 ? 0 : *p;
+
+  int m = MIN(a[0], a[1]);
+  assert(m == 1);
+
+  return 0;
+}
@@ -0,0 +1,18 @@
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  int y = nondet_int();
+  int z = 0;
+
+  if(x > 0)
+    z += 1;
+  if(y > 0)
+    z += 2;
+
+  __CPROVER_assert(z >= 0 && z <= 3, "in range");
+  __CPROVER_assert(z != 2, "y positive, x not");
+
+  return 0;
+}
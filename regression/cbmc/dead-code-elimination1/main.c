@@ -0,0 +1,26 @@
+#include <assert.h>
+
+int feature_enabled = 0;
+
+int feature(int x)
+{
+  assert(x > 10);
+  return x * 2;
+}
+
+int configure(int enabled)
+{
+  return enabled;
+}
+
+int main()
+{
+  int x;
+  __CPROVER_assume(x > 0 && x < 10);
+
+  if(configure(feature_enabled))
+    x = feature(x);
+
+  assert(x < 10);
+  return 0;
+}
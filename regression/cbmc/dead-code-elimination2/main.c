@@ -0,0 +1,16 @@
+#include <assert.h>
+
+int mode = 1;
+
+int main()
+{
+  int x;
+
+  if(mode == 1)
+    x = 1;
+  else
+    x = 2;
+
+  assert(x == 1);
+  return 0;
+}
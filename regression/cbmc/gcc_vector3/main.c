@@ -0,0 +1,34 @@
+#include <assert.h>
+
+#ifdef __GNUC__
+typedef int v4si __attribute__((vector_size(16)));
+#endif
+
+int main()
+{
+#ifdef __GNUC__
+  int x, y;
+  __CPROVER_assume(y != 0);
+
+  v4si a = {x, x + 1, x + 2, x + 3};
+  v4si b = {y, y, y, y};
+
+  v4si p = a * b;
+  assert(p[0] == x * y);
+  assert(p[3] == (x + 3) * y);
+
+  v4si q = a / b;
+  v4si r = a % b;
+  assert(q[1] == (x + 1) / y);
+  assert(r[2] == (x + 2) % y);
+
+  v4si c = a + 1;
+  c[2] = 42;
+  assert(c[0] == x + 1);
+  assert(c[2] == 42);
+
+  unsigned i;
+  __CPROVER_assume(i < 4);
+  assert(c[i] == (i == 2 ? 42 : x + i + 1));
+#endif
+}
@@ -0,0 +1,16 @@
+void set(int value)
+{
+}
+
+int main()
+{
+  int x;
+  x = 1;
+  set(x);
+  x = 2;
+  set(x);
+  x = 3;
+  set(x);
+  __CPROVER_assert(x != 3, "");
+  return 0;
+}
@@ -0,0 +1,15 @@
+int main()
+{
+  int x;
+  int y;
+
+  int a = x + 1;
+  __CPROVER_assert(a != x, "always holds");
+  __CPROVER_assert(a != 43, "x can be 42");
+
+  int b = y * 2;
+  __CPROVER_assert(b != 7, "b is even");
+  __CPROVER_assert(b != 8, "y can be 4");
+
+  return 0;
+}
@@ -0,0 +1,14 @@
+int main()
+{
+  int a[10];
+  for(int i = 0; i < 10; ++i)
+    a[i] = i;
+
+  unsigned n = 5;
+  int sum = 0;
+  for(unsigned j = 1; j <= n; j += 2)
+    sum += a[j];
+
+  __CPROVER_assert(sum == 1 + 3 + 5, "sum of odd elements");
+  return 0;
+}
@@ -0,0 +1,13 @@
+int main()
+{
+  int step;
+  int iterations = 0;
+  for(int i = 0; i < 6; i += step)
+  {
+    step = 2;
+    ++iterations;
+  }
+
+  __CPROVER_assert(iterations == 3, "three iterations");
+  return 0;
+}
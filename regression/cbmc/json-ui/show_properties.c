@@ -0,0 +1,7 @@
+int main()
+{
+  int x;
+  __CPROVER_assert(x > 0, "x is positive");
+  __CPROVER_assert(x < 10, "x is below ten");
+  return 0;
+}
@@ -0,0 +1,17 @@
+unsigned nondet_unsigned();
+
+int main()
+{
+  unsigned n = nondet_unsigned();
+  unsigned x = 0, y = 0;
+
+  while(y < n)
+    __CPROVER_loop_invariant(x == y)
+    {
+      x++;
+      y++;
+    }
+
+  __CPROVER_assert(x == y, "x and y agree");
+  return 0;
+}
@@ -0,0 +1,15 @@
+unsigned nondet_unsigned();
+
+int main()
+{
+  unsigned n = nondet_unsigned();
+  unsigned i = 0;
+
+  while(i < n)
+  {
+    i++;
+    __CPROVER_assert(i < 5, "i stays below 5");
+  }
+
+  return 0;
+}
@@ -0,0 +1,12 @@
+int main()
+{
+  int a[64];
+  unsigned i = 0;
+
+  while(1)
+  {
+    a[i % 64] = i;
+    ++i;
+    __CPROVER_assert(i != 0 || a[0] == 0, "holds on the explored iterations");
+  }
+}
@@ -0,0 +1,20 @@
+unsigned nondet_unsigned();
+int nondet_int();
+
+int main()
+{
+  unsigned a = nondet_unsigned();
+  unsigned b = nondet_unsigned();
+  __CPROVER_assume(a < 1000 && b < 1000);
+
+  __CPROVER_assert(a * b == b * a, "commutative");
+  __CPROVER_assert(a * (b + 1) == a * b + a, "distributive");
+  __CPROVER_assert(a / 8 == a >> 3, "division by a power of two");
+  __CPROVER_assert(a % 8 == (a & 7), "remainder of a power of two");
+
+  int c = nondet_int();
+  __CPROVER_assert(c / 4 * 4 + c % 4 == c, "signed division");
+  __CPROVER_assert(a * b != 391, "product can be 391");
+
+  return 0;
+}
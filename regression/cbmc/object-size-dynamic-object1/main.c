@@ -0,0 +1,17 @@
+#include <stdlib.h>
+
+int main()
+{
+  char a[1], b[2], c[3];
+  char *d = malloc(4);
+  int choice;
+  char *p = choice == 0 ? a : choice == 1 ? b : choice == 2 ? c : d;
+
+  __CPROVER_assert(
+    __CPROVER_OBJECT_SIZE(p) ==
+      (choice == 0 ? 1 : choice == 1 ? 2 : choice == 2 ? 3 : 4),
+    "object size");
+  __CPROVER_assert(
+    __CPROVER_DYNAMIC_OBJECT(p) == (choice < 0 || choice > 2), "dynamic");
+  __CPROVER_assert(__CPROVER_OBJECT_SIZE(p) != 4, "size of the dynamic one");
+}
@@ -0,0 +1,10 @@
+int main()
+{
+  int table[4];
+  for(int i = 0; i < 4; ++i)
+    table[i] = 2 * i;
+
+  unsigned x;
+  __CPROVER_assert(table[x % 4] == 2 * (x % 4), "table lookup");
+  return 0;
+}
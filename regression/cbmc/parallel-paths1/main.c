@@ -0,0 +1,21 @@
+int main()
+{
+  int x, y;
+  int sum = 0;
+
+  if(x > 0)
+    sum += 1;
+  else
+    sum += 2;
+
+  if(y > 0)
+    sum += 10;
+  else
+    sum += 20;
+
+  __CPROVER_assert(sum >= 11, "holds on all paths");
+  __CPROVER_assert(sum != 22, "fails on one path only");
+  __CPROVER_assert(sum <= 22, "holds on all paths either");
+
+  return 0;
+}
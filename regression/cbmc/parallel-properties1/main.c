@@ -0,0 +1,16 @@
+int main()
+{
+  int x;
+  int a[4];
+
+  __CPROVER_assert(x + 1 != x, "always holds");
+  __CPROVER_assert(x != 42, "x can be 42");
+
+  if(x >= 0 && x < 4)
+    a[x] = 1;
+
+  __CPROVER_assert(x < 100, "x can be large");
+  __CPROVER_assert(x == x, "trivially true");
+
+  return 0;
+}
@@ -0,0 +1,8 @@
+int main()
+{
+  int x;
+
+  __CPROVER_assert(x != 42, "x can be 42");
+
+  return 0;
+}
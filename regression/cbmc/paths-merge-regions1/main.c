@@ -0,0 +1,14 @@
+int main()
+{
+  int x, y;
+
+  if(x > 0)
+    y = 1;
+  else
+    y = 2;
+
+  __CPROVER_assert(y != 2, "y can be 2");
+  __CPROVER_assert(y == 1 || y == 2, "y is 1 or 2");
+
+  return 0;
+}
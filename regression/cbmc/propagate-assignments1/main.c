@@ -0,0 +1,15 @@
+int nondet_int();
+
+int main()
+{
+  int x = 5;
+  int y = x + 1;
+  int z = nondet_int();
+  int w = z;
+
+  __CPROVER_assert(y == 6, "constant");
+  __CPROVER_assert(w == z, "copy");
+  __CPROVER_assert(w + y != 10, "fails");
+
+  return 0;
+}
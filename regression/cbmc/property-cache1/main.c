@@ -0,0 +1,14 @@
+int twice(int x)
+{
+  return 2 * x;
+}
+
+int main()
+{
+  int x;
+  __CPROVER_assume(x > 0 && x < 100);
+  int y = twice(x);
+  __CPROVER_assert(y > x, "doubled");
+  __CPROVER_assert(y % 2 == 0, "even");
+  return 0;
+}
@@ -0,0 +1,9 @@
+int main()
+{
+  int x;
+  __CPROVER_assert(x != 1, "first");
+  __CPROVER_assert(x == x, "second");
+  __CPROVER_assert(x != 3, "third");
+  __CPROVER_assert(x + 0 == x, "fourth");
+  return 0;
+}
@@ -0,0 +1,16 @@
+#include <assert.h>
+
+int main()
+{
+  unsigned char a, b;
+  unsigned long long c, d;
+
+  unsigned char narrow = a * b;
+  unsigned long long wide = c / d;
+
+  assert(a != 3 || b != 5 || narrow == 15);
+  assert(d != 2 || c != 10 || wide == 5);
+  assert(narrow != 6 || wide != 7);
+
+  return 0;
+}
@@ -0,0 +1,8 @@
+int main()
+{
+  unsigned x, y;
+  __CPROVER_assume(x > 1 && x < 256 && y > 1 && y < 256);
+
+  // 251 is prime, which the solver can only show by running into conflicts
+  __CPROVER_assert(x * y != 251, "no factors");
+}
@@ -0,0 +1,15 @@
+int unused;
+int used_by_initializer;
+int *used = &used_by_initializer;
+int large_unused[100000];
+
+void unused_function()
+{
+  unused = 1;
+}
+
+int main()
+{
+  __CPROVER_assert(used == &used_by_initializer, "initialized");
+  __CPROVER_assert(used_by_initializer == 0, "zero");
+}
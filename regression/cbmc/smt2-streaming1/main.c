@@ -0,0 +1,14 @@
+unsigned nondet_unsigned();
+
+int main()
+{
+  unsigned sum = 0;
+
+  // enough steps for the SMT2 problem to exceed 1 MiB, which makes it
+  // stream to the solver while it is being generated
+  for(int i = 0; i < 8000; ++i)
+    sum += 2 * nondet_unsigned();
+
+  __CPROVER_assert(sum % 2 == 0, "sum is even");
+  __CPROVER_assert(sum != 4, "sum can be 4");
+}
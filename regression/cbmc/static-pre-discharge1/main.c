@@ -0,0 +1,15 @@
+int a[10];
+
+int main()
+{
+  for(int i = 0; i < 10; i++)
+    a[i] = i;
+
+  int x = 3;
+  a[x] = 1;
+
+  int j;
+  a[j] = 0;
+
+  return 0;
+}
@@ -0,0 +1,9 @@
+int main()
+{
+  int x = 0;
+  int *p = &x;
+  *p = 10;
+  __CPROVER_assert(x == 0, "x is still zero");
+
+  return 0;
+}
@@ -0,0 +1,12 @@
+int main()
+{
+  int x;
+  __CPROVER_assume(x >= 0 && x < 100);
+
+  int sum = 0;
+  for(int i = 0; i < 10; ++i)
+    sum += x;
+
+  __CPROVER_assert(sum != 420, "sum");
+  return 0;
+}
@@ -0,0 +1,31 @@
+struct node
+{
+  int value;
+  struct node *next;
+};
+
+int main()
+{
+  struct node nodes[4];
+  for(int i = 0; i < 4; ++i)
+  {
+    nodes[i].value = i + 1;
+    nodes[i].next = i < 3 ? &nodes[i + 1] : 0;
+  }
+
+  struct node *p = __CPROVER_nondet_bool() ? &nodes[0] : &nodes[1];
+  int sum = 0;
+  while(p != 0)
+  {
+    // the same pointer is dereferenced twice per iteration
+    sum += p->value;
+    if(p->value == 3)
+      p->value = 7;
+    p = p->next;
+  }
+
+  __CPROVER_assert(sum == 10 || sum == 9, "sum of the list");
+  __CPROVER_assert(nodes[2].value == 7, "update through the list");
+  __CPROVER_assert(sum == 10, "traversal from the head");
+  return 0;
+}
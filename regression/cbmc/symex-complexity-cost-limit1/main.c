@@ -0,0 +1,9 @@
+int main()
+{
+  unsigned x, y;
+
+  for(int i = 0; i < 4; ++i)
+    x = x * y;
+
+  __CPROVER_assert(0, "not reached as the path is too costly");
+}
@@ -0,0 +1,17 @@
+int main()
+{
+  int x, y, r = 0;
+  if(x > 0)
+  {
+    if(y > 0)
+      r = 1;
+    else
+      r = 2;
+  }
+  else if(y > 0)
+    r = 3;
+
+  __CPROVER_assert(r != 0 || x <= 0, "r is set when x is positive");
+  __CPROVER_assert(r != 3, "r is not 3");
+  return 0;
+}
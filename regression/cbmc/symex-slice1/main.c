@@ -0,0 +1,21 @@
+int checksum(const int *data, int n)
+{
+  int sum = 0;
+  for(int i = 0; i < n; ++i)
+    sum += data[i];
+  return sum;
+}
+
+int main()
+{
+  int data[4];
+  int log_entry = 0;
+  for(int j = 0; j < 4; ++j)
+    log_entry = log_entry * 31 + j;
+
+  int x;
+  int y = x + 1;
+  __CPROVER_assert(y != x, "increment");
+  __CPROVER_assert(checksum(data, 4) != 0, "checksum");
+  return 0;
+}
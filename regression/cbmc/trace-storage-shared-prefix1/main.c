@@ -0,0 +1,19 @@
+int main()
+{
+  int x;
+  int shared = 1;
+  int w;
+
+  if(x > 0)
+  {
+    w = 3;
+    __CPROVER_assert(0, "positive");
+  }
+  else
+  {
+    w = 4;
+    __CPROVER_assert(0, "not positive");
+  }
+
+  return 0;
+}
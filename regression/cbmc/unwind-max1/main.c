@@ -0,0 +1,13 @@
+int main()
+{
+  unsigned n;
+  __CPROVER_assume(n <= 5);
+
+  unsigned i;
+  for(i = 0; i < n; ++i)
+  {
+  }
+
+  __CPROVER_assert(i != 4, "four iterations");
+  return 0;
+}
@@ -0,0 +1,25 @@
+void f(unsigned n)
+{
+  for(unsigned i = 0; i < n; ++i)
+    ;
+}
+
+void g(unsigned n)
+{
+  for(unsigned i = 0; i < n; ++i)
+    ;
+}
+
+int main()
+{
+  unsigned n;
+  __CPROVER_assume(n <= 3);
+
+  for(int k = 0; k < 2; ++k)
+  {
+    f(n);
+    g(n);
+  }
+
+  return 0;
+}
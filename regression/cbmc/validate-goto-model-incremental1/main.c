@@ -0,0 +1,19 @@
+#include <assert.h>
+
+int unused(int x)
+{
+  return x + 1;
+}
+
+int twice(int x)
+{
+  return 2 * x;
+}
+
+int main()
+{
+  int x;
+  __CPROVER_assume(x > 0 && x < 100);
+  assert(twice(x) > x);
+  return 0;
+}
@@ -0,0 +1,28 @@
+// function_enforce_01
+
+// add_two is checked against its contract, using the contract of add_one
+// in place of its body.
+
+int add_one(int x)
+  __CPROVER_requires(x < 100)
+  __CPROVER_ensures(__CPROVER_return_value == x + 1)
+{
+  return x + 1;
+}
+
+int add_two(int x)
+  __CPROVER_requires(x < 50)
+  __CPROVER_ensures(__CPROVER_return_value == x + 2)
+{
+  int y = add_one(x);
+  return add_one(y);
+}
+
+int main()
+{
+  int n;
+  __CPROVER_assume(n < 10);
+  int r = add_two(n);
+  __CPROVER_assert(r == n + 2, "add_two");
+  return 0;
+}
@@ -0,0 +1,19 @@
+char *source(void);
+void sink(char *);
+void sanitize(char *);
+
+void use(char *p)
+{
+  sink(p);
+}
+
+int main()
+{
+  char *a = source();
+  char *b = source();
+  sanitize(b);
+  sink(a);
+  sink(b);
+  use(a);
+  return 0;
+}
@@ -0,0 +1,14 @@
+#include <assert.h>
+
+int main()
+{
+  int i = 0;
+
+  while(i < 1000)
+  {
+    assert(i >= 0);
+    ++i;
+  }
+
+  assert(i <= 1000);
+}
@@ -0,0 +1,20 @@
+int global;
+
+void set(int x)
+{
+  if(x > 10)
+    global = x;
+}
+
+int get(int x)
+{
+  int y = 5;
+  if(x > 0)
+    __CPROVER_assert(x >= 1, "positive");
+  __CPROVER_assert(y == 5, "constant");
+  return y;
+}
+
+int main()
+{
+}
@@ -0,0 +1,26 @@
+#!/usr/bin/env bash
+#
+# Compile a C file twice with the same translation unit cache, defining
+# FIRST_RUN in the first compilation only, and verify the second result
+
+set -e
+
+goto_cc=$1
+cbmc=$2
+
+options=${*:3:$#-3}
+name=${*:$#}
+base_name=${name%.c}
+
+cache=translation-unit-cache
+rm -rf "${cache}"
+
+echo "First compilation"
+"${goto_cc}" --verbosity 10 --translation-unit-cache "${cache}" \
+  -DFIRST_RUN -c "${name}" -o "${base_name}.gb"
+
+echo "Second compilation"
+"${goto_cc}" --verbosity 10 --translation-unit-cache "${cache}" \
+  -c "${name}" -o "${base_name}.gb"
+
+"${cbmc}" "${base_name}.gb" ${options}
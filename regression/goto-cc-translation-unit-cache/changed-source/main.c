@@ -0,0 +1,10 @@
+#ifdef FIRST_RUN
+#  define VALUE 1
+#else
+#  define VALUE 2
+#endif
+
+int main()
+{
+  __CPROVER_assert(VALUE == 2, "second compilation");
+}
@@ -0,0 +1,9 @@
+int f(int x)
+{
+  return x + 1;
+}
+
+int main()
+{
+  __CPROVER_assert(f(1) == 2, "f increments");
+}
@@ -0,0 +1,5 @@
+int main()
+{
+  int x = g();
+  __CPROVER_assert(x == x, "reflexive");
+}
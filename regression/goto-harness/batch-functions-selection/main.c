@@ -0,0 +1,27 @@
+#include <assert.h>
+
+int global;
+
+static int helper(int x)
+{
+  return x + global;
+}
+
+void set_global(int x)
+{
+  global = x;
+}
+
+int increment(int x)
+{
+  if(x < 100)
+    return x + 1;
+  return x;
+}
+
+int main(void)
+{
+  set_global(1);
+  assert(helper(1) == 2);
+  return 0;
+}
@@ -20,12 +20,22 @@ else
 fi
 
 if [ -e "${name}-mod.gb" ] ; then
-  rm -f "${name}-mod.gb"
+  rm -rf "${name}-mod.gb"
 fi
 
 # `# some comment` is an inline comment - basically, cause bash to execute an empty command
 $cbmc --show-goto-functions "${name}.gb"
 $goto_harness "${name}.gb" "${name}-mod.gb" --harness-function-name $entry_point ${args}
+
+# in batch mode, the output is a directory holding one goto binary per harness
+if [ -d "${name}-mod.gb" ] ; then
+  for harness in "${name}-mod.gb"/*.gb ; do
+    echo "harness ${harness}"
+    $cbmc --function $entry_point "${harness}" --pointer-check --unwind 11 --unwinding-assertions
+  done
+  exit 0
+fi
+
 $cbmc --show-goto-functions "${name}-mod.gb"
 $cbmc --function $entry_point "${name}-mod.gb" \
   --pointer-check `# because we want to see out of bounds errors` \
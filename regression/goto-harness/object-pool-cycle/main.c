@@ -0,0 +1,15 @@
+#include <assert.h>
+#include <stdlib.h>
+
+typedef struct st
+{
+  struct st *next;
+  int data;
+} st_t;
+
+void func(st_t *p)
+{
+  assert(p != NULL);
+  // the pool lets p->next point back to p
+  assert(p->next != p);
+}
@@ -0,0 +1,21 @@
+int a[100];
+char s[100];
+
+void fill(unsigned n, int v)
+{
+  for(unsigned i = 0; i < n; ++i)
+    a[i] = v;
+}
+
+unsigned length(void)
+{
+  unsigned i = 0;
+  while(s[i] != 0)
+    ++i;
+  return i;
+}
+
+int main()
+{
+  return 0;
+}
@@ -0,0 +1,39 @@
+#include <assert.h>
+
+int small(int x)
+{
+  if(x > 2)
+    return 1;
+  return 0;
+}
+
+int big(int x)
+{
+  int y = x;
+  y = y * 2;
+  y = y + 1;
+  y = y * 3;
+  y = y - 4;
+  y = y * 5;
+  y = y + 6;
+  y = y * 7;
+  y = y - 8;
+  y = y * 9;
+  y = y + 10;
+  y = y * 11;
+  return y;
+}
+
+int main()
+{
+  int n;
+  int count = 0;
+
+  for(int i = 0; i < 5; ++i)
+    count += small(i);
+
+  int r = big(n);
+
+  assert(count == 2);
+  return 0;
+}
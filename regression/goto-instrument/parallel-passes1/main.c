@@ -0,0 +1,19 @@
+int a[2];
+
+int get(int i)
+{
+  return a[i];
+}
+
+void set(int i, int v)
+{
+  a[i] = v;
+}
+
+int main()
+{
+  int i;
+  __CPROVER_assume(i >= 0 && i <= 2);
+  set(i, 1);
+  return get(i);
+}
@@ -0,0 +1,16 @@
+int a[10];
+int b[2];
+
+int main()
+{
+  int i;
+  __CPROVER_assume(i >= 0 && i < 10);
+  a[i] = 1;
+
+  int j;
+  b[j] = 1;
+  if(i > 5)
+    b[j] = 2;
+
+  return 0;
+}
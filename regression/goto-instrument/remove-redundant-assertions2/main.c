@@ -0,0 +1,11 @@
+int a[2];
+
+int main()
+{
+  int i = 0;
+  int *p = &i;
+  *p = 5;
+  a[i] = 1;
+
+  return 0;
+}
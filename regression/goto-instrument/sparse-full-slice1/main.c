@@ -0,0 +1,32 @@
+#include <assert.h>
+
+int g;
+int unrelated;
+
+void set(int *p, int v)
+{
+  *p = v;
+}
+
+int twice(int x)
+{
+  return 2 * x;
+}
+
+int main()
+{
+  int a;
+  int b = 1;
+  int c;
+
+  unrelated = b;
+  set(&a, b);
+  g = twice(a);
+
+  if(c)
+    g = 3;
+
+  assert(g == 2 || g == 3);
+  assert(a == 1);
+  return 0;
+}
@@ -0,0 +1,36 @@
+#include <assert.h>
+
+int f1(int x)
+{
+  return x + 1;
+}
+
+int f2(int x)
+{
+  return x + 2;
+}
+
+int f4(int x)
+{
+  return x + 4;
+}
+
+struct handlert
+{
+  int (*callback)(int);
+};
+
+struct handlert handlers[] = {{f1}, {f2}};
+
+int (*unused)(int) = f4;
+
+int main()
+{
+  unsigned i;
+  __CPROVER_assume(i < 2);
+
+  int result = handlers[i].callback(0);
+  assert(result == 1 || result == 2);
+
+  return 0;
+}
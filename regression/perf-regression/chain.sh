@@ -0,0 +1,12 @@
+#!/bin/bash
+
+set -e
+
+cbmc=$1
+corpus=${*:$#}
+args=${*:2:$#-2}
+
+script_dir=$(cd "$(dirname "$0")" && pwd)
+
+python3 "${script_dir}/../../scripts/perf-regression/perf_regression.py" \
+  --cbmc "${cbmc}" --repeat 1 --corpus "${corpus}" ${args}
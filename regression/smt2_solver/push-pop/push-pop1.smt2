@@ -0,0 +1,17 @@
+(set-logic QF_BV)
+(declare-const x (_ BitVec 8))
+(assert (bvult x #x10))
+(push 1)
+(declare-const y (_ BitVec 8))
+(assert (= x (bvadd y #x20)))
+(assert (bvult y #x10))
+(check-sat)
+(pop 1)
+(check-sat)
+(check-sat-assuming ((= x #x20)))
+(check-sat-assuming ((= x #x05)))
+(push)
+(assert (= x #x20))
+(check-sat)
+(pop)
+(check-sat)
@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+
+"""Modular verification of code contracts.
+
+Splits the verification of a goto binary with code contracts into one job
+per function with a contract (checked by goto-instrument --enforce-contract)
+plus one job for the entry point (--replace-calls-with-contracts), runs the
+jobs in parallel, and caches their results by the hashes that
+goto-instrument --show-contract-jobs reports. After a change to a function
+only the jobs whose hash changed are run again: those of the function itself
+and, if its contract changed, of its callers.
+"""
+
+import argparse
+import concurrent.futures
+import json
+import os
+import subprocess
+import sys
+import tempfile
+
+
+def list_jobs(goto_instrument, binary):
+    output = subprocess.run(
+        [goto_instrument, '--show-contract-jobs', binary],
+        check=True, stdout=subprocess.PIPE, universal_newlines=True).stdout
+    jobs = {}
+    for line in output.splitlines():
+        name, job_hash = line.split()
+        jobs[name] = job_hash
+    return jobs
+
+
+def run_job(args, name, entry_point):
+    with tempfile.TemporaryDirectory() as tmp:
+        instrumented = os.path.join(tmp, 'job.gb')
+        if name == entry_point:
+            mode = ['--replace-calls-with-contracts']
+        else:
+            mode = ['--enforce-contract', name]
+        subprocess.run(
+            [args.goto_instrument] + mode + [args.binary, instrumented],
+            check=True, stdout=subprocess.DEVNULL)
+        result = subprocess.run(
+            [args.cbmc, instrumented] + args.cbmc_args,
+            stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+            universal_newlines=True)
+        return result.returncode, result.stdout
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('binary', help='goto binary to verify')
+    parser.add_argument('--goto-instrument', default='goto-instrument')
+    parser.add_argument('--cbmc', default='cbmc')
+    parser.add_argument('--cache', default='contracts-cache.json',
+                        help='file holding the results of earlier runs')
+    parser.add_argument('--jobs', type=int, default=os.cpu_count(),
+                        help='number of jobs to run in parallel')
+    parser.add_argument('cbmc_args', nargs=argparse.REMAINDER,
+                        help='further options passed on to cbmc')
+    args = parser.parse_args()
+
+    jobs = list_jobs(args.goto_instrument, args.binary)
+    # the entry point is always listed last
+    entry_point = list(jobs)[-1]
+
+    cache = {}
+    if os.path.exists(args.cache):
+        with open(args.cache) as f:
+            cache = json.load(f)
+
+    todo = [name for name, job_hash in jobs.items()
+            if cache.get(name, {}).get('hash') != job_hash]
+    for name in jobs:
+        if name not in todo:
+            print('{}: cached, exit code {}'.format(
+                name, cache[name]['exit_code']))
+
+    with concurrent.futures.ThreadPoolExecutor(args.jobs) as executor:
+        futures = {executor.submit(run_job, args, name, entry_point): name
+                   for name in todo}
+        for future in concurrent.futures.as_completed(futures):
+            name = futures[future]
+            exit_code, output = future.result()
+            print('{}: exit code {}'.format(name, exit_code))
+            if exit_code != 0:
+                print(output)
+            cache[name] = {'hash': jobs[name], 'exit_code': exit_code}
+
+    # forget functions that no longer exist
+    cache = {name: cache[name] for name in jobs}
+    with open(args.cache, 'w') as f:
+        json.dump(cache, f, indent=2, sort_keys=True)
+
+    return max(cache[name]['exit_code'] for name in jobs)
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,228 @@
+#!/usr/bin/env python3
+
+"""End-to-end performance regression runner.
+
+Runs cbmc, goto-analyzer and jbmc on the programs listed in a corpus and
+records, for each of them, the time spent in each phase (derived from the
+monotonic timestamps of the tools' status messages), the peak resident set
+size, and the number of SSA steps and SAT variables and clauses. The results
+are compared against a stored baseline: any time or memory measurement that
+exceeds the baseline by more than the given relative threshold, and any
+change in the SSA or SAT counts beyond their threshold, is reported as a
+regression and makes the script exit with a non-zero code.
+"""
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+
+# A phase starts with the first message matching its pattern after the start
+# of the preceding phase and ends with the start of the next phase or the end
+# of the run. Everything before the first phase is accounted to "parse".
+PHASES = {
+    'cbmc': [
+        ('symex', re.compile(r'Starting Bounded Model Checking')),
+        ('postprocess', re.compile(r'Generated \d+ VCC')),
+        ('convert', re.compile(r'Passing problem to')),
+        ('solve', re.compile(r'Running ')),
+        ('report', re.compile(r'Runtime decision procedure')),
+    ],
+    'goto-analyzer': [
+        ('analyze', re.compile(r'Computing abstract states')),
+        ('report', re.compile(r'Performing task')),
+    ],
+}
+PHASES['jbmc'] = PHASES['cbmc']
+
+COUNTS = [
+    (re.compile(r'size of program expression: (\d+) steps'), ['ssa_steps']),
+    (re.compile(r'(\d+) variables, (\d+) clauses'),
+     ['sat_variables', 'sat_clauses']),
+]
+
+TIMESTAMP = re.compile(r'^(\d+\.\d+) (.*)$')
+
+
+def run_tool(tool, program, options):
+    """Run a single tool to completion and return its output together with
+    the peak resident set size of the process in KiB."""
+    command = [tool, '--timestamp', 'monotonic', '--verbosity', '8',
+               program] + options
+    with tempfile.TemporaryFile(mode='w+') as output:
+        process = subprocess.Popen(
+            command, stdout=output, stderr=subprocess.STDOUT,
+            universal_newlines=True)
+        _, status, rusage = os.wait4(process.pid, 0)
+        if os.WIFSIGNALED(status):
+            process.returncode = -os.WTERMSIG(status)
+        else:
+            process.returncode = os.WEXITSTATUS(status)
+        output.seek(0)
+        return process.returncode, output.read(), rusage.ru_maxrss
+
+
+def parse_output(tool, output):
+    metrics = {}
+    phases = PHASES[tool]
+    phase = 'parse'
+    next_phase = 0
+    phase_start = None
+    last = None
+
+    for line in output.splitlines():
+        match = TIMESTAMP.match(line)
+        if not match:
+            continue
+        time, message = float(match.group(1)), match.group(2)
+        if phase_start is None:
+            phase_start = time
+        last = time
+
+        for index, (name, pattern) in enumerate(phases[next_phase:]):
+            if pattern.search(message):
+                metrics['time_' + phase] = \
+                    metrics.get('time_' + phase, 0.0) + time - phase_start
+                phase, phase_start = name, time
+                next_phase += index + 1
+                break
+
+        for pattern, names in COUNTS:
+            count_match = pattern.search(message)
+            if count_match:
+                for name, value in zip(names, count_match.groups()):
+                    # with incremental solving the counts are reported
+                    # repeatedly; the last report covers the whole problem
+                    metrics[name] = int(value)
+
+    if last is not None:
+        metrics['time_' + phase] = \
+            metrics.get('time_' + phase, 0.0) + last - phase_start
+        metrics['time_total'] = sum(
+            value for key, value in metrics.items()
+            if key.startswith('time_'))
+    for key in metrics:
+        if key.startswith('time_'):
+            metrics[key] = round(metrics[key], 3)
+    return metrics
+
+
+def measure(args, corpus_dir, entry):
+    tool = getattr(args, entry['tool'].replace('-', '_'))
+    program = os.path.join(corpus_dir, entry['program'])
+    best = None
+    for _ in range(args.repeat):
+        exit_code, output, max_rss = run_tool(
+            tool, program, entry.get('options', []))
+        metrics = parse_output(entry['tool'], output)
+        metrics['peak_rss_kib'] = max_rss
+        metrics['exit_code'] = exit_code
+        # keep the fastest of the repetitions: it is the least disturbed by
+        # other load on the machine
+        if best is None or \
+                metrics.get('time_total', 0) < best.get('time_total', 0):
+            best = metrics
+    return best
+
+
+def is_regression(args, key, value, baseline):
+    if key == 'exit_code':
+        return value != baseline
+    if key.startswith('time_'):
+        return value > baseline * (1 + args.time_threshold) + \
+            args.time_resolution
+    if key == 'peak_rss_kib':
+        return value > baseline * (1 + args.memory_threshold)
+    return abs(value - baseline) > baseline * args.count_threshold
+
+
+def compare(args, results, baseline):
+    regressions = []
+    for name, metrics in sorted(results.items()):
+        if name not in baseline:
+            print('{}: no baseline'.format(name))
+            continue
+        for key, value in sorted(metrics.items()):
+            if key not in baseline[name]:
+                continue
+            old = baseline[name][key]
+            if is_regression(args, key, value, old):
+                regressions.append(name)
+                print('{}: {} regressed from {} to {}'.format(
+                    name, key, old, value))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('--corpus', default=os.path.join(
+                            os.path.dirname(os.path.abspath(__file__)),
+                            'corpus.json'),
+                        help='list of programs and options to run')
+    parser.add_argument('--cbmc', default='cbmc')
+    parser.add_argument('--goto-analyzer', default='goto-analyzer')
+    parser.add_argument('--jbmc', default='jbmc')
+    parser.add_argument('--filter', default='',
+                        help='only run corpus entries whose name contains '
+                             'this string')
+    parser.add_argument('--repeat', type=int, default=3,
+                        help='number of runs per entry, of which the '
+                             'fastest is kept')
+    parser.add_argument('--results', help='file to write the results to')
+    parser.add_argument('--baseline', help='file holding the baseline')
+    parser.add_argument('--update-baseline', action='store_true',
+                        help='store the results as the new baseline '
+                             'instead of comparing against it')
+    parser.add_argument('--time-threshold', type=float, default=0.1,
+                        help='permitted relative increase of run times')
+    parser.add_argument('--time-resolution', type=float, default=0.05,
+                        help='permitted absolute increase of run times in '
+                             'seconds, to ignore noise in short phases')
+    parser.add_argument('--memory-threshold', type=float, default=0.1,
+                        help='permitted relative increase of peak RSS')
+    parser.add_argument('--count-threshold', type=float, default=0.0,
+                        help='permitted relative change of SSA step and '
+                             'SAT variable and clause counts')
+    args = parser.parse_args()
+
+    with open(args.corpus) as f:
+        corpus = json.load(f)
+    corpus_dir = os.path.dirname(os.path.abspath(args.corpus))
+
+    results = {}
+    for entry in corpus:
+        if args.filter not in entry['name']:
+            continue
+        results[entry['name']] = measure(args, corpus_dir, entry)
+        print('{}: {:.2f}s, {} KiB'.format(
+            entry['name'], results[entry['name']].get('time_total', 0),
+            results[entry['name']]['peak_rss_kib']))
+
+    if args.results:
+        with open(args.results, 'w') as f:
+            json.dump(results, f, indent=2, sort_keys=True)
+
+    if not args.baseline:
+        return 0
+
+    if args.update_baseline:
+        baseline = {}
+        if os.path.exists(args.baseline):
+            with open(args.baseline) as f:
+                baseline = json.load(f)
+        baseline.update(results)
+        with open(args.baseline, 'w') as f:
+            json.dump(baseline, f, indent=2, sort_keys=True)
+        return 0
+
+    with open(args.baseline) as f:
+        baseline = json.load(f)
+    return 1 if compare(args, results, baseline) else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -254,11 +254,11 @@ bool ai_baset::visit(
   // Function call and end are special cases
   if(l->is_function_call() && !goto_functions.function_map.empty())
   {
+    const auto successors = goto_program.get_successors(l);
     DATA_INVARIANT(
-      goto_program.get_successors(l).size() == 1,
-      "function calls only have one successor");
+      successors.size() == 1, "function calls only have one successor");
     DATA_INVARIANT(
-      *(goto_program.get_successors(l).begin()) == std::next(l),
+      successors.front() == std::next(l),
       "function call successor / return location must be the next instruction");
 
     const code_function_callt &code = to_code_function_call(l->code);
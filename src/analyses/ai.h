@@ -332,6 +332,13 @@ protected:
     const goto_functionst &goto_functions,
     const namespacet &ns);
 
+  /// Apply the edges from \p l_call to the body of the function and from its
+  /// end back to \p l_return. All call sites join into the one entry state
+  /// of the function, and the body, whose states are shared by all call
+  /// sites, is analysed again whenever that entry state grows. The edge to
+  /// \p l_return uses the current exit state, which reflects the calls from
+  /// all call sites so far rather than from \p l_call alone.
+  /// \return True if the state at \p l_return changed
   bool do_function_call(
     const irep_idt &calling_function_id,
     locationt l_call,
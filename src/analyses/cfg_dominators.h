@@ -12,19 +12,183 @@ Author: Georg Weissenbacher, georg@weissenbacher.name
 #ifndef CPROVER_ANALYSES_CFG_DOMINATORS_H
 #define CPROVER_ANALYSES_CFG_DOMINATORS_H
 
-#include <set>
+#include <algorithm>
+#include <cassert>
+#include <iosfwd>
+#include <iterator>
+#include <limits>
 #include <list>
 #include <map>
-#include <iosfwd>
-#include <cassert>
+#include <memory>
+#include <set>
+#include <vector>
 
 #include <goto-programs/goto_functions.h>
 #include <goto-programs/goto_program.h>
 #include <goto-programs/cfg.h>
 
+/// The dominator tree computed by \ref cfg_dominators_templatet, shared by
+/// the dominator sets of all of its nodes. Nodes are identified by their
+/// index in the control-flow graph.
+template <class T>
+struct cfg_dominator_treet
+{
+  static const std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+  /// Program point of each node
+  std::vector<T> program_points;
+  /// Node of each program point
+  std::map<T, std::size_t> indices;
+  /// Immediate dominator of each node, the root of the tree for the root
+  /// itself and \ref npos for nodes that are unreachable
+  std::vector<std::size_t> immediate_dominators;
+  /// Number of dominators of each node, including the node itself
+  std::vector<std::size_t> depths;
+  /// Numbering of the nodes in pre- and post-order of a depth-first traversal
+  /// of the tree, such that the subtree rooted at a node is the interval of
+  /// nodes numbered in between
+  std::vector<std::size_t> preorder, postorder;
+
+  /// Returns true if node \p lhs dominates node \p rhs
+  bool dominates(std::size_t lhs, std::size_t rhs) const
+  {
+    return depths[lhs] != 0 && depths[rhs] != 0 &&
+           preorder[lhs] <= preorder[rhs] && postorder[rhs] <= postorder[lhs];
+  }
+};
+
+template <class T>
+const std::size_t cfg_dominator_treet<T>::npos;
+
+/// The dominators of a node as a read-only set, represented by a reference to
+/// the node in the \ref cfg_dominator_treet. Iteration walks up the tree,
+/// starting with the node itself. Membership is tested in constant time once
+/// the node of a program point is known.
+template <class T>
+class cfg_dominator_sett
+{
+public:
+  typedef cfg_dominator_treet<T> treet;
+
+  class const_iterator
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const T *pointer;
+    typedef const T &reference;
+
+    const_iterator(const treet *tree, std::size_t index)
+      : tree(tree), index(index)
+    {
+    }
+
+    reference operator*() const
+    {
+      return tree->program_points[index];
+    }
+
+    pointer operator->() const
+    {
+      return &tree->program_points[index];
+    }
+
+    const_iterator &operator++()
+    {
+      const std::size_t next = tree->immediate_dominators[index];
+      index = next == index ? treet::npos : next;
+      return *this;
+    }
+
+    const_iterator operator++(int)
+    {
+      const_iterator tmp = *this;
+      ++*this;
+      return tmp;
+    }
+
+    bool operator==(const const_iterator &other) const
+    {
+      return index == other.index;
+    }
+
+    bool operator!=(const const_iterator &other) const
+    {
+      return index != other.index;
+    }
+
+  private:
+    const treet *tree;
+    std::size_t index;
+  };
+
+  cfg_dominator_sett() : index(treet::npos)
+  {
+  }
+
+  cfg_dominator_sett(std::shared_ptr<const treet> tree, std::size_t index)
+    : tree(std::move(tree)), index(index)
+  {
+  }
+
+  const_iterator begin() const
+  {
+    return const_iterator(tree.get(), empty() ? treet::npos : index);
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator(tree.get(), treet::npos);
+  }
+
+  /// Number of dominators, which is zero for unreachable nodes
+  std::size_t size() const
+  {
+    return tree ? tree->depths[index] : 0;
+  }
+
+  bool empty() const
+  {
+    return size() == 0;
+  }
+
+  /// Returns true if the node with index \p node_index is a dominator
+  bool contains_node(std::size_t node_index) const
+  {
+    return tree && tree->dominates(node_index, index);
+  }
+
+  const_iterator find(const T &program_point) const
+  {
+    if(empty())
+      return end();
+
+    const auto entry = tree->indices.find(program_point);
+    if(entry == tree->indices.end() || !contains_node(entry->second))
+      return end();
+
+    return const_iterator(tree.get(), entry->second);
+  }
+
+  std::size_t count(const T &program_point) const
+  {
+    return find(program_point) != end() ? 1 : 0;
+  }
+
+private:
+  std::shared_ptr<const treet> tree;
+  std::size_t index;
+};
+
 /// Dominator graph. This computes a control-flow graph (see \ref cfgt) and
 /// decorates it with dominator sets per program point, following
 /// "A Simple, Fast Dominance Algorithm" by Cooper et al.
+/// The immediate dominators are computed by iterating over the nodes in
+/// reverse post-order; the dominator sets are views on the resulting
+/// dominator tree (see \ref cfg_dominator_sett), which takes memory linear in
+/// the number of program points and answers dominance queries in constant
+/// time.
 /// Templated over the program type (P) and program point type (T), which need
 /// to be supported by \ref cfgt. Can compute either dominators or
 /// postdominators depending on template parameter `post_dom`.
@@ -37,7 +201,7 @@ template <class P, class T, bool post_dom>
 class cfg_dominators_templatet
 {
 public:
-  typedef std::set<T> target_sett;
+  typedef cfg_dominator_sett<T> target_sett;
 
   struct nodet
   {
@@ -76,7 +240,7 @@ public:
   /// Note by definition all program points dominate themselves.
   bool dominates(T lhs, const nodet &rhs_node) const
   {
-    return rhs_node.dominators.count(lhs);
+    return rhs_node.dominators.contains_node(get_node_index(lhs));
   }
 
   /// Returns true if program point \p lhs dominates \p rhs.
@@ -142,11 +306,12 @@ void cfg_dominators_templatet<P, T, post_dom>::initialise(P &program)
   cfg(program);
 }
 
-/// Computes the MOP for the dominator analysis
+/// Computes the immediate dominators and from them the dominator tree
 template <class P, class T, bool post_dom>
 void cfg_dominators_templatet<P, T, post_dom>::fixedpoint(P &program)
 {
-  std::list<T> worklist;
+  typedef cfg_dominator_treet<T> treet;
+  const std::size_t npos = treet::npos;
 
   if(cfgt::nodes_empty(program))
     return;
@@ -155,83 +320,136 @@ void cfg_dominators_templatet<P, T, post_dom>::fixedpoint(P &program)
     entry_node = cfgt::get_last_node(program);
   else
     entry_node = cfgt::get_first_node(program);
-  typename cfgt::nodet &n = cfg.get_node(entry_node);
-  n.dominators.insert(entry_node);
+  const std::size_t root = cfg.get_node_index(entry_node);
 
-  for(typename cfgt::edgest::const_iterator
-      s_it=(post_dom?n.in:n.out).begin();
-      s_it!=(post_dom?n.in:n.out).end();
-      ++s_it)
-    worklist.push_back(cfg[s_it->first].PC);
+  typedef typename cfgt::edgest edgest;
+  const auto successors = [this](std::size_t n) -> const edgest & {
+    return post_dom ? cfg[n].in : cfg[n].out;
+  };
+  const auto predecessors = [this](std::size_t n) -> const edgest & {
+    return post_dom ? cfg[n].out : cfg[n].in;
+  };
 
-  while(!worklist.empty())
+  // number the nodes reachable from the root in post-order
+  const std::size_t size = cfg.size();
+  std::vector<std::size_t> postorder_number(size, npos);
+  std::vector<std::size_t> reverse_postorder;
   {
-    // get node from worklist
-    T current=worklist.front();
-    worklist.pop_front();
-
-    bool changed=false;
-    typename cfgt::nodet &node = cfg.get_node(current);
-    if(node.dominators.empty())
+    std::vector<bool> visited(size, false);
+    std::vector<std::pair<std::size_t, typename edgest::const_iterator>> stack;
+    visited[root] = true;
+    stack.emplace_back(root, successors(root).begin());
+    while(!stack.empty())
     {
-      for(const auto &edge : (post_dom ? node.out : node.in))
-        if(!cfg[edge.first].dominators.empty())
+      const std::size_t n = stack.back().first;
+      auto &edge = stack.back().second;
+      if(edge != successors(n).end())
+      {
+        const std::size_t s = (edge++)->first;
+        if(!visited[s])
         {
-          node.dominators=cfg[edge.first].dominators;
-          node.dominators.insert(current);
-          changed=true;
+          visited[s] = true;
+          stack.emplace_back(s, successors(s).begin());
         }
+      }
+      else
+      {
+        postorder_number[n] = reverse_postorder.size();
+        reverse_postorder.push_back(n);
+        stack.pop_back();
+      }
     }
+    std::reverse(reverse_postorder.begin(), reverse_postorder.end());
+  }
 
-    // compute intersection of predecessors
-    for(const auto &edge : (post_dom ? node.out : node.in))
+  auto tree = std::make_shared<treet>();
+  std::vector<std::size_t> &idom = tree->immediate_dominators;
+  idom.assign(size, npos);
+  idom[root] = root;
+
+  // walk up from both nodes to their nearest common dominator
+  const auto intersect = [&](std::size_t a, std::size_t b) {
+    while(a != b)
     {
-      const target_sett &other=cfg[edge.first].dominators;
-      if(other.empty())
-        continue;
+      while(postorder_number[a] < postorder_number[b])
+        a = idom[a];
+      while(postorder_number[b] < postorder_number[a])
+        b = idom[b];
+    }
+    return a;
+  };
 
-      typename target_sett::const_iterator n_it=node.dominators.begin();
-      typename target_sett::const_iterator o_it=other.begin();
+  for(bool changed = true; changed;)
+  {
+    changed = false;
+    for(const std::size_t n : reverse_postorder)
+    {
+      if(n == root)
+        continue;
 
-      // in-place intersection. not safe to use set_intersect
-      while(n_it!=node.dominators.end() && o_it!=other.end())
+      std::size_t new_idom = npos;
+      for(const auto &edge : predecessors(n))
       {
-        if(*n_it==current)
-          ++n_it;
-        else if(*n_it<*o_it)
-        {
-          changed=true;
-          node.dominators.erase(n_it++);
-        }
-        else if(*o_it<*n_it)
-          ++o_it;
-        else
-        {
-          ++n_it;
-          ++o_it;
-        }
+        if(idom[edge.first] == npos)
+          continue;
+        new_idom =
+          new_idom == npos ? edge.first : intersect(edge.first, new_idom);
       }
 
-      while(n_it!=node.dominators.end())
+      if(idom[n] != new_idom)
       {
-        if(*n_it==current)
-          ++n_it;
-        else
-        {
-          changed=true;
-          node.dominators.erase(n_it++);
-        }
+        idom[n] = new_idom;
+        changed = true;
       }
     }
+  }
 
-    if(changed) // fixed point for node reached?
+  // number the nodes of the dominator tree in a depth-first traversal
+  std::vector<std::vector<std::size_t>> children(size);
+  for(const std::size_t n : reverse_postorder)
+  {
+    if(n != root)
+      children[idom[n]].push_back(n);
+  }
+
+  tree->depths.assign(size, 0);
+  tree->preorder.assign(size, npos);
+  tree->postorder.assign(size, npos);
+  {
+    std::size_t counter = 0;
+    std::vector<std::pair<std::size_t, std::size_t>> stack;
+    tree->depths[root] = 1;
+    tree->preorder[root] = counter++;
+    stack.emplace_back(root, 0);
+    while(!stack.empty())
     {
-      for(const auto &edge : (post_dom ? node.in : node.out))
+      const std::size_t n = stack.back().first;
+      std::size_t &child = stack.back().second;
+      if(child < children[n].size())
       {
-        worklist.push_back(cfg[edge.first].PC);
+        const std::size_t c = children[n][child++];
+        tree->depths[c] = tree->depths[n] + 1;
+        tree->preorder[c] = counter++;
+        stack.emplace_back(c, 0);
+      }
+      else
+      {
+        tree->postorder[n] = counter++;
+        stack.pop_back();
       }
     }
   }
+
+  tree->program_points.reserve(size);
+  for(std::size_t n = 0; n < size; ++n)
+  {
+    tree->program_points.push_back(cfg[n].PC);
+    tree->indices.emplace(cfg[n].PC, n);
+  }
+
+  const std::shared_ptr<const treet> shared_tree = tree;
+  for(std::size_t n = 0; n < size; ++n)
+    cfg[n].dominators = target_sett(shared_tree, n);
 }
 
 /// Pretty-print a single node in the dominator tree. Supply a specialisation if
@@ -264,7 +482,9 @@ void cfg_dominators_templatet<P, T, post_dom>::output(std::ostream &out) const
     else
       out << " dominated by ";
     bool first=true;
-    for(const auto &d : cfg[node.second].dominators)
+    const std::set<T> dominators(
+      cfg[node.second].dominators.begin(), cfg[node.second].dominators.end());
+    for(const auto &d : dominators)
     {
       if(!first)
         out << ", ";
@@ -23,8 +23,13 @@ Author: Peter Schrammel
 #include <util/find_symbols.h>
 #include <util/ieee_float.h>
 #include <util/mathematical_types.h>
+#include <util/message.h>
 #include <util/simplify_expr.h>
 
+#include <goto-programs/remove_skip.h>
+#include <goto-programs/remove_unreachable.h>
+#include <goto-programs/remove_unused_functions.h>
+
 #include <langapi/language_util.h>
 
 #include <algorithm>
@@ -819,3 +824,89 @@ void constant_propagator_ait::replace_types_rec(
   Forall_operands(it, expr)
     replace_types_rec(replace_const, *it);
 }
+
+void propagate_constants_and_remove_dead_code(
+  goto_modelt &goto_model,
+  message_handlert &message_handler)
+{
+  messaget log(message_handler);
+
+  goto_functionst &goto_functions = goto_model.goto_functions;
+  if(
+    goto_functions.function_map.find(goto_functions.entry_point()) ==
+    goto_functions.function_map.end())
+  {
+    log.warning() << "no entry point, not removing dead code"
+                  << messaget::eom;
+    return;
+  }
+
+  // the analysis does not consider interleavings with other threads
+  forall_goto_functions(f_it, goto_functions)
+  {
+    forall_goto_program_instructions(i_it, f_it->second.body)
+    {
+      if(i_it->is_start_thread())
+      {
+        log.warning() << "program is concurrent, not removing dead code"
+                      << messaget::eom;
+        return;
+      }
+    }
+  }
+
+  // writes through pointers are not considered by the analysis
+  const dirtyt dirty(goto_functions);
+  constant_propagator_ait constant_propagator(
+    goto_model, [&dirty](const exprt &expr, const namespacet &) {
+      return expr.id() != ID_symbol || !dirty(to_symbol_expr(expr));
+    });
+
+  const namespacet ns(goto_model.symbol_table);
+
+  // the states of instructions the analysis never reached are bottom
+  std::size_t unreachable = 0;
+  std::size_t resolved_jumps = 0;
+  Forall_goto_functions(f_it, goto_functions)
+  {
+    Forall_goto_program_instructions(i_it, f_it->second.body)
+    {
+      const constant_propagator_domaint &state = constant_propagator[i_it];
+
+      if(state.is_bottom())
+      {
+        if(!i_it->is_end_function() && !i_it->is_skip())
+        {
+          i_it->turn_into_skip();
+          ++unreachable;
+        }
+      }
+      else if(i_it->is_goto() && !i_it->get_condition().is_constant())
+      {
+        // resolve jumps whose condition is decided by the constants found,
+        // which lets remove_unreachable drop the code they skip
+        exprt condition = i_it->get_condition();
+        if(
+          !constant_propagator_domaint::partial_evaluate(
+            state.values, condition, ns) &&
+          condition.is_constant())
+        {
+          if(condition.is_false())
+            i_it->turn_into_skip();
+          else
+            i_it->set_condition(condition);
+          ++resolved_jumps;
+        }
+      }
+    }
+  }
+
+  log.statistics() << "Removed " << unreachable << " unreachable instructions"
+                   << " and resolved " << resolved_jumps << " jumps"
+                   << messaget::eom;
+
+  remove_unreachable(goto_functions);
+  remove_skip(goto_functions);
+  remove_unused_functions(goto_functions, message_handler);
+  goto_functions.update();
+}
@@ -29,6 +29,7 @@ Author: Peter Schrammel
 #include "dirty.h"
 
 class constant_propagator_ait;
+class message_handlert;
 
 class constant_propagator_domaint:public ai_domain_baset
 {
@@ -236,4 +237,15 @@ protected:
   should_track_valuet should_track_value;
 };
 
+/// Propagate constants across the whole program, starting from its entry
+/// point, resolve the jumps whose condition is thereby decided, and then
+/// remove the code that is found to be unreachable, including functions
+/// that are no longer called. Only variables whose address is not taken are
+/// tracked, such that the result is sound. Concurrent programs are left
+/// unchanged, as the analysis does not consider other threads. Function
+/// pointers must have been removed before.
+void propagate_constants_and_remove_dead_code(
+  goto_modelt &goto_model,
+  message_handlert &message_handler);
+
 #endif // CPROVER_ANALYSES_CONSTANT_PROPAGATOR_H
@@ -19,30 +19,23 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <langapi/language_util.h>
 
 #include <iostream>
+#include <map>
 
 void custom_bitvector_domaint::set_bit(
   const irep_idt &identifier,
   unsigned bit_nr,
   modet mode)
 {
-  switch(mode)
-  {
-  case modet::SET_MUST:
-    set_bit(must_bits[identifier], bit_nr);
-    break;
-
-  case modet::CLEAR_MUST:
-    clear_bit(must_bits[identifier], bit_nr);
-    break;
+  bitst &bits =
+    mode == modet::SET_MUST || mode == modet::CLEAR_MUST ? must_bits : may_bits;
+  bit_vectort vector = get_bits(bits, identifier);
 
-  case modet::SET_MAY:
-    set_bit(may_bits[identifier], bit_nr);
-    break;
+  if(mode == modet::SET_MUST || mode == modet::SET_MAY)
+    vector.set(bit_nr);
+  else
+    vector.clear(bit_nr);
 
-  case modet::CLEAR_MAY:
-    clear_bit(may_bits[identifier], bit_nr);
-    break;
-  }
+  assign_bits(bits, identifier, vector);
 }
 
 void custom_bitvector_domaint::set_bit(
@@ -55,6 +48,77 @@ void custom_bitvector_domaint::set_bit(
     set_bit(id, bit_nr, mode);
 }
 
+std::vector<unsigned>
+custom_bitvector_domaint::bit_vectort::get_bit_numbers() const
+{
+  std::vector<unsigned> result;
+
+  for(std::size_t word = 0; word < words.size(); ++word)
+  {
+    for(wordt w = words[word]; w != 0; w &= w - 1)
+    {
+      unsigned bit = 0;
+      while((w & (wordt(1) << bit)) == 0)
+        ++bit;
+      result.push_back(static_cast<unsigned>(word * word_bits + bit));
+    }
+  }
+
+  return result;
+}
+
+custom_bitvector_domaint::bit_vectort custom_bitvector_domaint::get_bits(
+  const bitst &bits,
+  const irep_idt &identifier)
+{
+  const auto entry = bits.find(identifier);
+  if(entry.has_value())
+    return entry->get();
+  else
+    return bit_vectort();
+}
+
+/// Set the bits of \p identifier in \p bits to \p vector, where blank
+/// vectors are not stored to avoid noise
+void custom_bitvector_domaint::assign_bits(
+  bitst &bits,
+  const irep_idt &identifier,
+  const bit_vectort &vector)
+{
+  const auto entry = bits.find(identifier);
+
+  if(!entry.has_value())
+  {
+    if(!vector.empty())
+      bits.insert(identifier, vector);
+  }
+  else if(vector.empty())
+    bits.erase(identifier);
+  else if(entry->get() != vector)
+    bits.replace(identifier, vector);
+}
+
+/// Clear bit \p bit_nr of all objects in \p bits
+void custom_bitvector_domaint::clear_bit(bitst &bits, unsigned bit_nr)
+{
+  bitst::viewt view;
+  bits.get_view(view);
+
+  std::vector<irep_idt> identifiers;
+  for(const auto &entry : view)
+  {
+    if(entry.second.get(bit_nr))
+      identifiers.push_back(entry.first);
+  }
+
+  for(const auto &identifier : identifiers)
+  {
+    bit_vectort vector = get_bits(bits, identifier);
+    vector.clear(bit_nr);
+    assign_bits(bits, identifier, vector);
+  }
+}
+
 irep_idt custom_bitvector_domaint::object2id(const exprt &src)
 {
   if(src.id()==ID_symbol)
@@ -120,32 +184,16 @@ void custom_bitvector_domaint::assign_lhs(
   const irep_idt &identifier,
   const vectorst &vectors)
 {
-  // we erase blank ones to avoid noise
-
-  if(vectors.must_bits==0)
-    must_bits.erase(identifier);
-  else
-    must_bits[identifier]=vectors.must_bits;
-
-  if(vectors.may_bits==0)
-    may_bits.erase(identifier);
-  else
-    may_bits[identifier]=vectors.may_bits;
+  assign_bits(must_bits, identifier, vectors.must_bits);
+  assign_bits(may_bits, identifier, vectors.may_bits);
 }
 
 custom_bitvector_domaint::vectorst
   custom_bitvector_domaint::get_rhs(const irep_idt &identifier) const
 {
   vectorst vectors;
-
-  bitst::const_iterator may_it=may_bits.find(identifier);
-  if(may_it!=may_bits.end())
-    vectors.may_bits=may_it->second;
-
-  bitst::const_iterator must_it=must_bits.find(identifier);
-  if(must_it!=must_bits.end())
-    vectors.must_bits=must_it->second;
-
+  vectors.may_bits=get_bits(may_bits, identifier);
+  vectors.must_bits=get_bits(must_bits, identifier);
   return vectors;
 }
 
@@ -353,21 +401,9 @@ void custom_bitvector_domaint::transform(
                  to_constant_expr(lhs).get_value()==ID_NULL) // NULL means all
               {
                 if(mode==modet::CLEAR_MAY)
-                {
-                  for(auto &bit : may_bits)
-                    clear_bit(bit.second, bit_nr);
-
-                  // erase blank ones
-                  erase_blank_vectors(may_bits);
-                }
+                  clear_bit(may_bits, bit_nr);
                 else if(mode==modet::CLEAR_MUST)
-                {
-                  for(auto &bit : must_bits)
-                    clear_bit(bit.second, bit_nr);
-
-                  // erase blank ones
-                  erase_blank_vectors(must_bits);
-                }
+                  clear_bit(must_bits, bit_nr);
               }
               else
               {
@@ -481,25 +517,9 @@ void custom_bitvector_domaint::transform(
              to_constant_expr(lhs).get_value()==ID_NULL) // NULL means all
           {
             if(mode==modet::CLEAR_MAY)
-            {
-              for(bitst::iterator b_it=may_bits.begin();
-                  b_it!=may_bits.end();
-                  b_it++)
-                clear_bit(b_it->second, bit_nr);
-
-              // erase blank ones
-              erase_blank_vectors(may_bits);
-            }
+              clear_bit(may_bits, bit_nr);
             else if(mode==modet::CLEAR_MUST)
-            {
-              for(bitst::iterator b_it=must_bits.begin();
-                  b_it!=must_bits.end();
-                  b_it++)
-                clear_bit(b_it->second, bit_nr);
-
-              // erase blank ones
-              erase_blank_vectors(must_bits);
-            }
+              clear_bit(must_bits, bit_nr);
           }
           else
           {
@@ -573,37 +593,31 @@ void custom_bitvector_domaint::output(
   const custom_bitvector_analysist &cba=
     static_cast<const custom_bitvector_analysist &>(ai);
 
-  for(const auto &bit : may_bits)
-  {
-    out << bit.first << " MAY:";
-    bit_vectort b=bit.second;
-
-    for(unsigned i=0; b!=0; i++, b>>=1)
-      if(b&1)
-      {
-        assert(i<cba.bits.size());
-        out << ' '
-            << cba.bits[i];
-      }
-
-    out << '\n';
-  }
+  // list the objects in the order of their names
+  const auto output_bits = [&out, &cba](const bitst &bits, const char *kind) {
+    bitst::viewt view;
+    bits.get_view(view);
+    std::map<irep_idt, const bit_vectort *> sorted;
+    for(const auto &entry : view)
+      sorted.emplace(entry.first, &entry.second);
 
-  for(const auto &bit : must_bits)
-  {
-    out << bit.first << " MUST:";
-    bit_vectort b=bit.second;
+    for(const auto &bit : sorted)
+    {
+      out << bit.first << ' ' << kind << ':';
 
-    for(unsigned i=0; b!=0; i++, b>>=1)
-      if(b&1)
+      for(const auto i : bit.second->get_bit_numbers())
       {
         assert(i<cba.bits.size());
         out << ' '
             << cba.bits[i];
       }
 
-    out << '\n';
-  }
+      out << '\n';
+    }
+  };
+
+  output_bits(may_bits, "MAY");
+  output_bits(must_bits, "MUST");
 }
 
 bool custom_bitvector_domaint::merge(
@@ -611,77 +625,77 @@ bool custom_bitvector_domaint::merge(
   locationt,
   locationt)
 {
-  bool changed=has_values.is_false();
+  if(has_values.is_false())
+  {
+    // bottom is the identity of the join, and the maps can be shared
+    may_bits=b.may_bits;
+    must_bits=b.must_bits;
+    has_values=tvt::unknown();
+    return true;
+  }
+
   has_values=tvt::unknown();
 
-  // first do MAY
-  bitst::iterator it=may_bits.begin();
-  for(const auto &bit : b.may_bits)
+  if(b.has_values.is_false())
+    return false;
+
+  bool changed=false;
+
+  // first do MAY: the union of the bits, where only the entries that are
+  // not shared are visited
   {
-    while(it!=may_bits.end() && it->first<bit.first)
-      ++it;
-    if(it==may_bits.end() || bit.first<it->first)
-    {
-      may_bits.insert(it, bit);
-      changed=true;
-    }
-    else if(it!=may_bits.end())
+    bitst::delta_viewt delta_view;
+    b.may_bits.get_delta_view(may_bits, delta_view, false);
+
+    // the view refers into the maps, hence collect the changes first
+    std::vector<std::pair<irep_idt, bit_vectort>> joined;
+    for(const auto &item : delta_view)
     {
-      bit_vectort &a_bits=it->second;
-      bit_vectort old=a_bits;
-      a_bits|=bit.second;
-      if(old!=a_bits)
-        changed=true;
+      if(!item.is_in_both_maps())
+      {
+        joined.emplace_back(item.k, item.m);
+        continue;
+      }
 
-      ++it;
+      bit_vectort vector=item.get_other_map_value();
+      vector|=item.m;
+      if(vector!=item.get_other_map_value())
+        joined.emplace_back(item.k, std::move(vector));
     }
+
+    for(const auto &entry : joined)
+      assign_bits(may_bits, entry.first, entry.second);
+
+    changed|=!joined.empty();
   }
 
-  // now do MUST
-  it=must_bits.begin();
-  for(auto &bit : b.must_bits)
+  // now do MUST: the intersection of the bits
   {
-    while(it!=must_bits.end() && it->first<bit.first)
-    {
-      it=must_bits.erase(it);
-      changed=true;
-    }
-    if(it==must_bits.end() || bit.first<it->first)
-    {
-      must_bits.insert(it, bit);
-      changed=true;
-    }
-    else if(it!=must_bits.end())
+    bitst::delta_viewt delta_view;
+    must_bits.get_delta_view(b.must_bits, delta_view, false);
+
+    std::vector<std::pair<irep_idt, bit_vectort>> met;
+    for(const auto &item : delta_view)
     {
-      bit_vectort &a_bits=it->second;
-      bit_vectort old=a_bits;
-      a_bits&=bit.second;
-      if(old!=a_bits)
-        changed=true;
+      if(!item.is_in_both_maps())
+      {
+        met.emplace_back(item.k, bit_vectort());
+        continue;
+      }
 
-      ++it;
+      bit_vectort vector=item.m;
+      vector&=item.get_other_map_value();
+      if(vector!=item.m)
+        met.emplace_back(item.k, std::move(vector));
     }
-  }
 
-  // erase blank ones
-  erase_blank_vectors(may_bits);
-  erase_blank_vectors(must_bits);
-
-  return changed;
-}
+    for(const auto &entry : met)
+      assign_bits(must_bits, entry.first, entry.second);
 
-/// erase blank bitvectors
-void custom_bitvector_domaint::erase_blank_vectors(bitst &bits)
-{
-  for(bitst::iterator a_it=bits.begin();
-      a_it!=bits.end();
-     ) // no a_it++
-  {
-    if(a_it->second==0)
-      a_it=bits.erase(a_it);
-    else
-      a_it++;
+    changed|=!met.empty();
   }
+
+  return changed;
 }
 
 bool custom_bitvector_domaint::has_get_must_or_may(const exprt &src)
@@ -717,8 +731,11 @@ exprt custom_bitvector_domaint::eval(
       {
         if(src.id() == ID_get_may)
         {
-          for(const auto &bit : may_bits)
-            if(get_bit(bit.second, bit_nr))
+          bitst::viewt view;
+          may_bits.get_view(view);
+
+          for(const auto &bit : view)
+            if(bit.second.get(bit_nr))
               return true_exprt();
 
           return false_exprt();
@@ -738,9 +755,9 @@ exprt custom_bitvector_domaint::eval(
         bool value=false;
 
         if(src.id() == ID_get_must)
-          value=get_bit(v.must_bits, bit_nr);
+          value=v.must_bits.get(bit_nr);
         else if(src.id() == ID_get_may)
-          value=get_bit(v.may_bits, bit_nr);
+          value=v.may_bits.get(bit_nr);
 
         if(value)
           return true_exprt();
@@ -12,7 +12,11 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_ANALYSES_CUSTOM_BITVECTOR_ANALYSIS_H
 #define CPROVER_ANALYSES_CUSTOM_BITVECTOR_ANALYSIS_H
 
+#include <cstdint>
+#include <vector>
+
 #include <util/numbering.h>
+#include <util/sharing_map.h>
 #include <util/threeval.h>
 
 #include "ai.h"
@@ -76,23 +80,101 @@ public:
     locationt from,
     locationt to);
 
-  typedef unsigned long long bit_vectort;
+  /// A set of bit numbers of arbitrary width. The bits are kept in words
+  /// that are combined as a whole, and trailing blank words are never stored,
+  /// such that equal sets have equal representations.
+  class bit_vectort
+  {
+  public:
+    bool empty() const
+    {
+      return words.empty();
+    }
+
+    bool get(unsigned bit_nr) const
+    {
+      const std::size_t word = bit_nr / word_bits;
+      return word < words.size() &&
+             (words[word] & (wordt(1) << (bit_nr % word_bits))) != 0;
+    }
+
+    void set(unsigned bit_nr)
+    {
+      const std::size_t word = bit_nr / word_bits;
+      if(word >= words.size())
+        words.resize(word + 1, 0);
+      words[word] |= wordt(1) << (bit_nr % word_bits);
+    }
+
+    void clear(unsigned bit_nr)
+    {
+      const std::size_t word = bit_nr / word_bits;
+      if(word < words.size())
+      {
+        words[word] &= ~(wordt(1) << (bit_nr % word_bits));
+        trim();
+      }
+    }
+
+    bit_vectort &operator|=(const bit_vectort &other)
+    {
+      if(other.words.size() > words.size())
+        words.resize(other.words.size(), 0);
+      for(std::size_t i = 0; i < other.words.size(); ++i)
+        words[i] |= other.words[i];
+      return *this;
+    }
+
+    bit_vectort &operator&=(const bit_vectort &other)
+    {
+      if(words.size() > other.words.size())
+        words.resize(other.words.size());
+      for(std::size_t i = 0; i < words.size(); ++i)
+        words[i] &= other.words[i];
+      trim();
+      return *this;
+    }
+
+    bool operator==(const bit_vectort &other) const
+    {
+      return words == other.words;
+    }
+
+    bool operator!=(const bit_vectort &other) const
+    {
+      return words != other.words;
+    }
+
+    /// The numbers of the bits that are set, in increasing order
+    std::vector<unsigned> get_bit_numbers() const;
 
-  typedef std::map<irep_idt, bit_vectort> bitst;
+  protected:
+    typedef std::uint64_t wordt;
+    static const std::size_t word_bits = 64;
+    std::vector<wordt> words;
+
+    void trim()
+    {
+      while(!words.empty() && words.back() == 0)
+        words.pop_back();
+    }
+  };
+
+  /// The bits of each object, where objects without bits have no entry.
+  /// Sharing maps let the states of different locations share the entries
+  /// that they have in common, and merges skip those.
+  typedef sharing_mapt<irep_idt, bit_vectort, false, irep_id_hash> bitst;
 
   struct vectorst
   {
     bit_vectort may_bits, must_bits;
-    vectorst():may_bits(0), must_bits(0)
-    {
-    }
   };
 
   static vectorst merge(const vectorst &a, const vectorst &b)
   {
-    vectorst result;
-    result.may_bits=a.may_bits|b.may_bits;
-    result.must_bits=a.must_bits&b.must_bits;
+    vectorst result=a;
+    result.may_bits|=b.may_bits;
+    result.must_bits&=b.must_bits;
     return result;
   }
 
@@ -117,6 +199,10 @@ public:
   }
 
   static bool has_get_must_or_may(const exprt &);
+
+  /// Name of the object that bits of \p src are attached to, or the empty
+  /// identifier if \p src is not tracked
+  static irep_idt object2id(const exprt &src);
   exprt eval(
     const exprt &src,
     custom_bitvector_analysist &) const;
@@ -127,25 +213,10 @@ private:
   void set_bit(const exprt &, unsigned bit_nr, modet);
   void set_bit(const irep_idt &, unsigned bit_nr, modet);
 
-  static inline void set_bit(bit_vectort &dest, unsigned bit_nr)
-  {
-    dest|=(1ll<<bit_nr);
-  }
-
-  static inline void clear_bit(bit_vectort &dest, unsigned bit_nr)
-  {
-    dest|=(1ll<<bit_nr);
-    dest^=(1ll<<bit_nr);
-  }
-
-  static inline bool get_bit(const bit_vectort src, unsigned bit_nr)
-  {
-    return (src&(1ll<<bit_nr))!=0;
-  }
-
-  void erase_blank_vectors(bitst &);
-
-  static irep_idt object2id(const exprt &);
+  static bit_vectort get_bits(const bitst &, const irep_idt &);
+  static void
+  assign_bits(bitst &, const irep_idt &, const bit_vectort &);
+  static void clear_bit(bitst &, unsigned bit_nr);
 };
 
 class custom_bitvector_analysist:public ait<custom_bitvector_domaint>
@@ -87,9 +87,14 @@ public:
   ///   collected
   void collect_allocations(const goto_functionst &goto_functions);
 
+  local_bitvector_analysis_providert local_bitvector_analysis_provider;
+
 protected:
   const namespacet &ns;
-  std::unique_ptr<local_bitvector_analysist> local_bitvector_analysis;
+  /// The analysis of the pointers of the function being checked, which is
+  /// only set if checks may need it
+  const local_bitvector_analysist *local_bitvector_analysis;
+  std::unique_ptr<local_bitvector_analysist> own_local_bitvector_analysis;
   goto_programt::const_targett current_target;
   guard_managert guard_manager;
   bool no_enum_check;
@@ -309,6 +314,27 @@ void goto_checkt::invalidate(const exprt &lhs)
   }
 }
 
+/// The condition that \p divisor is non-zero, in each lane for vectors
+static exprt nonzero_divisor(const exprt &divisor)
+{
+  if(divisor.type().id() != ID_vector)
+    return notequal_exprt(divisor, from_integer(0, divisor.type()));
+
+  const vector_typet &vector_type = to_vector_type(divisor.type());
+  const std::size_t size = numeric_cast_v<std::size_t>(vector_type.size());
+
+  exprt::operandst conjuncts;
+  conjuncts.reserve(size);
+  for(std::size_t i = 0; i < size; ++i)
+  {
+    conjuncts.push_back(notequal_exprt(
+      index_exprt(divisor, from_integer(i, vector_type.size().type())),
+      from_integer(0, vector_type.subtype())));
+  }
+
+  return conjunction(conjuncts);
+}
+
 void goto_checkt::div_by_zero_check(
   const div_exprt &expr,
   const guardt &guard)
@@ -318,11 +344,8 @@ void goto_checkt::div_by_zero_check(
 
   // add divison by zero subgoal
 
-  exprt zero=from_integer(0, expr.op1().type());
-  const notequal_exprt inequality(expr.op1(), std::move(zero));
-
   add_guarded_property(
-    inequality,
+    nonzero_divisor(expr.op1()),
     "division by zero",
     "division-by-zero",
     expr.find_source_location(),
@@ -435,11 +458,8 @@ void goto_checkt::mod_by_zero_check(
 
   // add divison by zero subgoal
 
-  exprt zero=from_integer(0, expr.op1().type());
-  const notequal_exprt inequality(expr.op1(), std::move(zero));
-
   add_guarded_property(
-    inequality,
+    nonzero_divisor(expr.op1()),
     "division by zero",
     "division-by-zero",
     expr.find_source_location(),
@@ -1811,6 +1831,27 @@ private:
   std::list<std::pair<bool *, bool>> flags_to_reset;
 };
 
+static bool is_r_or_w_ok(const exprt &expr)
+{
+  return expr.id() == ID_r_ok || expr.id() == ID_w_ok;
+}
+
+/// Return true if \p goto_program contains an r_ok or w_ok expression
+static bool has_r_or_w_ok(const goto_programt &goto_program)
+{
+  for(const auto &instruction : goto_program.instructions)
+  {
+    if(
+      has_subexpr(instruction.code, is_r_or_w_ok) ||
+      has_subexpr(instruction.guard, is_r_or_w_ok))
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 void goto_checkt::goto_check(
   const irep_idt &function_identifier,
   goto_functiont &goto_function)
@@ -1822,8 +1863,25 @@ void goto_checkt::goto_check(
 
   bool did_something = false;
 
-  local_bitvector_analysis =
-    util_make_unique<local_bitvector_analysist>(goto_function, ns);
+  // The analysis is used by pointer checks, and by the checks of r_ok and
+  // w_ok, which are added whatever the options. It has to be computed before
+  // any checks are inserted.
+  local_bitvector_analysis = nullptr;
+  own_local_bitvector_analysis.reset();
+  if(enable_pointer_check || has_r_or_w_ok(goto_function.body))
+  {
+    if(local_bitvector_analysis_provider)
+    {
+      local_bitvector_analysis =
+        &local_bitvector_analysis_provider(function_identifier, goto_function);
+    }
+    else
+    {
+      own_local_bitvector_analysis =
+        util_make_unique<local_bitvector_analysist>(goto_function, ns);
+      local_bitvector_analysis = own_local_bitvector_analysis.get();
+    }
+  }
 
   goto_programt &goto_program=goto_function.body;
 
@@ -2172,3 +2230,22 @@ void goto_check(
   const namespacet ns(goto_model.symbol_table);
   goto_check(ns, options, goto_model.goto_functions);
 }
+
+std::function<void(const irep_idt &, goto_functionst::goto_functiont &)>
+goto_check_function(
+  const namespacet &ns,
+  const optionst &options,
+  const goto_functionst &goto_functions,
+  local_bitvector_analysis_providert local_bitvector_analysis_provider)
+{
+  const auto goto_check = std::make_shared<goto_checkt>(ns, options);
+  goto_check->collect_allocations(goto_functions);
+  goto_check->local_bitvector_analysis_provider =
+    std::move(local_bitvector_analysis_provider);
+
+  return [goto_check](
+           const irep_idt &function_identifier,
+           goto_functionst::goto_functiont &goto_function) {
+    goto_check->goto_check(function_identifier, goto_function);
+  };
+}
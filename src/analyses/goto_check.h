@@ -12,9 +12,12 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_ANALYSES_GOTO_CHECK_H
 #define CPROVER_ANALYSES_GOTO_CHECK_H
 
+#include <functional>
+
 #include <goto-programs/goto_functions.h>
 #include <goto-programs/goto_model.h>
 
+class local_bitvector_analysist;
 class namespacet;
 class optionst;
 
@@ -33,6 +36,25 @@ void goto_check(
   const optionst &options,
   goto_modelt &goto_model);
 
+/// Provides the local_bitvector_analysist of a function before the checks are
+/// added to it, for instance from a cache of analyses shared between passes
+typedef std::function<const local_bitvector_analysist &(
+  const irep_idt &,
+  const goto_functionst::goto_functiont &)>
+  local_bitvector_analysis_providert;
+
+/// Returns a function that adds the checks enabled in \p options to a single
+/// function, with the allocations collected from all of \p goto_functions
+/// upfront. \p ns must outlive the returned function. The analysis of
+/// pointers is taken from \p local_bitvector_analysis_provider if given, and
+/// is otherwise computed for each function that needs it.
+std::function<void(const irep_idt &, goto_functionst::goto_functiont &)>
+goto_check_function(
+  const namespacet &ns,
+  const optionst &options,
+  const goto_functionst &goto_functions,
+  local_bitvector_analysis_providert local_bitvector_analysis_provider = {});
+
 #define OPT_GOTO_CHECK                                                         \
   "(bounds-check)(pointer-check)(memory-leak-check)"                           \
   "(div-by-zero-check)(enum-range-check)(signed-overflow-check)(unsigned-"     \
@@ -21,10 +21,10 @@ using guardt = guard_bddt;
 
 #else
 
-#include "guard_expr.h"
+#include "guard_hybrid.h"
 
-using guard_managert = guard_expr_managert;
-using guardt = guard_exprt;
+using guard_managert = guard_hybrid_managert;
+using guardt = guard_hybridt;
 
 #endif // BDD_GUARDS
 
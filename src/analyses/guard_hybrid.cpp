@@ -0,0 +1,192 @@
+/*******************************************************************\
+
+Module: Guard Data Structure
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Implementation of guards using BDDs for small guards and expressions
+/// otherwise
+
+#include "guard_hybrid.h"
+
+#include <util/expr_iterator.h>
+#include <util/expr_util.h>
+#include <util/invariant.h>
+
+guard_hybridt::guard_hybridt(const exprt &e, guard_hybrid_managert &manager)
+  : manager(manager), expr(e, manager.expr_manager)
+{
+  if(fits_bdd(e))
+  {
+    bdd = manager.bdd_manager.from_expr(e);
+    check_bdd_size();
+  }
+}
+
+guard_hybridt &guard_hybridt::operator=(const guard_hybridt &other)
+{
+  PRECONDITION(&manager == &other.manager);
+  bdd = other.bdd;
+  expr = other.expr;
+  return *this;
+}
+
+guard_hybridt &guard_hybridt::operator=(guard_hybridt &&other)
+{
+  PRECONDITION(&manager == &other.manager);
+  std::swap(bdd, other.bdd);
+  std::swap(expr, other.expr);
+  return *this;
+}
+
+bool guard_hybridt::fits_bdd(const exprt &e) const
+{
+  std::size_t nodes = 0;
+  for(auto it = e.depth_cbegin(); it != e.depth_cend(); ++it)
+  {
+    if(++nodes > manager.max_bdd_nodes)
+      return false;
+  }
+  return true;
+}
+
+void guard_hybridt::check_bdd_size()
+{
+  if(
+    bdd && manager.bdd_manager.node_count(*bdd, manager.max_bdd_nodes) >
+             manager.max_bdd_nodes)
+  {
+    make_expr();
+  }
+}
+
+void guard_hybridt::make_expr()
+{
+  if(!bdd)
+    return;
+
+  expr = guard_exprt(manager.bdd_manager.as_expr(*bdd), manager.expr_manager);
+  bdd.reset();
+}
+
+exprt guard_hybridt::as_expr() const
+{
+  if(bdd)
+    return manager.bdd_manager.as_expr(*bdd);
+  return expr.as_expr();
+}
+
+exprt guard_hybridt::guard_expr(exprt expr) const
+{
+  if(is_true())
+  {
+    // do nothing
+    return expr;
+  }
+  else
+  {
+    if(expr.is_false())
+    {
+      return boolean_negate(as_expr());
+    }
+    else
+    {
+      return implies_exprt{as_expr(), expr};
+    }
+  }
+}
+
+guard_hybridt &guard_hybridt::add(const exprt &expr)
+{
+  if(bdd && fits_bdd(expr))
+  {
+    bdd = bdd->bdd_and(manager.bdd_manager.from_expr(expr));
+    check_bdd_size();
+  }
+  else
+  {
+    make_expr();
+    this->expr.add(expr);
+  }
+
+  return *this;
+}
+
+guard_hybridt &guard_hybridt::append(const guard_hybridt &guard)
+{
+  if(bdd && guard.bdd)
+  {
+    bdd = bdd->bdd_and(*guard.bdd);
+    check_bdd_size();
+  }
+  else
+  {
+    make_expr();
+    expr.add(guard.as_expr());
+  }
+
+  return *this;
+}
+
+guard_hybridt &operator-=(guard_hybridt &g1, const guard_hybridt &g2)
+{
+  if(g1.bdd && g2.bdd)
+  {
+    g1.bdd = g1.bdd->constrain(g2.bdd->bdd_or(*g1.bdd));
+    g1.check_bdd_size();
+  }
+  else
+  {
+    g1.make_expr();
+    g1.expr -= guard_exprt(g2.as_expr(), g1.manager.expr_manager);
+  }
+
+  return g1;
+}
+
+guard_hybridt &operator|=(guard_hybridt &g1, const guard_hybridt &g2)
+{
+  if(g1.bdd && g2.bdd)
+  {
+    g1.bdd = g1.bdd->bdd_or(*g2.bdd);
+    g1.check_bdd_size();
+  }
+  else
+  {
+    g1.make_expr();
+    g1.expr |= guard_exprt(g2.as_expr(), g1.manager.expr_manager);
+  }
+
+  return g1;
+}
+
+guard_hybridt guard_hybridt::operator!() const
+{
+  guard_hybridt result = *this;
+
+  if(result.bdd)
+    result.bdd = result.bdd->bdd_not();
+  else
+    result.expr =
+      guard_exprt(boolean_negate(expr.as_expr()), manager.expr_manager);
+
+  return result;
+}
+
+bool guard_hybridt::disjunction_may_simplify(const guard_hybridt &other_guard)
+{
+  if(bdd && other_guard.bdd)
+    return true;
+
+  if(bdd)
+  {
+    return guard_exprt(as_expr(), manager.expr_manager)
+      .disjunction_may_simplify(other_guard.expr);
+  }
+
+  return expr.disjunction_may_simplify(
+    guard_exprt(other_guard.as_expr(), manager.expr_manager));
+}
@@ -0,0 +1,115 @@
+/*******************************************************************\
+
+Module: Guard Data Structure
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Guard Data Structure
+/// Implementation using BDDs for small guards and expressions otherwise
+
+#ifndef CPROVER_ANALYSES_GUARD_HYBRID_H
+#define CPROVER_ANALYSES_GUARD_HYBRID_H
+
+#include <cstddef>
+
+#include <solvers/bdd/bdd.h>
+#include <solvers/prop/bdd_expr.h>
+#include <util/optional.h>
+#include <util/std_expr.h>
+
+#include "guard_expr.h"
+
+/// Manager shared by all guards of a \ref guard_hybridt family
+struct guard_hybrid_managert
+{
+  /// \param max_bdd_nodes: guards whose BDD would have more nodes than this
+  ///   are represented as expressions; 0 disables the use of BDDs
+  explicit guard_hybrid_managert(std::size_t max_bdd_nodes = 0)
+    : max_bdd_nodes(max_bdd_nodes)
+  {
+  }
+
+  /// Can be changed at any time; guards that already turned into
+  /// expressions do not go back to BDDs
+  std::size_t max_bdd_nodes;
+
+  bdd_exprt bdd_manager;
+  guard_expr_managert expr_manager;
+};
+
+/// Guard that is kept as a BDD as long as that stays small, which gives
+/// canonical, simplified guards for the common case of few nested branches.
+/// Once the BDD exceeds the size limit of the manager, or an operand is too
+/// large to be converted to a BDD, the guard turns into an expression for the
+/// rest of its lifetime. The expression of a BDD shares the sub-expressions
+/// of common nodes, so the guard is then a DAG rather than a tree.
+class guard_hybridt
+{
+public:
+  guard_hybridt(const exprt &e, guard_hybrid_managert &manager);
+  guard_hybridt(const guard_hybridt &other) = default;
+
+  guard_hybridt &operator=(const guard_hybridt &other);
+  guard_hybridt &operator=(guard_hybridt &&other);
+  guard_hybridt &add(const exprt &expr);
+  guard_hybridt &append(const guard_hybridt &guard);
+  exprt as_expr() const;
+
+  /// Only guards that are BDDs are always in a simplified form.
+  static constexpr bool is_always_simplified = false;
+
+  /// Return `guard => dest` or a simplified variant thereof if either guard or
+  /// dest are trivial.
+  exprt guard_expr(exprt expr) const;
+
+  bool is_true() const
+  {
+    return bdd ? bdd->is_true() : expr.is_true();
+  }
+
+  bool is_false() const
+  {
+    return bdd ? bdd->is_false() : expr.is_false();
+  }
+
+  /// \return True if the guard is represented by a BDD
+  bool is_bdd() const
+  {
+    return bdd.has_value();
+  }
+
+  /// Transforms \p g1 into \c g1' such that `g1' & g2 => g1 => g1'`
+  /// and returns a reference to g1.
+  friend guard_hybridt &operator-=(guard_hybridt &g1, const guard_hybridt &g2);
+
+  friend guard_hybridt &operator|=(guard_hybridt &g1, const guard_hybridt &g2);
+
+  guard_hybridt operator!() const;
+
+  /// Returns true if `operator|=` with \p other_guard may result in a simpler
+  /// expression, which is always the case when both are BDDs.
+  bool disjunction_may_simplify(const guard_hybridt &other_guard);
+
+private:
+  guard_hybrid_managert &manager;
+
+  /// The guard as a BDD, if it is small enough
+  optionalt<bddt> bdd;
+
+  /// The guard as an expression, used when \ref bdd is empty
+  guard_exprt expr;
+
+  /// \return True if \p e is small enough to be converted to a BDD
+  bool fits_bdd(const exprt &e) const;
+
+  /// Turn the guard into an expression if its BDD has become too large
+  void check_bdd_size();
+
+  /// Turn the guard into an expression
+  void make_expr();
+};
+
+#endif // CPROVER_ANALYSES_GUARD_HYBRID_H
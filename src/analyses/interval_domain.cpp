@@ -16,10 +16,45 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <langapi/language_util.h>
 #endif
 
+#include <algorithm>
+
 #include <util/simplify_expr.h>
 #include <util/std_expr.h>
 #include <util/arith_tools.h>
 
+/// Output the intervals of \p map that are not top, ordered by identifier
+template <typename mapt>
+void interval_domaint::output_map(std::ostream &out, const mapt &map)
+{
+  typename mapt::viewt view;
+  map.get_view(view);
+
+  std::vector<const typename mapt::view_itemt *> sorted;
+  sorted.reserve(view.size());
+  for(const auto &item : view)
+    sorted.push_back(&item);
+  std::sort(
+    sorted.begin(),
+    sorted.end(),
+    [](
+      const typename mapt::view_itemt *a, const typename mapt::view_itemt *b) {
+      return a->first < b->first;
+    });
+
+  for(const auto *item : sorted)
+  {
+    const auto &interval = item->second;
+    if(interval.is_top())
+      continue;
+    if(interval.lower_set)
+      out << interval.lower << " <= ";
+    out << item->first;
+    if(interval.upper_set)
+      out << " <= " << interval.upper;
+    out << "\n";
+  }
+}
+
 void interval_domaint::output(
   std::ostream &out,
   const ai_baset &,
@@ -31,29 +66,8 @@ void interval_domaint::output(
     return;
   }
 
-  for(const auto &interval : int_map)
-  {
-    if(interval.second.is_top())
-      continue;
-    if(interval.second.lower_set)
-      out << interval.second.lower << " <= ";
-    out << interval.first;
-    if(interval.second.upper_set)
-      out << " <= " << interval.second.upper;
-    out << "\n";
-  }
-
-  for(const auto &interval : float_map)
-  {
-    if(interval.second.is_top())
-      continue;
-    if(interval.second.lower_set)
-      out << interval.second.lower << " <= ";
-    out << interval.first;
-    if(interval.second.upper_set)
-      out << " <= " << interval.second.upper;
-    out << "\n";
-  }
+  output_map(out, int_map);
+  output_map(out, float_map);
 }
 
 void interval_domaint::transform(
@@ -159,51 +173,123 @@ bool interval_domaint::join(
     return true;
   }
 
-  bool result=false;
+  const bool int_result = join_map(int_map, b.int_map);
+  const bool float_result = join_map(float_map, b.float_map);
+  return int_result || float_result;
+}
+
+/// Join the intervals in \p other into \p map
+/// \return True if \p map changed
+template <typename mapt>
+bool interval_domaint::join_map(mapt &map, const mapt &other)
+{
+  return join_map(
+    map,
+    other,
+    [](
+      const typename mapt::mapped_type &, typename mapt::mapped_type &) {});
+}
 
-  for(int_mapt::iterator it=int_map.begin();
-      it!=int_map.end(); ) // no it++
+/// Join the intervals in \p other into \p map, and apply \p widen to the
+/// previous and the joined interval of each variable whose interval changed.
+/// Only the intervals that are not shared between the maps are visited.
+/// \return True if \p map changed
+template <typename mapt, typename wident>
+bool interval_domaint::join_map(mapt &map, const mapt &other, wident widen)
+{
+  typename mapt::delta_viewt delta_view;
+  map.get_delta_view(other, delta_view, false);
+
+  // the view refers into the map, hence collect the changes first
+  std::vector<irep_idt> erased;
+  std::vector<std::pair<irep_idt, typename mapt::mapped_type>> joined;
+
+  for(const auto &item : delta_view)
   {
-    // search for the variable that needs to be merged
-    // containers have different size and variable order
-    const int_mapt::const_iterator b_it=b.int_map.find(it->first);
-    if(b_it==b.int_map.end())
+    if(!item.is_in_both_maps())
     {
-      it=int_map.erase(it);
-      result=true;
+      // no constraint on this variable in 'other'
+      erased.push_back(item.k);
+      continue;
     }
-    else
-    {
-      integer_intervalt previous=it->second;
-      it->second.join(b_it->second);
-      if(it->second!=previous)
-        result=true;
 
-      it++;
+    typename mapt::mapped_type interval = item.m;
+    interval.join(item.get_other_map_value());
+    if(interval != item.m)
+    {
+      widen(item.m, interval);
+      joined.emplace_back(item.k, std::move(interval));
     }
   }
 
-  for(float_mapt::iterator it=float_map.begin();
-      it!=float_map.end(); ) // no it++
-  {
-    const float_mapt::const_iterator b_it=b.float_map.begin();
-    if(b_it==b.float_map.end())
-    {
-      it=float_map.erase(it);
-      result=true;
-    }
-    else
-    {
-      ieee_float_intervalt previous=it->second;
-      it->second.join(b_it->second);
-      if(it->second!=previous)
-        result=true;
+  for(const auto &identifier : erased)
+    map.erase(identifier);
 
-      it++;
-    }
+  for(const auto &interval : joined)
+    map.replace(interval.first, interval.second);
+
+  return !erased.empty() || !joined.empty();
+}
+
+bool interval_domaint::widen(
+  const interval_domaint &b,
+  const thresholdst &thresholds)
+{
+  if(b.bottom)
+    return false;
+  if(bottom)
+  {
+    *this = b;
+    return true;
   }
 
-  return result;
+  const bool int_result = join_map(
+    int_map,
+    b.int_map,
+    [&thresholds](
+      const integer_intervalt &previous, integer_intervalt &interval) {
+      if(
+        interval.upper_set &&
+        (!previous.upper_set || interval.upper > previous.upper))
+      {
+        const auto t_it = thresholds.lower_bound(interval.upper);
+        if(t_it == thresholds.end())
+          interval.upper_set = false;
+        else
+          interval.upper = *t_it;
+      }
+
+      if(
+        interval.lower_set &&
+        (!previous.lower_set || interval.lower < previous.lower))
+      {
+        auto t_it = thresholds.upper_bound(interval.lower);
+        if(t_it == thresholds.begin())
+          interval.lower_set = false;
+        else
+          interval.lower = *--t_it;
+      }
+    });
+
+  const bool float_result = join_map(
+    float_map,
+    b.float_map,
+    [](const ieee_float_intervalt &previous, ieee_float_intervalt &interval) {
+      if(
+        interval.upper_set &&
+        (!previous.upper_set || previous.upper < interval.upper))
+      {
+        interval.upper_set = false;
+      }
+      if(
+        interval.lower_set &&
+        (!previous.lower_set || interval.lower < previous.lower))
+      {
+        interval.lower_set = false;
+      }
+    });
+
+  return int_result || float_result;
 }
 
 void interval_domaint::assign(const code_assignt &code_assign)
@@ -224,9 +310,9 @@ void interval_domaint::havoc_rec(const exprt &lhs)
     irep_idt identifier=to_symbol_expr(lhs).get_identifier();
 
     if(is_int(lhs.type()))
-      int_map.erase(identifier);
+      int_map.erase_if_exists(identifier);
     else if(is_float(lhs.type()))
-      float_map.erase(identifier);
+      float_map.erase_if_exists(identifier);
   }
   else if(lhs.id()==ID_typecast)
   {
@@ -279,8 +365,9 @@ void interval_domaint::assume_rec(
       mp_integer tmp = numeric_cast_v<mp_integer>(to_constant_expr(rhs));
       if(id==ID_lt)
         --tmp;
-      integer_intervalt &ii=int_map[lhs_identifier];
+      integer_intervalt ii = get_interval(int_map, lhs_identifier);
       ii.make_le_than(tmp);
+      set_interval(int_map, lhs_identifier, ii);
       if(ii.is_bottom())
         make_bottom();
     }
@@ -289,8 +376,9 @@ void interval_domaint::assume_rec(
       ieee_floatt tmp(to_constant_expr(rhs));
       if(id==ID_lt)
         tmp.decrement();
-      ieee_float_intervalt &fi=float_map[lhs_identifier];
+      ieee_float_intervalt fi = get_interval(float_map, lhs_identifier);
       fi.make_le_than(tmp);
+      set_interval(float_map, lhs_identifier, fi);
       if(fi.is_bottom())
         make_bottom();
     }
@@ -304,8 +392,9 @@ void interval_domaint::assume_rec(
       mp_integer tmp = numeric_cast_v<mp_integer>(to_constant_expr(lhs));
       if(id==ID_lt)
         ++tmp;
-      integer_intervalt &ii=int_map[rhs_identifier];
+      integer_intervalt ii = get_interval(int_map, rhs_identifier);
       ii.make_ge_than(tmp);
+      set_interval(int_map, rhs_identifier, ii);
       if(ii.is_bottom())
         make_bottom();
     }
@@ -314,8 +403,9 @@ void interval_domaint::assume_rec(
       ieee_floatt tmp(to_constant_expr(lhs));
       if(id==ID_lt)
         tmp.increment();
-      ieee_float_intervalt &fi=float_map[rhs_identifier];
+      ieee_float_intervalt fi = get_interval(float_map, rhs_identifier);
       fi.make_ge_than(tmp);
+      set_interval(float_map, rhs_identifier, fi);
       if(fi.is_bottom())
         make_bottom();
     }
@@ -327,20 +417,20 @@ void interval_domaint::assume_rec(
 
     if(is_int(lhs.type()) && is_int(rhs.type()))
     {
-      integer_intervalt &lhs_i=int_map[lhs_identifier];
-      integer_intervalt &rhs_i=int_map[rhs_identifier];
-      lhs_i.meet(rhs_i);
-      rhs_i=lhs_i;
-      if(rhs_i.is_bottom())
+      integer_intervalt lhs_i = get_interval(int_map, lhs_identifier);
+      lhs_i.meet(get_interval(int_map, rhs_identifier));
+      set_interval(int_map, lhs_identifier, lhs_i);
+      set_interval(int_map, rhs_identifier, lhs_i);
+      if(lhs_i.is_bottom())
         make_bottom();
     }
     else if(is_float(lhs.type()) && is_float(rhs.type()))
     {
-      ieee_float_intervalt &lhs_i=float_map[lhs_identifier];
-      ieee_float_intervalt &rhs_i=float_map[rhs_identifier];
-      lhs_i.meet(rhs_i);
-      rhs_i=lhs_i;
-      if(rhs_i.is_bottom())
+      ieee_float_intervalt lhs_i = get_interval(float_map, lhs_identifier);
+      lhs_i.meet(get_interval(float_map, rhs_identifier));
+      set_interval(float_map, lhs_identifier, lhs_i);
+      set_interval(float_map, rhs_identifier, lhs_i);
+      if(lhs_i.is_bottom())
         make_bottom();
     }
   }
@@ -403,11 +493,11 @@ exprt interval_domaint::make_expression(const symbol_exprt &src) const
 {
   if(is_int(src.type()))
   {
-    int_mapt::const_iterator i_it=int_map.find(src.get_identifier());
-    if(i_it==int_map.end())
+    const auto i_it = int_map.find(src.get_identifier());
+    if(!i_it.has_value())
       return true_exprt();
 
-    const integer_intervalt &interval=i_it->second;
+    const integer_intervalt &interval = i_it->get();
     if(interval.is_top())
       return true_exprt();
     if(interval.is_bottom())
@@ -431,11 +521,11 @@ exprt interval_domaint::make_expression(const symbol_exprt &src) const
   }
   else if(is_float(src.type()))
   {
-    float_mapt::const_iterator i_it=float_map.find(src.get_identifier());
-    if(i_it==float_map.end())
+    const auto i_it = float_map.find(src.get_identifier());
+    if(!i_it.has_value())
       return true_exprt();
 
-    const ieee_float_intervalt &interval=i_it->second;
+    const ieee_float_intervalt &interval = i_it->get();
     if(interval.is_top())
       return true_exprt();
     if(interval.is_bottom())
@@ -515,3 +605,47 @@ bool interval_domaint::ai_simplify(
 
   return unchanged;
 }
+
+void interval_ait::initialize(
+  const irep_idt &function_id,
+  const goto_programt &goto_program)
+{
+  ait<interval_domaint>::initialize(function_id, goto_program);
+
+  if(!widening_delay.has_value() || !use_thresholds)
+    return;
+
+  forall_goto_program_instructions(i_it, goto_program)
+  {
+    auto collect_constants = [this](const exprt &expr) {
+      expr.visit_pre([this](const exprt &e) {
+        if(e.id() == ID_constant && interval_domaint::is_int(e.type()))
+        {
+          const auto value = numeric_cast<mp_integer>(to_constant_expr(e));
+          if(value.has_value())
+            thresholds.insert(*value);
+        }
+      });
+    };
+
+    collect_constants(i_it->code);
+    if(i_it->has_condition())
+      collect_constants(i_it->get_condition());
+  }
+}
+
+bool interval_ait::merge(const statet &src, locationt from, locationt to)
+{
+  interval_domaint &dest = static_cast<interval_domaint &>(get_state(to));
+  const interval_domaint &source = static_cast<const interval_domaint &>(src);
+
+  if(
+    widening_delay.has_value() &&
+    from->location_number >= to->location_number &&
+    ++back_joins[to] > *widening_delay)
+  {
+    return dest.widen(source, thresholds);
+  }
+
+  return dest.merge(source, from, to);
+}
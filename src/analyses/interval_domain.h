@@ -15,6 +15,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/ieee_float.h>
 #include <util/integer_interval.h>
 #include <util/interval_template.h>
+#include <util/sharing_map.h>
+
+#include <set>
 
 #include "ai.h"
 
@@ -26,6 +29,8 @@ public:
   // Trivial, conjunctive interval domain for both float
   // and integers. The categorization 'float' and 'integers'
   // is done by is_int and is_float.
+  // The intervals are kept in sharing maps, such that the states of
+  // neighbouring locations share the intervals that they agree on.
 
   interval_domaint():bottom(true)
   {
@@ -56,6 +61,14 @@ public:
     return join(b);
   }
 
+  typedef std::set<mp_integer> thresholdst;
+
+  /// Join \p b into this domain, and widen the bounds that grew: an integer
+  /// bound moves to the nearest value in \p thresholds that includes it, or
+  /// is dropped if there is none. Float bounds that grew are dropped.
+  /// \return True if the domain changed
+  bool widen(const interval_domaint &b, const thresholdst &thresholds);
+
   // no states
   void make_bottom() final override
   {
@@ -114,12 +127,46 @@ public:
 protected:
   bool bottom;
 
-  typedef std::map<irep_idt, integer_intervalt> int_mapt;
-  typedef std::map<irep_idt, ieee_float_intervalt> float_mapt;
+  typedef sharing_mapt<irep_idt, integer_intervalt, false, irep_id_hash>
+    int_mapt;
+  typedef sharing_mapt<irep_idt, ieee_float_intervalt, false, irep_id_hash>
+    float_mapt;
 
   int_mapt int_map;
   float_mapt float_map;
 
+  /// \return the interval of \p identifier, which is top if there is none
+  template <typename mapt>
+  static typename mapt::mapped_type
+  get_interval(const mapt &map, const irep_idt &identifier)
+  {
+    const auto interval = map.find(identifier);
+    if(interval.has_value())
+      return interval->get();
+    return typename mapt::mapped_type();
+  }
+
+  template <typename mapt>
+  static void set_interval(
+    mapt &map,
+    const irep_idt &identifier,
+    const typename mapt::mapped_type &interval)
+  {
+    if(map.has_key(identifier))
+      map.replace(identifier, interval);
+    else
+      map.insert(identifier, interval);
+  }
+
+  template <typename mapt>
+  static bool join_map(mapt &map, const mapt &other);
+
+  template <typename mapt, typename wident>
+  static bool join_map(mapt &map, const mapt &other, wident widen);
+
+  template <typename mapt>
+  static void output_map(std::ostream &out, const mapt &map);
+
   void havoc_rec(const exprt &);
   void assume_rec(const exprt &, bool negation=false);
   void assume_rec(const exprt &lhs, irep_idt id, const exprt &rhs);
@@ -128,4 +175,37 @@ protected:
   ieee_float_intervalt get_float_rec(const exprt &);
 };
 
+/// Interval analysis, which optionally widens the states at the targets of
+/// backward edges to bound the number of iterations of loops
+class interval_ait : public ait<interval_domaint>
+{
+public:
+  /// \param widening_delay: number of joins along backward edges into a
+  ///   location after which its state is widened; no widening if not set
+  /// \param use_thresholds: widen integer bounds to the integer constants in
+  ///   the program, rather than dropping them
+  explicit interval_ait(
+    optionalt<std::size_t> widening_delay = {},
+    bool use_thresholds = false)
+    : widening_delay(widening_delay), use_thresholds(use_thresholds)
+  {
+  }
+
+protected:
+  const optionalt<std::size_t> widening_delay;
+  const bool use_thresholds;
+
+  /// Integer constants of all functions that \ref initialize was called for.
+  /// The set is shared by all functions rather than kept per function, as
+  /// values flow between functions through calls.
+  interval_domaint::thresholdst thresholds;
+
+  /// Number of joins along backward edges into each location
+  std::unordered_map<locationt, std::size_t, const_target_hash> back_joins;
+
+  void initialize(const irep_idt &, const goto_programt &) override;
+
+  bool merge(const statet &src, locationt from, locationt to) override;
+};
+
 #endif // CPROVER_ANALYSES_INTERVAL_DOMAIN_H
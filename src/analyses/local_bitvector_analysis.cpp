@@ -58,7 +58,7 @@ bool local_bitvector_analysist::merge(points_tot &a, points_tot &b)
 }
 
 /// \return return 'true' iff we track the object with given identifier
-bool local_bitvector_analysist::is_tracked(const irep_idt &identifier)
+bool local_bitvector_analysist::is_tracked(const irep_idt &identifier) const
 {
   localst::locals_sett::const_iterator it = locals.locals.find(identifier);
   return it != locals.locals.end() && ns.lookup(*it).type.id() == ID_pointer &&
@@ -107,7 +107,7 @@ void local_bitvector_analysist::assign_lhs(
 
 local_bitvector_analysist::flagst local_bitvector_analysist::get(
   const goto_programt::const_targett t,
-  const exprt &rhs)
+  const exprt &rhs) const
 {
   local_cfgt::loc_mapt::const_iterator loc_it=cfg.loc_map.find(t);
 
@@ -118,7 +118,7 @@ local_bitvector_analysist::flagst local_bitvector_analysist::get(
 
 local_bitvector_analysist::flagst local_bitvector_analysist::get_rec(
   const exprt &rhs,
-  points_tot &loc_info_src)
+  const points_tot &loc_info_src) const
 {
   if(rhs.id()==ID_constant)
   {
@@ -132,8 +132,11 @@ local_bitvector_analysist::flagst local_bitvector_analysist::get_rec(
     const irep_idt &identifier=to_symbol_expr(rhs).get_identifier();
     if(is_tracked(identifier))
     {
-      unsigned src_pointer=pointers.number(identifier);
-      return loc_info_src[src_pointer];
+      // pointers without an entry have no flags
+      const auto src_pointer=pointers.get_number(identifier);
+      if(!src_pointer.has_value() || *src_pointer>=loc_info_src.size())
+        return flagst();
+      return *std::next(loc_info_src.begin(), *src_pointer);
     }
     else
       return flagst::mk_unknown();
@@ -175,7 +175,7 @@ public:
 
   flagst get(
     const goto_programt::const_targett t,
-    const exprt &src);
+    const exprt &src) const;
 
 protected:
   const namespacet &ns;
@@ -202,9 +202,9 @@ protected:
 
   flagst get_rec(
     const exprt &rhs,
-    points_tot &loc_info_src);
+    const points_tot &loc_info_src) const;
 
-  bool is_tracked(const irep_idt &identifier);
+  bool is_tracked(const irep_idt &identifier) const;
 };
 
 inline std::ostream &operator<<(
@@ -54,13 +54,12 @@ void rd_range_domaint::populate_cache(const irep_idt &identifier) const
 
   ranges_at_loct &export_entry=export_cache[identifier];
 
-  for(const auto &id : v_entry->second)
-  {
-    const reaching_definitiont &v=bv_container->get(id);
+  v_entry->second.for_each([&](std::size_t id) {
+    const reaching_definitiont &v = bv_container->get(identifier, id);
 
     export_entry[v.definition_at].insert(
       std::make_pair(v.bit_begin, v.bit_end));
-  }
+  });
 }
 
 void rd_range_domaint::transform(
@@ -261,18 +260,16 @@ void rd_range_domaint::transform_end_function(
        (!ns.lookup(identifier).is_shared() &&
         !rd.get_is_dirty()(identifier)))
     {
-      for(const auto &id : new_value.second)
-      {
-        const reaching_definitiont &v=bv_container->get(id);
+      new_value.second.for_each([&](std::size_t id) {
+        const reaching_definitiont &v = bv_container->get(identifier, id);
         kill(v.identifier, v.bit_begin, v.bit_end);
-      }
+      });
     }
 
-    for(const auto &id : new_value.second)
-    {
-      const reaching_definitiont &v=bv_container->get(id);
+    new_value.second.for_each([&](std::size_t id) {
+      const reaching_definitiont &v = bv_container->get(identifier, id);
       gen(v.definition_at, v.identifier, v.bit_begin, v.bit_end);
-    }
+    });
   }
 
   const code_typet &code_type = to_code_type(ns.lookup(function_from).type);
@@ -362,85 +359,58 @@ void rd_range_domaint::kill(
   if(entry==values.end())
     return;
 
-  bool clear_export_cache=false;
+  // the definitions to remove and to add are collected first, such that
+  // the set is updated word by word
+  values_innert killed;
   values_innert new_values;
 
-  for(values_innert::iterator
-      it=entry->second.begin();
-      it!=entry->second.end();
-     ) // no ++it
-  {
-    const reaching_definitiont &v=bv_container->get(*it);
+  entry->second.for_each([&](std::size_t id) {
+    const reaching_definitiont &v = bv_container->get(identifier, id);
 
     if(v.bit_begin >= range_end)
-      ++it;
-    else if(v.bit_end!=-1 &&
-            v.bit_end <= range_start)
-      ++it;
-    else if(v.bit_begin >= range_start &&
-            v.bit_end!=-1 &&
-            v.bit_end <= range_end) // rs <= a < b <= re
+      return;
+    else if(v.bit_end != -1 && v.bit_end <= range_start)
+      return;
+    else if(
+      v.bit_begin >= range_start && v.bit_end != -1 &&
+      v.bit_end <= range_end) // rs <= a < b <= re
     {
-      clear_export_cache=true;
-
-      entry->second.erase(it++);
+      // removed entirely
     }
     else if(v.bit_begin >= range_start) // rs <= a <= re < b
     {
-      clear_export_cache=true;
-
-      reaching_definitiont v_new=v;
-      v_new.bit_begin=range_end;
+      reaching_definitiont v_new = v;
+      v_new.bit_begin = range_end;
       new_values.insert(bv_container->add(v_new));
-
-      entry->second.erase(it++);
     }
-    else if(v.bit_end==-1 ||
-            v.bit_end > range_end) // a <= rs < re < b
+    else if(v.bit_end == -1 || v.bit_end > range_end) // a <= rs < re < b
     {
-      clear_export_cache=true;
-
-      reaching_definitiont v_new=v;
-      v_new.bit_end=range_start;
+      reaching_definitiont v_new = v;
+      v_new.bit_end = range_start;
 
-      reaching_definitiont v_new2=v;
-      v_new2.bit_begin=range_end;
+      reaching_definitiont v_new2 = v;
+      v_new2.bit_begin = range_end;
 
       new_values.insert(bv_container->add(v_new));
       new_values.insert(bv_container->add(v_new2));
-
-      entry->second.erase(it++);
     }
     else // a <= rs < b <= re
     {
-      clear_export_cache=true;
-
-      reaching_definitiont v_new=v;
-      v_new.bit_end=range_start;
+      reaching_definitiont v_new = v;
+      v_new.bit_end = range_start;
       new_values.insert(bv_container->add(v_new));
-
-      entry->second.erase(it++);
     }
-  }
 
-  if(clear_export_cache)
-    export_cache.erase(identifier);
+    killed.insert(id);
+  });
 
-  values_innert::iterator it=entry->second.begin();
-  for(const auto &id : new_values)
-  {
-    while(it!=entry->second.end() && *it<id)
-      ++it;
-    if(it==entry->second.end() || id<*it)
-    {
-      entry->second.insert(it, id);
-    }
-    else if(it!=entry->second.end())
-    {
-      assert(*it==id);
-      ++it;
-    }
-  }
+  if(killed.empty())
+    return;
+
+  export_cache.erase(identifier);
+
+  entry->second.subtract(killed);
+  entry->second.union_with(new_values);
 }
 
 void rd_range_domaint::kill_inf(
@@ -502,7 +472,7 @@ bool rd_range_domaint::gen(
   v.bit_begin=range_start;
   v.bit_end=range_end;
 
-  if(!values[identifier].insert(bv_container->add(v)).second)
+  if(!values[identifier].insert(bv_container->add(v)))
     return false;
 
   export_cache.erase(identifier);
@@ -592,57 +562,6 @@ void rd_range_domaint::output(std::ostream &out) const
   }
 }
 
-/// \return returns true iff there is something new
-bool rd_range_domaint::merge_inner(
-  values_innert &dest,
-  const values_innert &other)
-{
-  bool more=false;
-
-#if 0
-  ranges_at_loct::iterator itr=it->second.begin();
-  for(const auto &o : ito->second)
-  {
-    while(itr!=it->second.end() && itr->first<o.first)
-      ++itr;
-    if(itr==it->second.end() || o.first<itr->first)
-    {
-      it->second.insert(o);
-      more=true;
-    }
-    else if(itr!=it->second.end())
-    {
-      assert(itr->first==o.first);
-
-      for(const auto &o_range : o.second)
-        more=gen(itr->second, o_range.first, o_range.second) ||
-          more;
-
-      ++itr;
-    }
-  }
-#else
-  values_innert::iterator itr=dest.begin();
-  for(const auto &id : other)
-  {
-    while(itr!=dest.end() && *itr<id)
-      ++itr;
-    if(itr==dest.end() || id<*itr)
-    {
-      dest.insert(itr, id);
-      more=true;
-    }
-    else if(itr!=dest.end())
-    {
-      assert(*itr==id);
-      ++itr;
-    }
-  }
-#endif
-
-  return more;
-}
-
 /// \return returns true iff there is something new
 bool rd_range_domaint::merge(
   const rd_range_domaint &other,
@@ -666,7 +585,7 @@ bool rd_range_domaint::merge(
     {
       assert(it->first==value.first);
 
-      if(merge_inner(it->second, value.second))
+      if(it->second.union_with(value.second))
       {
         changed=true;
         export_cache.erase(it->first);
@@ -716,7 +635,7 @@ bool rd_range_domaint::merge_shared(
     {
       assert(it->first==value.first);
 
-      if(merge_inner(it->second, value.second))
+      if(it->second.union_with(value.second))
       {
         changed=true;
         export_cache.erase(it->first);
@@ -26,6 +26,7 @@ Date: February 2013
 #define CPROVER_ANALYSES_REACHING_DEFINITIONS_H
 
 #include <util/base_exceptions.h>
+#include <util/dense_bitvector.h>
 #include <util/threeval.h>
 
 #include "ai.h"
@@ -36,28 +37,32 @@ class is_threadedt;
 class dirtyt;
 class reaching_definitions_analysist;
 
-/// An instance of this class provides an assignment of unique numeric `ID` to
-/// each inserted `reaching_definitiont` instance.
+/// An instance of this class provides an assignment of numeric `ID`s to
+/// each inserted `reaching_definitiont` instance. The `ID`s are unique among
+/// the instances with the same identifier and numbered from 0, such that sets
+/// of the definitions of one variable can be stored as dense bit vectors.
 /// Requirement: V has a member "identifier" of type irep_idt
 template<typename V>
 class sparse_bitvector_analysist
 {
 public:
-  const V &get(const std::size_t value_index) const
+  const V &get(const irep_idt &identifier, const std::size_t value_index) const
   {
-    assert(value_index<values.size());
-    return values[value_index]->first;
+    const auto entry = value_map.find(identifier);
+    assert(entry != value_map.end());
+    assert(value_index < entry->second.values.size());
+    return entry->second.values[value_index]->first;
   }
 
   std::size_t add(const V &value)
   {
-    inner_mapt &m=value_map[value.identifier];
+    valuest &v = value_map[value.identifier];
 
-    std::pair<typename inner_mapt::iterator, bool> entry=
-      m.insert(std::make_pair(value, values.size()));
+    std::pair<typename inner_mapt::iterator, bool> entry =
+      v.inner_map.insert(std::make_pair(value, v.values.size()));
 
     if(entry.second)
-      values.push_back(entry.first);
+      v.values.push_back(entry.first);
 
     return entry.first->second;
   }
@@ -65,20 +70,26 @@ public:
   void clear()
   {
     value_map.clear();
-    values.clear();
   }
 
 protected:
   typedef typename std::map<V, std::size_t> inner_mapt;
-  /// It is a map from an `ID` to the corresponding `reaching_definitiont`
-  /// instance inside the map `value_map`. Namely, the map is implemented as an
-  /// `std::vector` of iterators to elements of the map `value_map`. An index to
-  /// this vector is the `ID` of the related `reaching_definitiont` instance.
-  std::vector<typename inner_mapt::const_iterator> values;
-  /// A map from names of program variables to a set of pairs
-  /// (`reaching_definitiont`, `ID`). Formally, the map is defined as
-  /// `value_map: var_names -> (reaching_definitiont -> ID)`.
-  std::unordered_map<irep_idt, inner_mapt> value_map;
+
+  struct valuest
+  {
+    /// A map from `reaching_definitiont` instances to their `ID`s.
+    inner_mapt inner_map;
+    /// It is a map from an `ID` to the corresponding `reaching_definitiont`
+    /// instance inside `inner_map`. Namely, the map is implemented as an
+    /// `std::vector` of iterators to elements of `inner_map`. An index to this
+    /// vector is the `ID` of the related `reaching_definitiont` instance.
+    std::vector<typename inner_mapt::const_iterator> values;
+  };
+
+  /// A map from names of program variables to their definitions. Formally,
+  /// the map is defined as `value_map: var_names -> (reaching_definitiont <->
+  /// ID)`.
+  std::unordered_map<irep_idt, valuest> value_map;
 };
 
 /// Identifies a GOTO instruction where a given variable is defined (i.e. it is
@@ -260,7 +271,10 @@ private:
   /// `this` is passed to `set_bitvector_container` for all instances.
   sparse_bitvector_analysist<reaching_definitiont> *bv_container;
 
-  typedef std::set<std::size_t> values_innert;
+  /// The `ID`s of the definitions of a variable, see
+  /// `sparse_bitvector_analysist`, such that joins and kills operate on
+  /// whole words of the set at once
+  typedef dense_bitvectort values_innert;
   #ifdef USE_DSTRING
   typedef std::map<irep_idt, values_innert> valuest;
   #else
@@ -333,10 +347,6 @@ private:
     const range_spect &range_end);
 
   void output(std::ostream &out) const;
-
-  bool merge_inner(
-    values_innert &dest,
-    const values_innert &other);
 };
 
 class reaching_definitions_analysist:
@@ -13,6 +13,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/config.h>
 #include <util/string_constant.h>
 
+#include <goto-programs/global_reachability.h>
 #include <goto-programs/goto_functions.h>
 
 #include <linking/static_lifetime_init.h>
@@ -169,7 +170,19 @@ bool ansi_c_entry_point(
     return false; // give up
   }
 
-  static_lifetime_init(symbol_table, symbol.location);
+  if(object_factory_parameters.slice_global_inits)
+  {
+    // Decide before generating the initialization code, which is large for
+    // programs with many global variables.
+    const global_reachabilityt reachability(
+      symbol_table, {main_symbol, INITIALIZE_FUNCTION});
+    static_lifetime_init(
+      symbol_table, symbol.location, [&reachability](const irep_idt &id) {
+        return reachability.is_reachable(id);
+      });
+  }
+  else
+    static_lifetime_init(symbol_table, symbol.location);
 
   return generate_ansi_c_start_function(
     symbol, symbol_table, message_handler, object_factory_parameters);
@@ -64,6 +64,16 @@ bool ansi_c_languaget::parse(
 
   std::istringstream i_preprocessed(o_preprocessed.str());
 
+  return parse_preprocessed(i_preprocessed, path);
+}
+
+bool ansi_c_languaget::parse_preprocessed(
+  std::istream &i_preprocessed,
+  const std::string &path)
+{
+  // store the path
+  parse_path=path;
+
   // parsing
 
   std::string code;
@@ -48,6 +48,10 @@ public:
     std::istream &instream,
     const std::string &path) override;
 
+  /// Parse \p instream, which holds the already preprocessed text of the file
+  /// at \p path
+  bool parse_preprocessed(std::istream &instream, const std::string &path);
+
   bool generate_support_functions(
     symbol_tablet &symbol_table) override;
 
@@ -10,6 +10,7 @@ Author: Daniel Poetzl
 #define CPROVER_ANSI_C_C_OBJECT_FACTORY_PARAMETERS_H
 
 #include <util/object_factory_parameters.h>
+#include <util/options.h>
 
 struct c_object_factory_parameterst final : public object_factory_parameterst
 {
@@ -18,9 +19,19 @@ struct c_object_factory_parameterst final : public object_factory_parameterst
   }
 
   explicit c_object_factory_parameterst(const optionst &options)
-    : object_factory_parameterst(options)
+    : object_factory_parameterst(options),
+      slice_global_inits(options.get_bool_option("slice-global-inits"))
   {
   }
+
+  void set(const optionst &options)
+  {
+    object_factory_parameterst::set(options);
+    slice_global_inits = options.get_bool_option("slice-global-inits");
+  }
+
+  /// Only initialize the global variables reachable from the entry point
+  bool slice_global_inits = false;
 };
 
 /// Parse the c object factory parameters from a given command line
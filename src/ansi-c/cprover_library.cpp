@@ -8,9 +8,21 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "cprover_library.h"
 
+#include <cstdio>
+#include <fstream>
+#include <random>
 #include <sstream>
 
 #include <util/config.h>
+#include <util/file_util.h>
+#include <util/string_hash.h>
+#include <util/version.h>
+
+#include <goto-programs/goto_functions.h>
+#include <goto-programs/read_bin_goto_object.h>
+#include <goto-programs/write_goto_binary.h>
+
+#include <linking/linking.h>
 
 #include "ansi_c_language.h"
 
@@ -89,6 +101,77 @@ void cprover_c_library_factory(
   add_library(library_text, symbol_table, message_handler);
 }
 
+/// Like \ref add_library, but keeps the symbols that type checking \p src
+/// yields in the directory `config.ansi_c.library_cache`, such that later runs
+/// that need the same library functions in the same configuration only read
+/// and link them
+static void add_cached_library(
+  const std::string &src,
+  symbol_tablet &symbol_table,
+  message_handlert &message_handler)
+{
+  std::ostringstream key;
+  key << CBMC_VERSION << '\n'
+      << GOTO_BINARY_VERSION << '\n'
+      << config.ansi_c.fingerprint() << src;
+
+  // Two hashes of different construction make accidental collisions of keys
+  // unlikely enough
+  const std::string key_string = key.str();
+  std::ostringstream file_name;
+  file_name << "library-" << std::hex << hash_string(key_string) << '-'
+            << std::hash<std::string>{}(key_string) << ".gb";
+  const std::string cache_file =
+    concat_dir_file(config.ansi_c.library_cache, file_name.str());
+
+  symbol_tablet library_symbol_table;
+  bool hit;
+
+  {
+    std::ifstream in(cache_file, std::ios::binary);
+    goto_functionst goto_functions;
+    null_message_handlert null_message_handler;
+    hit = in && !read_bin_goto_object(
+                  in,
+                  cache_file,
+                  library_symbol_table,
+                  goto_functions,
+                  null_message_handler);
+  }
+
+  if(!hit)
+  {
+    library_symbol_table.clear();
+
+    std::istringstream in(src);
+
+    ansi_c_languaget ansi_c_language;
+    ansi_c_language.set_message_handler(message_handler);
+    ansi_c_language.parse(in, "");
+
+    if(ansi_c_language.typecheck(library_symbol_table, "<built-in-library>"))
+      return;
+
+    // Write to a file of a unique name first, such that concurrent runs never
+    // read a partially written entry
+    create_directory(config.ansi_c.library_cache);
+    const std::string temporary =
+      cache_file + "." + std::to_string(std::random_device{}()) + ".tmp";
+    bool written;
+    {
+      std::ofstream out(temporary, std::ios::binary);
+      written = out &&
+                !write_goto_binary(
+                  out, library_symbol_table, goto_functionst()) &&
+                out.flush();
+    }
+    if(!written || std::rename(temporary.c_str(), cache_file.c_str()) != 0)
+      std::remove(temporary.c_str());
+  }
+
+  linking(symbol_table, library_symbol_table, message_handler);
+}
+
 void add_library(
   const std::string &src,
   symbol_tablet &symbol_table,
@@ -97,6 +180,12 @@ void add_library(
   if(src.empty())
     return;
 
+  if(!config.ansi_c.library_cache.empty())
+  {
+    add_cached_library(src, symbol_table, message_handler);
+    return;
+  }
+
   std::istringstream in(src);
 
   ansi_c_languaget ansi_c_language;
@@ -277,9 +277,17 @@ digit_div (onedig_t *r, const onedig_t *y, unsigned yl, onedig_t *q, unsigned ql
 inline void
 BigInt::allocate (unsigned digits)
 {
-  size = adjust_size (digits);
   length = 0;
-  digit = new onedig_t[size];
+  if (digits <= inline_size)
+    {
+      size = inline_size;
+      digit = inline_digit;
+    }
+  else
+    {
+      size = adjust_size (digits);
+      digit = new onedig_t[size];
+    }
 }
 
 
@@ -291,7 +299,7 @@ BigInt::reallocate (unsigned digits)
 {
   if (digits > size)
     {
-      if (size)
+      if (is_allocated())
 	delete[] digit;
       size = adjust_size (digits);
       digit = new onedig_t[size];
@@ -307,13 +315,16 @@ BigInt::resize (unsigned digits)
   if (digits > size)
     {
       onedig_t *old_digit = digit;
+      bool old_allocated = is_allocated();
       unsigned old_size = size;
       size = adjust_size (digits);
       digit = new onedig_t[size];
       if (old_digit)
 	{
-	  memcpy (digit, old_digit, length * sizeof (onedig_t));
-	  if (old_size)
+	  // Callers may have set the length already, beyond the old size.
+	  unsigned used = old_size != 0 && old_size < length ? old_size : length;
+	  memcpy (digit, old_digit, used * sizeof (onedig_t));
+	  if (old_allocated)
 	    delete[] old_digit;
 	}
     }
@@ -386,7 +397,7 @@ BigInt::assign (llong_t l)
 
 BigInt::~BigInt()
 {
-  if (size > 0)
+  if (is_allocated())
     {
       memset (digit, 0, size * sizeof digit[0]); // Crypto-paranoia.
       delete[] digit;
@@ -401,66 +412,74 @@ BigInt::BigInt (onedig_t *dig, unsigned len, bool pos)
 {}
 
 BigInt::BigInt()
-  : size (adjust_size (small)),
+  : size (inline_size),
     length (0),
-    digit (new onedig_t[size]),
+    digit (inline_digit),
     positive (true)
 {}
 
 BigInt::BigInt (signed long int n)
-  : size (adjust_size (small)),
+  : size (inline_size),
     length (0),
-    digit (new onedig_t[size])
+    digit (inline_digit)
 {
   assign (llong_t (n));
 }
 
 BigInt::BigInt (unsigned long int n)
-  : size (adjust_size (small)),
+  : size (inline_size),
     length (0),
-    digit (new onedig_t[size])
+    digit (inline_digit)
 {
   assign (ullong_t (n));
 }
 
 BigInt::BigInt (int n)
-  : size (adjust_size (small)),
+  : size (inline_size),
     length (0),
-    digit (new onedig_t[size])
+    digit (inline_digit)
 {
   assign (llong_t (n));
 }
 
 BigInt::BigInt (unsigned u)
-  : size (adjust_size (small)),
+  : size (inline_size),
     length (0),
-    digit (new onedig_t[size])
+    digit (inline_digit)
 {
   assign (ullong_t (u));
 }
 
 BigInt::BigInt (llong_t l)
-  : size (adjust_size (small)),
+  : size (inline_size),
     length (0),
-    digit (new onedig_t[size])
+    digit (inline_digit)
 {
   assign (l);
 }
 
 BigInt::BigInt (ullong_t ul)
-  : size (adjust_size (small)),
+  : size (inline_size),
     length (0),
-    digit (new onedig_t[size])
+    digit (inline_digit)
 {
   assign (ul);
 }
 
 BigInt::BigInt (BigInt const &y)
-  : size (adjust_size (y.length)),
-    length (y.length),
-    digit (new onedig_t[size]),
+  : length (y.length),
     positive (y.positive)
 {
+  if (length <= inline_size)
+    {
+      size = inline_size;
+      digit = inline_digit;
+    }
+  else
+    {
+      size = adjust_size (length);
+      digit = new onedig_t[size];
+    }
   memcpy (digit, y.digit, length * sizeof (onedig_t));
 }
 
@@ -471,9 +490,9 @@ BigInt::BigInt (BigInt &&y)
 }
 
 BigInt::BigInt (char const *s, onedig_t b)
-  : size (adjust_size (small)),
+  : size (inline_size),
     length (0),
-    digit (new onedig_t[size]),
+    digit (inline_digit),
     positive (true)
 {
   scan (s, b);
@@ -482,8 +501,14 @@ BigInt::BigInt (char const *s, onedig_t b)
 BigInt &
 BigInt::operator= (BigInt const &y)
 {
-  BigInt copy(y);
-  swap(copy);
+  if (this == &y)
+    return *this;
+
+  // Reuse the digits of this where they suffice.
+  reallocate (y.length);
+  length = y.length;
+  positive = y.positive;
+  memcpy (digit, y.digit, length * sizeof (onedig_t));
   return *this;
 }
 
@@ -494,6 +519,34 @@ BigInt::operator= (BigInt &&y)
   return *this;
 }
 
+// Digits stored within an object stay there, hence these are swapped by
+// value and only allocated digit vectors change hands.
+
+void
+BigInt::swap (BigInt &other)
+{
+  bool this_inline = digit == inline_digit;
+  bool other_inline = other.digit == other.inline_digit;
+
+  onedig_t tmp[inline_size];
+  if (this_inline)
+    memcpy (tmp, inline_digit, length * sizeof (onedig_t));
+  if (other_inline)
+    memcpy (inline_digit, other.inline_digit, other.length * sizeof (onedig_t));
+  if (this_inline)
+    memcpy (other.inline_digit, tmp, length * sizeof (onedig_t));
+
+  std::swap (other.size, size);
+  std::swap (other.length, length);
+  std::swap (other.digit, digit);
+  std::swap (other.positive, positive);
+
+  if (other_inline)
+    digit = inline_digit;
+  if (this_inline)
+    other.digit = other.inline_digit;
+}
+
 
 char const *
 BigInt::scan_on (char const *s, onedig_t b)
@@ -872,10 +925,21 @@ BigInt::mul (onedig_t const *dig, unsigned len, bool pos)
     }
   else
     {
-      // Get a new string of digits for the result.
-      unsigned old_size = size;
-      size = adjust_size (length + len);
-      onedig_t *r = new onedig_t[size];
+      // Get a new string of digits for the result, on the stack if the
+      // result fits into this without allocating.
+      bool old_allocated = is_allocated();
+      onedig_t small_r[inline_size];
+      onedig_t *r;
+      if (length + len <= inline_size)
+	{
+	  size = inline_size;
+	  r = small_r;
+	}
+      else
+	{
+	  size = adjust_size (length + len);
+	  r = new onedig_t[size];
+	}
 
       // The first parameter pair defines the outer loop which should
       // be the shorter.
@@ -885,10 +949,16 @@ BigInt::mul (onedig_t const *dig, unsigned len, bool pos)
 	digit_mul (dig, len, digit, length, r);
 
       // Replace digit string of this with result.
-      if (old_size)
+      if (old_allocated)
 	delete[] digit;
-      digit = r;
       length += len;
+      if (r == small_r)
+	{
+	  memcpy (inline_digit, small_r, length * sizeof (onedig_t));
+	  digit = inline_digit;
+	}
+      else
+	digit = r;
       adjust();
     }
 
@@ -128,11 +128,21 @@ public:
   // by an elementary type.
   enum { small = sizeof (ullong_t) / sizeof (onedig_t) };
 
+  // Number of digits that are stored within the object rather than
+  // allocated, such that values of up to 128 bits never allocate.
+  enum { inline_size = 2 * small };
+
 private:
   unsigned size;			// Length of digit vector.
   unsigned length;			// Used places in digit vector.
   onedig_t *digit;			// Least significant first.
   bool positive;			// Signed magnitude representation.
+  onedig_t inline_digit[inline_size];	// Digit vector of small values.
+
+  bool is_allocated() const
+  {
+    return size != 0 && digit != inline_digit;
+  }
 
   // Create or resize this.
   inline void allocate (unsigned digits);
@@ -281,13 +291,7 @@ public:
   // Not part of original BigInt.
   void setPower2 (unsigned exponent) _fast;
 
-  void swap (BigInt &other)
-  {
-    std::swap(other.size, size);
-    std::swap(other.length, length);
-    std::swap(other.digit, digit);
-    std::swap(other.positive, positive);
-  }
+  void swap (BigInt &other) _fast;
 };
 
 
@@ -11,21 +11,31 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "cbmc_parse_options.h"
 
+#include <algorithm>
 #include <fstream>
 #include <cstdlib> // exit()
 #include <iostream>
 #include <memory>
+#include <sstream>
+#include <thread>
 
 #include <util/config.h>
 #include <util/exception_utils.h>
 #include <util/exit_codes.h>
+#include <util/forked_workers.h>
 #include <util/invariant.h>
+#include <util/json.h>
 #include <util/make_unique.h>
+#include <util/memory_info.h>
+#include <util/string_hash.h>
+#include <util/string2int.h>
 #include <util/unicode.h>
 #include <util/version.h>
 
 #include <langapi/language.h>
 
+#include <analyses/constant_propagator.h>
+
 #include <ansi-c/c_preprocess.h>
 #include <ansi-c/cprover_library.h>
 #include <ansi-c/gcc_version.h>
@@ -39,21 +49,28 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-checker/all_properties_verifier_with_trace_storage.h>
 #include <goto-checker/bmc_util.h>
 #include <goto-checker/cover_goals_verifier_with_trace_storage.h>
+#include <goto-checker/k_induction_verifier.h>
 #include <goto-checker/multi_path_symex_checker.h>
 #include <goto-checker/multi_path_symex_only_checker.h>
+#include <goto-checker/multi_path_symex_parallel_checker.h>
+#include <goto-checker/multi_path_symex_parallel_cover_checker.h>
 #include <goto-checker/properties.h>
 #include <goto-checker/single_path_symex_checker.h>
 #include <goto-checker/single_path_symex_only_checker.h>
+#include <goto-checker/single_path_symex_parallel_checker.h>
 #include <goto-checker/stop_on_fail_verifier.h>
 #include <goto-checker/stop_on_fail_verifier_with_fault_localization.h>
 
 #include <goto-programs/adjust_float_expressions.h>
+#include <goto-programs/binary_goto_trace.h>
+#include <goto-programs/goto_convert_functions.h>
 #include <goto-programs/initialize_goto_model.h>
 #include <goto-programs/instrument_preconditions.h>
 #include <goto-programs/link_to_library.h>
 #include <goto-programs/loop_ids.h>
 #include <goto-programs/mm_io.h>
 #include <goto-programs/read_goto_binary.h>
+#include <goto-programs/rebuild_goto_start_function.h>
 #include <goto-programs/remove_complex.h>
 #include <goto-programs/remove_function_pointers.h>
 #include <goto-programs/remove_returns.h>
@@ -65,12 +82,14 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-programs/show_goto_functions.h>
 #include <goto-programs/show_properties.h>
 #include <goto-programs/show_symbol_table.h>
+#include <goto-programs/slice_global_inits.h>
 #include <goto-programs/string_abstraction.h>
 #include <goto-programs/string_instrumentation.h>
 #include <goto-programs/validate_goto_model.h>
 
 #include <goto-instrument/cover.h>
 #include <goto-instrument/full_slicer.h>
+#include <goto-instrument/loop_bounds.h>
 #include <goto-instrument/nondet_static.h>
 #include <goto-instrument/reachability_slicer.h>
 
@@ -78,9 +97,14 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <pointer-analysis/add_failed_symbols.h>
 
+#include <json/json_parser.h>
+
 #include <langapi/mode.h>
 
 #include "c_test_input_generator.h"
+#include "property_cache.h"
+#include "result_reuse.h"
+#include "static_pre_discharge.h"
 
 cbmc_parse_optionst::cbmc_parse_optionst(int argc, const char **argv)
   : parse_options_baset(
@@ -183,9 +207,12 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
     exit(CPROVER_EXIT_USAGE_ERROR);
   }
 
-  if(cmdline.isset("full-slice"))
+  if(cmdline.isset("full-slice") || cmdline.isset("sparse-full-slice"))
     options.set_option("full-slice", true);
 
+  if(cmdline.isset("sparse-full-slice"))
+    options.set_option("sparse-full-slice", true);
+
   if(cmdline.isset("show-symex-strategies"))
   {
     log.status() << show_path_strategies() << messaget::eom;
@@ -201,11 +228,24 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
     options.set_option("show-vcc", true);
 
   if(cmdline.isset("cover"))
+  {
     parse_cover_options(cmdline, options);
 
+    options.set_option("cover-minimize", cmdline.isset("cover-minimize"));
+
+    if(cmdline.isset("cover-batch"))
+      options.set_option("cover-batch", cmdline.get_value("cover-batch"));
+  }
+
   if(cmdline.isset("mm"))
     options.set_option("mm", cmdline.get_value("mm"));
 
+  if(cmdline.isset("lazy-memory-model"))
+    options.set_option("lazy-memory-model", true);
+
+  if(cmdline.isset("context-bound"))
+    options.set_option("context-bound", cmdline.get_value("context-bound"));
+
   if(cmdline.isset("c89"))
     config.ansi_c.set_c89();
 
@@ -213,11 +253,51 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
     options.set_option(
       "symex-complexity-limit", cmdline.get_value("symex-complexity-limit"));
 
+  if(cmdline.isset("simplify-cache-size"))
+  {
+    options.set_option(
+      "simplify-cache-size", cmdline.get_value("simplify-cache-size"));
+  }
+
+  if(cmdline.isset("symex-cache-dereferences"))
+    options.set_option("symex-cache-dereferences", true);
+
+  if(cmdline.isset("allocation-site-bound"))
+  {
+    options.set_option(
+      "allocation-site-bound", cmdline.get_value("allocation-site-bound"));
+  }
+
+  if(cmdline.isset("symex-guard-bdd-nodes"))
+  {
+    options.set_option(
+      "symex-guard-bdd-nodes", cmdline.get_value("symex-guard-bdd-nodes"));
+  }
+
   if(cmdline.isset("symex-complexity-failed-child-loops-limit"))
     options.set_option(
       "symex-complexity-failed-child-loops-limit",
       cmdline.get_value("symex-complexity-failed-child-loops-limit"));
 
+  if(cmdline.isset("symex-complexity-cost-limit"))
+    options.set_option(
+      "symex-complexity-cost-limit",
+      cmdline.get_value("symex-complexity-cost-limit"));
+
+  if(cmdline.isset("memory-limit"))
+    options.set_option("memory-limit", cmdline.get_value("memory-limit"));
+
+  if(cmdline.isset("k-induction"))
+  {
+    const auto k = string2optional_unsigned(cmdline.get_value("k-induction"));
+    if(!k.has_value() || *k == 0)
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "expected k >= 1", "--k-induction");
+    }
+    options.set_option("k-induction", cmdline.get_value("k-induction"));
+  }
+
   if(cmdline.isset("c99"))
     config.ansi_c.set_c99();
 
@@ -239,6 +319,9 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("drop-unused-functions"))
     options.set_option("drop-unused-functions", true);
 
+  if(cmdline.isset("dead-code-elimination"))
+    options.set_option("dead-code-elimination", true);
+
   if(cmdline.isset("string-abstraction"))
     options.set_option("string-abstraction", true);
 
@@ -271,6 +354,47 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("localize-faults"))
     options.set_option("localize-faults", true);
 
+  if(cmdline.isset("localize-faults-method"))
+  {
+    options.set_option("localize-faults", true);
+    options.set_option(
+      "localize-faults-method", cmdline.get_value("localize-faults-method"));
+  }
+
+  if(cmdline.isset("parallel-properties"))
+  {
+    options.set_option(
+      "parallel-properties", cmdline.get_value("parallel-properties"));
+
+    // coverage goals are decided in parallel regardless of these options
+    if(
+      !cmdline.isset("cover") &&
+      (options.get_bool_option("trace") || cmdline.isset("stop-on-fail") ||
+       cmdline.isset("paths") || options.get_bool_option("localize-faults")))
+    {
+      log.warning() << "--parallel-properties is ignored in combination with "
+                    << "traces, --stop-on-fail, --paths or --localize-faults"
+                    << messaget::eom;
+    }
+  }
+
+  if(cmdline.isset("group-properties"))
+  {
+    options.set_option("group-properties", true);
+
+    if(
+      options.get_bool_option("trace") || cmdline.isset("cover") ||
+      cmdline.isset("paths") || options.get_bool_option("localize-faults"))
+    {
+      log.warning() << "--group-properties is ignored in combination with "
+                    << "traces, --cover, --paths or --localize-faults"
+                    << messaget::eom;
+    }
+  }
+
+  if(cmdline.isset("parallel-paths"))
+    options.set_option("parallel-paths", cmdline.get_value("parallel-paths"));
+
   if(cmdline.isset("unwind"))
     options.set_option("unwind", cmdline.get_value("unwind"));
 
@@ -327,6 +451,46 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("slice-formula"))
     options.set_option("slice-formula", true);
 
+  if(cmdline.isset("propagate-assignments"))
+    options.set_option("propagate-assignments", true);
+
+  if(cmdline.isset("omit-constant-assignments"))
+    options.set_option("omit-constant-assignments", true);
+
+  if(cmdline.isset("symex-slice"))
+    options.set_option("symex-slice", true);
+
+  if(cmdline.isset("stream-equation"))
+  {
+    for(const char *incompatible :
+        {"slice-formula", "propagate-assignments", "validate-ssa-equation",
+         "graphml-witness", "group-properties"})
+    {
+      if(cmdline.isset(incompatible))
+      {
+        log.error() << "--stream-equation and --" << incompatible
+                    << " must not be given together" << messaget::eom;
+        exit(CPROVER_EXIT_USAGE_ERROR);
+      }
+    }
+    options.set_option("stream-equation", true);
+  }
+
+  if(cmdline.isset("cube-depth"))
+    options.set_option("cube-depth", cmdline.get_value("cube-depth"));
+
+  if(cmdline.isset("sat-hot-spots"))
+    options.set_option("sat-hot-spots", cmdline.get_value("sat-hot-spots"));
+
+  if(cmdline.isset("paths-merge-regions"))
+  {
+    options.set_option(
+      "paths-merge-regions", cmdline.get_value("paths-merge-regions"));
+  }
+
+  if(cmdline.isset("unwind-max"))
+    options.set_option("unwind-max", cmdline.get_value("unwind-max"));
+
   // simplify if conditions and branches
   if(cmdline.isset("no-simplify-if"))
     options.set_option("simplify-if", false);
@@ -369,6 +533,14 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
       "max-node-refinement",
       cmdline.get_value("max-node-refinement"));
 
+  if(cmdline.isset("refine-schedule"))
+    options.set_option("refine-schedule", cmdline.get_value("refine-schedule"));
+
+  if(cmdline.isset("max-refinements-per-iteration"))
+    options.set_option(
+      "max-refinements-per-iteration",
+      cmdline.get_value("max-refinements-per-iteration"));
+
   // SMT Options
 
   if(cmdline.isset("smt1"))
@@ -421,6 +593,9 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
     options.set_option("smt2", true);
   }
 
+  if(cmdline.isset("smt2-incremental"))
+    options.set_option("smt2-incremental", true);
+
   if(cmdline.isset("smt2") && !solver_set)
   {
     if(cmdline.isset("outfile"))
@@ -438,9 +613,70 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
   if(cmdline.isset("beautify"))
     options.set_option("beautify", true);
 
+  if(cmdline.isset("beautify-incremental"))
+  {
+    options.set_option("beautify", true);
+    options.set_option("beautify-incremental", true);
+  }
+
+  if(cmdline.isset("beautify-core-guided"))
+  {
+    options.set_option("beautify", true);
+    options.set_option("beautify-core-guided", true);
+  }
+
+  if(cmdline.isset("beautify-time-limit"))
+  {
+    options.set_option("beautify", true);
+    options.set_option(
+      "beautify-time-limit", cmdline.get_value("beautify-time-limit"));
+  }
+
   if(cmdline.isset("no-sat-preprocessor"))
     options.set_option("sat-preprocessor", false);
 
+  if(cmdline.isset("sat-preset"))
+    options.set_option("sat-preset", cmdline.get_value("sat-preset"));
+
+  if(cmdline.isset("aig"))
+    options.set_option("aig", true);
+
+  // the refinement and SMT2 backends expect vectors as arrays
+  if(cmdline.isset("native-vectors"))
+  {
+    if(
+      options.get_bool_option("smt2") || options.get_bool_option("refine") ||
+      options.get_bool_option("refine-strings"))
+    {
+      log.warning() << "--native-vectors is ignored in combination with "
+                    << "SMT2 solvers and refinement" << messaget::eom;
+    }
+    else
+      options.set_option("native-vectors", true);
+  }
+
+  if(cmdline.isset("sat-portfolio"))
+    options.set_option("sat-portfolio", true);
+
+  if(cmdline.isset("sat-portfolio-time-slice"))
+  {
+    options.set_option(
+      "sat-portfolio-time-slice",
+      cmdline.get_value("sat-portfolio-time-slice"));
+  }
+
+  if(cmdline.isset("sat-solver-library"))
+  {
+    options.set_option(
+      "sat-solver-library", cmdline.get_value("sat-solver-library"));
+  }
+
+  if(cmdline.isset("multiplier-encoding"))
+  {
+    options.set_option(
+      "multiplier-encoding", cmdline.get_value("multiplier-encoding"));
+  }
+
   if(cmdline.isset("no-pretty-names"))
     options.set_option("pretty-names", false);
 
@@ -454,6 +690,13 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
     options.set_option("trace", true);
   }
 
+  if(cmdline.isset("binary-trace"))
+  {
+    options.set_option("binary-trace", cmdline.get_value("binary-trace"));
+    options.set_option("stop-on-fail", true);
+    options.set_option("trace", true);
+  }
+
   if(cmdline.isset("symex-coverage-report"))
   {
     options.set_option(
@@ -472,12 +715,34 @@ void cbmc_parse_optionst::get_command_line_options(optionst &options)
     options.set_option("validate-goto-model", true);
   }
 
+  if(cmdline.isset("validate-goto-model-incremental"))
+    options.set_option("validate-goto-model-incremental", true);
+
   if(cmdline.isset("show-goto-symex-steps"))
     options.set_option("show-goto-symex-steps", true);
 
   PARSE_OPTIONS_GOTO_TRACE(cmdline, options);
 }
 
+/// Digest of the options that verification results depend on, which are all
+/// but the directories the results are kept in
+static std::string options_fingerprint(const cmdlinet &cmdline)
+{
+  std::string options_key = std::string(CBMC_VERSION) + "\n";
+  for(const auto &option : cmdline.option_names())
+  {
+    if(option == "reuse-results" || option == "property-cache")
+      continue;
+    options_key += option;
+    for(const auto &value : cmdline.get_values(option))
+      options_key += " " + value;
+    options_key += "\n";
+  }
+
+  return std::to_string(hash_string(options_key)) + "-" +
+         std::to_string(std::hash<std::string>{}(options_key));
+}
+
 /// invoke main modules
 int cbmc_parse_optionst::doit()
 {
@@ -497,6 +762,13 @@ int cbmc_parse_optionst::doit()
   messaget::eval_verbosity(
     cmdline.get_value("verbosity"), messaget::M_STATISTICS, ui_message_handler);
 
+  // writes the profile, if requested, once we are done
+  const profile_outputt profile_output(cmdline, ui_message_handler);
+
+  // samples the progress of symbolic execution, if requested
+  const symex_telemetry_outputt symex_telemetry_output(
+    cmdline, ui_message_handler);
+
   //
   // Print a banner
   //
@@ -504,6 +776,20 @@ int cbmc_parse_optionst::doit()
                << "-bit " << config.this_architecture() << " "
                << config.this_operating_system() << messaget::eom;
 
+  if(options.is_set("memory-limit"))
+  {
+    // This limits the virtual address space, which forked workers and
+    // SMT solvers inherit. Allocations beyond it are reported as
+    // "Out of memory" rather than the process being killed.
+    const std::size_t limit_mib =
+      options.get_unsigned_int_option("memory-limit");
+    if(!set_memory_limit(limit_mib * 1024 * 1024))
+    {
+      log.warning() << "cannot enforce the memory limit on this platform"
+                    << messaget::eom;
+    }
+  }
+
   //
   // Unwinding of transition systems is done by hw-cbmc.
   //
@@ -588,6 +874,12 @@ int cbmc_parse_optionst::doit()
     return CPROVER_EXIT_SUCCESS;
   }
 
+  if(cmdline.isset("batch"))
+    return batch(options);
+
+  if(cmdline.isset("server"))
+    return server(options);
+
   int get_goto_program_ret =
     get_goto_program(goto_model, options, cmdline, ui_message_handler);
 
@@ -601,9 +893,49 @@ int cbmc_parse_optionst::doit()
     return CPROVER_EXIT_SUCCESS;
   }
 
+  if(cmdline.isset("show-binary-trace"))
+  {
+    const std::string filename = cmdline.get_value("show-binary-trace");
+    std::ifstream in(filename, std::ios::binary);
+    if(!in)
+    {
+      log.error() << "failed to open binary trace " << filename
+                  << messaget::eom;
+      return CPROVER_EXIT_INCORRECT_TASK;
+    }
+
+    goto_tracet goto_trace;
+    read_binary_goto_trace(in, goto_model.goto_functions, goto_trace);
+    output_error_trace(
+      goto_trace,
+      namespacet(goto_model.symbol_table),
+      trace_optionst(options),
+      ui_message_handler);
+    return CPROVER_EXIT_SUCCESS;
+  }
+
   if(set_properties())
     return CPROVER_EXIT_SET_PROPERTIES_FAILED;
 
+  if(cmdline.isset("infer-unwindset"))
+  {
+    const auto bounds = infer_loop_bounds(goto_model);
+
+    std::string unwindset;
+    for(const auto &bound : bounds)
+    {
+      unwindset +=
+        id2string(bound.first) + ":" + std::to_string(bound.second) + ",";
+    }
+
+    // bounds given with --unwindset take precedence
+    options.set_option(
+      "unwindset", unwindset + options.get_option("unwindset"));
+
+    log.status() << "Inferred unwinding bounds of " << bounds.size()
+                 << " loops" << messaget::eom;
+  }
+
   if(
     options.get_bool_option("program-only") ||
     options.get_bool_option("show-vcc"))
@@ -645,6 +977,22 @@ int cbmc_parse_optionst::doit()
 
   if(options.is_set("cover"))
   {
+    if(
+      options.get_unsigned_int_option("parallel-properties") > 1 &&
+      forked_workers_supported())
+    {
+      cover_goals_verifier_with_trace_storaget<
+        multi_path_symex_parallel_cover_checkert>
+        verifier(options, ui_message_handler, goto_model);
+      (void)verifier();
+      verifier.report();
+
+      c_test_input_generatort test_generator(ui_message_handler, options);
+      test_generator(verifier.get_traces());
+
+      return CPROVER_EXIT_SUCCESS;
+    }
+
     cover_goals_verifier_with_trace_storaget<multi_path_symex_checkert>
       verifier(options, ui_message_handler, goto_model);
     (void)verifier();
@@ -656,9 +1004,51 @@ int cbmc_parse_optionst::doit()
     return CPROVER_EXIT_SUCCESS;
   }
 
+  std::unique_ptr<result_reuset> result_reuse;
+  if(cmdline.isset("reuse-results"))
+  {
+    result_reuse = util_make_unique<result_reuset>(
+      cmdline.get_value("reuse-results"),
+      options_fingerprint(cmdline),
+      ui_message_handler);
+    (*result_reuse)(goto_model);
+  }
+
+  std::unique_ptr<property_cachet> property_cache;
+  if(cmdline.isset("property-cache"))
+  {
+    property_cache = util_make_unique<property_cachet>(
+      cmdline.get_value("property-cache"),
+      options_fingerprint(cmdline),
+      ui_message_handler);
+    (*property_cache)(goto_model);
+  }
+
+  if(cmdline.isset("static-pre-discharge"))
+    static_pre_discharge(goto_model, ui_message_handler);
+
   std::unique_ptr<goto_verifiert> verifier = nullptr;
 
+  // stop-on-fail and trace may be implied by other options, hence check the
+  // same conditions as the verifier selection below
   if(
+    options.get_unsigned_int_option("parallel-paths") > 1 &&
+    (!options.get_bool_option("paths") || options.is_set("k-induction") ||
+     options.get_bool_option("stop-on-fail") ||
+     options.get_bool_option("trace") || !forked_workers_supported()))
+  {
+    log.warning() << "--parallel-paths requires --paths and is ignored in "
+                  << "combination with traces, --stop-on-fail or "
+                  << "--k-induction, and on Windows" << messaget::eom;
+  }
+
+  if(options.is_set("k-induction"))
+  {
+    verifier =
+      util_make_unique<k_induction_verifiert<multi_path_symex_checkert>>(
+        options, ui_message_handler, goto_model);
+  }
+  else if(
     options.get_bool_option("stop-on-fail") && options.get_bool_option("paths"))
   {
     verifier =
@@ -686,9 +1076,19 @@ int cbmc_parse_optionst::doit()
     !options.get_bool_option("stop-on-fail") &&
     options.get_bool_option("paths"))
   {
-    verifier = util_make_unique<
-      all_properties_verifier_with_trace_storaget<single_path_symex_checkert>>(
-      options, ui_message_handler, goto_model);
+    if(
+      options.get_unsigned_int_option("parallel-paths") > 1 &&
+      !options.get_bool_option("trace") && forked_workers_supported())
+    {
+      verifier = util_make_unique<
+        all_properties_verifiert<single_path_symex_parallel_checkert>>(
+        options, ui_message_handler, goto_model);
+    }
+    else
+    {
+      verifier = util_make_unique<all_properties_verifier_with_trace_storaget<
+        single_path_symex_checkert>>(options, ui_message_handler, goto_model);
+    }
   }
   else if(
     !options.get_bool_option("stop-on-fail") &&
@@ -700,6 +1100,16 @@ int cbmc_parse_optionst::doit()
         util_make_unique<all_properties_verifier_with_fault_localizationt<
           multi_path_symex_checkert>>(options, ui_message_handler, goto_model);
     }
+    else if(
+      ((options.get_unsigned_int_option("parallel-properties") > 1 &&
+        forked_workers_supported()) ||
+       options.get_bool_option("group-properties")) &&
+      !options.get_bool_option("trace"))
+    {
+      verifier = util_make_unique<
+        all_properties_verifiert<multi_path_symex_parallel_checkert>>(
+        options, ui_message_handler, goto_model);
+    }
     else
     {
       verifier = util_make_unique<
@@ -715,6 +1125,11 @@ int cbmc_parse_optionst::doit()
   const resultt result = (*verifier)();
   verifier->report();
 
+  if(result_reuse)
+    result_reuse->store(verifier->get_properties());
+  if(property_cache)
+    property_cache->store(verifier->get_properties());
+
   return result_to_exit_code(result);
 }
 
@@ -726,6 +1141,26 @@ bool cbmc_parse_optionst::set_properties()
   if(cmdline.isset("property")) // use this one
     ::set_properties(goto_model, cmdline.get_values("property"));
 
+  if(cmdline.isset("property-shard"))
+  {
+    const std::string value = cmdline.get_value("property-shard");
+    const auto slash = value.find('/');
+    const auto shard = string2optional_size_t(value.substr(0, slash));
+    const auto shards = slash == std::string::npos
+                          ? optionalt<std::size_t>{}
+                          : string2optional_size_t(value.substr(slash + 1));
+
+    if(
+      !shard.has_value() || !shards.has_value() || *shard == 0 ||
+      *shard > *shards)
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "expected k/n with 1 <= k <= n", "--property-shard");
+    }
+
+    select_property_shard(goto_model, *shard - 1, *shards);
+  }
+
   return false;
 }
 
@@ -813,11 +1248,378 @@ void cbmc_parse_optionst::preprocessing(const optionst &options)
     log.error() << "PREPROCESSING ERROR" << messaget::eom;
 }
 
+bool cbmc_parse_optionst::parse_batch_job(
+  const std::vector<std::string> &arguments,
+  batch_jobt &job)
+{
+  std::vector<const char *> argv{"cbmc"};
+  for(const auto &argument : arguments)
+    argv.push_back(argument.c_str());
+
+  if(
+    job.cmdline.parse(argv.size(), argv.data(), CBMC_OPTIONS) ||
+    job.cmdline.args.size() != 1)
+  {
+    return true;
+  }
+
+  job.function = job.cmdline.args.front();
+  return false;
+}
+
+bool cbmc_parse_optionst::read_batch_jobs(
+  const std::string &file,
+  std::vector<batch_jobt> &jobs)
+{
+  std::ifstream in(file);
+  if(!in)
+  {
+    log.error() << "failed to open batch file " << file << messaget::eom;
+    return true;
+  }
+
+  std::string line;
+  for(std::size_t line_number = 1; std::getline(in, line); ++line_number)
+  {
+    std::istringstream words(line);
+    std::vector<std::string> arguments;
+    for(std::string word; words >> word;)
+      arguments.push_back(word);
+
+    // skip empty lines and comments
+    if(arguments.empty() || arguments.front()[0] == '#')
+      continue;
+
+    batch_jobt job;
+    if(parse_batch_job(arguments, job))
+    {
+      log.error() << file << ':' << line_number
+                  << ": expected a function followed by options"
+                  << messaget::eom;
+      return true;
+    }
+
+    jobs.push_back(std::move(job));
+  }
+
+  return false;
+}
+
+goto_modelt cbmc_parse_optionst::load_linked_model(
+  const std::vector<std::string> &files,
+  const optionst &options)
+{
+  goto_modelt linked_model =
+    initialize_goto_model(files, ui_message_handler, options);
+  remove_asm(linked_model);
+  link_to_library(
+    linked_model, ui_message_handler, cprover_cpp_library_factory);
+  link_to_library(linked_model, ui_message_handler, cprover_c_library_factory);
+  return linked_model;
+}
+
+jsont cbmc_parse_optionst::run_batch_job(
+  const batch_jobt &job,
+  const goto_modelt &linked_model)
+{
+  json_objectt json_result{{"function", json_stringt{job.function}}};
+
+  // the options of the job add to the ones given on the command line
+  const cmdlinet saved_cmdline = cmdline;
+  for(const auto &option : job.cmdline.option_names())
+  {
+    const auto &values = job.cmdline.get_values(option);
+    if(values.empty())
+      cmdline.set(option);
+    for(const auto &value : values)
+      cmdline.set(option, value);
+  }
+
+  try
+  {
+    optionst options;
+    get_command_line_options(options);
+    options.set_option("function", id2string(job.function));
+
+    goto_model.symbol_table = linked_model.symbol_table;
+    goto_model.goto_functions.copy_from(linked_model.goto_functions);
+
+    // replace the entry point by one calling the function of the job
+    bool entry_point_failed;
+    if(goto_model.symbol_table.has_symbol(goto_functionst::entry_point()))
+    {
+      entry_point_failed =
+        rebuild_goto_start_functiont(options, goto_model, ui_message_handler)();
+    }
+    else
+    {
+      const symbolt *function_symbol =
+        goto_model.symbol_table.lookup(job.function);
+      if(function_symbol == nullptr)
+      {
+        throw invalid_command_line_argument_exceptiont(
+          "function " + id2string(job.function) + " not found", "--batch");
+      }
+      auto language = get_language_from_mode(function_symbol->mode);
+      CHECK_RETURN(language != nullptr);
+      language->set_message_handler(ui_message_handler);
+      language->set_language_options(options);
+      entry_point_failed =
+        language->generate_support_functions(goto_model.symbol_table);
+    }
+
+    if(entry_point_failed)
+      throw invalid_source_file_exceptiont("SUPPORT FUNCTION GENERATION ERROR");
+
+    goto_convert(
+      goto_functionst::entry_point(),
+      goto_model.symbol_table,
+      goto_model.goto_functions,
+      ui_message_handler);
+
+    if(process_goto_program(goto_model, options, log) || set_properties())
+      throw invalid_source_file_exceptiont("failed to prepare the program");
+
+    std::unique_ptr<goto_verifiert> verifier;
+    if(options.get_bool_option("stop-on-fail"))
+    {
+      verifier =
+        util_make_unique<stop_on_fail_verifiert<multi_path_symex_checkert>>(
+          options, ui_message_handler, goto_model);
+    }
+    else
+    {
+      verifier =
+        util_make_unique<all_properties_verifiert<multi_path_symex_checkert>>(
+          options, ui_message_handler, goto_model);
+    }
+
+    const resultt result = (*verifier)();
+
+    json_result["result"] = json_stringt{as_string(result)};
+    json_result["exitCode"] = json_numbert{
+      std::to_string(result_to_exit_code(result))};
+    json_arrayt &json_properties = json_result["properties"].make_array();
+    for(const auto &property_pair : verifier->get_properties())
+      json_properties.push_back(json(property_pair.first, property_pair.second));
+  }
+  catch(const cprover_exception_baset &e)
+  {
+    json_result["result"] = json_stringt{"ERROR"};
+    json_result["exitCode"] =
+      json_numbert{std::to_string(CPROVER_EXIT_INTERNAL_ERROR)};
+    json_result["error"] = json_stringt{e.what()};
+  }
+
+  cmdline = saved_cmdline;
+  return std::move(json_result);
+}
+
+std::vector<jsont> cbmc_parse_optionst::run_batch_jobs(
+  const std::vector<batch_jobt> &jobs,
+  std::size_t first,
+  std::size_t count,
+  const goto_modelt &linked_model)
+{
+  std::vector<jsont> results;
+
+  if(!forked_workers_supported())
+  {
+    for(std::size_t i = 0; i < count; ++i)
+      results.push_back(run_batch_job(jobs[first + i], linked_model));
+    return results;
+  }
+
+  const auto outputs = run_forked_workers(count, [&](std::size_t i) {
+    std::ostringstream out;
+    out << run_batch_job(jobs[first + i], linked_model);
+    return out.str();
+  });
+
+  for(std::size_t i = 0; i < count; ++i)
+  {
+    jsont result;
+    std::istringstream in(outputs[i].value_or(""));
+    if(!outputs[i] || parse_json(in, "", ui_message_handler, result))
+    {
+      result = json_objectt{
+        {"function", json_stringt{jobs[first + i].function}},
+        {"result", json_stringt{"ERROR"}},
+        {"exitCode",
+         json_numbert{std::to_string(CPROVER_EXIT_INTERNAL_ERROR)}},
+        {"error", json_stringt{"the worker failed"}}};
+    }
+    results.push_back(std::move(result));
+  }
+
+  return results;
+}
+
+int cbmc_parse_optionst::batch(const optionst &options)
+{
+  std::vector<batch_jobt> jobs;
+  if(read_batch_jobs(cmdline.get_value("batch"), jobs))
+    return CPROVER_EXIT_INCORRECT_TASK;
+
+  if(cmdline.args.empty())
+  {
+    log.error() << "Please provide a program to verify" << messaget::eom;
+    return CPROVER_EXIT_INCORRECT_TASK;
+  }
+
+  // Parsing, type checking and linking the library do not depend on the
+  // entry point, hence are shared by all jobs.
+  const goto_modelt linked_model = load_linked_model(cmdline.args, options);
+
+  log.status() << "Running " << jobs.size() << " batch jobs" << messaget::eom;
+
+  // the jobs' messages would be interleaved
+  ui_message_handler.set_verbosity(messaget::M_ERROR);
+
+  std::size_t workers = std::max(1u, std::thread::hardware_concurrency());
+  if(cmdline.isset("batch-workers"))
+  {
+    workers = unsafe_string2size_t(cmdline.get_value("batch-workers"));
+    if(workers == 0)
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "expected n >= 1", "--batch-workers");
+    }
+  }
+
+  json_arrayt json_jobs;
+  int exit_code = CPROVER_EXIT_SUCCESS;
+
+  for(std::size_t first = 0; first < jobs.size(); first += workers)
+  {
+    const std::size_t count = std::min(workers, jobs.size() - first);
+    for(auto &result : run_batch_jobs(jobs, first, count, linked_model))
+    {
+      exit_code = std::max(
+        exit_code, std::stoi(to_json_object(result)["exitCode"].value));
+      json_jobs.push_back(std::move(result));
+    }
+  }
+
+  std::cout << json_objectt{{"jobs", std::move(json_jobs)}} << '\n';
+
+  return exit_code;
+}
+
+/// Response of `--server` to a request it cannot answer
+static jsont server_error(const std::string &message)
+{
+  return json_objectt{{"error", json_stringt{message}}};
+}
+
+int cbmc_parse_optionst::server(const optionst &options)
+{
+  // Linked models by their list of files. They stay resident until a request
+  // asks to reload them, for example because the files changed.
+  std::map<std::vector<std::string>, goto_modelt> linked_models;
+
+  // only the responses go to the standard output
+  ui_message_handler.set_verbosity(messaget::M_ERROR);
+
+  std::string line;
+  while(std::getline(std::cin, line))
+  {
+    if(line.find_first_not_of(" \t\r") == std::string::npos)
+      continue;
+
+    jsont request;
+    std::istringstream in(line);
+    jsont response;
+
+    if(parse_json(in, "", ui_message_handler, request) || !request.is_object())
+      response = server_error("expected a JSON object");
+    else if(to_json_object(request)["command"].value == "shutdown")
+      break;
+    else
+    {
+      json_objectt &request_object = to_json_object(request);
+
+      std::vector<std::string> files;
+      std::vector<std::string> arguments{request_object["function"].value};
+      if(request_object["program"].is_array())
+      {
+        for(const auto &file : to_json_array(request_object["program"]))
+          files.push_back(file.value);
+      }
+      if(request_object["options"].is_array())
+      {
+        for(const auto &option : to_json_array(request_object["options"]))
+          arguments.push_back(option.value);
+      }
+
+      std::vector<batch_jobt> jobs(1);
+      if(files.empty() || arguments.front().empty())
+        response = server_error("expected \"program\" and \"function\"");
+      else if(parse_batch_job(arguments, jobs.front()))
+        response = server_error("invalid options");
+      else
+      {
+        try
+        {
+          if(request_object["reload"].is_true())
+            linked_models.erase(files);
+
+          auto model_it = linked_models.find(files);
+          if(model_it == linked_models.end())
+          {
+            model_it =
+              linked_models.emplace(files, load_linked_model(files, options))
+                .first;
+          }
+
+          response = run_batch_jobs(jobs, 0, 1, model_it->second).front();
+        }
+        catch(const cprover_exception_baset &e)
+        {
+          response = server_error(e.what());
+        }
+      }
+    }
+
+    // allow clients to match responses to requests
+    if(request.is_object() && to_json_object(request).find("id") !=
+                                to_json_object(request).end())
+    {
+      to_json_object(response)["id"] = to_json_object(request)["id"];
+    }
+
+    // responses span several lines, hence are ended by an empty line
+    std::cout << response << "\n\n" << std::flush;
+  }
+
+  return CPROVER_EXIT_SUCCESS;
+}
+
 bool cbmc_parse_optionst::process_goto_program(
   goto_modelt &goto_model,
   const optionst &options,
   messaget &log)
 {
+  profile_scopet profile_scope("instrument", "goto-program");
+
+  optionalt<incremental_goto_model_validatort> validator;
+  if(options.get_bool_option("validate-goto-model-incremental"))
+  {
+    // intermediate programs need not satisfy the checks on the whole model
+    validator.emplace(
+      validation_modet::INVARIANT,
+      goto_model_validation_optionst{
+        goto_model_validation_optionst::set_optionst::all_false});
+  }
+  const auto validate = [&validator, &goto_model, &log](const char *what) {
+    if(validator)
+    {
+      const std::size_t validated = (*validator)(goto_model);
+      log.statistics() << "Validated " << validated << " functions changed by "
+                       << what << messaget::eom;
+    }
+  };
+
   // Remove inline assembler; this needs to happen before
   // adding the library.
   remove_asm(goto_model);
@@ -848,7 +1650,8 @@ bool cbmc_parse_optionst::process_goto_program(
 
   // remove returns, gcc vectors, complex
   remove_returns(goto_model);
-  remove_vector(goto_model);
+  if(!options.get_bool_option("native-vectors"))
+    remove_vector(goto_model);
   remove_complex(goto_model);
   rewrite_union(goto_model);
 
@@ -885,6 +1688,8 @@ bool cbmc_parse_optionst::process_goto_program(
   // add loop ids
   goto_model.goto_functions.compute_loop_numbers();
 
+  validate("instrumentation");
+
   if(options.get_bool_option("drop-unused-functions"))
   {
     // Entry point will have been set before and function pointers removed
@@ -892,10 +1697,29 @@ bool cbmc_parse_optionst::process_goto_program(
     remove_unused_functions(goto_model, log.get_message_handler());
   }
 
+  if(options.get_bool_option("slice-global-inits"))
+  {
+    // Programs given as source have been sliced when generating the
+    // initialization code already, this covers goto binaries.
+    log.status() << "Slicing away initializations of unused global variables"
+                 << messaget::eom;
+    slice_global_inits(goto_model);
+  }
+
+  if(options.get_bool_option("dead-code-elimination"))
+  {
+    log.status() << "Propagating constants and removing dead code"
+                 << messaget::eom;
+    propagate_constants_and_remove_dead_code(
+      goto_model, log.get_message_handler());
+  }
+
   // remove skips such that trivial GOTOs are deleted and not considered
   // for coverage annotation:
   remove_skip(goto_model);
 
+  validate("removing unused code");
+
   // instrument cover goals
   if(options.is_set("cover"))
   {
@@ -938,15 +1762,29 @@ bool cbmc_parse_optionst::process_goto_program(
   if(options.get_bool_option("full-slice"))
   {
     log.status() << "Performing a full slice" << messaget::eom;
+    const bool sparse = options.get_bool_option("sparse-full-slice");
     if(options.is_set("property"))
-      property_slicer(goto_model, options.get_list_option("property"));
+    {
+      property_slicer(
+        goto_model, options.get_list_option("property"), sparse);
+    }
     else
-      full_slicer(goto_model);
+      full_slicer(goto_model, sparse);
   }
 
   // remove any skips introduced since coverage instrumentation
   remove_skip(goto_model);
 
+  validate("coverage instrumentation and slicing");
+
+  if(validator)
+  {
+    validate_goto_model(
+      goto_model.goto_functions,
+      validation_modet::INVARIANT,
+      goto_model_validation_optionst{});
+  }
+
   return false;
 }
 
@@ -971,8 +1809,47 @@ void cbmc_parse_optionst::help()
     HELP_SHOW_PROPERTIES
     " --symex-coverage-report f    generate a Cobertura XML coverage report in f\n" // NOLINT(*)
     " --property id                only check one specific property\n"
+    " --property-shard k/n         only check every n-th property, starting\n"
+    "                              with the k-th one\n"
+    " --reuse-results dir          keep the model and results in dir and skip\n"
+    "                              properties that passed there and are not\n"
+    "                              affected by the changes since\n"
+    " --property-cache dir         skip properties that passed before with the\n"
+    "                              same cone of influence, and keep the ones\n"
+    "                              that pass in dir\n"
+    " --static-pre-discharge       prove properties by constant propagation\n"
+    "                              and interval analysis before symbolic\n"
+    "                              execution, and only check the others\n"
+    " --k-induction k              prove the properties by k-induction,\n"
+    "                              increasing k up to the given bound;\n"
+    "                              loop invariants strengthen the step case\n"
     " --stop-on-fail               stop analysis once a failed property is detected\n" // NOLINT(*)
     " --trace                      give a counterexample trace for failed properties\n" //NOLINT(*)
+    " --parallel-properties n      decide the properties, or with --cover the\n"
+    "                              goals, using n solver processes (other\n"
+    "                              than with --cover, not supported with\n"
+    "                              --trace, --stop-on-fail, --paths or\n"
+    "                              --localize-faults)\n"
+    " --group-properties           decide properties whose cones of influence\n"
+    "                              overlap in one solver instance, and\n"
+    "                              disjoint groups in separate, smaller ones,\n"
+    "                              in parallel with --parallel-properties\n"
+    "                              (not supported with --trace, --stop-on-fail\n"
+    "                              or --paths)\n"
+    " --parallel-paths n           with --paths, explore the saved paths\n"
+    "                              using n processes (not supported with\n"
+    "                              traces, --stop-on-fail or --k-induction,\n"
+    "                              and on Windows)\n"
+    " --batch file                 verify the jobs in file, one per line given\n"
+    "                              as a function followed by further options,\n"
+    "                              loading the program only once, and write\n"
+    "                              a combined JSON report\n"
+    " --batch-workers n            run up to n batch jobs at a time\n"
+    " --server                     answer verification requests given as\n"
+    "                              JSON objects on the standard input, keeping\n"
+    "                              the loaded programs in memory\n"
+    " --show-binary-trace file     show a trace written with --binary-trace\n"
+    "                              for the same program\n"
     "\n"
     "C/C++ frontend options:\n"
     " -I path                      set include path (C/C++)\n"
@@ -985,6 +1862,10 @@ void cbmc_parse_optionst::help()
     " --big-endian                 allow big-endian word-byte conversions\n"
     " --unsigned-char              make \"char\" unsigned by default\n"
     " --mm model                   set memory model (default: sc)\n"
+    " --lazy-memory-model          add ordering constraints of the memory model\n"
+    "                              only once a model violates them\n"
+    " --context-bound k            only consider interleavings that run the\n"
+    "                              threads round-robin in at most k rounds\n"
     " --arch                       set architecture (default: "
                                    << configt::this_architecture() << ")\n"
     " --os                         set operating system (default: "
@@ -1008,6 +1889,8 @@ void cbmc_parse_optionst::help()
     #endif
     " --no-arch                    don't set up an architecture\n"
     " --no-library                 disable built-in abstract C library\n"
+    " --library-cache dir          keep the type-checked library models in dir\n" // NOLINT(*)
+    "                              for reuse by later runs\n"
     " --round-to-nearest           rounding towards nearest even (default)\n"
     " --round-to-plus-inf          rounding towards plus infinity\n"
     " --round-to-minus-inf         rounding towards minus infinity\n"
@@ -1026,11 +1909,22 @@ void cbmc_parse_optionst::help()
     " --no-assumptions             ignore user assumptions\n"
     " --error-label label          check that label is unreachable\n"
     " --cover CC                   create test-suite with coverage criterion CC\n" // NOLINT(*)
+    " --cover-minimize             with --cover, drop tests whose goals are\n"
+    "                              covered by the other tests\n"
+    " --cover-batch n              with --cover, first try to cover n goals\n"
+    "                              at once in each solver call\n"
     " --mm MM                      memory consistency model for concurrent programs\n" // NOLINT(*)
     HELP_REACHABILITY_SLICER
     HELP_REACHABILITY_SLICER_FB
     " --full-slice                 run full slicer (experimental)\n" // NOLINT(*)
+    " --sparse-full-slice          run full slicer, computing dependencies\n"
+    "                              only for the instructions kept\n"
     " --drop-unused-functions      drop functions trivially unreachable from main function\n" // NOLINT(*)
+    " --slice-global-inits         only initialize global variables used by\n"
+    "                              functions reachable from the entry point\n"
+    " --dead-code-elimination      propagate constants across functions and\n"
+    "                              remove code and functions that are then\n"
+    "                              found to be unreachable\n"
     "\n"
     "Semantic transformations:\n"
     // NOLINTNEXTLINE(whitespace/line_length)
@@ -1038,12 +1932,39 @@ void cbmc_parse_optionst::help()
     "\n"
     "BMC options:\n"
     HELP_BMC
+    " --infer-unwindset            unwind loops with a constant number of\n"
+    "                              iterations exactly that often\n"
     "\n"
     "Backend options:\n"
     " --object-bits n              number of bits used for object addresses\n"
     " --dimacs                     generate CNF in DIMACS format\n"
+    " --sat-preset p               tune the SAT solver for satisfiable (sat)\n"
+    "                              or unsatisfiable (unsat) formulas, or\n"
+    "                              disable its inprocessing (plain); only\n"
+    "                              supported by CaDiCaL\n"
+    " --sat-portfolio              take turns between the available SAT\n"
+    "                              solvers, doubling their time limit in each\n"
+    "                              round, until one solves the formula\n"
+    " --sat-portfolio-time-slice s time limit in the first round (default: 1)\n"
+    " --sat-solver-library f       load an IPASIR SAT solver from shared\n"
+    "                              library f\n"
+    " --aig                        simplify the formula as and-inverter graph\n"
+    "                              before generating CNF\n"
+    " --native-vectors             keep gcc vector types and operations for\n"
+    "                              the SAT backend instead of turning them\n"
+    "                              into arrays\n"
+    " --multiplier-encoding e      sum up partial products of multiplications\n"
+    "                              one by one (shift-add, the default) or by\n"
+    "                              a wallace or dadda tree\n"
     " --beautify                   beautify the counterexample (greedy heuristic)\n" // NOLINT(*)
+    " --beautify-incremental       beautify using assumptions only, leaving\n"
+    "                              the formula unchanged\n"
+    " --beautify-core-guided       beautify by relaxing conflicts among all\n"
+    "                              objectives of equal weight first\n"
+    " --beautify-time-limit s      stop beautifying after s seconds\n"
     " --localize-faults            localize faults (experimental)\n"
+    " --localize-faults-method m   flip each location (linear, the default)\n"
+    "                              or follow conflict cores (core)\n"
     " --smt2                       use default SMT2 solver (Z3)\n"
     " --boolector                  use Boolector\n"
     " --cprover-smt2               use CPROVER SMT2 solver\n"
@@ -1051,7 +1972,11 @@ void cbmc_parse_optionst::help()
     " --mathsat                    use MathSAT\n"
     " --yices                      use Yices\n"
     " --z3                         use Z3\n"
+    " --smt2-incremental           keep one SMT2 solver process for all queries\n" // NOLINT(*)
     " --refine                     use refinement procedure (experimental)\n"
+    " --refine-schedule s          refine in-order (default) or cheapest-first\n" // NOLINT(*)
+    " --max-refinements-per-iteration n\n"
+    "                              refine at most n operations per iteration\n" // NOLINT(*)
     HELP_STRING_REFINEMENT_CBMC
     " --outfile filename           output formula to given file\n"
     " --arrays-uf-never            never turn arrays into uninterpreted functions\n" // NOLINT(*)
@@ -1062,10 +1987,16 @@ void cbmc_parse_optionst::help()
     HELP_XML_INTERFACE
     HELP_JSON_INTERFACE
     HELP_VALIDATE
+    " --validate-goto-model-incremental\n"
+    "                              check the goto program after each group of\n"
+    "                              transformations, only functions that the\n"
+    "                              transformations changed, in parallel\n"
     HELP_GOTO_TRACE
     HELP_FLUSH
     " --verbosity #                verbosity level\n"
     HELP_TIMESTAMP
+    HELP_PROFILE
+    HELP_SYMEX_TELEMETRY
     "\n";
   // clang-format on
 }
@@ -16,6 +16,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <ansi-c/c_object_factory_parameters.h>
 
 #include <util/parse_options.h>
+#include <util/profiler.h>
 #include <util/timestamper.h>
 #include <util/ui_message.h>
 #include <util/validation_interface.h>
@@ -29,6 +30,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <goto-programs/goto_trace.h>
 
+#include <goto-symex/symex_telemetry.h>
+
 #include <solvers/strings/string_refinement.h>
 
 #include <json/json_interface.h>
@@ -42,7 +45,7 @@ class optionst;
   OPT_BMC \
   "(preprocess)(slice-by-trace):" \
   OPT_FUNCTIONS \
-  "(no-simplify)(full-slice)" \
+  "(no-simplify)(full-slice)(sparse-full-slice)" \
   OPT_REACHABILITY_SLICER \
   "(debug-level):(no-propagation)(no-simplify-if)" \
   "(document-subgoals)(outfile):(test-preprocessor)" \
@@ -53,33 +56,48 @@ class optionst;
   OPT_XML_INTERFACE \
   OPT_JSON_INTERFACE \
   "(smt1)(smt2)(fpa)(cvc3)(cvc4)(boolector)(yices)(z3)(mathsat)" \
-  "(cprover-smt2)" \
-  "(no-sat-preprocessor)" \
-  "(beautify)" \
+  "(cprover-smt2)(smt2-incremental)" \
+  "(no-sat-preprocessor)(sat-preset):(aig)(multiplier-encoding):" \
+  "(sat-portfolio)(sat-portfolio-time-slice):(sat-solver-library):" \
+  "(beautify)(beautify-incremental)(beautify-core-guided)" \
+  "(beautify-time-limit):" \
   "(dimacs)(refine)(max-node-refinement):(refine-arrays)(refine-arithmetic)"\
+  "(native-vectors)" \
+  "(refine-schedule):(max-refinements-per-iteration):" \
   OPT_STRING_REFINEMENT_CBMC \
   "(16)(32)(64)(LP64)(ILP64)(LLP64)(ILP32)(LP32)" \
   "(little-endian)(big-endian)" \
   OPT_SHOW_GOTO_FUNCTIONS \
   OPT_SHOW_PROPERTIES \
   "(show-symbol-table)(show-parse-tree)" \
-  "(drop-unused-functions)" \
-  "(property):(stop-on-fail)(trace)" \
-  "(error-label):(verbosity):(no-library)" \
+  "(drop-unused-functions)(dead-code-elimination)(slice-global-inits)" \
+  "(property):(property-shard):(stop-on-fail)(trace)" \
+  "(reuse-results):(property-cache):(static-pre-discharge)" \
+  "(k-induction):" \
+  "(show-binary-trace):" \
+  "(error-label):(verbosity):(no-library)(library-cache):" \
   "(nondet-static)" \
+  "(infer-unwindset)" \
   "(version)" \
-  "(cover):(symex-coverage-report):" \
-  "(mm):" \
+  "(cover):(cover-minimize)(cover-batch):(symex-coverage-report):" \
+  "(mm):(lazy-memory-model)(context-bound):" \
   OPT_TIMESTAMP \
+  OPT_PROFILE \
+  OPT_SYMEX_TELEMETRY \
   "(i386-linux)(i386-macos)(i386-win32)(win32)(winx64)(gcc)" \
   "(ppc-macos)(unsigned-char)" \
   "(arrays-uf-always)(arrays-uf-never)" \
   "(string-abstraction)(no-arch)(arch):" \
   "(round-to-nearest)(round-to-plus-inf)(round-to-minus-inf)(round-to-zero)" \
   OPT_FLUSH \
-  "(localize-faults)" \
+  "(localize-faults)(localize-faults-method):" \
+  "(parallel-properties):" \
+  "(group-properties)" \
+  "(parallel-paths):" \
+  "(batch):(batch-workers):(server)" \
   OPT_GOTO_TRACE \
   OPT_VALIDATE \
+  "(validate-goto-model-incremental)" \
   OPT_ANSI_C_LANGUAGE \
   "(claim):(show-claims)(floatbv)(all-claims)(all-properties)" // legacy, and will eventually disappear // NOLINT(whitespace/line_length)
 // clang-format on
@@ -117,6 +135,45 @@ protected:
   void get_command_line_options(optionst &);
   void preprocessing(const optionst &);
   bool set_properties();
+
+  /// A job of `--batch`: an entry function and the command-line options
+  /// that apply in addition to the ones given to cbmc
+  struct batch_jobt
+  {
+    irep_idt function;
+    cmdlinet cmdline;
+  };
+
+  /// Load the program once and verify each job of the file given with
+  /// `--batch` on a copy, in forked workers where supported, writing a
+  /// combined JSON report to the standard output
+  int batch(const optionst &);
+  bool read_batch_jobs(const std::string &file, std::vector<batch_jobt> &);
+  /// Parse \p arguments, an entry function followed by options, into \p job
+  /// \return true on error
+  bool parse_batch_job(const std::vector<std::string> &arguments, batch_jobt &);
+  /// Parse and type check \p files and link the library, but do not
+  /// instrument the model yet, as this depends on the entry point
+  goto_modelt
+  load_linked_model(const std::vector<std::string> &files, const optionst &);
+  /// Verify \p job on a copy of \p linked_model
+  /// \return the result as JSON object
+  jsont run_batch_job(const batch_jobt &job, const goto_modelt &linked_model);
+  /// Run \p count of \p jobs, starting from \p first, at the same time in
+  /// forked workers where supported and one after the other otherwise
+  std::vector<jsont> run_batch_jobs(
+    const std::vector<batch_jobt> &jobs,
+    std::size_t first,
+    std::size_t count,
+    const goto_modelt &linked_model);
+
+  /// Answer requests given as JSON objects, one per line of the standard
+  /// input, with one JSON object each on the standard output, followed by an
+  /// empty line, keeping the linked models resident between requests. A request
+  /// `{"program": [files], "function": f, "options": [options]}` verifies
+  /// f as a job of \ref batch; `"reload": true` loads the files again, and
+  /// `{"command": "shutdown"}` ends the server.
+  int server(const optionst &);
 };
 
 #endif // CPROVER_CBMC_CBMC_PARSE_OPTIONS_H
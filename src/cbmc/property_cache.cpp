@@ -0,0 +1,311 @@
+/*******************************************************************\
+
+Module: Cache of Property Results Keyed by Cone of Influence
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// An on-disk cache of verification results of properties, keyed by a digest
+/// of the part of the program that can influence each property
+
+#include "property_cache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <unordered_set>
+
+#include <util/file_util.h>
+#include <util/irep_hash.h>
+#include <util/string_hash.h>
+
+#include <goto-programs/goto_model.h>
+
+#include <goto-instrument/reachability_slicer.h>
+
+static std::string to_hex(std::size_t value)
+{
+  std::ostringstream out;
+  out << std::hex << value;
+  return out.str();
+}
+
+/// Digests of ireps that only depend on their contents, not on the order in
+/// which strings were numbered or on the sharing of subtrees, such that they
+/// are the same in different runs. Comments are left out, as they are by
+/// irept::operator==.
+class cone_hashert
+{
+public:
+  typedef std::pair<std::size_t, std::size_t> digestt;
+
+  digestt operator()(const irept &irep)
+  {
+    const auto entry =
+      digests.emplace(static_cast<const void *>(&irep.read()), digestt());
+    if(!entry.second)
+      return entry.first->second;
+
+    const std::string &id = id2string(irep.id());
+    std::size_t h1 = hash_string(id);
+    std::size_t h2 = std::hash<std::string>{}(id);
+
+    if(
+      irep.id() == ID_symbol || irep.id() == ID_struct_tag ||
+      irep.id() == ID_union_tag || irep.id() == ID_c_enum_tag)
+    {
+      referenced.insert(irep.get(ID_identifier));
+    }
+
+    for(const auto &sub : irep.get_sub())
+    {
+      const digestt digest = (*this)(sub);
+      h1 = hash_combine(h1, digest.first);
+      h2 = (h2 ^ digest.second) * 1099511628211u;
+    }
+
+    // named subtrees are ordered by the numbers of their names, which differ
+    // between runs, hence combine them independently of their order
+    std::size_t named1 = 0, named2 = 0;
+    for(const auto &named_sub : irep.get_named_sub())
+    {
+      if(irept::is_comment(named_sub.first))
+        continue;
+      const std::string &name = id2string(named_sub.first);
+      const digestt digest = (*this)(named_sub.second);
+      named1 += hash_combine(hash_string(name), digest.first);
+      named2 += (std::hash<std::string>{}(name) ^ digest.second) *
+                1099511628211u;
+    }
+    h1 = hash_finalize(hash_combine(h1, named1), irep.get_sub().size());
+    h2 = (h2 ^ named2) * 1099511628211u;
+
+    // the recursive calls may have rehashed the table
+    return digests[static_cast<const void *>(&irep.read())] = {h1, h2};
+  }
+
+  /// Identifiers of the symbols and tags that the hashed ireps refer to
+  std::unordered_set<irep_idt> referenced;
+
+protected:
+  std::unordered_map<const void *, digestt> digests;
+};
+
+static std::ostream &
+operator<<(std::ostream &out, const cone_hashert::digestt &digest)
+{
+  return out << to_hex(digest.first) << '-' << to_hex(digest.second);
+}
+
+/// Compute a digest of the program that remains after slicing
+/// \p goto_functions with respect to \p property_id, and of the symbols that
+/// this program refers to
+static std::string cone_digest(
+  const goto_functionst &goto_functions,
+  const symbol_tablet &symbol_table,
+  const irep_idt &property_id,
+  const std::string &fingerprint)
+{
+  goto_modelt cone;
+  cone.goto_functions.copy_from(goto_functions);
+
+  // other assertions do not influence the property, and whether they are
+  // there or have been skipped must not change the digest
+  for(auto &function : cone.goto_functions.function_map)
+  {
+    for(auto &instruction : function.second.body.instructions)
+    {
+      if(
+        instruction.is_assert() &&
+        instruction.source_location.get_property_id() != property_id)
+      {
+        instruction.turn_into_skip();
+      }
+    }
+  }
+
+  reachability_slicer(cone, {id2string(property_id)});
+
+  cone_hashert hasher;
+
+  // only functions that can be called on the way to the property matter
+  std::map<std::string, std::string> functions;
+  std::unordered_set<irep_idt> visited{goto_functionst::entry_point()};
+  std::vector<irep_idt> queue{goto_functionst::entry_point()};
+  while(!queue.empty())
+  {
+    const irep_idt function_id = queue.back();
+    queue.pop_back();
+
+    std::ostringstream text;
+    auto function = cone.goto_functions.function_map.find(function_id);
+    if(function != cone.goto_functions.function_map.end())
+    {
+      goto_programt &body = function->second.body;
+      body.compute_target_numbers();
+
+      for(const auto &instruction : body.instructions)
+      {
+        text << static_cast<int>(instruction.type) << ' '
+             << hasher(instruction.code) << ' ' << hasher(instruction.guard)
+             << ' ' << instruction.target_number;
+        for(const auto &target : instruction.targets)
+          text << ' ' << target->target_number;
+        text << '\n';
+
+        if(instruction.is_function_call())
+        {
+          const exprt &callee =
+            to_code_function_call(instruction.code).function();
+          if(
+            callee.id() == ID_symbol &&
+            visited.insert(to_symbol_expr(callee).get_identifier()).second)
+          {
+            queue.push_back(to_symbol_expr(callee).get_identifier());
+          }
+        }
+      }
+    }
+
+    functions[id2string(function_id)] = text.str();
+  }
+
+  // the types and initial values of the symbols, and of the symbols that
+  // these refer to in turn
+  std::map<std::string, std::string> symbols;
+  std::unordered_set<irep_idt> done;
+  while(done.size() < hasher.referenced.size())
+  {
+    const std::vector<irep_idt> referenced(
+      hasher.referenced.begin(), hasher.referenced.end());
+    for(const auto &identifier : referenced)
+    {
+      if(!done.insert(identifier).second)
+        continue;
+
+      std::ostringstream text;
+      const symbolt *symbol = symbol_table.lookup(identifier);
+      if(symbol != nullptr)
+      {
+        text << hasher(symbol->type) << ' ' << symbol->is_static_lifetime
+             << symbol->is_thread_local << symbol->is_volatile
+             << symbol->is_type;
+        if(symbol->type.id() != ID_code)
+          text << ' ' << hasher(symbol->value);
+      }
+      symbols[id2string(identifier)] = text.str();
+    }
+  }
+
+  std::ostringstream key;
+  key << fingerprint << '\n';
+  for(const auto &function : functions)
+    key << function.first << '\n' << function.second;
+  for(const auto &symbol : symbols)
+    key << symbol.first << ' ' << symbol.second << '\n';
+
+  // Two hashes of different construction make accidental collisions unlikely
+  // enough
+  const std::string key_string = key.str();
+  return to_hex(hash_string(key_string)) + "-" +
+         to_hex(std::hash<std::string>{}(key_string));
+}
+
+property_cachet::property_cachet(
+  std::string _directory,
+  std::string _fingerprint,
+  message_handlert &message_handler)
+  : directory(std::move(_directory)),
+    fingerprint(std::move(_fingerprint)),
+    log(message_handler)
+{
+  create_directory(directory);
+}
+
+std::string property_cachet::file_name(const std::string &cone_digest) const
+{
+  return concat_dir_file(directory, cone_digest + ".pass");
+}
+
+void property_cachet::operator()(goto_modelt &goto_model)
+{
+  cone_digests.clear();
+  hits = 0;
+
+  // compute all digests before any assertion is skipped
+  for(const auto &function : goto_model.goto_functions.function_map)
+  {
+    for(const auto &instruction : function.second.body.instructions)
+    {
+      if(!instruction.is_assert())
+        continue;
+
+      const irep_idt &property_id =
+        instruction.source_location.get_property_id();
+      cone_digests[property_id] = cone_digest(
+        goto_model.goto_functions,
+        goto_model.symbol_table,
+        property_id,
+        fingerprint);
+    }
+  }
+
+  for(auto &function : goto_model.goto_functions.function_map)
+  {
+    for(auto &instruction : function.second.body.instructions)
+    {
+      if(!instruction.is_assert())
+        continue;
+
+      const irep_idt &property_id =
+        instruction.source_location.get_property_id();
+      if(std::ifstream(file_name(cone_digests.at(property_id))))
+      {
+        cone_digests.erase(property_id);
+        instruction.turn_into_skip();
+        ++hits;
+      }
+    }
+  }
+
+  log.status() << "Property cache: " << hits << " of "
+               << hits + cone_digests.size()
+               << " properties passed before with the same cone of influence"
+               << messaget::eom;
+}
+
+void property_cachet::store(const propertiest &properties)
+{
+  for(const auto &property : properties)
+  {
+    const auto digest = cone_digests.find(property.first);
+    if(
+      digest == cone_digests.end() ||
+      property.second.status != property_statust::PASS)
+    {
+      continue;
+    }
+
+    // Write to a file of a unique name first, such that concurrent runs never
+    // read a partially written entry
+    const std::string target = file_name(digest->second);
+    const std::string temporary =
+      target + "." + to_hex(std::random_device{}()) + ".tmp";
+    {
+      std::ofstream file(temporary);
+      file << property.first << '\n';
+      if(!file)
+      {
+        std::remove(temporary.c_str());
+        continue;
+      }
+    }
+
+    if(std::rename(temporary.c_str(), target.c_str()) != 0)
+      std::remove(temporary.c_str());
+  }
+}
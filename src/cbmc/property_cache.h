@@ -0,0 +1,72 @@
+/*******************************************************************\
+
+Module: Cache of Property Results Keyed by Cone of Influence
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// An on-disk cache of verification results of properties, keyed by a digest
+/// of the part of the program that can influence each property
+
+#ifndef CPROVER_CBMC_PROPERTY_CACHE_H
+#define CPROVER_CBMC_PROPERTY_CACHE_H
+
+#include <string>
+#include <unordered_map>
+
+#include <util/message.h>
+
+#include <goto-checker/properties.h>
+
+class goto_modelt;
+
+/// Keeps the properties that passed in a directory, with one entry per
+/// digest of the cone of influence of a property: the program that remains
+/// after reachability slicing with respect to that property alone, together
+/// with the symbols it refers to. A property whose cone has an entry passed
+/// before and is not checked again, however the rest of the program changed.
+///
+/// Source locations and other comments do not contribute to the digests, such
+/// that edits that only move code keep the entries valid. Only passing
+/// results are kept, as failing ones have to be checked again to produce
+/// their traces. Entries are only used by runs with the same options.
+class property_cachet
+{
+public:
+  /// \param _directory: directory of the entries, which is created if it
+  ///   does not exist
+  /// \param _fingerprint: digest of the options that the results depend on
+  /// \param message_handler: handler for reporting
+  property_cachet(
+    std::string _directory,
+    std::string _fingerprint,
+    message_handlert &message_handler);
+
+  /// Compute the cone of each assertion in \p goto_model and turn the
+  /// assertions whose cone has an entry into skips
+  void operator()(goto_modelt &goto_model);
+
+  /// Add entries for the properties that passed in this run
+  /// \param properties: the properties checked in this run
+  void store(const propertiest &properties);
+
+  std::size_t get_hits() const
+  {
+    return hits;
+  }
+
+protected:
+  std::string directory;
+  std::string fingerprint;
+  messaget log;
+
+  /// Digest of the cone of each property that was checked in this run
+  std::unordered_map<irep_idt, std::string> cone_digests;
+  std::size_t hits = 0;
+
+  std::string file_name(const std::string &cone_digest) const;
+};
+
+#endif // CPROVER_CBMC_PROPERTY_CACHE_H
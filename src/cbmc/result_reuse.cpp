@@ -0,0 +1,217 @@
+/*******************************************************************\
+
+Module: Reuse of Verification Results Across Program Versions
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Reuse of verification results of properties that changes to a program do
+/// not affect
+
+#include "result_reuse.h"
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#include <util/file_util.h>
+#include <util/string_hash.h>
+
+#include <goto-programs/goto_model.h>
+#include <goto-programs/read_bin_goto_object.h>
+#include <goto-programs/write_goto_binary.h>
+
+#include <goto-diff/change_impact.h>
+
+static std::string to_hex(std::size_t value)
+{
+  std::ostringstream out;
+  out << std::hex << value;
+  return out.str();
+}
+
+/// Two hashes of different construction make accidental collisions unlikely
+/// enough
+static std::string digest(const std::string &data)
+{
+  return to_hex(hash_string(data)) + "-" +
+         to_hex(std::hash<std::string>{}(data));
+}
+
+/// Replace \p file_name by a file with \p data, writing to a file of a
+/// unique name first such that concurrent runs never read a partial file
+static bool replace_file(const std::string &file_name, const std::string &data)
+{
+  const std::string temporary =
+    file_name + "." + to_hex(std::random_device{}()) + ".tmp";
+  {
+    std::ofstream out(temporary, std::ios::binary);
+    out << data;
+    if(!out)
+    {
+      std::remove(temporary.c_str());
+      return true;
+    }
+  }
+
+  if(std::rename(temporary.c_str(), file_name.c_str()) != 0)
+  {
+    std::remove(temporary.c_str());
+    return true;
+  }
+
+  return false;
+}
+
+static bool read_file(const std::string &file_name, std::string &data)
+{
+  std::ifstream in(file_name, std::ios::binary);
+  if(!in)
+    return true;
+
+  std::ostringstream contents;
+  contents << in.rdbuf();
+  data = contents.str();
+  return !in;
+}
+
+result_reuset::result_reuset(
+  std::string _directory,
+  std::string _fingerprint,
+  message_handlert &message_handler)
+  : directory(std::move(_directory)),
+    fingerprint(std::move(_fingerprint)),
+    log(message_handler)
+{
+  create_directory(directory);
+}
+
+std::string result_reuset::model_file() const
+{
+  return concat_dir_file(directory, "model.gb");
+}
+
+std::string result_reuset::results_file() const
+{
+  return concat_dir_file(directory, "results");
+}
+
+void result_reuset::operator()(goto_modelt &goto_model)
+{
+  reused.clear();
+
+  {
+    std::ostringstream out;
+    write_goto_binary(out, goto_model);
+    model = out.str();
+  }
+
+  // The results have to be for the options of this run, and for the stored
+  // model, which is replaced before the results are
+  std::string results;
+  if(read_file(results_file(), results))
+    return;
+
+  std::istringstream results_in(results);
+  std::string stored_fingerprint, stored_model_digest;
+  std::getline(results_in, stored_fingerprint);
+  std::getline(results_in, stored_model_digest);
+  if(!results_in)
+    return;
+  if(stored_fingerprint != fingerprint)
+  {
+    log.status() << "Stored results are for other options" << messaget::eom;
+    return;
+  }
+
+  std::string stored_model;
+  if(
+    read_file(model_file(), stored_model) ||
+    digest(stored_model) != stored_model_digest)
+  {
+    return;
+  }
+
+  goto_modelt baseline;
+  {
+    std::istringstream in(stored_model);
+    null_message_handlert null_message_handler;
+    if(read_bin_goto_object(
+         in,
+         model_file(),
+         baseline.symbol_table,
+         baseline.goto_functions,
+         null_message_handler))
+    {
+      return;
+    }
+  }
+
+  const auto stored_status = deserialize_property_status(
+    results.substr(static_cast<std::size_t>(results_in.tellg())));
+
+  const auto summary =
+    summarize_change_impact(baseline, goto_model, impact_modet::BOTH);
+
+  if(summary.has_non_local_impact)
+  {
+    log.status() << "Changes since the stored results may affect all "
+                 << "properties" << messaget::eom;
+    return;
+  }
+
+  for(auto &function : goto_model.goto_functions.function_map)
+  {
+    if(summary.impacted_functions.count(function.first) != 0)
+      continue;
+
+    for(auto &instruction : function.second.body.instructions)
+    {
+      if(!instruction.is_assert())
+        continue;
+
+      const irep_idt &property_id =
+        instruction.source_location.get_property_id();
+      const auto status = stored_status.find(property_id);
+      if(
+        status != stored_status.end() &&
+        status->second == property_statust::PASS)
+      {
+        instruction.turn_into_skip();
+        reused.insert(property_id);
+      }
+    }
+  }
+
+  log.status() << "Reusing the results of " << reused.size()
+               << " properties that passed before and are not affected by "
+               << "the changes" << messaget::eom;
+}
+
+void result_reuset::store(const propertiest &properties)
+{
+  if(replace_file(model_file(), model))
+  {
+    log.warning() << "failed to store the model in " << directory
+                  << messaget::eom;
+    return;
+  }
+
+  std::ostringstream results;
+  results << fingerprint << '\n' << digest(model) << '\n';
+  results << serialize_property_status(properties);
+  for(const auto &property_id : reused)
+  {
+    results << static_cast<int>(property_statust::PASS) << ' ' << property_id
+            << '\n';
+  }
+
+  if(replace_file(results_file(), results.str()))
+  {
+    log.warning() << "failed to store the results in " << directory
+                  << messaget::eom;
+  }
+}
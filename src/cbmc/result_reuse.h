@@ -0,0 +1,77 @@
+/*******************************************************************\
+
+Module: Reuse of Verification Results Across Program Versions
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Reuse of verification results of properties that changes to a program do
+/// not affect
+
+#ifndef CPROVER_CBMC_RESULT_REUSE_H
+#define CPROVER_CBMC_RESULT_REUSE_H
+
+#include <string>
+#include <unordered_set>
+
+#include <util/message.h>
+
+#include <goto-checker/properties.h>
+
+class goto_modelt;
+
+/// Keeps a goto model and the status of its properties in a directory, such
+/// that a later run on a changed version of the program can skip the
+/// properties that passed and that the changes do not affect.
+///
+/// Whether a property is affected is determined by the change impact analysis
+/// of goto-diff: properties are checked again if their function has changed
+/// instructions, or instructions that depend on, or are depended on by,
+/// changed ones. All properties are checked again if any such instruction is
+/// an assumption, a function call or a loop, as their effect on the paths to
+/// other properties is not captured by dependencies. Stored results are only
+/// used by runs with the same command-line options.
+class result_reuset
+{
+public:
+  /// \param _directory: directory of the stored model and results, which is
+  ///   created if it does not exist
+  /// \param _fingerprint: digest of the options that the results depend on
+  /// \param message_handler: handler for reporting
+  result_reuset(
+    std::string _directory,
+    std::string _fingerprint,
+    message_handlert &message_handler);
+
+  /// Compare \p goto_model with the stored model and turn the assertions of
+  /// properties that passed and are not affected by the changes into skips.
+  /// The model as it was before is kept for \ref store.
+  void operator()(goto_modelt &goto_model);
+
+  /// Store the model given to the last call of \ref operator() together with
+  /// the status of \p properties and of the skipped properties, which passed
+  /// \param properties: the properties checked in this run
+  void store(const propertiest &properties);
+
+  /// The properties whose assertions were turned into skips
+  const std::unordered_set<irep_idt> &get_reused() const
+  {
+    return reused;
+  }
+
+protected:
+  std::string directory;
+  std::string fingerprint;
+  messaget log;
+
+  /// The goto binary of the model before assertions were turned into skips
+  std::string model;
+  std::unordered_set<irep_idt> reused;
+
+  std::string model_file() const;
+  std::string results_file() const;
+};
+
+#endif // CPROVER_CBMC_RESULT_REUSE_H
@@ -0,0 +1,124 @@
+/*******************************************************************\
+
+Module: Static Pre-Discharge of Properties
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Prove properties by abstract interpretation before symbolic execution
+
+#include "static_pre_discharge.h"
+
+#include <util/expr_util.h>
+#include <util/find_symbols.h>
+#include <util/message.h>
+#include <util/namespace.h>
+
+#include <goto-programs/goto_model.h>
+
+#include <analyses/constant_propagator.h>
+#include <analyses/dirty.h>
+#include <analyses/interval_domain.h>
+
+/// Number of joins along a backward edge before the intervals are widened
+static const std::size_t interval_widening_delay = 2;
+
+/// Neither domain tracks writes through pointers, hence only conditions that
+/// read variables whose address is not taken, and no other memory, are
+/// considered
+static bool
+reads_only_clean_variables(const exprt &condition, const dirtyt &dirty)
+{
+  if(has_subexpr(condition, ID_dereference))
+    return false;
+
+  find_symbols_sett symbols;
+  find_symbols(condition, symbols, true, false);
+
+  for(const auto &identifier : symbols)
+  {
+    if(dirty(identifier))
+      return false;
+  }
+
+  return true;
+}
+
+std::size_t
+static_pre_discharge(goto_modelt &goto_model, message_handlert &message_handler)
+{
+  messaget log(message_handler);
+
+  std::size_t assertions = 0;
+  for(const auto &function : goto_model.goto_functions.function_map)
+  {
+    for(const auto &instruction : function.second.body.instructions)
+    {
+      if(instruction.is_start_thread())
+      {
+        log.warning() << "Static pre-discharge is not supported for "
+                      << "multi-threaded programs" << messaget::eom;
+        return 0;
+      }
+
+      if(instruction.is_assert() && !instruction.get_condition().is_true())
+        ++assertions;
+    }
+  }
+
+  if(
+    assertions == 0 || goto_model.goto_functions.function_map.count(
+                         goto_functionst::entry_point()) == 0)
+  {
+    return 0;
+  }
+
+  log.status() << "Static pre-discharge of " << assertions << " properties"
+               << messaget::eom;
+
+  const namespacet ns(goto_model.symbol_table);
+
+  constant_propagator_ait constants(goto_model.goto_functions);
+  constants(goto_model.goto_functions, ns);
+
+  interval_ait intervals(interval_widening_delay, true);
+  intervals(goto_model.goto_functions, ns);
+
+  const dirtyt dirty(goto_model.goto_functions);
+
+  std::size_t discharged = 0;
+  for(auto &function : goto_model.goto_functions.function_map)
+  {
+    auto &body = function.second.body;
+    for(auto it = body.instructions.begin(); it != body.instructions.end();
+        ++it)
+    {
+      if(
+        !it->is_assert() || it->get_condition().is_true() ||
+        !reads_only_clean_variables(it->get_condition(), dirty))
+      {
+        continue;
+      }
+
+      // for such conditions the domains are sound on their own, hence it
+      // suffices that one of them proves the condition
+      exprt by_constants = it->get_condition();
+      constants.abstract_state_before(it)->ai_simplify(by_constants, ns);
+      exprt by_intervals = it->get_condition();
+      intervals.abstract_state_before(it)->ai_simplify(by_intervals, ns);
+
+      if(by_constants.is_true() || by_intervals.is_true())
+      {
+        it->set_condition(true_exprt());
+        ++discharged;
+      }
+    }
+  }
+
+  log.status() << "Static pre-discharge: " << discharged << " of "
+               << assertions << " properties proved" << messaget::eom;
+
+  return discharged;
+}
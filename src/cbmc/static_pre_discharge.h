@@ -0,0 +1,30 @@
+/*******************************************************************\
+
+Module: Static Pre-Discharge of Properties
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Prove properties by abstract interpretation before symbolic execution
+
+#ifndef CPROVER_CBMC_STATIC_PRE_DISCHARGE_H
+#define CPROVER_CBMC_STATIC_PRE_DISCHARGE_H
+
+#include <cstddef>
+
+class goto_modelt;
+class message_handlert;
+
+/// Run a constant propagation and an interval analysis from the entry point
+/// of \p goto_model and replace the conditions of the assertions that either
+/// of them proves by true. Symex does not generate a verification condition
+/// for such assertions, hence their properties never reach the solver and are
+/// reported as passing. Programs that start threads are left unchanged, as
+/// neither analysis accounts for interleavings.
+/// \return the number of assertions that were discharged
+std::size_t
+static_pre_discharge(goto_modelt &goto_model, message_handlert &message_handler);
+
+#endif // CPROVER_CBMC_STATIC_PRE_DISCHARGE_H
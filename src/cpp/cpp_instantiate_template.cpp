@@ -313,6 +313,12 @@ const symbolt &cpp_typecheckt::instantiate_template(
   // produce new symbol name
   std::string suffix=template_suffix(full_template_args);
 
+  // complete instances are reused without setting up the template scope
+  const std::string instance_key = id2string(template_symbol.name) + suffix;
+  const auto complete_instance = complete_instances.find(instance_key);
+  if(complete_instance != complete_instances.end())
+    return lookup(complete_instance->second);
+
   // we need the template scope to see the template parameters
   cpp_scopet *template_scope=
     static_cast<cpp_scopet *>(cpp_scopes.id_map[template_symbol.name]);
@@ -375,11 +381,14 @@ const symbolt &cpp_typecheckt::instantiate_template(
       const symbolt &symb=lookup(cpp_id.identifier);
 
       // continue if the type is incomplete only
-      if(cpp_id.id_class==cpp_idt::id_classt::CLASS &&
-         symb.type.id()==ID_struct)
-        return symb;
-      else if(symb.value.is_not_nil())
+      if(
+        (cpp_id.id_class == cpp_idt::id_classt::CLASS &&
+         symb.type.id() == ID_struct) ||
+        symb.value.is_not_nil())
+      {
+        complete_instances.emplace(instance_key, symb.name);
         return symb;
+      }
     }
 
     cpp_scopes.go_to(sub_scope);
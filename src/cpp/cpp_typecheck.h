@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@cs.cmu.edu
 #include <list>
 #include <map>
 #include <set>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <util/std_code.h>
@@ -183,6 +184,10 @@ protected:
 
   void show_instantiation_stack(std::ostream &);
 
+  /// Complete instances by the name of their template followed by the suffix
+  /// of their template arguments, see \ref template_suffix
+  std::unordered_map<std::string, irep_idt> complete_instances;
+
   class instantiation_levelt
   {
   public:
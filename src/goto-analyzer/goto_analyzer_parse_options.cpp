@@ -56,6 +56,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/exception_utils.h>
 #include <util/exit_codes.h>
 #include <util/options.h>
+#include <util/string2int.h>
+#include <util/string_utils.h>
 #include <util/unicode.h>
 #include <util/version.h>
 
@@ -263,28 +265,54 @@ void goto_analyzer_parse_optionst::get_command_line_options(optionst &options)
       options.set_option("location-sensitive", true);
     }
 
-    // Domain choice
+    // Domain choice; tasks that only use one domain use the first of these
     if(cmdline.isset("constants"))
     {
       options.set_option("constants", true);
       options.set_option("domain set", true);
     }
-    else if(cmdline.isset("dependence-graph"))
+    if(cmdline.isset("dependence-graph"))
     {
       options.set_option("dependence-graph", true);
       options.set_option("domain set", true);
     }
-    else if(cmdline.isset("intervals"))
+    if(cmdline.isset("intervals"))
     {
       options.set_option("intervals", true);
       options.set_option("domain set", true);
     }
-    else if(cmdline.isset("non-null"))
+    if(cmdline.isset("non-null"))
     {
       options.set_option("non-null", true);
       options.set_option("domain set", true);
     }
 
+    if(options.get_bool_option("intervals"))
+    {
+      if(cmdline.isset("interval-widening"))
+      {
+        options.set_option(
+          "interval-widening", cmdline.get_value("interval-widening"));
+      }
+      options.set_option(
+        "interval-thresholds", cmdline.isset("interval-thresholds"));
+    }
+
+    if(cmdline.isset("entry-points"))
+    {
+      const auto entry_points =
+        split_string(cmdline.get_value("entry-points"), ',', true, true);
+      options.set_option(
+        "entry-points",
+        optionst::value_listt(entry_points.begin(), entry_points.end()));
+    }
+
+    if(cmdline.isset("parallel-analyses"))
+    {
+      options.set_option(
+        "parallel-analyses", cmdline.get_value("parallel-analyses"));
+    }
+
     // Reachability questions, when given with a domain swap from specific
     // to general tasks so that they can use the domain & parameterisations.
     if(reachability_task)
@@ -335,7 +363,16 @@ ai_baset *goto_analyzer_parse_optionst::build_analyzer(
     }
     else if(options.get_bool_option("intervals"))
     {
-      domain=new ait<interval_domaint>();
+      optionalt<std::size_t> widening_delay;
+      if(options.is_set("interval-widening"))
+      {
+        widening_delay =
+          safe_string2size_t(options.get_option("interval-widening"));
+      }
+
+      // interval_ait derives from ait<interval_domaint>
+      domain = new interval_ait(
+        widening_delay, options.get_bool_option("interval-thresholds"));
     }
 #if 0
     // Not actually implemented, despite the option...
@@ -449,7 +486,12 @@ int goto_analyzer_parse_optionst::perform_analysis(const optionst &options)
     {
       std::string json_file=cmdline.get_value("json");
       bool result = taint_analysis(
-        goto_model, taint_file, ui_message_handler, false, json_file);
+        goto_model,
+        taint_file,
+        ui_message_handler,
+        false,
+        json_file,
+        cmdline.isset("sparse-taint"));
       return result ? CPROVER_EXIT_VERIFICATION_UNSAFE : CPROVER_EXIT_SUCCESS;
     }
   }
@@ -577,6 +619,20 @@ int goto_analyzer_parse_optionst::perform_analysis(const optionst &options)
       return CPROVER_EXIT_INTERNAL_ERROR;
     }
 
+    if(
+      count_domains(options) > 1 || options.is_set("entry-points") ||
+      options.is_set("parallel-analyses"))
+    {
+      if(!options.get_bool_option("verify"))
+      {
+        log.error() << "Several domains, entry points or parallel analyses "
+                    << "are only supported with --verify" << messaget::eom;
+        return CPROVER_EXIT_USAGE_ERROR;
+      }
+
+      return combined_verification(options, out);
+    }
+
     // Build analyzer
     log.status() << "Selecting abstract domain" << messaget::eom;
     namespacet ns(goto_model.symbol_table);  // Must live as long as the domain.
@@ -659,6 +715,74 @@ int goto_analyzer_parse_optionst::perform_analysis(const optionst &options)
   return CPROVER_EXIT_USAGE_ERROR;
 }
 
+/// The domains that \ref goto_analyzer_parse_optionst::build_analyzer
+/// supports, in the order in which it picks them
+static const char *const domain_options[] = {"constants",
+                                             "dependence-graph",
+                                             "intervals",
+                                             "non-null"};
+
+std::size_t goto_analyzer_parse_optionst::count_domains(const optionst &options)
+{
+  std::size_t count = 0;
+  for(const char *domain : domain_options)
+  {
+    if(options.get_bool_option(domain))
+      ++count;
+  }
+  return count;
+}
+
+/// Check the assertions with each of the selected domains, from each of the
+/// selected entry points, in several processes if requested, and report the
+/// combined results
+int goto_analyzer_parse_optionst::combined_verification(
+  const optionst &options,
+  std::ostream &out)
+{
+  std::vector<std::string> domains;
+  for(const char *domain : domain_options)
+  {
+    if(options.get_bool_option(domain))
+      domains.push_back(domain);
+  }
+
+  std::vector<irep_idt> entry_points;
+  for(const auto &entry_point : options.get_list_option("entry-points"))
+    entry_points.push_back(entry_point);
+
+  const std::size_t parallel_analyses =
+    options.is_set("parallel-analyses")
+      ? safe_string2size_t(options.get_option("parallel-analyses"))
+      : 1;
+
+  const auto build = [&](const std::string &domain, const namespacet &ns) {
+    optionst task_options = options;
+    for(const auto &d : domains)
+      task_options.set_option(d, d == domain);
+    return std::unique_ptr<ai_baset>(build_analyzer(task_options, ns));
+  };
+
+  std::vector<static_verifier_resultt> results;
+  if(combined_static_verifier_results(
+       goto_model,
+       domains,
+       entry_points,
+       parallel_analyses,
+       build,
+       ui_message_handler,
+       results))
+  {
+    return CPROVER_EXIT_USAGE_ERROR;
+  }
+
+  log.status() << "Performing task" << messaget::eom;
+
+  static_verifier_report(goto_model, results, options, ui_message_handler, out);
+
+  return CPROVER_EXIT_VERIFICATION_SAFE;
+}
+
 bool goto_analyzer_parse_optionst::process_goto_program(
   const optionst &options)
 {
@@ -743,8 +867,17 @@ void goto_analyzer_parse_optionst::help()
     "Domain options:\n"
     " --constants                  constant domain\n"
     " --intervals                  interval domain\n"
+    " --interval-widening n        widen intervals at loop heads after n\n"
+    "                              iterations\n"
+    " --interval-thresholds        widen intervals to the integer constants\n"
+    "                              in the program\n"
     " --non-null                   non-null domain\n"
     " --dependence-graph           data and control dependencies between instructions\n" // NOLINT(*)
+    " --entry-points f,g,...       with --verify, analyze the program from\n"
+    "                              each of the given functions and combine\n"
+    "                              the results, as for several domains\n"
+    " --parallel-analyses n        with --verify, run the analyses for the\n"
+    "                              domains and entry points in n processes\n"
     "\n"
     "Output options:\n"
     " --text file_name             output results in plain text to given file\n"
@@ -756,6 +889,7 @@ void goto_analyzer_parse_optionst::help()
     "Specific analyses:\n"
     // NOLINTNEXTLINE(whitespace/line_length)
     " --taint file_name            perform taint analysis using rules in given file\n"
+    " --sparse-taint               propagate taint from the sources only\n"
     "\n"
     "C/C++ frontend options:\n"
     " -I path                      set include path (C/C++)\n"
@@ -134,7 +134,7 @@ class optionst;
   "(show-reachable-properties)(property):" \
   "(verbosity):(version)" \
   "(gcc)(arch):" \
-  "(taint):(show-taint)" \
+  "(taint):(show-taint)(sparse-taint)" \
   "(show-local-may-alias)" \
   "(json):(xml):" \
   "(text):(dot):" \
@@ -143,9 +143,11 @@ class optionst;
   "(unreachable-instructions)(unreachable-functions)" \
   "(reachable-functions)" \
   "(intervals)(show-intervals)" \
+  "(interval-widening):(interval-thresholds)" \
   "(non-null)(show-non-null)" \
   "(constants)" \
   "(dependence-graph)" \
+  "(entry-points):(parallel-analyses):" \
   "(show)(verify)(simplify):" \
   "(show-on-source)" \
   "(location-sensitive)(concurrent)" \
@@ -173,6 +175,9 @@ protected:
   virtual int perform_analysis(const optionst &options);
 
   ai_baset *build_analyzer(const optionst &, const namespacet &ns);
+
+  static std::size_t count_domains(const optionst &options);
+  int combined_verification(const optionst &options, std::ostream &out);
 };
 
 #endif // CPROVER_GOTO_ANALYZER_GOTO_ANALYZER_PARSE_OPTIONS_H
@@ -0,0 +1,706 @@
+/*******************************************************************\
+
+Module: Sparse Taint Analysis
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Sparse Taint Analysis
+
+#include "sparse_taint_analysis.h"
+
+#include <algorithm>
+
+#include <util/cprover_prefix.h>
+#include <util/make_unique.h>
+#include <util/namespace.h>
+#include <util/std_code.h>
+#include <util/std_expr.h>
+#include <util/string_constant.h>
+
+#include <analyses/custom_bitvector_analysis.h>
+#include <analyses/local_may_alias.h>
+
+sparse_taint_analysist::sparse_taint_analysist(
+  const goto_functionst &_goto_functions,
+  const namespacet &_ns)
+  : goto_functions(_goto_functions), ns(_ns)
+{
+  // the context of facts that hold in any calling context
+  facts.push_back(factt());
+}
+
+sparse_taint_analysist::~sparse_taint_analysist() = default;
+
+/// The name of a taint as numbered by custom_bitvector_analysist
+static irep_idt taint_name(const exprt &src)
+{
+  if(src.id() == ID_typecast)
+    return taint_name(to_typecast_expr(src).op());
+  else if(src.id() == ID_address_of)
+    return taint_name(to_address_of_expr(src).object());
+  else if(src.id() == ID_index)
+    return taint_name(to_index_expr(src).array());
+  else if(src.id() == ID_string_constant)
+    return to_string_constant(src).get_value();
+  else
+    return "(unknown)";
+}
+
+/// The symbol that custom_bitvector_domaint::object2id derives the name of
+/// \p src from
+static irep_idt base_symbol(const exprt &src)
+{
+  if(src.id() == ID_symbol)
+    return to_symbol_expr(src).get_identifier();
+  else if(src.id() == ID_dereference)
+    return base_symbol(to_dereference_expr(src).pointer());
+  else if(src.id() == ID_address_of)
+    return base_symbol(to_address_of_expr(src).object());
+  else if(src.id() == ID_member)
+    return base_symbol(to_member_expr(src).compound());
+  else if(src.id() == ID_typecast)
+    return base_symbol(to_typecast_expr(src).op());
+  else
+    return irep_idt();
+}
+
+/// The objects whose bits custom_bitvector_domaint::get_rhs reads for \p rhs
+static void rhs_objects(const exprt &rhs, std::vector<irep_idt> &dest)
+{
+  if(rhs.id() == ID_symbol || rhs.id() == ID_dereference)
+  {
+    const irep_idt object = custom_bitvector_domaint::object2id(rhs);
+    if(!object.empty())
+      dest.push_back(object);
+  }
+  else if(rhs.id() == ID_typecast)
+    rhs_objects(to_typecast_expr(rhs).op(), dest);
+  else if(rhs.id() == ID_if)
+  {
+    rhs_objects(to_if_expr(rhs).true_case(), dest);
+    rhs_objects(to_if_expr(rhs).false_case(), dest);
+  }
+}
+
+sparse_taint_analysist::fact_indext
+sparse_taint_analysist::fact_number(const factt &fact)
+{
+  const auto entry =
+    fact_numbers.emplace(object_taintt(fact.object, fact.taint), facts.size());
+  if(entry.second)
+    facts.push_back(fact);
+  return entry.first->second;
+}
+
+std::vector<exprt> sparse_taint_analysist::aliases(
+  const irep_idt &function_id,
+  locationt location,
+  const exprt &src)
+{
+  if(src.id() == ID_symbol)
+    return {src};
+  else if(src.id() == ID_dereference)
+  {
+    auto &local = local_may_alias[function_id];
+    if(!local)
+    {
+      local = util_make_unique<local_may_aliast>(
+        goto_functions.function_map.at(function_id));
+    }
+
+    std::vector<exprt> result;
+    for(const auto &alias :
+        local->get(location, to_dereference_expr(src).pointer()))
+    {
+      if(alias.type().id() == ID_pointer)
+        result.push_back(dereference_exprt(alias));
+    }
+    result.push_back(src);
+    return result;
+  }
+  else if(src.id() == ID_typecast)
+    return aliases(function_id, location, to_typecast_expr(src).op());
+  else
+    return {};
+}
+
+/// Mirrors custom_bitvector_domaint::assign_struct_rec
+void sparse_taint_analysist::assign(
+  const irep_idt &function_id,
+  locationt location,
+  const exprt &lhs,
+  const exprt &rhs,
+  effectt &dest)
+{
+  if(lhs.type().id() == ID_struct || lhs.type().id() == ID_struct_tag)
+  {
+    const struct_typet &struct_type = to_struct_type(ns.follow(lhs.type()));
+    for(const auto &component : struct_type.components())
+    {
+      assign(
+        function_id,
+        location,
+        member_exprt(lhs, component),
+        member_exprt(rhs, component),
+        dest);
+    }
+    return;
+  }
+
+  transfert transfer;
+  transfer.kill = true;
+  for(const auto &alias : aliases(function_id, location, lhs))
+  {
+    const irep_idt object = custom_bitvector_domaint::object2id(alias);
+    if(!object.empty())
+      transfer.dests.push_back({object, base_symbol(alias)});
+  }
+  rhs_objects(rhs, transfer.srcs);
+  dest.transfers.push_back(std::move(transfer));
+
+  if(lhs.type().id() == ID_pointer)
+  {
+    const dereference_exprt lhs_deref(lhs);
+    const irep_idt lhs_object = custom_bitvector_domaint::object2id(lhs_deref);
+    if(!lhs_object.empty())
+    {
+      transfert pointee;
+      pointee.kill = true;
+      pointee.dests.push_back({lhs_object, base_symbol(lhs)});
+      rhs_objects(dereference_exprt(rhs), pointee.srcs);
+      dest.transfers.push_back(std::move(pointee));
+    }
+  }
+}
+
+void sparse_taint_analysist::set_or_clear(
+  const irep_idt &function_id,
+  locationt location,
+  const irep_idt &statement,
+  const exprt &pointer,
+  const exprt &taint,
+  effectt &dest)
+{
+  // only the "may" bits describe taint
+  if(
+    (statement != ID_set_may && statement != ID_clear_may) ||
+    pointer.type().id() != ID_pointer)
+  {
+    return;
+  }
+
+  const irep_idt taint_id = taint_name(taint);
+
+  if(pointer.is_constant() && to_constant_expr(pointer).get_value() == ID_NULL)
+  {
+    // NULL means all objects
+    if(statement == ID_clear_may)
+      dest.clear.emplace_back(irep_idt(), taint_id);
+    return;
+  }
+
+  for(const auto &alias :
+      aliases(function_id, location, dereference_exprt(pointer)))
+  {
+    const irep_idt object = custom_bitvector_domaint::object2id(alias);
+    if(object.empty())
+      continue;
+    if(statement == ID_set_may)
+      dest.gen.push_back({object, base_symbol(alias), taint_id});
+    else
+      dest.clear.emplace_back(object, taint_id);
+  }
+}
+
+/// Collect the objects that the get_may expressions in \p src read
+static void collect_sinks(
+  const exprt &src,
+  std::vector<std::pair<irep_idt, irep_idt>> &dest)
+{
+  if(src.id() == ID_get_may && src.operands().size() == 2)
+  {
+    const exprt &pointer = to_binary_expr(src).op0();
+    if(pointer.type().id() != ID_pointer)
+      return;
+
+    const irep_idt taint = taint_name(to_binary_expr(src).op1());
+    if(pointer.is_constant() && to_constant_expr(pointer).get_value() == ID_NULL)
+      dest.emplace_back(irep_idt(), taint);
+    else
+    {
+      const irep_idt object =
+        custom_bitvector_domaint::object2id(dereference_exprt(pointer));
+      if(!object.empty())
+        dest.emplace_back(object, taint);
+    }
+    return;
+  }
+
+  for(const auto &op : src.operands())
+    collect_sinks(op, dest);
+}
+
+const sparse_taint_analysist::effectt &
+sparse_taint_analysist::effect(const irep_idt &function_id, locationt location)
+{
+  const auto entry = effects.emplace(&*location, effectt());
+  effectt &result = entry.first->second;
+  if(!entry.second)
+    return result;
+
+  const goto_programt::instructiont &instruction = *location;
+
+  switch(instruction.type)
+  {
+  case ASSIGN:
+  {
+    const code_assignt &code_assign = to_code_assign(instruction.code);
+    assign(function_id, location, code_assign.lhs(), code_assign.rhs(), result);
+    break;
+  }
+
+  case DECL:
+  case DEAD:
+  {
+    const symbol_exprt &symbol = instruction.type == DECL
+                                   ? to_code_decl(instruction.code).symbol()
+                                   : to_code_dead(instruction.code).symbol();
+    transfert transfer;
+    transfer.kill = true;
+    transfer.dests.push_back({symbol.get_identifier(), symbol.get_identifier()});
+    if(symbol.type().id() == ID_pointer)
+    {
+      transfer.dests.push_back(
+        {custom_bitvector_domaint::object2id(dereference_exprt(symbol)),
+         symbol.get_identifier()});
+    }
+    result.transfers.push_back(std::move(transfer));
+    break;
+  }
+
+  case FUNCTION_CALL:
+  {
+    const code_function_callt &call = instruction.get_function_call();
+    if(call.function().id() != ID_symbol)
+      break;
+
+    const irep_idt &identifier =
+      to_symbol_expr(call.function()).get_identifier();
+    if(
+      (identifier == CPROVER_PREFIX "set_may" ||
+       identifier == CPROVER_PREFIX "clear_may") &&
+      call.arguments().size() == 2)
+    {
+      set_or_clear(
+        function_id,
+        location,
+        identifier == CPROVER_PREFIX "set_may" ? ID_set_may : ID_clear_may,
+        call.arguments()[0],
+        call.arguments()[1],
+        result);
+    }
+    else if(
+      (identifier == "memcpy" || identifier == "memmove") &&
+      call.arguments().size() == 3)
+    {
+      assign(
+        function_id,
+        location,
+        dereference_exprt(call.arguments()[0]),
+        dereference_exprt(call.arguments()[1]),
+        result);
+    }
+    break;
+  }
+
+  case OTHER:
+  {
+    const codet &code = instruction.get_other();
+    if(code.operands().size() == 2)
+    {
+      set_or_clear(
+        function_id,
+        location,
+        code.get_statement(),
+        code.op0(),
+        code.op1(),
+        result);
+    }
+    break;
+  }
+
+  case ASSERT:
+    collect_sinks(instruction.get_condition(), result.sinks);
+    break;
+
+  case GOTO:
+  case ASSUME:
+  case LOCATION:
+  case SKIP:
+  case END_FUNCTION:
+  case ATOMIC_BEGIN:
+  case ATOMIC_END:
+  case START_THREAD:
+  case END_THREAD:
+  case RETURN:
+  case THROW:
+  case CATCH:
+  case INCOMPLETE_GOTO:
+  case NO_INSTRUCTION_TYPE:
+    break;
+  }
+
+  return result;
+}
+
+const goto_functionst::goto_functiont *
+sparse_taint_analysist::callee(locationt location, irep_idt &callee_id) const
+{
+  if(!location->is_function_call())
+    return nullptr;
+
+  const code_function_callt &call = location->get_function_call();
+  if(call.function().id() != ID_symbol)
+    return nullptr;
+
+  callee_id = to_symbol_expr(call.function()).get_identifier();
+
+  // treated as instructions, as by custom_bitvector_domaint
+  if(callee_id == "memcpy" || callee_id == "memmove")
+    return nullptr;
+
+  const auto function = goto_functions.function_map.find(callee_id);
+  if(
+    function == goto_functions.function_map.end() ||
+    !function->second.body_available())
+  {
+    return nullptr;
+  }
+
+  return &function->second;
+}
+
+const sparse_taint_analysist::call_effectt &
+sparse_taint_analysist::call_effect(
+  const irep_idt &,
+  locationt location,
+  const irep_idt &callee_id)
+{
+  const auto entry = call_effects.emplace(&*location, call_effectt());
+  call_effectt &result = entry.first->second;
+  if(!entry.second)
+    return result;
+
+  const code_function_callt &call = location->get_function_call();
+  const code_typet &code_type = to_code_type(ns.lookup(callee_id).type);
+
+  auto argument = call.arguments().begin();
+  for(const auto &parameter : code_type.parameters())
+  {
+    // there may be a mismatch in the number of arguments
+    if(argument == call.arguments().end())
+      break;
+
+    const irep_idt &parameter_id = parameter.get_identifier();
+    if(!parameter_id.empty())
+    {
+      transfert value;
+      value.kill = false;
+      value.dests.push_back({parameter_id, parameter_id});
+      rhs_objects(*argument, value.srcs);
+      result.to_callee.push_back(std::move(value));
+
+      if(parameter.type().id() == ID_pointer)
+      {
+        const symbol_exprt parameter_expr(parameter_id, parameter.type());
+        const irep_idt parameter_pointee =
+          custom_bitvector_domaint::object2id(dereference_exprt(parameter_expr));
+        const irep_idt argument_pointee =
+          custom_bitvector_domaint::object2id(dereference_exprt(*argument));
+
+        transfert pointee;
+        pointee.kill = false;
+        pointee.dests.push_back({parameter_pointee, parameter_id});
+        if(!argument_pointee.empty())
+          pointee.srcs.push_back(argument_pointee);
+        result.to_callee.push_back(std::move(pointee));
+
+        // the callee may taint what the argument points to
+        if(!argument_pointee.empty())
+        {
+          transfert back;
+          back.kill = false;
+          back.dests.push_back({argument_pointee, base_symbol(*argument)});
+          back.srcs.push_back(parameter_pointee);
+          result.to_caller.push_back(std::move(back));
+        }
+      }
+    }
+
+    ++argument;
+  }
+
+  return result;
+}
+
+bool sparse_taint_analysist::is_global(const irep_idt &base) const
+{
+  const symbolt *symbol;
+  return base.empty() || ns.lookup(base, symbol) ||
+         symbol->is_static_lifetime;
+}
+
+std::vector<sparse_taint_analysist::fact_indext> sparse_taint_analysist::apply(
+  const std::vector<transfert> &transfers,
+  fact_indext fact,
+  bool keep)
+{
+  // copied, as numbering new facts may move the vector
+  const factt source = facts[fact];
+  std::vector<fact_indext> result;
+
+  for(const auto &transfer : transfers)
+  {
+    if(
+      transfer.kill &&
+      std::any_of(
+        transfer.dests.begin(),
+        transfer.dests.end(),
+        [&source](const objectt &dest) {
+          return dest.object == source.object;
+        }))
+    {
+      keep = false;
+    }
+
+    if(
+      std::find(transfer.srcs.begin(), transfer.srcs.end(), source.object) !=
+      transfer.srcs.end())
+    {
+      for(const auto &dest : transfer.dests)
+        result.push_back(fact_number({dest.object, dest.base, source.taint}));
+    }
+  }
+
+  if(keep)
+    result.push_back(fact);
+
+  return result;
+}
+
+void sparse_taint_analysist::propagate(
+  const irep_idt &function_id,
+  fact_indext context,
+  locationt location,
+  fact_indext fact)
+{
+  if(path_edges.insert({context, &*location, fact}).second)
+    worklist.push_back({function_id, context, location, fact});
+}
+
+void sparse_taint_analysist::find_reachable_functions()
+{
+  std::vector<irep_idt> queue;
+
+  const auto entry = goto_functions.function_map.find(
+    goto_functionst::entry_point());
+  if(
+    entry != goto_functions.function_map.end() &&
+    entry->second.body_available())
+  {
+    queue.push_back(entry->first);
+  }
+  else
+  {
+    for(const auto &function : goto_functions.function_map)
+    {
+      if(function.second.body_available())
+        queue.push_back(function.first);
+    }
+  }
+  reachable.insert(queue.begin(), queue.end());
+
+  while(!queue.empty())
+  {
+    const irep_idt function_id = queue.back();
+    queue.pop_back();
+
+    const goto_programt &body =
+      goto_functions.function_map.at(function_id).body;
+    forall_goto_program_instructions(it, body)
+    {
+      irep_idt callee_id;
+      if(callee(it, callee_id) == nullptr)
+        continue;
+
+      callers[callee_id].emplace_back(function_id, it);
+      if(reachable.insert(callee_id).second)
+        queue.push_back(callee_id);
+    }
+  }
+}
+
+void sparse_taint_analysist::return_to(
+  const irep_idt &function_id,
+  fact_indext context,
+  locationt call,
+  const irep_idt &callee_id,
+  fact_indext fact)
+{
+  // objects of the callee other than what its parameters point to are not
+  // visible to the caller
+  const bool keep = is_global(facts[fact].base);
+  for(const auto result :
+      apply(call_effect(function_id, call, callee_id).to_caller, fact, keep))
+  {
+    propagate(function_id, context, std::next(call), result);
+  }
+}
+
+void sparse_taint_analysist::process(const work_itemt &item)
+{
+  const irep_idt &function_id = item.function_id;
+  const locationt location = item.location;
+  const fact_indext fact = item.fact;
+
+  if(location->is_end_function())
+  {
+    const function_contextt function_context(function_id, item.context);
+    if(!summaries[function_context].insert(fact).second)
+      return;
+
+    const auto calls = incoming.find(function_context);
+    if(calls != incoming.end())
+    {
+      // copied, as returning may add calls
+      const std::vector<incomingt> incoming_calls = calls->second;
+      for(const auto &call : incoming_calls)
+        return_to(call.function_id, call.context, call.location, function_id, fact);
+    }
+
+    // facts that hold in any context return to all callers
+    if(item.context == zero)
+    {
+      const auto call_sites = callers.find(function_id);
+      if(call_sites != callers.end())
+      {
+        for(const auto &call_site : call_sites->second)
+          return_to(call_site.first, zero, call_site.second, function_id, fact);
+      }
+    }
+
+    return;
+  }
+
+  irep_idt callee_id;
+  const goto_functionst::goto_functiont *callee_function =
+    callee(location, callee_id);
+  if(callee_function != nullptr)
+  {
+    const bool global = is_global(facts[fact].base);
+    const auto entry_facts = apply(
+      call_effect(function_id, location, callee_id).to_callee, fact, global);
+
+    for(const auto entry_fact : entry_facts)
+    {
+      const function_contextt callee_context(callee_id, entry_fact);
+      incoming[callee_context].push_back({function_id, item.context, location});
+      propagate(
+        callee_id,
+        entry_fact,
+        callee_function->body.instructions.begin(),
+        entry_fact);
+
+      // reuse the summary of the callee in this context
+      const auto summary = summaries.find(callee_context);
+      if(summary != summaries.end())
+      {
+        const std::vector<fact_indext> exit_facts(
+          summary->second.begin(), summary->second.end());
+        for(const auto exit_fact : exit_facts)
+        {
+          return_to(
+            function_id, item.context, location, callee_id, exit_fact);
+        }
+      }
+    }
+
+    // objects of the caller that the callee cannot name bypass it
+    if(!global)
+      propagate(function_id, item.context, std::next(location), fact);
+
+    return;
+  }
+
+  const effectt &instruction_effect = effect(function_id, location);
+
+  for(const auto &sink : instruction_effect.sinks)
+  {
+    if(
+      (sink.first.empty() || sink.first == facts[fact].object) &&
+      sink.second == facts[fact].taint)
+    {
+      failing.insert(&*location);
+    }
+  }
+
+  const bool cleared = std::any_of(
+    instruction_effect.clear.begin(),
+    instruction_effect.clear.end(),
+    [this, fact](const object_taintt &clear) {
+      return (clear.first.empty() || clear.first == facts[fact].object) &&
+             clear.second == facts[fact].taint;
+    });
+  if(cleared)
+    return;
+
+  const auto successor_facts =
+    apply(instruction_effect.transfers, fact, true);
+  for(const auto successor :
+      goto_functions.function_map.at(function_id).body.get_successors(
+        location))
+  {
+    for(const auto successor_fact : successor_facts)
+      propagate(function_id, item.context, successor, successor_fact);
+  }
+}
+
+void sparse_taint_analysist::operator()()
+{
+  find_reachable_functions();
+
+  // seed the facts that the sources generate in any context
+  for(const auto &function_id : reachable)
+  {
+    const goto_programt &body =
+      goto_functions.function_map.at(function_id).body;
+    forall_goto_program_instructions(it, body)
+    {
+      const bool is_source =
+        it->is_other() ||
+        (it->is_function_call() &&
+         it->get_function_call().function().id() == ID_symbol &&
+         to_symbol_expr(it->get_function_call().function()).get_identifier() ==
+           CPROVER_PREFIX "set_may");
+      if(!is_source)
+        continue;
+
+      const std::vector<factt> gen = effect(function_id, it).gen;
+      for(const auto successor : body.get_successors(it))
+      {
+        for(const auto &fact : gen)
+          propagate(function_id, zero, successor, fact_number(fact));
+      }
+    }
+  }
+
+  while(!worklist.empty())
+  {
+    const work_itemt item = worklist.back();
+    worklist.pop_back();
+    process(item);
+  }
+}
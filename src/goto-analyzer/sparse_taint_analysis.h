@@ -0,0 +1,247 @@
+/*******************************************************************\
+
+Module: Sparse Taint Analysis
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Sparse Taint Analysis
+
+#ifndef CPROVER_GOTO_ANALYZER_SPARSE_TAINT_ANALYSIS_H
+#define CPROVER_GOTO_ANALYZER_SPARSE_TAINT_ANALYSIS_H
+
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <goto-programs/goto_functions.h>
+
+class local_may_aliast;
+class namespacet;
+
+/// Demand-driven taint analysis of a program instrumented by
+/// taint_analysist, with the semantics of the "may" bits of
+/// custom_bitvector_analysist.
+///
+/// Rather than keeping the state of all objects at every location of the
+/// program, this solves the problem as an IFDS problem (Reps, Horwitz and
+/// Sagiv, 1995) whose facts are pairs of an object and a taint. Facts are
+/// generated at the sources only and propagated along the edges that they
+/// reach: instructions without a tainted object are never visited, and a
+/// function is analyzed once per fact that reaches its entry, its summary
+/// being reused at all other call sites. Facts that do not depend on the
+/// calling context, as those generated at sources, return to all callers.
+class sparse_taint_analysist
+{
+public:
+  sparse_taint_analysist(
+    const goto_functionst &goto_functions,
+    const namespacet &ns);
+  ~sparse_taint_analysist();
+
+  /// Propagate the taint from the sources in the functions that are
+  /// reachable from the entry point, or in all functions if there is none
+  void operator()();
+
+  /// Return true if a tainted object may reach the assertion at \p target
+  bool may_fail(goto_programt::const_targett target) const
+  {
+    return failing.count(&*target) != 0;
+  }
+
+protected:
+  typedef goto_programt::const_targett locationt;
+  typedef std::size_t fact_indext;
+
+  const goto_functionst &goto_functions;
+  const namespacet &ns;
+
+  struct factt
+  {
+    /// name of the object as given by custom_bitvector_domaint::object2id
+    irep_idt object;
+    /// the symbol the name of the object derives from, which determines
+    /// the functions it is visible in
+    irep_idt base;
+    irep_idt taint;
+  };
+
+  /// Fact 0 is the context of facts that hold in any calling context
+  static const fact_indext zero = 0;
+  std::vector<factt> facts;
+  typedef std::pair<irep_idt, irep_idt> object_taintt;
+  struct object_taint_hasht
+  {
+    std::size_t operator()(const object_taintt &object_taint) const
+    {
+      return irep_id_hash()(object_taint.first) ^
+             (irep_id_hash()(object_taint.second) << 1);
+    }
+  };
+  std::unordered_map<object_taintt, fact_indext, object_taint_hasht>
+    fact_numbers;
+  fact_indext fact_number(const factt &fact);
+
+  /// A tracked object with the symbol its name derives from
+  struct objectt
+  {
+    irep_idt object;
+    irep_idt base;
+  };
+  /// The taint of the objects in \ref srcs flows into those in \ref dests
+  struct transfert
+  {
+    std::vector<objectt> dests;
+    std::vector<irep_idt> srcs;
+    /// whether the \ref dests are overwritten
+    bool kill;
+  };
+
+  /// The effect of an instruction other than a call to a function with a body
+  struct effectt
+  {
+    std::vector<transfert> transfers;
+    /// facts generated in any context
+    std::vector<factt> gen;
+    /// objects and taints whose facts are removed, where an empty object
+    /// stands for all objects
+    std::vector<object_taintt> clear;
+    /// objects and taints that must not be tainted, for assertions
+    std::vector<object_taintt> sinks;
+  };
+  std::unordered_map<const goto_programt::instructiont *, effectt> effects;
+  const effectt &effect(const irep_idt &function_id, locationt location);
+
+  std::unordered_map<irep_idt, std::unique_ptr<local_may_aliast>>
+    local_may_alias;
+  std::vector<exprt> aliases(
+    const irep_idt &function_id,
+    locationt location,
+    const exprt &src);
+  void assign(
+    const irep_idt &function_id,
+    locationt location,
+    const exprt &lhs,
+    const exprt &rhs,
+    effectt &dest);
+  void set_or_clear(
+    const irep_idt &function_id,
+    locationt location,
+    const irep_idt &statement,
+    const exprt &pointer,
+    const exprt &taint,
+    effectt &dest);
+
+  /// The body of the function called at \p location, if there is one
+  const goto_functionst::goto_functiont *
+  callee(locationt location, irep_idt &callee_id) const;
+
+  /// The transfers from the arguments of the call at \p location to the
+  /// parameters of the callee, and back from the objects the parameters
+  /// point to
+  struct call_effectt
+  {
+    std::vector<transfert> to_callee;
+    std::vector<transfert> to_caller;
+  };
+  std::unordered_map<const goto_programt::instructiont *, call_effectt>
+    call_effects;
+  const call_effectt &call_effect(
+    const irep_idt &function_id,
+    locationt location,
+    const irep_idt &callee_id);
+
+  bool is_global(const irep_idt &base) const;
+
+  /// The facts that \p fact becomes through \p transfers, including
+  /// \p fact itself if it is not killed and \p keep is set
+  std::vector<fact_indext> apply(
+    const std::vector<transfert> &transfers,
+    fact_indext fact,
+    bool keep);
+
+  struct path_edget
+  {
+    fact_indext context;
+    const goto_programt::instructiont *location;
+    fact_indext fact;
+
+    bool operator==(const path_edget &other) const
+    {
+      return context == other.context && location == other.location &&
+             fact == other.fact;
+    }
+  };
+  struct path_edge_hasht
+  {
+    std::size_t operator()(const path_edget &edge) const
+    {
+      return std::hash<const void *>{}(edge.location) ^
+             (edge.context * 0x9e3779b9) ^ (edge.fact << 16);
+    }
+  };
+  std::unordered_set<path_edget, path_edge_hasht> path_edges;
+
+  struct work_itemt
+  {
+    irep_idt function_id;
+    fact_indext context;
+    locationt location;
+    fact_indext fact;
+  };
+  std::vector<work_itemt> worklist;
+  void propagate(
+    const irep_idt &function_id,
+    fact_indext context,
+    locationt location,
+    fact_indext fact);
+
+  /// A call that reached a function with a given context
+  struct incomingt
+  {
+    irep_idt function_id;
+    fact_indext context;
+    locationt location;
+  };
+  typedef std::pair<irep_idt, fact_indext> function_contextt;
+  struct function_context_hasht
+  {
+    std::size_t operator()(const function_contextt &function_context) const
+    {
+      return irep_id_hash()(function_context.first) ^
+             (function_context.second * 0x9e3779b9);
+    }
+  };
+  std::unordered_map<
+    function_contextt,
+    std::vector<incomingt>,
+    function_context_hasht>
+    incoming;
+  std::unordered_map<
+    function_contextt,
+    std::unordered_set<fact_indext>,
+    function_context_hasht>
+    summaries;
+
+  /// The call sites of each function in reachable functions
+  std::unordered_map<irep_idt, std::vector<std::pair<irep_idt, locationt>>>
+    callers;
+  std::unordered_set<irep_idt> reachable;
+  void find_reachable_functions();
+
+  void return_to(
+    const irep_idt &function_id,
+    fact_indext context,
+    locationt call,
+    const irep_idt &callee_id,
+    fact_indext fact);
+
+  void process(const work_itemt &item);
+
+  std::unordered_set<const goto_programt::instructiont *> failing;
+};
+
+#endif // CPROVER_GOTO_ANALYZER_SPARSE_TAINT_ANALYSIS_H
@@ -8,6 +8,11 @@ Author: Martin Brain, martin.brain@cs.ox.ac.uk
 
 #include "static_verifier.h"
 
+#include <algorithm>
+#include <sstream>
+
+#include <util/cprover_prefix.h>
+#include <util/forked_workers.h>
 #include <util/json_irep.h>
 #include <util/message.h>
 #include <util/namespace.h>
@@ -18,15 +23,6 @@ Author: Martin Brain, martin.brain@cs.ox.ac.uk
 
 #include <analyses/ai.h>
 
-struct static_verifier_resultt
-{
-  // clang-format off
-  enum statust { TRUE, FALSE, BOTTOM, UNKNOWN } status;
-  // clang-format on
-  source_locationt source_location;
-  irep_idt function_id;
-};
-
 void static_verifier(
   const abstract_goto_modelt &abstract_goto_model,
   const ai_baset &ai,
@@ -262,35 +258,15 @@ static void static_verifier_console(
     m.result() << '\n';
 }
 
-/// Runs the analyzer and then prints out the domain
-/// \param goto_model: the program analyzed
-/// \param ai: the abstract interpreter after it has been run to fix point
-/// \param options: the parsed user options
-/// \param message_handler: the system message handler
-/// \param out: output stream for the printing
-/// \return false on success with the domain printed to out
-bool static_verifier(
-  const goto_modelt &goto_model,
-  const ai_baset &ai,
-  const optionst &options,
-  message_handlert &message_handler,
-  std::ostream &out)
+std::vector<static_verifier_resultt>
+static_verifier_results(const goto_modelt &goto_model, const ai_baset &ai)
 {
-  std::size_t pass = 0, fail = 0, unknown = 0;
-
-  namespacet ns(goto_model.symbol_table);
-
-  messaget m(message_handler);
-  m.status() << "Checking assertions" << messaget::eom;
+  const namespacet ns(goto_model.symbol_table);
 
   std::vector<static_verifier_resultt> results;
 
   for(const auto &f : goto_model.goto_functions.function_map)
   {
-    const auto &symbol = ns.lookup(f.first);
-
-    m.progress() << "Checking " << symbol.display_name() << messaget::eom;
-
     if(!f.second.body.has_assertion())
       continue;
 
@@ -308,31 +284,304 @@ bool static_verifier(
       auto &result = results.back();
 
       if(e.is_true())
-      {
         result.status = static_verifier_resultt::TRUE;
-        ++pass;
-      }
       else if(e.is_false())
-      {
         result.status = static_verifier_resultt::FALSE;
-        ++fail;
-      }
       else if(domain.is_bottom())
-      {
         result.status = static_verifier_resultt::BOTTOM;
-        ++pass;
-      }
       else
-      {
         result.status = static_verifier_resultt::UNKNOWN;
-        ++unknown;
-      }
 
       result.source_location = i_it->source_location;
       result.function_id = f.first;
     }
   }
 
+  return results;
+}
+
+void merge_domain_results(
+  std::vector<static_verifier_resultt> &results,
+  const std::vector<static_verifier_resultt> &other)
+{
+  PRECONDITION(results.size() == other.size());
+
+  for(std::size_t i = 0; i < results.size(); ++i)
+  {
+    auto &status = results[i].status;
+    const auto other_status = other[i].status;
+
+    // an assertion that one sound domain shows to always hold and another
+    // to always fail cannot be reached
+    if(
+      status == static_verifier_resultt::BOTTOM ||
+      other_status == static_verifier_resultt::BOTTOM ||
+      (status == static_verifier_resultt::TRUE &&
+       other_status == static_verifier_resultt::FALSE) ||
+      (status == static_verifier_resultt::FALSE &&
+       other_status == static_verifier_resultt::TRUE))
+    {
+      status = static_verifier_resultt::BOTTOM;
+    }
+    else if(status == static_verifier_resultt::UNKNOWN)
+      status = other_status;
+  }
+}
+
+void merge_entry_point_results(
+  std::vector<static_verifier_resultt> &results,
+  const std::vector<static_verifier_resultt> &other)
+{
+  PRECONDITION(results.size() == other.size());
+
+  for(std::size_t i = 0; i < results.size(); ++i)
+  {
+    auto &status = results[i].status;
+    const auto other_status = other[i].status;
+
+    if(status == static_verifier_resultt::BOTTOM)
+      status = other_status;
+    else if(
+      other_status != static_verifier_resultt::BOTTOM &&
+      other_status != status)
+    {
+      status = static_verifier_resultt::UNKNOWN;
+    }
+  }
+}
+
+/// Make the entry point of \p goto_model call \p function_id with
+/// non-deterministic arguments after initialising the static objects
+/// \return the previous body of the entry point
+static goto_programt
+set_entry_point(goto_modelt &goto_model, const irep_idt &function_id)
+{
+  goto_programt &start =
+    goto_model.goto_functions.function_map.at(goto_functionst::entry_point())
+      .body;
+  const symbolt &function_symbol =
+    goto_model.symbol_table.lookup_ref(function_id);
+  const source_locationt &source_location = function_symbol.location;
+
+  goto_programt body;
+
+  // keep the initialisation of static objects
+  for(const auto &instruction : start.instructions)
+  {
+    if(
+      instruction.is_function_call() &&
+      to_code_function_call(instruction.code).function().id() == ID_symbol &&
+      to_symbol_expr(to_code_function_call(instruction.code).function())
+          .get_identifier() == CPROVER_PREFIX "initialize")
+    {
+      body.add(goto_programt::make_function_call(
+        to_code_function_call(instruction.code), source_location));
+    }
+  }
+
+  code_function_callt::argumentst arguments;
+  for(const auto &parameter : to_code_type(function_symbol.type).parameters())
+  {
+    arguments.push_back(
+      side_effect_expr_nondett(parameter.type(), source_location));
+  }
+  body.add(goto_programt::make_function_call(
+    function_symbol.symbol_expr(), std::move(arguments), source_location));
+  body.add(goto_programt::make_end_function(source_location));
+
+  start.swap(body);
+  goto_model.goto_functions.update();
+
+  return body;
+}
+
+bool combined_static_verifier_results(
+  goto_modelt &goto_model,
+  const std::vector<std::string> &domains,
+  std::vector<irep_idt> entry_points,
+  std::size_t parallel_analyses,
+  const std::function<std::unique_ptr<ai_baset>(
+    const std::string &domain,
+    const namespacet &ns)> &build_analyzer,
+  message_handlert &message_handler,
+  std::vector<static_verifier_resultt> &results)
+{
+  messaget log(message_handler);
+
+  for(const auto &entry_point : entry_points)
+  {
+    const auto function =
+      goto_model.goto_functions.function_map.find(entry_point);
+    if(
+      function == goto_model.goto_functions.function_map.end() ||
+      !function->second.body_available())
+    {
+      log.error() << "Entry point '" << entry_point << "' has no body"
+                  << messaget::eom;
+      return true;
+    }
+  }
+
+  // the empty identifier stands for the entry point of the program
+  if(entry_points.empty())
+    entry_points.push_back(irep_idt());
+
+  if(
+    !entry_points.front().empty() &&
+    goto_model.goto_functions.function_map.count(
+      goto_functionst::entry_point()) == 0)
+  {
+    log.error() << "No entry point to replace" << messaget::eom;
+    return true;
+  }
+
+  // The results of one task are the statuses of all assertions in the order
+  // of static_verifier_results, one character each
+  const std::size_t number_of_tasks = domains.size() * entry_points.size();
+  const auto run_task = [&](std::size_t task) {
+    const irep_idt &entry_point = entry_points[task / domains.size()];
+    goto_programt start;
+    if(!entry_point.empty())
+      start = set_entry_point(goto_model, entry_point);
+
+    std::string statuses;
+    {
+      const namespacet ns(goto_model.symbol_table);
+      std::unique_ptr<ai_baset> analyzer =
+        build_analyzer(domains[task % domains.size()], ns);
+      if(analyzer != nullptr)
+      {
+        (*analyzer)(goto_model);
+        for(const auto &result : static_verifier_results(goto_model, *analyzer))
+          statuses += static_cast<char>('0' + result.status);
+      }
+    }
+
+    if(!entry_point.empty())
+    {
+      goto_model.goto_functions.function_map
+        .at(goto_functionst::entry_point())
+        .body.swap(start);
+      goto_model.goto_functions.update();
+    }
+
+    return statuses;
+  };
+
+  log.status() << "Computing abstract states in " << number_of_tasks
+               << " analyses" << messaget::eom;
+
+  std::vector<std::string> task_statuses(number_of_tasks);
+  if(parallel_analyses > 1 && forked_workers_supported())
+  {
+    // worker i runs the tasks i, i + n, i + 2n, ... for n workers
+    const std::size_t number_of_workers =
+      std::min(parallel_analyses, number_of_tasks);
+    const auto worker_results =
+      run_forked_workers(number_of_workers, [&](std::size_t worker) {
+        std::string result;
+        for(std::size_t task = worker; task < number_of_tasks;
+            task += number_of_workers)
+        {
+          result += run_task(task) + '\n';
+        }
+        return result;
+      });
+
+    for(std::size_t worker = 0; worker < number_of_workers; ++worker)
+    {
+      if(!worker_results[worker].has_value())
+        continue;
+      std::istringstream in(*worker_results[worker]);
+      for(std::size_t task = worker; task < number_of_tasks;
+          task += number_of_workers)
+      {
+        std::getline(in, task_statuses[task]);
+      }
+    }
+  }
+  else
+  {
+    for(std::size_t task = 0; task < number_of_tasks; ++task)
+      task_statuses[task] = run_task(task);
+  }
+
+  // Analyses that failed leave their assertions unknown
+  std::vector<static_verifier_resultt> unknown;
+  for(const auto &f : goto_model.goto_functions.function_map)
+  {
+    forall_goto_program_instructions(i_it, f.second.body)
+    {
+      if(i_it->is_assert())
+      {
+        unknown.push_back(
+          {static_verifier_resultt::UNKNOWN, i_it->source_location, f.first});
+      }
+    }
+  }
+
+  results.clear();
+  for(std::size_t entry = 0; entry < entry_points.size(); ++entry)
+  {
+    std::vector<static_verifier_resultt> entry_results = unknown;
+    for(std::size_t domain = 0; domain < domains.size(); ++domain)
+    {
+      const std::string &statuses =
+        task_statuses[entry * domains.size() + domain];
+      if(statuses.size() != unknown.size())
+      {
+        log.warning() << "Analysis with domain " << domains[domain]
+                      << " did not complete" << messaget::eom;
+        continue;
+      }
+
+      std::vector<static_verifier_resultt> domain_results = unknown;
+      for(std::size_t i = 0; i < statuses.size(); ++i)
+      {
+        domain_results[i].status =
+          static_cast<static_verifier_resultt::statust>(statuses[i] - '0');
+      }
+      merge_domain_results(entry_results, domain_results);
+    }
+
+    if(entry == 0)
+      results = std::move(entry_results);
+    else
+      merge_entry_point_results(results, entry_results);
+  }
+
+  return false;
+}
+
+bool static_verifier_report(
+  const goto_modelt &goto_model,
+  const std::vector<static_verifier_resultt> &results,
+  const optionst &options,
+  message_handlert &message_handler,
+  std::ostream &out)
+{
+  std::size_t pass = 0, fail = 0, unknown = 0;
+
+  for(const auto &result : results)
+  {
+    switch(result.status)
+    {
+    case static_verifier_resultt::TRUE:
+    case static_verifier_resultt::BOTTOM:
+      ++pass;
+      break;
+    case static_verifier_resultt::FALSE:
+      ++fail;
+      break;
+    case static_verifier_resultt::UNKNOWN:
+      ++unknown;
+      break;
+    }
+  }
+
+  namespacet ns(goto_model.symbol_table);
+  messaget m(message_handler);
+
   if(options.get_bool_option("json"))
   {
     static_verifier_json(results, m, out);
@@ -358,3 +607,28 @@ bool static_verifier(
 
   return false;
 }
+
+/// Runs the analyzer and then prints out the domain
+/// \param goto_model: the program analyzed
+/// \param ai: the abstract interpreter after it has been run to fix point
+/// \param options: the parsed user options
+/// \param message_handler: the system message handler
+/// \param out: output stream for the printing
+/// \return false on success with the domain printed to out
+bool static_verifier(
+  const goto_modelt &goto_model,
+  const ai_baset &ai,
+  const optionst &options,
+  message_handlert &message_handler,
+  std::ostream &out)
+{
+  messaget m(message_handler);
+  m.status() << "Checking assertions" << messaget::eom;
+
+  return static_verifier_report(
+    goto_model,
+    static_verifier_results(goto_model, ai),
+    options,
+    message_handler,
+    out);
+}
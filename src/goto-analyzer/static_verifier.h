@@ -10,14 +10,29 @@ Author: Martin Brain, martin.brain@cs.ox.ac.uk
 #define CPROVER_GOTO_ANALYZER_STATIC_VERIFIER_H
 
 #include <goto-checker/properties.h>
+#include <functional>
 #include <iosfwd>
+#include <memory>
+#include <vector>
+
+#include <util/source_location.h>
 
 class abstract_goto_modelt;
 class ai_baset;
 class goto_modelt;
 class message_handlert;
+class namespacet;
 class optionst;
 
+struct static_verifier_resultt
+{
+  // clang-format off
+  enum statust { TRUE, FALSE, BOTTOM, UNKNOWN } status;
+  // clang-format on
+  source_locationt source_location;
+  irep_idt function_id;
+};
+
 bool static_verifier(
   const goto_modelt &,
   const ai_baset &,
@@ -25,6 +40,69 @@ bool static_verifier(
   message_handlert &,
   std::ostream &);
 
+/// Use the information from the abstract interpreter to check each assertion
+/// \param goto_model: the program analyzed
+/// \param ai: the abstract interpreter after it has been run to fix point
+/// \return one result per assertion, in the order of the goto functions
+std::vector<static_verifier_resultt>
+static_verifier_results(const goto_modelt &goto_model, const ai_baset &ai);
+
+/// Combine the results of two analyses of the same program that used
+/// different domains: as each of them is sound, the more precise status
+/// holds
+/// \param results: the results of one analysis, updated in place
+/// \param other: the results of another analysis
+void merge_domain_results(
+  std::vector<static_verifier_resultt> &results,
+  const std::vector<static_verifier_resultt> &other);
+
+/// Combine the results of two analyses of the same program that started from
+/// different entry points: an assertion only succeeds if it does from all
+/// entry points that reach it
+/// \param results: the results of one analysis, updated in place
+/// \param other: the results of another analysis
+void merge_entry_point_results(
+  std::vector<static_verifier_resultt> &results,
+  const std::vector<static_verifier_resultt> &other);
+
+/// Check the assertions with each of \p domains, from each of
+/// \p entry_points, and combine the results with \ref merge_domain_results
+/// and \ref merge_entry_point_results. The analyses are run in up to
+/// \p parallel_analyses processes; those that fail leave their assertions
+/// unknown.
+/// \param goto_model: the program analyzed, whose entry point is replaced
+///   temporarily for each of \p entry_points
+/// \param domains: the names of the domains, as passed to \p build_analyzer
+/// \param entry_points: functions to analyze the program from, called with
+///   non-deterministic arguments; none stands for the entry point of the
+///   program
+/// \param parallel_analyses: the number of processes to use
+/// \param build_analyzer: makes the abstract interpreter for a domain
+/// \param message_handler: for status and errors
+/// \param [out] results: one result per assertion, as for
+///   \ref static_verifier_results
+/// \return true if one of \p entry_points has no body
+bool combined_static_verifier_results(
+  goto_modelt &goto_model,
+  const std::vector<std::string> &domains,
+  std::vector<irep_idt> entry_points,
+  std::size_t parallel_analyses,
+  const std::function<std::unique_ptr<ai_baset>(
+    const std::string &domain,
+    const namespacet &ns)> &build_analyzer,
+  message_handlert &message_handler,
+  std::vector<static_verifier_resultt> &results);
+
+/// Report the results of \ref static_verifier_results in the format
+/// selected by \p options
+/// \return false
+bool static_verifier_report(
+  const goto_modelt &goto_model,
+  const std::vector<static_verifier_resultt> &results,
+  const optionst &options,
+  message_handlert &message_handler,
+  std::ostream &out);
+
 /// Use the information from the abstract interpreter to fill out the statuses
 /// of the passed properties
 /// \param abstract_goto_model The goto program to verify
@@ -24,6 +24,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <analyses/custom_bitvector_analysis.h>
 
+#include "sparse_taint_analysis.h"
 #include "taint_parser.h"
 
 class taint_analysist
@@ -39,7 +40,8 @@ public:
     const symbol_tablet &,
     goto_functionst &,
     bool show_full,
-    const optionalt<std::string> &json_file_name);
+    const optionalt<std::string> &json_file_name,
+    bool sparse);
 
 protected:
   messaget log;
@@ -224,7 +226,8 @@ bool taint_analysist::operator()(
   const symbol_tablet &symbol_table,
   goto_functionst &goto_functions,
   bool show_full,
-  const optionalt<std::string> &json_file_name)
+  const optionalt<std::string> &json_file_name,
+  bool sparse)
 {
   try
   {
@@ -304,7 +307,13 @@ bool taint_analysist::operator()(
     log.status() << "Data-flow analysis" << messaget::eom;
 
     custom_bitvector_analysist custom_bitvector_analysis;
-    custom_bitvector_analysis(goto_functions, ns);
+    sparse_taint_analysist sparse_taint_analysis(goto_functions, ns);
+    sparse = sparse && !show_full;
+
+    if(sparse)
+      sparse_taint_analysis();
+    else
+      custom_bitvector_analysis(goto_functions, ns);
 
     if(show_full)
     {
@@ -335,13 +344,21 @@ bool taint_analysist::operator()(
           continue;
         }
 
-        if(custom_bitvector_analysis[i_it].has_values.is_false())
-          continue;
+        if(sparse)
+        {
+          if(!sparse_taint_analysis.may_fail(i_it))
+            continue;
+        }
+        else
+        {
+          if(custom_bitvector_analysis[i_it].has_values.is_false())
+            continue;
 
-        exprt result =
-          custom_bitvector_analysis.eval(i_it->get_condition(), i_it);
-        if(simplify_expr(std::move(result), ns).is_true())
-          continue;
+          exprt result =
+            custom_bitvector_analysis.eval(i_it->get_condition(), i_it);
+          if(simplify_expr(std::move(result), ns).is_true())
+            continue;
+        }
 
         if(first)
         {
@@ -418,7 +435,8 @@ bool taint_analysis(
   const std::string &taint_file_name,
   message_handlert &message_handler,
   bool show_full,
-  const optionalt<std::string> &json_file_name)
+  const optionalt<std::string> &json_file_name,
+  bool sparse)
 {
   taint_analysist taint_analysis(message_handler);
   return taint_analysis(
@@ -426,5 +444,6 @@ bool taint_analysis(
     goto_model.symbol_table,
     goto_model.goto_functions,
     show_full,
-    json_file_name);
+    json_file_name,
+    sparse);
 }
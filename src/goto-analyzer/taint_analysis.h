@@ -22,6 +22,7 @@ bool taint_analysis(
   const std::string &taint_file_name,
   message_handlert &,
   bool show_full,
-  const optionalt<std::string> &json_output_file_name = {});
+  const optionalt<std::string> &json_output_file_name = {},
+  bool sparse = false);
 
 #endif // CPROVER_GOTO_ANALYZER_TAINT_ANALYSIS_H
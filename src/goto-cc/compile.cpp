@@ -13,16 +13,22 @@ Date: June 2006
 
 #include "compile.h"
 
+#include <algorithm>
+#include <cstdio>
 #include <cstring>
 #include <fstream>
 #include <iostream>
+#include <random>
+#include <sstream>
 
 #include <util/cmdline.h>
 #include <util/config.h>
 #include <util/file_util.h>
+#include <util/forked_workers.h>
 #include <util/get_base_name.h>
 #include <util/prefix.h>
 #include <util/run.h>
+#include <util/string_hash.h>
 #include <util/suffix.h>
 #include <util/symbol_table_builder.h>
 #include <util/tempdir.h>
@@ -31,10 +37,12 @@ Date: June 2006
 #include <util/version.h>
 
 #include <ansi-c/ansi_c_entry_point.h>
+#include <ansi-c/ansi_c_language.h>
 
 #include <goto-programs/goto_convert.h>
 #include <goto-programs/goto_convert_functions.h>
 #include <goto-programs/name_mangler.h>
+#include <goto-programs/read_bin_goto_object.h>
 #include <goto-programs/read_goto_binary.h>
 #include <goto-programs/validate_goto_model.h>
 #include <goto-programs/write_goto_binary.h>
@@ -42,6 +50,7 @@ Date: June 2006
 #include <langapi/language_file.h>
 #include <langapi/mode.h>
 
+#include <linking/linking.h>
 #include <linking/static_lifetime_init.h>
 
 #define DOTGRAPHSETTINGS  "color=black;" \
@@ -357,73 +366,166 @@ bool compilet::link()
 /// \return true on error, false otherwise
 bool compilet::compile()
 {
+  if(
+    parallel_sources > 1 && source_files.size() > 1 &&
+    (mode == COMPILE_ONLY || mode == ASSEMBLE_ONLY) &&
+    output_file_object.empty() && !echo_file_name &&
+    std::find(source_files.begin(), source_files.end(), "-") ==
+      source_files.end() &&
+    forked_workers_supported())
+  {
+    return compile_in_parallel();
+  }
+
   while(!source_files.empty())
   {
     std::string file_name=source_files.front();
     source_files.pop_front();
 
-    // Visual Studio always prints the name of the file it's doing
-    // onto stdout. The name of the directory is stripped.
-    if(echo_file_name)
-      std::cout << get_base_name(file_name, false) << '\n' << std::flush;
+    if(compile_source(file_name))
+      return true;
+  }
 
-    bool r=parse_source(file_name); // don't break the program!
+  return false;
+}
 
-    if(r)
+/// parses a source file, and writes an object file for it unless the symbols
+/// are to be kept for linking
+/// \return true on error, false otherwise
+bool compilet::compile_source(const std::string &file_name)
+{
+  // Visual Studio always prints the name of the file it's doing
+  // onto stdout. The name of the directory is stripped.
+  if(echo_file_name)
+    std::cout << get_base_name(file_name, false) << '\n' << std::flush;
+
+  bool r=parse_source(file_name); // don't break the program!
+
+  if(r)
+  {
+    const std::string &debug_outfile=
+      cmdline.get_value("print-rejected-preprocessed-source");
+    if(!debug_outfile.empty())
     {
-      const std::string &debug_outfile=
-        cmdline.get_value("print-rejected-preprocessed-source");
-      if(!debug_outfile.empty())
-      {
-        std::ifstream in(file_name, std::ios::binary);
-        std::ofstream out(debug_outfile, std::ios::binary);
-        out << in.rdbuf();
-        warning() << "Failed sources in " << debug_outfile << eom;
-      }
+      std::ifstream in(file_name, std::ios::binary);
+      std::ofstream out(debug_outfile, std::ios::binary);
+      out << in.rdbuf();
+      warning() << "Failed sources in " << debug_outfile << eom;
+    }
+
+    return true; // parser/typecheck error
+  }
+
+  if(mode==COMPILE_ONLY || mode==ASSEMBLE_ONLY)
+  {
+    // output an object file for every source file
+
+    // "compile" functions
+    convert_symbols(goto_model.goto_functions);
+
+    std::string cfn;
 
-      return true; // parser/typecheck error
+    if(output_file_object.empty())
+    {
+      const std::string file_name_with_obj_ext =
+        get_base_name(file_name, true) + "." + object_file_extension;
+
+      if(!output_directory_object.empty())
+        cfn = concat_dir_file(output_directory_object, file_name_with_obj_ext);
+      else
+        cfn = file_name_with_obj_ext;
     }
+    else
+      cfn = output_file_object;
 
-    if(mode==COMPILE_ONLY || mode==ASSEMBLE_ONLY)
+    if(keep_file_local)
     {
-      // output an object file for every source file
+      function_name_manglert<file_name_manglert> mangler(
+        get_message_handler(), goto_model, file_local_mangle_suffix);
+      mangler.mangle();
+    }
+
+    if(write_bin_object_file(cfn, goto_model))
+      return true;
 
-      // "compile" functions
-      convert_symbols(goto_model.goto_functions);
+    if(add_written_cprover_symbols(goto_model.symbol_table))
+      return true;
 
-      std::string cfn;
+    goto_model.clear(); // clean symbol table for next source file.
+  }
 
-      if(output_file_object.empty())
-      {
-        const std::string file_name_with_obj_ext =
-          get_base_name(file_name, true) + "." + object_file_extension;
+  return false;
+}
+
+/// compiles the source files to object files using \ref parallel_sources
+/// forked processes, each of which works on every n-th file. The
+/// `__CPROVER` macros each process wrote are sent back as a goto binary.
+/// \return true on error, false otherwise
+bool compilet::compile_in_parallel()
+{
+  const std::vector<std::string> files(
+    source_files.begin(), source_files.end());
+  source_files.clear();
 
-        if(!output_directory_object.empty())
-          cfn = concat_dir_file(output_directory_object, file_name_with_obj_ext);
-        else
-          cfn = file_name_with_obj_ext;
+  const std::size_t number_of_workers =
+    std::min<std::size_t>(parallel_sources, files.size());
+
+  const auto results = run_forked_workers(
+    number_of_workers, [&](std::size_t worker) -> std::string {
+      const unsigned warnings_before =
+        get_message_handler().get_message_count(messaget::M_WARNING);
+
+      for(std::size_t i = worker; i < files.size(); i += number_of_workers)
+      {
+        if(compile_source(files[i]))
+          return "";
       }
-      else
-        cfn = output_file_object;
 
-      if(keep_file_local)
+      // warnings are not counted by the parent
+      if(
+        warning_is_fatal &&
+        get_message_handler().get_message_count(messaget::M_WARNING) !=
+          warnings_before)
       {
-        function_name_manglert<file_name_manglert> mangler(
-          get_message_handler(), goto_model, file_local_mangle_suffix);
-        mangler.mangle();
+        return "";
       }
 
-      if(write_bin_object_file(cfn, goto_model))
-        return true;
+      symbol_tablet macros;
+      for(const auto &macro : written_macros)
+        macros.add(macro.second);
 
-      if(add_written_cprover_symbols(goto_model.symbol_table))
-        return true;
+      std::ostringstream result;
+      write_goto_binary(result, macros, goto_functionst());
+      return result.str();
+    });
 
-      goto_model.clear(); // clean symbol table for next source file.
+  bool error = false;
+
+  for(const auto &result : results)
+  {
+    if(!result.has_value() || result->empty())
+    {
+      error = true;
+      continue;
     }
+
+    std::istringstream in(*result);
+    goto_modelt macros;
+    if(read_bin_goto_object(
+         in,
+         "",
+         macros.symbol_table,
+         macros.goto_functions,
+         get_message_handler()) ||
+       add_written_cprover_symbols(macros.symbol_table))
+    {
+      error = true;
+    }
+    else
+      wrote_object = true;
   }
 
-  return false;
+  return error;
 }
 
 /// parses a source file (low-level parsing)
@@ -593,10 +695,171 @@ bool compilet::write_bin_object_file(
   return false;
 }
 
+/// Computes the key of the cache entry of a translation unit, which covers
+/// everything that parsing and type checking the preprocessed text depend on
+/// \param file_name: name of the source file
+/// \param preprocessed: preprocessed text of the source file
+/// \return file name of the cache entry
+std::string compilet::translation_unit_key(
+  const std::string &file_name,
+  const std::string &preprocessed) const
+{
+  std::ostringstream key;
+  key << CBMC_VERSION << '\n'
+      << GOTO_BINARY_VERSION << '\n'
+      << file_name << '\n'
+      << keep_file_local << '\n'
+      << config.ansi_c.fingerprint() << preprocessed;
+
+  // Two hashes of different construction make accidental collisions of keys
+  // unlikely enough
+  const std::string key_string = key.str();
+  std::ostringstream result;
+  result << std::hex << hash_string(key_string) << '-'
+         << std::hash<std::string>{}(key_string) << ".gb";
+  return result.str();
+}
+
+/// parses and type checks a C source file using the translation unit cache:
+/// the file is preprocessed, and the symbols that parsing and type checking
+/// the preprocessed text yield are read from the cache if it has them, and
+/// are added to the cache otherwise
+/// \return true on error, false otherwise, or an empty optional if the file
+///   is not to be parsed via the cache
+optionalt<bool> compilet::parse_source_with_cache(const std::string &file_name)
+{
+  std::unique_ptr<languaget> languagep;
+
+  if(!override_language.empty())
+  {
+    if(override_language == "c++" || override_language == "c++-header")
+      return {};
+    languagep = get_language_from_mode(ID_C);
+  }
+  else
+    languagep = get_language_from_filename(file_name);
+
+  ansi_c_languaget *ansi_c_language =
+    dynamic_cast<ansi_c_languaget *>(languagep.get());
+  if(ansi_c_language == nullptr)
+    return {};
+
+#ifdef _MSC_VER
+  std::ifstream infile(widen(file_name));
+#else
+  std::ifstream infile(file_name);
+#endif
+
+  if(!infile)
+    return {};
+
+  ansi_c_language->set_message_handler(get_message_handler());
+
+  std::ostringstream preprocessed;
+  if(ansi_c_language->preprocess(infile, file_name, preprocessed))
+  {
+    error() << "PARSING ERROR" << eom;
+    return true;
+  }
+
+  const std::string cache_file = concat_dir_file(
+    translation_unit_cache,
+    translation_unit_key(file_name, preprocessed.str()));
+
+  symbol_tablet tu_symbol_table;
+  bool hit = false;
+
+  {
+    std::ifstream in(cache_file, std::ios::binary);
+    goto_functionst goto_functions;
+    null_message_handlert null_message_handler;
+    hit =
+      in && !read_bin_goto_object(
+              in,
+              cache_file,
+              tu_symbol_table,
+              goto_functions,
+              null_message_handler);
+  }
+
+  if(hit)
+    statistics() << "Using cached translation unit: " << file_name << eom;
+  else
+  {
+    tu_symbol_table.clear();
+
+    statistics() << "Parsing: " << file_name << eom;
+
+    language_filest language_files;
+    language_files.set_message_handler(get_message_handler());
+    language_filet &lf = language_files.add_file(file_name);
+    lf.language = std::move(languagep);
+
+    std::istringstream in(preprocessed.str());
+    if(ansi_c_language->parse_preprocessed(in, file_name))
+    {
+      error() << "PARSING ERROR" << eom;
+      return true;
+    }
+
+    lf.get_modules();
+
+    const unsigned warnings_before =
+      get_message_handler().get_message_count(messaget::M_WARNING);
+
+    if(
+      language_files.typecheck(tu_symbol_table, keep_file_local) ||
+      language_files.final(tu_symbol_table))
+    {
+      error() << "CONVERSION ERROR" << eom;
+      return true;
+    }
+
+    // Warnings would not be repeated when using the entry, hence translation
+    // units that produce any are not cached. Entries are written to a file of
+    // a unique name first, such that concurrent runs never read a partially
+    // written entry.
+    if(
+      get_message_handler().get_message_count(messaget::M_WARNING) ==
+      warnings_before)
+    {
+      create_directory(translation_unit_cache);
+      const std::string temporary =
+        cache_file + "." + std::to_string(std::random_device{}()) + ".tmp";
+      bool written;
+      {
+        std::ofstream out(temporary, std::ios::binary);
+        written = out && !write_goto_binary(
+                           out, tu_symbol_table, goto_functionst()) &&
+                  out.flush();
+      }
+      if(!written || std::rename(temporary.c_str(), cache_file.c_str()) != 0)
+        std::remove(temporary.c_str());
+    }
+  }
+
+  if(linking(goto_model.symbol_table, tu_symbol_table, get_message_handler()))
+  {
+    error() << "CONVERSION ERROR" << eom;
+    return true;
+  }
+
+  return false;
+}
+
 /// parses a source file
 /// \return true on error, false otherwise
 bool compilet::parse_source(const std::string &file_name)
 {
+  if(
+    !translation_unit_cache.empty() && mode != PREPROCESS_ONLY &&
+    file_name != "-")
+  {
+    const auto result = parse_source_with_cache(file_name);
+    if(result.has_value())
+      return *result;
+  }
+
   language_filest language_files;
   language_files.set_message_handler(get_message_handler());
 
@@ -16,6 +16,7 @@ Date: June 2006
 
 #include <util/cmdline.h>
 #include <util/message.h>
+#include <util/optional.h>
 #include <util/rename_symbol.h>
 
 #include <goto-programs/goto_model.h>
@@ -36,6 +37,14 @@ public:
   std::string override_language;
   bool validate_goto_model = false;
 
+  /// Number of processes source files are compiled in when writing one
+  /// object file for each of them
+  std::size_t parallel_sources = 1;
+
+  /// Directory of the cache of parsed and type-checked C translation units,
+  /// or empty if no cache is to be used
+  std::string translation_unit_cache;
+
   enum { PREPROCESS_ONLY, // gcc -E
          COMPILE_ONLY, // gcc -c
          ASSEMBLE_ONLY, // gcc -S
@@ -72,6 +81,7 @@ public:
   bool link();
 
   bool parse_source(const std::string &);
+  bool compile_source(const std::string &);
 
   bool write_bin_object_file(const std::string &, const goto_modelt &);
 
@@ -106,6 +116,13 @@ protected:
 
   void add_compiler_specific_defines() const;
 
+  bool compile_in_parallel();
+
+  optionalt<bool> parse_source_with_cache(const std::string &);
+  std::string translation_unit_key(
+    const std::string &file_name,
+    const std::string &preprocessed) const;
+
   void convert_symbols(goto_functionst &dest);
 
   bool add_written_cprover_symbols(const symbol_tablet &symbol_table);
@@ -28,6 +28,8 @@ const char *goto_cc_options_with_separated_argument[]=
   "--native-linker",
   "--print-rejected-preprocessed-source",
   "--mangle-suffix",
+  "--parallel-sources",
+  "--translation-unit-cache",
   nullptr
 };
 
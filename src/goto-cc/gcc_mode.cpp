@@ -40,6 +40,7 @@ Author: CM Wintersteiger, 2006
 #include <util/prefix.h>
 #include <util/replace_symbol.h>
 #include <util/run.h>
+#include <util/string2int.h>
 #include <util/suffix.h>
 #include <util/tempdir.h>
 #include <util/tempfile.h>
@@ -426,6 +427,18 @@ int gcc_modet::doit()
   // model validation
   compiler.validate_goto_model = cmdline.isset("validate-goto-model");
 
+  if(cmdline.isset("parallel-sources"))
+  {
+    compiler.parallel_sources =
+      safe_string2unsigned(cmdline.get_value("parallel-sources"));
+  }
+
+  if(cmdline.isset("translation-unit-cache"))
+  {
+    compiler.translation_unit_cache =
+      cmdline.get_value("translation-unit-cache");
+  }
+
   // determine actions to be undertaken
   if(cmdline.isset('S'))
     compiler.mode=compilet::ASSEMBLE_ONLY;
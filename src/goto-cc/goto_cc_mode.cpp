@@ -66,6 +66,11 @@ void goto_cc_modet::help()
   " --native-assembler cmd      command to invoke as assembler (goto-as only)\n"
   " --print-rejected-preprocessed-source file\n"
   "                             copy failing (preprocessed) source to file\n"
+  " --parallel-sources n        with -c, compile the source files in n\n"
+  "                             processes\n"
+  " --translation-unit-cache dir reuse the results of parsing C sources\n"
+  "                             whose preprocessed text is unchanged, which\n"
+  "                             are kept in dir\n"
   "\n";
   // clang-format on
 }
@@ -14,12 +14,15 @@ Author: Daniel Kroening, Peter Schrammel
 #include <fstream>
 #include <iostream>
 
+#include <goto-programs/binary_goto_trace.h>
 #include <goto-programs/graphml_witness.h>
 #include <goto-programs/json_goto_trace.h>
 #include <goto-programs/xml_goto_trace.h>
 
 #include <goto-symex/build_goto_trace.h>
 #include <goto-symex/memory_model_pso.h>
+#include <goto-symex/propagate_assignments.h>
+#include <goto-symex/relevant_symbols.h>
 #include <goto-symex/slice.h>
 #include <goto-symex/symex_target_equation.h>
 
@@ -27,6 +30,7 @@ Author: Daniel Kroening, Peter Schrammel
 
 #include <solvers/decision_procedure.h>
 
+#include <util/exception_utils.h>
 #include <util/make_unique.h>
 #include <util/ui_message.h>
 
@@ -62,6 +66,31 @@ ssa_step_matches_failing_property(const irep_idt &property_id)
   };
 }
 
+trace_step_predicatet trace_steps_needing_values(
+  const optionst &options,
+  const ui_message_handlert &ui_message_handler)
+{
+  // witnesses, binary traces, structured output and trace validation
+  // consume all the values of the trace
+  if(
+    ui_message_handler.get_ui() != ui_message_handlert::uit::PLAIN ||
+    options.is_set("graphml-witness") || options.is_set("binary-trace") ||
+    options.get_bool_option("validate-trace"))
+  {
+    return {};
+  }
+
+  if(options.get_bool_option("stack-trace"))
+  {
+    return [](const goto_trace_stept &step) {
+      return step.is_function_call();
+    };
+  }
+
+  // the plain text traces do not show hidden steps
+  return [](const goto_trace_stept &step) { return !step.hidden; };
+}
+
 void output_error_trace(
   const goto_tracet &goto_trace,
   const namespacet &ns,
@@ -147,6 +176,18 @@ void output_graphml(
   }
 }
 
+void output_binary_trace(
+  const goto_tracet &goto_trace,
+  const optionst &options)
+{
+  const std::string filename = options.get_option("binary-trace");
+  if(filename.empty())
+    return;
+
+  if(write_binary_goto_trace(goto_trace, filename))
+    throw system_exceptiont("failed to write binary trace to " + filename);
+}
+
 void convert_symex_target_equation(
   symex_target_equationt &equation,
   decision_proceduret &decision_procedure,
@@ -163,9 +204,13 @@ std::unique_ptr<memory_model_baset>
 get_memory_model(const optionst &options, const namespacet &ns)
 {
   const std::string mm = options.get_option("mm");
+  const unsigned context_bound =
+    options.get_unsigned_int_option("context-bound");
 
   if(mm.empty() || mm == "sc")
-    return util_make_unique<memory_model_sct>(ns);
+    return util_make_unique<memory_model_sct>(ns, context_bound);
+  else if(context_bound != 0)
+    throw "context bounding is only supported for memory model sc";
   else if(mm == "tso")
     return util_make_unique<memory_model_tsot>(ns);
   else if(mm == "pso")
@@ -195,6 +240,21 @@ void setup_symex(
   symex.unwindset.parse_unwindset(options.get_option("unwindset"));
 }
 
+std::shared_ptr<const std::unordered_set<irep_idt>> get_relevant_symbols(
+  const optionst &options,
+  const abstract_goto_modelt &goto_model)
+{
+  if(
+    !options.get_bool_option("symex-slice") ||
+    options.get_bool_option("symex-driven-lazy-loading"))
+  {
+    return nullptr;
+  }
+
+  return std::make_shared<const std::unordered_set<irep_idt>>(
+    compute_relevant_symbols(goto_model.get_goto_functions()));
+}
+
 void slice(
   symex_bmct &symex,
   symex_target_equationt &symex_target_equation,
@@ -303,15 +363,39 @@ void update_status_of_unknown_properties(
   }
 }
 
+void update_status_of_not_checked_properties_to_unknown(
+  propertiest &properties,
+  std::unordered_set<irep_idt> &updated_properties)
+{
+  for(auto &property_pair : properties)
+  {
+    if(property_pair.second.status == property_statust::NOT_CHECKED)
+    {
+      property_pair.second.status = property_statust::UNKNOWN;
+      updated_properties.insert(property_pair.first);
+    }
+  }
+}
+
 void output_coverage_report(
   const std::string &cov_out,
   const abstract_goto_modelt &goto_model,
   const symex_bmct &symex,
   ui_message_handlert &ui_message_handler)
+{
+  output_coverage_report(
+    cov_out, goto_model, symex.get_coverage(), ui_message_handler);
+}
+
+void output_coverage_report(
+  const std::string &cov_out,
+  const abstract_goto_modelt &goto_model,
+  const symex_coveraget &coverage,
+  ui_message_handlert &ui_message_handler)
 {
   if(
     !cov_out.empty() &&
-    symex.output_coverage_report(goto_model.get_goto_functions(), cov_out))
+    coverage.generate_report(goto_model.get_goto_functions(), cov_out))
   {
     messaget log(ui_message_handler);
     log.error() << "Failed to write symex coverage report to '" << cov_out
@@ -332,6 +416,7 @@ void postprocess_equation(
     std::unique_ptr<memory_model_baset> memory_model =
       get_memory_model(options, ns);
     memory_model->set_message_handler(ui_message_handler);
+    memory_model->set_lazy(options.get_bool_option("lazy-memory-model"));
     (*memory_model)(equation);
   }
 
@@ -341,6 +426,21 @@ void postprocess_equation(
 
   slice(symex, equation, ns, options, ui_message_handler);
 
+  if(options.get_bool_option("propagate-assignments"))
+  {
+    if(equation.has_threads())
+    {
+      log.statistics() << "no propagation of assignments due to threads"
+                       << messaget::eom;
+    }
+    else
+    {
+      const std::size_t changed_steps = propagate_assignments(equation, ns);
+      log.statistics() << "propagation of assignments changed "
+                       << changed_steps << " steps" << messaget::eom;
+    }
+  }
+
   if(options.get_bool_option("validate-ssa-equation"))
   {
     symex.validate(validation_modet::INVARIANT);
@@ -30,6 +30,7 @@ class message_handlert;
 class namespacet;
 class optionst;
 class symex_bmct;
+class symex_coveraget;
 class symex_target_equationt;
 struct trace_optionst;
 class ui_message_handlert;
@@ -54,6 +55,12 @@ void build_error_trace(
   const decision_proceduret &,
   ui_message_handlert &);
 
+/// Returns the predicate selecting the steps of an error trace whose values
+/// are needed for the trace output requested by \p options, or an empty
+/// predicate if the values of all steps are needed.
+trace_step_predicatet
+trace_steps_needing_values(const optionst &, const ui_message_handlert &);
+
 void output_error_trace(
   const goto_tracet &,
   const namespacet &,
@@ -66,6 +73,10 @@ void output_graphml(
   const namespacet &,
   const optionst &);
 
+/// Writes the trace to the file given by the "binary-trace" option, if set,
+/// in the format of \ref binary_goto_trace_writert
+void output_binary_trace(const goto_tracet &, const optionst &);
+
 std::unique_ptr<memory_model_baset>
 get_memory_model(const optionst &options, const namespacet &);
 
@@ -75,6 +86,12 @@ void setup_symex(
   const optionst &,
   ui_message_handlert &);
 
+/// \return the symbols relevant to the properties of \p goto_model if
+///   the "symex-slice" option is set and all functions are available,
+///   otherwise nullptr
+std::shared_ptr<const std::unordered_set<irep_idt>>
+get_relevant_symbols(const optionst &, const abstract_goto_modelt &);
+
 void slice(
   symex_bmct &,
   symex_target_equationt &symex_target_equation,
@@ -106,6 +123,14 @@ void output_coverage_report(
   const symex_bmct &symex,
   ui_message_handlert &ui_message_handler);
 
+/// Output a coverage report of the executions recorded in \p coverage, for
+/// example merged from several symex runs, if \p cov_out is non-empty.
+void output_coverage_report(
+  const std::string &cov_out,
+  const abstract_goto_modelt &goto_model,
+  const symex_coveraget &coverage,
+  ui_message_handlert &ui_message_handler);
+
 /// Sets property status to PASS for properties whose
 /// conditions are constant true in the \p equation.
 /// \param [in,out] properties: The status is updated in this data structure
@@ -137,6 +162,15 @@ void update_status_of_unknown_properties(
   propertiest &properties,
   std::unordered_set<irep_idt> &updated_properties);
 
+/// Sets the property status of NOT_CHECKED properties to UNKNOWN, for when
+/// symex has abandoned paths on which they may fail.
+/// \param [in,out] properties: The status is updated in this data structure
+/// \param [in,out] updated_properties: The set of property IDs of
+///   updated properties
+void update_status_of_not_checked_properties_to_unknown(
+  propertiest &properties,
+  std::unordered_set<irep_idt> &updated_properties);
+
 /// Converts the equation and sets up the property decider,
 /// but does not call solve.
 /// \param [in,out] properties: Sets the status of properties to be checked to
@@ -177,25 +211,47 @@ void run_property_decider(
   "(show-vcc)" \
   "(show-goto-symex-steps)" \
   "(slice-formula)" \
+  "(propagate-assignments)" \
+  "(omit-constant-assignments)" \
+  "(symex-slice)" \
+  "(stream-equation)" \
+  "(cube-depth):" \
+  "(sat-hot-spots):" \
   "(unwinding-assertions)" \
   "(no-unwinding-assertions)" \
   "(no-pretty-names)" \
   "(no-self-loops-to-assumptions)" \
   "(partial-loops)" \
   "(paths):" \
+  "(paths-merge-regions):" \
+  "(concolic-seed):" \
   "(show-symex-strategies)" \
   "(depth):" \
   "(unwind):" \
+  "(unwind-max):" \
   "(max-field-sensitivity-array-size):" \
   "(no-array-field-sensitivity)" \
   "(graphml-witness):" \
+  "(binary-trace):" \
   "(unwindset):" \
   "(symex-complexity-limit):" \
-  "(symex-complexity-failed-child-loops-limit):"
+  "(symex-complexity-failed-child-loops-limit):" \
+  "(symex-complexity-cost-limit):" \
+  "(simplify-cache-size):" \
+  "(symex-cache-dereferences)" \
+  "(allocation-site-bound):" \
+  "(symex-guard-bdd-nodes):" \
+  "(memory-limit):"
 
 #define HELP_BMC \
   " --paths [strategy]           explore paths one at a time\n" \
   " --show-symex-strategies      list strategies for use with --paths\n" \
+  " --paths-merge-regions n      with --paths, merge the branches of\n" \
+  "                              single-entry, single-exit regions of at\n" \
+  "                              most n instructions\n" \
+  " --concolic-seed file         branch decisions (0 or 1 for each\n" \
+  "                              conditional goto reached) of a concrete\n" \
+  "                              execution, for use with --paths concolic\n" \
   " --show-goto-symex-steps      show which steps symex travels, includes " \
   "                              diagnostic information\n" \
   " --program-only               only show program expression\n" \
@@ -211,10 +267,29 @@ void run_property_decider(
   "                              equivalent to setting the maximum field \n" \
   "                              sensitivity size for arrays to 0\n" \
   " --unwind nr                  unwind nr times\n" \
+  " --unwind-max nr              with --paths, unwind incrementally: paths\n" \
+  "                              that exceed the bound are continued with\n" \
+  "                              the bound raised by one, up to nr\n" \
   " --unwindset L:B,...          unwind loop L with a bound of B\n" \
   "                              (use --show-loops to get the loop IDs)\n" \
   " --show-vcc                   show the verification conditions\n" \
   " --slice-formula              remove assignments unrelated to property\n" \
+  " --propagate-assignments      propagate constants and copies in the\n" \
+  "                              program expression and merge equal terms\n" \
+  "                              before solving\n" \
+  " --omit-constant-assignments  do not add assignments of constants to the\n" \
+  "                              program expression, and thus not show them\n" \
+  "                              in traces\n" \
+  " --symex-slice                do not execute assignments to variables\n" \
+  "                              that cannot affect any property\n" \
+  " --stream-equation            pass assignments to the solver while the\n" \
+  "                              program expression is built instead of\n" \
+  "                              keeping them in memory\n" \
+  " --cube-depth n               solve the formula in 2^n parts, split on\n" \
+  "                              the conditions of the first n branches\n" \
+  " --sat-hot-spots n            after solving, show the symbols encoded by\n" \
+  "                              the n most active variables of the SAT\n" \
+  "                              solver, and where they are assigned\n" \
   " --unwinding-assertions       generate unwinding assertions (cannot be\n" \
   "                              used with --cover or --partial-loops)\n" \
   " --partial-loops              permit paths with partial loops\n" \
@@ -230,6 +305,26 @@ void run_property_decider(
   "                              iteration are allowed to fail due to\n" \
   "                              complexity violations before the loop\n" \
   "                              gets blacklisted\n" \
+  " --symex-complexity-cost-limit N\n" \
+  "                              abandon paths whose assignments are\n" \
+  "                              estimated to yield more than N gates,\n" \
+  "                              leaving unchecked properties unknown\n" \
+  " --simplify-cache-size N      cache up to N simplification results\n" \
+  "                              during symbolic execution\n" \
+  " --symex-cache-dereferences   reuse the case splits of dereferenced\n" \
+  "                              pointers and share them through symbols\n" \
+  " --allocation-site-bound N    allocate at most N objects per allocation\n" \
+  "                              site, further allocations share a summary\n" \
+  "                              object that is updated weakly\n" \
+  " --symex-guard-bdd-nodes N    keep path conditions as BDDs as long as\n" \
+  "                              they have at most N nodes\n" \
+  " --memory-limit M             limit the virtual address space to M MiB,\n" \
+  "                              also of forked workers and SMT solvers;\n" \
+  "                              symex abandons all remaining paths once\n" \
+  "                              half of it is allocated and the SAT solver\n" \
+  "                              gives up beyond 90%, leaving inconclusive\n" \
+  "                              results\n" \
+  " --binary-trace file          write the trace in binary format to file\n" \
   " --graphml-witness filename   write the witness in GraphML format to filename\n" // NOLINT(*)
 // clang-format on
 
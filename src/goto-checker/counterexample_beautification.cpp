@@ -12,10 +12,12 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "counterexample_beautification.h"
 
 #include <util/arith_tools.h>
+#include <util/options.h>
 #include <util/std_expr.h>
 #include <util/symbol.h>
 #include <util/threeval.h>
 
+#include <solvers/prop/literal_expr.h>
 #include <solvers/prop/prop_minimize.h>
 
 counterexample_beautificationt::counterexample_beautificationt(
@@ -24,6 +26,41 @@ counterexample_beautificationt::counterexample_beautificationt(
 {
 }
 
+counterexample_beautificationt::counterexample_beautificationt(
+  const optionst &options,
+  message_handlert &message_handler)
+  : incremental(options.get_bool_option("beautify-incremental")),
+    core_guided(options.get_bool_option("beautify-core-guided")),
+    time_limit(options.get_unsigned_int_option("beautify-time-limit")),
+    log(message_handler)
+{
+}
+
+void counterexample_beautificationt::setup(prop_minimizet &prop_minimize) const
+{
+  prop_minimize.set_incremental(incremental);
+  prop_minimize.set_core_guided(core_guided);
+
+  if(time_limit != 0)
+    prop_minimize.set_deadline(deadline);
+}
+
+void counterexample_beautificationt::report(
+  const prop_minimizet &prop_minimize)
+{
+  log.statistics() << "Satisfied " << prop_minimize.number_satisfied() << " of "
+                   << prop_minimize.size() << " objectives in "
+                   << prop_minimize.iterations() << " iterations"
+                   << messaget::eom;
+
+  if(prop_minimize.timed_out())
+  {
+    log.warning() << "Beautification stopped after " << time_limit
+                  << "s with a partially minimized counterexample"
+                  << messaget::eom;
+  }
+}
+
 void counterexample_beautificationt::get_minimization_list(
   prop_convt &prop_conv,
   const symex_target_equationt &equation,
@@ -97,8 +134,14 @@ operator()(boolbvt &boolbv, const symex_target_equationt &equation)
 
   failed = get_failed_property(boolbv, equation);
 
+  deadline =
+    std::chrono::steady_clock::now() + std::chrono::seconds(time_limit);
+
   // lock the failed assertion
-  boolbv.set_to(failed->cond_handle, false);
+  if(incremental)
+    boolbv.push({literal_exprt(!boolbv.convert(failed->cond_handle))});
+  else
+    boolbv.set_to(failed->cond_handle, false);
 
   {
     log.status() << "Beautifying counterexample (guards)" << messaget::eom;
@@ -128,12 +171,25 @@ operator()(boolbvt &boolbv, const symex_target_equationt &equation)
 
     // give to propositional minimizer
     prop_minimizet prop_minimize{boolbv, log.get_message_handler()};
+    setup(prop_minimize);
 
     for(const auto &g : guard_count)
       prop_minimize.objective(g.first, g.second);
 
     // minimize
     prop_minimize();
+    report(prop_minimize);
+
+    if(prop_minimize.timed_out())
+    {
+      // drop the assumptions on the failed assertion and the guards
+      if(incremental)
+      {
+        boolbv.pop();
+        boolbv.pop();
+      }
+      return;
+    }
   }
 
   {
@@ -145,7 +201,21 @@ operator()(boolbvt &boolbv, const symex_target_equationt &equation)
     get_minimization_list(boolbv, equation, minimization_list);
 
     // minimize
+    prop_minimizet prop_minimize{boolbv, log.get_message_handler()};
+    setup(prop_minimize);
+
     bv_minimizet bv_minimize(boolbv, log.get_message_handler());
-    bv_minimize(minimization_list);
+    bv_minimize.add_objectives(prop_minimize, minimization_list);
+
+    prop_minimize();
+    report(prop_minimize);
+  }
+
+  // the model stays, but the formula is as before
+  if(incremental)
+  {
+    boolbv.pop();
+    boolbv.pop();
+    boolbv.pop();
   }
 }
@@ -12,16 +12,26 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_GOTO_CHECKER_COUNTEREXAMPLE_BEAUTIFICATION_H
 #define CPROVER_GOTO_CHECKER_COUNTEREXAMPLE_BEAUTIFICATION_H
 
+#include <chrono>
+
 #include <util/namespace.h>
 
 #include <goto-symex/symex_target_equation.h>
 
 #include <solvers/flattening/bv_minimize.h>
 
+class optionst;
+
 class counterexample_beautificationt
 {
 public:
   explicit counterexample_beautificationt(message_handlert &message_handler);
+
+  /// Takes the `beautify-incremental`, `beautify-core-guided` and
+  /// `beautify-time-limit` settings from \p options
+  counterexample_beautificationt(
+    const optionst &options,
+    message_handlert &message_handler);
   virtual ~counterexample_beautificationt() = default;
 
   void operator()(boolbvt &boolbv, const symex_target_equationt &equation);
@@ -34,6 +44,12 @@ protected:
 
   void minimize(const exprt &expr, class prop_minimizet &prop_minimize);
 
+  /// Apply the configuration to \p prop_minimize
+  void setup(class prop_minimizet &prop_minimize) const;
+
+  /// Report how far \p prop_minimize got
+  void report(const class prop_minimizet &prop_minimize);
+
   symex_target_equationt::SSA_stepst::const_iterator get_failed_property(
     const prop_convt &prop_conv,
     const symex_target_equationt &equation);
@@ -41,6 +57,17 @@ protected:
   // the failed property
   symex_target_equationt::SSA_stepst::const_iterator failed;
 
+  /// Use assumptions instead of clauses, leaving the formula unchanged
+  bool incremental = false;
+
+  /// Start each weight from the conflicts reported by the solver
+  bool core_guided = false;
+
+  /// Time budget in seconds, 0 for no limit
+  std::size_t time_limit = 0;
+
+  std::chrono::steady_clock::time_point deadline;
+
   messaget log;
 };
 
@@ -48,6 +48,15 @@ public:
       ++iterations;
     }
 
+    if(options.get_bool_option("cover-minimize"))
+    {
+      const std::size_t number_of_traces = traces.size();
+      traces.minimize();
+      log.status() << "Minimized test suite from " << number_of_traces
+                   << " to " << traces.size() << " tests"
+                   << messaget::eom;
+    }
+
     return determine_result(properties);
   }
 
@@ -11,6 +11,8 @@ Author: Peter Schrammel
 
 #include "goto_symex_fault_localizer.h"
 
+#include <util/exception_utils.h>
+
 goto_symex_fault_localizert::goto_symex_fault_localizert(
   const optionst &options,
   ui_message_handlert &ui_message_handler,
@@ -37,8 +39,25 @@ operator()(const irep_idt &failed_property_id)
     log.status() << "Localizing fault" << messaget::eom;
 
     // pick localization method
-    //  if(options.get_option("localize-faults-method")=="TBD")
-    localize_linear(failed_step, localization_points);
+    const std::string &method = options.get_option("localize-faults-method");
+    if(!method.empty() && method != "linear" && method != "core")
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "unknown fault localization method " + method,
+        "--localize-faults-method",
+        "linear or core");
+    }
+
+    const auto conflict_provider =
+      dynamic_cast<const conflict_providert *>(&solver);
+
+    if(
+      method != "core" || conflict_provider == nullptr ||
+      !localize_core_guided(
+        failed_step, localization_points, *conflict_provider))
+    {
+      localize_linear(failed_step, localization_points);
+    }
   }
 
   return fault_location;
@@ -135,3 +154,104 @@ void goto_symex_fault_localizert::localize_linear(
   // clear assumptions
   solver.pop();
 }
+
+bool goto_symex_fault_localizert::localize_core_guided(
+  const SSA_stept &failed_step,
+  const localization_pointst &localization_points,
+  const conflict_providert &conflict_provider)
+{
+  messaget log(ui_message_handler);
+
+  // block all points: the failure must happen without executing them
+  std::map<exprt, localization_pointst::const_iterator> blocked;
+  for(auto it = localization_points.begin(); it != localization_points.end();
+      ++it)
+  {
+    blocked.emplace(solver.handle(not_exprt(it->first)), it);
+  }
+
+  const exprt failed_lock = solver.handle(not_exprt(failed_step.cond_handle));
+
+  const auto solve = [&](const std::vector<exprt> &blocking) {
+    std::vector<exprt> assumptions = blocking;
+    assumptions.push_back(failed_lock);
+    solver.push(assumptions);
+    const decision_proceduret::resultt result = solver();
+    solver.pop();
+    return result;
+  };
+
+  const auto get_core = [&](const std::vector<exprt> &blocking) {
+    std::vector<exprt> core;
+    for(const auto &b : blocking)
+    {
+      if(conflict_provider.is_in_conflict(b))
+        core.push_back(b);
+    }
+    return core;
+  };
+
+  std::size_t solver_calls = 0;
+  std::size_t number_of_cores = 0;
+
+  while(true)
+  {
+    std::vector<exprt> blocking;
+    blocking.reserve(blocked.size());
+    for(const auto &b : blocked)
+      blocking.push_back(b.first);
+
+    ++solver_calls;
+    decision_proceduret::resultt result = solve(blocking);
+
+    if(result == decision_proceduret::resultt::D_ERROR)
+      return number_of_cores != 0;
+
+    if(result == decision_proceduret::resultt::D_SATISFIABLE)
+    {
+      // the points executed in the failing run are confirmed
+      for(const auto &l : localization_points)
+      {
+        if(solver.get(l.first).is_true())
+          l.second->second++;
+      }
+      break;
+    }
+
+    std::vector<exprt> core = get_core(blocking);
+
+    // the core of the solver need not be minimal, solving on it alone
+    // usually shrinks it
+    if(core.size() > 1)
+    {
+      ++solver_calls;
+      if(solve(core) == decision_proceduret::resultt::D_UNSATISFIABLE)
+      {
+        std::vector<exprt> smaller_core = get_core(core);
+        if(!smaller_core.empty())
+          core.swap(smaller_core);
+      }
+    }
+
+    // without any point in the core the failure is impossible anyway,
+    // or the solver does not provide cores
+    if(core.empty())
+      return number_of_cores != 0;
+
+    // one of the points in the core must be executed for the failure
+    ++number_of_cores;
+    for(const auto &b : core)
+    {
+      const auto blocked_it = blocked.find(b);
+      const auto &score_it = blocked_it->second->second;
+      score_it->second++;
+      blocked.erase(blocked_it);
+    }
+  }
+
+  log.statistics() << "Fault localization found " << number_of_cores
+                   << " conflict cores in " << solver_calls << " solver calls"
+                   << messaget::eom;
+
+  return true;
+}
@@ -18,6 +18,7 @@ Author: Peter Schrammel
 
 #include <goto-symex/symex_target_equation.h>
 
+#include <solvers/conflict_provider.h>
 #include <solvers/stack_decision_procedure.h>
 
 #include "fault_localization_provider.h"
@@ -63,6 +64,15 @@ protected:
   // localization method: flip each point
   void
   localize_linear(const SSA_stept &failed_step, const localization_pointst &);
+
+  /// Localization method that blocks all points and relaxes the ones in the
+  /// conflict cores reported by \p conflict_provider, until the failure is
+  /// possible again. This takes one solver call per core rather than two per
+  /// point. Returns false if the solver did not provide a core.
+  bool localize_core_guided(
+    const SSA_stept &failed_step,
+    const localization_pointst &,
+    const conflict_providert &conflict_provider);
 };
 
 #endif // CPROVER_GOTO_CHECKER_GOTO_SYMEX_FAULT_LOCALIZER_H
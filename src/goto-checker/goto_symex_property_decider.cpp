@@ -13,15 +13,24 @@ Author: Daniel Kroening, Peter Schrammel
 
 #include <solvers/prop/literal_expr.h>
 #include <solvers/prop/prop.h>
+#include <solvers/prop/prop_conv_solver.h>
 
+#include <util/exception_utils.h>
 #include <util/threeval.h>
 
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
 goto_symex_property_decidert::goto_symex_property_decidert(
   const optionst &options,
   ui_message_handlert &ui_message_handler,
   symex_target_equationt &equation,
   const namespacet &ns)
-  : options(options), ui_message_handler(ui_message_handler), equation(equation)
+  : options(options),
+    ui_message_handler(ui_message_handler),
+    equation(equation),
+    ns(ns)
 {
   solver_factoryt solvers(
     options,
@@ -81,7 +90,7 @@ void goto_symex_property_decidert::convert_goals()
 void goto_symex_property_decidert::add_constraint_from_goals(
   std::function<bool(const irep_idt &)> select_property)
 {
-  exprt::operandst disjuncts;
+  selected_goals.clear();
 
   for(const auto &goal_pair : goal_map)
   {
@@ -89,17 +98,235 @@ void goto_symex_property_decidert::add_constraint_from_goals(
       select_property(goal_pair.first) &&
       !goal_pair.second.condition.is_false())
     {
-      disjuncts.push_back(goal_pair.second.condition);
+      selected_goals.push_back(goal_pair.second.condition);
     }
   }
 
   // this is 'false' if there are no disjuncts
-  solver->decision_procedure().set_to_true(disjunction(disjuncts));
+  solver->decision_procedure().set_to_true(disjunction(selected_goals));
 }
 
 decision_proceduret::resultt goto_symex_property_decidert::solve()
 {
-  return solver->decision_procedure()();
+  messaget log(ui_message_handler);
+
+  decision_proceduret::resultt result;
+  while(true)
+  {
+    result = solve_once();
+
+    if(result != decision_proceduret::resultt::D_SATISFIABLE)
+      break;
+
+    // the model must satisfy the lazy constraints, too
+    const std::size_t violated =
+      equation.convert_violated_constraints(get_decision_procedure(), ns);
+
+    if(violated == 0)
+      break;
+
+    log.statistics() << "Model violates " << violated
+                     << " lazy constraints, solving again" << messaget::eom;
+  }
+
+  const std::size_t hot_spots =
+    options.get_unsigned_int_option("sat-hot-spots");
+  if(hot_spots > 0)
+    output_sat_hot_spots(hot_spots);
+
+  return result;
+}
+
+void goto_symex_property_decidert::output_sat_hot_spots(std::size_t n) const
+{
+  messaget log(ui_message_handler);
+
+  const prop_conv_solvert *prop_conv_solver =
+    dynamic_cast<const prop_conv_solvert *>(&solver->decision_procedure());
+  if(prop_conv_solver == nullptr || solver->prop_ptr == nullptr)
+  {
+    log.warning() << "SAT hot spots require a SAT solver" << messaget::eom;
+    return;
+  }
+
+  const std::vector<propt::variable_activityt> active_variables =
+    solver->prop().most_active_variables(n);
+  if(active_variables.empty())
+  {
+    log.warning() << "SAT hot spots are not supported by "
+                  << solver->prop().solver_text() << messaget::eom;
+    return;
+  }
+
+  std::unordered_set<literalt::var_not> variables;
+  for(const auto &variable : active_variables)
+    variables.insert(variable.first);
+  std::unordered_map<literalt::var_not, irep_idt> identifiers;
+  prop_conv_solver->identify_variables(variables, identifiers);
+
+  // sum up the activities of the bits of each symbol
+  std::vector<std::pair<irep_idt, double>> activities;
+  std::unordered_map<irep_idt, std::size_t> symbol_index;
+  std::size_t intermediate_results = 0;
+  for(const auto &variable : active_variables)
+  {
+    const auto identifier = identifiers.find(variable.first);
+    if(identifier == identifiers.end())
+    {
+      ++intermediate_results;
+      continue;
+    }
+
+    const auto index =
+      symbol_index.emplace(identifier->second, activities.size());
+    if(index.second)
+      activities.emplace_back(identifier->second, 0);
+    activities[index.first->second].second += variable.second;
+  }
+
+  std::stable_sort(
+    activities.begin(),
+    activities.end(),
+    [](const std::pair<irep_idt, double> &a,
+       const std::pair<irep_idt, double> &b) { return a.second > b.second; });
+
+  // the symbols are L2 names, which are assigned at most once
+  std::unordered_map<irep_idt, const source_locationt *> source_locations;
+  for(const auto &step : equation.SSA_steps)
+  {
+    if(
+      step.is_assignment() &&
+      symbol_index.find(step.ssa_lhs.get_identifier()) != symbol_index.end())
+    {
+      source_locations.emplace(
+        step.ssa_lhs.get_identifier(), &step.source.pc->source_location);
+    }
+  }
+
+  log.status() << "SAT hot spots among the " << active_variables.size()
+               << " most active variables:" << messaget::eom;
+
+  for(const auto &activity : activities)
+  {
+    log.status() << "  " << activity.first << " (activity " << activity.second
+                 << ")";
+    const auto source_location = source_locations.find(activity.first);
+    if(
+      source_location != source_locations.end() &&
+      source_location->second->is_not_nil())
+    {
+      log.status() << " assigned at " << *source_location->second;
+    }
+    log.status() << messaget::eom;
+  }
+
+  if(intermediate_results > 0)
+  {
+    log.status() << "  " << intermediate_results
+                 << " of them encode intermediate results" << messaget::eom;
+  }
+}
+
+decision_proceduret::resultt goto_symex_property_decidert::solve_once()
+{
+  const std::size_t batch_size =
+    options.get_unsigned_int_option("cover-batch");
+
+  if(batch_size > 1)
+  {
+    const auto result = solve_goal_batch(batch_size);
+    if(result.has_value())
+      return *result;
+  }
+
+  const std::size_t cube_depth = options.get_unsigned_int_option("cube-depth");
+
+  if(cube_depth == 0)
+    return solver->decision_procedure()();
+
+  return solve_cubes(cube_depth);
+}
+
+optionalt<decision_proceduret::resultt>
+goto_symex_property_decidert::solve_goal_batch(std::size_t batch_size)
+{
+  stack_decision_proceduret &stack_decision_procedure =
+    solver->stack_decision_procedure();
+
+  for(std::size_t size = std::min(batch_size, selected_goals.size()); size > 1;
+      size /= 2)
+  {
+    const std::vector<exprt> assumptions(
+      selected_goals.begin(), selected_goals.begin() + size);
+
+    stack_decision_procedure.push(assumptions);
+    const decision_proceduret::resultt result = stack_decision_procedure();
+    // popping only drops the assumptions, the model remains available
+    stack_decision_procedure.pop();
+
+    if(result != decision_proceduret::resultt::D_UNSATISFIABLE)
+      return result;
+  }
+
+  return {};
+}
+
+decision_proceduret::resultt
+goto_symex_property_decidert::solve_cubes(std::size_t depth)
+{
+  if(depth >= 32)
+  {
+    throw invalid_command_line_argument_exceptiont(
+      "cube depth must be less than 32", "--cube-depth");
+  }
+
+  std::vector<exprt> conditions;
+  for(const auto &step : equation.SSA_steps)
+  {
+    if(conditions.size() == depth)
+      break;
+
+    if(
+      step.is_goto() && !step.ignore && !step.cond_handle.is_constant() &&
+      std::find(conditions.begin(), conditions.end(), step.cond_handle) ==
+        conditions.end())
+    {
+      conditions.push_back(step.cond_handle);
+    }
+  }
+
+  stack_decision_proceduret &stack_decision_procedure =
+    solver->stack_decision_procedure();
+  messaget log(ui_message_handler);
+  const std::size_t cubes = std::size_t(1) << conditions.size();
+  bool error = false;
+
+  for(std::size_t cube = 0; cube < cubes; ++cube)
+  {
+    std::vector<exprt> assumptions;
+    assumptions.reserve(conditions.size());
+    for(std::size_t i = 0; i < conditions.size(); ++i)
+    {
+      assumptions.push_back(
+        (cube >> i) & 1 ? conditions[i] : not_exprt{conditions[i]});
+    }
+
+    log.status() << "Solving cube " << (cube + 1) << " of " << cubes
+                 << messaget::eom;
+
+    stack_decision_procedure.push(assumptions);
+    const decision_proceduret::resultt result = stack_decision_procedure();
+    // popping only drops the assumptions, the model remains available
+    stack_decision_procedure.pop();
+
+    if(result == decision_proceduret::resultt::D_SATISFIABLE)
+      return result;
+    else if(result == decision_proceduret::resultt::D_ERROR)
+      error = true;
+  }
+
+  return error ? decision_proceduret::resultt::D_ERROR
+               : decision_proceduret::resultt::D_UNSATISFIABLE;
 }
 
 decision_proceduret &
@@ -12,6 +12,7 @@ Author: Daniel Kroening, Peter Schrammel
 #ifndef CPROVER_GOTO_CHECKER_GOTO_SYMEX_PROPERTY_DECIDER_H
 #define CPROVER_GOTO_CHECKER_GOTO_SYMEX_PROPERTY_DECIDER_H
 
+#include <util/optional.h>
 #include <util/ui_message.h>
 
 #include <goto-symex/symex_target_equation.h>
@@ -41,7 +42,15 @@ public:
   void add_constraint_from_goals(
     std::function<bool(const irep_idt &property_id)> select_property);
 
-  /// Calls solve() on the solver instance
+  /// Calls solve() on the solver instance. If the `cover-batch` option is
+  /// set to n > 1, a model that reaches a batch of up to n of the goals
+  /// selected last at once is tried first, see \ref solve_goal_batch. If the
+  /// `cube-depth` option is set to n, the problem is split into 2^n cubes,
+  /// which are solved one after the other, see \ref solve_cubes. A model
+  /// that violates lazy constraints of the equation is refined by converting
+  /// these and solving again. If the `sat-hot-spots` option is set to n,
+  /// the symbols encoded by the n most active variables of the SAT solver
+  /// are shown afterwards, see \ref output_sat_hot_spots.
   decision_proceduret::resultt solve();
 
   /// Returns the solver instance
@@ -70,8 +79,13 @@ protected:
   const optionst &options;
   ui_message_handlert &ui_message_handler;
   symex_target_equationt &equation;
+  const namespacet &ns;
   std::unique_ptr<solver_factoryt::solvert> solver;
 
+  /// One call to the solver as described for \ref solve, ignoring the lazy
+  /// constraints of the equation
+  decision_proceduret::resultt solve_once();
+
   struct goalt
   {
     /// A property holds if all instances of it are true
@@ -87,6 +101,33 @@ protected:
   /// the corresponding goal variable that encodes
   /// the negation of the conjunction of the instances of the property
   std::map<irep_idt, goalt> goal_map;
+
+  /// The goal variables selected by the last call to
+  /// `add_constraint_from_goals`
+  std::vector<exprt> selected_goals;
+
+  /// Try to find a model in which the first \p batch_size goals of
+  /// `selected_goals` are reached all at once by assuming them. If there
+  /// isn't any, halve the batch until it has fewer than two goals.
+  /// \return The result of the solver if it is not unsatisfiable, or an
+  ///   empty optional if no batch could be reached at once
+  optionalt<decision_proceduret::resultt>
+  solve_goal_batch(std::size_t batch_size);
+
+  /// Split the problem on the conditions of the first \p depth branches
+  /// of the equation whose conditions are not constant, and solve it under
+  /// each combination of truth values of these conditions as assumptions.
+  /// Branching early in the program matters to most of the equation, which
+  /// makes the cubes about equally hard.
+  /// \return Satisfiable as soon as a cube is satisfiable, unsatisfiable if
+  ///   all cubes are unsatisfiable, and an error otherwise
+  decision_proceduret::resultt solve_cubes(std::size_t depth);
+
+  /// Show the symbols of the equation that the \p n variables with the
+  /// highest activity in the SAT solver encode, most active first, with
+  /// the location of their assignment, as these are the parts of the
+  /// program that made the formula hard to solve
+  void output_sat_hot_spots(std::size_t n) const;
 };
 
 #endif // CPROVER_GOTO_CHECKER_GOTO_SYMEX_PROPERTY_DECIDER_H
@@ -11,50 +11,179 @@ Author: Daniel Kroening, Peter Schrammel
 
 #include "goto_trace_storage.h"
 
-goto_trace_storaget::goto_trace_storaget(const namespacet &ns) : ns(ns)
+#include <algorithm>
+
+goto_trace_storaget::goto_trace_storaget(const namespacet &ns)
+  : ns(ns), nodes(1)
+{
+}
+
+static bool same_step(const goto_trace_stept &a, const goto_trace_stept &b)
+{
+  return a.step_nr == b.step_nr && a.type == b.type && a.pc == b.pc &&
+         a.hidden == b.hidden && a.internal == b.internal &&
+         a.assignment_type == b.assignment_type &&
+         a.function_id == b.function_id && a.thread_nr == b.thread_nr &&
+         a.cond_value == b.cond_value && a.cond_expr == b.cond_expr &&
+         a.property_id == b.property_id && a.comment == b.comment &&
+         a.full_lhs == b.full_lhs && a.full_lhs_value == b.full_lhs_value &&
+         a.format_string == b.format_string && a.io_id == b.io_id &&
+         a.io_args == b.io_args && a.formatted == b.formatted &&
+         a.called_function == b.called_function &&
+         a.function_arguments == b.function_arguments;
+}
+
+std::size_t goto_trace_storaget::add(goto_tracet &&trace)
+{
+  std::size_t node = 0;
+
+  for(auto &step : trace.steps)
+  {
+    // merged expressions compare equal by pointer
+    merge_irep(step.cond_expr);
+    merge_irep(step.full_lhs);
+    merge_irep(step.full_lhs_value);
+    for(auto &arg : step.io_args)
+      merge_irep(arg);
+    for(auto &argument : step.function_arguments)
+      merge_irep(argument);
+
+    const auto &children = nodes[node].children;
+    const auto child_it = std::find_if(
+      children.begin(), children.end(), [this, &step](std::size_t child) {
+        return same_step(nodes[child].step, step);
+      });
+
+    if(child_it != children.end())
+    {
+      node = *child_it;
+      continue;
+    }
+
+    const std::size_t child = nodes.size();
+    nodes[node].children.push_back(child);
+    nodes.push_back(nodet{std::move(step), node, {}});
+    node = child;
+  }
+
+  return node;
+}
+
+goto_tracet goto_trace_storaget::build(std::size_t end) const
 {
+  goto_tracet trace;
+  for(std::size_t node = end; node != 0; node = nodes[node].parent)
+    trace.steps.push_front(nodes[node].step);
+  return trace;
 }
 
-const goto_tracet &goto_trace_storaget::insert(goto_tracet &&trace)
+std::set<irep_idt>
+goto_trace_storaget::failed_property_ids(std::size_t end) const
 {
-  traces.push_back(std::move(trace));
-  const auto &last_step = traces.back().get_last_step();
+  std::set<irep_idt> property_ids;
+  for(std::size_t node = end; node != 0; node = nodes[node].parent)
+  {
+    const goto_trace_stept &step = nodes[node].step;
+    if(step.is_assert() && !step.cond_value)
+      property_ids.insert(step.property_id);
+  }
+  return property_ids;
+}
+
+void goto_trace_storaget::insert(goto_tracet &&trace)
+{
+  const auto &last_step = trace.get_last_step();
   DATA_INVARIANT(
     last_step.is_assert(), "last goto trace step expected to be assertion");
   const auto emplace_result = property_id_to_trace_index.emplace(
-    last_step.property_id, traces.size() - 1);
+    last_step.property_id, trace_ends.size());
   INVARIANT(
     emplace_result.second,
     "cannot associate more than one error trace with property " +
       id2string(last_step.property_id));
-  return traces.back();
+  trace_ends.push_back(add(std::move(trace)));
 }
 
-const goto_tracet &goto_trace_storaget::insert_all(goto_tracet &&trace)
+void goto_trace_storaget::insert_all(goto_tracet &&trace)
 {
-  traces.push_back(std::move(trace));
-  const auto &all_property_ids = traces.back().get_failed_property_ids();
+  const auto &all_property_ids = trace.get_failed_property_ids();
   DATA_INVARIANT(
     !all_property_ids.empty(), "a trace must violate at least one assertion");
   for(const auto &property_id : all_property_ids)
   {
-    property_id_to_trace_index.emplace(property_id, traces.size() - 1);
+    property_id_to_trace_index.emplace(property_id, trace_ends.size());
   }
-  return traces.back();
+  trace_ends.push_back(add(std::move(trace)));
+}
+
+void goto_trace_storaget::minimize()
+{
+  std::vector<std::set<irep_idt>> property_ids;
+  property_ids.reserve(trace_ends.size());
+  for(const auto end : trace_ends)
+    property_ids.push_back(failed_property_ids(end));
+
+  std::vector<goto_tracet> kept_traces;
+  std::unordered_map<irep_idt, std::size_t> kept_property_id_to_trace_index;
+
+  while(true)
+  {
+    std::size_t best_index = trace_ends.size();
+    std::size_t best_count = 0;
+
+    for(std::size_t i = 0; i < trace_ends.size(); ++i)
+    {
+      const std::size_t count = std::count_if(
+        property_ids[i].begin(),
+        property_ids[i].end(),
+        [&kept_property_id_to_trace_index](const irep_idt &property_id) {
+          return kept_property_id_to_trace_index.count(property_id) == 0;
+        });
+
+      if(count > best_count)
+      {
+        best_index = i;
+        best_count = count;
+      }
+    }
+
+    // all property IDs are covered by the kept traces
+    if(best_count == 0)
+      break;
+
+    for(const auto &property_id : property_ids[best_index])
+      kept_property_id_to_trace_index.emplace(property_id, kept_traces.size());
+
+    kept_traces.push_back(build(trace_ends[best_index]));
+    property_ids[best_index].clear();
+  }
+
+  // rebuild the trie to drop the steps of the other traces
+  nodes.resize(1);
+  nodes.front().children.clear();
+  trace_ends.clear();
+  for(auto &trace : kept_traces)
+    trace_ends.push_back(add(std::move(trace)));
+
+  property_id_to_trace_index = std::move(kept_property_id_to_trace_index);
+}
+
+std::size_t goto_trace_storaget::size() const
+{
+  return trace_ends.size();
 }
 
-const std::vector<goto_tracet> &goto_trace_storaget::all() const
+goto_tracet goto_trace_storaget::get(std::size_t index) const
 {
-  return traces;
+  return build(trace_ends.at(index));
 }
 
-const goto_tracet &goto_trace_storaget::
-operator[](const irep_idt &property_id) const
+goto_tracet goto_trace_storaget::operator[](const irep_idt &property_id) const
 {
   const auto trace_found = property_id_to_trace_index.find(property_id);
   PRECONDITION(trace_found != property_id_to_trace_index.end());
 
-  return traces.at(trace_found->second);
+  return build(trace_ends.at(trace_found->second));
 }
 
 const namespacet &goto_trace_storaget::get_namespace() const
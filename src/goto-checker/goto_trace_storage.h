@@ -14,6 +14,13 @@ Author: Daniel Kroening, Peter Schrammel
 
 #include <goto-programs/goto_trace.h>
 
+#include <util/merge_irep.h>
+
+/// Stores goto traces in a trie of their steps, such that the steps that
+/// several traces share as a prefix are stored once, and merges the
+/// expressions of all steps such that equal ones share their storage.
+/// Traces are built from the trie when requested, typically one at a time
+/// while reporting.
 class goto_trace_storaget
 {
 public:
@@ -21,15 +28,28 @@ public:
   goto_trace_storaget(const goto_trace_storaget &) = delete;
 
   /// Store trace that ends in a violated assertion
-  const goto_tracet &insert(goto_tracet &&);
+  void insert(goto_tracet &&);
 
   /// Store trace that contains multiple violated assertions
   /// \note Only property IDs that are not part of any already stored trace
   ///   are mapped to the given trace.
-  const goto_tracet &insert_all(goto_tracet &&);
+  void insert_all(goto_tracet &&);
+
+  /// Drop traces such that the remaining ones still violate all property IDs
+  /// that any stored trace violates. The traces to keep are picked greedily,
+  /// each one violating the most property IDs not violated by those picked
+  /// before, which yields a set cover within a logarithmic factor of the
+  /// smallest one. Property IDs are mapped to the kept traces afterwards.
+  void minimize();
+
+  /// Number of stored traces
+  std::size_t size() const;
 
-  const std::vector<goto_tracet> &all() const;
-  const goto_tracet &operator[](const irep_idt &property_id) const;
+  /// Build the trace stored \p index -th
+  goto_tracet get(std::size_t index) const;
+
+  /// Build the trace mapped to \p property_id
+  goto_tracet operator[](const irep_idt &property_id) const;
 
   const namespacet &get_namespace() const;
 
@@ -37,11 +57,35 @@ protected:
   /// the namespace related to the traces
   const namespacet &ns;
 
-  /// stores the traces
-  std::vector<goto_tracet> traces;
+  struct nodet
+  {
+    goto_trace_stept step;
+    /// node of the previous step
+    std::size_t parent;
+    /// nodes of the steps that follow in some trace
+    std::vector<std::size_t> children;
+  };
+
+  /// the trie of steps, the root at index 0 does not hold a step
+  std::vector<nodet> nodes;
 
-  // maps property ID to index in traces
+  /// node of the last step of each trace
+  std::vector<std::size_t> trace_ends;
+
+  // maps property ID to index in trace_ends
   std::unordered_map<irep_idt, std::size_t> property_id_to_trace_index;
+
+  /// makes equal expressions of steps share their storage
+  merge_irept merge_irep;
+
+  /// Add the steps of \p trace to the trie
+  /// \return the node of the last step
+  std::size_t add(goto_tracet &&trace);
+
+  goto_tracet build(std::size_t end) const;
+
+  /// Property IDs of the failed assertions on the path to \p end
+  std::set<irep_idt> failed_property_ids(std::size_t end) const;
 };
 
 #endif // CPROVER_GOTO_CHECKER_GOTO_TRACE_STORAGE_H
@@ -0,0 +1,182 @@
+/*******************************************************************\
+
+Module: Goto Verifier for k-Induction
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Goto Verifier for k-Induction
+
+#ifndef CPROVER_GOTO_CHECKER_K_INDUCTION_VERIFIER_H
+#define CPROVER_GOTO_CHECKER_K_INDUCTION_VERIFIER_H
+
+#include "goto_verifier.h"
+
+#include <goto-programs/goto_model.h>
+
+#include <goto-instrument/k_induction.h>
+
+#include "incremental_goto_checker.h"
+#include "properties.h"
+#include "report_util.h"
+
+/// Proves the properties by k-induction for k = 1, 2, ... up to the bound
+/// given by the option `k-induction`. For each k the base case and the step
+/// case are instrumented on copies of the goto model and checked by
+/// \p incremental_goto_checkerT, all within a single run. Loop invariants
+/// given with `__CPROVER_loop_invariant` are turned into properties, which
+/// the step case assumes for the first k iterations.
+template <class incremental_goto_checkerT>
+class k_induction_verifiert : public goto_verifiert
+{
+public:
+  k_induction_verifiert(
+    const optionst &options,
+    ui_message_handlert &ui_message_handler,
+    abstract_goto_modelt &goto_model)
+    : goto_verifiert(options, ui_message_handler)
+  {
+    copy_goto_model(goto_model, goto_model_with_invariants);
+    assert_loop_invariants(goto_model_with_invariants);
+    properties = initialize_properties(goto_model_with_invariants);
+  }
+
+  resultt operator()() override
+  {
+    const std::size_t max_k = options.get_unsigned_int_option("k-induction");
+
+    for(std::size_t k = 1; k <= max_k; ++k)
+    {
+      iterations = k;
+
+      log.status() << "k-induction: checking base case for k=" << k
+                   << messaget::eom;
+      const propertiest base_case_properties = check(true, false, k);
+
+      // a violation of the base case is a violation of the program
+      bool base_case_failed = false;
+      for(const auto &property_pair : base_case_properties)
+      {
+        const property_statust status = property_pair.second.status;
+        if(
+          status == property_statust::FAIL ||
+          status == property_statust::ERROR)
+        {
+          properties.at(property_pair.first).status = status;
+          base_case_failed = true;
+        }
+      }
+
+      if(base_case_failed)
+      {
+        log.status() << "k-induction: base case failed for k=" << k
+                     << messaget::eom;
+        update_status_of_not_checked_properties_to_unknown();
+        return determine_result(properties);
+      }
+
+      log.status() << "k-induction: checking step case for k=" << k
+                   << messaget::eom;
+      const propertiest step_case_properties = check(false, true, k);
+
+      // The step case assumes all properties in the first k iterations,
+      // hence it proves them only if it proves all of them together.
+      bool step_case_passed = true;
+      for(const auto &property_pair : properties)
+      {
+        const auto it = step_case_properties.find(property_pair.first);
+        if(
+          it == step_case_properties.end() ||
+          (it->second.status != property_statust::PASS &&
+           it->second.status != property_statust::NOT_REACHABLE))
+        {
+          step_case_passed = false;
+          break;
+        }
+      }
+
+      if(step_case_passed)
+      {
+        log.status() << "k-induction: step case passed for k=" << k
+                     << messaget::eom;
+        for(auto &property_pair : properties)
+          property_pair.second.status = property_statust::PASS;
+        return determine_result(properties);
+      }
+    }
+
+    log.status() << "k-induction: inconclusive up to k=" << max_k
+                 << messaget::eom;
+    update_status_of_not_checked_properties_to_unknown();
+    return determine_result(properties);
+  }
+
+  void report() override
+  {
+    output_properties(properties, iterations, ui_message_handler);
+    output_overall_result(determine_result(properties), ui_message_handler);
+  }
+
+protected:
+  goto_modelt goto_model_with_invariants;
+  std::size_t iterations = 1;
+
+  static void
+  copy_goto_model(const abstract_goto_modelt &src, goto_modelt &dest)
+  {
+    dest.symbol_table = src.get_symbol_table();
+    dest.goto_functions.copy_from(src.get_goto_functions());
+  }
+
+  /// Instruments the base case or the step case for \p k on a copy of the
+  /// goto model and returns the properties as determined by the checker.
+  /// The properties returned refer to the instructions of
+  /// \ref goto_model_with_invariants, as the copy goes away.
+  propertiest check(bool base_case, bool step_case, std::size_t k)
+  {
+    goto_modelt instrumented_model;
+    copy_goto_model(goto_model_with_invariants, instrumented_model);
+    k_induction(
+      instrumented_model, base_case, step_case, static_cast<unsigned>(k));
+    instrumented_model.goto_functions.update();
+
+    propertiest instrumented_properties =
+      initialize_properties(instrumented_model);
+    incremental_goto_checkerT incremental_goto_checker(
+      options, ui_message_handler, instrumented_model);
+    while(incremental_goto_checker(instrumented_properties).progress !=
+          incremental_goto_checkert::resultt::progresst::DONE)
+    {
+      // loop until we are done
+    }
+
+    propertiest result;
+    for(const auto &property_pair : instrumented_properties)
+    {
+      const auto it = properties.find(property_pair.first);
+      if(it != properties.end())
+      {
+        result.emplace(
+          property_pair.first,
+          property_infot{it->second.pc,
+                         it->second.description,
+                         property_pair.second.status});
+      }
+    }
+
+    return result;
+  }
+
+  void update_status_of_not_checked_properties_to_unknown()
+  {
+    for(auto &property_pair : properties)
+    {
+      if(property_pair.second.status == property_statust::NOT_CHECKED)
+        property_pair.second.status = property_statust::UNKNOWN;
+    }
+  }
+};
+
+#endif // CPROVER_GOTO_CHECKER_K_INDUCTION_VERIFIER_H
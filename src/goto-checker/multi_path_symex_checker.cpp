@@ -25,6 +25,11 @@ multi_path_symex_checkert::multi_path_symex_checkert(
     equation_generated(false),
     property_decider(options, ui_message_handler, equation, ns)
 {
+  if(options.get_bool_option("stream-equation"))
+  {
+    equation.convert_assignments_on_the_fly(
+      property_decider.get_decision_procedure());
+  }
 }
 
 incremental_goto_checkert::resultt multi_path_symex_checkert::
@@ -80,8 +85,15 @@ void multi_path_symex_checkert::run_property_decider(
   propertiest &properties,
   std::chrono::duration<double> solver_runtime)
 {
+  // Properties that hold on the equation may still fail on the paths that
+  // symex abandoned.
   ::run_property_decider(
-    result, properties, property_decider, ui_message_handler, solver_runtime);
+    result,
+    properties,
+    property_decider,
+    ui_message_handler,
+    solver_runtime,
+    !symex.paths_abandoned());
 }
 
 goto_tracet multi_path_symex_checkert::build_full_trace() const
@@ -102,14 +114,18 @@ goto_tracet multi_path_symex_checkert::build_shortest_trace() const
   if(options.get_bool_option("beautify"))
   {
     // NOLINTNEXTLINE(whitespace/braces)
-    counterexample_beautificationt{ui_message_handler}(
+    counterexample_beautificationt{options, ui_message_handler}(
       dynamic_cast<boolbvt &>(property_decider.get_stack_decision_procedure()),
       equation);
   }
 
   goto_tracet goto_trace;
   build_goto_trace(
-    equation, property_decider.get_decision_procedure(), ns, goto_trace);
+    equation,
+    property_decider.get_decision_procedure(),
+    ns,
+    goto_trace,
+    trace_steps_needing_values(options, ui_message_handler));
 
   return goto_trace;
 }
@@ -123,7 +139,8 @@ multi_path_symex_checkert::build_trace(const irep_idt &property_id) const
     ssa_step_matches_failing_property(property_id),
     property_decider.get_decision_procedure(),
     ns,
-    goto_trace);
+    goto_trace,
+    trace_steps_needing_values(options, ui_message_handler));
 
   return goto_trace;
 }
@@ -142,6 +159,7 @@ void multi_path_symex_checkert::output_error_witness(
   const goto_tracet &error_trace)
 {
   output_graphml(error_trace, ns, options);
+  output_binary_trace(error_trace, options);
 }
 
 fault_location_infot
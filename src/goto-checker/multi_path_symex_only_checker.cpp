@@ -36,6 +36,7 @@ multi_path_symex_only_checkert::multi_path_symex_only_checkert(
       guard_manager)
 {
   setup_symex(symex, ns, options, ui_message_handler);
+  symex.relevant_symbols = get_relevant_symbols(options, goto_model);
 }
 
 incremental_goto_checkert::resultt multi_path_symex_only_checkert::
@@ -82,6 +83,12 @@ void multi_path_symex_only_checkert::update_properties(
     properties, updated_properties, equation);
   // Since we will not symex any further we can decide the status
   // of all properties that do not occur in the equation now.
-  // The current behavior is PASS.
-  update_status_of_not_checked_properties(properties, updated_properties);
+  // The current behavior is PASS, unless symex has abandoned paths.
+  if(symex.paths_abandoned())
+  {
+    update_status_of_not_checked_properties_to_unknown(
+      properties, updated_properties);
+  }
+  else
+    update_status_of_not_checked_properties(properties, updated_properties);
 }
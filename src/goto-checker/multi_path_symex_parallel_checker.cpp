@@ -0,0 +1,284 @@
+/*******************************************************************\
+
+Module: Goto Checker using Multi-Path Symbolic Execution and
+        Parallel Property Solving
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Goto Checker using Multi-Path Symbolic Execution and
+/// Parallel Property Solving
+
+#include "multi_path_symex_parallel_checker.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <util/forked_workers.h>
+
+#include <goto-symex/property_groups.h>
+#include <goto-symex/slice.h>
+
+#include "bmc_util.h"
+
+multi_path_symex_parallel_checkert::multi_path_symex_parallel_checkert(
+  const optionst &options,
+  ui_message_handlert &ui_message_handler,
+  abstract_goto_modelt &goto_model)
+  : multi_path_symex_checkert(options, ui_message_handler, goto_model)
+{
+}
+
+incremental_goto_checkert::resultt multi_path_symex_parallel_checkert::
+operator()(propertiest &properties)
+{
+  resultt result(resultt::progresst::DONE);
+
+  // all properties are decided in the first invocation
+  if(equation_generated)
+    return result;
+
+  generate_equation();
+  equation_generated = true;
+
+  output_coverage_report(
+    options.get_option("symex-coverage-report"),
+    goto_model,
+    symex,
+    ui_message_handler);
+
+  update_properties(properties, result.updated_properties);
+
+  std::vector<irep_idt> property_ids;
+  for(const auto &property_pair : properties)
+  {
+    if(is_property_to_check(property_pair.second.status))
+      property_ids.push_back(property_pair.first);
+  }
+
+  if(property_ids.empty())
+    return result;
+
+  // sort to make the partitioning independent of hash table order
+  std::sort(
+    property_ids.begin(),
+    property_ids.end(),
+    [](const irep_idt &a, const irep_idt &b) {
+      return id2string(a) < id2string(b);
+    });
+
+  messaget log(ui_message_handler);
+
+  // with group-properties, the groups that are decided by a solver instance
+  // of their own
+  const bool grouping = options.get_bool_option("group-properties");
+  std::vector<propertiest> groups;
+  if(grouping)
+  {
+    for(const auto &group : group_properties_by_cone(equation, property_ids))
+    {
+      groups.emplace_back();
+      for(const auto &property_id : group)
+        groups.back().emplace(property_id, properties.at(property_id));
+    }
+
+    log.status() << "Grouped " << property_ids.size() << " properties into "
+                 << groups.size() << " groups by their cones of influence"
+                 << messaget::eom;
+  }
+
+  const std::size_t number_of_workers =
+    forked_workers_supported()
+      ? std::min(
+          grouping ? groups.size() : property_ids.size(),
+          std::max<std::size_t>(
+            1, options.get_unsigned_int_option("parallel-properties")))
+      : 1;
+
+  if(number_of_workers == 1)
+  {
+    if(!grouping)
+    {
+      decide_properties(
+        properties, property_decider, result.updated_properties);
+      return result;
+    }
+
+    for(auto &group : groups)
+    {
+      decide_group(group, result.updated_properties);
+      for(const auto &property_pair : group)
+        properties.at(property_pair.first) = property_pair.second;
+    }
+    return result;
+  }
+
+  // the groups each worker decides, and all of their properties
+  std::vector<std::vector<std::size_t>> worker_groups(number_of_workers);
+  std::vector<propertiest> shares(number_of_workers);
+  if(grouping)
+  {
+    // the groups come largest first, each goes to the worker with the fewest
+    // properties so far
+    for(std::size_t group = 0; group < groups.size(); ++group)
+    {
+      const std::size_t worker = std::distance(
+        shares.begin(),
+        std::min_element(
+          shares.begin(),
+          shares.end(),
+          [](const propertiest &a, const propertiest &b) {
+            return a.size() < b.size();
+          }));
+      worker_groups[worker].push_back(group);
+      shares[worker].insert(groups[group].begin(), groups[group].end());
+    }
+  }
+  else
+  {
+    for(std::size_t i = 0; i < property_ids.size(); ++i)
+    {
+      shares[i % number_of_workers].emplace(
+        property_ids[i], properties.at(property_ids[i]));
+    }
+  }
+
+  log.status() << "Deciding " << property_ids.size() << " properties in "
+               << number_of_workers << " parallel processes" << messaget::eom;
+
+  const auto solver_start = std::chrono::steady_clock::now();
+
+  const auto worker_results =
+    run_forked_workers(number_of_workers, [&](std::size_t worker) {
+      // workers run concurrently, keep their output to errors
+      ui_message_handler.set_verbosity(messaget::M_ERROR);
+
+      propertiest &share = shares[worker];
+      std::unordered_set<irep_idt> updated_properties;
+
+      if(grouping)
+      {
+        for(const std::size_t group : worker_groups[worker])
+        {
+          decide_group(groups[group], updated_properties);
+          for(const auto &property_pair : groups[group])
+            share.at(property_pair.first) = property_pair.second;
+        }
+      }
+      else
+      {
+        // the equation is this worker's own copy, which need not be shared
+        if(options.get_bool_option("slice-formula"))
+          slice_to_properties(share);
+
+        decide_properties(share, property_decider, updated_properties);
+      }
+
+      return serialize_property_status(share);
+    });
+
+  for(std::size_t worker = 0; worker < number_of_workers; ++worker)
+  {
+    std::unordered_map<irep_idt, property_statust> worker_status;
+    if(worker_results[worker].has_value())
+    {
+      worker_status = deserialize_property_status(*worker_results[worker]);
+    }
+    else
+    {
+      log.error() << "parallel property worker " << worker
+                  << " failed to report results" << messaget::eom;
+    }
+
+    // properties not reported by a worker are marked as ERROR
+    for(const auto &property_pair : shares[worker])
+    {
+      const auto status_it = worker_status.find(property_pair.first);
+      properties.at(property_pair.first).status |=
+        status_it == worker_status.end() ? property_statust::ERROR
+                                         : status_it->second;
+      result.updated_properties.insert(property_pair.first);
+    }
+  }
+
+  const auto solver_stop = std::chrono::steady_clock::now();
+  log.status() << "Runtime decision procedure: "
+               << std::chrono::duration<double>(solver_stop - solver_start)
+                    .count()
+               << "s" << messaget::eom;
+
+  return result;
+}
+
+void multi_path_symex_parallel_checkert::decide_properties(
+  propertiest &properties,
+  goto_symex_property_decidert &decider,
+  std::unordered_set<irep_idt> &updated_properties)
+{
+  std::chrono::duration<double> solver_runtime = ::prepare_property_decider(
+    properties, equation, decider, ui_message_handler);
+
+  while(true)
+  {
+    resultt result(resultt::progresst::DONE);
+    // Properties that hold on the equation may still fail on the paths that
+    // symex abandoned.
+    ::run_property_decider(
+      result,
+      properties,
+      decider,
+      ui_message_handler,
+      solver_runtime,
+      !symex.paths_abandoned());
+    solver_runtime = std::chrono::duration<double>(0);
+
+    updated_properties.insert(
+      result.updated_properties.begin(), result.updated_properties.end());
+
+    // failed properties are excluded from the next round
+    if(result.progress != resultt::progresst::FOUND_FAIL)
+      break;
+  }
+}
+
+void multi_path_symex_parallel_checkert::decide_group(
+  propertiest &group,
+  std::unordered_set<irep_idt> &updated_properties)
+{
+  // the new decider converts the steps again, and the next group may need
+  // the steps sliced away for this one
+  std::vector<std::pair<bool, bool>> flags;
+  flags.reserve(equation.SSA_steps.size());
+  for(const auto &step : equation.SSA_steps)
+    flags.emplace_back(step.ignore, step.converted);
+
+  slice_to_properties(group);
+
+  {
+    goto_symex_property_decidert decider(
+      options, ui_message_handler, equation, ns);
+    decide_properties(group, decider, updated_properties);
+  }
+
+  auto flags_it = flags.begin();
+  for(auto &step : equation.SSA_steps)
+  {
+    step.ignore = flags_it->first;
+    step.converted = flags_it->second;
+    ++flags_it;
+  }
+}
+
+void multi_path_symex_parallel_checkert::slice_to_properties(
+  const propertiest &properties)
+{
+  for(auto &step : equation.SSA_steps)
+  {
+    if(step.is_assert() && properties.count(step.get_property_id()) == 0)
+      step.ignore = true;
+  }
+
+  ::slice(equation);
+}
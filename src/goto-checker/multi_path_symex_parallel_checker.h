@@ -0,0 +1,76 @@
+/*******************************************************************\
+
+Module: Goto Checker using Multi-Path Symbolic Execution and
+        Parallel Property Solving
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Goto Checker using Multi-Path Symbolic Execution and
+/// Parallel Property Solving
+
+#ifndef CPROVER_GOTO_CHECKER_MULTI_PATH_SYMEX_PARALLEL_CHECKER_H
+#define CPROVER_GOTO_CHECKER_MULTI_PATH_SYMEX_PARALLEL_CHECKER_H
+
+#include "multi_path_symex_checker.h"
+
+/// Performs a multi-path symbolic execution using goto-symex and then splits
+/// the properties into `parallel-properties` shares. Each share is decided
+/// by a solver instance of its own in a forked worker process, which inherits
+/// the equation copy-on-write. The results of all workers are merged back
+/// into the properties given to `operator()`.
+///
+/// Workers start from the equation that the calling process produced, such
+/// that symbolic execution is done once for all shares. With `slice-formula`,
+/// each worker slices its copy of the equation to the properties of its
+/// share before converting it.
+///
+/// With `group-properties`, the properties are first partitioned into
+/// groups whose cones of influence in the equation overlap heavily, see
+/// \ref group_properties_by_cone. Each group is decided by a solver instance
+/// of its own on the equation sliced to the group, such that the parts of
+/// the equation that only other groups depend on do not slow it down. The
+/// groups are spread over the workers, largest first, or decided one after
+/// the other in the calling process.
+///
+/// All properties are decided in the first invocation. As there is no solver
+/// state in the calling process afterwards, traces cannot be built; this
+/// checker is therefore meant to be used with \ref all_properties_verifiert.
+class multi_path_symex_parallel_checkert : public multi_path_symex_checkert
+{
+public:
+  multi_path_symex_parallel_checkert(
+    const optionst &options,
+    ui_message_handlert &ui_message_handler,
+    abstract_goto_modelt &goto_model);
+
+  resultt operator()(propertiest &) override;
+
+protected:
+  /// Decide all properties in \p properties to completion using
+  /// \p decider, which has not been used before.
+  /// \param [in,out] properties: the properties to decide, the status of
+  ///   which is updated
+  /// \param decider: the property decider to convert the equation into
+  /// \param [in,out] updated_properties: the IDs of updated properties are
+  ///   added here
+  void decide_properties(
+    propertiest &properties,
+    goto_symex_property_decidert &decider,
+    std::unordered_set<irep_idt> &updated_properties);
+
+  /// Decide the properties in \p group using a new property decider, on the
+  /// equation sliced to \p group. The slicing, and which steps have been
+  /// converted, is undone afterwards.
+  void decide_group(
+    propertiest &group,
+    std::unordered_set<irep_idt> &updated_properties);
+
+  /// Ignore the assertions of the equation that are not in \p properties,
+  /// and slice away the steps that only those assertions depend on
+  void slice_to_properties(const propertiest &properties);
+};
+
+#endif // CPROVER_GOTO_CHECKER_MULTI_PATH_SYMEX_PARALLEL_CHECKER_H
@@ -0,0 +1,304 @@
+/*******************************************************************\
+
+Module: Goto Checker using Multi-Path Symbolic Execution and
+        Parallel Cover Goal Solving
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Goto Checker using Multi-Path Symbolic Execution and
+/// Parallel Cover Goal Solving
+
+#include "multi_path_symex_parallel_cover_checker.h"
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+
+#include <util/exception_utils.h>
+#include <util/forked_workers.h>
+
+#include <goto-programs/binary_goto_trace.h>
+
+#include "bmc_util.h"
+
+multi_path_symex_parallel_cover_checkert::
+  multi_path_symex_parallel_cover_checkert(
+    const optionst &options,
+    ui_message_handlert &ui_message_handler,
+    abstract_goto_modelt &goto_model)
+  : multi_path_symex_checkert(options, ui_message_handler, goto_model)
+{
+}
+
+incremental_goto_checkert::resultt multi_path_symex_parallel_cover_checkert::
+operator()(propertiest &properties)
+{
+  resultt result(resultt::progresst::DONE);
+
+  if(!goals_decided)
+  {
+    goals_decided = true;
+
+    generate_equation();
+    equation_generated = true;
+
+    output_coverage_report(
+      options.get_option("symex-coverage-report"),
+      goto_model,
+      symex,
+      ui_message_handler);
+
+    update_properties(properties, result.updated_properties);
+
+    std::vector<irep_idt> goal_ids;
+    for(const auto &property_pair : properties)
+    {
+      if(is_property_to_check(property_pair.second.status))
+        goal_ids.push_back(property_pair.first);
+    }
+
+    if(goal_ids.empty())
+      return result;
+
+    // sort to make the partitioning independent of hash table order
+    std::sort(
+      goal_ids.begin(),
+      goal_ids.end(),
+      [](const irep_idt &a, const irep_idt &b) {
+        return id2string(a) < id2string(b);
+      });
+
+    const std::size_t number_of_workers = std::min(
+      goal_ids.size(),
+      std::max<std::size_t>(
+        1, options.get_unsigned_int_option("parallel-properties")));
+
+    messaget log(ui_message_handler);
+    log.status() << "Covering " << goal_ids.size() << " goals in "
+                 << number_of_workers << " parallel processes"
+                 << messaget::eom;
+
+    const auto solver_start = std::chrono::steady_clock::now();
+
+    // allocated before forking, such that all workers see the same flags
+    shared_flagst covered(goal_ids.size());
+
+    const auto worker_results =
+      run_forked_workers(number_of_workers, [&](std::size_t worker) {
+        // workers run concurrently, keep their output to errors
+        ui_message_handler.set_verbosity(messaget::M_ERROR);
+
+        return cover_goals(
+          properties, worker, number_of_workers, goal_ids, covered);
+      });
+
+    // a goal is covered if any worker covered it, otherwise its status is
+    // the one reported by the worker whose share it is in
+    std::vector<std::unordered_map<irep_idt, property_statust>> worker_status(
+      number_of_workers);
+    std::unordered_set<irep_idt> covered_goals;
+
+    for(std::size_t worker = 0; worker < number_of_workers; ++worker)
+    {
+      if(
+        !worker_results[worker].has_value() ||
+        !deserialize_worker_result(
+          *worker_results[worker], worker_status[worker]))
+      {
+        log.error() << "parallel cover worker " << worker
+                    << " failed to report results" << messaget::eom;
+        continue;
+      }
+
+      for(const auto &status_pair : worker_status[worker])
+      {
+        if(status_pair.second == property_statust::FAIL)
+          covered_goals.insert(status_pair.first);
+      }
+    }
+
+    for(std::size_t i = 0; i < goal_ids.size(); ++i)
+    {
+      const irep_idt &goal_id = goal_ids[i];
+      property_statust status = property_statust::ERROR;
+
+      if(covered_goals.count(goal_id) != 0)
+        status = property_statust::FAIL;
+      else
+      {
+        const auto &owner_status = worker_status[i % number_of_workers];
+        const auto status_it = owner_status.find(goal_id);
+        if(status_it != owner_status.end())
+          status = status_it->second;
+      }
+
+      properties.at(goal_id).status |= status;
+      result.updated_properties.insert(goal_id);
+    }
+
+    const auto solver_stop = std::chrono::steady_clock::now();
+    log.status() << "Runtime decision procedure: "
+                 << std::chrono::duration<double>(solver_stop - solver_start)
+                      .count()
+                 << "s" << messaget::eom;
+  }
+
+  // hand out one trace per invocation
+  if(!pending_traces.empty())
+  {
+    current_trace = std::move(pending_traces.front());
+    pending_traces.pop_front();
+    result.progress = resultt::progresst::FOUND_FAIL;
+  }
+
+  return result;
+}
+
+goto_tracet multi_path_symex_parallel_cover_checkert::build_full_trace() const
+{
+  return current_trace;
+}
+
+std::string multi_path_symex_parallel_cover_checkert::cover_goals(
+  propertiest &properties,
+  std::size_t worker,
+  std::size_t number_of_workers,
+  const std::vector<irep_idt> &goal_ids,
+  shared_flagst &covered)
+{
+  std::unordered_map<irep_idt, std::size_t> goal_index;
+  for(std::size_t i = 0; i < goal_ids.size(); ++i)
+    goal_index.emplace(goal_ids[i], i);
+
+  const auto is_in_share = [&](std::size_t i) {
+    return i % number_of_workers == worker;
+  };
+
+  // all goals are given to the solver, such that a model covering goals of
+  // other shares is recognized as doing so
+  prepare_property_decider(properties);
+
+  std::ostringstream traces;
+  std::size_t number_of_traces = 0;
+
+  while(true)
+  {
+    // goals that another worker has covered need not be covered again
+    property_decider.add_constraint_from_goals([&](const irep_idt &goal_id) {
+      const auto index_it = goal_index.find(goal_id);
+      return index_it != goal_index.end() && is_in_share(index_it->second) &&
+             !covered.get(index_it->second) &&
+             is_property_to_check(properties.at(goal_id).status);
+    });
+
+    const decision_proceduret::resultt dec_result = property_decider.solve();
+
+    std::unordered_set<irep_idt> updated_properties;
+    property_decider.update_properties_status_from_goals(
+      properties, updated_properties, dec_result, false);
+
+    if(dec_result != decision_proceduret::resultt::D_SATISFIABLE)
+    {
+      // the goals of the share that are left can't be covered, unless
+      // another worker did
+      const property_statust status =
+        dec_result == decision_proceduret::resultt::D_UNSATISFIABLE
+          ? property_statust::PASS
+          : property_statust::ERROR;
+
+      for(std::size_t i = 0; i < goal_ids.size(); ++i)
+      {
+        auto &goal_status = properties.at(goal_ids[i]).status;
+        if(
+          is_in_share(i) && !covered.get(i) &&
+          goal_status == property_statust::UNKNOWN)
+        {
+          goal_status |= status;
+        }
+      }
+
+      break;
+    }
+
+    for(const auto &goal_id : updated_properties)
+    {
+      const auto index_it = goal_index.find(goal_id);
+      if(index_it != goal_index.end())
+        covered.set(index_it->second);
+    }
+
+    std::ostringstream trace;
+    write_binary_goto_trace(
+      multi_path_symex_checkert::build_full_trace(), trace);
+    traces << trace.str().size() << '\n' << trace.str();
+    ++number_of_traces;
+  }
+
+  // report the share and whatever else this worker covered
+  propertiest reported;
+  for(std::size_t i = 0; i < goal_ids.size(); ++i)
+  {
+    const auto &property_info = properties.at(goal_ids[i]);
+    if(is_in_share(i) || property_info.status == property_statust::FAIL)
+      reported.emplace(goal_ids[i], property_info);
+  }
+
+  const std::string status = serialize_property_status(reported);
+
+  std::ostringstream out;
+  out << status.size() << '\n'
+      << status << number_of_traces << '\n'
+      << traces.str();
+  return out.str();
+}
+
+bool multi_path_symex_parallel_cover_checkert::deserialize_worker_result(
+  const std::string &serialized,
+  std::unordered_map<irep_idt, property_statust> &worker_status)
+{
+  std::istringstream in(serialized);
+
+  // reads a block of the given size after a line holding the size
+  const auto read_block = [&in](std::string &dest) {
+    std::size_t size;
+    if(!(in >> size) || in.get() != '\n')
+      return false;
+    dest.resize(size);
+    return size == 0 || static_cast<bool>(in.read(&dest[0], size));
+  };
+
+  std::string status;
+  if(!read_block(status))
+    return false;
+
+  worker_status = deserialize_property_status(status);
+
+  std::size_t number_of_traces;
+  if(!(in >> number_of_traces) || in.get() != '\n')
+    return false;
+
+  for(std::size_t i = 0; i < number_of_traces; ++i)
+  {
+    std::string trace;
+    if(!read_block(trace))
+      return false;
+
+    std::istringstream trace_in(trace);
+    goto_tracet goto_trace;
+    try
+    {
+      read_binary_goto_trace(
+        trace_in, goto_model.get_goto_functions(), goto_trace);
+    }
+    catch(const deserialization_exceptiont &)
+    {
+      return false;
+    }
+    pending_traces.push_back(std::move(goto_trace));
+  }
+
+  return true;
+}
@@ -0,0 +1,81 @@
+/*******************************************************************\
+
+Module: Goto Checker using Multi-Path Symbolic Execution and
+        Parallel Cover Goal Solving
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Goto Checker using Multi-Path Symbolic Execution and
+/// Parallel Cover Goal Solving
+
+#ifndef CPROVER_GOTO_CHECKER_MULTI_PATH_SYMEX_PARALLEL_COVER_CHECKER_H
+#define CPROVER_GOTO_CHECKER_MULTI_PATH_SYMEX_PARALLEL_COVER_CHECKER_H
+
+#include <list>
+
+#include "multi_path_symex_checker.h"
+
+class shared_flagst;
+
+/// Performs a multi-path symbolic execution using goto-symex and then splits
+/// the cover goals into `parallel-properties` shares. Each share is covered
+/// by a solver instance of its own in a forked worker process, which inherits
+/// the equation copy-on-write.
+///
+/// Workers mark the goals they cover in memory shared by all of them, and
+/// stop pursuing goals of their share that another worker has covered in the
+/// meantime. A trace that covers goals of other shares is still reported for
+/// all of them.
+///
+/// All goals are decided in the first invocation, and the traces of all
+/// workers are sent back in the format of \ref binary_goto_trace_writert.
+/// Every invocation then hands out one of these traces through
+/// `build_full_trace`, such that this checker can be used with
+/// \ref cover_goals_verifier_with_trace_storaget.
+class multi_path_symex_parallel_cover_checkert
+  : public multi_path_symex_checkert
+{
+public:
+  multi_path_symex_parallel_cover_checkert(
+    const optionst &options,
+    ui_message_handlert &ui_message_handler,
+    abstract_goto_modelt &goto_model);
+
+  resultt operator()(propertiest &) override;
+
+  goto_tracet build_full_trace() const override;
+
+protected:
+  bool goals_decided = false;
+
+  /// Traces received from the workers that have not been handed out yet
+  std::list<goto_tracet> pending_traces;
+
+  /// The trace handed out by the last invocation
+  goto_tracet current_trace;
+
+  /// Cover the goals in the share of \p worker out of \p number_of_workers,
+  /// skipping those that \p covered marks as covered by another worker.
+  /// \param [in,out] properties: the properties, whose status is updated
+  /// \param goal_ids: the goals to cover, by their index in \p covered
+  /// \return the serialized status of the goals of the share and of those
+  ///   the worker covered, followed by the traces it found
+  std::string cover_goals(
+    propertiest &properties,
+    std::size_t worker,
+    std::size_t number_of_workers,
+    const std::vector<irep_idt> &goal_ids,
+    shared_flagst &covered);
+
+  /// Merge \p serialized as returned by `cover_goals` into \p worker_status
+  /// and `pending_traces`
+  /// \return False if \p serialized is malformed
+  bool deserialize_worker_result(
+    const std::string &serialized,
+    std::unordered_map<irep_idt, property_statust> &worker_status);
+};
+
+#endif // CPROVER_GOTO_CHECKER_MULTI_PATH_SYMEX_PARALLEL_COVER_CHECKER_H
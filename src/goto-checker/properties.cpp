@@ -11,6 +11,8 @@ Author: Daniel Kroening, Peter Schrammel
 
 #include "properties.h"
 
+#include <sstream>
+
 #include <util/exit_codes.h>
 #include <util/invariant.h>
 #include <util/json.h>
@@ -181,6 +183,49 @@ bool has_properties_to_check(const propertiest &properties)
   return false;
 }
 
+std::string serialize_property_status(const propertiest &properties)
+{
+  std::ostringstream out;
+  for(const auto &property_pair : properties)
+  {
+    out << static_cast<int>(property_pair.second.status) << ' '
+        << property_pair.first << '\n';
+  }
+  return out.str();
+}
+
+std::unordered_map<irep_idt, property_statust>
+deserialize_property_status(const std::string &serialized)
+{
+  std::unordered_map<irep_idt, property_statust> result;
+  std::istringstream in(serialized);
+  std::string line;
+
+  while(std::getline(in, line))
+  {
+    const auto space = line.find(' ');
+    if(
+      space == std::string::npos || space == 0 ||
+      line.find_first_not_of("0123456789") != space)
+    {
+      continue;
+    }
+
+    const int status = std::stoi(line.substr(0, space));
+    if(
+      status < static_cast<int>(property_statust::NOT_CHECKED) ||
+      status > static_cast<int>(property_statust::ERROR))
+    {
+      continue;
+    }
+
+    result.emplace(
+      line.substr(space + 1), static_cast<property_statust>(status));
+  }
+
+  return result;
+}
+
 /// Update with the preference order
 /// 1. old non-UNKNOWN/non-NOT_CHECKED status
 /// 2. new non-UNKNOWN/non-NOT_CHECKED status
@@ -104,6 +104,16 @@ bool is_property_to_check(property_statust);
 /// Return true if there as a property with NOT_CHECKED or UNKNOWN status
 bool has_properties_to_check(const propertiest &properties);
 
+/// Write the status of each of \p properties as a line
+/// `<status> <property id>`. This is used to pass results between processes
+/// that work on the same goto model.
+std::string serialize_property_status(const propertiest &properties);
+
+/// Read property status as written by \ref serialize_property_status.
+/// Malformed lines are skipped.
+std::unordered_map<irep_idt, property_statust>
+deserialize_property_status(const std::string &serialized);
+
 property_statust &operator|=(property_statust &, property_statust const &);
 property_statust &operator&=(property_statust &, property_statust const &);
 resultt determine_result(const propertiest &properties);
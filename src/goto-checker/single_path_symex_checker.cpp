@@ -70,12 +70,17 @@ operator()(propertiest &properties)
         result, properties, *property_decider, solver_runtime);
 
       if(result.progress == resultt::progresst::FOUND_FAIL)
+      {
+        // the caller may not ask for further results
+        output_coverage();
         return result;
+      }
     }
 
     worklist->pop();
   }
 
+  output_coverage();
   final_update_properties(properties, result.updated_properties);
 
   // Worklist is empty: we are done.
@@ -134,7 +139,7 @@ goto_tracet single_path_symex_checkert::build_shortest_trace() const
   if(options.get_bool_option("beautify"))
   {
     // NOLINTNEXTLINE(whitespace/braces)
-    counterexample_beautificationt{ui_message_handler}(
+    counterexample_beautificationt{options, ui_message_handler}(
       dynamic_cast<boolbvt &>(property_decider->get_stack_decision_procedure()),
       property_decider->get_equation());
   }
@@ -144,7 +149,8 @@ goto_tracet single_path_symex_checkert::build_shortest_trace() const
     property_decider->get_equation(),
     property_decider->get_decision_procedure(),
     ns,
-    goto_trace);
+    goto_trace,
+    trace_steps_needing_values(options, ui_message_handler));
 
   return goto_trace;
 }
@@ -158,7 +164,8 @@ single_path_symex_checkert::build_trace(const irep_idt &property_id) const
     ssa_step_matches_failing_property(property_id),
     property_decider->get_decision_procedure(),
     ns,
-    goto_trace);
+    goto_trace,
+    trace_steps_needing_values(options, ui_message_handler));
 
   return goto_trace;
 }
@@ -172,6 +179,7 @@ void single_path_symex_checkert::output_error_witness(
   const goto_tracet &goto_trace)
 {
   output_graphml(goto_trace, ns, options);
+  output_binary_trace(goto_trace, options);
 }
 
 void single_path_symex_checkert::output_proof()
@@ -28,8 +28,17 @@ single_path_symex_only_checkert::single_path_symex_only_checkert(
   : incremental_goto_checkert(options, ui_message_handler),
     goto_model(goto_model),
     ns(goto_model.get_symbol_table(), symex_symbol_table),
-    worklist(get_path_strategy(options.get_option("exploration-strategy")))
+    worklist(
+      get_path_strategy(options.get_option("exploration-strategy"), options)),
+    relevant_symbols(get_relevant_symbols(options, goto_model)),
+    coverage(ns)
 {
+  if(options.is_set("unwind-max"))
+  {
+    unwind_bound = options.get_unsigned_int_option("unwind");
+    max_unwind_bound = options.get_unsigned_int_option("unwind-max");
+    worklist->defer_exceeded_loops = unwind_bound < *max_unwind_bound;
+  }
 }
 
 incremental_goto_checkert::resultt single_path_symex_only_checkert::
@@ -50,6 +59,7 @@ operator()(propertiest &properties)
     worklist->pop();
   }
 
+  output_coverage();
   final_update_properties(properties, result.updated_properties);
 
   return result;
@@ -75,9 +85,33 @@ void single_path_symex_only_checkert::initialize_worklist()
 bool single_path_symex_only_checkert::has_finished_exploration(
   const propertiest &properties)
 {
-  return worklist->empty() ||
-         (!options.get_bool_option("paths-symex-explore-all") &&
-          !has_properties_to_check(properties));
+  if(memory_limit_reached)
+    return true;
+
+  if(
+    !options.get_bool_option("paths-symex-explore-all") &&
+    !has_properties_to_check(properties))
+  {
+    return true;
+  }
+
+  return worklist->empty() && !next_unwinding_round();
+}
+
+bool single_path_symex_only_checkert::next_unwinding_round()
+{
+  if(!max_unwind_bound.has_value() || worklist->deferred_paths.empty())
+    return false;
+
+  ++unwind_bound;
+  worklist->defer_exceeded_loops = unwind_bound < *max_unwind_bound;
+
+  log.status() << "Raising the unwinding bound to " << unwind_bound
+               << ", resuming " << worklist->deferred_paths.size()
+               << " deferred paths" << messaget::eom;
+
+  worklist->resume_deferred_paths();
+  return true;
 }
 
 bool single_path_symex_only_checkert::resume_path(path_storaget::patht &path)
@@ -98,11 +132,25 @@ bool single_path_symex_only_checkert::resume_path(path_storaget::patht &path)
     symex_symbol_table);
   postprocess_equation(symex, path.equation, options, ns, ui_message_handler);
 
+  if(symex.memory_limit_reached())
+    memory_limit_reached = true;
+  if(symex.paths_abandoned())
+    paths_abandoned = true;
+
   equation_output(symex, path.equation);
 
   return is_ready_to_decide(symex, path);
 }
 
+void single_path_symex_only_checkert::output_coverage()
+{
+  output_coverage_report(
+    options.get_option("symex-coverage-report"),
+    goto_model,
+    coverage,
+    ui_message_handler);
+}
+
 bool single_path_symex_only_checkert::is_ready_to_decide(
   const symex_bmct &,
   const path_storaget::patht &)
@@ -115,11 +163,9 @@ void single_path_symex_only_checkert::equation_output(
   const symex_bmct &symex,
   const symex_target_equationt &equation)
 {
-  output_coverage_report(
-    options.get_option("symex-coverage-report"),
-    goto_model,
-    symex,
-    ui_message_handler);
+  // the report is written once exploration stops, see output_coverage
+  if(symex.record_coverage)
+    coverage.merge(symex.get_coverage());
 
   if(options.get_bool_option("show-vcc"))
     show_vcc(options, ui_message_handler, equation);
@@ -136,6 +182,10 @@ void single_path_symex_only_checkert::equation_output(
 void single_path_symex_only_checkert::setup_symex(symex_bmct &symex)
 {
   ::setup_symex(symex, ns, options, ui_message_handler);
+  symex.relevant_symbols = relevant_symbols;
+
+  if(max_unwind_bound.has_value())
+    symex.unwindset.parse_unwind(std::to_string(unwind_bound));
 }
 
 void single_path_symex_only_checkert::update_properties(
@@ -154,6 +204,14 @@ void single_path_symex_only_checkert::final_update_properties(
   propertiest &properties,
   std::unordered_set<irep_idt> &updated_properties)
 {
+  // Properties may fail on the paths that have not been explored.
+  if(paths_abandoned)
+  {
+    update_status_of_not_checked_properties_to_unknown(
+      properties, updated_properties);
+    return;
+  }
+
   // For now, we assume that NOT_REACHED properties are PASS.
   update_status_of_not_checked_properties(properties, updated_properties);
 
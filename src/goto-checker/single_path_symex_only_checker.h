@@ -14,8 +14,12 @@ Author: Daniel Kroening, Peter Schrammel
 
 #include "incremental_goto_checker.h"
 
+#include <util/optional.h>
+
 #include <goto-symex/path_storage.h>
 
+#include "symex_coverage.h"
+
 class symex_bmct;
 
 /// Uses goto-symex to generate a `symex_target_equationt` for each path.
@@ -38,6 +42,17 @@ protected:
   guard_managert guard_manager;
   std::unique_ptr<path_storaget> worklist;
 
+  /// Shared by the symex runs of all paths, see
+  /// \ref goto_symext::relevant_symbols
+  std::shared_ptr<const std::unordered_set<irep_idt>> relevant_symbols;
+
+  /// The executions recorded by the symex runs of all paths explored so far,
+  /// for `--symex-coverage-report`
+  symex_coveraget coverage;
+
+  /// Write the coverage report of the paths explored so far, if requested
+  void output_coverage();
+
   void equation_output(
     const symex_bmct &symex,
     const symex_target_equationt &equation);
@@ -71,6 +86,26 @@ protected:
   virtual void final_update_properties(
     propertiest &properties,
     std::unordered_set<irep_idt> &updated_properties);
+
+  /// With `--unwind-max`, the unwinding bound of the current round: paths are
+  /// explored with this bound, and the paths that exceed it are deferred to
+  /// the next round, which raises the bound by one up to `--unwind-max`
+  unsigned unwind_bound = 0;
+  optionalt<unsigned> max_unwind_bound;
+
+  /// If paths have been deferred and the bound can still be raised, start the
+  /// next round of incremental unwinding by moving the deferred paths into
+  /// the worklist
+  /// \return True if a new round has been started
+  bool next_unwinding_round();
+
+  /// Set once symex has abandoned a path for lack of memory, after which no
+  /// further paths are explored
+  bool memory_limit_reached = false;
+
+  /// Set once symex has abandoned a path, after which properties are no
+  /// longer taken to pass
+  bool paths_abandoned = false;
 };
 
 #endif // CPROVER_GOTO_CHECKER_SINGLE_PATH_SYMEX_ONLY_CHECKER_H
@@ -0,0 +1,179 @@
+/*******************************************************************\
+
+Module: Goto Checker using Single Path Symbolic Execution and
+        Parallel Path Exploration
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Goto Checker using Single Path Symbolic Execution and
+/// Parallel Path Exploration
+
+#include "single_path_symex_parallel_checker.h"
+
+#include <chrono>
+
+#include <util/forked_workers.h>
+#include <util/make_unique.h>
+
+single_path_symex_parallel_checkert::single_path_symex_parallel_checkert(
+  const optionst &options,
+  ui_message_handlert &ui_message_handler,
+  abstract_goto_modelt &goto_model)
+  : single_path_symex_checkert(options, ui_message_handler, goto_model)
+{
+}
+
+incremental_goto_checkert::resultt single_path_symex_parallel_checkert::
+operator()(propertiest &properties)
+{
+  resultt result(resultt::progresst::DONE);
+
+  // all properties are decided in the first invocation
+  if(symex_initialized)
+    return result;
+
+  symex_initialized = true;
+  initialize_worklist();
+
+  const std::size_t number_of_workers = std::max<std::size_t>(
+    1, options.get_unsigned_int_option("parallel-paths"));
+
+  // explore sequentially until there is enough work for all workers
+  while(!has_finished_exploration(properties) &&
+        worklist->size() < number_of_workers)
+  {
+    explore_next_path(properties, result.updated_properties);
+  }
+
+  if(!has_finished_exploration(properties))
+  {
+    explore_in_parallel(
+      std::min(number_of_workers, worklist->size()),
+      properties,
+      result.updated_properties);
+  }
+
+  output_coverage();
+  final_update_properties(properties, result.updated_properties);
+
+  return result;
+}
+
+void single_path_symex_parallel_checkert::explore_next_path(
+  propertiest &properties,
+  std::unordered_set<irep_idt> &updated_properties)
+{
+  path_storaget::patht &path = worklist->peek();
+
+  if(resume_path(path))
+  {
+    update_properties(properties, updated_properties, path.equation);
+
+    property_decider = util_make_unique<goto_symex_property_decidert>(
+      options, ui_message_handler, path.equation, ns);
+
+    std::chrono::duration<double> solver_runtime =
+      prepare_property_decider(properties, path.equation, *property_decider);
+
+    // find all violations on this path
+    while(true)
+    {
+      resultt result(resultt::progresst::DONE);
+      run_property_decider(
+        result, properties, *property_decider, solver_runtime);
+      solver_runtime = std::chrono::duration<double>(0);
+
+      updated_properties.insert(
+        result.updated_properties.begin(), result.updated_properties.end());
+
+      if(result.progress != resultt::progresst::FOUND_FAIL)
+        break;
+    }
+  }
+
+  // the decider refers to the equation of the path we are about to drop
+  property_decider.reset();
+  worklist->pop();
+}
+
+void single_path_symex_parallel_checkert::explore_in_parallel(
+  std::size_t number_of_workers,
+  propertiest &properties,
+  std::unordered_set<irep_idt> &updated_properties)
+{
+  messaget log(ui_message_handler);
+  log.status() << "Exploring " << worklist->size() << " saved paths in "
+               << number_of_workers << " parallel processes" << messaget::eom;
+
+  const auto worker_results =
+    run_forked_workers(number_of_workers, [&](std::size_t worker) {
+      // workers run concurrently, keep their output to errors
+      ui_message_handler.set_verbosity(messaget::M_ERROR);
+
+      worklist->retain_share(worker, number_of_workers);
+      // paths deferred before the fork are continued by the first worker
+      if(worker != 0)
+        worklist->deferred_paths.clear();
+
+      // report only the coverage of this worker's share, the parent holds
+      // that of the paths explored before forking
+      coverage.clear();
+
+      std::unordered_set<irep_idt> worker_updated_properties;
+      while(!has_finished_exploration(properties))
+        explore_next_path(properties, worker_updated_properties);
+
+      final_update_properties(properties, worker_updated_properties);
+
+      // coverage lines are skipped by deserialize_property_status
+      return serialize_property_status(properties) + coverage.serialize();
+    });
+
+  // The workers explore disjoint sets of paths: a property is violated if it
+  // is violated on the paths of any of the workers.
+  std::unordered_map<irep_idt, property_statust> merged_status;
+
+  for(std::size_t worker = 0; worker < number_of_workers; ++worker)
+  {
+    std::unordered_map<irep_idt, property_statust> worker_status;
+    if(worker_results[worker].has_value())
+    {
+      worker_status = deserialize_property_status(*worker_results[worker]);
+      coverage.merge_serialized(*worker_results[worker]);
+    }
+    else
+    {
+      log.error() << "parallel path worker " << worker
+                  << " failed to report results" << messaget::eom;
+    }
+
+    for(const auto &property_pair : properties)
+    {
+      const auto status_it = worker_status.find(property_pair.first);
+      const property_statust status = status_it == worker_status.end()
+                                        ? property_statust::ERROR
+                                        : status_it->second;
+
+      // an error of any worker is kept, as &= would let ERROR be
+      // overridden by the status that another worker reports
+      auto entry = merged_status.emplace(property_pair.first, status);
+      if(!entry.second && entry.first->second != property_statust::ERROR)
+        entry.first->second &= status;
+    }
+  }
+
+  for(const auto &status_pair : merged_status)
+  {
+    property_statust &status = properties.at(status_pair.first).status;
+    if(status != status_pair.second)
+    {
+      status = status_pair.second;
+      updated_properties.insert(status_pair.first);
+    }
+  }
+
+  worklist->clear();
+}
@@ -0,0 +1,54 @@
+/*******************************************************************\
+
+Module: Goto Checker using Single Path Symbolic Execution and
+        Parallel Path Exploration
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Goto Checker using Single Path Symbolic Execution and
+/// Parallel Path Exploration
+
+#ifndef CPROVER_GOTO_CHECKER_SINGLE_PATH_SYMEX_PARALLEL_CHECKER_H
+#define CPROVER_GOTO_CHECKER_SINGLE_PATH_SYMEX_PARALLEL_CHECKER_H
+
+#include "single_path_symex_checker.h"
+
+/// Explores paths one at a time like \ref single_path_symex_checkert until
+/// the worklist holds at least `parallel-paths` saved paths. The saved paths
+/// are then split into shares by \ref path_storaget::retain_share, and each
+/// share is explored to completion, using a symex and solver instance of its
+/// own, in a forked worker process. The property status reported by the
+/// workers is merged back into the properties given to `operator()`.
+///
+/// All properties are decided in the first invocation, and no traces are
+/// available afterwards; this checker is therefore meant to be used with
+/// \ref all_properties_verifiert.
+class single_path_symex_parallel_checkert : public single_path_symex_checkert
+{
+public:
+  single_path_symex_parallel_checkert(
+    const optionst &options,
+    ui_message_handlert &ui_message_handler,
+    abstract_goto_modelt &goto_model);
+
+  resultt operator()(propertiest &) override;
+
+protected:
+  /// Resume and decide the next path in the worklist, then remove it
+  /// from the worklist.
+  void explore_next_path(
+    propertiest &properties,
+    std::unordered_set<irep_idt> &updated_properties);
+
+  /// Split the worklist across worker processes and merge their results
+  /// into \p properties.
+  void explore_in_parallel(
+    std::size_t number_of_workers,
+    propertiest &properties,
+    std::unordered_set<irep_idt> &updated_properties);
+};
+
+#endif // CPROVER_GOTO_CHECKER_SINGLE_PATH_SYMEX_PARALLEL_CHECKER_H
@@ -14,6 +14,7 @@ Author: Daniel Kroening, Peter Schrammel
 #include <iostream>
 
 #include <util/exception_utils.h>
+#include <util/magic.h>
 #include <util/make_unique.h>
 #include <util/message.h>
 #include <util/namespace.h>
@@ -27,12 +28,25 @@ Author: Daniel Kroening, Peter Schrammel
 #include <solvers/stack_decision_procedure.h>
 
 #include <solvers/flattening/bv_dimacs.h>
+#include <solvers/prop/aig_prop.h>
 #include <solvers/prop/prop.h>
 #include <solvers/prop/prop_conv.h>
 #include <solvers/prop/solver_resource_limits.h>
 #include <solvers/refinement/bv_refinement.h>
 #include <solvers/sat/dimacs_cnf.h>
+#include <solvers/sat/sat_portfolio.h>
 #include <solvers/sat/satcheck.h>
+#include <solvers/sat/satcheck_ipasir_dynamic.h>
+#ifdef HAVE_CADICAL
+#  include <solvers/sat/satcheck_cadical.h>
+#endif
+#ifdef HAVE_GLUCOSE
+#  include <solvers/sat/satcheck_glucose.h>
+#endif
+#ifdef HAVE_MINISAT2
+#  include <solvers/sat/satcheck_minisat2.h>
+#endif
+#include <solvers/smt2/smt2_incremental_dec.h>
 #include <solvers/strings/string_refinement.h>
 
 solver_factoryt::solver_factoryt(
@@ -66,6 +80,8 @@ solver_factoryt::solvert::solvert(
 {
 }
 
+solver_factoryt::solvert::~solvert() = default;
+
 decision_proceduret &solver_factoryt::solvert::decision_procedure() const
 {
   PRECONDITION(decision_procedure_ptr != nullptr);
@@ -111,6 +127,28 @@ void solver_factoryt::set_decision_procedure_time_limit(
   }
 }
 
+void solver_factoryt::set_decision_procedure_memory_limit(
+  decision_proceduret &decision_procedure)
+{
+  const std::size_t limit_mib = options.get_unsigned_int_option("memory-limit");
+
+  if(limit_mib > 0)
+  {
+    solver_resource_limitst *solver =
+      dynamic_cast<solver_resource_limitst *>(&decision_procedure);
+    if(solver == nullptr)
+    {
+      messaget log(message_handler);
+      log.warning() << "cannot set solver memory limit on "
+                    << decision_procedure.decision_procedure_text()
+                    << messaget::eom;
+      return;
+    }
+
+    solver->set_memory_limit_bytes(limit_mib * 1024 * 1024 / 10 * 9);
+  }
+}
+
 void solver_factoryt::solvert::set_decision_procedure(
   std::unique_ptr<decision_proceduret> p)
 {
@@ -169,15 +207,150 @@ smt2_dect::solvert solver_factoryt::get_smt2_solver_type() const
   return s;
 }
 
+void solver_factoryt::set_sat_preset(propt &prop)
+{
+  const std::string &preset = options.get_option("sat-preset");
+
+  if(preset.empty())
+    return;
+
+#ifdef HAVE_CADICAL
+  satcheck_cadicalt *cadical = dynamic_cast<satcheck_cadicalt *>(&prop);
+  if(cadical != nullptr)
+  {
+    if(!cadical->set_preset(preset))
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "unknown SAT solver preset " + preset,
+        "--sat-preset",
+        "sat, unsat or plain");
+    }
+    return;
+  }
+#endif
+
+  messaget log(message_handler);
+  log.warning() << "cannot set SAT solver preset on " << prop.solver_text()
+                << messaget::eom;
+}
+
+void solver_factoryt::set_multiplier_encoding(boolbvt &boolbv)
+{
+  const std::string &encoding = options.get_option("multiplier-encoding");
+
+  if(encoding.empty() || encoding == "shift-add")
+    boolbv.set_multiplier_encoding(bv_utilst::multiplier_encodingt::SHIFT_ADD);
+  else if(encoding == "wallace")
+  {
+    boolbv.set_multiplier_encoding(
+      bv_utilst::multiplier_encodingt::WALLACE_TREE);
+  }
+  else if(encoding == "dadda")
+    boolbv.set_multiplier_encoding(bv_utilst::multiplier_encodingt::DADDA_TREE);
+  else
+  {
+    throw invalid_command_line_argument_exceptiont(
+      "unknown multiplier encoding " + encoding,
+      "--multiplier-encoding",
+      "shift-add, wallace or dadda");
+  }
+}
+
+/// Sets the refinement schedule in \p info as given by the `refine-schedule`
+/// and `max-refinements-per-iteration` options
+static void
+set_refinement_schedule(const optionst &options, bv_refinementt::infot &info)
+{
+  const std::string &schedule = options.get_option("refine-schedule");
+
+  if(schedule.empty() || schedule == "in-order")
+    info.schedule = bv_refinementt::schedulet::IN_ORDER;
+  else if(schedule == "cheapest-first")
+    info.schedule = bv_refinementt::schedulet::CHEAPEST_FIRST;
+  else
+  {
+    throw invalid_command_line_argument_exceptiont(
+      "unknown refinement schedule " + schedule,
+      "--refine-schedule",
+      "in-order or cheapest-first");
+  }
+
+  if(options.is_set("max-refinements-per-iteration"))
+  {
+    info.max_refinements_per_iteration =
+      options.get_unsigned_int_option("max-refinements-per-iteration");
+  }
+}
+
+/// \return A portfolio of the SAT solvers that have been linked in, with and
+///   without preprocessing where they support it
+static std::unique_ptr<propt>
+make_sat_portfolio(const optionst &options, message_handlert &message_handler)
+{
+  auto portfolio = util_make_unique<sat_portfoliot>(message_handler);
+
+  if(options.is_set("sat-portfolio-time-slice"))
+  {
+    portfolio->set_time_slice_seconds(
+      options.get_unsigned_int_option("sat-portfolio-time-slice"));
+  }
+
+#ifdef HAVE_MINISAT2
+  portfolio->add_solver(
+    util_make_unique<satcheck_minisat_no_simplifiert>(message_handler));
+  portfolio->add_solver(
+    util_make_unique<satcheck_minisat_simplifiert>(message_handler));
+#endif
+#ifdef HAVE_GLUCOSE
+  portfolio->add_solver(
+    util_make_unique<satcheck_glucose_no_simplifiert>(message_handler));
+  portfolio->add_solver(
+    util_make_unique<satcheck_glucose_simplifiert>(message_handler));
+#endif
+#ifdef HAVE_CADICAL
+  portfolio->add_solver(util_make_unique<satcheck_cadicalt>(message_handler));
+#endif
+
+  return std::move(portfolio);
+}
+
 std::unique_ptr<solver_factoryt::solvert> solver_factoryt::get_default()
 {
   auto solver = util_make_unique<solvert>();
 
-  if(
-    options.get_bool_option("beautify") ||
-    !options.get_bool_option("sat-preprocessor")) // no simplifier
+  if(options.get_bool_option("aig"))
+  {
+    // Nodes of the graph are converted lazily, possibly after solving, such
+    // that the SAT preprocessor must not eliminate any variables.
+    solver->set_prop(util_make_unique<aig_prop_solvert>(
+      util_make_unique<satcheck_no_simplifiert>(message_handler),
+      message_handler));
+  }
+  else if(options.get_bool_option("sat-portfolio"))
+  {
+    no_beautification();
+    solver->set_prop(make_sat_portfolio(options, message_handler));
+  }
+  else if(options.is_set("sat-solver-library"))
+  {
+    // The library may implement any preprocessing of its own, which IPASIR
+    // does not allow us to restrict.
+    no_beautification();
+    try
+    {
+      solver->set_prop(util_make_unique<satcheck_ipasir_dynamict>(
+        options.get_option("sat-solver-library"), message_handler));
+    }
+    catch(const system_exceptiont &e)
+    {
+      throw invalid_command_line_argument_exceptiont(
+        e.what(),
+        "--sat-solver-library",
+        "a shared library implementing the IPASIR interface");
+    }
+  }
+  else if(!options.get_bool_option("sat-preprocessor")) // no simplifier
   {
-    // simplifier won't work with beautification
     solver->set_prop(
       util_make_unique<satcheck_no_simplifiert>(message_handler));
   }
@@ -186,6 +359,8 @@ std::unique_ptr<solver_factoryt::solvert> solver_factoryt::get_default()
     solver->set_prop(util_make_unique<satcheckt>(message_handler));
   }
 
+  set_sat_preset(solver->prop());
+
   auto bv_pointers =
     util_make_unique<bv_pointerst>(ns, solver->prop(), message_handler);
 
@@ -194,7 +369,13 @@ std::unique_ptr<solver_factoryt::solvert> solver_factoryt::get_default()
   else if(options.get_option("arrays-uf") == "always")
     bv_pointers->unbounded_array = bv_pointerst::unbounded_arrayt::U_ALL;
 
+  // beautification adds constraints over the symbols after solving
+  if(options.get_bool_option("beautify"))
+    bv_pointers->set_symbols_frozen();
+
+  set_multiplier_encoding(*bv_pointers);
   set_decision_procedure_time_limit(*bv_pointers);
+  set_decision_procedure_memory_limit(*bv_pointers);
   solver->set_decision_procedure(std::move(bv_pointers));
 
   return solver;
@@ -205,13 +386,41 @@ std::unique_ptr<solver_factoryt::solvert> solver_factoryt::get_dimacs()
   no_beautification();
   no_incremental_check();
 
-  auto prop = util_make_unique<dimacs_cnft>(message_handler);
-
   std::string filename = options.get_option("outfile");
 
+  if(filename.empty() || filename == "-")
+  {
+    auto prop = util_make_unique<dimacs_cnft>(message_handler);
+
+    auto bv_dimacs =
+      util_make_unique<bv_dimacst>(ns, *prop, message_handler, filename);
+    set_multiplier_encoding(*bv_dimacs);
+    return util_make_unique<solvert>(std::move(bv_dimacs), std::move(prop));
+  }
+
+  // write the clauses to the file while they are generated
+#ifdef _MSC_VER
+  auto out = util_make_unique<std::ofstream>(widen(filename));
+#else
+  auto out = util_make_unique<std::ofstream>(filename);
+#endif
+
+  if(!*out)
+  {
+    throw invalid_command_line_argument_exceptiont(
+      "failed to open file: " + filename, "--outfile");
+  }
+
+  auto prop = util_make_unique<dimacs_cnf_streamt>(*out, message_handler);
+
   auto bv_dimacs =
     util_make_unique<bv_dimacst>(ns, *prop, message_handler, filename);
-  return util_make_unique<solvert>(std::move(bv_dimacs), std::move(prop));
+  set_multiplier_encoding(*bv_dimacs);
+
+  auto solver =
+    util_make_unique<solvert>(std::move(bv_dimacs), std::move(prop));
+  solver->set_ofstream(std::move(out));
+  return solver;
 }
 
 std::unique_ptr<solver_factoryt::solvert> solver_factoryt::get_bv_refinement()
@@ -226,6 +435,8 @@ std::unique_ptr<solver_factoryt::solvert> solver_factoryt::get_bv_refinement()
     return util_make_unique<satcheck_no_simplifiert>(message_handler);
   }();
 
+  set_sat_preset(*prop);
+
   bv_refinementt::infot info;
   info.ns = &ns;
   info.prop = prop.get();
@@ -238,10 +449,13 @@ std::unique_ptr<solver_factoryt::solvert> solver_factoryt::get_bv_refinement()
 
   info.refine_arrays = options.get_bool_option("refine-arrays");
   info.refine_arithmetic = options.get_bool_option("refine-arithmetic");
+  set_refinement_schedule(options, info);
   info.message_handler = &message_handler;
 
   auto decision_procedure = util_make_unique<bv_refinementt>(info);
+  set_multiplier_encoding(*decision_procedure);
   set_decision_procedure_time_limit(*decision_procedure);
+  set_decision_procedure_memory_limit(*decision_procedure);
   return util_make_unique<solvert>(
     std::move(decision_procedure), std::move(prop));
 }
@@ -257,16 +471,34 @@ solver_factoryt::get_string_refinement()
   auto prop = util_make_unique<satcheck_no_simplifiert>(message_handler);
   info.prop = prop.get();
   info.refinement_bound = DEFAULT_MAX_NB_REFINEMENT;
+  if(options.is_set("max-string-refinement-rounds"))
+    info.refinement_bound =
+      options.get_unsigned_int_option("max-string-refinement-rounds");
+  if(options.is_set("string-refinement-time-limit"))
+    info.refinement_time_limit =
+      options.get_unsigned_int_option("string-refinement-time-limit");
+  // Short strings are cheaper to handle by a complete instantiation of the
+  // quantified constraints than by refinement
+  if(
+    options.is_set("max-nondet-string-length") &&
+    options.get_unsigned_int_option("max-nondet-string-length") <=
+      MAX_EAGER_STRING_INSTANTIATION_LENGTH)
+  {
+    info.eager_instantiation_bound =
+      options.get_unsigned_int_option("max-nondet-string-length");
+  }
   info.output_xml = output_xml_in_refinement;
   if(options.get_bool_option("max-node-refinement"))
     info.max_node_refinement =
       options.get_unsigned_int_option("max-node-refinement");
   info.refine_arrays = options.get_bool_option("refine-arrays");
   info.refine_arithmetic = options.get_bool_option("refine-arithmetic");
+  set_refinement_schedule(options, info);
   info.message_handler = &message_handler;
 
   auto decision_procedure = util_make_unique<string_refinementt>(info);
   set_decision_procedure_time_limit(*decision_procedure);
+  set_decision_procedure_memory_limit(*decision_procedure);
   return util_make_unique<solvert>(
     std::move(decision_procedure), std::move(prop));
 }
@@ -288,12 +520,35 @@ solver_factoryt::get_smt2(smt2_dect::solvert solver)
         "provide a filename with --outfile");
     }
 
-    auto smt2_dec = util_make_unique<smt2_dect>(
-      ns,
-      "cbmc",
-      std::string("Generated by CBMC ") + CBMC_VERSION,
-      "QF_AUFBV",
-      solver);
+    std::unique_ptr<smt2_dect> smt2_dec;
+
+    if(
+      options.get_bool_option("smt2-incremental") &&
+      smt2_incremental_dect::is_supported(solver))
+    {
+      smt2_dec = util_make_unique<smt2_incremental_dect>(
+        ns,
+        "cbmc",
+        std::string("Generated by CBMC ") + CBMC_VERSION,
+        "QF_AUFBV",
+        solver);
+    }
+    else
+    {
+      if(options.get_bool_option("smt2-incremental"))
+      {
+        messaget log(message_handler);
+        log.warning() << "incremental SMT2 solving is not supported for "
+                      << "this solver on this platform" << messaget::eom;
+      }
+
+      smt2_dec = util_make_unique<smt2_dect>(
+        ns,
+        "cbmc",
+        std::string("Generated by CBMC ") + CBMC_VERSION,
+        "QF_AUFBV",
+        solver);
+    }
     smt2_dec->set_message_handler(message_handler);
 
     if(options.get_bool_option("fpa"))
@@ -16,6 +16,9 @@ Author: Daniel Kroening, Peter Schrammel
 
 #include <solvers/smt2/smt2_dec.h>
 
+class boolbvt;
+class propt;
+
 class message_handlert;
 class namespacet;
 class optionst;
@@ -45,6 +48,9 @@ public:
       std::unique_ptr<decision_proceduret> p1,
       std::unique_ptr<std::ofstream> p2);
 
+    // out of line, as propt is incomplete here
+    ~solvert();
+
     decision_proceduret &decision_procedure() const;
     stack_decision_proceduret &stack_decision_procedure() const;
     propt &prop() const;
@@ -84,6 +90,20 @@ protected:
   void
   set_decision_procedure_time_limit(decision_proceduret &decision_procedure);
 
+  /// Sets the memory limit of \p decision_procedure if the `memory-limit`
+  /// option has a positive value (in MiB), leaving some headroom for building
+  /// traces once the solver has given up.
+  void
+  set_decision_procedure_memory_limit(decision_proceduret &decision_procedure);
+
+  /// Configures \p prop as given by the `sat-preset` option, if set, which
+  /// is only supported by CaDiCaL at the moment
+  void set_sat_preset(propt &prop);
+
+  /// Selects the multiplier circuit of \p boolbv as given by the
+  /// `multiplier-encoding` option
+  void set_multiplier_encoding(boolbvt &boolbv);
+
   // consistency checks during solver creation
   void no_beautification();
   void no_incremental_check();
@@ -118,7 +118,7 @@ bool symex_bmct::should_stop_unwind(
   const call_stackt &context,
   unsigned unwind)
 {
-  const irep_idt id = goto_programt::loop_id(source.function_id, *source.pc);
+  const irep_idt id = get_loop_id(source.function_id, *source.pc);
 
   tvt abort_unwind_decision;
   unsigned this_loop_limit = std::numeric_limits<unsigned>::max();
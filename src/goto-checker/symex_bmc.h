@@ -73,11 +73,9 @@ public:
     recursion_unwind_handlers.push_back(handler);
   }
 
-  bool output_coverage_report(
-    const goto_functionst &goto_functions,
-    const std::string &path) const
+  const symex_coveraget &get_coverage() const
   {
-    return symex_coverage.generate_report(goto_functions, path);
+    return symex_coverage;
   }
 
   const bool record_coverage;
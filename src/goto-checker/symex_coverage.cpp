@@ -13,10 +13,13 @@ Date: March 2016
 
 #include "symex_coverage.h"
 
+#include <algorithm>
 #include <chrono>
 #include <ctime>
 #include <fstream>
 #include <iostream>
+#include <map>
+#include <sstream>
 
 #include <util/string2int.h>
 #include <util/xml.h>
@@ -28,67 +31,47 @@ Date: March 2016
 
 #include <linking/static_lifetime_init.h>
 
-class coverage_recordt
+/// Line and branch counts of a method, class or package
+struct coverage_totalst
 {
-public:
-  explicit coverage_recordt(const std::string &node_id)
-    : xml(node_id),
-      lines_covered(0),
-      lines_total(0),
-      branches_covered(0),
-      branches_total(0)
+  std::size_t lines_covered = 0;
+  std::size_t lines_total = 0;
+  std::size_t branches_covered = 0;
+  std::size_t branches_total = 0;
+
+  coverage_totalst &operator+=(const coverage_totalst &other)
   {
+    lines_covered += other.lines_covered;
+    lines_total += other.lines_total;
+    branches_covered += other.branches_covered;
+    branches_total += other.branches_total;
+    return *this;
   }
-
-  xmlt xml;
-  std::size_t lines_covered;
-  std::size_t lines_total;
-  std::size_t branches_covered;
-  std::size_t branches_total;
 };
 
-class goto_program_coverage_recordt : public coverage_recordt
+struct coverage_linet
 {
-public:
-  goto_program_coverage_recordt(
-    const namespacet &ns,
-    goto_functionst::function_mapt::const_iterator gf_it,
-    const symex_coveraget::coveraget &coverage);
-
-  const irep_idt &get_file() const
-  {
-    return file_name;
-  }
-
-protected:
-  irep_idt file_name;
-
-  struct coverage_conditiont
-  {
-    coverage_conditiont() : false_taken(false), true_taken(false)
-    {
-    }
-
-    bool false_taken;
-    bool true_taken;
-  };
-
-  struct coverage_linet
-  {
-    coverage_linet() : hits(0)
-    {
-    }
+  /// Maximum number of executions of any instruction of the line
+  unsigned hits = 0;
+  /// For each branch instruction of the line, the number of its two
+  /// successors that have been taken
+  std::vector<unsigned char> conditions;
+};
 
-    unsigned hits;
-    std::map<goto_programt::const_targett, coverage_conditiont> conditions;
-  };
+typedef std::map<unsigned, coverage_linet> coverage_linest;
 
-  typedef std::map<unsigned, coverage_linet> coverage_lines_mapt;
+struct method_recordt
+{
+  irep_idt name;
+  std::string signature;
+  coverage_totalst totals;
+  coverage_linest lines;
+};
 
-  void compute_coverage_lines(
-    const goto_programt &goto_program,
-    const symex_coveraget::coveraget &coverage,
-    coverage_lines_mapt &dest);
+struct class_recordt
+{
+  std::vector<method_recordt> methods;
+  coverage_totalst totals;
 };
 
 static std::string
@@ -124,88 +107,69 @@ rate_detailed(std::size_t covered, std::size_t total, bool per_cent = false)
   return oss.str();
 }
 
-goto_program_coverage_recordt::goto_program_coverage_recordt(
-  const namespacet &ns,
-  goto_functionst::function_mapt::const_iterator gf_it,
-  const symex_coveraget::coveraget &coverage)
-  : coverage_recordt("method")
+void symex_coveraget::merge(const symex_coveraget &other)
 {
-  PRECONDITION(gf_it->second.body_available());
-
-  // identify the file name, inlined functions aren't properly
-  // accounted for
-  goto_programt::const_targett end_function =
-    --gf_it->second.body.instructions.end();
-  DATA_INVARIANT(
-    end_function->is_end_function(),
-    "last instruction in a function body is end function");
-  file_name = end_function->source_location.get_file();
-  DATA_INVARIANT(!file_name.empty(), "should have a valid source location");
-
-  // compute the maximum coverage of individual source-code lines
-  coverage_lines_mapt coverage_lines_map;
-  compute_coverage_lines(gf_it->second.body, coverage, coverage_lines_map);
-
-  // <method name="foo" signature="int(int)" line-rate="1.0" branch-rate="1.0">
-  //   <lines>
-  //     <line number="23" hits="1" branch="false"/>
-  //     <line number="24" hits="1" branch="false"/>
-  //     <line number="25" hits="1" branch="false"/>
-  //     <line number="26" hits="1" branch="false"/>
-  //     <line number="27" hits="1" branch="false"/>
-  //     <line number="28" hits="1" branch="false"/>
-  //     <line number="29" hits="1" branch="false"/>
-  //     <line number="30" hits="1" branch="false"/>
-  //   </lines>
-  // </method>
-  xml.set_attribute("name", id2string(gf_it->first));
-
-  xml.set_attribute(
-    "signature", from_type(ns, gf_it->first, gf_it->second.type));
-
-  xml.set_attribute("line-rate", rate_detailed(lines_covered, lines_total));
-  xml.set_attribute("branch-rate", rate(branches_covered, branches_total));
-
-  xmlt &lines = xml.new_element("lines");
-
-  for(const auto &cov_line : coverage_lines_map)
+  if(other.coverage.size() > coverage.size())
+    coverage.resize(other.coverage.size());
+
+  for(std::size_t i = 0; i < other.coverage.size(); ++i)
   {
-    xmlt &line = lines.new_element("line");
+    coverage[i].taken += other.coverage[i].taken;
+    coverage[i].not_taken += other.coverage[i].not_taken;
+  }
+}
 
-    line.set_attribute("number", std::to_string(cov_line.first));
-    line.set_attribute("hits", std::to_string(cov_line.second.hits));
-    if(cov_line.second.conditions.empty())
-      line.set_attribute("branch", "false");
-    else
-    {
-      line.set_attribute("branch", "true");
+void symex_coveraget::merge_serialized(const std::string &serialized)
+{
+  std::istringstream in(serialized);
+  std::string line;
 
-      xmlt &conditions = line.new_element("conditions");
+  while(std::getline(in, line))
+  {
+    if(line.compare(0, 9, "coverage ") != 0)
+      continue;
 
-      std::size_t number = 0, total_taken = 0;
-      for(const auto &c : cov_line.second.conditions)
-      {
-        // <condition number="0" type="jump" coverage="50%"/>
-        xmlt &condition = conditions.new_element("condition");
-        condition.set_attribute("number", std::to_string(number++));
-        condition.set_attribute("type", "jump");
-        unsigned taken = c.second.false_taken + c.second.true_taken;
-        total_taken += taken;
-        condition.set_attribute("coverage", rate(taken, 2, true));
-      }
+    std::istringstream fields(line.substr(9));
+    std::size_t location_number;
+    execution_countst counts;
+    if(!(fields >> location_number >> counts.taken >> counts.not_taken))
+      continue;
+
+    if(location_number >= coverage.size())
+      coverage.resize(location_number + 1);
+    coverage[location_number].taken += counts.taken;
+    coverage[location_number].not_taken += counts.not_taken;
+  }
+}
 
-      line.set_attribute(
-        "condition-coverage", rate_detailed(total_taken, number * 2, true));
+std::string symex_coveraget::serialize() const
+{
+  std::ostringstream out;
+  for(std::size_t i = 0; i < coverage.size(); ++i)
+  {
+    if(coverage[i].taken != 0 || coverage[i].not_taken != 0)
+    {
+      out << "coverage " << i << ' ' << coverage[i].taken << ' '
+          << coverage[i].not_taken << '\n';
     }
   }
+  return out.str();
 }
 
-void goto_program_coverage_recordt::compute_coverage_lines(
-  const goto_programt &goto_program,
-  const symex_coveraget::coveraget &coverage,
-  coverage_lines_mapt &dest)
+/// Compute the maximum coverage of the individual source-code lines of the
+/// function \p gf_it, which are in the file \p file_name
+static method_recordt compute_method_record(
+  const namespacet &ns,
+  goto_functionst::function_mapt::const_iterator gf_it,
+  const irep_idt &file_name,
+  const std::vector<symex_coveraget::execution_countst> &coverage)
 {
-  forall_goto_program_instructions(it, goto_program)
+  method_recordt record;
+  record.name = gf_it->first;
+  record.signature = from_type(ns, gf_it->first, gf_it->second.type);
+  coverage_totalst &totals = record.totals;
+
+  forall_goto_program_instructions(it, gf_it->second.body)
   {
     if(
       it->source_location.is_nil() ||
@@ -217,205 +181,270 @@ void goto_program_coverage_recordt::compute_coverage_lines(
 
     unsigned l =
       safe_string2unsigned(id2string(it->source_location.get_line()));
-    std::pair<coverage_lines_mapt::iterator, bool> entry =
-      dest.insert(std::make_pair(l, coverage_linet()));
+    std::pair<coverage_linest::iterator, bool> entry =
+      record.lines.insert(std::make_pair(l, coverage_linet()));
+    coverage_linet &line = entry.first->second;
 
     if(entry.second)
-      ++lines_total;
+      ++totals.lines_total;
 
     // mark as branch if any instruction in this source code line is
     // a branching instruction
     if(is_branch)
     {
-      branches_total += 2;
-      if(!entry.first->second.conditions.insert({it, coverage_conditiont()})
-            .second)
-        UNREACHABLE;
+      totals.branches_total += 2;
+      line.conditions.push_back(0);
     }
 
-    symex_coveraget::coveraget::const_iterator c_entry = coverage.find(it);
-    if(c_entry != coverage.end())
-    {
-      if(!(c_entry->second.size() == 1 || is_branch))
-      {
-        std::cerr << it->location_number << '\n';
-        for(const auto &cov : c_entry->second)
-          std::cerr << cov.second.succ->location_number << '\n';
-      }
-      DATA_INVARIANT(
-        c_entry->second.size() == 1 || is_branch,
-        "instructions other than branch instructions have exactly 1 successor");
+    if(it->location_number >= coverage.size())
+      continue;
 
-      for(const auto &cov : c_entry->second)
-      {
-        DATA_INVARIANT(
-          cov.second.num_executions > 0,
-          "coverage entries can only exist with at least one execution");
-
-        if(entry.first->second.hits == 0)
-          ++lines_covered;
-
-        if(cov.second.num_executions > entry.first->second.hits)
-          entry.first->second.hits = cov.second.num_executions;
-
-        if(is_branch)
-        {
-          auto cond_entry = entry.first->second.conditions.find(it);
-          INVARIANT(
-            cond_entry != entry.first->second.conditions.end(),
-            "branch should have condition");
-
-          if(it->get_target() == cov.second.succ)
-          {
-            if(!cond_entry->second.false_taken)
-            {
-              cond_entry->second.false_taken = true;
-              ++branches_covered;
-            }
-          }
-          else
-          {
-            if(!cond_entry->second.true_taken)
-            {
-              cond_entry->second.true_taken = true;
-              ++branches_covered;
-            }
-          }
-        }
-      }
+    const symex_coveraget::execution_countst &counts =
+      coverage[it->location_number];
+    const unsigned hits = std::max(counts.taken, counts.not_taken);
+    if(hits == 0)
+      continue;
+
+    if(line.hits == 0)
+      ++totals.lines_covered;
+    line.hits = std::max(line.hits, hits);
+
+    if(is_branch)
+    {
+      const unsigned char taken = (counts.taken != 0) + (counts.not_taken != 0);
+      line.conditions.back() = taken;
+      totals.branches_covered += taken;
     }
   }
+
+  return record;
 }
 
-void symex_coveraget::compute_overall_coverage(
-  const goto_functionst &goto_functions,
-  coverage_recordt &dest) const
+static void indent(std::ostream &os, unsigned n)
 {
-  typedef std::map<irep_idt, coverage_recordt> file_recordst;
-  file_recordst file_records;
+  for(unsigned i = 0; i < n; ++i)
+    os << ' ';
+}
 
-  forall_goto_functions(gf_it, goto_functions)
-  {
-    if(
-      !gf_it->second.body_available() ||
-      gf_it->first == goto_functions.entry_point() ||
-      gf_it->first == INITIALIZE_FUNCTION)
-      continue;
+static void
+attribute(std::ostream &os, const char *name, const std::string &value)
+{
+  os << ' ' << name << "=\"";
+  xmlt::escape_attribute(value, os);
+  os << '"';
+}
 
-    goto_program_coverage_recordt func_cov(ns, gf_it, coverage);
+static void output_lines(
+  std::ostream &os,
+  const coverage_linest &lines,
+  unsigned depth)
+{
+  for(const auto &cov_line : lines)
+  {
+    const coverage_linet &line = cov_line.second;
 
-    std::pair<file_recordst::iterator, bool> entry = file_records.insert(
-      std::make_pair(func_cov.get_file(), coverage_recordt("class")));
-    coverage_recordt &file_record = entry.first->second;
+    // <line number="23" hits="1" branch="false"/>
+    indent(os, depth);
+    os << "<line";
+    attribute(os, "branch", line.conditions.empty() ? "false" : "true");
+    if(!line.conditions.empty())
+    {
+      std::size_t total_taken = 0;
+      for(const auto taken : line.conditions)
+        total_taken += taken;
+      attribute(
+        os,
+        "condition-coverage",
+        rate_detailed(total_taken, line.conditions.size() * 2, true));
+    }
+    attribute(os, "hits", std::to_string(line.hits));
+    attribute(os, "number", std::to_string(cov_line.first));
 
-    if(entry.second)
+    if(line.conditions.empty())
     {
-      file_record.xml.new_element("methods");
-      file_record.xml.new_element("lines");
+      os << "/>\n";
+      continue;
     }
 
-    // copy the "method" node
-    file_record.xml.elements.front().new_element(func_cov.xml);
-
-    // copy any lines
-    for(xmlt::elementst::const_iterator it =
-          func_cov.xml.elements.front().elements.begin();
-        it != func_cov.xml.elements.front().elements.end();
-        ++it)
-      file_record.xml.elements.back().new_element(*it);
-
-    // merge line/branch info
-    file_record.lines_covered += func_cov.lines_covered;
-    file_record.lines_total += func_cov.lines_total;
-    file_record.branches_covered += func_cov.branches_covered;
-    file_record.branches_total += func_cov.branches_total;
+    os << ">\n";
+    indent(os, depth + 2);
+    os << "<conditions>\n";
+    std::size_t number = 0;
+    for(const auto taken : line.conditions)
+    {
+      // <condition number="0" type="jump" coverage="50%"/>
+      indent(os, depth + 4);
+      os << "<condition";
+      attribute(os, "coverage", rate(taken, 2, true));
+      attribute(os, "number", std::to_string(number++));
+      attribute(os, "type", "jump");
+      os << "/>\n";
+    }
+    indent(os, depth + 2);
+    os << "</conditions>\n";
+    indent(os, depth);
+    os << "</line>\n";
   }
+}
 
-  xmlt &classes = dest.xml.new_element("classes");
+bool symex_coveraget::output_report(
+  const goto_functionst &goto_functions,
+  std::ostream &os) const
+{
+  // The totals are attributes of the enclosing elements, hence the line
+  // coverage of all methods is computed before any of it is written.
+  std::map<irep_idt, class_recordt> class_records;
 
-  // <class name="MyProject.GameRules" filename="MyProject/GameRules.java"
-  //        line-rate="1.0" branch-rate="1.0" complexity="1.4">
-  for(file_recordst::const_iterator it = file_records.begin();
-      it != file_records.end();
-      ++it)
+  forall_goto_functions(gf_it, goto_functions)
   {
-    if(source_locationt::is_built_in(id2string(it->first)))
+    if(
+      !gf_it->second.body_available() ||
+      gf_it->first == goto_functions.entry_point() ||
+      gf_it->first == INITIALIZE_FUNCTION)
       continue;
 
-    const coverage_recordt &f_cov = it->second;
-
-    xmlt &class_xml = classes.new_element(f_cov.xml);
-    class_xml.set_attribute("name", id2string(it->first));
-    class_xml.set_attribute("filename", id2string(it->first));
-    class_xml.set_attribute(
-      "line-rate", rate(f_cov.lines_covered, f_cov.lines_total));
-    class_xml.set_attribute(
-      "branch-rate", rate(f_cov.branches_covered, f_cov.branches_total));
-    class_xml.set_attribute("complexity", "0.0");
-
-    // merge line/branch info
-    dest.lines_covered += f_cov.lines_covered;
-    dest.lines_total += f_cov.lines_total;
-    dest.branches_covered += f_cov.branches_covered;
-    dest.branches_total += f_cov.branches_total;
+    // identify the file name, inlined functions aren't properly
+    // accounted for
+    goto_programt::const_targett end_function =
+      --gf_it->second.body.instructions.end();
+    DATA_INVARIANT(
+      end_function->is_end_function(),
+      "last instruction in a function body is end function");
+    const irep_idt &file_name = end_function->source_location.get_file();
+    DATA_INVARIANT(!file_name.empty(), "should have a valid source location");
+
+    class_recordt &class_record = class_records[file_name];
+    class_record.methods.push_back(
+      compute_method_record(ns, gf_it, file_name, coverage));
+    class_record.totals += class_record.methods.back().totals;
   }
-}
 
-void symex_coveraget::build_cobertura(
-  const goto_functionst &goto_functions,
-  xmlt &xml_coverage) const
-{
-  coverage_recordt overall_cov("package");
-  compute_overall_coverage(goto_functions, overall_cov);
-
-  std::string overall_line_rate_str =
-    rate(overall_cov.lines_covered, overall_cov.lines_total);
-  std::string overall_branch_rate_str =
-    rate(overall_cov.branches_covered, overall_cov.branches_total);
+  coverage_totalst overall;
+  for(const auto &class_record : class_records)
+  {
+    if(!source_locationt::is_built_in(id2string(class_record.first)))
+      overall += class_record.second.totals;
+  }
 
   auto now = std::chrono::system_clock::now();
   auto current_time = std::chrono::time_point_cast<std::chrono::seconds>(now);
   std::time_t tt = std::chrono::system_clock::to_time_t(current_time);
 
+  os << "<?xml version=\"1.0\"?>\n";
+  os << "<!DOCTYPE coverage SYSTEM \""
+     << "http://cobertura.sourceforge.net/xml/coverage-04.dtd\">\n";
+
   // <coverage line-rate="0.0" branch-rate="0.0" lines-covered="1"
   //           lines-valid="1" branches-covered="1"
   //           branches-valid="1" complexity="0.0"
   //           version="2.1.1" timestamp="0">
-  xml_coverage.set_attribute("line-rate", overall_line_rate_str);
-  xml_coverage.set_attribute("branch-rate", overall_branch_rate_str);
-  xml_coverage.set_attribute(
-    "lines-covered", std::to_string(overall_cov.lines_covered));
-  xml_coverage.set_attribute(
-    "lines-valid", std::to_string(overall_cov.lines_total));
-  xml_coverage.set_attribute(
-    "branches-covered", std::to_string(overall_cov.branches_covered));
-  xml_coverage.set_attribute(
-    "branches-valid", std::to_string(overall_cov.branches_total));
-  xml_coverage.set_attribute("complexity", "0.0");
-  xml_coverage.set_attribute("version", "2.1.1");
-  xml_coverage.set_attribute("timestamp", std::to_string(tt));
-
-  xmlt &packages = xml_coverage.new_element("packages");
+  os << "<coverage";
+  attribute(
+    os, "branch-rate", rate(overall.branches_covered, overall.branches_total));
+  attribute(os, "branches-covered", std::to_string(overall.branches_covered));
+  attribute(os, "branches-valid", std::to_string(overall.branches_total));
+  attribute(os, "complexity", "0.0");
+  attribute(os, "line-rate", rate(overall.lines_covered, overall.lines_total));
+  attribute(os, "lines-covered", std::to_string(overall.lines_covered));
+  attribute(os, "lines-valid", std::to_string(overall.lines_total));
+  attribute(os, "timestamp", std::to_string(tt));
+  attribute(os, "version", "2.1.1");
+  os << ">\n";
 
   // <package name="" line-rate="0.0" branch-rate="0.0" complexity="0.0">
-  xmlt &package = packages.new_element(overall_cov.xml);
-  package.set_attribute("name", "");
-  package.set_attribute("line-rate", overall_line_rate_str);
-  package.set_attribute("branch-rate", overall_branch_rate_str);
-  package.set_attribute("complexity", "0.0");
-}
+  os << "  <packages>\n";
+  os << "    <package";
+  attribute(
+    os, "branch-rate", rate(overall.branches_covered, overall.branches_total));
+  attribute(os, "complexity", "0.0");
+  attribute(os, "line-rate", rate(overall.lines_covered, overall.lines_total));
+  attribute(os, "name", "");
+  os << ">\n";
+  os << "      <classes>\n";
 
-bool symex_coveraget::output_report(
-  const goto_functionst &goto_functions,
-  std::ostream &os) const
-{
-  xmlt xml_coverage("coverage");
-  build_cobertura(goto_functions, xml_coverage);
+  // <class name="MyProject.GameRules" filename="MyProject/GameRules.java"
+  //        line-rate="1.0" branch-rate="1.0" complexity="1.4">
+  for(const auto &class_record : class_records)
+  {
+    if(source_locationt::is_built_in(id2string(class_record.first)))
+      continue;
 
-  os << "<?xml version=\"1.0\"?>\n";
-  os << "<!DOCTYPE coverage SYSTEM \""
-     << "http://cobertura.sourceforge.net/xml/coverage-04.dtd\">\n";
-  os << xml_coverage;
+    const std::string file_name = id2string(class_record.first);
+    os << "        <class";
+    attribute(
+      os,
+      "branch-rate",
+      rate(
+        class_record.second.totals.branches_covered,
+        class_record.second.totals.branches_total));
+    attribute(os, "complexity", "0.0");
+    attribute(os, "filename", file_name);
+    attribute(
+      os,
+      "line-rate",
+      rate(
+        class_record.second.totals.lines_covered,
+        class_record.second.totals.lines_total));
+    attribute(os, "name", file_name);
+    os << ">\n";
+
+    // <method name="foo" signature="int(int)" line-rate="1.0"
+    //         branch-rate="1.0">
+    //   <lines>
+    //     <line number="23" hits="1" branch="false"/>
+    //   </lines>
+    // </method>
+    os << "          <methods>\n";
+    for(const auto &method : class_record.second.methods)
+    {
+      os << "            <method";
+      attribute(
+        os,
+        "branch-rate",
+        rate(method.totals.branches_covered, method.totals.branches_total));
+      attribute(
+        os,
+        "line-rate",
+        rate_detailed(method.totals.lines_covered, method.totals.lines_total));
+      attribute(os, "name", id2string(method.name));
+      attribute(os, "signature", method.signature);
+      os << ">\n";
+
+      if(method.lines.empty())
+        os << "              <lines/>\n";
+      else
+      {
+        os << "              <lines>\n";
+        output_lines(os, method.lines, 16);
+        os << "              </lines>\n";
+      }
+
+      os << "            </method>\n";
+    }
+    os << "          </methods>\n";
+
+    // the lines of all methods of the class
+    bool has_lines = false;
+    for(const auto &method : class_record.second.methods)
+      has_lines |= !method.lines.empty();
+
+    if(!has_lines)
+      os << "          <lines/>\n";
+    else
+    {
+      os << "          <lines>\n";
+      for(const auto &method : class_record.second.methods)
+        output_lines(os, method.lines, 12);
+      os << "          </lines>\n";
+    }
+
+    os << "        </class>\n";
+  }
+
+  os << "      </classes>\n";
+  os << "    </package>\n";
+  os << "  </packages>\n";
+  os << "</coverage>\n";
 
   return !os.good();
 }
@@ -15,16 +15,19 @@ Date: March 2016
 #define CPROVER_CBMC_SYMEX_COVERAGE_H
 
 #include <iosfwd>
-#include <map>
 #include <string>
+#include <vector>
 
 #include <goto-programs/goto_program.h>
 
-class coverage_recordt;
 class goto_functionst;
 class namespacet;
-class xmlt;
 
+/// Counts how often each instruction was executed during symbolic execution
+/// and writes a Cobertura report of the line and branch coverage. The counts
+/// are kept in a vector indexed by the location number of the instruction,
+/// which requires location numbers to be unique across the goto functions of
+/// the model, as \ref goto_functionst::compute_location_numbers makes them.
 class symex_coveraget
 {
 public:
@@ -32,14 +35,44 @@ public:
   {
   }
 
+  struct execution_countst
+  {
+    /// Number of executions of a goto instruction that jumped to its target
+    unsigned taken = 0;
+    /// Number of executions that continued at any other instruction
+    unsigned not_taken = 0;
+  };
+
+  /// Record an execution of \p from that continued at \p to
   void
   covered(goto_programt::const_targett from, goto_programt::const_targett to)
   {
-    std::pair<coverage_innert::iterator, bool> entry =
-      coverage[from].insert({to, coverage_infot(from, to, 1)});
+    const std::size_t location_number = from->location_number;
+    if(location_number >= coverage.size())
+      coverage.resize(location_number + 1);
+
+    if(from->is_goto() && to == from->get_target())
+      ++coverage[location_number].taken;
+    else
+      ++coverage[location_number].not_taken;
+  }
 
-    if(!entry.second)
-      ++(entry.first->second.num_executions);
+  /// Add the executions recorded by \p other, for example by the symbolic
+  /// execution of another path
+  void merge(const symex_coveraget &other);
+
+  /// Add the executions written by \ref serialize, typically in a worker
+  /// process. Lines in other formats are ignored.
+  void merge_serialized(const std::string &serialized);
+
+  /// Write the executions recorded so far as one line per instruction, each
+  /// starting with "coverage ", such that they can be sent along with other
+  /// data
+  std::string serialize() const;
+
+  void clear()
+  {
+    coverage.clear();
   }
 
   bool generate_report(
@@ -49,38 +82,11 @@ public:
 protected:
   const namespacet &ns;
 
-  struct coverage_infot
-  {
-    coverage_infot(
-      goto_programt::const_targett _from,
-      goto_programt::const_targett _to,
-      unsigned _num_executions)
-      : location(_from), num_executions(_num_executions), succ(_to)
-    {
-    }
-
-    goto_programt::const_targett location;
-    unsigned num_executions;
-    goto_programt::const_targett succ;
-  };
-
-  typedef std::map<goto_programt::const_targett, coverage_infot>
-    coverage_innert;
-  typedef std::map<goto_programt::const_targett, coverage_innert> coveraget;
-  coveraget coverage;
+  /// Indexed by the location number of the executed instruction
+  std::vector<execution_countst> coverage;
 
   bool
   output_report(const goto_functionst &goto_functions, std::ostream &os) const;
-
-  void build_cobertura(
-    const goto_functionst &goto_functions,
-    xmlt &xml_coverage) const;
-
-  void compute_overall_coverage(
-    const goto_functionst &goto_functions,
-    coverage_recordt &dest) const;
-
-  friend class goto_program_coverage_recordt;
 };
 
 #endif // CPROVER_CBMC_SYMEX_COVERAGE_H
@@ -14,6 +14,7 @@ Date: April 2016
 #include "change_impact.h"
 
 #include <iostream>
+#include <unordered_map>
 
 #include <goto-programs/goto_model.h>
 
@@ -209,6 +210,8 @@ public:
 
   void operator()();
 
+  change_impact_summaryt summarize();
+
 protected:
   impact_modet impact_mode;
   bool compact_output;
@@ -241,6 +244,13 @@ protected:
 
   goto_functions_change_impactt old_change_impact, new_change_impact;
 
+  void compute();
+
+  static void summarize(
+    const goto_functions_change_impactt &change_impact,
+    const goto_functionst &goto_functions,
+    change_impact_summaryt &summary);
+
   void change_impact(const irep_idt &function_id);
 
   void change_impact(
@@ -485,7 +495,7 @@ void change_impactt::propogate_dep_back(
   }
 }
 
-void change_impactt::operator()()
+void change_impactt::compute()
 {
   // sorted iteration over intersection(old functions, new functions)
   typedef std::map<irep_idt,
@@ -514,6 +524,11 @@ void change_impactt::operator()()
       ++ito;
     }
   }
+}
+
+void change_impactt::operator()()
+{
+  compute();
 
   goto_functions_change_impactt::const_iterator oc_it=
     old_change_impact.begin();
@@ -555,6 +570,70 @@ void change_impactt::operator()()
   }
 }
 
+void change_impactt::summarize(
+  const goto_functions_change_impactt &change_impact,
+  const goto_functionst &goto_functions,
+  change_impact_summaryt &summary)
+{
+  // Dependencies are recorded with the function of the changed instruction
+  // even where they cross into other functions, hence the function of each
+  // instruction is looked up.
+  std::unordered_map<const goto_programt::instructiont *, irep_idt>
+    function_of_instruction;
+  forall_goto_functions(f_it, goto_functions)
+  {
+    forall_goto_program_instructions(i_it, f_it->second.body)
+      function_of_instruction.emplace(&*i_it, f_it->first);
+  }
+
+  for(const auto &function_impact : change_impact)
+  {
+    for(const auto &instruction_impact : function_impact.second)
+    {
+      if(instruction_impact.second == SAME)
+        continue;
+
+      const auto function_it =
+        function_of_instruction.find(&*instruction_impact.first);
+      summary.impacted_functions.insert(
+        function_it == function_of_instruction.end() ? function_impact.first
+                                                     : function_it->second);
+
+      const goto_programt::instructiont &instruction =
+        *instruction_impact.first;
+      if(
+        instruction.is_assume() || instruction.is_function_call() ||
+        instruction.is_backwards_goto())
+      {
+        summary.has_non_local_impact = true;
+      }
+    }
+  }
+}
+
+change_impact_summaryt change_impactt::summarize()
+{
+  compute();
+
+  change_impact_summaryt summary;
+  summarize(old_change_impact, old_goto_functions, summary);
+  summarize(new_change_impact, new_goto_functions, summary);
+
+  // functions that were added or removed
+  forall_goto_functions(it, new_goto_functions)
+  {
+    if(old_goto_functions.function_map.count(it->first) == 0)
+      summary.impacted_functions.insert(it->first);
+  }
+  forall_goto_functions(it, old_goto_functions)
+  {
+    if(new_goto_functions.function_map.count(it->first) == 0)
+      summary.impacted_functions.insert(it->first);
+  }
+
+  return summary;
+}
+
 void change_impactt::output_change_impact(
   const irep_idt &function_id,
   const goto_program_change_impactt &c_i,
@@ -751,3 +830,12 @@ void change_impact(
   change_impactt c(model_old, model_new, impact_mode, compact_output);
   c();
 }
+
+change_impact_summaryt summarize_change_impact(
+  const goto_modelt &model_old,
+  const goto_modelt &model_new,
+  impact_modet impact_mode)
+{
+  change_impactt c(model_old, model_new, impact_mode, false);
+  return c.summarize();
+}
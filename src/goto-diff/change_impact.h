@@ -14,6 +14,10 @@ Date: April 2016
 #ifndef CPROVER_GOTO_DIFF_CHANGE_IMPACT_H
 #define CPROVER_GOTO_DIFF_CHANGE_IMPACT_H
 
+#include <unordered_set>
+
+#include <util/irep.h>
+
 class goto_modelt;
 enum class impact_modet { FORWARD, BACKWARD, BOTH };
 
@@ -23,4 +27,26 @@ void change_impact(
   impact_modet impact_mode,
   bool compact_output);
 
+/// Which parts of a program are affected by changes to it
+struct change_impact_summaryt
+{
+  /// Functions of either model with instructions that changed, or that
+  /// depend on, or are depended on by, changed instructions
+  std::unordered_set<irep_idt> impacted_functions;
+
+  /// True if a changed or impacted instruction is an assumption, a function
+  /// call or a loop. These may restrict the paths to, or the values at,
+  /// instructions that do not depend on them, and thereby affect any part of
+  /// the program.
+  bool has_non_local_impact = false;
+};
+
+/// Summarize the impact of the changes from \p model_old to \p model_new by
+/// function, instead of printing it per instruction as \ref change_impact
+/// does. Functions that exist in only one of the models are impacted.
+change_impact_summaryt summarize_change_impact(
+  const goto_modelt &model_old,
+  const goto_modelt &model_new,
+  impact_modet impact_mode);
+
 #endif // CPROVER_GOTO_DIFF_CHANGE_IMPACT_H
@@ -11,6 +11,7 @@ Author: Peter Schrammel
 
 #include "syntactic_diff.h"
 
+#include <goto-programs/goto_function_hash.h>
 #include <goto-programs/goto_model.h>
 
 bool syntactic_difft::operator()()
@@ -69,7 +70,9 @@ bool syntactic_difft::operator()()
       continue;
     }
 
-    if(!it->second.body.equals(f_it->second.body))
+    if(
+      goto_function_hash(it->first, it->second) !=
+      goto_function_hash(f_it->first, f_it->second))
     {
       modified_functions.insert(it->first);
       continue;
@@ -15,6 +15,7 @@ Date: April 2016
 
 #include <algorithm>
 
+#include <goto-programs/goto_function_hash.h>
 #include <goto-programs/goto_model.h>
 
 unified_difft::unified_difft(
@@ -353,8 +354,19 @@ bool unified_difft::operator()()
     {
       INVARIANT(
         ito->first == itn->first, "old and new function names do not match");
-      unified_diff(
-        itn->first, ito->second->second.body, itn->second->second.body);
+      // skip the LCS computation for functions with the same content
+      if(
+        goto_function_hash(ito->first, ito->second->second) ==
+        goto_function_hash(itn->first, itn->second->second))
+      {
+        differences_map_[itn->first].assign(
+          itn->second->second.body.instructions.size(), differencet::SAME);
+      }
+      else
+      {
+        unified_diff(
+          itn->first, ito->second->second.body, itn->second->second.body);
+      }
       ++ito;
     }
   }
@@ -14,6 +14,9 @@ Author: Diffblue Ltd.
   "max-nondet-tree-depth"
 #define COMMON_HARNESS_GENERATOR_MIN_ARRAY_SIZE_OPT "min-array-size"
 #define COMMON_HARNESS_GENERATOR_MAX_ARRAY_SIZE_OPT "max-array-size"
+#define COMMON_HARNESS_GENERATOR_INITIALIZER_FUNCTIONS_OPT                     \
+  "initializer-functions"
+#define COMMON_HARNESS_GENERATOR_OBJECT_POOL_SIZE_OPT "object-pool-size"
 
 // clang-format off
 #define COMMON_HARNESS_GENERATOR_OPTIONS                                       \
@@ -21,6 +24,8 @@ Author: Diffblue Ltd.
   "(" COMMON_HARNESS_GENERATOR_MAX_NONDET_TREE_DEPTH_OPT "):"                  \
   "(" COMMON_HARNESS_GENERATOR_MIN_ARRAY_SIZE_OPT "):"                         \
   "(" COMMON_HARNESS_GENERATOR_MAX_ARRAY_SIZE_OPT "):"                         \
+  "(" COMMON_HARNESS_GENERATOR_INITIALIZER_FUNCTIONS_OPT ")"                   \
+  "(" COMMON_HARNESS_GENERATOR_OBJECT_POOL_SIZE_OPT "):"                       \
 // COMMON_HARNESS_GENERATOR_OPTIONS
 
 // clang-format on
@@ -39,6 +44,13 @@ Author: Diffblue Ltd.
   "--" COMMON_HARNESS_GENERATOR_MAX_ARRAY_SIZE_OPT                             \
   " N            maximum size of dynamically created arrays\n"                 \
   "                              (default: 2)\n"                               \
+  "--" COMMON_HARNESS_GENERATOR_INITIALIZER_FUNCTIONS_OPT                      \
+  "       initialize structs by one function per type and\n"                   \
+  "                              depth rather than inline\n"                   \
+  "--" COMMON_HARNESS_GENERATOR_OBJECT_POOL_SIZE_OPT                           \
+  " N          let pointers to a struct alias up to N earlier\n"               \
+  "                              objects of that type (implies\n"              \
+  "                              --initializer-functions)\n"                   \
   // COMMON_HARNESS_GENERATOR_HELP
 
 // clang-format on
@@ -195,6 +195,7 @@ void function_call_harness_generatort::implt::generate(
 
   generate_nondet_globals(function_body);
   call_function(arguments, function_body);
+  recursive_initialization->add_object_pool_initialization(function_body);
   add_harness_function_to_goto_model(std::move(function_body));
 }
 
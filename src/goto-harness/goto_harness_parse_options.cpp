@@ -20,6 +20,7 @@ Author: Diffblue Ltd.
 #include <util/config.h>
 #include <util/exception_utils.h>
 #include <util/exit_codes.h>
+#include <util/file_util.h>
 #include <util/invariant.h>
 #include <util/version.h>
 
@@ -79,6 +80,13 @@ int goto_harness_parse_optionst::doit()
       "--" GOTO_HARNESS_GENERATOR_HARNESS_FUNCTION_NAME_OPT);
   }
 
+  if(!got_harness_config.batch_functions.empty())
+  {
+    generate_batch(
+      got_harness_config, factory, factory_options, goto_model);
+    return CPROVER_EXIT_SUCCESS;
+  }
+
   // Initialise harness generator
   auto harness_generator = factory.factory(
     got_harness_config.harness_type, factory_options, goto_model);
@@ -98,6 +106,65 @@ int goto_harness_parse_optionst::doit()
   return CPROVER_EXIT_SUCCESS;
 }
 
+void goto_harness_parse_optionst::generate_batch(
+  const goto_harness_configt &config,
+  goto_harness_generator_factoryt &factory,
+  const goto_harness_generator_factoryt::generator_optionst &options,
+  goto_modelt &goto_model)
+{
+  if(config.harness_type != "call-function")
+  {
+    throw invalid_command_line_argument_exceptiont{
+      "batch mode requires --" GOTO_HARNESS_GENERATOR_TYPE_OPT
+      " call-function",
+      "--" GOTO_HARNESS_BATCH_FUNCTIONS_OPT};
+  }
+  if(options.count(FUNCTION_HARNESS_GENERATOR_FUNCTION_OPT) != 0)
+  {
+    throw invalid_command_line_argument_exceptiont{
+      "batch mode selects the functions to call itself",
+      "--" FUNCTION_HARNESS_GENERATOR_FUNCTION_OPT};
+  }
+
+  if(!is_directory(config.out_file) && !create_directory(config.out_file))
+  {
+    throw system_exceptiont{"failed to create directory '" + config.out_file +
+                            "'"};
+  }
+
+  const auto functions =
+    select_batch_functions(goto_model, config.batch_functions);
+
+  for(const auto &function : functions)
+  {
+    auto function_options = options;
+    function_options[FUNCTION_HARNESS_GENERATOR_FUNCTION_OPT] = {
+      id2string(function)};
+
+    auto harness_generator =
+      factory.factory(config.harness_type, function_options, goto_model);
+    CHECK_RETURN(harness_generator != nullptr);
+
+    harness_generator->generate(goto_model, config.harness_function_name);
+
+    write_harness_goto_binary(
+      goto_model,
+      config.harness_function_name,
+      concat_dir_file(config.out_file, id2string(function) + ".gb"),
+      ui_message_handler);
+
+    // Any auxiliary symbols the generator introduced have fresh names and
+    // are not written unless used, so dropping the harness itself suffices
+    // to generate the next one.
+    goto_model.goto_functions.function_map.erase(
+      config.harness_function_name);
+    goto_model.symbol_table.remove(config.harness_function_name);
+  }
+
+  log.status() << "Generated " << functions.size() << " harnesses in "
+               << config.out_file << messaget::eom;
+}
+
 void goto_harness_parse_optionst::help()
 {
   log.status()
@@ -118,6 +185,7 @@ void goto_harness_parse_optionst::help()
     << "--harness-function-name    the name of the harness function to "
        "generate\n"
     << "--harness-type             one of the harness types listed below\n"
+    << GOTO_HARNESS_BATCH_HELP
     << "\n\n"
     << FUNCTION_HARNESS_GENERATOR_HELP << "\n\n"
     << MEMORY_SNAPSHOT_HARNESS_GENERATOR_HELP << messaget::eom;
@@ -170,6 +238,12 @@ goto_harness_parse_optionst::handle_common_options()
   goto_harness_config.harness_function_name = {
     cmdline.get_value(GOTO_HARNESS_GENERATOR_HARNESS_FUNCTION_NAME_OPT)};
 
+  if(cmdline.isset(GOTO_HARNESS_BATCH_FUNCTIONS_OPT))
+  {
+    goto_harness_config.batch_functions =
+      cmdline.get_values(GOTO_HARNESS_BATCH_FUNCTIONS_OPT);
+  }
+
   return goto_harness_config;
 }
 
@@ -195,7 +269,8 @@ goto_harness_parse_optionst::collect_generate_factory_options()
   auto const common_options =
     std::set<std::string>{"version",
                           GOTO_HARNESS_GENERATOR_TYPE_OPT,
-                          GOTO_HARNESS_GENERATOR_HARNESS_FUNCTION_NAME_OPT};
+                          GOTO_HARNESS_GENERATOR_HARNESS_FUNCTION_NAME_OPT,
+                          GOTO_HARNESS_BATCH_FUNCTIONS_OPT};
 
   auto factory_options = goto_harness_generator_factoryt::generator_optionst{};
 
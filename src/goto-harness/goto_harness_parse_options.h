@@ -9,6 +9,7 @@ Author: Diffblue Ltd.
 #ifndef CPROVER_GOTO_HARNESS_GOTO_HARNESS_PARSE_OPTIONS_H
 #define CPROVER_GOTO_HARNESS_GOTO_HARNESS_PARSE_OPTIONS_H
 
+#include <list>
 #include <string>
 
 #include <goto-programs/goto_model.h>
@@ -17,12 +18,14 @@ Author: Diffblue Ltd.
 
 #include "function_harness_generator_options.h"
 #include "goto_harness_generator_factory.h"
+#include "harness_batch.h"
 #include "memory_snapshot_harness_generator_options.h"
 
 // clang-format off
 #define GOTO_HARNESS_OPTIONS                                                   \
   "(version)"                                                                  \
   GOTO_HARNESS_FACTORY_OPTIONS                                                 \
+  GOTO_HARNESS_BATCH_OPTIONS                                                   \
   COMMON_HARNESS_GENERATOR_OPTIONS                                             \
   FUNCTION_HARNESS_GENERATOR_OPTIONS                                           \
   MEMORY_SNAPSHOT_HARNESS_GENERATOR_OPTIONS                                    \
@@ -45,6 +48,8 @@ private:
     std::string out_file;
     std::string harness_type;
     irep_idt harness_function_name;
+    /// values of --batch-functions, empty unless in batch mode
+    std::list<std::string> batch_functions;
   };
 
   /// Handle command line arguments that are common to all
@@ -59,6 +64,15 @@ private:
   /// Setup the generator factory. This is the function you
   /// need to change when you add a new generator.
   goto_harness_generator_factoryt make_factory();
+
+  /// Generate one harness per function selected by --batch-functions, each
+  /// written to a goto binary of its own in the output directory. The model
+  /// is only read once and shared by all generators.
+  void generate_batch(
+    const goto_harness_configt &config,
+    goto_harness_generator_factoryt &factory,
+    const goto_harness_generator_factoryt::generator_optionst &options,
+    goto_modelt &goto_model);
 };
 
 #endif // CPROVER_GOTO_HARNESS_GOTO_HARNESS_PARSE_OPTIONS_H
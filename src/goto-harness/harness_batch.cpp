@@ -0,0 +1,151 @@
+/******************************************************************\
+
+Module: harness_batch
+
+Author: Diffblue Ltd.
+
+\******************************************************************/
+
+#include "harness_batch.h"
+
+#include <algorithm>
+
+#include <goto-programs/goto_model.h>
+#include <goto-programs/write_goto_binary.h>
+#include <util/cprover_prefix.h>
+#include <util/exception_utils.h>
+#include <util/find_symbols.h>
+#include <util/prefix.h>
+#include <util/string_utils.h>
+
+#include <linking/static_lifetime_init.h>
+
+std::vector<irep_idt> select_batch_functions(
+  const goto_modelt &goto_model,
+  const std::list<std::string> &selection)
+{
+  std::vector<irep_idt> functions;
+
+  if(selection.size() == 1 && selection.front() == "all")
+  {
+    for(const auto &entry : goto_model.goto_functions.function_map)
+    {
+      const symbolt *symbol = goto_model.symbol_table.lookup(entry.first);
+      if(
+        entry.second.body_available() && symbol != nullptr &&
+        !symbol->is_file_local &&
+        entry.first != goto_functionst::entry_point() &&
+        !has_prefix(id2string(entry.first), CPROVER_PREFIX))
+      {
+        functions.push_back(entry.first);
+      }
+    }
+  }
+  else
+  {
+    for(const auto &value : selection)
+    {
+      for(const auto &function : split_string(value, ',', true, true))
+      {
+        const auto f_it = goto_model.goto_functions.function_map.find(function);
+        if(
+          f_it == goto_model.goto_functions.function_map.end() ||
+          !f_it->second.body_available())
+        {
+          throw invalid_command_line_argument_exceptiont{
+            "function `" + function + "' has no body",
+            "--" GOTO_HARNESS_BATCH_FUNCTIONS_OPT};
+        }
+        functions.push_back(function);
+      }
+    }
+  }
+
+  std::sort(
+    functions.begin(),
+    functions.end(),
+    [](const irep_idt &a, const irep_idt &b) {
+      return id2string(a) < id2string(b);
+    });
+  functions.erase(
+    std::unique(functions.begin(), functions.end()), functions.end());
+
+  return functions;
+}
+
+void write_harness_goto_binary(
+  const goto_modelt &goto_model,
+  const irep_idt &harness_function_name,
+  const std::string &file_name,
+  message_handlert &message_handler)
+{
+  const auto &function_map = goto_model.goto_functions.function_map;
+
+  find_symbols_sett symbols;
+  std::vector<irep_idt> worklist;
+
+  auto add_symbol = [&symbols, &worklist](const irep_idt &id) {
+    if(symbols.insert(id).second)
+      worklist.push_back(id);
+  };
+
+  add_symbol(harness_function_name);
+  add_symbol(INITIALIZE_FUNCTION);
+
+  // close over the functions (and their bodies) and the symbols referenced
+  // by types, values and instructions
+  while(!worklist.empty())
+  {
+    const irep_idt id = worklist.back();
+    worklist.pop_back();
+
+    find_symbols_sett found;
+
+    const symbolt *symbol = goto_model.symbol_table.lookup(id);
+    if(symbol != nullptr)
+    {
+      find_type_and_expr_symbols(symbol->type, found);
+      // function symbols are followed via their goto bodies below
+      if(symbol->type.id() != ID_code)
+        find_type_and_expr_symbols(symbol->value, found);
+    }
+
+    const auto f_it = function_map.find(id);
+    if(f_it != function_map.end())
+    {
+      for(const auto &parameter : f_it->second.parameter_identifiers)
+        found.insert(parameter);
+
+      forall_goto_program_instructions(i_it, f_it->second.body)
+      {
+        find_type_and_expr_symbols(i_it->code, found);
+        if(i_it->has_condition())
+          find_type_and_expr_symbols(i_it->get_condition(), found);
+      }
+    }
+
+    for(const auto &f : found)
+      add_symbol(f);
+  }
+
+  goto_modelt harness_model;
+
+  for(const auto &id : symbols)
+  {
+    const symbolt *symbol = goto_model.symbol_table.lookup(id);
+    if(symbol != nullptr)
+      harness_model.symbol_table.add(*symbol);
+
+    const auto f_it = function_map.find(id);
+    if(f_it != function_map.end())
+      harness_model.goto_functions.function_map[id].copy_from(f_it->second);
+  }
+
+  harness_model.goto_functions.update();
+
+  if(write_goto_binary(file_name, harness_model, message_handler))
+  {
+    throw system_exceptiont{"failed to write goto program to file '" +
+                            file_name + "'"};
+  }
+}
@@ -0,0 +1,58 @@
+/******************************************************************\
+
+Module: harness_batch
+
+Author: Diffblue Ltd.
+
+\******************************************************************/
+
+#ifndef CPROVER_GOTO_HARNESS_HARNESS_BATCH_H
+#define CPROVER_GOTO_HARNESS_HARNESS_BATCH_H
+
+#include <list>
+#include <string>
+#include <vector>
+
+#include <util/irep.h>
+
+class goto_modelt;
+class message_handlert;
+
+#define GOTO_HARNESS_BATCH_FUNCTIONS_OPT "batch-functions"
+
+// clang-format off
+#define GOTO_HARNESS_BATCH_OPTIONS                                             \
+  "(" GOTO_HARNESS_BATCH_FUNCTIONS_OPT "):"                                    \
+// end GOTO_HARNESS_BATCH_OPTIONS
+
+#define GOTO_HARNESS_BATCH_HELP                                                \
+  "--" GOTO_HARNESS_BATCH_FUNCTIONS_OPT                                        \
+  " <all|f,g,...>\n"                                                           \
+  "                              generate one call-function harness per\n"     \
+  "                              function (all: every exported function);\n"   \
+  "                              <out> is a directory receiving <f>.gb\n"      \
+// end GOTO_HARNESS_BATCH_HELP
+// clang-format on
+
+/// Select the functions to generate harnesses for in batch mode.
+/// \param goto_model: the model the harnesses are generated for
+/// \param selection: function names, or the single value `all` to select
+///   every function with a body that has external linkage and is not
+///   internal to CBMC
+/// \return the names of the selected functions, in lexicographic order
+std::vector<irep_idt> select_batch_functions(
+  const goto_modelt &goto_model,
+  const std::list<std::string> &selection);
+
+/// Write a goto binary that only holds what is needed to run
+/// \p harness_function_name: the functions that may be called from it or
+/// from the initialisation of static-lifetime objects, and the symbols these
+/// refer to. This is much smaller than the full model when harnessing the
+/// functions of a large library one by one.
+void write_harness_goto_binary(
+  const goto_modelt &goto_model,
+  const irep_idt &harness_function_name,
+  const std::string &file_name,
+  message_handlert &message_handler);
+
+#endif // CPROVER_GOTO_HARNESS_HARNESS_BATCH_H
@@ -278,6 +278,7 @@ code_blockt memory_snapshot_harness_generatort::add_assignments_to_globals(
         fresh_or_snapshot_symbol.symbol_expr(), 0, {}, code);
     }
   }
+  recursive_initialization.add_object_pool_initialization(code);
   return code;
 }
 
@@ -18,6 +18,8 @@ Author: Diffblue Ltd.
 #include <util/std_expr.h>
 #include <util/string2int.h>
 
+#include <goto-programs/goto_convert.h>
+
 #include <functional>
 
 bool recursive_initialization_configt::handle_option(
@@ -72,6 +74,19 @@ bool recursive_initialization_configt::handle_option(
       COMMON_HARNESS_GENERATOR_MIN_ARRAY_SIZE_OPT, values);
     return true;
   }
+  else if(option == COMMON_HARNESS_GENERATOR_INITIALIZER_FUNCTIONS_OPT)
+  {
+    harness_options_parser::assert_no_values(option, values);
+    initializer_functions = true;
+    return true;
+  }
+  else if(option == COMMON_HARNESS_GENERATOR_OBJECT_POOL_SIZE_OPT)
+  {
+    object_pool_size = harness_options_parser::require_one_size_value(
+      COMMON_HARNESS_GENERATOR_OBJECT_POOL_SIZE_OPT, values);
+    initializer_functions = true;
+    return true;
+  }
   return false;
 }
 
@@ -150,6 +165,13 @@ void recursive_initializationt::initialize_struct_tag(
 {
   PRECONDITION(lhs.type().id() == ID_struct_tag);
   auto const &type = to_struct_tag_type(lhs.type());
+  if(initialization_config.initializer_functions)
+  {
+    body.add(code_function_callt{
+      get_initializer_function(type, depth, known_tags),
+      {address_of_exprt{lhs}}});
+    return;
+  }
   auto new_known_tags = known_tags;
   new_known_tags.insert(type.get_identifier());
   auto const &ns = namespacet{goto_model.symbol_table};
@@ -173,17 +195,7 @@ void recursive_initializationt::initialize_pointer(
                                      goto_model.symbol_table};
   exprt choice =
     allocate_objects.allocate_automatic_local_object(bool_typet{}, "choice");
-  symbolt &pointee_symbol = get_fresh_aux_symbol(
-    type.subtype(),
-    "__goto_harness",
-    "pointee",
-    lhs.source_location(),
-    initialization_config.mode,
-    goto_model.symbol_table);
-  pointee_symbol.is_static_lifetime = true;
-  pointee_symbol.is_lvalue = true;
 
-  auto pointee = pointee_symbol.symbol_expr();
   allocate_objects.declare_created_symbols(body);
   body.add(code_assignt{lhs, null_pointer_exprt{type}, type.source_location()});
   bool is_unknown_struct_tag =
@@ -195,19 +207,291 @@ void recursive_initializationt::initialize_pointer(
     depth < initialization_config.max_nondet_tree_depth ||
     is_unknown_struct_tag)
   {
+    code_blockt new_pointee{};
+    initialize_new_pointee(lhs, depth, known_tags, new_pointee);
+
+    if(
+      initialization_config.object_pool_size != 0 &&
+      type.subtype().id() == ID_struct_tag)
+    {
+      // if(pool_size != 0 && alias) lhs = pool[index]; else <new pointee>
+      const auto &pool = get_object_pool(to_struct_tag_type(type.subtype()));
+      const symbol_exprt alias =
+        allocate_objects.allocate_automatic_local_object(bool_typet{}, "alias");
+      const symbol_exprt index = allocate_objects.allocate_automatic_local_object(
+        pool.size.type(), "pool_index");
+
+      code_blockt existing_pointee{};
+      existing_pointee.add(code_declt{index});
+      existing_pointee.add(code_assumet{
+        binary_relation_exprt{index, ID_lt, pool.size}});
+      existing_pointee.add(code_assignt{
+        lhs,
+        typecast_exprt::conditional_cast(
+          index_exprt{pool.objects, index}, type)});
+
+      code_blockt pick{};
+      pick.add(code_declt{alias});
+      pick.add(code_ifthenelset{
+        and_exprt{alias,
+                  notequal_exprt{pool.size, from_integer(0, pool.size.type())}},
+        std::move(existing_pointee),
+        std::move(new_pointee)});
+      new_pointee = std::move(pick);
+    }
+
     if(depth < initialization_config.min_null_tree_depth)
     {
-      initialize(pointee, depth + 1, known_tags, body);
-      body.add(code_assignt{lhs, address_of_exprt{pointee}});
+      body.append(new_pointee);
     }
     else
     {
-      code_blockt then_case{};
-      initialize(pointee, depth + 1, known_tags, then_case);
-      then_case.add(code_assignt{lhs, address_of_exprt{pointee}});
-      body.add(code_ifthenelset{choice, then_case});
+      body.add(code_ifthenelset{choice, std::move(new_pointee)});
+    }
+  }
+}
+
+void recursive_initializationt::initialize_new_pointee(
+  const exprt &lhs,
+  const std::size_t depth,
+  const recursion_sett &known_tags,
+  code_blockt &body)
+{
+  auto const &type = to_pointer_type(lhs.type());
+
+  if(!initialization_config.initializer_functions)
+  {
+    symbolt &pointee_symbol = get_fresh_aux_symbol(
+      type.subtype(),
+      "__goto_harness",
+      "pointee",
+      lhs.source_location(),
+      initialization_config.mode,
+      goto_model.symbol_table);
+    pointee_symbol.is_static_lifetime = true;
+    pointee_symbol.is_lvalue = true;
+
+    auto pointee = pointee_symbol.symbol_expr();
+    initialize(pointee, depth + 1, known_tags, body);
+    body.add(code_assignt{lhs, address_of_exprt{pointee}});
+    return;
+  }
+
+  allocate_objectst allocate_objects{initialization_config.mode,
+                                     type.source_location(),
+                                     "initializer",
+                                     goto_model.symbol_table};
+  code_blockt allocation{};
+  const exprt pointee =
+    allocate_objects.allocate_dynamic_object(allocation, lhs, type.subtype());
+  allocate_objects.declare_created_symbols(body);
+  body.append(allocation);
+
+  // nothing to initialise behind a void pointer
+  if(pointee.is_nil())
+    return;
+
+  // register the object before initialising it, which allows for cycles
+  if(
+    initialization_config.object_pool_size != 0 &&
+    type.subtype().id() == ID_struct_tag)
+  {
+    // if(pool_size < object_pool_size)
+    //   { pool[pool_size] = lhs; pool_size = pool_size + 1; }
+    const auto &pool = get_object_pool(to_struct_tag_type(type.subtype()));
+    const auto &pool_type = to_array_type(pool.objects.type());
+    code_blockt add_to_pool{};
+    add_to_pool.add(code_assignt{
+      index_exprt{pool.objects, pool.size},
+      typecast_exprt::conditional_cast(lhs, pool_type.subtype())});
+    add_to_pool.add(code_assignt{
+      pool.size,
+      plus_exprt{pool.size, from_integer(1, pool.size.type())}});
+    body.add(code_ifthenelset{
+      binary_relation_exprt{pool.size, ID_lt, pool_type.size()},
+      std::move(add_to_pool)});
+  }
+
+  initialize(pointee, depth + 1, known_tags, body);
+}
+
+bool recursive_initializationt::is_recursive(const irep_idt &tag)
+{
+  auto entry = recursive_tags.find(tag);
+  if(entry != recursive_tags.end())
+    return entry->second;
+
+  const namespacet ns{goto_model.symbol_table};
+  std::set<irep_idt> visited;
+  bool result = false;
+  for(const auto &component : ns.follow_tag(struct_tag_typet{tag}).components())
+  {
+    if(reaches_tag(component.type(), tag, visited))
+    {
+      result = true;
+      break;
     }
   }
+
+  recursive_tags.emplace(tag, result);
+  return result;
+}
+
+bool recursive_initializationt::reaches_tag(
+  const typet &type,
+  const irep_idt &tag,
+  std::set<irep_idt> &visited) const
+{
+  if(type.id() == ID_pointer || type.id() == ID_array)
+    return reaches_tag(type.subtype(), tag, visited);
+
+  if(type.id() != ID_struct_tag)
+    return false;
+
+  const irep_idt &identifier = to_struct_tag_type(type).get_identifier();
+  if(identifier == tag)
+    return true;
+  if(!visited.insert(identifier).second)
+    return false;
+
+  const namespacet ns{goto_model.symbol_table};
+  for(const auto &component :
+      ns.follow_tag(to_struct_tag_type(type)).components())
+  {
+    if(reaches_tag(component.type(), tag, visited))
+      return true;
+  }
+  return false;
+}
+
+symbol_exprt recursive_initializationt::get_initializer_function(
+  const struct_tag_typet &type,
+  const std::size_t depth,
+  const recursion_sett &known_tags)
+{
+  // Whether a pointer is initialised depends on whether its (struct) target
+  // type is known; for struct types that are not recursive this is never the
+  // case, hence only the recursive ones need to be part of the key.
+  recursion_sett known_recursive_tags;
+  for(const auto &tag : known_tags)
+  {
+    if(is_recursive(tag))
+      known_recursive_tags.insert(tag);
+  }
+
+  const initializer_keyt key{type.get_identifier(), depth, known_recursive_tags};
+  auto entry = initializer_functions.find(key);
+  if(entry != initializer_functions.end())
+    return entry->second;
+
+  const namespacet ns{goto_model.symbol_table};
+  const irep_idt &tag_name = ns.follow_tag(type).get_tag();
+
+  const symbolt &function_symbol = get_fresh_aux_symbol(
+    code_typet{{}, empty_typet{}},
+    "__goto_harness",
+    "initialize_" + id2string(tag_name),
+    source_locationt{},
+    initialization_config.mode,
+    goto_model.symbol_table);
+  const irep_idt function_name = function_symbol.name;
+
+  symbolt parameter_symbol;
+  parameter_symbol.name = id2string(function_name) + "::object";
+  parameter_symbol.base_name = parameter_symbol.pretty_name = "object";
+  parameter_symbol.type = pointer_type(type);
+  parameter_symbol.mode = initialization_config.mode;
+  parameter_symbol.is_parameter = true;
+  parameter_symbol.is_lvalue = true;
+  parameter_symbol.is_file_local = true;
+  parameter_symbol.is_state_var = true;
+  goto_model.symbol_table.insert(parameter_symbol);
+
+  code_typet::parametert parameter{parameter_symbol.type};
+  parameter.set_identifier(parameter_symbol.name);
+  parameter.set_base_name(parameter_symbol.base_name);
+  const code_typet function_type{{parameter}, empty_typet{}};
+
+  const symbol_exprt function_expr{function_name, function_type};
+  initializer_functions.emplace(key, function_expr);
+
+  // the members of *object
+  code_blockt function_body{};
+  auto new_known_tags = known_recursive_tags;
+  new_known_tags.insert(type.get_identifier());
+  const dereference_exprt object{parameter_symbol.symbol_expr()};
+  for(auto const &component : ns.follow_tag(type).components())
+  {
+    initialize(
+      member_exprt{object, component}, depth, new_known_tags, function_body);
+  }
+
+  symbolt &writeable_function_symbol =
+    goto_model.symbol_table.get_writeable_ref(function_name);
+  writeable_function_symbol.type = function_type;
+  writeable_function_symbol.value = function_body;
+
+  auto &goto_function = goto_model.goto_functions.function_map[function_name];
+  goto_function.type = function_type;
+  goto_function.set_parameter_identifiers(function_type);
+  null_message_handlert null_message_handler;
+  goto_convert(
+    function_body,
+    goto_model.symbol_table,
+    goto_function.body,
+    null_message_handler,
+    initialization_config.mode);
+  goto_function.body.add(goto_programt::make_end_function());
+
+  return function_expr;
+}
+
+const recursive_initializationt::object_poolt &
+recursive_initializationt::get_object_pool(const struct_tag_typet &type)
+{
+  auto entry = object_pools.find(type.get_identifier());
+  if(entry != object_pools.end())
+    return entry->second;
+
+  auto new_static_symbol = [this](const typet &symbol_type, const char *name) {
+    symbolt &symbol = get_fresh_aux_symbol(
+      symbol_type,
+      "__goto_harness",
+      name,
+      source_locationt{},
+      initialization_config.mode,
+      goto_model.symbol_table);
+    symbol.is_static_lifetime = true;
+    symbol.is_lvalue = true;
+    return symbol.symbol_expr();
+  };
+
+  const object_poolt pool{
+    new_static_symbol(
+      array_typet{pointer_type(type),
+                  from_integer(
+                    initialization_config.object_pool_size, size_type())},
+      "pool"),
+    new_static_symbol(size_type(), "pool_size")};
+
+  return object_pools.emplace(type.get_identifier(), pool).first->second;
+}
+
+void recursive_initializationt::add_object_pool_initialization(
+  code_blockt &body) const
+{
+  if(object_pools.empty())
+    return;
+
+  code_blockt reset{};
+  for(const auto &pool : object_pools)
+  {
+    reset.add(code_assignt{pool.second.size,
+                           from_integer(0, pool.second.size.type())});
+  }
+
+  reset.append(body);
+  body = std::move(reset);
 }
 
 void recursive_initializationt::initialize_nondet(
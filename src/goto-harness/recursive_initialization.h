@@ -11,6 +11,7 @@ Author: Diffblue Ltd.
 
 #include <map>
 #include <set>
+#include <tuple>
 
 #include <goto-programs/goto_model.h>
 #include <util/expr.h>
@@ -37,6 +38,15 @@ struct recursive_initialization_configt
 
   std::set<irep_idt> pointers_to_treat_as_cstrings;
 
+  /// Initialise structs by calling one function per struct type, depth and
+  /// set of recursive struct types already being initialised, which keeps
+  /// the size of the harness linear in the number of types
+  bool initializer_functions = false;
+  /// Number of objects of each struct type that pointers to that type may
+  /// alias rather than pointing to a new object; requires
+  /// initializer_functions
+  std::size_t object_pool_size = 0;
+
   std::string to_string() const; // for debugging purposes
 
   /// Parse the options specific for recursive initialisation
@@ -71,10 +81,29 @@ public:
     const recursion_sett &known_tags,
     code_blockt &body);
 
+  /// Prepend the code resetting the object pools that the code generated so
+  /// far uses to \p body, which must contain all of that code.
+  void add_object_pool_initialization(code_blockt &body) const;
+
 private:
   const recursive_initialization_configt initialization_config;
   goto_modelt &goto_model;
 
+  using initializer_keyt = std::tuple<irep_idt, std::size_t, recursion_sett>;
+  /// The initialisation functions generated so far
+  std::map<initializer_keyt, symbol_exprt> initializer_functions;
+
+  /// Struct tags that can reach themselves via members and pointers
+  std::map<irep_idt, bool> recursive_tags;
+
+  struct object_poolt
+  {
+    symbol_exprt objects;
+    symbol_exprt size;
+  };
+  /// The object pools generated so far, by struct tag
+  std::map<irep_idt, object_poolt> object_pools;
+
   /// Get the malloc function as symbol exprt,
   /// and inserts it into the goto-model if it doesn't
   /// exist already.
@@ -90,6 +119,31 @@ private:
     std::size_t depth,
     const recursion_sett &known_tags,
     code_blockt &body);
+  /// Generate the code for a pointer to an object that
+  /// initialize_pointer creates: a dynamically allocated object when using
+  /// initializer functions, which may be called more than once, and a new
+  /// static object otherwise.
+  void initialize_new_pointee(
+    const exprt &lhs,
+    std::size_t depth,
+    const recursion_sett &known_tags,
+    code_blockt &body);
+
+  bool is_recursive(const irep_idt &tag);
+  bool reaches_tag(
+    const typet &type,
+    const irep_idt &tag,
+    std::set<irep_idt> &visited) const;
+
+  /// Get the function that initialises the object its argument points to,
+  /// generating it if there is none for \p type, \p depth and the recursive
+  /// tags among \p known_tags yet.
+  symbol_exprt get_initializer_function(
+    const struct_tag_typet &type,
+    std::size_t depth,
+    const recursion_sett &known_tags);
+
+  const object_poolt &get_object_pool(const struct_tag_typet &type);
   void initialize_nondet(
     const exprt &lhs,
     std::size_t depth,
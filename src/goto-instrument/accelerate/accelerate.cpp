@@ -28,6 +28,7 @@ Author: Matt Lewis
 #include "polynomial_accelerator.h"
 #include "enumerating_loop_acceleration.h"
 #include "disjunctive_polynomial_acceleration.h"
+#include "syntactic_loop_acceleration.h"
 #include "overflow_instrumenter.h"
 #include "util.h"
 
@@ -96,54 +97,78 @@ int acceleratet::accelerate_loop(goto_programt::targett &loop_header)
     return 0;
   }
 
-  goto_programt::targett overflow_loc;
-  make_overflow_loc(loop_header, back_jump, overflow_loc);
-  program.update();
+  path_acceleratort accelerator;
 
-#if 1
-  enumerating_loop_accelerationt acceleration(
+  // Loops that follow common idioms are accelerated without SAT queries.
+  syntactic_loop_accelerationt syntactic_acceleration(
     message_handler,
     symbol_table,
     goto_functions,
-    program,
     loop,
     loop_header,
-    accelerate_limit,
-    guard_manager);
-#else
-  disjunctive_polynomial_accelerationt
-    acceleration(symbol_table, goto_functions, program, loop, loop_header);
-#endif
-
-  path_acceleratort accelerator;
+    back_jump);
 
-  while(acceleration.accelerate(accelerator) &&
-        (accelerate_limit < 0 ||
-         num_accelerated < accelerate_limit))
+  if(syntactic_acceleration.accelerate(accelerator))
   {
-    // set_dirty_vars(accelerator);
+    accelerators.push_back(accelerator);
+  }
+  else if(syntactic_only)
+  {
+    return 0;
+  }
+  else
+  {
+    goto_programt::targett overflow_loc;
+    make_overflow_loc(loop_header, back_jump, overflow_loc);
+    program.update();
 
-    if(is_underapproximate(accelerator))
+#if 1
+    enumerating_loop_accelerationt acceleration(
+      message_handler,
+      symbol_table,
+      goto_functions,
+      program,
+      loop,
+      loop_header,
+      accelerate_limit,
+      guard_manager);
+#else
+    disjunctive_polynomial_accelerationt
+      acceleration(symbol_table, goto_functions, program, loop, loop_header);
+#endif
+
+    while(acceleration.accelerate(accelerator) &&
+          (accelerate_limit < 0 ||
+           num_accelerated < accelerate_limit))
     {
-      // We have some underapproximated variables -- just punt for now.
+      // set_dirty_vars(accelerator);
+
+      if(is_underapproximate(accelerator))
+      {
+        // We have some underapproximated variables -- just punt for now.
 #ifdef DEBUG
-      std::cout << "Not inserting accelerator because of underapproximation\n";
+        std::cout << "Not inserting accelerator because of "
+                  << "underapproximation\n";
 #endif
 
-      continue;
-    }
+        continue;
+      }
 
-    accelerators.push_back(accelerator);
-    num_accelerated++;
+      accelerators.push_back(accelerator);
+      num_accelerated++;
 
 #ifdef DEBUG
-    std::cout << "Accelerated path:\n";
-    output_path(accelerator.path, program, ns, std::cout);
+      std::cout << "Accelerated path:\n";
+      output_path(accelerator.path, program, ns, std::cout);
 
-    std::cout << "Accelerator has "
-              << accelerator.pure_accelerator.instructions.size()
-              << " instructions\n";
+      std::cout << "Accelerator has "
+                << accelerator.pure_accelerator.instructions.size()
+                << " instructions\n";
 #endif
+    }
+
+    std::cout << "Overflow loc is " << overflow_loc->location_number << '\n';
+    std::cout << "Back jump is " << back_jump->location_number << '\n';
   }
 
   goto_programt::instructiont skip(SKIP);
@@ -154,9 +179,6 @@ int acceleratet::accelerate_loop(goto_programt::targett &loop_header)
 
   loop.insert_instruction(new_inst);
 
-  std::cout << "Overflow loc is " << overflow_loc->location_number << '\n';
-  std::cout << "Back jump is " << back_jump->location_number << '\n';
-
   for(std::list<path_acceleratort>::iterator it=accelerators.begin();
       it!=accelerators.end();
       ++it)
@@ -622,7 +644,9 @@ int acceleratet::accelerate_loops()
 
   program.update();
 
-  if(num_accelerated > 0)
+  // Restricting the traces only prunes redundant ones, which is not worth
+  // building the trace automaton for syntactic accelerators.
+  if(num_accelerated > 0 && !syntactic_only)
   {
     std::cout << "Engaging crush mode...\n";
 
@@ -640,13 +664,19 @@ void accelerate_functions(
   goto_modelt &goto_model,
   message_handlert &message_handler,
   bool use_z3,
-  guard_managert &guard_manager)
+  guard_managert &guard_manager,
+  bool syntactic_only)
 {
   Forall_goto_functions(it, goto_model.goto_functions)
   {
     std::cout << "Accelerating function " << it->first << '\n';
     acceleratet accelerate(
-      it->second.body, goto_model, message_handler, use_z3, guard_manager);
+      it->second.body,
+      goto_model,
+      message_handler,
+      use_z3,
+      guard_manager,
+      syntactic_only);
 
     int num_accelerated=accelerate.accelerate_loops();
 
@@ -35,7 +35,8 @@ public:
     goto_modelt &_goto_model,
     message_handlert &message_handler,
     bool _use_z3,
-    guard_managert &guard_manager)
+    guard_managert &guard_manager,
+    bool _syntactic_only = false)
     : message_handler(message_handler),
       program(_program),
       goto_functions(_goto_model.goto_functions),
@@ -43,7 +44,8 @@ public:
       guard_manager(guard_manager),
       ns(_goto_model.symbol_table),
       utils(symbol_table, message_handler, goto_functions),
-      use_z3(_use_z3)
+      use_z3(_use_z3),
+      syntactic_only(_syntactic_only)
   {
     natural_loops(program);
   }
@@ -128,12 +130,17 @@ protected:
   expr_mapt dirty_vars_map;
 
   bool use_z3;
+
+  /// Only add the accelerators of \ref syntactic_loop_accelerationt, which
+  /// need no SAT queries
+  bool syntactic_only;
 };
 
 void accelerate_functions(
   goto_modelt &,
   message_handlert &message_handler,
   bool use_z3,
-  guard_managert &guard_manager);
+  guard_managert &guard_manager,
+  bool syntactic_only = false);
 
 #endif // CPROVER_GOTO_INSTRUMENT_ACCELERATE_ACCELERATE_H
@@ -0,0 +1,518 @@
+/*******************************************************************\
+
+Module: Loop Acceleration
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Syntactic Loop Acceleration
+
+#include "syntactic_loop_acceleration.h"
+
+#include <util/arith_tools.h>
+#include <util/expr_util.h>
+#include <util/mathematical_expr.h>
+#include <util/replace_expr.h>
+
+#include "overflow_instrumenter.h"
+#include "util.h"
+
+static bool is_integer_type(const typet &type)
+{
+  return type.id() == ID_signedbv || type.id() == ID_unsignedbv;
+}
+
+/// \return True iff \p expr converts its operand to a type that can represent
+///   all values of the type of the operand
+static bool is_widening(const typecast_exprt &expr)
+{
+  const typet &from = expr.op().type();
+  const typet &to = expr.type();
+
+  if(!is_integer_type(from) || !is_integer_type(to))
+    return false;
+
+  const std::size_t from_width = to_bitvector_type(from).get_width();
+  const std::size_t to_width = to_bitvector_type(to).get_width();
+
+  if(from.id() == to.id())
+    return to_width >= from_width;
+
+  return from.id() == ID_unsignedbv && to_width > from_width;
+}
+
+static const exprt &skip_widening(const exprt &expr)
+{
+  if(expr.id() == ID_typecast && is_widening(to_typecast_expr(expr)))
+    return skip_widening(to_typecast_expr(expr).op());
+
+  return expr;
+}
+
+bool syntactic_loop_accelerationt::is_readable(const exprt &expr) const
+{
+  // The values of the induction variables are substituted into the
+  // expressions, which would be wrong below an address-of.
+  if(
+    has_subexpr(expr, ID_dereference) || has_subexpr(expr, ID_address_of) ||
+    has_subexpr(expr, ID_side_effect))
+  {
+    return false;
+  }
+
+  find_symbols_sett symbols;
+  find_symbols_or_nexts(expr, symbols);
+
+  for(const auto &identifier : symbols)
+  {
+    if(written_arrays.count(identifier) != 0)
+      return false;
+
+    if(
+      written_scalars.count(identifier) != 0 &&
+      induction_variables.count(identifier) == 0)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool syntactic_loop_accelerationt::is_invariant(const exprt &expr) const
+{
+  return is_readable(expr) && !has_symbol(expr, written_scalars);
+}
+
+/// \return True iff \p expr is an induction variable with step 1 or -1,
+///   possibly widened, in which case \p direction is set to the step
+bool syntactic_loop_accelerationt::has_unit_step(
+  const exprt &expr,
+  int &direction) const
+{
+  const exprt &variable = skip_widening(expr);
+  if(variable.id() != ID_symbol)
+    return false;
+
+  const auto entry =
+    induction_variables.find(to_symbol_expr(variable).get_identifier());
+  if(entry == induction_variables.end())
+    return false;
+
+  const auto step = numeric_cast<mp_integer>(entry->second.step);
+  if(!step.has_value() || (*step != 1 && *step != -1))
+    return false;
+
+  direction = (*step == 1) != entry->second.decreasing ? 1 : -1;
+  return true;
+}
+
+/// \return The value of the expression of \p site when evaluated in the
+///   iteration with number \p iteration, where the first one is 0
+exprt syntactic_loop_accelerationt::at_iteration(
+  const sitet &site,
+  const exprt &iteration) const
+{
+  replace_mapt values;
+
+  for(const auto &entry : induction_variables)
+  {
+    const induction_variablet &induction_variable = entry.second;
+
+    exprt count = iteration;
+    if(site.updated.count(entry.first) != 0)
+    {
+      const exprt one = from_integer(1, iteration.type());
+      count = iteration.is_zero() ? one : plus_exprt(iteration, one);
+    }
+
+    if(count.is_zero())
+    {
+      values.emplace(induction_variable.variable, induction_variable.initial);
+      continue;
+    }
+
+    const mult_exprt offset(
+      typecast_exprt::conditional_cast(
+        count, induction_variable.variable.type()),
+      induction_variable.step);
+
+    if(induction_variable.decreasing)
+    {
+      values.emplace(
+        induction_variable.variable,
+        minus_exprt(induction_variable.initial, offset));
+    }
+    else
+    {
+      values.emplace(
+        induction_variable.variable,
+        plus_exprt(induction_variable.initial, offset));
+    }
+  }
+
+  exprt result = site.expr;
+  replace_expr(values, result);
+  return result;
+}
+
+bool syntactic_loop_accelerationt::match_loop(patht &path)
+{
+  if(back_jump == loop_header)
+    return false;
+
+  // The loop must be a contiguous block without branches, other than exits.
+  std::size_t size = 0;
+
+  for(goto_programt::targett t = loop_header;; ++t)
+  {
+    if(!loop.contains(t))
+      return false;
+
+    ++size;
+
+    if(t == back_jump)
+      break;
+
+    if(t->is_assign())
+    {
+      const exprt &lhs = t->get_assign().lhs();
+
+      if(lhs.id() == ID_symbol)
+      {
+        if(!written_scalars.insert(to_symbol_expr(lhs).get_identifier())
+              .second)
+        {
+          return false;
+        }
+      }
+      else if(
+        lhs.id() == ID_index && to_index_expr(lhs).array().id() == ID_symbol)
+      {
+        const irep_idt &array =
+          to_symbol_expr(to_index_expr(lhs).array()).get_identifier();
+
+        if(!written_arrays.insert(array).second)
+          return false;
+      }
+      else
+        return false;
+    }
+    else if(t->is_goto())
+    {
+      if(t->targets.size() != 1 || loop.contains(t->get_target()))
+        return false;
+    }
+    else if(!t->is_skip() && !t->is_location())
+      return false;
+  }
+
+  if(size != loop.size())
+    return false;
+
+  // Classify the scalar assignments.
+  for(goto_programt::targett t = loop_header; t != back_jump; ++t)
+  {
+    if(!t->is_assign() || t->get_assign().lhs().id() != ID_symbol)
+      continue;
+
+    const symbol_exprt &lhs = to_symbol_expr(t->get_assign().lhs());
+    const exprt &rhs = t->get_assign().rhs();
+
+    if(written_arrays.count(lhs.get_identifier()) != 0)
+      return false;
+
+    if(
+      (rhs.id() == ID_plus || rhs.id() == ID_minus) &&
+      rhs.operands().size() == 2 && is_integer_type(lhs.type()))
+    {
+      const exprt &op0 = to_binary_expr(rhs).op0();
+      const exprt &op1 = to_binary_expr(rhs).op1();
+      const exprt *step = nullptr;
+
+      if(op0 == lhs)
+        step = &op1;
+      else if(rhs.id() == ID_plus && op1 == lhs)
+        step = &op0;
+
+      // Steps are restricted to constants and variables such that the only
+      // arithmetic in the closed forms is the one built here.
+      if(
+        step != nullptr && (step->is_constant() || step->id() == ID_symbol) &&
+        step->type() == lhs.type() && is_invariant(*step))
+      {
+        induction_variables.emplace(
+          lhs.get_identifier(),
+          induction_variablet{lhs, *step, rhs.id() == ID_minus, nil_exprt()});
+        continue;
+      }
+    }
+
+    if(!is_invariant(rhs))
+      return false;
+
+    invariant_assignments.push_back(t->get_assign());
+  }
+
+  if(induction_variables.empty())
+    return false;
+
+  // Record where the exit conditions and the array writes are evaluated.
+  find_symbols_sett updated;
+
+  for(goto_programt::targett t = loop_header; t != back_jump; ++t)
+  {
+    if(t->is_goto())
+    {
+      const exprt stay = boolean_negate(t->get_condition());
+      if(!is_readable(stay))
+        return false;
+
+      stay_conditions.push_back({stay, updated});
+      path.push_back(path_nodet(t, not_exprt(t->get_condition())));
+      continue;
+    }
+
+    path.push_back(path_nodet(t));
+
+    if(!t->is_assign())
+      continue;
+
+    const exprt &lhs = t->get_assign().lhs();
+
+    if(lhs.id() == ID_symbol)
+    {
+      const irep_idt &identifier = to_symbol_expr(lhs).get_identifier();
+      if(induction_variables.count(identifier) != 0)
+        updated.insert(identifier);
+
+      continue;
+    }
+
+    const index_exprt &index_lhs = to_index_expr(lhs);
+    const exprt &rhs = t->get_assign().rhs();
+    int direction;
+
+    if(!has_unit_step(index_lhs.index(), direction) || !is_readable(rhs))
+      return false;
+
+    array_writes.push_back(
+      {to_symbol_expr(index_lhs.array()), {index_lhs.index(), updated}, rhs});
+  }
+
+  path.push_back(path_nodet(back_jump));
+
+  return true;
+}
+
+void syntactic_loop_accelerationt::assume_stay_condition(
+  const sitet &site,
+  const exprt &loop_counter,
+  goto_programt &quantified,
+  goto_programt &monotone)
+{
+  if(site.expr.id() == ID_and)
+  {
+    for(const auto &op : site.expr.operands())
+    {
+      assume_stay_condition(
+        {op, site.updated}, loop_counter, quantified, monotone);
+    }
+
+    return;
+  }
+
+  const exprt first = from_integer(0, loop_counter.type());
+  const minus_exprt last(loop_counter, from_integer(1, loop_counter.type()));
+
+  const irep_idt &id = site.expr.id();
+
+  if(
+    (id == ID_lt || id == ID_le || id == ID_gt || id == ID_ge ||
+     id == ID_notequal) &&
+    site.expr.operands().size() == 2)
+  {
+    const auto &relation = to_binary_relation_expr(site.expr);
+    const exprt *variable = &relation.lhs();
+    const exprt *invariant = &relation.rhs();
+
+    if(!is_invariant(*invariant))
+      std::swap(variable, invariant);
+
+    const exprt &stripped = skip_widening(*variable);
+
+    if(
+      is_invariant(*invariant) && stripped.id() == ID_symbol &&
+      induction_variables.count(to_symbol_expr(stripped).get_identifier()) !=
+        0)
+    {
+      int direction;
+
+      if(id != ID_notequal)
+      {
+        // A comparison of an induction variable with an invariant holds in
+        // all iterations iff it holds in the first and the last one.
+        monotone.add(goto_programt::make_assumption(at_iteration(site, first)));
+        monotone.add(goto_programt::make_assumption(at_iteration(site, last)));
+        return;
+      }
+      else if(has_unit_step(*variable, direction))
+      {
+        // An induction variable with unit step differs from an invariant in
+        // all iterations iff the latter is outside the values it takes.
+        const sitet value{*variable, site.updated};
+        const exprt value_first = at_iteration(value, first);
+        const exprt value_last = at_iteration(value, last);
+        const irep_idt &before = direction > 0 ? ID_lt : ID_gt;
+
+        monotone.add(goto_programt::make_assumption(or_exprt(
+          binary_relation_exprt(*invariant, before, value_first),
+          binary_relation_exprt(value_last, before, *invariant))));
+        return;
+      }
+    }
+  }
+
+  const symbol_exprt k =
+    utils.fresh_symbol("syntactic::k", loop_counter.type()).symbol_expr();
+
+  quantified.add(goto_programt::make_assumption(forall_exprt(
+    k,
+    implies_exprt(
+      binary_relation_exprt(k, ID_lt, loop_counter),
+      at_iteration(site, k)))));
+}
+
+bool syntactic_loop_accelerationt::accelerate(path_acceleratort &accelerator)
+{
+  accelerator.clear();
+
+  if(!match_loop(accelerator.path))
+  {
+    accelerator.clear();
+    return false;
+  }
+
+  const symbol_exprt loop_counter =
+    utils.fresh_symbol("syntactic::loop_counter", unsigned_poly_type())
+      .symbol_expr();
+
+  for(auto &entry : induction_variables)
+  {
+    entry.second.initial =
+      utils
+        .fresh_symbol("syntactic::initial", entry.second.variable.type())
+        .symbol_expr();
+  }
+
+  // The accelerator is of the form:
+  //
+  // loop_counter=*;
+  // assume(loop_counter >= 1);
+  // initial1=induction1;
+  // ...
+  // induction1=initial1 + loop_counter*step1;
+  // ...
+  // assume(no overflows in previous code);
+  // invariant1=value1;
+  // ...
+  // initial_array1=array1;
+  // array1=*;
+  // assume(forall k. k < loop_counter ==> array1[index1(k)]==value1(k));
+  // assume(forall j. j not in index1(0..loop_counter-1) ==>
+  //          array1[j]==initial_array1[j]);
+  // ...
+  // assume(stay conditions hold in iterations 0..loop_counter-1);
+  //
+  // The values of the induction variables in all iterations lie between
+  // their initial and final values, so checking the latter for overflows
+  // covers the former.
+  goto_programt &program = accelerator.pure_accelerator;
+  const source_locationt &source_location = loop_header->source_location;
+
+  program.add(goto_programt::make_assignment(
+    loop_counter,
+    side_effect_expr_nondett(loop_counter.type(), source_location)));
+  program.add(goto_programt::make_assumption(binary_relation_exprt(
+    loop_counter, ID_ge, from_integer(1, loop_counter.type()))));
+
+  for(const auto &entry : induction_variables)
+  {
+    program.add(goto_programt::make_assignment(
+      entry.second.initial, entry.second.variable));
+  }
+
+  for(const auto &entry : induction_variables)
+  {
+    const symbol_exprt &variable = entry.second.variable;
+    program.add(goto_programt::make_assignment(
+      variable, at_iteration({variable, {}}, loop_counter)));
+    accelerator.changed_vars.insert(variable);
+  }
+
+  const symbol_exprt overflow_var =
+    utils.fresh_symbol("syntactic::overflow", bool_typet()).symbol_expr();
+  overflow_instrumentert instrumenter(program, overflow_var, symbol_table);
+  instrumenter.add_overflow_checks();
+  program.add(goto_programt::make_assumption(not_exprt(overflow_var)));
+
+  for(const auto &assignment : invariant_assignments)
+  {
+    program.add(goto_programt::make_assignment(assignment));
+    accelerator.changed_vars.insert(assignment.lhs());
+  }
+
+  const minus_exprt last(loop_counter, from_integer(1, loop_counter.type()));
+
+  for(const auto &write : array_writes)
+  {
+    const symbol_exprt initial =
+      utils.fresh_symbol("syntactic::initial", write.array.type())
+        .symbol_expr();
+    program.add(goto_programt::make_assignment(initial, write.array));
+    program.add(goto_programt::make_assignment(
+      write.array,
+      side_effect_expr_nondett(write.array.type(), source_location)));
+
+    const symbol_exprt k =
+      utils.fresh_symbol("syntactic::k", loop_counter.type()).symbol_expr();
+    program.add(goto_programt::make_assumption(forall_exprt(
+      k,
+      implies_exprt(
+        binary_relation_exprt(k, ID_lt, loop_counter),
+        equal_exprt(
+          index_exprt(write.array, at_iteration(write.index, k)),
+          at_iteration({write.value, write.index.updated}, k))))));
+
+    int direction = 0;
+    has_unit_step(write.index.expr, direction);
+    exprt lower = at_iteration(write.index, from_integer(0, last.type()));
+    exprt upper = at_iteration(write.index, last);
+    if(direction < 0)
+      std::swap(lower, upper);
+
+    const symbol_exprt j =
+      utils.fresh_symbol("syntactic::j", write.index.expr.type())
+        .symbol_expr();
+    program.add(goto_programt::make_assumption(forall_exprt(
+      j,
+      implies_exprt(
+        not_exprt(and_exprt(
+          binary_relation_exprt(lower, ID_le, j),
+          binary_relation_exprt(j, ID_le, upper))),
+        equal_exprt(index_exprt(write.array, j), index_exprt(initial, j))))));
+
+    accelerator.changed_vars.insert(write.array);
+  }
+
+  goto_programt quantified;
+
+  for(const auto &site : stay_conditions)
+    assume_stay_condition(site, loop_counter, quantified, program);
+
+  program.destructive_append(quantified);
+
+  return true;
+}
@@ -0,0 +1,128 @@
+/*******************************************************************\
+
+Module: Loop Acceleration
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Syntactic Loop Acceleration
+
+#ifndef CPROVER_GOTO_INSTRUMENT_ACCELERATE_SYNTACTIC_LOOP_ACCELERATION_H
+#define CPROVER_GOTO_INSTRUMENT_ACCELERATE_SYNTACTIC_LOOP_ACCELERATION_H
+
+#include <map>
+#include <vector>
+
+#include <util/find_symbols.h>
+#include <util/std_expr.h>
+
+#include <goto-programs/goto_program.h>
+
+#include <analyses/natural_loops.h>
+
+#include "accelerator.h"
+#include "acceleration_utils.h"
+
+/// Accelerates loops that follow one of a few common idioms by building the
+/// closed form of their effect directly from their syntax. Unlike
+/// \ref enumerating_loop_accelerationt this needs no SAT queries, so it is
+/// cheap enough to try on every loop before falling back to the former.
+///
+/// A loop is matched if its instructions form a contiguous block that ends
+/// in the unconditional jump back to the header, in which all other jumps
+/// leave the loop, and in which every assignment has one of the forms
+/// - `x = x + c` or `x = x - c` (an induction variable),
+/// - `x = e`, where `x` is not read anywhere in the loop,
+/// - `a[i] = v`, where `i` is an induction variable with step 1 or -1,
+/// where `c` and `e` are loop invariant, and `v` and the conditions of the
+/// jumps depend on no other variables written in the loop than the induction
+/// variables. This covers counted loops with affine updates, loops that fill
+/// or copy arrays, and scans such as `while(s[i] != 0) ++i;`.
+class syntactic_loop_accelerationt
+{
+public:
+  syntactic_loop_accelerationt(
+    message_handlert &message_handler,
+    symbol_tablet &_symbol_table,
+    const goto_functionst &_goto_functions,
+    natural_loops_mutablet::natural_loopt &_loop,
+    goto_programt::targett _loop_header,
+    goto_programt::targett _back_jump)
+    : symbol_table(_symbol_table),
+      ns(symbol_table),
+      loop(_loop),
+      loop_header(_loop_header),
+      back_jump(_back_jump),
+      utils(symbol_table, message_handler, _goto_functions)
+  {
+  }
+
+  /// Build an accelerator for the loop
+  /// \return True iff the loop matches one of the idioms
+  bool accelerate(path_acceleratort &accelerator);
+
+protected:
+  symbol_tablet &symbol_table;
+  namespacet ns;
+  natural_loops_mutablet::natural_loopt &loop;
+  goto_programt::targett loop_header;
+  goto_programt::targett back_jump;
+  acceleration_utilst utils;
+
+  struct induction_variablet
+  {
+    symbol_exprt variable;
+    exprt step;
+    bool decreasing;
+    /// Holds the value of the variable before the accelerated iterations,
+    /// set once the loop has been matched
+    exprt initial;
+  };
+
+  /// Variables that are assigned in the loop, by kind
+  std::map<irep_idt, induction_variablet> induction_variables;
+  std::vector<code_assignt> invariant_assignments;
+  find_symbols_sett written_scalars;
+  find_symbols_sett written_arrays;
+
+  /// An expression that is evaluated in the loop, together with the
+  /// induction variables that have already been updated in the iteration
+  /// when it is evaluated
+  struct sitet
+  {
+    exprt expr;
+    find_symbols_sett updated;
+  };
+
+  /// Conditions under which the loop is not left
+  std::vector<sitet> stay_conditions;
+
+  struct array_writet
+  {
+    symbol_exprt array;
+    /// The index, which is an induction variable, possibly widened
+    sitet index;
+    /// The value, in the same iteration as the index
+    exprt value;
+  };
+
+  std::vector<array_writet> array_writes;
+
+  bool match_loop(patht &path);
+
+  bool is_invariant(const exprt &expr) const;
+  bool is_readable(const exprt &expr) const;
+  bool has_unit_step(const exprt &expr, int &direction) const;
+
+  exprt at_iteration(const sitet &site, const exprt &iteration) const;
+
+  void assume_stay_condition(
+    const sitet &site,
+    const exprt &loop_counter,
+    goto_programt &quantified,
+    goto_programt &monotone);
+};
+
+#endif // CPROVER_GOTO_INSTRUMENT_ACCELERATE_SYNTACTIC_LOOP_ACCELERATION_H
@@ -13,9 +13,16 @@ Date: February 2016
 
 #include "code_contracts.h"
 
+#include <map>
+#include <set>
+#include <sstream>
+
+#include <util/exception_utils.h>
 #include <util/expr_util.h>
+#include <util/find_symbols.h>
 #include <util/fresh_symbol.h>
 #include <util/replace_symbol.h>
+#include <util/string_hash.h>
 
 #include <goto-programs/remove_skip.h>
 
@@ -40,6 +47,9 @@ public:
 
   void operator()();
 
+  void enforce(const irep_idt &function);
+  void replace_calls();
+
 protected:
   namespacet ns;
   symbol_tablet &symbol_table;
@@ -57,7 +67,8 @@ protected:
 
   void add_contract_check(
     const irep_idt &function,
-    goto_programt &dest);
+    goto_programt &dest,
+    bool unconditional = false);
 
   const symbolt &new_tmp_symbol(
     const typet &type,
@@ -259,7 +270,8 @@ const symbolt &code_contractst::new_tmp_symbol(
 
 void code_contractst::add_contract_check(
   const irep_idt &function,
-  goto_programt &dest)
+  goto_programt &dest,
+  bool unconditional)
 {
   assert(!dest.instructions.empty());
 
@@ -276,7 +288,7 @@ void code_contractst::add_contract_check(
   assert(ensures.is_not_nil());
 
   // build:
-  // if(nondet)
+  // if(nondet)  [unless unconditional]
   //   decl ret
   //   decl parameter1 ...
   //   assume(requires)  [optional]
@@ -293,10 +305,13 @@ void code_contractst::add_contract_check(
   goto_programt check;
 
   // if(nondet)
-  check.add(goto_programt::make_goto(
-    skip,
-    side_effect_expr_nondett(bool_typet(), skip->source_location),
-    skip->source_location));
+  if(!unconditional)
+  {
+    check.add(goto_programt::make_goto(
+      skip,
+      side_effect_expr_nondett(bool_typet(), skip->source_location),
+      skip->source_location));
+  }
 
   // prepare function call including all declarations
   const symbolt &function_symbol = ns.lookup(function);
@@ -388,7 +403,242 @@ void code_contractst::operator()()
   goto_functions.update();
 }
 
+void code_contractst::enforce(const irep_idt &function)
+{
+  const symbolt *function_symbol = symbol_table.lookup(function);
+  if(
+    function_symbol == nullptr ||
+    function_symbol->type.find(ID_C_spec_ensures).is_nil() ||
+    goto_functions.function_map.find(function) ==
+      goto_functions.function_map.end())
+  {
+    throw invalid_command_line_argument_exceptiont(
+      "function `" + id2string(function) + "' has no contract",
+      "--enforce-contract");
+  }
+
+  Forall_goto_functions(it, goto_functions)
+    code_contracts(it->second);
+
+  goto_functionst::function_mapt::iterator i_it=
+    goto_functions.function_map.find(INITIALIZE_FUNCTION);
+  assert(i_it!=goto_functions.function_map.end());
+
+  add_contract_check(function, i_it->second.body, true);
+
+  goto_functions.update();
+}
+
+void code_contractst::replace_calls()
+{
+  Forall_goto_functions(it, goto_functions)
+    code_contracts(it->second);
+
+  goto_functions.update();
+}
+
 void code_contracts(goto_modelt &goto_model)
 {
   code_contractst(goto_model.symbol_table, goto_model.goto_functions)();
 }
+
+void enforce_contract(goto_modelt &goto_model, const irep_idt &function)
+{
+  code_contractst(goto_model.symbol_table, goto_model.goto_functions)
+    .enforce(function);
+}
+
+void replace_calls_with_contracts(goto_modelt &goto_model)
+{
+  code_contractst(goto_model.symbol_table, goto_model.goto_functions)
+    .replace_calls();
+}
+
+static bool has_contract(const namespacet &ns, const irep_idt &function)
+{
+  const symbolt *symbol;
+  return !ns.lookup(function, symbol) &&
+         symbol->type.find(ID_C_spec_ensures).is_not_nil();
+}
+
+/// Writes \p irep without any comments (such as source locations), with
+/// named sub-trees in lexicographic order, so that the output does not
+/// depend on the order in which identifiers were created
+static void output_stable(const irept &irep, std::ostream &out)
+{
+  out << '(' << irep.id();
+
+  std::map<std::string, const irept *> named_sub;
+  for(const auto &entry : irep.get_named_sub())
+  {
+    if(!irept::is_comment(entry.first))
+      named_sub.emplace(id2string(entry.first), &entry.second);
+  }
+
+  for(const auto &entry : named_sub)
+  {
+    out << ' ' << entry.first << '=';
+    output_stable(*entry.second, out);
+  }
+
+  for(const auto &sub : irep.get_sub())
+  {
+    out << ' ';
+    output_stable(sub, out);
+  }
+
+  out << ')';
+}
+
+/// Hash of the bodies of all functions that the job rooted at \p root
+/// executes and of the contracts it uses: the bodies of functions without a
+/// contract are followed, calls to functions with a contract only depend on
+/// the contract. The types of all symbols these refer to, and the initial
+/// values of the global variables among them, are included as well.
+static std::size_t contract_job_hash(
+  const goto_modelt &goto_model,
+  const namespacet &ns,
+  const irep_idt &root)
+{
+  std::set<std::string> bodies;
+  std::set<std::string> contracts;
+
+  if(has_contract(ns, root))
+    contracts.insert(id2string(root));
+
+  std::vector<irep_idt> worklist;
+  bodies.insert(id2string(root));
+  worklist.push_back(root);
+
+  while(!worklist.empty())
+  {
+    const irep_idt function = worklist.back();
+    worklist.pop_back();
+
+    const auto f_it = goto_model.goto_functions.function_map.find(function);
+    if(f_it == goto_model.goto_functions.function_map.end())
+      continue;
+
+    forall_goto_program_instructions(i_it, f_it->second.body)
+    {
+      if(!i_it->is_function_call())
+        continue;
+
+      const exprt &callee = i_it->get_function_call().function();
+      if(callee.id() != ID_symbol)
+        continue;
+
+      const irep_idt &callee_id = to_symbol_expr(callee).get_identifier();
+      if(has_contract(ns, callee_id))
+        contracts.insert(id2string(callee_id));
+      else if(bodies.insert(id2string(callee_id)).second)
+        worklist.push_back(callee_id);
+    }
+  }
+
+  std::ostringstream out;
+  find_symbols_sett used_symbols;
+
+  for(const auto &function : bodies)
+  {
+    out << "body " << function << '\n';
+
+    const auto f_it = goto_model.goto_functions.function_map.find(function);
+    if(f_it == goto_model.goto_functions.function_map.end())
+      continue;
+
+    forall_goto_program_instructions(i_it, f_it->second.body)
+    {
+      out << i_it->type << ' ';
+      if(i_it->has_condition())
+      {
+        output_stable(i_it->get_condition(), out);
+        find_type_and_expr_symbols(i_it->get_condition(), used_symbols);
+      }
+      output_stable(i_it->code, out);
+      find_type_and_expr_symbols(i_it->code, used_symbols);
+      for(const auto &target : i_it->targets)
+        out << ' ' << target->target_number;
+      out << '\n';
+    }
+  }
+
+  for(const auto &function : contracts)
+  {
+    const code_typet &type = to_code_type(ns.lookup(function).type);
+    out << "contract " << function << '\n';
+    output_stable(type.find(ID_C_spec_requires), out);
+    output_stable(type.find(ID_C_spec_ensures), out);
+    out << '\n';
+    find_type_and_expr_symbols(type, used_symbols);
+    find_type_and_expr_symbols(
+      static_cast<const exprt &>(type.find(ID_C_spec_requires)), used_symbols);
+    find_type_and_expr_symbols(
+      static_cast<const exprt &>(type.find(ID_C_spec_ensures)), used_symbols);
+  }
+
+  // symbols and tags used by the types and initial values that are hashed
+  std::set<std::string> symbols;
+  std::vector<irep_idt> symbol_worklist(
+    used_symbols.begin(), used_symbols.end());
+  while(!symbol_worklist.empty())
+  {
+    const irep_idt identifier = symbol_worklist.back();
+    symbol_worklist.pop_back();
+
+    const symbolt *symbol;
+    if(
+      !symbols.insert(id2string(identifier)).second ||
+      ns.lookup(identifier, symbol))
+    {
+      continue;
+    }
+
+    find_symbols_sett dependencies;
+    find_type_and_expr_symbols(symbol->type, dependencies);
+    if(symbol->is_static_lifetime && symbol->type.id() != ID_code)
+      find_type_and_expr_symbols(symbol->value, dependencies);
+    symbol_worklist.insert(
+      symbol_worklist.end(), dependencies.begin(), dependencies.end());
+  }
+
+  for(const auto &identifier : symbols)
+  {
+    const symbolt *symbol;
+    if(ns.lookup(identifier, symbol))
+      continue;
+
+    out << "symbol " << identifier << '\n';
+    output_stable(symbol->type, out);
+    if(symbol->is_static_lifetime && symbol->type.id() != ID_code)
+    {
+      out << ' ';
+      output_stable(symbol->value, out);
+    }
+    out << '\n';
+  }
+
+  return hash_string(out.str());
+}
+
+void show_contract_jobs(const goto_modelt &goto_model, std::ostream &out)
+{
+  const namespacet ns(goto_model.symbol_table);
+
+  std::set<std::string> jobs;
+  for(const auto &f : goto_model.goto_functions.function_map)
+  {
+    if(f.second.body_available() && has_contract(ns, f.first))
+      jobs.insert(id2string(f.first));
+  }
+
+  for(const auto &job : jobs)
+  {
+    out << job << ' ' << std::hex << contract_job_hash(goto_model, ns, job)
+        << std::dec << '\n';
+  }
+
+  const irep_idt entry_point = goto_functionst::entry_point();
+  out << entry_point << ' ' << std::hex
+      << contract_job_hash(goto_model, ns, entry_point) << std::dec << '\n';
+}
@@ -14,8 +14,30 @@ Date: February 2016
 #ifndef CPROVER_GOTO_INSTRUMENT_CODE_CONTRACTS_H
 #define CPROVER_GOTO_INSTRUMENT_CODE_CONTRACTS_H
 
+#include <iosfwd>
+
+#include <util/irep.h>
+
 class goto_modelt;
 
 void code_contracts(goto_modelt &);
 
+/// Replaces all calls to functions with a contract by their contracts and
+/// checks \p function, which must have a contract, against its contract.
+/// The check is the only part of the program that is executed, which makes
+/// this a verification job of its own.
+void enforce_contract(goto_modelt &, const irep_idt &function);
+
+/// Replaces all calls to functions with a contract by their contracts
+/// without checking any of the contracts.
+void replace_calls_with_contracts(goto_modelt &);
+
+/// Lists the verification jobs of a modular proof: one per function with a
+/// contract, see \ref enforce_contract, and one for the entry point, see
+/// \ref replace_calls_with_contracts. Each job comes with a hash of the
+/// bodies, contracts, symbol types and global initial values its result
+/// depends on, such that a result can be cached for as long as the hash does
+/// not change.
+void show_contract_jobs(const goto_modelt &, std::ostream &);
+
 #endif // CPROVER_GOTO_INSTRUMENT_CODE_CONTRACTS_H
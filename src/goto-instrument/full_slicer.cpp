@@ -12,8 +12,12 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "full_slicer.h"
 #include "full_slicer_class.h"
 
-#include <util/find_symbols.h>
+#include <algorithm>
+
+#include <util/byte_operators.h>
 #include <util/cprover_prefix.h>
+#include <util/expr_util.h>
+#include <util/find_symbols.h>
 
 #include <goto-programs/remove_skip.h>
 
@@ -85,7 +89,7 @@ void full_slicert::add_decl_dead(
 void full_slicert::add_jumps(
   queuet &queue,
   jumpst &jumps,
-  const dependence_grapht::post_dominators_mapt &post_dominators)
+  const get_post_dominatorst &post_dominators)
 {
   // Based on:
   // On slicing programs with jump statements
@@ -139,7 +143,7 @@ void full_slicert::add_jumps(
     }
 
     const irep_idt &id = j.function_id;
-    const cfg_post_dominatorst &pd=post_dominators.at(id);
+    const cfg_post_dominatorst &pd = post_dominators(id);
 
     const auto &j_PC_node = pd.get_node(j.PC);
 
@@ -192,14 +196,9 @@ void full_slicert::fixedpoint(
   queuet &queue,
   jumpst &jumps,
   decl_deadt &decl_dead,
-  const dependence_grapht &dep_graph)
+  const add_dependenciest &add_dependencies,
+  const get_post_dominatorst &post_dominators)
 {
-  std::vector<cfgt::entryt> dep_node_to_cfg;
-  dep_node_to_cfg.reserve(dep_graph.size());
-
-  for(dependence_grapht::node_indext i = 0; i < dep_graph.size(); ++i)
-    dep_node_to_cfg.push_back(cfg.get_node_index(dep_graph[i].PC));
-
   // process queue until empty
   while(!queue.empty())
   {
@@ -217,7 +216,7 @@ void full_slicert::fixedpoint(
       node.node_required=true;
 
       // add data and control dependencies of node
-      add_dependencies(node, queue, dep_graph, dep_node_to_cfg);
+      add_dependencies(node, queue);
 
       // retain all calls of the containing function
       add_function_calls(node, queue, goto_functions);
@@ -227,8 +226,439 @@ void full_slicert::fixedpoint(
     }
 
     // add any required jumps
-    add_jumps(queue, jumps, dep_graph.cfg_post_dominators());
+    add_jumps(queue, jumps, post_dominators);
+  }
+}
+
+/// Stands for all memory accessed through pointers in the variables used by
+/// \ref full_slicert::sparse_dependenciest, which is not a valid identifier
+static const irep_idt &dereferenced_memory()
+{
+  static const irep_idt identifier = "#dereferenced";
+  return identifier;
+}
+
+/// Add the variables read when evaluating \p expr to \p reads
+static void get_reads(const exprt &expr, find_symbols_sett &reads)
+{
+  find_symbols_or_nexts(expr, reads);
+
+  if(has_subexpr(expr, ID_dereference))
+    reads.insert(dereferenced_memory());
+}
+
+/// Return the variable that assignments to \p lhs write to, or the empty
+/// identifier if it may be written through a pointer. The variables read to
+/// determine the target, such as array indices, are added to \p reads.
+static irep_idt get_written(const exprt &lhs, find_symbols_sett &reads)
+{
+  const exprt *target = &lhs;
+
+  while(true)
+  {
+    if(target->id() == ID_symbol)
+      return to_symbol_expr(*target).get_identifier();
+    else if(target->id() == ID_member)
+      target = &to_member_expr(*target).compound();
+    else if(target->id() == ID_index)
+    {
+      get_reads(to_index_expr(*target).index(), reads);
+      target = &to_index_expr(*target).array();
+    }
+    else if(
+      target->id() == ID_byte_extract_little_endian ||
+      target->id() == ID_byte_extract_big_endian)
+    {
+      get_reads(to_byte_extract_expr(*target).offset(), reads);
+      target = &to_byte_extract_expr(*target).op();
+    }
+    else if(target->id() == ID_typecast)
+      target = &to_typecast_expr(*target).op();
+    else if(target->id() == ID_dereference)
+    {
+      get_reads(to_dereference_expr(*target).pointer(), reads);
+      return irep_idt();
+    }
+    else
+    {
+      get_reads(*target, reads);
+      return irep_idt();
+    }
+  }
+}
+
+/// Return the variables read by \p instruction
+static find_symbols_sett
+get_reads(const goto_programt::instructiont &instruction)
+{
+  find_symbols_sett reads;
+
+  switch(instruction.type)
+  {
+  case ASSIGN:
+  {
+    const code_assignt &assign = to_code_assign(instruction.code);
+    get_reads(assign.rhs(), reads);
+    get_written(assign.lhs(), reads);
+    break;
+  }
+
+  case FUNCTION_CALL:
+  {
+    const code_function_callt &call = to_code_function_call(instruction.code);
+    get_reads(call.function(), reads);
+    for(const auto &argument : call.arguments())
+      get_reads(argument, reads);
+    if(call.lhs().is_not_nil())
+      get_written(call.lhs(), reads);
+    break;
+  }
+
+  case DECL:
+  case DEAD:
+  case SKIP:
+  case LOCATION:
+  case END_FUNCTION:
+  case ATOMIC_BEGIN:
+  case ATOMIC_END:
+  case NO_INSTRUCTION_TYPE:
+    break;
+
+  case GOTO:
+  case ASSUME:
+  case ASSERT:
+  case RETURN:
+  case OTHER:
+  case START_THREAD:
+  case END_THREAD:
+  case THROW:
+  case CATCH:
+  case INCOMPLETE_GOTO:
+    get_reads(instruction.code, reads);
+    get_reads(instruction.guard, reads);
+    break;
+  }
+
+  return reads;
+}
+
+full_slicert::sparse_dependenciest::sparse_dependenciest(
+  const goto_functionst &goto_functions,
+  const namespacet &ns,
+  const cfgt &cfg)
+  : goto_functions(goto_functions), ns(ns), cfg(cfg), dirty(goto_functions)
+{
+}
+
+void full_slicert::sparse_dependenciest::operator()(
+  const cfgt::nodet &node,
+  const std::function<void(cfgt::entryt)> &add_dependency)
+{
+  const cfgt::entryt entry = cfg.get_node_index(node.PC);
+
+  for(const auto &identifier : get_reads(*node.PC))
+    add_definitions(identifier, entry, add_dependency);
+
+  const control_dependenciest &branches =
+    control_dependencies(node.function_id);
+  const auto branches_it = branches.find(entry);
+  if(branches_it != branches.end())
+  {
+    for(const auto &branch : branches_it->second)
+      add_dependency(branch);
+  }
+}
+
+const cfg_post_dominatorst &
+full_slicert::sparse_dependenciest::post_dominators(
+  const irep_idt &function_id)
+{
+  auto entry = post_dominators_map.find(function_id);
+  if(entry == post_dominators_map.end())
+  {
+    cfg_post_dominatorst &pd = post_dominators_map[function_id];
+    pd(goto_functions.function_map.at(function_id).body);
+    return pd;
+  }
+
+  return entry->second;
+}
+
+bool full_slicert::sparse_dependenciest::is_local(
+  const irep_idt &identifier) const
+{
+  const symbolt *symbol;
+  if(identifier == dereferenced_memory() || ns.lookup(identifier, symbol))
+    return false;
+
+  return !symbol->is_static_lifetime && !dirty(identifier);
+}
+
+/// How an instruction affects a variable
+enum class definitiont
+{
+  /// the variable is not written
+  NONE,
+  /// the variable may be written, or only a part of it is
+  MAY,
+  /// the variable is overwritten
+  MUST,
+  /// the variable goes into or out of scope
+  SCOPE
+};
+
+/// Return how \p instruction affects the variable \p identifier, where
+/// \p may_be_pointed_to tells whether writes through pointers may change it
+static definitiont get_definition(
+  const goto_programt::instructiont &instruction,
+  const irep_idt &identifier,
+  bool may_be_pointed_to,
+  const goto_functionst &goto_functions,
+  const dirtyt &dirty)
+{
+  // how the assignment to lhs affects the variable
+  const auto assigns = [&](const exprt &lhs, definitiont whole) {
+    find_symbols_sett reads;
+    const irep_idt written = get_written(lhs, reads);
+
+    if(written.empty())
+      return may_be_pointed_to ? definitiont::MAY : definitiont::NONE;
+    else if(written == identifier)
+      return lhs.id() == ID_symbol ? whole : definitiont::MAY;
+    else if(identifier == dereferenced_memory() && dirty(written))
+      return definitiont::MAY;
+    else
+      return definitiont::NONE;
+  };
+
+  switch(instruction.type)
+  {
+  case ASSIGN:
+    return assigns(to_code_assign(instruction.code).lhs(), definitiont::MUST);
+
+  case FUNCTION_CALL:
+  {
+    const code_function_callt &call = to_code_function_call(instruction.code);
+
+    // the call assigns the parameters of the function
+    if(call.function().id() == ID_symbol)
+    {
+      const auto f_it = goto_functions.function_map.find(
+        to_symbol_expr(call.function()).get_identifier());
+      if(
+        f_it != goto_functions.function_map.end() &&
+        std::find(
+          f_it->second.parameter_identifiers.begin(),
+          f_it->second.parameter_identifiers.end(),
+          identifier) != f_it->second.parameter_identifiers.end())
+      {
+        return definitiont::MUST;
+      }
+    }
+
+    // the return value is assigned once the call returns, while the callee
+    // may change the variable before
+    if(call.lhs().is_nil())
+      return definitiont::NONE;
+    const definitiont definition = assigns(call.lhs(), definitiont::MAY);
+    return definition == definitiont::NONE ? definitiont::NONE
+                                           : definitiont::MAY;
+  }
+
+  case DECL:
+    return to_code_decl(instruction.code).get_identifier() == identifier
+             ? definitiont::SCOPE
+             : definitiont::NONE;
+
+  case DEAD:
+    return to_code_dead(instruction.code).get_identifier() == identifier
+             ? definitiont::SCOPE
+             : definitiont::NONE;
+
+  case OTHER:
+  case RETURN:
+  {
+    if(may_be_pointed_to)
+      return definitiont::MAY;
+
+    find_symbols_sett symbols;
+    find_symbols_or_nexts(instruction.code, symbols);
+    return symbols.count(identifier) != 0 ? definitiont::MAY
+                                          : definitiont::NONE;
+  }
+
+  case GOTO:
+  case ASSUME:
+  case ASSERT:
+  case SKIP:
+  case LOCATION:
+  case END_FUNCTION:
+  case ATOMIC_BEGIN:
+  case ATOMIC_END:
+  case START_THREAD:
+  case END_THREAD:
+  case THROW:
+  case CATCH:
+  case INCOMPLETE_GOTO:
+  case NO_INSTRUCTION_TYPE:
+    break;
+  }
+
+  return definitiont::NONE;
+}
+
+void full_slicert::sparse_dependenciest::add_definitions(
+  const irep_idt &identifier,
+  cfgt::entryt use,
+  const std::function<void(cfgt::entryt)> &add_dependency)
+{
+  std::unordered_set<cfgt::entryt> &searched_from = searched[identifier];
+  if(!searched_from.insert(use).second)
+    return;
+
+  const bool may_be_pointed_to =
+    identifier == dereferenced_memory() || dirty(identifier);
+
+  // local variables are neither changed by called functions nor do they
+  // outlive the function, which does not apply to parameters of recursive
+  // functions, but then the calls are definitions themselves
+  const bool local = is_local(identifier);
+  const symbolt *symbol = nullptr;
+  const bool parameter =
+    local && !ns.lookup(identifier, symbol) && symbol->is_parameter;
+
+  std::vector<cfgt::entryt> stack(1, use);
+
+  while(!stack.empty())
+  {
+    const cfgt::nodet &node = cfg[stack.back()];
+    stack.pop_back();
+
+    for(const auto &in_edge : node.in)
+    {
+      cfgt::entryt predecessor = in_edge.first;
+      goto_programt::const_targett predecessor_PC = cfg[predecessor].PC;
+
+      if(local && predecessor_PC->is_end_function())
+      {
+        // returning from a function, continue at the call
+        predecessor = cfg.get_node_index(std::prev(node.PC));
+        predecessor_PC = cfg[predecessor].PC;
+      }
+      else if(
+        local && predecessor_PC->is_function_call() &&
+        &*std::next(predecessor_PC) != &*node.PC)
+      {
+        // entering the function from a call
+        if(parameter)
+          add_dependency(predecessor);
+        continue;
+      }
+
+      switch(get_definition(
+        *predecessor_PC, identifier, may_be_pointed_to, goto_functions, dirty))
+      {
+      case definitiont::MUST:
+        add_dependency(predecessor);
+        continue;
+      case definitiont::SCOPE:
+        continue;
+      case definitiont::MAY:
+        add_dependency(predecessor);
+        break;
+      case definitiont::NONE:
+        break;
+      }
+
+      if(searched_from.insert(predecessor).second)
+        stack.push_back(predecessor);
+    }
+  }
+}
+
+const full_slicert::sparse_dependenciest::control_dependenciest &
+full_slicert::sparse_dependenciest::control_dependencies(
+  const irep_idt &function_id)
+{
+  const auto entry = control_dependencies_map.find(function_id);
+  if(entry != control_dependencies_map.end())
+    return entry->second;
+
+  control_dependenciest &dependencies = control_dependencies_map[function_id];
+  const cfg_post_dominatorst &pd = post_dominators(function_id);
+  const goto_programt::instructionst &instructions =
+    goto_functions.function_map.at(function_id).body.instructions;
+
+  // the immediate post-dominator is the strict post-dominator with the most
+  // post-dominators, or end() if there is none
+  std::map<goto_programt::const_targett, goto_programt::const_targett>
+    immediate_post_dominators;
+  const auto immediate_post_dominator = [&](goto_programt::const_targett t) {
+    const auto ipd_it = immediate_post_dominators.find(t);
+    if(ipd_it != immediate_post_dominators.end())
+      return ipd_it->second;
+
+    goto_programt::const_targett ipd = instructions.end();
+    std::size_t post_dom_size = 0;
+    for(const auto &d : pd.get_node(t).dominators)
+    {
+      const std::size_t d_size = pd.get_node(d).dominators.size();
+      if(d != t && d_size > post_dom_size)
+      {
+        ipd = d;
+        post_dom_size = d_size;
+      }
+    }
+
+    immediate_post_dominators.emplace(t, ipd);
+    return ipd;
+  };
+
+  // Based on:
+  // The program dependence graph and its use in optimization
+  // Ferrante, Ottenstein, Warren, TOPLAS'87
+  // An instruction on the path in the post-dominator tree from a successor
+  // of a branch up to, but excluding, the immediate post-dominator of the
+  // branch is control dependent on the branch.
+  for(auto it = instructions.begin(); it != instructions.end(); ++it)
+  {
+    std::vector<goto_programt::const_targett> successors;
+
+    if(it->is_goto() && !it->get_condition().is_true())
+    {
+      successors.assign(it->targets.begin(), it->targets.end());
+      successors.push_back(std::next(it));
+    }
+    else if(it->is_assume())
+    {
+      // all that follows may depend on whether execution continues
+      successors.push_back(std::next(it));
+    }
+    else
+      continue;
+
+    const goto_programt::const_targett stop =
+      it->is_assume() ? instructions.end() : immediate_post_dominator(it);
+    const cfgt::entryt branch = cfg.get_node_index(it);
+
+    for(auto successor : successors)
+    {
+      while(successor != instructions.end() && successor != stop)
+      {
+        auto &branches = dependencies[cfg.get_node_index(successor)];
+        if(
+          std::find(branches.begin(), branches.end(), branch) !=
+          branches.end())
+        {
+          break;
+        }
+        branches.push_back(branch);
+        successor = immediate_post_dominator(successor);
+      }
+    }
   }
+
+  return dependencies;
 }
 
 static bool implicit(goto_programt::const_targett target)
@@ -295,12 +725,49 @@ void full_slicert::operator()(
     }
   }
 
-  // compute program dependence graph (and post-dominators)
-  dependence_grapht dep_graph(ns);
-  dep_graph(goto_functions, ns);
-
-  // compute the fixedpoint
-  fixedpoint(goto_functions, queue, jumps, decl_dead, dep_graph);
+  if(sparse)
+  {
+    sparse_dependenciest dependencies(goto_functions, ns, cfg);
+
+    fixedpoint(
+      goto_functions,
+      queue,
+      jumps,
+      decl_dead,
+      [&](const cfgt::nodet &node, queuet &queue) {
+        dependencies(node, [&](cfgt::entryt dependency) {
+          add_to_queue(queue, dependency, node.PC);
+        });
+      },
+      [&](const irep_idt &function_id) -> const cfg_post_dominatorst & {
+        return dependencies.post_dominators(function_id);
+      });
+  }
+  else
+  {
+    // compute program dependence graph (and post-dominators)
+    dependence_grapht dep_graph(ns);
+    dep_graph(goto_functions, ns);
+
+    dep_node_to_cfgt dep_node_to_cfg;
+    dep_node_to_cfg.reserve(dep_graph.size());
+
+    for(dependence_grapht::node_indext i = 0; i < dep_graph.size(); ++i)
+      dep_node_to_cfg.push_back(cfg.get_node_index(dep_graph[i].PC));
+
+    // compute the fixedpoint
+    fixedpoint(
+      goto_functions,
+      queue,
+      jumps,
+      decl_dead,
+      [&](const cfgt::nodet &node, queuet &queue) {
+        add_dependencies(node, queue, dep_graph, dep_node_to_cfg);
+      },
+      [&](const irep_idt &function_id) -> const cfg_post_dominatorst & {
+        return dep_graph.cfg_post_dominators().at(function_id);
+      });
+  }
 
   // now replace those instructions that are not needed
   // by skips
@@ -358,11 +825,12 @@ void full_slicer(
   full_slicert()(goto_functions, ns, a);
 }
 
-void full_slicer(goto_modelt &goto_model)
+void full_slicer(goto_modelt &goto_model, bool sparse)
 {
   assert_criteriont a;
   const namespacet ns(goto_model.symbol_table);
-  full_slicert()(goto_model.goto_functions, ns, a);
+  full_slicert slicer(sparse);
+  slicer(goto_model.goto_functions, ns, a);
 }
 
 void property_slicer(
@@ -376,10 +844,13 @@ void property_slicer(
 
 void property_slicer(
   goto_modelt &goto_model,
-  const std::list<std::string> &properties)
+  const std::list<std::string> &properties,
+  bool sparse)
 {
+  properties_criteriont p(properties);
   const namespacet ns(goto_model.symbol_table);
-  property_slicer(goto_model.goto_functions, ns, properties);
+  full_slicert slicer(sparse);
+  slicer(goto_model.goto_functions, ns, p);
 }
 
 slicing_criteriont::~slicing_criteriont()
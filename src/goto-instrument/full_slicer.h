@@ -18,16 +18,23 @@ void full_slicer(
   goto_functionst &,
   const namespacet &);
 
-void full_slicer(goto_modelt &);
+/// Slice with respect to all assertions
+/// \param sparse: compute dependencies on demand rather than building a
+///   dependence graph of the whole program, which scales to larger programs
+///   at the price of a less precise treatment of pointers
+void full_slicer(goto_modelt &, bool sparse = false);
 
 void property_slicer(
   goto_functionst &,
   const namespacet &,
   const std::list<std::string> &properties);
 
+/// Slice with respect to the given \p properties, see \ref full_slicer for
+/// \p sparse
 void property_slicer(
   goto_modelt &,
-  const std::list<std::string> &properties);
+  const std::list<std::string> &properties,
+  bool sparse = false);
 
 class slicing_criteriont
 {
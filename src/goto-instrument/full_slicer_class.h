@@ -12,7 +12,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_GOTO_INSTRUMENT_FULL_SLICER_CLASS_H
 #define CPROVER_GOTO_INSTRUMENT_FULL_SLICER_CLASS_H
 
+#include <functional>
 #include <stack>
+#include <unordered_set>
 #include <vector>
 #include <list>
 
@@ -20,6 +22,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <goto-programs/cfg.h>
 
 #include <analyses/dependence_graph.h>
+#include <analyses/dirty.h>
 
 #include "full_slicer.h"
 
@@ -38,12 +41,21 @@ echo 'digraph g {' > c.dot ; cat c.goto | \
 class full_slicert
 {
 public:
+  /// \param sparse: compute the dependencies of the instructions only once
+  ///   they are found to be in the slice, see \ref sparse_dependenciest,
+  ///   rather than building a dependence graph of the whole program upfront
+  explicit full_slicert(bool sparse = false) : sparse(sparse)
+  {
+  }
+
   void operator()(
     goto_functionst &goto_functions,
     const namespacet &ns,
     const slicing_criteriont &criterion);
 
 protected:
+  const bool sparse;
+
   struct cfg_nodet
   {
     cfg_nodet():node_required(false)
@@ -65,12 +77,71 @@ protected:
   typedef std::list<cfgt::entryt> jumpst;
   typedef std::unordered_map<irep_idt, queuet> decl_deadt;
 
+  /// Adds the instructions the given instruction depends on to the queue
+  typedef std::function<void(const cfgt::nodet &, queuet &)>
+    add_dependenciest;
+  typedef std::function<const cfg_post_dominatorst &(const irep_idt &)>
+    get_post_dominatorst;
+
+  /// Computes data and control dependencies of single instructions on
+  /// demand. Data dependencies are found by searching backwards in the
+  /// interprocedural CFG from a use of a variable to the instructions that
+  /// may define it, stopping at those that certainly do. Each variable is
+  /// searched for from each instruction at most once. Writes through
+  /// pointers are assumed to possibly define any variable whose address is
+  /// taken. Control dependencies and post-dominators are only computed for
+  /// the functions that contain instructions in the slice.
+  class sparse_dependenciest
+  {
+  public:
+    sparse_dependenciest(
+      const goto_functionst &goto_functions,
+      const namespacet &ns,
+      const cfgt &cfg);
+
+    void operator()(
+      const cfgt::nodet &node,
+      const std::function<void(cfgt::entryt)> &add_dependency);
+
+    const cfg_post_dominatorst &post_dominators(const irep_idt &function_id);
+
+  protected:
+    const goto_functionst &goto_functions;
+    const namespacet &ns;
+    const cfgt &cfg;
+    const dirtyt dirty;
+
+    std::map<irep_idt, cfg_post_dominatorst> post_dominators_map;
+
+    /// Maps instructions of a function to the branches they are control
+    /// dependent on
+    typedef std::unordered_map<cfgt::entryt, std::vector<cfgt::entryt>>
+      control_dependenciest;
+    std::unordered_map<irep_idt, control_dependenciest>
+      control_dependencies_map;
+
+    /// For each variable, the instructions from which the instructions
+    /// defining it have been searched for already
+    std::unordered_map<irep_idt, std::unordered_set<cfgt::entryt>> searched;
+
+    const control_dependenciest &
+    control_dependencies(const irep_idt &function_id);
+
+    void add_definitions(
+      const irep_idt &identifier,
+      cfgt::entryt use,
+      const std::function<void(cfgt::entryt)> &add_dependency);
+
+    bool is_local(const irep_idt &identifier) const;
+  };
+
   void fixedpoint(
     goto_functionst &goto_functions,
     queuet &queue,
     jumpst &jumps,
     decl_deadt &decl_dead,
-    const dependence_grapht &dep_graph);
+    const add_dependenciest &add_dependencies,
+    const get_post_dominatorst &post_dominators);
 
   void add_dependencies(
     const cfgt::nodet &node,
@@ -91,7 +162,7 @@ protected:
   void add_jumps(
     queuet &queue,
     jumpst &jumps,
-    const dependence_grapht::post_dominators_mapt &post_dominators);
+    const get_post_dominatorst &post_dominators);
 
   void add_to_queue(
     queuet &queue,
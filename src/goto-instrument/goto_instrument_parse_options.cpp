@@ -63,6 +63,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <analyses/is_threaded.h>
 #include <analyses/lexical_loops.h>
 #include <analyses/local_bitvector_analysis.h>
+#include <analyses/local_may_alias.h>
 #include <analyses/local_safe_pointers.h>
 #include <analyses/natural_loops.h>
 #include <analyses/reaching_definitions.h>
@@ -87,6 +88,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "dump_c.h"
 #include "full_slicer.h"
 #include "function.h"
+#include "goto_pass_manager.h"
 #include "havoc_loops.h"
 #include "horn_encoding.h"
 #include "insert_final_assert_false.h"
@@ -105,10 +107,12 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "skip_loops.h"
 #include "splice_call.h"
 #include "stack_depth.h"
+#include "summarize_loops.h"
 #include "thread_instrumentation.h"
 #include "undefined_functions.h"
 #include "uninitialized.h"
 #include "unwind.h"
+#include "value_set_fi_fp_removal.h"
 #include "wmm/weak_memory.h"
 
 /// invoke main modules
@@ -544,6 +548,12 @@ int goto_instrument_parse_optionst::doit()
       return CPROVER_EXIT_SUCCESS;
     }
 
+    if(cmdline.isset("show-contract-jobs"))
+    {
+      show_contract_jobs(goto_model, std::cout);
+      return CPROVER_EXIT_SUCCESS;
+    }
+
     if(cmdline.isset("show-dependence-graph"))
     {
       do_indirect_call_and_rtti_removal();
@@ -843,6 +853,15 @@ int goto_instrument_parse_optionst::doit()
       remove_skip(goto_model);
     }
 
+    if(cmdline.isset("accelerate-fast"))
+    {
+      log.status() << "Accelerating simple loops" << messaget::eom;
+      guard_managert guard_manager;
+      accelerate_functions(
+        goto_model, ui_message_handler, false, guard_manager, true);
+      remove_skip(goto_model);
+    }
+
     if(cmdline.isset("horn-encoding"))
     {
       log.status() << "Horn-clause encoding" << messaget::eom;
@@ -919,6 +938,14 @@ void goto_instrument_parse_optionst::do_indirect_call_and_rtti_removal(
 
   function_pointer_removal_done=true;
 
+  if(cmdline.isset("value-set-fi-fp-removal"))
+  {
+    log.status() << "Function Pointer Removal using points-to analysis"
+                 << messaget::eom;
+    value_set_fi_fp_removal(
+      goto_model, ui_message_handler, cmdline.isset("pointer-check"));
+  }
+
   log.status() << "Function Pointer Removal" << messaget::eom;
   remove_function_pointers(
     ui_message_handler, goto_model, cmdline.isset("pointer-check"));
@@ -1136,8 +1163,22 @@ void goto_instrument_parse_optionst::instrument_goto_program()
     code_contracts(goto_model);
   }
 
+  if(cmdline.isset("enforce-contract"))
+  {
+    log.status() << "Enforcing contract of "
+                 << cmdline.get_value("enforce-contract") << messaget::eom;
+    enforce_contract(goto_model, cmdline.get_value("enforce-contract"));
+  }
+  else if(cmdline.isset("replace-calls-with-contracts"))
+  {
+    log.status() << "Replacing calls with contracts" << messaget::eom;
+    replace_calls_with_contracts(goto_model);
+  }
+
   // replace function pointers, if explicitly requested
-  if(cmdline.isset("remove-function-pointers"))
+  if(
+    cmdline.isset("remove-function-pointers") ||
+    cmdline.isset("value-set-fi-fp-removal"))
   {
     do_indirect_call_and_rtti_removal();
   }
@@ -1213,6 +1254,21 @@ void goto_instrument_parse_optionst::instrument_goto_program()
     goto_model.goto_functions.compute_loop_numbers();
   }
 
+  if(cmdline.isset("cost-inline"))
+  {
+    do_indirect_call_and_rtti_removal();
+
+    log.status() << "Cost-based partial inlining" << messaget::eom;
+    goto_cost_inline(
+      goto_model,
+      ui_message_handler,
+      safe_string2unsigned(cmdline.get_value("cost-inline")),
+      true);
+
+    goto_model.goto_functions.update();
+    goto_model.goto_functions.compute_loop_numbers();
+  }
+
   if(cmdline.isset("remove-calls-no-body"))
   {
     log.status() << "Removing calls to functions without a body"
@@ -1235,6 +1291,15 @@ void goto_instrument_parse_optionst::instrument_goto_program()
     remove_skip(goto_model);
   }
 
+  if(cmdline.isset("dead-code-elimination"))
+  {
+    do_indirect_call_and_rtti_removal();
+
+    log.status() << "Propagating constants and removing dead code"
+                 << messaget::eom;
+    propagate_constants_and_remove_dead_code(goto_model, ui_message_handler);
+  }
+
   if(cmdline.isset("generate-function-body"))
   {
     optionst c_object_factory_options;
@@ -1254,26 +1319,57 @@ void goto_instrument_parse_optionst::instrument_goto_program()
       ui_message_handler);
   }
 
-  // add generic checks, if needed
-  goto_check(options, goto_model);
-
-  // check for uninitalized local variables
+  goto_pass_managert pass_manager(
+    cmdline.isset("parallel-passes")
+      ? safe_string2size_t(cmdline.get_value("parallel-passes"))
+      : 1,
+    ui_message_handler);
+
+  // add generic checks, if needed, sharing the analysis of pointers with
+  // other passes through the pass manager
+  pass_manager.add_function_local_pass(
+    "generic checks",
+    goto_check_function(
+      ns,
+      options,
+      goto_model.goto_functions,
+      [&pass_manager, &ns](
+        const irep_idt &function_id,
+        const goto_functionst::goto_functiont &function)
+        -> const local_bitvector_analysist & {
+        return pass_manager.get_function_analysis<local_bitvector_analysist>(
+          function_id, function, ns);
+      }));
+
+  // check for uninitalized local variables, which adds symbols
   if(cmdline.isset("uninitialized-check"))
   {
-    log.status() << "Adding checks for uninitialized local variables"
-                 << messaget::eom;
-    add_uninitialized_locals_assertions(goto_model);
+    pass_manager.add_global_pass(
+      "checks for uninitialized local variables",
+      add_uninitialized_locals_assertions);
   }
 
-  // check for maximum call stack size
+  // check for maximum call stack size, which adds symbols
   if(cmdline.isset("stack-depth"))
   {
-    log.status() << "Adding check for maximum call stack size" << messaget::eom;
-    stack_depth(
-      goto_model,
-      safe_string2size_t(cmdline.get_value("stack-depth")));
+    const std::size_t depth =
+      safe_string2size_t(cmdline.get_value("stack-depth"));
+    pass_manager.add_global_pass(
+      "check for maximum call stack size",
+      [depth](goto_modelt &goto_model) { stack_depth(goto_model, depth); });
+  }
+
+  // after all checks have been added
+  if(cmdline.isset("remove-redundant-assertions"))
+  {
+    pass_manager.add_global_pass(
+      "removal of redundant checks", [this](goto_modelt &goto_model) {
+        remove_redundant_assertions(goto_model, ui_message_handler);
+      });
   }
 
+  pass_manager.run(goto_model);
+
   // ignore default/user-specified initialization of variables with static
   // lifetime
   if(cmdline.isset("nondet-static-exclude"))
@@ -1363,6 +1459,9 @@ void goto_instrument_parse_optionst::instrument_goto_program()
       const unsigned max_po_trans=
         cmdline.isset("max-po-trans")?
         unsafe_string2unsigned(cmdline.get_value("max-po-trans")):0;
+      const unsigned cycles_time_limit=
+        cmdline.isset("cycles-time-limit")?
+        unsafe_string2unsigned(cmdline.get_value("cycles-time-limit")):0;
 
       if(mm=="tso")
       {
@@ -1420,7 +1519,8 @@ void goto_instrument_parse_optionst::instrument_goto_program()
           cmdline.isset("cav11"),
           cmdline.isset("hide-internals"),
           ui_message_handler,
-          cmdline.isset("ignore-arrays"));
+          cmdline.isset("ignore-arrays"),
+          cycles_time_limit);
     }
 
     // Interrupt handler
@@ -1453,10 +1553,32 @@ void goto_instrument_parse_optionst::instrument_goto_program()
     interval_analysis(goto_model);
   }
 
+  // loop instrumentation shares the aliasing information of the functions
+  const auto get_local_may_alias =
+    [&pass_manager](
+      const irep_idt &function_id,
+      const goto_functionst::goto_functiont &goto_function)
+    -> const local_may_aliast & {
+    return pass_manager.get_function_analysis<local_may_aliast>(
+      function_id, goto_function);
+  };
+
   if(cmdline.isset("havoc-loops"))
   {
-    log.status() << "Havocking loops" << messaget::eom;
-    havoc_loops(goto_model);
+    // reads the bodies of called functions, hence global
+    pass_manager.add_global_pass(
+      "loop havocking", [&](goto_modelt &goto_model) {
+        havoc_loops(goto_model, get_local_may_alias);
+      });
+  }
+
+  if(cmdline.isset("summarize-loops"))
+  {
+    // runs an interprocedural analysis, hence global
+    pass_manager.add_global_pass(
+      "loop summarization", [this](goto_modelt &goto_model) {
+        summarize_loops(goto_model, ui_message_handler);
+      });
   }
 
   if(cmdline.isset("k-induction"))
@@ -1477,9 +1599,23 @@ void goto_instrument_parse_optionst::instrument_goto_program()
     log.status() << "Instrumenting k-induction for k=" << k << ", "
                  << (base_case ? "base case" : "step case") << messaget::eom;
 
-    k_induction(goto_model, base_case, step_case, k);
+    pass_manager.add_function_local_pass(
+      "k-induction",
+      [&get_local_may_alias, base_case, step_case, k](
+        const irep_idt &function_id,
+        goto_functionst::goto_functiont &goto_function) {
+        k_induction(
+          function_id,
+          goto_function,
+          get_local_may_alias(function_id, goto_function),
+          base_case,
+          step_case,
+          k);
+      });
   }
 
+  pass_manager.run(goto_model);
+
   if(cmdline.isset("function-enter"))
   {
     log.status() << "Function enter instrumentation" << messaget::eom;
@@ -1551,19 +1687,21 @@ void goto_instrument_parse_optionst::instrument_goto_program()
   }
 
   // full slice?
-  if(cmdline.isset("full-slice"))
+  if(cmdline.isset("full-slice") || cmdline.isset("sparse-full-slice"))
   {
     do_indirect_call_and_rtti_removal();
     do_remove_returns();
 
+    const bool sparse = cmdline.isset("sparse-full-slice");
+
     log.status() << "Performing a full slice" << messaget::eom;
     if(cmdline.isset("property"))
-      property_slicer(goto_model, cmdline.get_values("property"));
+      property_slicer(goto_model, cmdline.get_values("property"), sparse);
     else
     {
       // full_slicer requires that the model has unique location numbers:
       goto_model.goto_functions.update();
-      full_slicer(goto_model);
+      full_slicer(goto_model, sparse);
     }
   }
 
@@ -1695,6 +1833,9 @@ void goto_instrument_parse_optionst::help()
     " --error-label label          check that label is unreachable\n"
     " --stack-depth n              add check that call stack size of non-inlined functions never exceeds n\n" // NOLINT(*)
     " --race-check                 add floating-point data race checks\n"
+    " --parallel-passes n          add checks to the functions in n parallel\n"
+    "                              processes\n"
+    HELP_REMOVE_REDUNDANT_ASSERTIONS
     "\n"
     "Semantic transformations:\n"
     " --nondet-volatile            makes reads from volatile variables non-deterministic\n" // NOLINT(*)
@@ -1710,6 +1851,11 @@ void goto_instrument_parse_optionst::help()
     " --nondet-static-exclude e    same as nondet-static except for the variable e\n" //NOLINT(*)
     "                              (use multiple times if required)\n"
     " --check-invariant function   instruments invariant checking function\n"
+    " --enforce-contract function  check the contract of function, using the\n"
+    "                              contracts of all functions it calls\n"
+    " --replace-calls-with-contracts\n"
+    "                              replace calls to functions by their contracts\n" // NOLINT(*)
+    " --show-contract-jobs         list the jobs of a modular contract proof\n"
     " --remove-pointers            converts pointer arithmetic to base+offset expressions\n" // NOLINT(*)
     " --splice-call caller,callee  prepends a call to callee in the body of caller\n"  // NOLINT(*)
     " --undefined-function-is-assume-false\n"
@@ -1724,7 +1870,11 @@ void goto_instrument_parse_optionst::help()
     " --step-case                  k-induction: do step-case\n"
     " --base-case                  k-induction: do base-case\n"
     " --havoc-loops                over-approximate all loops\n"
+    " --summarize-loops            over-approximate loops by a single iteration\n" // NOLINT(*)
+    "                              from states satisfying inferred invariants\n"
     " --accelerate                 add loop accelerators\n"
+    " --accelerate-fast            add loop accelerators only for common loop\n"
+    "                              idioms, without SAT queries\n"
     " --skip-loops <loop-ids>      add gotos to skip selected loops during execution\n" // NOLINT(*)
     "\n"
     "Memory model instrumentations:\n"
@@ -1743,6 +1893,9 @@ void goto_instrument_parse_optionst::help()
     "Slicing:\n"
     HELP_REACHABILITY_SLICER
     " --full-slice                 slice away instructions that don't affect assertions\n" // NOLINT(*)
+    " --sparse-full-slice          like --full-slice, but compute dependencies\n"
+    "                              only for the instructions kept, which scales\n" // NOLINT(*)
+    "                              to larger programs\n"
     " --property id                slice with respect to specific property only\n" // NOLINT(*)
     " --slice-global-inits         slice away initializations of unused global variables\n" // NOLINT(*)
     " --aggressive-slice           remove bodies of any functions not on the shortest path between\n" // NOLINT(*)
@@ -1759,12 +1912,23 @@ void goto_instrument_parse_optionst::help()
     "\n"
     "Further transformations:\n"
     " --constant-propagator        propagate constants and simplify expressions\n" // NOLINT(*)
+    " --dead-code-elimination      propagate constants across functions and\n"
+    "                              remove code and functions that are then\n"
+    "                              found to be unreachable\n"
     " --inline                     perform full inlining\n"
     " --partial-inline             perform partial inlining\n"
+    " --cost-inline n              inline calls where the callee has at most n\n"
+    "                              instructions per unit of estimated benefit,\n" // NOLINT(*)
+    "                              which grows with loops around the call and\n" // NOLINT(*)
+    "                              constant arguments\n"
     " --function-inline <function> transitively inline all calls <function> makes\n" // NOLINT(*)
     " --no-caching                 disable caching of intermediate results during transitive function inlining\n" // NOLINT(*)
     " --log <file>                 log in json format which code segments were inlined, use with --function-inline\n" // NOLINT(*)
     " --remove-function-pointers   replace function pointers by case statement over function calls\n" // NOLINT(*)
+    " --value-set-fi-fp-removal    like --remove-function-pointers, but only\n"
+    "                              consider the functions a function pointer\n"
+    "                              may point to according to a points-to\n"
+    "                              analysis\n"
     HELP_REMOVE_CALLS_NO_BODY
     HELP_REMOVE_CONST_FUNCTION_POINTERS
     " --add-library                add models of C library functions\n"
@@ -32,6 +32,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "aggressive_slicer.h"
 #include "generate_function_bodies.h"
 #include "insert_final_assert_false.h"
+#include "remove_redundant_assertions.h"
 
 #include "count_eloc.h"
 
@@ -49,6 +50,7 @@ Author: Daniel Kroening, kroening@kroening.com
   "(no-nan-check)" \
   "(remove-pointers)" \
   "(no-simplify)" \
+  "(parallel-passes):" \
   "(assert-to-assume)" \
   "(no-assertions)(no-assumptions)(uninitialized-check)" \
   "(race-check)(scc)(one-event-per-cycle)" \
@@ -57,7 +59,7 @@ Author: Daniel Kroening, kroening@kroening.com
   "(unwind):(unwindset):(unwindset-file):" \
   "(unwinding-assertions)(partial-loops)(continue-as-loops)" \
   "(log):" \
-  "(max-var):(max-po-trans):(ignore-arrays)" \
+  "(max-var):(max-po-trans):(ignore-arrays)(cycles-time-limit):" \
   "(cfg-kill)(no-dependencies)(force-loop-duplication)" \
   "(call-graph)(reachable-call-graph)" \
   OPT_INSERT_FINAL_ASSERT_FALSE \
@@ -77,26 +79,27 @@ Author: Daniel Kroening, kroening@kroening.com
   "(custom-bitvector-analysis)" \
   "(show-struct-alignment)(interval-analysis)(show-intervals)" \
   "(show-uninitialized)(show-locations)" \
-  "(full-slice)(reachability-slice)(slice-global-inits)" \
+  "(full-slice)(sparse-full-slice)(reachability-slice)(slice-global-inits)" \
   "(fp-reachability-slice):" \
-  "(inline)(partial-inline)(function-inline):(log):(no-caching)" \
+  "(inline)(partial-inline)(cost-inline):(function-inline):(log):(no-caching)" \
   OPT_REMOVE_CONST_FUNCTION_POINTERS \
   "(print-internal-representation)" \
-  "(remove-function-pointers)" \
+  "(remove-function-pointers)(value-set-fi-fp-removal)" \
   "(show-claims)(property):" \
   "(show-symbol-table)(show-points-to)(show-rw-set)" \
   "(cav11)" \
   OPT_TIMESTAMP \
   "(show-natural-loops)(show-lexical-loops)(accelerate)(havoc-loops)" \
+  "(accelerate-fast)(summarize-loops)" \
   "(error-label):(string-abstraction)" \
   "(verbosity):(version)(xml-ui)(json-ui)(show-loops)" \
-  "(accelerate)(constant-propagator)" \
+  "(accelerate)(constant-propagator)(dead-code-elimination)" \
   "(k-induction):(step-case)(base-case)" \
   "(show-call-sequences)(check-call-sequence)" \
   "(interpreter)(show-reaching-definitions)" \
   "(list-symbols)(list-undefined-functions)" \
   "(z3)(add-library)(show-dependence-graph)" \
-  "(horn)(skip-loops):(apply-code-contracts)(model-argc-argv):" \
+  "(horn)(skip-loops):(apply-code-contracts)(enforce-contract):(replace-calls-with-contracts)(show-contract-jobs)(model-argc-argv):" \
   "(show-threaded)(list-calls-args)" \
   "(undefined-function-is-assume-false)" \
   "(remove-function-body):"\
@@ -108,6 +111,7 @@ Author: Daniel Kroening, kroening@kroening.com
   OPT_GOTO_PROGRAM_STATS \
   "(show-local-safe-pointers)(show-safe-dereferences)" \
   "(show-sese-regions)" \
+  OPT_REMOVE_REDUNDANT_ASSERTIONS \
   OPT_REPLACE_CALLS \
   "(validate-goto-binary)" \
   OPT_VALIDATE \
@@ -0,0 +1,233 @@
+/*******************************************************************\
+
+Module: Goto Program Transformation Passes
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Goto Program Transformation Passes
+
+#include "goto_pass_manager.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include <util/exception_utils.h>
+#include <util/forked_workers.h>
+#include <util/message.h>
+
+#include <goto-programs/goto_model.h>
+#include <goto-programs/read_bin_goto_object.h>
+#include <goto-programs/write_goto_binary.h>
+
+goto_pass_managert::goto_pass_managert(
+  std::size_t number_of_workers,
+  message_handlert &message_handler)
+  : number_of_workers(number_of_workers), message_handler(message_handler)
+{
+}
+
+void goto_pass_managert::add_global_pass(
+  const std::string &name,
+  global_passt pass)
+{
+  passes.push_back({name, std::move(pass), {}});
+}
+
+void goto_pass_managert::add_function_local_pass(
+  const std::string &name,
+  function_local_passt pass)
+{
+  passes.push_back({name, {}, std::move(pass)});
+}
+
+void goto_pass_managert::run(goto_modelt &goto_model)
+{
+  messaget log(message_handler);
+
+  auto it = passes.cbegin();
+  while(it != passes.cend())
+  {
+    if(it->global)
+    {
+      log.status() << "Running " << it->name << messaget::eom;
+      it->global(goto_model);
+      ++it;
+      continue;
+    }
+
+    auto end = it;
+    while(end != passes.cend() && end->function_local)
+    {
+      log.status() << "Running " << end->name << messaget::eom;
+      ++end;
+    }
+
+    run_function_local_passes(goto_model, it, end);
+    it = end;
+  }
+
+  passes.clear();
+}
+
+void goto_pass_managert::run_function_local_passes(
+  goto_modelt &goto_model,
+  std::vector<passt>::const_iterator begin,
+  std::vector<passt>::const_iterator end) const
+{
+  std::vector<irep_idt> function_ids;
+  for(const auto &function_pair : goto_model.goto_functions.function_map)
+  {
+    if(function_pair.second.body_available())
+      function_ids.push_back(function_pair.first);
+  }
+
+  const std::size_t workers = std::min(number_of_workers, function_ids.size());
+
+  // transforms every stride-th function, starting with the first one
+  const auto transform_share = [&](std::size_t first, std::size_t stride) {
+    for(std::size_t i = first; i < function_ids.size(); i += stride)
+    {
+      auto &function =
+        goto_model.goto_functions.function_map.at(function_ids[i]);
+      for(auto pass = begin; pass != end; ++pass)
+        pass->function_local(function_ids[i], function);
+    }
+  };
+
+  if(workers <= 1 || !forked_workers_supported())
+  {
+    transform_share(0, 1);
+    goto_model.goto_functions.update();
+    return;
+  }
+
+  const auto worker_results =
+    run_forked_workers(workers, [&](std::size_t worker) {
+      // workers run concurrently, keep their output to errors
+      message_handler.set_verbosity(messaget::M_ERROR);
+
+      transform_share(worker, workers);
+
+      std::ostringstream out;
+      for(std::size_t i = worker; i < function_ids.size(); i += workers)
+      {
+        auto &body =
+          goto_model.goto_functions.function_map.at(function_ids[i]).body;
+        // target numbers are written with the instructions
+        body.update();
+
+        std::ostringstream function_out;
+        write_goto_function_body(function_out, body);
+        out << function_out.str().size() << '\n' << function_out.str();
+      }
+      return out.str();
+    });
+
+  messaget log(message_handler);
+
+  for(std::size_t worker = 0; worker < workers; ++worker)
+  {
+    std::vector<goto_functionst::goto_functiont> bodies;
+    bool success = worker_results[worker].has_value();
+
+    if(success)
+    {
+      std::istringstream in(*worker_results[worker]);
+      try
+      {
+        for(std::size_t i = worker; i < function_ids.size(); i += workers)
+        {
+          std::size_t size;
+          if(!(in >> size) || in.get() != '\n')
+            throw deserialization_exceptiont("malformed function body size");
+
+          std::string body(size, '\0');
+          if(size != 0 && !in.read(&body[0], size))
+            throw deserialization_exceptiont("truncated function body");
+
+          std::istringstream body_in(body);
+          bodies.emplace_back();
+          read_goto_function_body(body_in, bodies.back());
+        }
+      }
+      catch(const deserialization_exceptiont &)
+      {
+        success = false;
+      }
+    }
+
+    if(!success)
+    {
+      log.warning() << "transformation worker " << worker
+                    << " failed to report results, transforming its functions"
+                    << " sequentially" << messaget::eom;
+      transform_share(worker, workers);
+      continue;
+    }
+
+    auto body_it = bodies.begin();
+    for(std::size_t i = worker; i < function_ids.size(); i += workers)
+    {
+      auto &function =
+        goto_model.goto_functions.function_map.at(function_ids[i]);
+      function.body.swap(body_it->body);
+      ++body_it;
+    }
+  }
+
+  goto_model.goto_functions.update();
+}
+
+goto_pass_managert::body_fingerprintt::body_fingerprintt(
+  const goto_programt &body)
+{
+  instructions.reserve(body.instructions.size());
+  for(const auto &instruction : body.instructions)
+  {
+    std::vector<const goto_programt::instructiont *> targets;
+    for(const auto &target : instruction.targets)
+      targets.push_back(&*target);
+
+    instructions.push_back(
+      {&instruction,
+       instruction.type,
+       instruction.code,
+       instruction.guard,
+       std::move(targets)});
+  }
+}
+
+bool goto_pass_managert::body_fingerprintt::matches(
+  const goto_programt &body) const
+{
+  if(body.instructions.size() != instructions.size())
+    return false;
+
+  auto it = instructions.begin();
+  for(const auto &instruction : body.instructions)
+  {
+    // ireps that are shared compare in constant time
+    if(
+      it->address != &instruction || it->type != instruction.type ||
+      it->code != instruction.code || it->guard != instruction.guard ||
+      it->targets.size() != instruction.targets.size())
+    {
+      return false;
+    }
+
+    auto target_it = it->targets.begin();
+    for(const auto &target : instruction.targets)
+    {
+      if(*target_it != &*target)
+        return false;
+      ++target_it;
+    }
+
+    ++it;
+  }
+
+  return true;
+}
@@ -0,0 +1,163 @@
+/*******************************************************************\
+
+Module: Goto Program Transformation Passes
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Goto Program Transformation Passes
+
+#ifndef CPROVER_GOTO_INSTRUMENT_GOTO_PASS_MANAGER_H
+#define CPROVER_GOTO_INSTRUMENT_GOTO_PASS_MANAGER_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+#include <goto-programs/goto_functions.h>
+
+class goto_modelt;
+class message_handlert;
+
+/// Runs a sequence of transformation passes over a goto model. Each pass is
+/// declared either as global or as function-local:
+/// - A global pass may inspect and change the whole goto model.
+/// - A function-local pass only changes the body of the function it is
+///   given. It may read, but must not change, the symbol table and the other
+///   functions.
+///
+/// Consecutive function-local passes are applied one function at a time. If
+/// more than one worker is requested, the functions are split into shares
+/// that are transformed in forked worker processes (see
+/// \ref run_forked_workers), which send back the bodies in the format of
+/// \ref write_goto_function_body. Shares of workers that fail are
+/// transformed in the parent process instead.
+///
+/// Passes can share the results of analyses of single functions through
+/// \ref get_function_analysis. These are computed once and reused until the
+/// body of the function changes.
+class goto_pass_managert
+{
+public:
+  typedef std::function<void(goto_modelt &)> global_passt;
+  typedef std::function<
+    void(const irep_idt &, goto_functionst::goto_functiont &)>
+    function_local_passt;
+
+  /// \param number_of_workers: number of processes to run function-local
+  ///   passes in, where 0 and 1 mean that they are run in this process
+  goto_pass_managert(
+    std::size_t number_of_workers,
+    message_handlert &message_handler);
+
+  void add_global_pass(const std::string &name, global_passt pass);
+
+  void
+  add_function_local_pass(const std::string &name, function_local_passt pass);
+
+  /// Run the passes added so far in the order they were added, and then
+  /// forget them
+  void run(goto_modelt &goto_model);
+
+  /// Return the result of `analysist(function, args...)`. It is computed when
+  /// first requested and then cached until the body of \p function changes,
+  /// which is checked on every request by comparing the instructions with
+  /// those the result was computed for. The cache is keyed by the type of the
+  /// analysis only, hence \p args must be the same on all requests.
+  template <class analysist, typename... argst>
+  const analysist &get_function_analysis(
+    const irep_idt &function_id,
+    const goto_functionst::goto_functiont &function,
+    argst &&... args);
+
+protected:
+  std::size_t number_of_workers;
+  message_handlert &message_handler;
+
+  struct passt
+  {
+    std::string name;
+    /// Set for global passes
+    global_passt global;
+    /// Set for function-local passes
+    function_local_passt function_local;
+  };
+
+  std::vector<passt> passes;
+
+  /// Records which instructions a function body consists of, and what they
+  /// are, such that an unchanged body can be recognized. Analyses may refer
+  /// to instructions by their iterators, so a body that is equal, but
+  /// consists of other instructions, counts as changed.
+  class body_fingerprintt
+  {
+  public:
+    explicit body_fingerprintt(const goto_programt &body);
+
+    bool matches(const goto_programt &body) const;
+
+  protected:
+    struct instructiont
+    {
+      const goto_programt::instructiont *address;
+      goto_program_instruction_typet type;
+      codet code;
+      exprt guard;
+      std::vector<const goto_programt::instructiont *> targets;
+    };
+
+    std::vector<instructiont> instructions;
+  };
+
+  struct function_analysest
+  {
+    body_fingerprintt fingerprint;
+    std::unordered_map<std::type_index, std::shared_ptr<void>> analyses;
+  };
+
+  std::unordered_map<irep_idt, function_analysest> function_analyses;
+
+  /// Run the function-local passes in [\p begin, \p end) on all functions
+  /// with a body
+  void run_function_local_passes(
+    goto_modelt &goto_model,
+    std::vector<passt>::const_iterator begin,
+    std::vector<passt>::const_iterator end) const;
+};
+
+template <class analysist, typename... argst>
+const analysist &goto_pass_managert::get_function_analysis(
+  const irep_idt &function_id,
+  const goto_functionst::goto_functiont &function,
+  argst &&... args)
+{
+  auto entry = function_analyses.find(function_id);
+  if(entry == function_analyses.end())
+  {
+    entry = function_analyses
+              .emplace(
+                function_id,
+                function_analysest{body_fingerprintt{function.body}, {}})
+              .first;
+  }
+  else if(!entry->second.fingerprint.matches(function.body))
+  {
+    entry->second = function_analysest{body_fingerprintt{function.body}, {}};
+  }
+
+  std::shared_ptr<void> &analysis =
+    entry->second.analyses[std::type_index(typeid(analysist))];
+  if(!analysis)
+    analysis =
+      std::make_shared<analysist>(function, std::forward<argst>(args)...);
+
+  return *static_cast<const analysist *>(analysis.get());
+}
+
+#endif // CPROVER_GOTO_INSTRUMENT_GOTO_PASS_MANAGER_H
@@ -28,9 +28,10 @@ public:
 
   havoc_loopst(
     function_modifiest &_function_modifies,
-    goto_functiont &_goto_function):
+    goto_functiont &_goto_function,
+    const local_may_aliast &_local_may_alias):
     goto_function(_goto_function),
-    local_may_alias(_goto_function),
+    local_may_alias(_local_may_alias),
     function_modifies(_function_modifies),
     natural_loops(_goto_function.body)
   {
@@ -39,7 +40,7 @@ public:
 
 protected:
   goto_functiont &goto_function;
-  local_may_aliast local_may_alias;
+  const local_may_aliast &local_may_alias;
   function_modifiest &function_modifies;
   natural_loops_mutablet natural_loops;
 
@@ -117,10 +118,30 @@ void havoc_loopst::havoc_loops()
     havoc_loop(loop.first, loop.second);
 }
 
+void havoc_loops(
+  goto_modelt &goto_model,
+  const std::function<const local_may_aliast &(
+    const irep_idt &,
+    const goto_functionst::goto_functiont &)> &get_local_may_alias)
+{
+  function_modifiest function_modifies(goto_model.goto_functions);
+
+  Forall_goto_functions(it, goto_model.goto_functions)
+  {
+    havoc_loopst(
+      function_modifies,
+      it->second,
+      get_local_may_alias(it->first, it->second));
+  }
+}
+
 void havoc_loops(goto_modelt &goto_model)
 {
   function_modifiest function_modifies(goto_model.goto_functions);
 
   Forall_goto_functions(it, goto_model.goto_functions)
-    havoc_loopst(function_modifies, it->second);
+  {
+    const local_may_aliast local_may_alias(it->second);
+    havoc_loopst(function_modifies, it->second, local_may_alias);
+  }
 }
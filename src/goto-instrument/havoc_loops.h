@@ -12,8 +12,21 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_GOTO_INSTRUMENT_HAVOC_LOOPS_H
 #define CPROVER_GOTO_INSTRUMENT_HAVOC_LOOPS_H
 
+#include <functional>
+
+#include <goto-programs/goto_functions.h>
+
 class goto_modelt;
+class local_may_aliast;
 
 void havoc_loops(goto_modelt &);
 
+/// Like \ref havoc_loops, but with the aliasing in each function given by
+/// \p get_local_may_alias rather than computed afresh
+void havoc_loops(
+  goto_modelt &,
+  const std::function<const local_may_aliast &(
+    const irep_idt &,
+    const goto_functionst::goto_functiont &)> &get_local_may_alias);
+
 #endif // CPROVER_GOTO_INSTRUMENT_HAVOC_LOOPS_H
@@ -27,12 +27,13 @@ public:
   k_inductiont(
     const irep_idt &_function_id,
     goto_functiont &_goto_function,
+    const local_may_aliast &_local_may_alias,
     bool _base_case,
     bool _step_case,
     unsigned _k)
     : function_id(_function_id),
       goto_function(_goto_function),
-      local_may_alias(_goto_function),
+      local_may_alias(_local_may_alias),
       natural_loops(_goto_function.body),
       base_case(_base_case),
       step_case(_step_case),
@@ -44,7 +45,7 @@ public:
 protected:
   const irep_idt &function_id;
   goto_functiont &goto_function;
-  local_may_aliast local_may_alias;
+  const local_may_aliast &local_may_alias;
   natural_loops_mutablet natural_loops;
 
   const bool base_case, step_case;
@@ -159,11 +160,72 @@ void k_inductiont::k_induction()
     process_loop(l_it->first, l_it->second);
 }
 
+void k_induction(
+  const irep_idt &function_id,
+  goto_functionst::goto_functiont &goto_function,
+  const local_may_aliast &local_may_alias,
+  bool base_case,
+  bool step_case,
+  unsigned k)
+{
+  k_inductiont(
+    function_id, goto_function, local_may_alias, base_case, step_case, k);
+}
+
 void k_induction(
   goto_modelt &goto_model,
   bool base_case, bool step_case,
   unsigned k)
 {
   Forall_goto_functions(it, goto_model.goto_functions)
-    k_inductiont(it->first, it->second, base_case, step_case, k);
+  {
+    const local_may_aliast local_may_alias(it->second);
+    k_induction(
+      it->first, it->second, local_may_alias, base_case, step_case, k);
+  }
+}
+
+void assert_loop_invariants(goto_modelt &goto_model)
+{
+  Forall_goto_functions(it, goto_model.goto_functions)
+  {
+    goto_programt &body = it->second.body;
+    natural_loops_mutablet natural_loops(body);
+    std::size_t count = 0;
+
+    for(const auto &loop_pair : natural_loops.loop_map)
+    {
+      const goto_programt::targett loop_head = loop_pair.first;
+
+      // the invariant is attached to the last back edge
+      goto_programt::targett loop_end = loop_head;
+      for(const auto &t : loop_pair.second)
+      {
+        if(
+          t->is_goto() && t->get_target() == loop_head &&
+          t->location_number > loop_end->location_number)
+        {
+          loop_end = t;
+        }
+      }
+
+      const exprt &invariant = static_cast<const exprt &>(
+        loop_end->get_condition().find(ID_C_spec_loop_invariant));
+      if(invariant.is_nil())
+        continue;
+
+      source_locationt source_location = loop_head->source_location;
+      source_location.set_property_class("loop_invariant");
+      source_location.set_property_id(
+        id2string(it->first) + ".loop_invariant." + std::to_string(++count));
+      source_location.set_comment("loop invariant");
+
+      // Keep the loop head, whose guard k-induction assumes at the loop
+      // exit, and check the invariant right after it.
+      body.insert_after(
+        loop_head, goto_programt::make_assertion(invariant, source_location));
+    }
+  }
+
+  goto_model.goto_functions.update();
 }
@@ -12,11 +12,30 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_GOTO_INSTRUMENT_K_INDUCTION_H
 #define CPROVER_GOTO_INSTRUMENT_K_INDUCTION_H
 
+#include <goto-programs/goto_functions.h>
+
 class goto_modelt;
+class local_may_aliast;
 
 void k_induction(
   goto_modelt &,
   bool base_case, bool step_case,
   unsigned k);
 
+/// Instrument the loops of a single function, whose aliasing is given by
+/// \p local_may_alias
+void k_induction(
+  const irep_idt &function_id,
+  goto_functionst::goto_functiont &goto_function,
+  const local_may_aliast &local_may_alias,
+  bool base_case,
+  bool step_case,
+  unsigned k);
+
+/// Add an assertion of each loop invariant given with
+/// `__CPROVER_loop_invariant` right after the head of its loop. In the step
+/// case of k-induction the assertions of the first k iterations become
+/// assumptions, which strengthens the induction hypothesis.
+void assert_loop_invariants(goto_modelt &);
+
 #endif // CPROVER_GOTO_INSTRUMENT_K_INDUCTION_H
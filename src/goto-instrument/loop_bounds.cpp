@@ -0,0 +1,238 @@
+/*******************************************************************\
+
+Module: Static Loop Bounds
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Static Loop Bounds
+
+#include "loop_bounds.h"
+
+#include <limits>
+
+#include <util/arith_tools.h>
+#include <util/expr_util.h>
+#include <util/simplify_expr.h>
+#include <util/std_expr.h>
+
+#include <goto-programs/goto_model.h>
+
+#include <analyses/constant_propagator.h>
+#include <analyses/natural_loops.h>
+
+/// \return The value of \p expr in the state \p domain of the constant
+///   propagation, if it is a constant
+static optionalt<mp_integer> constant_value(
+  exprt expr,
+  const constant_propagator_domaint &domain,
+  const namespacet &ns)
+{
+  if(domain.is_bottom())
+    return {};
+
+  domain.values.replace_const.replace(expr);
+  return numeric_cast<mp_integer>(simplify_expr(expr, ns));
+}
+
+/// \return True if \p instruction may modify \p counter, which is a local
+///   variable whose address is not taken
+static bool
+modifies(const goto_programt::instructiont &instruction, const exprt &counter)
+{
+  if(instruction.is_assign())
+    return instruction.get_assign().lhs() == counter;
+  if(instruction.is_function_call())
+    return instruction.get_function_call().lhs() == counter;
+  if(instruction.is_decl())
+    return instruction.get_decl().symbol() == counter;
+  if(instruction.is_dead())
+    return instruction.get_dead().symbol() == counter;
+  return false;
+}
+
+/// Determine the number of iterations of the loop with head \p head
+/// \return The unwinding bound of the loop, which is the number of
+///   iterations plus one, if it is known statically
+static optionalt<mp_integer> loop_bound(
+  const goto_programt::const_targett head,
+  const natural_loopst::natural_loopt &loop,
+  goto_programt::const_targett &back_edge,
+  const constant_propagator_ait &constant_propagator,
+  const dirtyt &dirty,
+  const namespacet &ns)
+{
+  // the loop is left at the head, and entered again by a single unconditional
+  // backwards goto
+  if(
+    !head->is_goto() || head->get_condition().is_true() ||
+    loop.contains(head->get_target()))
+  {
+    return {};
+  }
+
+  bool found_back_edge = false;
+  for(const auto &t : loop)
+  {
+    if(t->is_goto() && t->get_target() == head)
+    {
+      if(found_back_edge || !t->get_condition().is_true())
+        return {};
+      found_back_edge = true;
+      back_edge = t;
+    }
+  }
+
+  if(!found_back_edge || back_edge->incoming_edges.size() != 1)
+    return {};
+
+  // condition to stay in the loop, with the counter on the left-hand side
+  exprt condition = boolean_negate(head->get_condition());
+  if(condition.id() == ID_gt || condition.id() == ID_ge)
+  {
+    auto &relation = to_binary_relation_expr(condition);
+    relation.id(relation.id() == ID_gt ? ID_lt : ID_le);
+    std::swap(relation.lhs(), relation.rhs());
+  }
+
+  if(
+    condition.id() != ID_lt && condition.id() != ID_le &&
+    condition.id() != ID_notequal)
+  {
+    return {};
+  }
+
+  const auto &relation = to_binary_relation_expr(condition);
+  if(
+    relation.lhs().id() != ID_symbol ||
+    !can_cast_type<integer_bitvector_typet>(relation.lhs().type()))
+  {
+    return {};
+  }
+
+  const symbol_exprt &counter = to_symbol_expr(relation.lhs());
+  if(
+    ns.lookup(counter.get_identifier()).is_static_lifetime ||
+    dirty(counter.get_identifier()))
+  {
+    return {};
+  }
+
+  // the counter is incremented right before the backwards goto, and not
+  // modified anywhere else in the loop
+  const auto increment = std::prev(back_edge);
+  if(!increment->is_assign() || increment->get_assign().lhs() != counter)
+    return {};
+
+  const exprt &rhs = increment->get_assign().rhs();
+  if(rhs.id() != ID_plus || rhs.operands().size() != 2)
+    return {};
+
+  const auto &plus = to_plus_expr(rhs);
+  if(plus.op0() != counter && plus.op1() != counter)
+    return {};
+  const exprt &step_expr = plus.op0() == counter ? plus.op1() : plus.op0();
+
+  for(const auto &t : loop)
+  {
+    if(t != increment && modifies(*t, counter))
+      return {};
+  }
+
+  // the loop is entered from a single instruction outside of it
+  optionalt<goto_programt::const_targett> entry;
+  for(const auto &predecessor : head->incoming_edges)
+  {
+    if(!loop.contains(predecessor))
+    {
+      if(entry.has_value())
+        return {};
+      entry = goto_programt::const_targett(predecessor);
+    }
+  }
+
+  if(!entry.has_value())
+    return {};
+
+  const auto &entry_state = constant_propagator[*entry];
+  optionalt<mp_integer> start;
+  if((*entry)->is_assign() && (*entry)->get_assign().lhs() == counter)
+    start = constant_value((*entry)->get_assign().rhs(), entry_state, ns);
+  else if(!modifies(**entry, counter))
+    start = constant_value(counter, entry_state, ns);
+
+  // the bound is read where the counter is compared, and the step where it
+  // is added to the counter
+  const auto end =
+    constant_value(relation.rhs(), constant_propagator[head], ns);
+  const auto step =
+    constant_value(step_expr, constant_propagator[increment], ns);
+
+  if(!start.has_value() || !end.has_value() || !step.has_value() || *step <= 0)
+    return {};
+
+  mp_integer iterations = 0;
+  if(condition.id() == ID_lt)
+  {
+    if(*start < *end)
+      iterations = (*end - *start + *step - 1) / *step;
+  }
+  else if(condition.id() == ID_le)
+  {
+    if(*start <= *end)
+      iterations = (*end - *start) / *step + 1;
+  }
+  else
+  {
+    if(*step != 1 || *start > *end)
+      return {};
+    iterations = *end - *start;
+  }
+
+  // the counter must not wrap around before the loop is left
+  const mp_integer largest =
+    to_integer_bitvector_type(counter.type()).largest();
+  if(*start + iterations * *step > largest)
+    return {};
+
+  return iterations + 1;
+}
+
+std::map<irep_idt, unsigned> infer_loop_bounds(const goto_modelt &goto_model)
+{
+  const namespacet ns(goto_model.symbol_table);
+
+  constant_propagator_ait constant_propagator(goto_model.goto_functions);
+  constant_propagator(goto_model.goto_functions, ns);
+
+  std::map<irep_idt, unsigned> bounds;
+
+  for(const auto &function : goto_model.goto_functions.function_map)
+  {
+    const goto_programt &body = function.second.body;
+    if(body.empty())
+      continue;
+
+    natural_loopst natural_loops;
+    natural_loops(body);
+    const dirtyt dirty(function.second);
+
+    for(const auto &loop : natural_loops.loop_map)
+    {
+      goto_programt::const_targett back_edge;
+      const auto bound = loop_bound(
+        loop.first, loop.second, back_edge, constant_propagator, dirty, ns);
+
+      if(bound.has_value() && *bound <= std::numeric_limits<unsigned>::max())
+      {
+        bounds.emplace(
+          goto_programt::loop_id(function.first, *back_edge),
+          numeric_cast_v<unsigned>(*bound));
+      }
+    }
+  }
+
+  return bounds;
+}
@@ -0,0 +1,31 @@
+/*******************************************************************\
+
+Module: Static Loop Bounds
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Static Loop Bounds
+
+#ifndef CPROVER_GOTO_INSTRUMENT_LOOP_BOUNDS_H
+#define CPROVER_GOTO_INSTRUMENT_LOOP_BOUNDS_H
+
+#include <map>
+
+#include <util/irep.h>
+
+class goto_modelt;
+
+/// Find the loops that execute a number of iterations that is known
+/// statically. These are loops that compare a local counter against a
+/// constant each time they enter the loop head, change the counter by adding
+/// a constant at the end of each iteration, and do not modify it otherwise.
+/// The initial value of the counter and the bound it is compared against are
+/// determined by constant propagation.
+/// \return Map from the identifiers of these loops to the smallest unwinding
+///   bound for which their unwinding assertions hold
+std::map<irep_idt, unsigned> infer_loop_bounds(const goto_modelt &goto_model);
+
+#endif // CPROVER_GOTO_INSTRUMENT_LOOP_BOUNDS_H
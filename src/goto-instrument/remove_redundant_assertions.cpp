@@ -0,0 +1,379 @@
+/*******************************************************************\
+
+Module: Remove Redundant Assertions
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Remove automatically generated checks that are implied by other
+/// assertions or by the intervals of the variables
+
+#include "remove_redundant_assertions.h"
+
+#include <set>
+#include <stack>
+#include <unordered_set>
+
+#include <util/expr_util.h>
+#include <util/find_symbols.h>
+#include <util/message.h>
+#include <util/optional.h>
+
+#include <goto-programs/goto_model.h>
+#include <goto-programs/remove_skip.h>
+
+#include <analyses/ai.h>
+#include <analyses/dirty.h>
+#include <analyses/interval_domain.h>
+#include <analyses/local_cfg.h>
+#include <analyses/locals.h>
+
+/// Computes, for each location of a function, the conditions of assertions
+/// that hold on all paths to it: an assertion was passed on every path, and
+/// none of the variables that its condition reads were changed since. This
+/// is a must-analysis over the local control-flow graph, with invalidation
+/// as done by goto_checkt within basic blocks.
+class available_assertionst
+{
+public:
+  typedef goto_functionst::goto_functiont goto_functiont;
+
+  /// \param goto_function: the function to analyze
+  /// \param concurrent: whether other threads may change variables that are
+  ///   shared, in which case only conditions on the function's own variables
+  ///   are kept
+  available_assertionst(const goto_functiont &goto_function, bool concurrent)
+    : locals(goto_function),
+      dirty(goto_function),
+      cfg(goto_function.body),
+      concurrent(concurrent)
+  {
+    build();
+  }
+
+  /// Return true if the condition of the assertion at \p target holds on all
+  /// paths to it
+  bool is_available(goto_programt::const_targett target) const
+  {
+    const auto &state = states[cfg.loc_map.at(target)];
+    return state.has_value() && state->count(target->get_condition()) != 0;
+  }
+
+protected:
+  typedef std::set<exprt> assertionst;
+
+  localst locals;
+  dirtyt dirty;
+  local_cfgt cfg;
+  bool concurrent;
+
+  /// The conditions that hold before each node, where locations that have
+  /// not been reached have no state
+  std::vector<optionalt<assertionst>> states;
+
+  void build();
+  void transform(const goto_programt::instructiont &, assertionst &) const;
+
+  /// Return true if \p condition only reads variables of this function whose
+  /// address is not taken, which calls and other threads cannot change
+  bool is_local(const exprt &condition) const;
+  void keep_local(assertionst &) const;
+  void invalidate(const exprt &lhs, assertionst &) const;
+};
+
+bool available_assertionst::is_local(const exprt &condition) const
+{
+  if(has_subexpr(condition, ID_dereference))
+    return false;
+
+  for(const auto &identifier : find_symbol_identifiers(condition))
+  {
+    if(!locals.is_local(identifier) || dirty(identifier))
+      return false;
+  }
+
+  return true;
+}
+
+void available_assertionst::keep_local(assertionst &assertions) const
+{
+  for(auto it = assertions.begin(); it != assertions.end();)
+  {
+    if(is_local(*it))
+      ++it;
+    else
+      it = assertions.erase(it);
+  }
+}
+
+void available_assertionst::invalidate(
+  const exprt &lhs,
+  assertionst &assertions) const
+{
+  if(lhs.id() == ID_index)
+    invalidate(to_index_expr(lhs).array(), assertions);
+  else if(lhs.id() == ID_member)
+    invalidate(to_member_expr(lhs).struct_op(), assertions);
+  else if(lhs.id() == ID_symbol)
+  {
+    // clear all assertions about 'symbol', and those that read memory
+    // through pointers, which may point to it
+    const find_symbols_sett find_symbols_set{
+      to_symbol_expr(lhs).get_identifier()};
+
+    for(auto it = assertions.begin(); it != assertions.end();)
+    {
+      if(has_symbol(*it, find_symbols_set) || has_subexpr(*it, ID_dereference))
+        it = assertions.erase(it);
+      else
+        ++it;
+    }
+  }
+  else
+  {
+    // give up, clear all
+    assertions.clear();
+  }
+}
+
+void available_assertionst::transform(
+  const goto_programt::instructiont &instruction,
+  assertionst &assertions) const
+{
+  switch(instruction.type)
+  {
+  case ASSERT:
+    if(!concurrent || is_local(instruction.get_condition()))
+      assertions.insert(instruction.get_condition());
+    break;
+
+  case ASSIGN:
+    invalidate(instruction.get_assign().lhs(), assertions);
+    break;
+
+  case DECL:
+    invalidate(instruction.get_decl().symbol(), assertions);
+    break;
+
+  case DEAD:
+    invalidate(instruction.get_dead().symbol(), assertions);
+    break;
+
+  case FUNCTION_CALL:
+  {
+    // the callee can only change variables of this function through their
+    // address
+    keep_local(assertions);
+    const exprt &lhs = instruction.get_function_call().lhs();
+    if(lhs.is_not_nil())
+      invalidate(lhs, assertions);
+    break;
+  }
+
+  case OTHER:
+  case THROW:
+  case CATCH:
+    assertions.clear();
+    break;
+
+  case GOTO:
+  case ASSUME:
+  case RETURN:
+  case SKIP:
+  case LOCATION:
+  case END_FUNCTION:
+  case ATOMIC_BEGIN:
+  case ATOMIC_END:
+  case START_THREAD:
+  case END_THREAD:
+  case INCOMPLETE_GOTO:
+  case NO_INSTRUCTION_TYPE:
+    break;
+  }
+}
+
+void available_assertionst::build()
+{
+  if(cfg.nodes.empty())
+    return;
+
+  states.resize(cfg.nodes.size());
+  states[0] = assertionst();
+
+  std::stack<local_cfgt::node_nrt> work_queue;
+  work_queue.push(0);
+
+  while(!work_queue.empty())
+  {
+    const local_cfgt::node_nrt node_nr = work_queue.top();
+    work_queue.pop();
+
+    const local_cfgt::nodet &node = cfg.nodes[node_nr];
+    assertionst assertions = *states[node_nr];
+    transform(*node.t, assertions);
+
+    for(const auto successor : node.successors)
+    {
+      optionalt<assertionst> &state = states[successor];
+
+      if(!state.has_value())
+      {
+        state = assertions;
+        work_queue.push(successor);
+        continue;
+      }
+
+      // keep the conditions that hold on all incoming paths
+      bool changed = false;
+      for(auto it = state->begin(); it != state->end();)
+      {
+        if(assertions.count(*it) == 0)
+        {
+          it = state->erase(it);
+          changed = true;
+        }
+        else
+          ++it;
+      }
+
+      if(changed)
+        work_queue.push(successor);
+    }
+  }
+}
+
+/// Assertions written in the program are kept even if they are redundant
+static bool is_check(const goto_programt::instructiont &instruction)
+{
+  return instruction.is_assert() &&
+         instruction.source_location.get_property_class() != "assertion";
+}
+
+/// The interval domain does not track writes through pointers nor by other
+/// threads, so its results are only trusted for conditions that read local
+/// variables whose address is not taken, and no other memory
+static bool has_trusted_intervals(
+  const exprt &condition,
+  const dirtyt &dirty,
+  const namespacet &ns)
+{
+  if(has_subexpr(condition, ID_dereference))
+    return false;
+
+  find_symbols_sett symbols;
+  find_symbols(condition, symbols, true, false);
+
+  for(const auto &identifier : symbols)
+  {
+    const symbolt *symbol;
+    if(ns.lookup(identifier, symbol) || symbol->is_static_lifetime)
+      return false;
+
+    if(dirty(identifier))
+      return false;
+  }
+
+  return true;
+}
+
+void remove_redundant_assertions(
+  goto_modelt &goto_model,
+  message_handlert &message_handler)
+{
+  messaget log(message_handler);
+  const namespacet ns(goto_model.symbol_table);
+
+  bool concurrent = false;
+  std::size_t checks = 0;
+  for(const auto &function : goto_model.goto_functions.function_map)
+  {
+    for(const auto &instruction : function.second.body.instructions)
+    {
+      if(instruction.is_start_thread())
+        concurrent = true;
+      else if(is_check(instruction))
+        ++checks;
+    }
+  }
+
+  if(checks == 0)
+    return;
+
+  // decide on all checks before changing any function, as the intervals are
+  // computed for the whole program
+  std::unordered_set<const goto_programt::instructiont *> redundant;
+
+  for(const auto &function : goto_model.goto_functions.function_map)
+  {
+    if(!function.second.body_available())
+      continue;
+
+    const available_assertionst available_assertions(
+      function.second, concurrent);
+
+    forall_goto_program_instructions(it, function.second.body)
+    {
+      if(is_check(*it) && available_assertions.is_available(it))
+        redundant.insert(&*it);
+    }
+  }
+
+  const std::size_t implied = redundant.size();
+
+  // the intervals are computed from the entry point, without which all
+  // locations would seem unreachable; they do not account for other threads
+  if(
+    !concurrent && goto_model.goto_functions.function_map.count(
+                     goto_functionst::entry_point()) != 0)
+  {
+    ait<interval_domaint> interval_analysis;
+    interval_analysis(goto_model.goto_functions, ns);
+    const dirtyt dirty(goto_model.goto_functions);
+
+    forall_goto_functions(f_it, goto_model.goto_functions)
+    {
+      forall_goto_program_instructions(it, f_it->second.body)
+      {
+        if(
+          !is_check(*it) || redundant.count(&*it) != 0 ||
+          !has_trusted_intervals(it->get_condition(), dirty, ns))
+        {
+          continue;
+        }
+
+        // unreachable checks have bottom states, in which they hold
+        exprt condition = it->get_condition();
+        interval_analysis.abstract_state_before(it)->ai_simplify(
+          condition, ns);
+        if(condition.is_true())
+          redundant.insert(&*it);
+      }
+    }
+  }
+
+  Forall_goto_functions(f_it, goto_model.goto_functions)
+  {
+    bool changed = false;
+
+    for(auto &instruction : f_it->second.body.instructions)
+    {
+      if(redundant.count(&instruction) != 0)
+      {
+        instruction.turn_into_skip();
+        changed = true;
+      }
+    }
+
+    if(changed)
+      remove_skip(f_it->second.body);
+  }
+
+  goto_model.goto_functions.update();
+
+  log.status() << "Removed " << redundant.size() << " of " << checks
+               << " checks, " << implied << " implied by other assertions and "
+               << redundant.size() - implied << " by intervals"
+               << messaget::eom;
+}
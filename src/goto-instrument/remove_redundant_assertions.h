@@ -0,0 +1,44 @@
+/*******************************************************************\
+
+Module: Remove Redundant Assertions
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Remove automatically generated checks that are implied by other
+/// assertions or by the intervals of the variables
+
+#ifndef CPROVER_GOTO_INSTRUMENT_REMOVE_REDUNDANT_ASSERTIONS_H
+#define CPROVER_GOTO_INSTRUMENT_REMOVE_REDUNDANT_ASSERTIONS_H
+
+class goto_modelt;
+class message_handlert;
+
+/// Remove the checks that cannot fail unless another check fails, which
+/// are those whose condition
+/// - is also the condition of an assertion that is passed on all paths to
+///   them, with none of the variables that the condition reads changed in
+///   between, or
+/// - holds by the intervals that \ref interval_domaint computes.
+///
+/// Assertions that are written in the program (of property class
+/// "assertion") are kept, but may make checks redundant. The result of the
+/// verification is the same, but a failure is only reported for the first
+/// of several checks with the same condition.
+void remove_redundant_assertions(
+  goto_modelt &goto_model,
+  message_handlert &message_handler);
+
+// clang-format off
+#define OPT_REMOVE_REDUNDANT_ASSERTIONS \
+  "(remove-redundant-assertions)"
+
+#define HELP_REMOVE_REDUNDANT_ASSERTIONS \
+  " --remove-redundant-assertions\n" \
+  "                              remove checks implied by other assertions\n" \
+  "                              or by the intervals of variables\n"
+// clang-format on
+
+#endif // CPROVER_GOTO_INSTRUMENT_REMOVE_REDUNDANT_ASSERTIONS_H
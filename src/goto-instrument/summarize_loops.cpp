@@ -0,0 +1,218 @@
+/*******************************************************************\
+
+Module: Loop Summarization
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Loop Summarization
+
+#include "summarize_loops.h"
+
+#include <util/expr_util.h>
+#include <util/message.h>
+#include <util/std_expr.h>
+
+#include <analyses/dirty.h>
+#include <analyses/interval_domain.h>
+
+#include <goto-programs/goto_model.h>
+#include <goto-programs/remove_skip.h>
+
+#include "loop_utils.h"
+
+/// Number of joins into a loop head before its interval is widened
+static const std::size_t widening_delay = 2;
+
+struct loop_summaryt
+{
+  goto_programt::targett head;
+  std::vector<goto_programt::targett> back_edges;
+  modifiest modifies;
+  exprt invariant;
+};
+
+/// Collect the variables that \p loop modifies, where parts of variables
+/// count as the whole variable, and variables declared in the loop are left
+/// out, as they are not live at its head
+/// \return False if \p loop may modify state other than variables
+static bool get_modified_variables(const loopt &loop, modifiest &modifies)
+{
+  std::set<irep_idt> declared;
+
+  for(const auto &t : loop)
+  {
+    switch(t->type)
+    {
+    case ASSIGN:
+    {
+      const exprt *root = &t->get_assign().lhs();
+      while(root->id() == ID_index || root->id() == ID_member)
+        root = &to_binary_expr(*root).op0();
+
+      if(root->id() != ID_symbol)
+        return false;
+
+      modifies.insert(*root);
+      break;
+    }
+
+    case DECL:
+      declared.insert(t->get_decl().get_identifier());
+      break;
+
+    case GOTO:
+    case ASSUME:
+    case ASSERT:
+    case SKIP:
+    case LOCATION:
+    case DEAD:
+      break;
+
+    case NO_INSTRUCTION_TYPE:
+    case OTHER:
+    case START_THREAD:
+    case END_THREAD:
+    case END_FUNCTION:
+    case ATOMIC_BEGIN:
+    case ATOMIC_END:
+    case RETURN:
+    case FUNCTION_CALL:
+    case THROW:
+    case CATCH:
+    case INCOMPLETE_GOTO:
+      return false;
+    }
+  }
+
+  for(auto it = modifies.begin(); it != modifies.end();)
+  {
+    if(declared.count(to_symbol_expr(*it).get_identifier()) != 0)
+      it = modifies.erase(it);
+    else
+      ++it;
+  }
+
+  return true;
+}
+
+/// Interval analysis does not track assignments through pointers, so its
+/// results are only used for local variables whose address is not taken.
+static exprt get_invariant(
+  const interval_domaint &state,
+  const modifiest &modifies,
+  const dirtyt &dirty,
+  const namespacet &ns)
+{
+  exprt::operandst conjuncts;
+
+  for(const auto &modified : modifies)
+  {
+    const symbol_exprt &variable = to_symbol_expr(modified);
+
+    if(dirty(variable) || ns.lookup(variable).is_static_lifetime)
+      continue;
+
+    const exprt constraint = state.make_expression(variable);
+    if(!constraint.is_true())
+      conjuncts.push_back(constraint);
+  }
+
+  return conjunction(conjuncts);
+}
+
+void summarize_loops(goto_modelt &goto_model, message_handlert &message_handler)
+{
+  messaget log(message_handler);
+  const namespacet ns(goto_model.symbol_table);
+
+  interval_ait intervals(widening_delay, true);
+  intervals(goto_model);
+
+  const dirtyt dirty(goto_model.goto_functions);
+
+  std::size_t summarized = 0;
+  std::size_t unchanged = 0;
+
+  Forall_goto_functions(f_it, goto_model.goto_functions)
+  {
+    goto_programt &body = f_it->second.body;
+    natural_loops_mutablet natural_loops(body);
+
+    // All summaries are computed before any loop is changed, as changing
+    // one may move the instructions of loops that enclose it.
+    std::vector<loop_summaryt> summaries;
+
+    for(const auto &loop : natural_loops.loop_map)
+    {
+      loop_summaryt summary;
+      summary.head = loop.first;
+
+      bool supported = get_modified_variables(loop.second, summary.modifies);
+
+      for(const auto &t : loop.second)
+      {
+        if(!t->is_goto())
+          continue;
+
+        for(const auto &target : t->targets)
+        {
+          if(target != summary.head)
+            continue;
+
+          if(t->targets.size() != 1)
+            supported = false;
+
+          summary.back_edges.push_back(t);
+        }
+      }
+
+      if(!supported)
+      {
+        ++unchanged;
+        continue;
+      }
+
+      summary.invariant = get_invariant(
+        intervals[summary.head], summary.modifies, dirty, ns);
+      summaries.push_back(std::move(summary));
+    }
+
+    // A back edge `IF c GOTO head` becomes `ASSUME !c`, as all iterations
+    // that would follow are covered by the havoc at the head.
+    for(const auto &summary : summaries)
+    {
+      for(const auto &back_edge : summary.back_edges)
+      {
+        const exprt condition = back_edge->get_condition();
+        back_edge->type = ASSUME;
+        back_edge->targets.clear();
+        back_edge->set_condition(boolean_negate(condition));
+      }
+    }
+
+    for(const auto &summary : summaries)
+    {
+      goto_programt summary_code;
+      build_havoc_code(summary.head, summary.modifies, summary_code);
+      if(!summary.invariant.is_true())
+      {
+        summary_code.add(goto_programt::make_assumption(
+          summary.invariant, summary.head->source_location));
+      }
+
+      // Use insert_swap to preserve jumps to the loop head.
+      body.insert_before_swap(summary.head, summary_code);
+      ++summarized;
+    }
+
+    remove_skip(body);
+  }
+
+  goto_model.goto_functions.update();
+
+  log.status() << "Summarized " << summarized << " loop(s), left " << unchanged
+               << " unchanged" << messaget::eom;
+}
@@ -0,0 +1,30 @@
+/*******************************************************************\
+
+Module: Loop Summarization
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Loop Summarization
+
+#ifndef CPROVER_GOTO_INSTRUMENT_SUMMARIZE_LOOPS_H
+#define CPROVER_GOTO_INSTRUMENT_SUMMARIZE_LOOPS_H
+
+class goto_modelt;
+class message_handlert;
+
+/// Replace each loop by a summary of all its iterations, which costs the same
+/// as a single one. The variables that the loop may modify are havocked at
+/// the loop head, and then constrained by an invariant, namely the intervals
+/// that interval analysis infers for them there. The body is executed once,
+/// with the jumps back to the head turned into assumptions that they are not
+/// taken. The invariant holds whenever the head is reached, so every state
+/// at the head of the original loop is also one of the summary.
+///
+/// Loops that call functions or assign through pointers are left unchanged,
+/// as the variables they modify are not known syntactically.
+void summarize_loops(goto_modelt &, message_handlert &);
+
+#endif // CPROVER_GOTO_INSTRUMENT_SUMMARIZE_LOOPS_H
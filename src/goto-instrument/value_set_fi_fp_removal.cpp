@@ -0,0 +1,88 @@
+/*******************************************************************\
+
+Module: Value Set Function Pointer Removal
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Value Set Function Pointer Removal
+
+#include "value_set_fi_fp_removal.h"
+
+#include <util/message.h>
+#include <util/namespace.h>
+
+#include <goto-programs/goto_model.h>
+#include <goto-programs/remove_function_pointers.h>
+
+#include <pointer-analysis/value_set_analysis_fi.h>
+
+void value_set_fi_fp_removal(
+  goto_modelt &goto_model,
+  message_handlert &message_handler,
+  bool add_safety_assertion)
+{
+  messaget log(message_handler);
+
+  log.status() << "Doing FI value set analysis" << messaget::eom;
+
+  const namespacet ns(goto_model.symbol_table);
+  value_set_analysis_fit value_sets(
+    ns, value_set_analysis_fit::TRACK_FUNCTION_POINTERS);
+  value_sets(goto_model.goto_functions);
+
+  function_pointer_targetst targets;
+  std::size_t unresolved = 0;
+
+  for(const auto &function_pair : goto_model.goto_functions.function_map)
+  {
+    forall_goto_program_instructions(target, function_pair.second.body)
+    {
+      if(!target->is_function_call())
+        continue;
+
+      const exprt &function = target->get_function_call().function();
+      if(function.id() != ID_dereference)
+        continue;
+
+      std::unordered_set<symbol_exprt, irep_hash> functions;
+      bool resolved = true;
+
+      for(const auto &value : value_sets.get_values(
+            function_pair.first,
+            target,
+            to_dereference_expr(function).pointer()))
+      {
+        if(value.id() != ID_object_descriptor)
+        {
+          resolved = false;
+          break;
+        }
+
+        const exprt &object = to_object_descriptor_expr(value).object();
+        if(object.id() == ID_symbol && object.type().id() == ID_code)
+          functions.insert(to_symbol_expr(object));
+        else if(object.id() != ID_null_object)
+        {
+          // calls through null pointers are caught by the fall-through case
+          resolved = false;
+          break;
+        }
+      }
+
+      if(resolved && !functions.empty())
+        targets.emplace(target, std::move(functions));
+      else
+        ++unresolved;
+    }
+  }
+
+  log.statistics() << "Resolved " << targets.size()
+                   << " calls through function pointers, " << unresolved
+                   << " left to signature-based removal" << messaget::eom;
+
+  remove_function_pointers(
+    message_handler, goto_model, targets, add_safety_assertion);
+}
@@ -0,0 +1,29 @@
+/*******************************************************************\
+
+Module: Value Set Function Pointer Removal
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Value Set Function Pointer Removal
+
+#ifndef CPROVER_GOTO_INSTRUMENT_VALUE_SET_FI_FP_REMOVAL_H
+#define CPROVER_GOTO_INSTRUMENT_VALUE_SET_FI_FP_REMOVAL_H
+
+class goto_modelt;
+class message_handlert;
+
+/// Replace calls through function pointers by a case split over the
+/// functions that a flow-insensitive points-to analysis (see
+/// \ref value_set_analysis_fit) finds they may point to. The analysis is run
+/// once for the whole program. Calls through function pointers that may
+/// point to objects other than functions are left unchanged, such that they
+/// can be removed by \ref remove_function_pointers.
+void value_set_fi_fp_removal(
+  goto_modelt &goto_model,
+  message_handlert &message_handler,
+  bool add_safety_assertion);
+
+#endif // CPROVER_GOTO_INSTRUMENT_VALUE_SET_FI_FP_REMOVAL_H
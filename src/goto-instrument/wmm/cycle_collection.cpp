@@ -82,13 +82,19 @@ void event_grapht::graph_explorert::collect_cycles(
   if(order->empty())
     return;
 
+  if(egraph.time_limit!=0)
+    deadline=
+      std::chrono::steady_clock::now()+
+      std::chrono::seconds(egraph.time_limit);
+
   for(std::list<event_idt>::const_iterator
       st_it=order->begin();
-      st_it!=order->end();
+      st_it!=order->end() && !timed_out;
       ++st_it)
   {
     event_idt source=*st_it;
     egraph.message.debug() << "explore " << egraph[source].id << messaget::eom;
+    compute_reaches_source(source);
     backtrack(
       set_of_cycles,
       source,
@@ -109,11 +115,41 @@ void event_grapht::graph_explorert::collect_cycles(
     }
   }
 
+  if(timed_out)
+    egraph.message.warning() << "cycle collection ran out of time, "
+                             << set_of_cycles.size()
+                             << " cycles found so far" << messaget::eom;
+
   /* end of collection -- remove spurious by thin-air cycles */
   if(egraph.filter_thin_air)
     filter_thin_air(set_of_cycles);
 }
 
+/// collects the events from which the source can be reached backwards along
+/// po and com transitions, which bounds the exploration of backtrack
+void event_grapht::graph_explorert::compute_reaches_source(event_idt source)
+{
+  reaches_source.clear();
+  reaches_source.insert(source);
+
+  std::stack<event_idt> to_visit;
+  to_visit.push(source);
+
+  while(!to_visit.empty())
+  {
+    const event_idt current=to_visit.top();
+    to_visit.pop();
+
+    for(const auto &edge : egraph.po_in(current))
+      if(!filtering(edge.first) && reaches_source.insert(edge.first).second)
+        to_visit.push(edge.first);
+
+    for(const auto &edge : egraph.com_in(current))
+      if(!filtering(edge.first) && reaches_source.insert(edge.first).second)
+        to_visit.push(edge.first);
+  }
+}
+
 /// extracts a (whole, unreduced) cycle from the stack. Note: it may not be a
 /// real cycle yet -- we cannot check the size before a call to this function.
 event_grapht::critical_cyclet event_grapht::graph_explorert::extract_cycle(
@@ -204,6 +240,17 @@ bool event_grapht::graph_explorert::backtrack(
   if(filtering(vertex))
     return false;
 
+  /* no cycle back to the source from here */
+  if(reaches_source.find(vertex)==reaches_source.end())
+    return false;
+
+  if(egraph.time_limit!=0 && !timed_out &&
+     std::chrono::steady_clock::now()>deadline)
+    timed_out=true;
+
+  if(timed_out)
+    return false;
+
   egraph.message.debug() << "bcktck "<<egraph[vertex].id<<"#"<<vertex<<", "
     <<egraph[source].id<<"#"<<source<<" lw:"<<lwfence_met<<" unsafe:"
     <<unsafe_met << messaget::eom;
@@ -14,6 +14,7 @@ Date: 2012
 #ifndef CPROVER_GOTO_INSTRUMENT_WMM_EVENT_GRAPH_H
 #define CPROVER_GOTO_INSTRUMENT_WMM_EVENT_GRAPH_H
 
+#include <chrono>
 #include <list>
 #include <set>
 #include <map>
@@ -245,6 +246,8 @@ protected:
   unsigned max_var;
   unsigned max_po_trans;
   bool ignore_arrays;
+  /* seconds for each collection of cycles, 0 for no limit */
+  unsigned time_limit;
 
   /* graph explorer (for each cycles collection) */
   class graph_explorert
@@ -290,6 +293,15 @@ protected:
        indirect thin-air */
     void filter_thin_air(std::set<critical_cyclet> &set_of_cycles);
 
+    /* events from which the current source can be reached by po and com
+       transitions; no cycle through the source leaves this set */
+    std::set<event_idt> reaches_source;
+    void compute_reaches_source(event_idt source);
+
+    /* the collection stops at the deadline with the cycles found so far */
+    std::chrono::steady_clock::time_point deadline;
+    bool timed_out;
+
   public:
     graph_explorert(
       event_grapht &_egraph,
@@ -298,7 +310,8 @@ protected:
       egraph(_egraph),
       max_var(_max_var),
       max_po_trans(_max_po_trans),
-      cycle_nb(0)
+      cycle_nb(0),
+      timed_out(false)
     {
     }
 
@@ -384,6 +397,7 @@ public:
     max_var(0),
     max_po_trans(0),
     ignore_arrays(false),
+    time_limit(0),
     filter_thin_air(true),
     filter_uniproc(true),
     message(_message)
@@ -574,6 +588,13 @@ public:
     ignore_arrays = _ignore_arrays;
   }
 
+  /* bounds the time of each collection of cycles, which then only reports
+     the cycles found so far; 0 for no limit */
+  void set_time_limit(unsigned _time_limit)
+  {
+    time_limit = _time_limit;
+  }
+
   /* collects all the pairs of events with respectively at least one cmp,
      regardless of the architecture (Pensieve'05 strategy) */
   void collect_pairs()
@@ -398,6 +398,12 @@ public:
     egraph.set_parameters_collection(_max_var, _max_po_trans, _ignore_arrays);
   }
 
+  /* bounds the time of each collection of cycles, if required */
+  void set_time_limit(unsigned _time_limit)
+  {
+    egraph.set_time_limit(_time_limit);
+  }
+
   /* builds the relations between unsafe pairs in the critical cycles and
      instructions to instrument in the code */
 
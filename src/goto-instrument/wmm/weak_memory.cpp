@@ -121,7 +121,8 @@ void weak_memory(
   bool cav11_option,
   bool hide_internals,
   message_handlert &message_handler,
-  bool ignore_arrays)
+  bool ignore_arrays,
+  unsigned cycles_time_limit)
 {
   messaget message(message_handler);
 
@@ -159,6 +160,8 @@ void weak_memory(
   else
     instrumenter.set_parameters_collection(max_thds, 0, ignore_arrays);
 
+  instrumenter.set_time_limit(cycles_time_limit);
+
   if(SCC)
   {
     instrumenter.collect_cycles_by_SCCs(model);
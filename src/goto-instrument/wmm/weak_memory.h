@@ -42,7 +42,8 @@ void weak_memory(
   bool cav11_option,
   bool hide_internals,
   message_handlert &,
-  bool ignore_arrays);
+  bool ignore_arrays,
+  unsigned cycles_time_limit);
 
 void introduce_temporaries(
   value_setst &,
@@ -0,0 +1,255 @@
+/*******************************************************************\
+
+Module: Binary Traces of GOTO Programs
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Binary Traces of GOTO Programs
+
+#include "binary_goto_trace.h"
+
+#include <fstream>
+
+#include <util/exception_utils.h>
+
+#include "goto_functions.h"
+
+/// Map the difference \p to - \p from to an unsigned number, such that small
+/// differences in either direction result in small numbers
+static std::size_t encode_delta(std::size_t from, std::size_t to)
+{
+  return to >= from ? (to - from) << 1 : ((from - to) << 1) - 1;
+}
+
+static std::size_t decode_delta(std::size_t from, std::size_t delta)
+{
+  return (delta & 1) == 0 ? from + (delta >> 1) : from - ((delta + 1) >> 1);
+}
+
+enum
+{
+  HIDDEN = 1 << 0,
+  INTERNAL = 1 << 1,
+  COND_VALUE = 1 << 2,
+  FORMATTED = 1 << 3,
+  ACTUAL_PARAMETER = 1 << 4
+};
+
+binary_goto_trace_writert::binary_goto_trace_writert(std::ostream &_out)
+  : out(_out), irep_converter(ireps_container)
+{
+  out << char(0x7f) << "GBT";
+  write_gb_word(out, BINARY_GOTO_TRACE_VERSION);
+}
+
+void binary_goto_trace_writert::write_step(const goto_trace_stept &step)
+{
+  // the type is offset by one, as zero marks the end of the trace
+  write_gb_word(out, static_cast<std::size_t>(step.type) + 1);
+  write_gb_word(out, encode_delta(previous_step_nr, step.step_nr));
+  previous_step_nr = step.step_nr;
+
+  std::size_t flags = 0;
+  if(step.hidden)
+    flags |= HIDDEN;
+  if(step.internal)
+    flags |= INTERNAL;
+  if(step.cond_value)
+    flags |= COND_VALUE;
+  if(step.formatted)
+    flags |= FORMATTED;
+  if(
+    step.assignment_type ==
+    goto_trace_stept::assignment_typet::ACTUAL_PARAMETER)
+  {
+    flags |= ACTUAL_PARAMETER;
+  }
+  write_gb_word(out, flags);
+
+  write_gb_word(out, step.thread_nr);
+
+  irep_converter.write_string_ref(out, step.function_id);
+  write_gb_word(
+    out, encode_delta(previous_location_number, step.pc->location_number));
+  previous_location_number = step.pc->location_number;
+
+  irep_converter.reference_convert(step.cond_expr, out);
+  irep_converter.write_string_ref(out, step.property_id);
+  irep_converter.write_string_ref(out, step.comment);
+
+  irep_converter.reference_convert(step.full_lhs, out);
+  irep_converter.reference_convert(step.full_lhs_value, out);
+
+  irep_converter.write_string_ref(out, step.format_string);
+  irep_converter.write_string_ref(out, step.io_id);
+  write_gb_word(out, step.io_args.size());
+  for(const auto &arg : step.io_args)
+    irep_converter.reference_convert(arg, out);
+
+  irep_converter.write_string_ref(out, step.called_function);
+  write_gb_word(out, step.function_arguments.size());
+  for(const auto &arg : step.function_arguments)
+    irep_converter.reference_convert(arg, out);
+}
+
+void binary_goto_trace_writert::finish()
+{
+  write_gb_word(out, 0);
+  out.flush();
+}
+
+binary_goto_trace_readert::binary_goto_trace_readert(
+  std::istream &_in,
+  const goto_functionst &_goto_functions)
+  : in(_in), goto_functions(_goto_functions), irep_converter(ireps_container)
+{
+  char hdr[4];
+  in.read(hdr, 4);
+
+  if(!in || hdr[0] != 0x7f || hdr[1] != 'G' || hdr[2] != 'B' || hdr[3] != 'T')
+    throw deserialization_exceptiont("not a binary goto trace");
+
+  const std::size_t version = irep_serializationt::read_gb_word(in);
+  if(version != BINARY_GOTO_TRACE_VERSION)
+  {
+    throw deserialization_exceptiont(
+      "unsupported binary goto trace version " + std::to_string(version));
+  }
+}
+
+goto_programt::const_targett binary_goto_trace_readert::find_instruction(
+  const irep_idt &function_id,
+  std::size_t location_number)
+{
+  auto entry = instructions.emplace(function_id, instructionst{});
+  instructionst &function_instructions = entry.first->second;
+
+  if(entry.second)
+  {
+    const auto function = goto_functions.function_map.find(function_id);
+    if(function == goto_functions.function_map.end())
+    {
+      throw deserialization_exceptiont(
+        "binary goto trace refers to unknown function " +
+        id2string(function_id));
+    }
+
+    const auto &body = function->second.body;
+    forall_goto_program_instructions(it, body)
+      function_instructions.emplace(it->location_number, it);
+  }
+
+  const auto instruction = function_instructions.find(location_number);
+  if(instruction == function_instructions.end())
+  {
+    throw deserialization_exceptiont(
+      "binary goto trace refers to unknown location " +
+      std::to_string(location_number) + " of " + id2string(function_id));
+  }
+
+  return instruction->second;
+}
+
+bool binary_goto_trace_readert::read_step(goto_trace_stept &step)
+{
+  const std::size_t type = irep_serializationt::read_gb_word(in);
+  if(type == 0)
+    return false;
+  if(type - 1 > static_cast<std::size_t>(goto_trace_stept::typet::ATOMIC_END))
+    throw deserialization_exceptiont("invalid binary goto trace step type");
+
+  step = goto_trace_stept();
+  step.type = static_cast<goto_trace_stept::typet>(type - 1);
+  step.step_nr =
+    decode_delta(previous_step_nr, irep_serializationt::read_gb_word(in));
+  previous_step_nr = step.step_nr;
+
+  const std::size_t flags = irep_serializationt::read_gb_word(in);
+  step.hidden = (flags & HIDDEN) != 0;
+  step.internal = (flags & INTERNAL) != 0;
+  step.cond_value = (flags & COND_VALUE) != 0;
+  step.formatted = (flags & FORMATTED) != 0;
+  if((flags & ACTUAL_PARAMETER) != 0)
+  {
+    step.assignment_type =
+      goto_trace_stept::assignment_typet::ACTUAL_PARAMETER;
+  }
+
+  step.thread_nr =
+    static_cast<unsigned>(irep_serializationt::read_gb_word(in));
+
+  step.function_id = irep_converter.read_string_ref(in);
+  const std::size_t location_number = decode_delta(
+    previous_location_number, irep_serializationt::read_gb_word(in));
+  previous_location_number = location_number;
+  step.pc = find_instruction(step.function_id, location_number);
+
+  step.cond_expr =
+    static_cast<const exprt &>(irep_converter.reference_convert(in));
+  step.property_id = irep_converter.read_string_ref(in);
+  step.comment = id2string(irep_converter.read_string_ref(in));
+
+  step.full_lhs =
+    static_cast<const exprt &>(irep_converter.reference_convert(in));
+  step.full_lhs_value =
+    static_cast<const exprt &>(irep_converter.reference_convert(in));
+
+  step.format_string = irep_converter.read_string_ref(in);
+  step.io_id = irep_converter.read_string_ref(in);
+  const std::size_t io_args = irep_serializationt::read_gb_word(in);
+  for(std::size_t i = 0; i < io_args; ++i)
+  {
+    step.io_args.push_back(
+      static_cast<const exprt &>(irep_converter.reference_convert(in)));
+  }
+
+  step.called_function = irep_converter.read_string_ref(in);
+  const std::size_t function_arguments = irep_serializationt::read_gb_word(in);
+  for(std::size_t i = 0; i < function_arguments; ++i)
+  {
+    step.function_arguments.push_back(
+      static_cast<const exprt &>(irep_converter.reference_convert(in)));
+  }
+
+  return true;
+}
+
+void write_binary_goto_trace(const goto_tracet &goto_trace, std::ostream &out)
+{
+  binary_goto_trace_writert writer(out);
+
+  for(const auto &step : goto_trace.steps)
+    writer.write_step(step);
+
+  writer.finish();
+}
+
+bool write_binary_goto_trace(
+  const goto_tracet &goto_trace,
+  const std::string &filename)
+{
+  std::ofstream out(filename, std::ios::binary);
+
+  if(!out)
+    return true;
+
+  write_binary_goto_trace(goto_trace, out);
+
+  return !out;
+}
+
+void read_binary_goto_trace(
+  std::istream &in,
+  const goto_functionst &goto_functions,
+  goto_tracet &dest)
+{
+  binary_goto_trace_readert reader(in, goto_functions);
+
+  dest.clear();
+  goto_trace_stept step;
+  while(reader.read_step(step))
+    dest.add_step(step);
+}
@@ -0,0 +1,108 @@
+/*******************************************************************\
+
+Module: Binary Traces of GOTO Programs
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Binary Traces of GOTO Programs
+
+#ifndef CPROVER_GOTO_PROGRAMS_BINARY_GOTO_TRACE_H
+#define CPROVER_GOTO_PROGRAMS_BINARY_GOTO_TRACE_H
+
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+
+#include <util/irep_serialization.h>
+
+#include "goto_trace.h"
+
+class goto_functionst;
+
+#define BINARY_GOTO_TRACE_VERSION 1
+
+/// Writes the steps of a trace to a stream in a compact binary format, one
+/// step at a time, such that the trace never needs to be held in memory as
+/// text. The stream starts with the header `0x7f GBT` and the version.
+///
+/// Identifiers and strings are written once and then referred to by number,
+/// as are expressions, using \ref irep_serializationt: a value that is
+/// assigned repeatedly, or that shares sub-expressions with an earlier one,
+/// only costs the references to what was written before. Step numbers and
+/// location numbers are written as the difference to those of the previous
+/// step. The instruction of a step is identified by its function and its
+/// location number, which are resolved against the goto functions when the
+/// trace is read back.
+class binary_goto_trace_writert
+{
+public:
+  explicit binary_goto_trace_writert(std::ostream &out);
+
+  /// Append \p step to the trace
+  void write_step(const goto_trace_stept &step);
+
+  /// Mark the end of the trace
+  void finish();
+
+protected:
+  std::ostream &out;
+  irep_serializationt::ireps_containert ireps_container;
+  irep_serializationt irep_converter;
+
+  std::size_t previous_step_nr = 0;
+  std::size_t previous_location_number = 0;
+};
+
+/// Reads a trace written by \ref binary_goto_trace_writert.
+/// Throws a \ref deserialization_exceptiont if the stream is not a binary
+/// trace, or if the trace refers to instructions that are not in
+/// \p goto_functions.
+class binary_goto_trace_readert
+{
+public:
+  binary_goto_trace_readert(
+    std::istream &in,
+    const goto_functionst &goto_functions);
+
+  /// Read the next step into \p step
+  /// \return False once the end of the trace has been reached
+  bool read_step(goto_trace_stept &step);
+
+protected:
+  std::istream &in;
+  const goto_functionst &goto_functions;
+  irep_serializationt::ireps_containert ireps_container;
+  irep_serializationt irep_converter;
+
+  std::size_t previous_step_nr = 0;
+  std::size_t previous_location_number = 0;
+
+  using instructionst =
+    std::unordered_map<std::size_t, goto_programt::const_targett>;
+  /// Instructions of each function by location number, filled as functions
+  /// are referred to by the trace
+  std::unordered_map<irep_idt, instructionst, irep_id_hash> instructions;
+
+  goto_programt::const_targett
+  find_instruction(const irep_idt &function_id, std::size_t location_number);
+};
+
+/// Write all steps of \p goto_trace to \p out
+void write_binary_goto_trace(const goto_tracet &goto_trace, std::ostream &out);
+
+/// Write \p goto_trace to the file \p filename
+/// \return True if the file could not be written
+bool write_binary_goto_trace(
+  const goto_tracet &goto_trace,
+  const std::string &filename);
+
+/// Read a whole trace from \p in into \p dest
+void read_binary_goto_trace(
+  std::istream &in,
+  const goto_functionst &goto_functions,
+  goto_tracet &dest);
+
+#endif // CPROVER_GOTO_PROGRAMS_BINARY_GOTO_TRACE_H
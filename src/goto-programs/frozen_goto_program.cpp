@@ -0,0 +1,92 @@
+/*******************************************************************\
+
+Module: Contiguous Representation of GOTO Programs
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Contiguous Representation of GOTO Programs
+
+#include "frozen_goto_program.h"
+
+frozen_goto_programt::frozen_goto_programt(const goto_programt &goto_program)
+{
+  const std::size_t size = goto_program.instructions.size();
+  instructions.reserve(size);
+  indices.reserve(size);
+
+  forall_goto_program_instructions(it, goto_program)
+  {
+    indices.emplace(&*it, instructions.size());
+    instructions.push_back(*it);
+  }
+
+  target_offsets.reserve(size + 1);
+  successor_offsets.reserve(size + 1);
+  target_offsets.push_back(0);
+  successor_offsets.push_back(0);
+
+  std::vector<std::size_t> predecessor_counts(size, 0);
+
+  forall_goto_program_instructions(it, goto_program)
+  {
+    for(const auto &target : it->targets)
+      target_indices.push_back(index_of(target));
+    target_offsets.push_back(target_indices.size());
+
+    for(const auto &successor : goto_program.get_successors(it))
+    {
+      const std::size_t s = index_of(successor);
+      successor_indices.push_back(s);
+      ++predecessor_counts[s];
+    }
+    successor_offsets.push_back(successor_indices.size());
+  }
+
+  // invert the successor relation
+  predecessor_offsets.reserve(size + 1);
+  predecessor_offsets.push_back(0);
+  for(const auto count : predecessor_counts)
+    predecessor_offsets.push_back(predecessor_offsets.back() + count);
+
+  predecessor_indices.resize(successor_indices.size());
+  std::vector<std::size_t> next(
+    predecessor_offsets.begin(), predecessor_offsets.end() - 1);
+  for(std::size_t i = 0; i < size; ++i)
+  {
+    for(const auto s : successors(i))
+      predecessor_indices[next[s]++] = i;
+  }
+}
+
+std::size_t
+frozen_goto_programt::index_of(goto_programt::const_targett target) const
+{
+  const auto entry = indices.find(&*target);
+  PRECONDITION(entry != indices.end());
+  return entry->second;
+}
+
+goto_programt frozen_goto_programt::thaw() const
+{
+  goto_programt goto_program;
+
+  std::vector<goto_programt::targett> targets_of_index;
+  targets_of_index.reserve(size());
+  for(const auto &instruction : instructions)
+    targets_of_index.push_back(goto_program.add(goto_programt::instructiont{
+      instruction}));
+
+  for(std::size_t i = 0; i < size(); ++i)
+  {
+    auto &new_targets = targets_of_index[i]->targets;
+    new_targets.clear();
+    for(const auto t : targets(i))
+      new_targets.push_back(targets_of_index[t]);
+  }
+
+  goto_program.update();
+  return goto_program;
+}
@@ -0,0 +1,138 @@
+/*******************************************************************\
+
+Module: Contiguous Representation of GOTO Programs
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Contiguous Representation of GOTO Programs
+
+#ifndef CPROVER_GOTO_PROGRAMS_FROZEN_GOTO_PROGRAM_H
+#define CPROVER_GOTO_PROGRAMS_FROZEN_GOTO_PROGRAM_H
+
+#include "goto_program.h"
+
+#include <unordered_map>
+#include <vector>
+
+/// A read-only copy of a \ref goto_programt that stores the instructions in
+/// a contiguous array, refers to instructions by their index in that array,
+/// and has the successors and predecessors of all instructions precomputed.
+/// Analyses that walk over a program that is no longer modified, e.g., after
+/// instrumentation, thus avoid chasing the pointers of the instruction list.
+/// Use \ref thaw to obtain a \ref goto_programt again when the program is to
+/// be modified.
+///
+/// The `targets` of the copied instructions still refer to the instructions
+/// of the original program; use \ref targets instead.
+class frozen_goto_programt
+{
+public:
+  /// A range of instruction indices
+  class index_ranget
+  {
+  public:
+    index_ranget(const std::size_t *begin, const std::size_t *end)
+      : begin_(begin), end_(end)
+    {
+    }
+
+    const std::size_t *begin() const
+    {
+      return begin_;
+    }
+
+    const std::size_t *end() const
+    {
+      return end_;
+    }
+
+    std::size_t size() const
+    {
+      return static_cast<std::size_t>(end_ - begin_);
+    }
+
+    bool empty() const
+    {
+      return begin_ == end_;
+    }
+
+    std::size_t operator[](std::size_t i) const
+    {
+      return begin_[i];
+    }
+
+  private:
+    const std::size_t *begin_;
+    const std::size_t *end_;
+  };
+
+  explicit frozen_goto_programt(const goto_programt &);
+
+  std::size_t size() const
+  {
+    return instructions.size();
+  }
+
+  bool empty() const
+  {
+    return instructions.empty();
+  }
+
+  const goto_programt::instructiont &operator[](std::size_t index) const
+  {
+    return instructions[index];
+  }
+
+  /// Index of the instruction \p target of the original program
+  std::size_t index_of(goto_programt::const_targett target) const;
+
+  /// Indices of the targets of the goto instruction at \p index
+  index_ranget targets(std::size_t index) const
+  {
+    return range(target_offsets, target_indices, index);
+  }
+
+  /// Indices of the instructions that may be executed after the one at
+  /// \p index, as given by \ref goto_programt::get_successors
+  index_ranget successors(std::size_t index) const
+  {
+    return range(successor_offsets, successor_indices, index);
+  }
+
+  /// Indices of the instructions that the one at \p index may be executed
+  /// after
+  index_ranget predecessors(std::size_t index) const
+  {
+    return range(predecessor_offsets, predecessor_indices, index);
+  }
+
+  /// Convert back to a \ref goto_programt, with the targets of the
+  /// instructions referring to the instructions of the new program
+  goto_programt thaw() const;
+
+protected:
+  std::vector<goto_programt::instructiont> instructions;
+  std::unordered_map<const goto_programt::instructiont *, std::size_t>
+    indices;
+
+  // Compressed adjacency lists: the entries for instruction i are those in
+  // [offsets[i], offsets[i + 1]) of the corresponding array of indices.
+  std::vector<std::size_t> target_offsets, target_indices;
+  std::vector<std::size_t> successor_offsets, successor_indices;
+  std::vector<std::size_t> predecessor_offsets, predecessor_indices;
+
+  static index_ranget range(
+    const std::vector<std::size_t> &offsets,
+    const std::vector<std::size_t> &indices,
+    std::size_t index)
+  {
+    PRECONDITION(index + 1 < offsets.size());
+    return index_ranget(
+      indices.data() + offsets[index], indices.data() + offsets[index + 1]);
+  }
+};
+
+#endif // CPROVER_GOTO_PROGRAMS_FROZEN_GOTO_PROGRAM_H
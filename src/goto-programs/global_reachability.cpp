@@ -0,0 +1,116 @@
+/*******************************************************************\
+
+Module: Reachability of Functions and Global Variables
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Reachability of Functions and Global Variables
+
+#include "global_reachability.h"
+
+#include <util/find_symbols.h>
+#include <util/prefix.h>
+#include <util/std_types.h>
+#include <util/symbol_table_base.h>
+
+#include <linking/static_lifetime_init.h>
+
+#include "goto_functions.h"
+
+global_reachabilityt::global_reachabilityt(
+  const symbol_table_baset &symbol_table,
+  const goto_functionst &goto_functions,
+  const std::vector<irep_idt> &roots)
+  : symbol_table(symbol_table), goto_functions(&goto_functions)
+{
+  compute(roots);
+}
+
+global_reachabilityt::global_reachabilityt(
+  const symbol_table_baset &symbol_table,
+  const std::vector<irep_idt> &roots)
+  : symbol_table(symbol_table), goto_functions(nullptr)
+{
+  compute(roots);
+}
+
+/// The symbols `__CPROVER_initialize` is made of, see static_lifetime_init
+static bool is_initialization_root(const symbolt &symbol)
+{
+  if(symbol.type.id() == ID_code)
+  {
+    const code_typet &code_type = to_code_type(symbol.type);
+    return code_type.return_type().id() == ID_constructor &&
+           code_type.parameters().empty();
+  }
+
+  return symbol.is_static_lifetime &&
+         has_prefix(id2string(symbol.name), CPROVER_PREFIX);
+}
+
+void global_reachabilityt::compute(const std::vector<irep_idt> &roots)
+{
+  numbers.reserve(symbol_table.symbols.size());
+  for(const auto &symbol_pair : symbol_table.symbols)
+    numbers.emplace(symbol_pair.first, numbers.size());
+  reached.resize(numbers.size(), false);
+
+  std::vector<irep_idt> worklist;
+  auto reach = [this, &worklist](const irep_idt &identifier) {
+    const auto it = numbers.find(identifier);
+    if(it != numbers.end() && !reached[it->second])
+    {
+      reached[it->second] = true;
+      worklist.push_back(identifier);
+    }
+  };
+
+  for(const auto &root : roots)
+    reach(root);
+
+  while(!worklist.empty())
+  {
+    const irep_idt identifier = worklist.back();
+    worklist.pop_back();
+
+    if(identifier == INITIALIZE_FUNCTION)
+    {
+      for(const auto &symbol_pair : symbol_table.symbols)
+      {
+        if(is_initialization_root(symbol_pair.second))
+          reach(symbol_pair.first);
+      }
+      continue;
+    }
+
+    find_symbols_sett successors;
+
+    bool has_goto_body = false;
+    if(goto_functions != nullptr)
+    {
+      const auto function_it = goto_functions->function_map.find(identifier);
+      if(function_it != goto_functions->function_map.end())
+      {
+        has_goto_body = true;
+        for(const auto &instruction : function_it->second.body.instructions)
+        {
+          find_symbols(instruction.code, successors, true, false);
+          if(instruction.has_condition())
+            find_symbols(instruction.get_condition(), successors, true, false);
+        }
+      }
+    }
+
+    if(!has_goto_body)
+    {
+      find_symbols(
+        symbol_table.lookup_ref(identifier).value, successors, true, false);
+    }
+
+    for(const auto &successor : successors)
+      reach(successor);
+  }
+}
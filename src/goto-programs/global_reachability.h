@@ -0,0 +1,62 @@
+/*******************************************************************\
+
+Module: Reachability of Functions and Global Variables
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Reachability of Functions and Global Variables
+
+#ifndef CPROVER_GOTO_PROGRAMS_GLOBAL_REACHABILITY_H
+#define CPROVER_GOTO_PROGRAMS_GLOBAL_REACHABILITY_H
+
+#include <util/irep.h>
+
+#include <unordered_map>
+#include <vector>
+
+class goto_functionst;
+class symbol_table_baset;
+
+/// The functions and variables of static lifetime that are reachable from a
+/// set of roots, computed together as the transitive closure of "occurs in
+/// the body or the initial value of" over the symbol table. The body of
+/// `__CPROVER_initialize` is not followed, as it mentions all variables:
+/// it instead reaches what it is made of regardless of the program, the
+/// variables with prefix `__CPROVER_` and the constructors.
+class global_reachabilityt
+{
+public:
+  /// Follow the bodies in \p goto_functions where present and the values of
+  /// the function symbols otherwise.
+  global_reachabilityt(
+    const symbol_table_baset &symbol_table,
+    const goto_functionst &goto_functions,
+    const std::vector<irep_idt> &roots);
+
+  /// Follow the values of the function symbols, for use before goto
+  /// conversion, e.g. before the initialization code is generated.
+  global_reachabilityt(
+    const symbol_table_baset &symbol_table,
+    const std::vector<irep_idt> &roots);
+
+  bool is_reachable(const irep_idt &identifier) const
+  {
+    const auto it = numbers.find(identifier);
+    return it != numbers.end() && reached[it->second];
+  }
+
+protected:
+  const symbol_table_baset &symbol_table;
+  const goto_functionst *const goto_functions;
+
+  /// the number of each symbol, indexing \ref reached
+  std::unordered_map<irep_idt, std::size_t> numbers;
+  std::vector<bool> reached;
+
+  void compute(const std::vector<irep_idt> &roots);
+};
+
+#endif // CPROVER_GOTO_PROGRAMS_GLOBAL_REACHABILITY_H
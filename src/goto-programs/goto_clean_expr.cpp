@@ -106,6 +106,17 @@ bool goto_convertt::needs_cleaning(const exprt &expr)
   return false;
 }
 
+/// \return true if \p expr contains neither side effects nor other
+///   subexpressions that cleaning turns into instructions, i.e., it only
+///   needs cleaning because of dereferences or index expressions
+static bool is_side_effect_free(const exprt &expr)
+{
+  return !has_subexpr(expr, [](const exprt &subexpr) {
+    return subexpr.id() == ID_side_effect || subexpr.id() == ID_comma ||
+           subexpr.id() == ID_compound_literal;
+  });
+}
+
 /// re-write boolean operators into ?:
 void goto_convertt::rewrite_boolean(exprt &expr)
 {
@@ -194,6 +205,19 @@ void goto_convertt::clean_expr(
        !needs_cleaning(to_if_expr(expr).false_case()))
       return;
 
+    // A non-Boolean ?: whose cases have no side effects can stay an
+    // expression: goto_check guards the checks of the cases by the
+    // condition, so no temporary and branches are needed. This is the
+    // common shape of MIN/MAX-style macros applied to array elements or
+    // dereferenced pointers.
+    if(
+      !expr.is_boolean() &&
+      is_side_effect_free(to_if_expr(expr).true_case()) &&
+      is_side_effect_free(to_if_expr(expr).false_case()))
+    {
+      return;
+    }
+
     // copy expression
     if_exprt if_expr=to_if_expr(expr);
 
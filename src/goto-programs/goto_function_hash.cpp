@@ -0,0 +1,126 @@
+/*******************************************************************\
+
+Module: Content Hash of Goto Functions
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Content Hash of Goto Functions
+
+#include "goto_function_hash.h"
+
+#include <util/irep_hash.h>
+#include <util/prefix.h>
+#include <util/string_hash.h>
+
+#include "goto_function.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+class goto_function_hashert
+{
+public:
+  explicit goto_function_hashert(const irep_idt &function_id)
+    : local_prefix(id2string(function_id) + "::")
+  {
+  }
+
+  void add(std::size_t value)
+  {
+    hash = hash_combine(hash, value);
+    ++length;
+  }
+
+  void add(const irep_idt &id)
+  {
+    add(hash_string(id2string(id)));
+  }
+
+  /// Adds \p irep without comments, with named sub-trees in lexicographic
+  /// order and local identifiers replaced by their number
+  void add(const irept &irep)
+  {
+    add(irep.id());
+
+    std::vector<std::pair<std::string, const irept *>> named_sub;
+    for(const auto &entry : irep.get_named_sub())
+    {
+      if(!irept::is_comment(entry.first))
+        named_sub.emplace_back(id2string(entry.first), &entry.second);
+    }
+    std::sort(named_sub.begin(), named_sub.end());
+
+    for(const auto &entry : named_sub)
+    {
+      add(hash_string(entry.first));
+      if(entry.first == id2string(ID_identifier))
+        add_identifier(entry.second->id());
+      else
+        add(*entry.second);
+    }
+
+    add(irep.get_sub().size());
+    for(const auto &sub : irep.get_sub())
+      add(sub);
+  }
+
+  std::size_t result() const
+  {
+    return hash_finalize(hash, length);
+  }
+
+  void add_identifier(const irep_idt &identifier)
+  {
+    if(has_prefix(id2string(identifier), local_prefix))
+    {
+      const auto entry =
+        local_numbers.emplace(identifier, local_numbers.size());
+      add(hash_string("local"));
+      add(entry.first->second);
+    }
+    else
+      add(identifier);
+  }
+
+private:
+  const std::string local_prefix;
+  std::unordered_map<irep_idt, std::size_t> local_numbers;
+  std::size_t hash = 0;
+  std::size_t length = 0;
+};
+} // namespace
+
+std::size_t goto_function_hash(
+  const irep_idt &function_id,
+  const goto_functiont &goto_function)
+{
+  goto_function_hashert hasher(function_id);
+
+  for(const auto &parameter : goto_function.parameter_identifiers)
+    hasher.add_identifier(parameter);
+
+  const auto &instructions = goto_function.body.instructions;
+
+  std::unordered_map<const goto_programt::instructiont *, std::size_t> index;
+  for(const auto &instruction : instructions)
+    index.emplace(&instruction, index.size());
+
+  hasher.add(instructions.size());
+  for(const auto &instruction : instructions)
+  {
+    hasher.add(static_cast<std::size_t>(instruction.type));
+    if(instruction.has_condition())
+      hasher.add(instruction.get_condition());
+    hasher.add(instruction.code);
+    for(const auto &target : instruction.targets)
+      hasher.add(index.at(&*target));
+  }
+
+  return hasher.result();
+}
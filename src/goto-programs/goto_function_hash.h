@@ -0,0 +1,36 @@
+/*******************************************************************\
+
+Module: Content Hash of Goto Functions
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Content Hash of Goto Functions
+
+#ifndef CPROVER_GOTO_PROGRAMS_GOTO_FUNCTION_HASH_H
+#define CPROVER_GOTO_PROGRAMS_GOTO_FUNCTION_HASH_H
+
+#include <util/irep.h>
+
+#include <cstddef>
+
+class goto_functiont;
+
+/// Computes a hash of the body of \p goto_function that is the same in
+/// separate runs and across goto binaries. It ignores source locations and
+/// other comments, and the local variables and parameters of \p function_id
+/// (those named `function_id::...`) are numbered in order of their first
+/// occurrence, so that changes elsewhere in the source, such as additional
+/// block scopes, do not affect the hash. Functions with different hashes
+/// differ; functions with equal hashes are the same up to those
+/// normalisations, barring collisions.
+/// \param function_id: name of the function, used to recognise local names
+/// \param goto_function: the function to hash
+/// \return the hash
+std::size_t goto_function_hash(
+  const irep_idt &function_id,
+  const goto_functiont &goto_function);
+
+#endif // CPROVER_GOTO_PROGRAMS_GOTO_FUNCTION_HASH_H
@@ -112,6 +112,13 @@ public:
   /// The validation mode indicates whether well-formedness check failures are
   /// reported via DATA_INVARIANT violations or exceptions.
   void validate(const namespacet &, validation_modet) const;
+
+  /// Check that the goto function \p function_id is well-formed and
+  /// consistent with its symbol, as done by \ref validate for each function
+  void validate_function(
+    const namespacet &,
+    validation_modet,
+    const irep_idt &function_id) const;
 };
 
 #define Forall_goto_functions(it, functions) \
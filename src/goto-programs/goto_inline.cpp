@@ -11,13 +11,17 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "goto_inline.h"
 
+#include <algorithm>
 #include <cassert>
 
+#include <util/message.h>
 #include <util/prefix.h>
 #include <util/cprover_prefix.h>
 #include <util/std_code.h>
 #include <util/std_expr.h>
 
+#include <analyses/call_graph.h>
+
 #include "goto_inline_class.h"
 
 void goto_inline(
@@ -207,6 +211,188 @@ void goto_partial_inline(
   goto_inline.goto_inline(inline_map, false);
 }
 
+void goto_cost_inline(
+  goto_modelt &goto_model,
+  message_handlert &message_handler,
+  unsigned cost_limit,
+  bool adjust_function)
+{
+  const namespacet ns(goto_model.symbol_table);
+  goto_cost_inline(
+    goto_model.goto_functions,
+    ns,
+    message_handler,
+    cost_limit,
+    adjust_function);
+}
+
+/// Return the number of loops each instruction of \p goto_program is in,
+/// where a loop is formed by a backward jump and the instructions it jumps
+/// over
+static std::unordered_map<const goto_programt::instructiont *, std::size_t>
+loop_depths(const goto_programt &goto_program)
+{
+  std::vector<goto_programt::const_targett> instructions;
+  std::unordered_map<const goto_programt::instructiont *, std::size_t> index;
+  forall_goto_program_instructions(i_it, goto_program)
+  {
+    index.emplace(&*i_it, instructions.size());
+    instructions.push_back(i_it);
+  }
+
+  std::vector<std::size_t> depth(instructions.size(), 0);
+  for(std::size_t i = 0; i < instructions.size(); ++i)
+  {
+    if(!instructions[i]->is_goto())
+      continue;
+
+    // forward jumps leave the range empty
+    for(const auto &target : instructions[i]->targets)
+    {
+      const std::size_t head = index.at(&*target);
+      for(std::size_t j = head; j <= i; ++j)
+        ++depth[j];
+    }
+  }
+
+  std::unordered_map<const goto_programt::instructiont *, std::size_t> result;
+  for(std::size_t i = 0; i < instructions.size(); ++i)
+    result.emplace(&*instructions[i], depth[i]);
+
+  return result;
+}
+
+/// Inline all function calls to functions marked as "inlined", and those
+/// calls for which the number of instructions of the callee is at most
+/// \p cost_limit times the estimated benefit of inlining the call. The
+/// benefit grows with
+/// - the number of times the call is executed, which is estimated to be 10
+///   times per loop the call is in, for up to 3 nested loops, and
+/// - the number of arguments that are constants or addresses, as these may
+///   allow simplifying the inlined body.
+///
+/// Functions that are part of a recursion are only inlined if they are
+/// marked as "inlined", as their inlining would have to be cut off at some
+/// depth.
+/// \param goto_functions: The function map to use to find functions
+///   containing calls and function bodies.
+/// \param ns: Namespace used by goto_inlinet.
+/// \param message_handler: Message handler used by goto_inlinet.
+/// \param cost_limit: The maximum number of instructions of an inlined
+///   function per unit of benefit.
+/// \param adjust_function: Tell goto_inlinet to adjust function.
+void goto_cost_inline(
+  goto_functionst &goto_functions,
+  const namespacet &ns,
+  message_handlert &message_handler,
+  unsigned cost_limit,
+  bool adjust_function)
+{
+  goto_inlinet goto_inline(
+    goto_functions,
+    ns,
+    message_handler,
+    adjust_function);
+
+  typedef goto_functionst::goto_functiont goto_functiont;
+
+  const call_grapht::directed_grapht call_graph =
+    call_grapht(goto_functions).get_directed_graph();
+  std::vector<call_grapht::directed_grapht::node_indext> scc;
+  std::vector<std::size_t> scc_size(call_graph.SCCs(scc), 0);
+  for(const auto s : scc)
+    ++scc_size[s];
+
+  const auto is_recursive = [&](const irep_idt &id) {
+    const auto node = call_graph.get_node_index(id);
+    return node.has_value() &&
+           (scc_size[scc[*node]] > 1 || call_graph.has_edge(*node, *node));
+  };
+
+  // gather the calls to inline
+  goto_inlinet::inline_mapt inline_map;
+  std::size_t number_of_calls = 0;
+
+  Forall_goto_functions(f_it, goto_functions)
+  {
+    goto_functiont &goto_function=f_it->second;
+
+    if(!goto_function.body_available())
+      continue;
+
+    if(f_it->first==goto_functions.entry_point())
+      // Don't inline any function calls made from the _start function.
+      continue;
+
+    goto_programt &goto_program=goto_function.body;
+
+    goto_inlinet::call_listt &call_list=inline_map[f_it->first];
+
+    const auto loop_depth = loop_depths(goto_program);
+
+    Forall_goto_program_instructions(i_it, goto_program)
+    {
+      if(!i_it->is_function_call())
+        continue;
+
+      exprt lhs;
+      exprt function_expr;
+      exprt::operandst arguments;
+      goto_inlinet::get_call(i_it, lhs, function_expr, arguments);
+
+      if(function_expr.id()!=ID_symbol)
+        // Can't handle pointers to functions
+        continue;
+
+      const irep_idt id = to_symbol_expr(function_expr).get_identifier();
+
+      goto_functionst::function_mapt::const_iterator called_it =
+        goto_functions.function_map.find(id);
+
+      if(
+        called_it == goto_functions.function_map.end() ||
+        !called_it->second.body_available())
+      {
+        continue;
+      }
+
+      bool inline_call = to_code_type(ns.lookup(id).type).get_inlined();
+
+      if(!inline_call && !is_recursive(id))
+      {
+        const std::size_t depth =
+          std::min<std::size_t>(loop_depth.at(&*i_it), 3);
+        std::size_t frequency = 1;
+        for(std::size_t i = 0; i < depth; ++i)
+          frequency *= 10;
+
+        std::size_t constant_arguments = 0;
+        for(const auto &argument : arguments)
+        {
+          if(argument.is_constant() || argument.id() == ID_address_of)
+            ++constant_arguments;
+        }
+
+        const std::size_t benefit = frequency * (1 + constant_arguments);
+        inline_call =
+          called_it->second.body.instructions.size() <= cost_limit * benefit;
+      }
+
+      if(inline_call)
+      {
+        call_list.push_back(goto_inlinet::callt(i_it, false));
+        ++number_of_calls;
+      }
+    }
+  }
+
+  messaget log(message_handler);
+  log.statistics() << "Inlining " << number_of_calls << " calls"
+                   << messaget::eom;
+
+  goto_inline.goto_inline(inline_map, false);
+}
+
 /// Inline all function calls made from a particular function
 /// \param goto_model: Source of the symbol table and function map to use.
 /// \param function: The function whose calls to inline.
@@ -47,6 +47,23 @@ void goto_partial_inline(
   unsigned smallfunc_limit=0,
   bool adjust_function=false);
 
+// inline those functions marked as "inlined" and calls for which the
+// number of instructions of the callee is at most cost_limit times the
+// estimated benefit of inlining, see goto_cost_inline in goto_inline.cpp
+
+void goto_cost_inline(
+  goto_modelt &goto_model,
+  message_handlert &message_handler,
+  unsigned cost_limit,
+  bool adjust_function=false);
+
+void goto_cost_inline(
+  goto_functionst &goto_functions,
+  const namespacet &ns,
+  message_handlert &message_handler,
+  unsigned cost_limit,
+  bool adjust_function=false);
+
 // transitively inline all calls the given function makes
 
 void goto_function_inline(
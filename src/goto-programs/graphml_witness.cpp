@@ -18,7 +18,6 @@ Author: Daniel Kroening
 #include <util/pointer_predicates.h>
 #include <util/prefix.h>
 #include <util/ssa_expr.h>
-#include <util/string_container.h>
 
 #include <langapi/language_util.h>
 #include <langapi/mode.h>
@@ -62,16 +61,24 @@ void graphml_witnesst::remove_l0_l1(exprt &expr)
     remove_l0_l1(*it);
 }
 
+std::string
+graphml_witnesst::convert_expr(const irep_idt &identifier, const exprt &expr)
+{
+  cache_keyt key{identifier, expr};
+  const auto cit = expr_cache.find(key);
+  if(cit != expr_cache.end())
+    return cit->second;
+
+  std::string result = expr_to_string(ns, identifier, expr);
+  expr_cache.emplace(std::move(key), result);
+  return result;
+}
+
 std::string graphml_witnesst::convert_assign_rec(
   const irep_idt &identifier,
   const code_assignt &assign)
 {
-#ifdef USE_DSTRING
-  const auto cit = cache.find({identifier.get_no(), &assign.read()});
-#else
-  const auto cit =
-    cache.find({get_string_container()[id2string(identifier)], &assign.read()});
-#endif
+  const auto cit = cache.find({identifier, assign});
   if(cit != cache.end())
     return cit->second;
 
@@ -194,7 +201,7 @@ std::string graphml_witnesst::convert_assign_rec(
 
     exprt clean_lhs = assign.lhs();
     remove_l0_l1(clean_lhs);
-    std::string lhs = expr_to_string(ns, identifier, clean_lhs);
+    std::string lhs = convert_expr(identifier, clean_lhs);
 
     if(
       lhs.find("#return_value") != std::string::npos ||
@@ -204,15 +211,10 @@ std::string graphml_witnesst::convert_assign_rec(
       lhs="\\result";
     }
 
-    result = lhs + " = " + expr_to_string(ns, identifier, clean_rhs) + ";";
+    result = lhs + " = " + convert_expr(identifier, clean_rhs) + ";";
   }
 
-#ifdef USE_DSTRING
-  cache.insert({{identifier.get_no(), &assign.read()}, result});
-#else
-  cache.insert(
-    {{get_string_container()[id2string(identifier)], &assign.read()}, result});
-#endif
+  cache.emplace(cache_keyt{identifier, assign}, result);
   return result;
 }
 
@@ -324,8 +326,8 @@ void graphml_witnesst::operator()(const goto_tracet &goto_trace)
         data.set_attribute("key", "enterFunction");
         data.data = "main";
       }
-      graphml[*std::next(it)].in[*it].xml_node = edge;
-      graphml[*it].out[*std::next(it)].xml_node = edge;
+      graphml.add_edge(*it, *std::next(it));
+      graphml[*it].out[*std::next(it)].xml_node = std::move(edge);
     }
 
     // we do not provide any further details as CPAchecker does not seem to
@@ -488,8 +490,8 @@ void graphml_witnesst::operator()(const goto_tracet &goto_trace)
       {
       }
 
-      graphml[to].in[from].xml_node = edge;
-      graphml[from].out[to].xml_node = edge;
+      graphml.add_edge(from, to);
+      graphml[from].out[to].xml_node = std::move(edge);
 
       break;
     }
@@ -639,8 +641,8 @@ void graphml_witnesst::operator()(const symex_target_equationt &equation)
         graphml[to].invariant_scope = id2string(it->source.function_id);
       }
 
-      graphml[to].in[from].xml_node = edge;
-      graphml[from].out[to].xml_node = edge;
+      graphml.add_edge(from, to);
+      graphml[from].out[to].xml_node = std::move(edge);
 
       break;
     }
@@ -42,6 +42,7 @@ protected:
   std::string convert_assign_rec(
     const irep_idt &identifier,
     const code_assignt &assign);
+  std::string convert_expr(const irep_idt &identifier, const exprt &expr);
 
   template <typename T>
   static void hash_combine(std::size_t &seed, const T &v)
@@ -50,22 +51,24 @@ protected:
     seed ^= hasher(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
   }
 
-  template <typename S, typename T>
-  struct pair_hash // NOLINT(readability/identifiers)
+  /// Conversions are cached by content rather than by address: traces
+  /// assign the same values to the same objects over and over again, and
+  /// the keys keep the expressions alive, so that no entry is ever looked up
+  /// for a different expression that happens to reuse the memory.
+  typedef std::pair<irep_idt, exprt> cache_keyt;
+
+  struct cache_key_hash // NOLINT(readability/identifiers)
   {
-    std::size_t operator()(const std::pair<S, T> &v) const
+    std::size_t operator()(const cache_keyt &key) const
     {
       std::size_t seed = 0;
-      hash_combine(seed, v.first);
-      hash_combine(seed, v.second);
+      hash_combine(seed, key.first);
+      hash_combine(seed, irep_hash()(key.second));
       return seed;
     }
   };
-  std::unordered_map<
-    std::pair<unsigned int, const irept::dt *>,
-    std::string,
-    pair_hash<unsigned int, const irept::dt *>>
-    cache;
+  std::unordered_map<cache_keyt, std::string, cache_key_hash> cache;
+  std::unordered_map<cache_keyt, std::string, cache_key_hash> expr_cache;
 };
 
 #endif // CPROVER_GOTO_PROGRAMS_GRAPHML_WITNESS_H
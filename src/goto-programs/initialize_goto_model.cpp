@@ -18,6 +18,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/message.h>
 #include <util/object_factory_parameters.h>
 #include <util/options.h>
+#include <util/profiler.h>
 #include <util/unicode.h>
 
 #include <langapi/mode.h>
@@ -117,6 +118,8 @@ goto_modelt initialize_goto_model(
 
       msg.status() << "Parsing " << filename << messaget::eom;
 
+      profile_scopet parse_scope("parse", filename);
+
       if(language.parse(infile, filename))
       {
         throw invalid_source_file_exceptiont("PARSING ERROR");
@@ -127,6 +130,8 @@ goto_modelt initialize_goto_model(
 
     msg.status() << "Converting" << messaget::eom;
 
+    profile_scopet typecheck_scope("typecheck", "all");
+
     if(language_files.typecheck(goto_model.symbol_table))
     {
       throw invalid_source_file_exceptiont("CONVERSION ERROR");
@@ -187,10 +192,13 @@ goto_modelt initialize_goto_model(
 
   msg.status() << "Generating GOTO Program" << messaget::eom;
 
-  goto_convert(
-    goto_model.symbol_table,
-    goto_model.goto_functions,
-    message_handler);
+  {
+    profile_scopet goto_convert_scope("goto-convert", "all");
+    goto_convert(
+      goto_model.symbol_table,
+      goto_model.goto_functions,
+      message_handler);
+  }
 
   if(options.is_set("validate-goto-model"))
   {
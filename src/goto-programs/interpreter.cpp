@@ -974,11 +974,56 @@ bool interpretert::unbounded_size(const typet &type)
   return false;
 }
 
-/// Retrieves the actual size of the provided structured type. Unbounded objects
-/// get allocated 2^32 address space each (of a 2^64 sized space).
+/// Checks whether the size of \p type is independent of the state of the
+/// program, i.e., it does not contain variable length arrays.
+bool interpretert::has_constant_size(const typet &type)
+{
+  if(type.id()==ID_array)
+  {
+    const exprt &size=to_array_type(type).size();
+    return (size.is_constant() || size.id()==ID_infinity) &&
+           has_constant_size(type.subtype());
+  }
+  else if(type.id()==ID_struct || type.id()==ID_union)
+  {
+    for(const auto &comp : to_struct_union_type(type).components())
+    {
+      if(comp.type().id()!=ID_code && !has_constant_size(comp.type()))
+        return false;
+    }
+    return true;
+  }
+  else if(type.id() == ID_struct_tag)
+  {
+    return has_constant_size(ns.follow_tag(to_struct_tag_type(type)));
+  }
+
+  return true;
+}
+
+/// Retrieves the actual size of the provided structured type, see
+/// \ref compute_size. Sizes that do not depend on the state of the program
+/// are cached.
 /// \param type: a structured type
 /// \return Size of the given type
 mp_integer interpretert::get_size(const typet &type)
+{
+  const auto entry=type_sizes.find(type);
+  if(entry!=type_sizes.end())
+    return entry->second;
+
+  const mp_integer size=compute_size(type);
+  if(has_constant_size(type))
+    type_sizes.emplace(type, size);
+
+  return size;
+}
+
+/// Computes the actual size of the provided structured type. Unbounded objects
+/// get allocated 2^32 address space each (of a 2^64 sized space).
+/// \param type: a structured type
+/// \return Size of the given type
+mp_integer interpretert::compute_size(const typet &type)
 {
   if(unbounded_size(type))
     return mp_integer(2) << 32;
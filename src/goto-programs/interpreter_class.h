@@ -13,6 +13,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_GOTO_PROGRAMS_INTERPRETER_CLASS_H
 
 #include <stack>
+#include <unordered_map>
 
 #include <util/arith_tools.h>
 #include <util/invariant.h>
@@ -195,7 +196,15 @@ protected:
   mp_integer build_memory_map(const symbol_exprt &symbol_expr);
   typet concretize_type(const typet &type);
   bool unbounded_size(const typet &);
+  bool has_constant_size(const typet &);
   mp_integer get_size(const typet &type);
+  mp_integer compute_size(const typet &type);
+
+  // Sizes of types that do not depend on the state of the program, and the
+  // values of scalar constants, such that repeatedly executed instructions
+  // don't re-compute them
+  std::unordered_map<typet, mp_integer, irep_hash> type_sizes;
+  std::unordered_map<exprt, mp_integer, irep_hash> constant_values;
 
   DEPRECATED("use the object_type version instead")
   struct_typet::componentt get_component(
@@ -316,6 +316,13 @@ void interpretert::evaluate(
 {
   if(expr.id()==ID_constant)
   {
+    const auto cached=constant_values.find(expr);
+    if(cached!=constant_values.end())
+    {
+      dest.push_back(cached->second);
+      return;
+    }
+
     if(expr.type().id()==ID_struct)
     {
       dest.reserve(numeric_cast_v<std::size_t>(get_size(expr.type())));
@@ -378,21 +385,24 @@ void interpretert::evaluate(
     {
       ieee_floatt f;
       f.from_expr(to_constant_expr(expr));
-      dest.push_back(f.pack());
+      dest.push_back(constant_values.emplace(expr, f.pack()).first->second);
       return;
     }
     else if(expr.type().id()==ID_fixedbv)
     {
       fixedbvt f;
       f.from_expr(to_constant_expr(expr));
-      dest.push_back(f.get_value());
+      dest.push_back(
+        constant_values.emplace(expr, f.get_value()).first->second);
       return;
     }
     else if(expr.type().id()==ID_c_bool)
     {
       const irep_idt &value=to_constant_expr(expr).get_value();
       const auto width = to_c_bool_type(expr.type()).get_width();
-      dest.push_back(bvrep2integer(value, width, false));
+      dest.push_back(
+        constant_values.emplace(expr, bvrep2integer(value, width, false))
+          .first->second);
       return;
     }
     else if(expr.type().id()==ID_bool)
@@ -413,7 +423,7 @@ void interpretert::evaluate(
     {
       if(const auto i = numeric_cast<mp_integer>(expr))
       {
-        dest.push_back(*i);
+        dest.push_back(constant_values.emplace(expr, *i).first->second);
         return;
       }
     }
@@ -10,6 +10,7 @@
 
 #include "goto_functions.h"
 #include "goto_convert_functions.h"
+#include "read_bin_goto_object.h"
 
 #include <langapi/language_file.h>
 #include <util/journalling_symbol_table.h>
@@ -74,6 +75,7 @@ private:
   mutable std::unordered_set<irep_idt> processed_functions;
 
   language_filest &language_files;
+  lazy_goto_binary_functionst &binary_functions;
   symbol_tablet &symbol_table;
   const post_process_functiont post_process_function;
   const can_generate_function_bodyt driver_program_can_generate_function_body;
@@ -85,6 +87,7 @@ public:
   lazy_goto_functions_mapt(
     underlying_mapt &goto_functions,
     language_filest &language_files,
+    lazy_goto_binary_functionst &binary_functions,
     symbol_tablet &symbol_table,
     post_process_functiont post_process_function,
     can_generate_function_bodyt driver_program_can_generate_function_body,
@@ -92,6 +95,7 @@ public:
     message_handlert &message_handler)
   : goto_functions(goto_functions),
     language_files(language_files),
+    binary_functions(binary_functions),
     symbol_table(symbol_table),
     post_process_function(post_process_function),
     driver_program_can_generate_function_body(
@@ -127,6 +131,7 @@ public:
   {
     return
       language_files.can_convert_lazy_method(name) ||
+      binary_functions.has_function(name) ||
       driver_program_can_generate_function_body(name);
   }
 
@@ -182,6 +187,14 @@ private:
 
     goto_functiont function;
 
+    // Bodies from a goto binary are used as they are, just like functions
+    // that were read eagerly:
+    if(binary_functions.has_function(name))
+    {
+      binary_functions.load(name, function_symbol_table, function);
+      return *goto_functions.emplace(name, std::move(function)).first;
+    }
+
     // First chance: see if the driver program wants to provide a replacement:
     bool body_provided =
       driver_program_generate_function_body(
@@ -31,6 +31,7 @@ lazy_goto_modelt::lazy_goto_modelt(
     goto_functions(
       goto_model->goto_functions.function_map,
       language_files,
+      binary_functions,
       symbol_table,
       [this] (
         const irep_idt &function_name,
@@ -61,9 +62,11 @@ lazy_goto_modelt::lazy_goto_modelt(
 lazy_goto_modelt::lazy_goto_modelt(lazy_goto_modelt &&other)
   : goto_model(std::move(other.goto_model)),
     symbol_table(goto_model->symbol_table),
+    binary_functions(std::move(other.binary_functions)),
     goto_functions(
       goto_model->goto_functions.function_map,
       language_files,
+      binary_functions,
       symbol_table,
       [this] (
         const irep_idt &function_name,
@@ -185,7 +188,15 @@ void lazy_goto_modelt::initialize(
   {
     msg.status() << "Reading GOTO program from file" << messaget::eom;
 
-    if(read_object_and_link(file, *goto_model, message_handler))
+    // A single goto binary does not need to be linked, hence the bodies of
+    // its functions can be read when they are first requested.
+    const bool read_failed =
+      binaries.size() == 1 && sources.empty()
+        ? read_object_lazily(
+            file, *goto_model, binary_functions, message_handler)
+        : read_object_and_link(file, *goto_model, message_handler);
+
+    if(read_failed)
     {
       source_locationt source_location;
       source_location.set_file(file);
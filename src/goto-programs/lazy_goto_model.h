@@ -130,6 +130,7 @@ public:
   lazy_goto_modelt &operator=(lazy_goto_modelt &&other)
   {
     goto_model = std::move(other.goto_model);
+    binary_functions = std::move(other.binary_functions);
     language_files = std::move(other.language_files);
     return *this;
   }
@@ -263,6 +264,8 @@ public:
   symbol_tablet &symbol_table;
 
 private:
+  /// Function bodies of an indexed goto binary that have not been read yet
+  lazy_goto_binary_functionst binary_functions;
   const lazy_goto_functions_mapt goto_functions;
   language_filest language_files;
 
@@ -13,24 +13,27 @@ Date: June 2006
 
 #include "read_bin_goto_object.h"
 
-#include <util/namespace.h>
+#include <util/exception_utils.h>
+#include <util/irep_serialization.h>
+#include <util/make_unique.h>
 #include <util/message.h>
+#include <util/namespace.h>
 #include <util/symbol_table.h>
-#include <util/irep_serialization.h>
+#include <util/unicode.h>
 
 #include "goto_functions.h"
 #include "write_goto_binary.h"
 
-/// read goto binary format
+/// read the symbol table of a goto binary
 /// \par parameters: input stream, symbol_table, functions
-/// \return true on error, false otherwise
-static bool read_bin_goto_object(
+static void read_bin_goto_symbols(
   std::istream &in,
   symbol_tablet &symbol_table,
   goto_functionst &functions,
   irep_serializationt &irepconverter)
 {
   std::size_t count = irepconverter.read_gb_word(in); // # of symbols
+  symbol_table.reserve(symbol_table.symbols.size() + count);
 
   for(std::size_t i=0; i<count; i++)
   {
@@ -80,93 +83,125 @@ static bool read_bin_goto_object(
       entry.first->second.set_parameter_identifiers(code_type);
     }
 
-    symbol_table.add(sym);
+    symbol_table.insert(std::move(sym));
   }
+}
 
-  count=irepconverter.read_gb_word(in); // # of functions
+/// read the instructions of a function body
+/// \par parameters: input stream, function, irep converter
+/// \return true if the function is marked as hidden
+static bool read_bin_goto_function(
+  std::istream &in,
+  goto_functionst::goto_functiont &f,
+  irep_serializationt &irepconverter)
+{
+  typedef std::map<goto_programt::targett, std::list<unsigned> > target_mapt;
+  target_mapt target_map;
+  typedef std::map<unsigned, goto_programt::targett> rev_target_mapt;
+  rev_target_mapt rev_target_map;
 
-  for(std::size_t fct_index = 0; fct_index < count; ++fct_index)
+  bool hidden=false;
+
+  std::size_t ins_count = irepconverter.read_gb_word(in); // # of instructions
+  for(std::size_t ins_index = 0; ins_index < ins_count; ++ins_index)
   {
-    irep_idt fname=irepconverter.read_gb_string(in);
-    goto_functionst::goto_functiont &f = functions.function_map[fname];
+    goto_programt::targett itarget = f.body.add_instruction();
+    goto_programt::instructiont &instruction=*itarget;
 
-    typedef std::map<goto_programt::targett, std::list<unsigned> > target_mapt;
-    target_mapt target_map;
-    typedef std::map<unsigned, goto_programt::targett> rev_target_mapt;
-    rev_target_mapt rev_target_map;
+    instruction.code =
+      static_cast<const codet &>(irepconverter.reference_convert(in));
+    instruction.source_location = static_cast<const source_locationt &>(
+      irepconverter.reference_convert(in));
+    instruction.type = (goto_program_instruction_typet)
+                            irepconverter.read_gb_word(in);
+    instruction.guard =
+      static_cast<const exprt &>(irepconverter.reference_convert(in));
+    instruction.target_number = irepconverter.read_gb_word(in);
+    if(instruction.is_target() &&
+       rev_target_map.insert(
+         rev_target_map.end(),
+         std::make_pair(instruction.target_number, itarget))->second!=itarget)
+      UNREACHABLE;
+
+    std::size_t t_count = irepconverter.read_gb_word(in); // # of targets
+    for(std::size_t i=0; i<t_count; i++)
+      // just save the target numbers
+      target_map[itarget].push_back(irepconverter.read_gb_word(in));
+
+    std::size_t l_count = irepconverter.read_gb_word(in); // # of labels
+
+    for(std::size_t i=0; i<l_count; i++)
+    {
+      irep_idt label=irepconverter.read_string_ref(in);
+      instruction.labels.push_back(label);
+      if(label == CPROVER_PREFIX "HIDE")
+        hidden=true;
+      // The above info is normally in the type of the goto_functiont object,
+      // which should likely be stored in the binary.
+    }
+  }
 
-    bool hidden=false;
+  // Resolve targets
+  for(target_mapt::iterator tit = target_map.begin();
+      tit!=target_map.end();
+      tit++)
+  {
+    goto_programt::targett ins = tit->first;
 
-    std::size_t ins_count = irepconverter.read_gb_word(in); // # of instructions
-    for(std::size_t ins_index = 0; ins_index < ins_count; ++ins_index)
+    for(std::list<unsigned>::iterator nit = tit->second.begin();
+        nit!=tit->second.end();
+        nit++)
     {
-      goto_programt::targett itarget = f.body.add_instruction();
-      goto_programt::instructiont &instruction=*itarget;
-
-      instruction.code =
-        static_cast<const codet &>(irepconverter.reference_convert(in));
-      instruction.source_location = static_cast<const source_locationt &>(
-        irepconverter.reference_convert(in));
-      instruction.type = (goto_program_instruction_typet)
-                              irepconverter.read_gb_word(in);
-      instruction.guard =
-        static_cast<const exprt &>(irepconverter.reference_convert(in));
-      instruction.target_number = irepconverter.read_gb_word(in);
-      if(instruction.is_target() &&
-         rev_target_map.insert(
-           rev_target_map.end(),
-           std::make_pair(instruction.target_number, itarget))->second!=itarget)
-        UNREACHABLE;
-
-      std::size_t t_count = irepconverter.read_gb_word(in); // # of targets
-      for(std::size_t i=0; i<t_count; i++)
-        // just save the target numbers
-        target_map[itarget].push_back(irepconverter.read_gb_word(in));
-
-      std::size_t l_count = irepconverter.read_gb_word(in); // # of labels
-
-      for(std::size_t i=0; i<l_count; i++)
-      {
-        irep_idt label=irepconverter.read_string_ref(in);
-        instruction.labels.push_back(label);
-        if(label == CPROVER_PREFIX "HIDE")
-          hidden=true;
-        // The above info is normally in the type of the goto_functiont object,
-        // which should likely be stored in the binary.
-      }
+      unsigned n=*nit;
+      rev_target_mapt::const_iterator entry=rev_target_map.find(n);
+      INVARIANT(
+        entry != rev_target_map.end(),
+        "something from the target map should also be in the reverse target "
+        "map");
+      ins->targets.push_back(entry->second);
     }
+  }
 
-    // Resolve targets
-    for(target_mapt::iterator tit = target_map.begin();
-        tit!=target_map.end();
-        tit++)
-    {
-      goto_programt::targett ins = tit->first;
+  f.body.update();
 
-      for(std::list<unsigned>::iterator nit = tit->second.begin();
-          nit!=tit->second.end();
-          nit++)
-      {
-        unsigned n=*nit;
-        rev_target_mapt::const_iterator entry=rev_target_map.find(n);
-        INVARIANT(
-          entry != rev_target_map.end(),
-          "something from the target map should also be in the reverse target "
-          "map");
-        ins->targets.push_back(entry->second);
-      }
-    }
+  if(hidden)
+    f.make_hidden();
+
+  return hidden;
+}
+
+void read_goto_function_body(
+  std::istream &in,
+  goto_functionst::goto_functiont &function)
+{
+  function.body.clear();
 
-    f.body.update();
+  irep_serializationt::ireps_containert ic;
+  irep_serializationt irepconverter(ic);
+  read_bin_goto_function(in, function, irepconverter);
+}
 
-    if(hidden)
+/// read goto binary format, where all functions share one irep converter
+/// \par parameters: input stream, symbol_table, functions
+/// \return true on error, false otherwise
+static bool read_bin_goto_object_v5(
+  std::istream &in,
+  symbol_tablet &symbol_table,
+  goto_functionst &functions,
+  irep_serializationt &irepconverter)
+{
+  read_bin_goto_symbols(in, symbol_table, functions, irepconverter);
+
+  std::size_t count=irepconverter.read_gb_word(in); // # of functions
+
+  for(std::size_t fct_index = 0; fct_index < count; ++fct_index)
+  {
+    irep_idt fname=irepconverter.read_gb_string(in);
+    goto_functionst::goto_functiont &f = functions.function_map[fname];
+
+    if(read_bin_goto_function(in, f, irepconverter))
     {
-      f.make_hidden();
-      // can be removed with the next goto-binary version update as the
-      // information is guaranteed to be stored in the symbol table
-#if GOTO_BINARY_VERSION > 5
-#error This code should be removed
-#endif
+      // version 5 binaries may lack this information in the symbol table
       symbol_table.get_writeable_ref(fname).set_hidden();
     }
   }
@@ -176,18 +211,66 @@ static bool read_bin_goto_object(
   return false;
 }
 
-/// reads a goto binary file back into a symbol and a function table
-/// \par parameters: input stream, symbol table, functions
+/// read the index of the function bodies of an indexed goto binary
+/// \par parameters: input stream, irep converter
+/// \return names and sizes in bytes of the function bodies, in file order
+static std::vector<std::pair<irep_idt, std::size_t>>
+read_bin_goto_function_index(
+  std::istream &in,
+  irep_serializationt &irepconverter)
+{
+  std::size_t count=irepconverter.read_gb_word(in); // # of functions
+
+  std::vector<std::pair<irep_idt, std::size_t>> index;
+  index.reserve(count);
+
+  for(std::size_t fct_index = 0; fct_index < count; ++fct_index)
+  {
+    irep_idt fname=irepconverter.read_gb_string(in);
+    index.emplace_back(fname, irepconverter.read_gb_word(in));
+  }
+
+  return index;
+}
+
+/// read indexed goto binary format, where each function body can be read
+/// on its own
+/// \par parameters: input stream, symbol_table, functions
 /// \return true on error, false otherwise
-bool read_bin_goto_object(
+static bool read_bin_goto_object_v6(
   std::istream &in,
-  const std::string &filename,
   symbol_tablet &symbol_table,
   goto_functionst &functions,
-  message_handlert &message_handler)
+  irep_serializationt &irepconverter)
 {
-  messaget message(message_handler);
+  read_bin_goto_symbols(in, symbol_table, functions, irepconverter);
+
+  // Each function body is decoded with tables of its own. Clearing the
+  // tables instead of creating new ones keeps their memory.
+  irep_serializationt::ireps_containert ic;
+  irep_serializationt function_converter(ic);
+
+  for(const auto &entry : read_bin_goto_function_index(in, irepconverter))
+  {
+    function_converter.clear();
+    read_bin_goto_function(
+      in, functions.function_map[entry.first], function_converter);
+  }
 
+  functions.compute_location_numbers();
+
+  return false;
+}
+
+/// check the header of a goto binary and read its version
+/// \par parameters: input stream, file name, message, version
+/// \return true on error, false otherwise
+static bool read_bin_goto_header(
+  std::istream &in,
+  const std::string &filename,
+  messaget &message,
+  std::size_t &version)
+{
   {
     char hdr[4];
     hdr[0]=static_cast<char>(in.get());
@@ -225,32 +308,133 @@ bool read_bin_goto_object(
     }
   }
 
+  version=irep_serializationt::read_gb_word(in);
+
+  // version 5 lacks the function index, but can still be read
+  if(version < 5)
+  {
+    message.error() <<
+        "The input was compiled with an old version of "
+        "goto-cc; please recompile" << messaget::eom;
+    return true;
+  }
+  else if(version > GOTO_BINARY_VERSION)
+  {
+    message.error() <<
+        "The input was compiled with an unsupported version of "
+        "goto-cc; please recompile" << messaget::eom;
+    return true;
+  }
+
+  return false;
+}
+
+/// reads a goto binary file back into a symbol and a function table
+/// \par parameters: input stream, symbol table, functions
+/// \return true on error, false otherwise
+bool read_bin_goto_object(
+  std::istream &in,
+  const std::string &filename,
+  symbol_tablet &symbol_table,
+  goto_functionst &functions,
+  message_handlert &message_handler)
+{
+  messaget message(message_handler);
+
+  std::size_t version;
+  if(read_bin_goto_header(in, filename, message, version))
+    return true;
+
   irep_serializationt::ireps_containert ic;
   irep_serializationt irepconverter(ic);
   // symbol_serializationt symbolconverter(ic);
 
+  if(version == GOTO_BINARY_VERSION)
+    return read_bin_goto_object_v6(in, symbol_table, functions, irepconverter);
+  else
+    return read_bin_goto_object_v5(in, symbol_table, functions, irepconverter);
+}
+
+bool read_bin_goto_object(
+  std::istream &in,
+  const std::string &filename,
+  symbol_tablet &symbol_table,
+  goto_functionst &functions,
+  lazy_goto_binary_functionst &lazy_functions,
+  message_handlert &message_handler)
+{
+  messaget message(message_handler);
+
+  std::size_t version;
+  if(read_bin_goto_header(in, filename, message, version))
+    return true;
+
+  irep_serializationt::ireps_containert ic;
+  irep_serializationt irepconverter(ic);
+
+  if(version != GOTO_BINARY_VERSION)
   {
-    std::size_t version=irepconverter.read_gb_word(in);
+    // function bodies can only be read on their own from indexed binaries
+    return read_bin_goto_object_v5(in, symbol_table, functions, irepconverter);
+  }
 
-    if(version < GOTO_BINARY_VERSION)
-    {
-      message.error() <<
-          "The input was compiled with an old version of "
-          "goto-cc; please recompile" << messaget::eom;
-      return true;
-    }
-    else if(version == GOTO_BINARY_VERSION)
-    {
-      return read_bin_goto_object(in, symbol_table, functions, irepconverter);
-    }
-    else
-    {
-      message.error() <<
-          "The input was compiled with an unsupported version of "
-          "goto-cc; please recompile" << messaget::eom;
-      return true;
-    }
+  read_bin_goto_symbols(in, symbol_table, functions, irepconverter);
+
+  const auto index = read_bin_goto_function_index(in, irepconverter);
+
+  std::streamoff offset = in.tellg();
+  if(offset < 0)
+  {
+    message.error() << "failed to determine the position in '" << filename
+                    << "'" << messaget::eom;
+    return true;
+  }
+
+  lazy_functions.filename = filename;
+  lazy_functions.in.reset();
+
+  for(const auto &entry : index)
+  {
+    // the body is provided when it is first requested
+    functions.function_map.erase(entry.first);
+    lazy_functions.offsets[entry.first] = offset;
+    offset += static_cast<std::streamoff>(entry.second);
   }
 
   return false;
 }
+
+void lazy_goto_binary_functionst::load(
+  const irep_idt &function_name,
+  const symbol_table_baset &symbol_table,
+  goto_functionst::goto_functiont &function)
+{
+  const auto entry = offsets.find(function_name);
+  PRECONDITION(entry != offsets.end());
+
+  if(!in)
+  {
+#ifdef _MSC_VER
+    in = util_make_unique<std::ifstream>(widen(filename), std::ios::binary);
+#else
+    in = util_make_unique<std::ifstream>(filename, std::ios::binary);
+#endif
+  }
+
+  in->clear();
+  in->seekg(entry->second);
+  if(!*in)
+  {
+    throw system_exceptiont(
+      "failed to read function '" + id2string(function_name) + "' from '" +
+      filename + "'");
+  }
+
+  const code_typet &code_type =
+    to_code_type(symbol_table.lookup_ref(function_name).type);
+  function.type = code_type;
+  function.set_parameter_identifiers(code_type);
+
+  irep_serializationt irepconverter(ireps_container);
+  read_bin_goto_function(*in, function, irepconverter);
+}
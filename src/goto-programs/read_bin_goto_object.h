@@ -14,11 +14,17 @@ Date: May 2007
 #ifndef CPROVER_GOTO_PROGRAMS_READ_BIN_GOTO_OBJECT_H
 #define CPROVER_GOTO_PROGRAMS_READ_BIN_GOTO_OBJECT_H
 
-#include <iosfwd>
+#include <fstream>
+#include <memory>
 #include <string>
+#include <unordered_map>
 
+#include <util/irep_serialization.h>
+
+#include "goto_functions.h"
+
+class symbol_table_baset;
 class symbol_tablet;
-class goto_functionst;
 class message_handlert;
 
 bool read_bin_goto_object(
@@ -28,4 +34,61 @@ bool read_bin_goto_object(
   goto_functionst &goto_functions,
   message_handlert &message_handler);
 
+/// Replace the body of \p function by one written with
+/// \ref write_goto_function_body
+void read_goto_function_body(
+  std::istream &in,
+  goto_functionst::goto_functiont &function);
+
+/// The bodies of the functions of an indexed goto binary, which are read
+/// from the file when they are requested
+class lazy_goto_binary_functionst
+{
+public:
+  /// Return true if the body of \p function_name can be read
+  bool has_function(const irep_idt &function_name) const
+  {
+    return offsets.find(function_name) != offsets.end();
+  }
+
+  /// Read the body of \p function_name into \p function, whose type is
+  /// taken from \p symbol_table. Throws \ref system_exceptiont if the file
+  /// cannot be read.
+  void load(
+    const irep_idt &function_name,
+    const symbol_table_baset &symbol_table,
+    goto_functionst::goto_functiont &function);
+
+protected:
+  std::string filename;
+  std::unique_ptr<std::ifstream> in;
+
+  /// Position of each function body in \ref filename
+  std::unordered_map<irep_idt, std::streamoff> offsets;
+
+  /// Tables for decoding a function body, which are kept to reuse their
+  /// memory for the next body
+  irep_serializationt::ireps_containert ireps_container;
+
+  friend bool read_bin_goto_object(
+    std::istream &,
+    const std::string &,
+    symbol_tablet &,
+    goto_functionst &,
+    lazy_goto_binary_functionst &,
+    message_handlert &);
+};
+
+/// Like \ref read_bin_goto_object, but the function bodies of an indexed
+/// goto binary are not read. Instead, \p lazy_functions is set up to read
+/// them from \p filename on demand, and \p goto_functions has no entries for
+/// them. Binaries of older versions are read completely.
+bool read_bin_goto_object(
+  std::istream &in,
+  const std::string &filename,
+  symbol_tablet &symbol_table,
+  goto_functionst &goto_functions,
+  lazy_goto_binary_functionst &lazy_functions,
+  message_handlert &message_handler);
+
 #endif // CPROVER_GOTO_PROGRAMS_READ_BIN_GOTO_OBJECT_H
@@ -19,6 +19,7 @@ Author:
 #include <util/tempfile.h>
 #include <util/rename_symbol.h>
 #include <util/config.h>
+#include <util/invariant.h>
 
 #include "goto_model.h"
 #include "link_goto_model.h"
@@ -325,3 +326,54 @@ bool read_object_and_link(
 
   return result;
 }
+
+/// \brief reads an object file into an empty goto model, leaving the
+///   function bodies of an indexed goto binary to be read on demand, and
+///   updates config
+/// \param file_name: file name of the goto binary
+/// \param dest: the goto model returned, which must be empty
+/// \param lazy_functions: provides the function bodies that were not read
+/// \param message_handler: for diagnostics
+/// \return true on error, false otherwise
+bool read_object_lazily(
+  const std::string &file_name,
+  goto_modelt &dest,
+  lazy_goto_binary_functionst &lazy_functions,
+  message_handlert &message_handler)
+{
+  PRECONDITION(dest.symbol_table.symbols.empty());
+
+  #ifdef _MSC_VER
+  std::ifstream in(widen(file_name), std::ios::binary);
+  #else
+  std::ifstream in(file_name, std::ios::binary);
+  #endif
+
+  char hdr[4];
+  if(!in || !in.read(hdr, 4) ||
+     !(hdr[0] == 0x7f && hdr[1] == 'G' && hdr[2] == 'B' && hdr[3] == 'F'))
+  {
+    // only plain goto binaries are read lazily
+    return read_object_and_link(file_name, dest, message_handler);
+  }
+
+  messaget(message_handler).statistics() << "Reading: "
+                                         << file_name << messaget::eom;
+
+  in.seekg(0);
+
+  if(read_bin_goto_object(
+       in,
+       file_name,
+       dest.symbol_table,
+       dest.goto_functions,
+       lazy_functions,
+       message_handler))
+  {
+    return true;
+  }
+
+  config.set_from_symbol_table(dest.symbol_table);
+
+  return false;
+}
@@ -19,6 +19,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 class goto_functionst;
 class goto_modelt;
+class lazy_goto_binary_functionst;
 class message_handlert;
 class symbol_tablet;
 
@@ -38,4 +39,10 @@ bool read_object_and_link(
   goto_modelt &,
   message_handlert &);
 
+bool read_object_lazily(
+  const std::string &file_name,
+  goto_modelt &,
+  lazy_goto_binary_functionst &,
+  message_handlert &);
+
 #endif // CPROVER_GOTO_PROGRAMS_READ_GOTO_BINARY_H
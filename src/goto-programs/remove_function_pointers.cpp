@@ -566,3 +566,52 @@ void remove_function_pointers(message_handlert &_message_handler,
     add_safety_assertion,
     only_remove_const_fps);
 }
+
+void remove_function_pointers(
+  message_handlert &_message_handler,
+  goto_modelt &goto_model,
+  const function_pointer_targetst &targets,
+  bool add_safety_assertion)
+{
+  remove_function_pointerst rfp(
+    _message_handler,
+    goto_model.symbol_table,
+    add_safety_assertion,
+    true,
+    goto_model.goto_functions);
+
+  bool did_something = false;
+
+  for(auto &function_pair : goto_model.goto_functions.function_map)
+  {
+    goto_programt &goto_program = function_pair.second.body;
+    bool did_something_in_function = false;
+
+    Forall_goto_program_instructions(target, goto_program)
+    {
+      if(
+        !target->is_function_call() ||
+        target->get_function_call().function().id() != ID_dereference)
+      {
+        continue;
+      }
+
+      const auto targets_it = targets.find(target);
+      if(targets_it == targets.end())
+        continue;
+
+      rfp.remove_function_pointer(
+        goto_program, function_pair.first, target, targets_it->second);
+      did_something_in_function = true;
+    }
+
+    if(did_something_in_function)
+    {
+      remove_skip(goto_program);
+      did_something = true;
+    }
+  }
+
+  if(did_something)
+    goto_model.goto_functions.compute_location_numbers();
+}
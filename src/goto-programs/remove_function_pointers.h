@@ -14,10 +14,15 @@ Date: June 2003
 #ifndef CPROVER_GOTO_PROGRAMS_REMOVE_FUNCTION_POINTERS_H
 #define CPROVER_GOTO_PROGRAMS_REMOVE_FUNCTION_POINTERS_H
 
+#include <map>
+#include <unordered_set>
+
 #include <util/irep.h>
+#include <util/std_expr.h>
+
+#include "goto_program.h"
 
 class goto_functionst;
-class goto_programt;
 class goto_modelt;
 class message_handlert;
 class symbol_tablet;
@@ -46,4 +51,19 @@ bool remove_function_pointers(
   bool add_safety_assertion,
   bool only_remove_const_fps = false);
 
+/// Maps calls through function pointers to the functions they may call
+typedef std::map<
+  goto_programt::const_targett,
+  std::unordered_set<symbol_exprt, irep_hash>>
+  function_pointer_targetst;
+
+/// Replace the calls through function pointers that \p targets has an entry
+/// for by a case split over the functions given there. Other calls through
+/// function pointers are left unchanged.
+void remove_function_pointers(
+  message_handlert &_message_handler,
+  goto_modelt &goto_model,
+  const function_pointer_targetst &targets,
+  bool add_safety_assertion);
+
 #endif // CPROVER_GOTO_PROGRAMS_REMOVE_FUNCTION_POINTERS_H
@@ -11,30 +11,34 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "remove_unreachable.h"
 
-#include <set>
 #include <stack>
+#include <vector>
 
+#include "frozen_goto_program.h"
 #include "goto_functions.h"
 
 /// remove unreachable code
 void remove_unreachable(goto_programt &goto_program)
 {
-  std::set<goto_programt::targett> reachable;
-  std::stack<goto_programt::targett> working;
+  if(goto_program.instructions.empty())
+    return;
 
-  working.push(goto_program.instructions.begin());
+  const frozen_goto_programt frozen(goto_program);
+  std::vector<bool> reachable(frozen.size(), false);
+  std::stack<std::size_t> working;
+
+  working.push(0);
 
   while(!working.empty())
   {
-    goto_programt::targett t=working.top();
+    const std::size_t index = working.top();
     working.pop();
 
-    if(reachable.find(t)==reachable.end() &&
-       t!=goto_program.instructions.end())
+    if(!reachable[index])
     {
-      reachable.insert(t);
+      reachable[index] = true;
 
-      for(const auto &succ : goto_program.get_successors(t))
+      for(const auto succ : frozen.successors(index))
         working.push(succ);
     }
   }
@@ -42,11 +46,11 @@ void remove_unreachable(goto_programt &goto_program)
   // make all unreachable code a skip
   // unless it's an 'end_function'
   bool did_something = false;
+  std::size_t index = 0;
 
   Forall_goto_program_instructions(it, goto_program)
   {
-    if(reachable.find(it)==reachable.end() &&
-       !it->is_end_function())
+    if(!reachable[index++] && !it->is_end_function())
     {
       it->turn_into_skip();
       did_something = true;
@@ -13,13 +13,53 @@ Author: CM Wintersteiger
 
 #include <util/message.h>
 
+#include "global_reachability.h"
 #include "goto_model.h"
 
+static void report_and_remove(
+  goto_functionst &functions,
+  const std::list<goto_functionst::function_mapt::iterator> &unused_functions,
+  std::size_t used_functions,
+  message_handlert &message_handler)
+{
+  messaget message(message_handler);
+
+  if(!unused_functions.empty())
+  {
+    message.statistics()
+      << "Dropping " << unused_functions.size() << " of " <<
+      functions.function_map.size() << " functions (" <<
+      used_functions << " used)" << messaget::eom;
+  }
+
+  for(const auto &f : unused_functions)
+    functions.function_map.erase(f);
+}
+
 void remove_unused_functions(
   goto_modelt &goto_model,
   message_handlert &message_handler)
 {
-  remove_unused_functions(goto_model.goto_functions, message_handler);
+  // With the symbol table at hand, functions only used through their
+  // address are kept as well.
+  goto_functionst &functions = goto_model.goto_functions;
+  const global_reachabilityt reachability(
+    goto_model.symbol_table, functions, {goto_functionst::entry_point()});
+
+  std::size_t used_functions = 0;
+  std::list<goto_functionst::function_mapt::iterator> unused_functions;
+  for(auto it = functions.function_map.begin();
+      it != functions.function_map.end();
+      it++)
+  {
+    if(reachability.is_reachable(it->first))
+      ++used_functions;
+    else
+      unused_functions.push_back(it);
+  }
+
+  report_and_remove(
+    functions, unused_functions, used_functions, message_handler);
 }
 
 void remove_unused_functions(
@@ -40,18 +80,8 @@ void remove_unused_functions(
       unused_functions.push_back(it);
   }
 
-  messaget message(message_handler);
-
-  if(!unused_functions.empty())
-  {
-    message.statistics()
-      << "Dropping " << unused_functions.size() << " of " <<
-      functions.function_map.size() << " functions (" <<
-      used_functions.size() << " used)" << messaget::eom;
-  }
-
-  for(const auto &f : unused_functions)
-    functions.function_map.erase(f);
+  report_and_remove(
+    functions, unused_functions, used_functions.size(), message_handler);
 }
 
 void find_used_functions(
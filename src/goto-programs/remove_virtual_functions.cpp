@@ -63,8 +63,10 @@ class remove_virtual_functionst
 public:
   remove_virtual_functionst(
     symbol_table_baset &_symbol_table,
-    const class_hierarchyt &_class_hierarchy)
+    const class_hierarchyt &_class_hierarchy,
+    const std::unordered_set<irep_idt> *_uninstantiated_classes = nullptr)
     : class_hierarchy(_class_hierarchy),
+      uninstantiated_classes(_uninstantiated_classes),
       symbol_table(_symbol_table),
       ns(symbol_table)
   {
@@ -78,6 +80,8 @@ public:
 
 private:
   const class_hierarchyt &class_hierarchy;
+  /// Classes known to have no instances, or null if unknown
+  const std::unordered_set<irep_idt> *uninstantiated_classes;
   symbol_table_baset &symbol_table;
   namespacet ns;
 
@@ -459,6 +463,37 @@ static goto_programt::targett replace_virtual_function_with_dispatch_table(
   return next_target;
 }
 
+/// Remove the entries of a dispatch table that test for classes of which
+/// there are no instances, or that call the same function as the last entry,
+/// which is called when no other entry matches. If this leaves only the last
+/// entry, the call can be made directly.
+/// \param [in,out] functions: dispatch table as built by
+///   \ref get_virtual_calleest::get_functions
+/// \param uninstantiated_classes: classes known to have no instances
+static void prune_dispatch_table(
+  dispatch_table_entriest &functions,
+  const std::unordered_set<irep_idt> &uninstantiated_classes)
+{
+  if(functions.empty())
+    return;
+
+  const optionalt<symbol_exprt> last_function_symbol =
+    functions.back().symbol_expr;
+
+  functions.erase(
+    std::remove_if(
+      functions.begin(),
+      std::prev(functions.end()),
+      [&](const dispatch_table_entryt &entry) {
+        return uninstantiated_classes.count(entry.class_id) != 0 ||
+               (entry.symbol_expr.has_value() ==
+                  last_function_symbol.has_value() &&
+                (!entry.symbol_expr.has_value() ||
+                 *entry.symbol_expr == *last_function_symbol));
+      }),
+    std::prev(functions.end()));
+}
+
 /// Replace specified virtual function call with a static call to its
 /// most derived implementation
 /// \param function_id: The identifier of the function we are currently
@@ -488,6 +523,9 @@ goto_programt::targett remove_virtual_functionst::remove_virtual_function(
   dispatch_table_entriest functions;
   get_callees.get_functions(function, functions);
 
+  if(uninstantiated_classes != nullptr)
+    prune_dispatch_table(functions, *uninstantiated_classes);
+
   return replace_virtual_function_with_dispatch_table(
     symbol_table,
     function_id,
@@ -815,6 +853,28 @@ void remove_virtual_functions(
     function.get_function_id(), function.get_goto_function().body);
 }
 
+/// Remove virtual function calls from the specified model function, leaving
+/// out of the dispatch tables the classes that are known to have no instances.
+/// Call sites with a single remaining target become direct calls.
+/// May change the location numbers in `function`.
+/// \param function: function from which virtual functions should be converted
+///   to explicit dispatch tables.
+/// \param class_hierarchy: class hierarchy derived from function.symbol_table
+///   This should already be populated (i.e. class_hierarchyt::operator() has
+///   already been called)
+/// \param uninstantiated_classes: classes of which there are no objects, for
+///   example as found by a rapid type analysis of the program
+void remove_virtual_functions(
+  goto_model_functiont &function,
+  const class_hierarchyt &class_hierarchy,
+  const std::unordered_set<irep_idt> &uninstantiated_classes)
+{
+  remove_virtual_functionst rvf(
+    function.get_symbol_table(), class_hierarchy, &uninstantiated_classes);
+  rvf.remove_virtual_functions(
+    function.get_function_id(), function.get_goto_function().body);
+}
+
 /// Replace virtual function call with a static function call
 /// Achieved by substituting a virtual function with its most derived
 /// implementation. If there's a type mismatch between implementation
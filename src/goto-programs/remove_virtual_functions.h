@@ -15,6 +15,8 @@ Date: April 2016
 #ifndef CPROVER_GOTO_PROGRAMS_REMOVE_VIRTUAL_FUNCTIONS_H
 #define CPROVER_GOTO_PROGRAMS_REMOVE_VIRTUAL_FUNCTIONS_H
 
+#include <unordered_set>
+
 #include <util/optional.h>
 #include <util/std_expr.h>
 
@@ -52,6 +54,11 @@ void remove_virtual_functions(
   goto_model_functiont &function,
   const class_hierarchyt &class_hierarchy);
 
+void remove_virtual_functions(
+  goto_model_functiont &function,
+  const class_hierarchyt &class_hierarchy,
+  const std::unordered_set<irep_idt> &uninstantiated_classes);
+
 /// Specifies remove_virtual_function's behaviour when the actual supplied
 /// parameter does not match any of the possible callee types
 enum class virtual_dispatch_fallback_actiont
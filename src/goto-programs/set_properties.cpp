@@ -12,6 +12,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "set_properties.h"
 
 #include <util/exception_utils.h>
+#include <util/invariant.h>
 
 #include <algorithm>
 #include <unordered_set>
@@ -117,6 +118,30 @@ void set_properties(
       "--property id");
 }
 
+void select_property_shard(
+  goto_modelt &goto_model,
+  std::size_t shard,
+  std::size_t shards)
+{
+  PRECONDITION(shard < shards);
+
+  std::size_t index = 0;
+
+  for(const auto &f : goto_model.goto_functions.sorted())
+  {
+    for(auto &instruction : f->second.body.instructions)
+    {
+      if(!instruction.is_assert())
+        continue;
+
+      if(index % shards != shard)
+        instruction.turn_into_skip();
+
+      ++index;
+    }
+  }
+}
+
 void label_properties(goto_functionst &goto_functions)
 {
   std::map<irep_idt, std::size_t> property_counters;
@@ -22,6 +22,16 @@ void set_properties(
   goto_modelt &goto_model,
   const std::list<std::string> &properties);
 
+/// Keep every \p shards-th property, starting with the one at (zero-based)
+/// position \p shard, and turn the other assertions into skips. Properties
+/// are ordered by the name of their function and their position within it,
+/// such that separate runs on the same goto model with all shards from 0 to
+/// \p shards - 1 partition the properties without having to list them first.
+void select_property_shard(
+  goto_modelt &goto_model,
+  std::size_t shard,
+  std::size_t shards);
+
 void make_assertions_false(goto_functionst &);
 void make_assertions_false(goto_modelt &);
 
@@ -43,7 +43,9 @@ void show_goto_functions(
   case ui_message_handlert::uit::JSON_UI:
   {
     show_goto_functions_jsont json_show_functions(ns, list_only);
-    msg.status() << json_show_functions.convert(goto_functions);
+    json_show_functions.convert(
+      goto_functions,
+      ui_message_handler.get_json_stream().push_back_stream_object());
   }
   break;
 
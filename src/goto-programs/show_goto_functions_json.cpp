@@ -15,6 +15,7 @@ Author: Thomas Kiley
 #include <sstream>
 
 #include <util/json_irep.h>
+#include <util/json_stream.h>
 #include <util/cprover_prefix.h>
 #include <util/prefix.h>
 
@@ -39,7 +40,6 @@ json_objectt show_goto_functions_jsont::convert(
   const goto_functionst &goto_functions)
 {
   json_arrayt json_functions;
-  const json_irept no_comments_irep_converter(false);
 
   const auto sorted = goto_functions.sorted();
 
@@ -48,76 +48,131 @@ json_objectt show_goto_functions_jsont::convert(
     const irep_idt &function_name = function_entry->first;
     const goto_functionst::goto_functiont &function = function_entry->second;
 
-    json_objectt &json_function=
-      json_functions.push_back(jsont()).make_object();
-    json_function["name"] = json_stringt(function_name);
-    json_function["isBodyAvailable"]=
-      jsont::json_boolean(function.body_available());
-    bool is_internal=
-      has_prefix(id2string(function_name), CPROVER_PREFIX) ||
-      has_prefix(id2string(function_name), "java::array[") ||
-      has_prefix(id2string(function_name), "java::org.cprover") ||
-      has_prefix(id2string(function_name), "java::java");
-    json_function["isInternal"]=jsont::json_boolean(is_internal);
-
-    if(list_only)
-      continue;
-
-    if(function.body_available())
-    {
-      json_arrayt json_instruction_array=json_arrayt();
+    json_objectt json_function = convert_function_header(function_entry);
 
+    if(!list_only && function.body_available())
+    {
+      json_arrayt json_instruction_array;
       for(const goto_programt::instructiont &instruction :
-        function.body.instructions)
+          function.body.instructions)
       {
-        json_objectt instruction_entry{
-          {"instructionId", json_stringt(instruction.to_string())}};
-
-        if(instruction.code.source_location().is_not_nil())
-        {
-          instruction_entry["sourceLocation"]=
-            json(instruction.code.source_location());
-        }
-
-        std::ostringstream instruction_builder;
-        function.body.output_instruction(
-          ns, function_name, instruction_builder, instruction);
-
-        instruction_entry["instruction"]=
-          json_stringt(instruction_builder.str());
-
-        if(!instruction.code.operands().empty())
-        {
-          json_arrayt operand_array;
-          for(const exprt &operand : instruction.code.operands())
-          {
-            json_objectt operand_object=
-              no_comments_irep_converter.convert_from_irep(
-                operand);
-            operand_array.push_back(operand_object);
-          }
-          instruction_entry["operands"] = std::move(operand_array);
-        }
-
-        if(!instruction.guard.is_true())
-        {
-          json_objectt guard_object=
-            no_comments_irep_converter.convert_from_irep(
-              instruction.guard);
-
-          instruction_entry["guard"] = std::move(guard_object);
-        }
-
-        json_instruction_array.push_back(std::move(instruction_entry));
+        json_instruction_array.push_back(
+          convert_instruction(function_name, function.body, instruction));
       }
 
       json_function["instructions"] = std::move(json_instruction_array);
     }
+
+    json_functions.push_back(std::move(json_function));
   }
 
   return json_objectt({{"functions", json_functions}});
 }
 
+/// Walks through all of the functions in the program and writes them to
+/// \p result as they are converted, without building the JSON object for
+/// the whole program first
+/// \param goto_functions: the goto functions that make up the program
+/// \param result: the JSON stream object to add the "functions" member to
+void show_goto_functions_jsont::convert(
+  const goto_functionst &goto_functions,
+  json_stream_objectt &result)
+{
+  json_stream_arrayt &json_functions =
+    result.push_back_stream_array("functions");
+
+  const auto sorted = goto_functions.sorted();
+
+  for(const auto &function_entry : sorted)
+  {
+    const irep_idt &function_name = function_entry->first;
+    const goto_functionst::goto_functiont &function = function_entry->second;
+
+    json_stream_objectt &json_function =
+      json_functions.push_back_stream_object();
+    for(const auto &entry : convert_function_header(function_entry))
+      json_function.push_back(entry.first, entry.second);
+
+    if(!list_only && function.body_available())
+    {
+      json_stream_arrayt &json_instruction_array =
+        json_function.push_back_stream_array("instructions");
+      for(const goto_programt::instructiont &instruction :
+          function.body.instructions)
+      {
+        json_instruction_array.push_back(
+          convert_instruction(function_name, function.body, instruction));
+      }
+    }
+  }
+}
+
+json_objectt show_goto_functions_jsont::convert_function_header(
+  const goto_functionst::function_mapt::const_iterator &function_entry)
+{
+  const irep_idt &function_name = function_entry->first;
+
+  bool is_internal=
+    has_prefix(id2string(function_name), CPROVER_PREFIX) ||
+    has_prefix(id2string(function_name), "java::array[") ||
+    has_prefix(id2string(function_name), "java::org.cprover") ||
+    has_prefix(id2string(function_name), "java::java");
+
+  return json_objectt{
+    {"name", json_stringt(function_name)},
+    {"isBodyAvailable",
+     jsont::json_boolean(function_entry->second.body_available())},
+    {"isInternal", jsont::json_boolean(is_internal)}};
+}
+
+json_objectt show_goto_functions_jsont::convert_instruction(
+  const irep_idt &function_name,
+  const goto_programt &goto_program,
+  const goto_programt::instructiont &instruction)
+{
+  const json_irept no_comments_irep_converter(false);
+
+  json_objectt instruction_entry{
+    {"instructionId", json_stringt(instruction.to_string())}};
+
+  if(instruction.code.source_location().is_not_nil())
+  {
+    instruction_entry["sourceLocation"]=
+      json(instruction.code.source_location());
+  }
+
+  std::ostringstream instruction_builder;
+  goto_program.output_instruction(
+    ns, function_name, instruction_builder, instruction);
+
+  instruction_entry["instruction"]=
+    json_stringt(instruction_builder.str());
+
+  if(!instruction.code.operands().empty())
+  {
+    json_arrayt operand_array;
+    for(const exprt &operand : instruction.code.operands())
+    {
+      json_objectt operand_object=
+        no_comments_irep_converter.convert_from_irep(
+          operand);
+      operand_array.push_back(operand_object);
+    }
+    instruction_entry["operands"] = std::move(operand_array);
+  }
+
+  if(!instruction.guard.is_true())
+  {
+    json_objectt guard_object=
+      no_comments_irep_converter.convert_from_irep(
+        instruction.guard);
+
+    instruction_entry["guard"] = std::move(guard_object);
+  }
+
+  return instruction_entry;
+}
+
 /// Print the json object generated by
 /// show_goto_functions_jsont::show_goto_functions to the provided stream (e.g.
 /// std::cout)
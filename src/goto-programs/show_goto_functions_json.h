@@ -14,7 +14,9 @@ Author: Thomas Kiley
 
 #include <util/json.h>
 
-class goto_functionst;
+#include "goto_functions.h"
+
+class json_stream_objectt;
 class namespacet;
 
 class show_goto_functions_jsont
@@ -25,12 +27,21 @@ public:
     bool _list_only = false);
 
   json_objectt convert(const goto_functionst &goto_functions);
+  void
+  convert(const goto_functionst &goto_functions, json_stream_objectt &result);
   void operator()(
     const goto_functionst &goto_functions, std::ostream &out, bool append=true);
 
 private:
   const namespacet &ns;
   bool list_only;
+
+  json_objectt convert_function_header(
+    const goto_functionst::function_mapt::const_iterator &function_entry);
+  json_objectt convert_instruction(
+    const irep_idt &function_name,
+    const goto_programt &goto_program,
+    const goto_programt::instructiont &instruction);
 };
 
 #endif // CPROVER_GOTO_PROGRAMS_SHOW_GOTO_FUNCTIONS_JSON_H
@@ -14,6 +14,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <iostream>
 
 #include <util/json_irep.h>
+#include <util/json_stream.h>
 #include <util/xml_irep.h>
 
 #include <langapi/language_util.h>
@@ -108,55 +109,75 @@ void show_properties(
   }
 }
 
-void convert_properties_json(
-  json_arrayt &json_properties,
+/// \return JSON object describing the property checked by the assertion
+///   \p ins of function \p identifier
+static json_objectt convert_property_json(
   const namespacet &ns,
   const irep_idt &identifier,
-  const goto_programt &goto_program)
+  const goto_programt::instructiont &ins)
 {
-  for(const auto &ins : goto_program.instructions)
-  {
-    if(!ins.is_assert())
-      continue;
+  const source_locationt &source_location=ins.source_location;
 
-    const source_locationt &source_location=ins.source_location;
+  const irep_idt &comment=source_location.get_comment();
+  // const irep_idt &function=location.get_function();
+  const irep_idt &property_class=source_location.get_property_class();
+  const irep_idt description = (comment.empty() ? "assertion" : comment);
 
-    const irep_idt &comment=source_location.get_comment();
-    // const irep_idt &function=location.get_function();
-    const irep_idt &property_class=source_location.get_property_class();
-    const irep_idt description = (comment.empty() ? "assertion" : comment);
+  irep_idt property_id=source_location.get_property_id();
 
-    irep_idt property_id=source_location.get_property_id();
+  json_objectt json_property{
+    {"name", json_stringt(property_id)},
+    {"class", json_stringt(property_class)},
+    {"sourceLocation", json(source_location)},
+    {"description", json_stringt(description)},
+    {"expression",
+     json_stringt(from_expr(ns, identifier, ins.get_condition()))}};
 
-    json_objectt json_property{
-      {"name", json_stringt(property_id)},
-      {"class", json_stringt(property_class)},
-      {"sourceLocation", json(source_location)},
-      {"description", json_stringt(description)},
-      {"expression",
-       json_stringt(from_expr(ns, identifier, ins.get_condition()))}};
+  if(!source_location.get_basic_block_covered_lines().empty())
+    json_property["coveredLines"] =
+      json_stringt(source_location.get_basic_block_covered_lines());
 
-    if(!source_location.get_basic_block_covered_lines().empty())
-      json_property["coveredLines"] =
-        json_stringt(source_location.get_basic_block_covered_lines());
+  return json_property;
+}
 
-    json_properties.push_back(std::move(json_property));
+void convert_properties_json(
+  json_arrayt &json_properties,
+  const namespacet &ns,
+  const irep_idt &identifier,
+  const goto_programt &goto_program)
+{
+  for(const auto &ins : goto_program.instructions)
+  {
+    if(ins.is_assert())
+      json_properties.push_back(convert_property_json(ns, identifier, ins));
+  }
+}
+
+void convert_properties_json(
+  json_stream_arrayt &json_properties,
+  const namespacet &ns,
+  const irep_idt &identifier,
+  const goto_programt &goto_program)
+{
+  for(const auto &ins : goto_program.instructions)
+  {
+    if(ins.is_assert())
+      json_properties.push_back(convert_property_json(ns, identifier, ins));
   }
 }
 
 void show_properties_json(
   const namespacet &ns,
-  message_handlert &message_handler,
+  ui_message_handlert &ui_message_handler,
   const goto_functionst &goto_functions)
 {
-  messaget msg(message_handler);
-  json_arrayt json_properties;
+  json_stream_arrayt &json_properties =
+    ui_message_handler.get_json_stream()
+      .push_back_stream_object()
+      .push_back_stream_array("properties");
 
   for(const auto &fct : goto_functions.function_map)
     convert_properties_json(json_properties, ns, fct.first, fct.second.body);
-
-  json_objectt json_result{{"properties", json_properties}};
-  msg.result() << json_result;
 }
 
 void show_properties(
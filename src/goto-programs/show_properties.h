@@ -21,6 +21,7 @@ class symbol_tablet;
 class goto_programt;
 class goto_functionst;
 class message_handlert;
+class json_stream_arrayt;
 
 // clang-format off
 #define OPT_SHOW_PROPERTIES \
@@ -61,4 +62,12 @@ void convert_properties_json(
   const irep_idt &identifier,
   const goto_programt &goto_program);
 
+/// \brief Streams the properties in the goto program to \p json_properties,
+///   see \ref convert_properties_json
+void convert_properties_json(
+  json_stream_arrayt &json_properties,
+  const namespacet &ns,
+  const irep_idt &identifier,
+  const goto_programt &goto_program);
+
 #endif // CPROVER_GOTO_PROGRAMS_SHOW_PROPERTIES_H
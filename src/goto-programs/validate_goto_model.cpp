@@ -9,13 +9,23 @@ Date: Oct 2018
 
 #include "validate_goto_model.h"
 
+#include <algorithm>
 #include <set>
+#include <thread>
 
+#include <util/exception_utils.h>
+#include <util/forked_workers.h>
 #include <util/invariant.h>
 
+#include "goto_function_hash.h"
 #include "goto_functions.h"
+#include "goto_model.h"
 #include "remove_returns.h"
 
+/// Changed functions validated by each forked worker at least, such that the
+/// cost of forking is small in comparison
+#define VALIDATE_FUNCTIONS_PER_WORKER 256
+
 namespace
 {
 class validate_goto_modelt
@@ -194,3 +204,82 @@ void validate_goto_model(
 {
   validate_goto_modelt{goto_functions, vm, validation_options};
 }
+
+incremental_goto_model_validatort::incremental_goto_model_validatort(
+  validation_modet vm,
+  goto_model_validation_optionst validation_options)
+  : vm(vm), validation_options(validation_options)
+{
+}
+
+std::size_t incremental_goto_model_validatort::
+operator()(const goto_modelt &goto_model)
+{
+  if(!symbol_table_validated)
+  {
+    goto_model.symbol_table.validate(vm);
+    symbol_table_validated = true;
+  }
+
+  validate_goto_model(goto_model.goto_functions, vm, validation_options);
+
+  const auto &function_map = goto_model.goto_functions.function_map;
+
+  std::vector<irep_idt> changed;
+  std::unordered_map<irep_idt, std::size_t> hashes;
+  hashes.reserve(function_map.size());
+  for(const auto &function_pair : function_map)
+  {
+    const std::size_t hash =
+      goto_function_hash(function_pair.first, function_pair.second);
+    hashes.emplace(function_pair.first, hash);
+
+    const auto validated_it = validated_hashes.find(function_pair.first);
+    if(validated_it == validated_hashes.end() || validated_it->second != hash)
+      changed.push_back(function_pair.first);
+  }
+
+  const namespacet ns(goto_model.symbol_table);
+
+  const std::size_t workers = std::min<std::size_t>(
+    std::thread::hardware_concurrency(),
+    changed.size() / VALIDATE_FUNCTIONS_PER_WORKER);
+
+  if(workers > 1 && forked_workers_supported())
+  {
+    // validation only reads the model, which the workers inherit
+    const auto results =
+      run_forked_workers(workers, [&](std::size_t worker) -> std::string {
+        try
+        {
+          for(std::size_t i = worker; i < changed.size(); i += workers)
+          {
+            goto_model.goto_functions.validate_function(
+              ns, validation_modet::EXCEPTION, changed[i]);
+          }
+        }
+        catch(const incorrect_goto_program_exceptiont &e)
+        {
+          return e.what();
+        }
+        // an empty result means all functions are well-formed
+        return {};
+      });
+
+    for(const auto &result : results)
+    {
+      DATA_CHECK(
+        vm, result.has_value(), "goto function validation worker failed");
+      DATA_CHECK(vm, result->empty(), *result);
+    }
+  }
+  else
+  {
+    for(const auto &function_id : changed)
+      goto_model.goto_functions.validate_function(ns, vm, function_id);
+  }
+
+  validated_hashes = std::move(hashes);
+
+  return changed.size();
+}
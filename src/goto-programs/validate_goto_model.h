@@ -10,8 +10,11 @@ Date: Oct 2018
 #ifndef CPROVER_GOTO_PROGRAMS_VALIDATE_GOTO_MODEL_H
 #define CPROVER_GOTO_PROGRAMS_VALIDATE_GOTO_MODEL_H
 
+#include <util/irep.h>
 #include <util/validate.h>
 
+#include <unordered_map>
+
 class goto_model_validation_optionst final
 {
 public:
@@ -56,10 +59,38 @@ public:
 };
 
 class goto_functionst;
+class goto_modelt;
 
 void validate_goto_model(
   const goto_functionst &goto_functions,
   const validation_modet vm,
   const goto_model_validation_optionst validation_options);
 
+/// Validates a goto model repeatedly, for example after each of a series of
+/// transformations, at a fraction of the cost of \ref goto_modelt::validate.
+/// The symbol table is validated on the first call only, and the functions
+/// only when their bodies changed since the previous call, as determined by
+/// \ref goto_function_hash. The changed functions are validated in parallel
+/// where forked workers are supported. Changes to the symbol table alone do
+/// not cause functions to be validated again.
+class incremental_goto_model_validatort
+{
+public:
+  incremental_goto_model_validatort(
+    validation_modet vm,
+    goto_model_validation_optionst validation_options);
+
+  /// Validate \p goto_model
+  /// \return the number of functions validated
+  std::size_t operator()(const goto_modelt &goto_model);
+
+protected:
+  const validation_modet vm;
+  const goto_model_validation_optionst validation_options;
+  bool symbol_table_validated = false;
+
+  /// hash of each function when it was last validated
+  std::unordered_map<irep_idt, std::size_t> validated_hashes;
+};
+
 #endif // CPROVER_GOTO_PROGRAMS_VALIDATE_GOTO_MODEL_H
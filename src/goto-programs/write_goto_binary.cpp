@@ -12,6 +12,7 @@ Author: CM Wintersteiger
 #include "write_goto_binary.h"
 
 #include <fstream>
+#include <sstream>
 
 #include <util/exception_utils.h>
 #include <util/invariant.h>
@@ -21,6 +22,46 @@ Author: CM Wintersteiger
 
 #include <goto-programs/goto_model.h>
 
+/// Writes the instructions of a function body
+static void write_goto_function(
+  std::ostream &out,
+  const goto_programt &body,
+  irep_serializationt &irepconverter)
+{
+  // Since version 2, goto functions are not converted to ireps,
+  // instead they are saved in a custom binary format
+
+  write_gb_word(out, body.instructions.size()); // # instructions
+
+  forall_goto_program_instructions(i_it, body)
+  {
+    const goto_programt::instructiont &instruction = *i_it;
+
+    irepconverter.reference_convert(instruction.code, out);
+    irepconverter.reference_convert(instruction.source_location, out);
+    write_gb_word(out, (long)instruction.type);
+    irepconverter.reference_convert(instruction.guard, out);
+    write_gb_word(out, instruction.target_number);
+
+    write_gb_word(out, instruction.targets.size());
+
+    for(const auto &t_it : instruction.targets)
+      write_gb_word(out, t_it->target_number);
+
+    write_gb_word(out, instruction.labels.size());
+
+    for(const auto &l_it : instruction.labels)
+      irepconverter.write_string_ref(out, l_it);
+  }
+}
+
+void write_goto_function_body(std::ostream &out, const goto_programt &body)
+{
+  irep_serializationt::ireps_containert ic;
+  irep_serializationt function_converter(ic);
+  write_goto_function(out, body, function_converter);
+}
+
 /// Writes a goto program to disc, using goto binary format
 bool write_goto_binary(
   std::ostream &out,
@@ -73,48 +114,33 @@ bool write_goto_binary(
     write_gb_word(out, flags);
   }
 
-  // now write functions, but only those with body
-
-  unsigned cnt=0;
-  forall_goto_functions(it, goto_functions)
-    if(it->second.body_available())
-      cnt++;
+  // now write functions, but only those with body. Each body is
+  // serialized on its own and preceded by an index of names and sizes, so
+  // that readers can load individual functions on demand.
 
-  write_gb_word(out, cnt);
+  std::vector<std::pair<irep_idt, std::string>> bodies;
 
   for(const auto &fct : goto_functions.function_map)
   {
     if(fct.second.body_available())
     {
-      // Since version 2, goto functions are not converted to ireps,
-      // instead they are saved in a custom binary format
-
-      write_gb_string(out, id2string(fct.first)); // name
-      write_gb_word(out, fct.second.body.instructions.size()); // # instructions
-
-      forall_goto_program_instructions(i_it, fct.second.body)
-      {
-        const goto_programt::instructiont &instruction = *i_it;
-
-        irepconverter.reference_convert(instruction.code, out);
-        irepconverter.reference_convert(instruction.source_location, out);
-        write_gb_word(out, (long)instruction.type);
-        irepconverter.reference_convert(instruction.guard, out);
-        write_gb_word(out, instruction.target_number);
-
-        write_gb_word(out, instruction.targets.size());
-
-        for(const auto &t_it : instruction.targets)
-          write_gb_word(out, t_it->target_number);
+      std::ostringstream body;
+      write_goto_function_body(body, fct.second.body);
+      bodies.emplace_back(fct.first, body.str());
+    }
+  }
 
-        write_gb_word(out, instruction.labels.size());
+  write_gb_word(out, bodies.size());
 
-        for(const auto &l_it : instruction.labels)
-          irepconverter.write_string_ref(out, l_it);
-      }
-    }
+  for(const auto &body : bodies)
+  {
+    write_gb_string(out, id2string(body.first)); // name
+    write_gb_word(out, body.second.size()); // # bytes
   }
 
+  for(const auto &body : bodies)
+    out << body.second;
+
   // irepconverter.output_map(f);
   // irepconverter.output_string_map(f);
 
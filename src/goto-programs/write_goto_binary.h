@@ -12,7 +12,7 @@ Author: CM Wintersteiger
 #ifndef CPROVER_GOTO_PROGRAMS_WRITE_GOTO_BINARY_H
 #define CPROVER_GOTO_PROGRAMS_WRITE_GOTO_BINARY_H
 
-#define GOTO_BINARY_VERSION 5
+#define GOTO_BINARY_VERSION 6
 
 #include <iosfwd>
 #include <string>
@@ -33,6 +33,10 @@ bool write_goto_binary(
   const goto_functionst &,
   int version=GOTO_BINARY_VERSION);
 
+/// Writes the body of a single function as it is stored in a goto binary,
+/// such that it can be read with \ref read_goto_function_body
+void write_goto_function_body(std::ostream &out, const goto_programt &body);
+
 bool write_goto_binary(
   const std::string &filename,
   const goto_modelt &,
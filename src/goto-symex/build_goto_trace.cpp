@@ -13,6 +13,8 @@ Author: Daniel Kroening
 
 #include "build_goto_trace.h"
 
+#include <algorithm>
+
 #include <util/arith_tools.h>
 #include <util/byte_operators.h>
 #include <util/simplify_expr.h>
@@ -206,7 +208,8 @@ void build_goto_trace(
   ssa_step_predicatet is_last_step_to_keep,
   const decision_proceduret &decision_procedure,
   const namespacet &ns,
-  goto_tracet &goto_trace)
+  goto_tracet &goto_trace,
+  const trace_step_predicatet &needs_values)
 {
   // We need to re-sort the steps according to their clock.
   // Furthermore, read-events need to occur before write
@@ -221,6 +224,16 @@ void build_goto_trace(
   ssa_step_iteratort last_step_to_keep = target.SSA_steps.end();
   bool last_step_was_kept = false;
 
+  // Without shared accesses all steps happen at time zero, and no step after
+  // the last one to keep can make it into the trace.
+  const bool is_concurrent = std::any_of(
+    target.SSA_steps.begin(),
+    target.SSA_steps.end(),
+    [](const SSA_stept &step) {
+      return step.is_shared_read() || step.is_shared_write() ||
+             step.is_atomic_begin();
+    });
+
   // First sort the SSA steps by time, in the process dropping steps
   // we definitely don't want to retain in the final trace:
 
@@ -309,12 +322,15 @@ void build_goto_trace(
       continue;
     }
 
+    time_map[current_time].push_back(it);
+
     if(it == last_step_to_keep)
     {
       last_step_was_kept = true;
-    }
 
-    time_map[current_time].push_back(it);
+      if(!is_concurrent)
+        break;
+    }
   }
 
   INVARIANT(
@@ -351,10 +367,6 @@ void build_goto_trace(
       goto_trace_step.io_id = SSA_step.io_id;
       goto_trace_step.formatted = SSA_step.formatted;
       goto_trace_step.called_function = SSA_step.called_function;
-      goto_trace_step.function_arguments = SSA_step.converted_function_arguments;
-
-      for(auto &arg : goto_trace_step.function_arguments)
-        arg = decision_procedure.get(arg);
 
       // update internal field for specific variables in the counterexample
       update_internal_field(SSA_step, goto_trace_step, ns);
@@ -368,6 +380,29 @@ void build_goto_trace(
           ? goto_trace_stept::assignment_typet::ACTUAL_PARAMETER
           : goto_trace_stept::assignment_typet::STATE;
 
+      if(SSA_step.is_assert() || SSA_step.is_assume() || SSA_step.is_goto())
+      {
+        goto_trace_step.cond_expr = SSA_step.cond_expr;
+
+        goto_trace_step.cond_value =
+          decision_procedure.get(SSA_step.cond_handle).is_true();
+      }
+
+      const bool is_last_step = ssa_step_it == last_step_to_keep;
+
+      // the skeleton of the step is complete, the values are costly to get
+      if(needs_values && !needs_values(goto_trace_step))
+      {
+        if(is_last_step)
+          return;
+        continue;
+      }
+
+      goto_trace_step.function_arguments =
+        SSA_step.converted_function_arguments;
+      for(auto &arg : goto_trace_step.function_arguments)
+        arg = decision_procedure.get(arg);
+
       if(SSA_step.original_full_lhs.is_not_nil())
       {
         goto_trace_step.full_lhs = simplify_expr(
@@ -402,15 +437,7 @@ void build_goto_trace(
         }
       }
 
-      if(SSA_step.is_assert() || SSA_step.is_assume() || SSA_step.is_goto())
-      {
-        goto_trace_step.cond_expr = SSA_step.cond_expr;
-
-        goto_trace_step.cond_value =
-          decision_procedure.get(SSA_step.cond_handle).is_true();
-      }
-
-      if(ssa_step_it == last_step_to_keep)
+      if(is_last_step)
         return;
     }
   }
@@ -421,7 +448,8 @@ void build_goto_trace(
   symex_target_equationt::SSA_stepst::const_iterator last_step_to_keep,
   const decision_proceduret &decision_procedure,
   const namespacet &ns,
-  goto_tracet &goto_trace)
+  goto_tracet &goto_trace,
+  const trace_step_predicatet &needs_values)
 {
   const auto is_last_step_to_keep =
     [last_step_to_keep](
@@ -429,7 +457,12 @@ void build_goto_trace(
       const decision_proceduret &) { return last_step_to_keep == it; };
 
   return build_goto_trace(
-    target, is_last_step_to_keep, decision_procedure, ns, goto_trace);
+    target,
+    is_last_step_to_keep,
+    decision_procedure,
+    ns,
+    goto_trace,
+    needs_values);
 }
 
 static bool is_failed_assertion_step(
@@ -444,8 +477,14 @@ void build_goto_trace(
   const symex_target_equationt &target,
   const decision_proceduret &decision_procedure,
   const namespacet &ns,
-  goto_tracet &goto_trace)
+  goto_tracet &goto_trace,
+  const trace_step_predicatet &needs_values)
 {
   build_goto_trace(
-    target, is_failed_assertion_step, decision_procedure, ns, goto_trace);
+    target,
+    is_failed_assertion_step,
+    decision_procedure,
+    ns,
+    goto_trace,
+    needs_values);
 }
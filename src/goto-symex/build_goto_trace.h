@@ -17,17 +17,25 @@ Date: July 2005
 #include "symex_target_equation.h"
 #include "goto_symex_state.h"
 
+/// Decides whether the values of a step of the trace are fetched from the
+/// decision procedure. The predicate is given the step with its kind,
+/// location and visibility filled in, but without any values.
+typedef std::function<bool(const goto_trace_stept &)> trace_step_predicatet;
+
 /// Build a trace by going through the steps of \p target and stopping at the
 /// first failing assertion
 /// \param target: SSA form of the program
 /// \param decision_procedure: solver from which to get valuations
 /// \param ns: namespace
 /// \param [out] goto_trace: trace to which the steps of the trace get appended
+/// \param needs_values: selects the steps whose values are fetched, all
+///   steps if empty
 void build_goto_trace(
   const symex_target_equationt &target,
   const decision_proceduret &decision_procedure,
   const namespacet &ns,
-  goto_tracet &goto_trace);
+  goto_tracet &goto_trace,
+  const trace_step_predicatet &needs_values = {});
 
 /// Build a trace by going through the steps of \p target and stopping after
 /// the given step
@@ -36,12 +44,15 @@ void build_goto_trace(
 /// \param decision_procedure: solver from which to get valuations
 /// \param ns: namespace
 /// \param [out] goto_trace: trace to which the steps of the trace get appended
+/// \param needs_values: selects the steps whose values are fetched, all
+///   steps if empty
 void build_goto_trace(
   const symex_target_equationt &target,
   symex_target_equationt::SSA_stepst::const_iterator last_step_to_keep,
   const decision_proceduret &decision_procedure,
   const namespacet &ns,
-  goto_tracet &goto_trace);
+  goto_tracet &goto_trace,
+  const trace_step_predicatet &needs_values = {});
 
 typedef std::function<bool(
   symex_target_equationt::SSA_stepst::const_iterator,
@@ -56,11 +67,14 @@ typedef std::function<bool(
 /// \param decision_procedure: solver from which to get valuations
 /// \param ns: namespace
 /// \param [out] goto_trace: trace to which the steps of the trace get appended
+/// \param needs_values: selects the steps whose values are fetched, all
+///   steps if empty
 void build_goto_trace(
   const symex_target_equationt &target,
   ssa_step_predicatet stop_after_predicate,
   const decision_proceduret &decision_procedure,
   const namespacet &ns,
-  goto_tracet &goto_trace);
+  goto_tracet &goto_trace,
+  const trace_step_predicatet &needs_values = {});
 
 #endif // CPROVER_GOTO_SYMEX_BUILD_GOTO_TRACE_H
@@ -10,13 +10,22 @@ Author: John Dumbell
 #include "goto_symex_state.h"
 #include <cmath>
 
+#include <util/memory_info.h>
+
 complexity_limitert::complexity_limitert(
   message_handlert &message_handler,
   const optionst &options)
   : log(message_handler)
 {
   std::size_t limit = options.get_signed_int_option("symex-complexity-limit");
-  if((complexity_active = limit > 0))
+  max_formula_cost =
+    options.get_unsigned_int_option("symex-complexity-cost-limit");
+  // Symex leaves half of the memory limit to the conversion of the equation
+  // and to the solver.
+  max_memory =
+    static_cast<std::size_t>(options.get_unsigned_int_option("memory-limit")) *
+    1024 * 1024 / 2;
+  if((complexity_active = limit > 0 || max_formula_cost > 0 || max_memory > 0))
   {
     // This gives a curve that allows low limits to be rightly restrictive,
     // while larger numbers are very large.
@@ -36,7 +45,7 @@ complexity_limitert::complexity_limitert(
     else if(unwind > 0)
       max_loops_complexity = std::max(static_cast<int>(floor(unwind / 3)), 1);
     else
-      max_loops_complexity = limit;
+      max_loops_complexity = std::max(limit, std::size_t{1});
   }
 }
 
@@ -131,22 +140,55 @@ bool complexity_limitert::are_loop_children_too_complicated(
   return !loop_to_blacklist;
 }
 
+bool complexity_limitert::check_memory()
+{
+  if(max_memory == 0 || memory_exhausted)
+    return memory_exhausted;
+
+  if(++steps_since_memory_check < 1000)
+    return false;
+
+  steps_since_memory_check = 0;
+  memory_exhausted = allocated_memory() >= max_memory;
+
+  if(memory_exhausted)
+  {
+    log.warning() << "[symex-complexity] Memory use reached "
+                  << max_memory / (1024 * 1024)
+                  << " MiB, abandoning all remaining branches"
+                  << messaget::eom;
+  }
+
+  return memory_exhausted;
+}
+
 complexity_violationt
 complexity_limitert::check_complexity(goto_symex_statet &state)
 {
   if(!complexity_limits_active() || !state.reachable)
     return complexity_violationt::NONE;
 
+  if(check_memory())
+    return complexity_violationt::BRANCH;
+
+  const bool too_costly =
+    max_formula_cost != 0 && state.formula_cost >= max_formula_cost;
+
   std::size_t complexity = state.complexity();
-  if(complexity == 0)
+  if(complexity == 0 && !too_costly)
     return complexity_violationt::NONE;
 
   auto &current_call_stack = state.call_stack();
 
   // Check if this branch is too complicated to continue.
   auto active_loop = get_current_active_loop(current_call_stack);
-  if(complexity >= max_complexity)
+  if((max_complexity != 0 && complexity >= max_complexity) || too_costly)
   {
+    // The cost of a path is never reduced, hence even a path with a true
+    // guard is abandoned, and properties can no longer be taken to pass.
+    if(too_costly)
+      formula_cost_exceeded = true;
+
     // If we're too complex, add a counter to the current loop we're in and
     // check if we've violated child-loop complexity limits.
     if(active_loop != nullptr)
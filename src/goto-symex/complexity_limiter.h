@@ -21,7 +21,9 @@ Author: John Dumbell
 /// Dynamically sets branches as unreachable symex considers them too complex.
 /// A branch is too complex when runtime may be beyond reasonable
 /// bounds due to internal structures becoming too large or solving conditions
-/// becoming too big for the SAT solver to deal with.
+/// becoming too big for the SAT solver to deal with. The latter is measured
+/// by the size of the guard and, optionally, by an estimate of the number of
+/// gates that the assignments on the branch yield when bit-blasted.
 ///
 /// On top of the branch cancelling there is special consideration for loops.
 /// As branches get cancelled it keeps track of what loops are currently active
@@ -56,6 +58,20 @@ public:
     return this->complexity_active;
   }
 
+  /// Have branches been abandoned because the memory use reached
+  /// \ref max_memory?
+  bool memory_limit_reached() const
+  {
+    return memory_exhausted;
+  }
+
+  /// Have branches been abandoned because their formula cost reached
+  /// \ref max_formula_cost?
+  bool formula_cost_limit_reached() const
+  {
+    return formula_cost_exceeded;
+  }
+
   /// Checks the passed-in state to see if its become too complex for us to deal
   /// with, and if so set its guard to false.
   /// \param state goto_symex_statet you want to check the complexity of.
@@ -89,10 +105,34 @@ protected:
   /// argument passed in via options.
   std::size_t max_complexity = 0;
 
+  /// The estimated formula size, in gates, that the assignments of a branch
+  /// may reach before it's abandoned, or 0 for no limit. See
+  /// \ref goto_statet::formula_cost.
+  std::size_t max_formula_cost = 0;
+
+  /// Whether a branch has been abandoned for reaching \ref max_formula_cost.
+  bool formula_cost_exceeded = false;
+
   /// The amount of branches that can fail within the scope of a loops execution
   /// before the entire loop is abandoned.
   std::size_t max_loops_complexity = 0;
 
+  /// The number of bytes that may be allocated, see \ref allocated_memory,
+  /// before all remaining branches are abandoned, or 0 for no limit.
+  std::size_t max_memory = 0;
+
+  /// Whether the memory use has reached \ref max_memory, which is final.
+  bool memory_exhausted = false;
+
+  /// Calls to \ref check_complexity since the memory use was last measured,
+  /// which is too costly to do on every step.
+  std::size_t steps_since_memory_check = 0;
+
+  /// Measures the memory use every so many steps and compares it to
+  /// \ref max_memory.
+  /// \return Whether the memory limit has been reached.
+  bool check_memory();
+
   /// Checks whether the current loop execution stack has violated
   /// max_loops_complexity.
   bool are_loop_children_too_complicated(call_stackt &current_call_stack);
@@ -259,6 +259,19 @@ void field_sensitivityt::field_assignments_rec(
     exprt ssa_rhs = state.rename(lhs, ns).get();
     simplify(ssa_rhs, ns);
 
+    // fields that keep their value do not need a new version, unless other
+    // threads may observe the write
+    if(
+      state.write_is_shared(to_ssa_expr(lhs_fs), ns) ==
+      goto_symex_statet::write_is_shared_resultt::NOT_SHARED)
+    {
+      state.record_events.push(false);
+      const exprt current_value = state.rename(lhs_fs, ns).get();
+      state.record_events.pop();
+      if(current_value == ssa_rhs)
+        return;
+    }
+
     const ssa_exprt ssa_lhs = state
                                 .assignment(
                                   to_ssa_expr(lhs_fs),
@@ -0,0 +1,171 @@
+/*******************************************************************\
+
+Module: Symbolic Execution
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Estimate of the Size of the Propositional Encoding of Expressions
+
+#include "formula_cost.h"
+
+#include <unordered_set>
+#include <vector>
+
+#include <util/arith_tools.h>
+#include <util/pointer_offset_size.h>
+#include <util/std_expr.h>
+#include <util/std_types.h>
+
+/// Number of bits of an expression of type \p type, or a single bit if the
+/// width is not known
+static std::size_t width(const typet &type, const namespacet &ns)
+{
+  if(type.id() == ID_bool)
+    return 1;
+
+  const auto bits = pointer_offset_bits(type, ns);
+  if(!bits.has_value() || *bits <= 0)
+    return 1;
+
+  return numeric_cast_v<std::size_t>(*bits);
+}
+
+static std::size_t log2_ceil(std::size_t w)
+{
+  std::size_t result = 0;
+  while((std::size_t{1} << result) < w)
+    ++result;
+  return result;
+}
+
+/// Cost of the operator of \p expr, disregarding its operands
+static std::size_t operator_cost(const exprt &expr, const namespacet &ns)
+{
+  const irep_idt &id = expr.id();
+
+  if(id == ID_symbol || id == ID_nondet_symbol || id == ID_constant)
+    return 0;
+
+  // wiring only
+  if(
+    id == ID_typecast || id == ID_member || id == ID_struct ||
+    id == ID_union || id == ID_array || id == ID_array_of ||
+    id == ID_address_of || id == ID_extractbit || id == ID_extractbits ||
+    id == ID_concatenation || id == ID_pointer_object ||
+    id == ID_pointer_offset)
+  {
+    return 0;
+  }
+
+  const std::size_t w = width(expr.type(), ns);
+  const std::size_t operands =
+    expr.operands().size() < 2 ? 1 : expr.operands().size() - 1;
+
+  if(
+    id == ID_and || id == ID_or || id == ID_xor || id == ID_not ||
+    id == ID_implies || id == ID_bitand || id == ID_bitor || id == ID_bitxor ||
+    id == ID_bitnot)
+  {
+    return operands * w;
+  }
+
+  // a full adder takes about five gates
+  if(id == ID_plus || id == ID_minus || id == ID_unary_minus)
+    return 5 * operands * w;
+
+  if(id == ID_mult)
+    return 5 * operands * w * w;
+
+  // the quotient and remainder are constrained by a multiplication
+  if(id == ID_div || id == ID_mod)
+    return 10 * w * w;
+
+  if(id == ID_shl || id == ID_ashr || id == ID_lshr)
+  {
+    if(to_binary_expr(expr).op1().is_constant())
+      return 0;
+    return 3 * w * log2_ceil(w);
+  }
+
+  if(
+    id == ID_byte_extract_little_endian || id == ID_byte_extract_big_endian ||
+    id == ID_byte_update_little_endian || id == ID_byte_update_big_endian)
+  {
+    if(expr.operands().size() >= 2 && expr.operands()[1].is_constant())
+      return 0;
+    const std::size_t op_width = width(expr.operands()[0].type(), ns);
+    return 3 * op_width * log2_ceil(op_width);
+  }
+
+  if(id == ID_equal || id == ID_notequal)
+    return 2 * width(to_binary_expr(expr).op0().type(), ns);
+
+  if(id == ID_lt || id == ID_le || id == ID_gt || id == ID_ge)
+    return 5 * width(to_binary_expr(expr).op0().type(), ns);
+
+  // a multiplexer per bit
+  if(id == ID_if)
+    return 3 * w;
+
+  // reading from or writing to an array at a non-constant index is encoded
+  // by constraints that compare the index with those of other accesses
+  if(id == ID_index)
+  {
+    const exprt &index = to_binary_expr(expr).op1();
+    if(index.is_constant())
+      return 0;
+    return 3 * w + 2 * width(index.type(), ns);
+  }
+
+  if(id == ID_with)
+  {
+    // operands are the old value and pairs of index and new value
+    const std::size_t updates = expr.operands().size() / 2;
+    const std::size_t element_width =
+      expr.type().id() == ID_array
+        ? width(to_array_type(expr.type()).subtype(), ns)
+        : w;
+    return 3 * element_width * updates;
+  }
+
+  if(
+    id == ID_floatbv_plus || id == ID_floatbv_minus ||
+    id == ID_floatbv_typecast)
+  {
+    return 30 * w;
+  }
+
+  if(id == ID_floatbv_mult || id == ID_floatbv_div || id == ID_floatbv_rem)
+    return 10 * w * w;
+
+  // anything else: a gate per bit of the result
+  return w;
+}
+
+std::size_t estimate_formula_cost(const exprt &expr, const namespacet &ns)
+{
+  std::size_t cost = 0;
+
+  // expressions are DAGs: count each shared node only once
+  std::unordered_set<const void *> visited;
+  std::vector<const exprt *> stack{&expr};
+
+  while(!stack.empty())
+  {
+    const exprt &e = *stack.back();
+    stack.pop_back();
+
+    if(!visited.insert(&e.read()).second)
+      continue;
+
+    cost += operator_cost(e, ns);
+
+    for(const auto &op : e.operands())
+      stack.push_back(&op);
+  }
+
+  return cost;
+}
@@ -0,0 +1,29 @@
+/*******************************************************************\
+
+Module: Symbolic Execution
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Estimate of the Size of the Propositional Encoding of Expressions
+
+#ifndef CPROVER_GOTO_SYMEX_FORMULA_COST_H
+#define CPROVER_GOTO_SYMEX_FORMULA_COST_H
+
+#include <cstddef>
+
+class exprt;
+class namespacet;
+
+/// Estimate the number of gates that bit-blasting \p expr yields. The
+/// estimate is based on the bit widths of the operands and the expected
+/// circuit size of each operator: linear for bitwise operations, adders and
+/// comparisons, quadratic for multiplication and division, and
+/// `w * log2(w)` for shifts and byte operations by a non-constant distance.
+/// Symbols and constants cost nothing, and sub-expressions that are shared
+/// are counted once.
+std::size_t estimate_formula_cost(const exprt &expr, const namespacet &ns);
+
+#endif // CPROVER_GOTO_SYMEX_FORMULA_COST_H
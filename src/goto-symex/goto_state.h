@@ -13,6 +13,7 @@ Author: Romain Brenguier, romain.brenguier@diffblue.com
 #define CPROVER_GOTO_SYMEX_GOTO_STATE_H
 
 #include <util/sharing_map.h>
+#include <util/std_expr.h>
 
 #include <analyses/guard.h>
 #include <analyses/local_safe_pointers.h>
@@ -64,6 +65,11 @@ public:
 
   void output_propagation_map(std::ostream &);
 
+  /// Symbols that case splits of dereferences, renamed to L2, have been
+  /// assigned to on this path, see \ref goto_symext::cache_dereference. Only
+  /// the entries that both branches agree on survive a merge.
+  sharing_mapt<exprt, symbol_exprt, false, irep_hash> dereference_cache;
+
   /// Threads
   unsigned atomic_section_id = 0;
 
@@ -76,6 +82,11 @@ public:
     return guard.as_expr().size();
   }
 
+  /// Estimated number of gates of the assignments on this branch, see
+  /// \ref estimate_formula_cost. Only tracked when complexity limits are
+  /// active.
+  std::size_t formula_cost = 0;
+
   /// Constructors
   goto_statet() = delete;
   goto_statet &operator=(const goto_statet &other) = delete;
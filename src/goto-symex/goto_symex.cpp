@@ -12,15 +12,18 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "goto_symex.h"
 
 #include "expr_skeleton.h"
+#include "relevant_symbols.h"
 #include "symex_assign.h"
 
 #include <util/arith_tools.h>
 #include <util/c_types.h>
+#include <util/cprover_prefix.h>
 #include <util/format_expr.h>
 #include <util/fresh_symbol.h>
 #include <util/mathematical_expr.h>
 #include <util/mathematical_types.h>
 #include <util/pointer_offset_size.h>
+#include <util/prefix.h>
 #include <util/simplify_expr.h>
 #include <util/string_expr.h>
 #include <util/string_utils.h>
@@ -31,7 +34,12 @@ unsigned goto_symext::dynamic_counter=0;
 
 void goto_symext::do_simplify(exprt &expr)
 {
-  if(symex_config.simplify_opt)
+  if(!symex_config.simplify_opt)
+    return;
+
+  if(simplify_cache)
+    simplify(expr, ns, *simplify_cache);
+  else
     simplify(expr, ns);
 }
 
@@ -116,6 +124,17 @@ void goto_symext::symex_assign(statet &state, const code_assignt &code)
   }
 }
 
+bool goto_symext::is_sliced_assignment(const code_assignt &code) const
+{
+  if(!relevant_symbols)
+    return false;
+
+  const irep_idt &identifier = assigned_symbol(code.lhs());
+  return !identifier.empty() &&
+         !has_prefix(id2string(identifier), CPROVER_PREFIX) &&
+         relevant_symbols->find(identifier) == relevant_symbols->end();
+}
+
 /// Maps the given array expression containing constant characters to a string
 /// containing only alphanumeric characters
 ///
@@ -12,8 +12,13 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_GOTO_SYMEX_GOTO_SYMEX_H
 #define CPROVER_GOTO_SYMEX_GOTO_SYMEX_H
 
+#include <util/make_unique.h>
 #include <util/options.h>
 #include <util/message.h>
+#include <util/simplify_expr_cache.h>
+
+#include <map>
+#include <unordered_map>
 
 #include <goto-programs/abstract_goto_model.h>
 
@@ -80,6 +85,15 @@ public:
       _remaining_vccs(std::numeric_limits<unsigned>::max()),
       complexity_module(mh, options)
   {
+#ifndef BDD_GUARDS
+    guard_manager.max_bdd_nodes = symex_config.guard_bdd_nodes;
+#endif
+
+    if(symex_config.simplify_cache_size > 0)
+    {
+      simplify_cache = util_make_unique<simplify_expr_cachet>(
+        symex_config.simplify_cache_size);
+    }
   }
 
   /// A virtual destructor allowing derived classes to be cleaned up correctly
@@ -224,6 +238,10 @@ public:
   /// if we know the source language in use, irep_idt() otherwise.
   irep_idt language_mode;
 
+  /// If set, assignments to symbols not in this set are not executed, see
+  /// \ref compute_relevant_symbols
+  std::shared_ptr<const std::unordered_set<irep_idt>> relevant_symbols;
+
 protected:
   /// The symbol table associated with the goto-program being executed.
   /// This symbol table will not have objects that are dynamically created as
@@ -261,6 +279,31 @@ protected:
   /// The messaget to write log messages to
   mutable messaget log;
 
+  /// Results of \ref do_simplify, if enabled by the `simplify-cache-size`
+  /// option. The cache is cleared whenever the namespace is reset.
+  std::unique_ptr<simplify_expr_cachet> simplify_cache;
+
+  /// An L2 pointer and whether it is known not to be null
+  typedef std::pair<exprt, bool> dereference_result_keyt;
+
+  struct dereference_result_key_hasht
+  {
+    std::size_t operator()(const dereference_result_keyt &key) const
+    {
+      return (irep_hash{}(key.first) << 1) ^ key.second;
+    }
+  };
+
+  /// Case splits built by \ref value_set_dereferencet, if enabled by the
+  /// `symex-cache-dereferences` option. They refer to L1 objects and stay
+  /// valid for as long as the L2 name of the pointer, which changes whenever
+  /// its value set does. The cache is cleared whenever the namespace is reset.
+  std::unordered_map<
+    dereference_result_keyt,
+    exprt,
+    dereference_result_key_hasht>
+    dereference_results;
+
   friend class symex_dereference_statet;
 
   /// Clean up an expression
@@ -285,15 +328,28 @@ protected:
   exprt make_auto_object(const typet &, statet &);
   virtual void dereference(exprt &, statet &, bool write);
 
-  void dereference_rec(exprt &, statet &, bool write);
+  void dereference_rec(exprt &, statet &, bool write, bool is_in_quantifier);
   exprt address_arithmetic(
     const exprt &,
     statet &,
-    bool keep_array);
+    bool keep_array,
+    bool is_in_quantifier);
+
+  /// Return the symbol that holds \p dereference_result, assigning it to a
+  /// fresh symbol unless an equal case split over the same L2 objects has
+  /// been assigned on the current path already
+  symbol_exprt cache_dereference(const exprt &dereference_result, statet &);
 
   /// Symbolically execute a GOTO instruction
   /// \param state: Symbolic execution state for current instruction
   virtual void symex_goto(statet &state);
+  /// In path exploration, decide whether the branches of the GOTO instruction
+  /// at `state.source.pc` are merged as in multi-path symex rather than
+  /// explored as separate paths. This is the case for the entry of a small
+  /// single-entry, single-exit region, and within such a region, that is, as
+  /// long as any frame has branches still to be merged.
+  /// \param state: Symbolic execution state for current instruction
+  bool should_merge_branches(const statet &state) const;
   /// Symbolically execute a GOTO instruction in the context of unreachable code
   /// \param state: Symbolic execution state for current instruction
   void symex_unreachable_goto(statet &state);
@@ -411,6 +467,23 @@ protected:
     const call_stackt &context,
     unsigned unwind);
 
+  /// \return true if the assignment \p code can be skipped as it does not
+  ///   affect any property, see \ref relevant_symbols
+  bool is_sliced_assignment(const code_assignt &code) const;
+
+  /// Identifier of the loop whose backwards goto is \p instruction of
+  /// function \p function_id, as given by \ref goto_programt::loop_id.
+  /// Identifiers are built once per function and loop number and are then
+  /// looked up by index, which avoids building and interning a string on
+  /// each iteration of a loop.
+  const irep_idt &get_loop_id(
+    const irep_idt &function_id,
+    const goto_programt::instructiont &instruction);
+
+  /// Per-function table of loop identifiers, indexed by loop number, see
+  /// \ref get_loop_id
+  std::unordered_map<irep_idt, std::vector<irep_idt>> loop_ids;
+
   virtual void loop_bound_exceeded(statet &state, const exprt &guard);
 
   /// Log a warning that a function has no body
@@ -779,6 +852,20 @@ protected:
   /// A monotonically increasing index for each created dynamic object
   static unsigned dynamic_counter;
 
+  /// Allocations made at an allocation site, see
+  /// \ref symex_configt::allocation_site_bound
+  struct allocation_sitet
+  {
+    std::size_t count = 0;
+    /// Object shared by all allocations beyond the bound
+    optionalt<symbol_exprt> summary_object;
+  };
+
+  /// Allocation sites are identified by the location numbers of the
+  /// allocating instruction and of the call to the function containing it,
+  /// as the allocation of `malloc` is the same instruction for all callers
+  std::map<std::pair<unsigned, unsigned>, allocation_sitet> allocation_sites;
+
   void rewrite_quantifiers(exprt &, statet &);
 
   /// \brief Symbolic execution paths to be resumed later
@@ -832,6 +919,23 @@ public:
     return _remaining_vccs;
   }
 
+  /// Whether paths were abandoned because the memory use came close to the
+  /// `memory-limit` option, such that properties that hold on the explored
+  /// paths may still fail on the others
+  bool memory_limit_reached() const
+  {
+    return complexity_module.memory_limit_reached();
+  }
+
+  /// Whether paths were abandoned, either for lack of memory or because their
+  /// formula cost reached the `symex-complexity-cost-limit` option, such that
+  /// properties that hold on the explored paths may still fail on the others
+  bool paths_abandoned() const
+  {
+    return complexity_module.memory_limit_reached() ||
+           complexity_module.formula_cost_limit_reached();
+  }
+
   void validate(const validation_modet vm) const
   {
     target.validate(ns, vm);
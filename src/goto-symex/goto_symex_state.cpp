@@ -31,6 +31,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <pointer-analysis/add_failed_symbols.h>
 
 static void get_l1_name(exprt &expr);
+static bool requires_renaming(const typet &type, const namespacet &ns);
 
 goto_symex_statet::goto_symex_statet(
   const symex_targett::sourcet &_source,
@@ -254,7 +255,9 @@ goto_symex_statet::rename(exprt expr, const namespacet &ns)
   }
   else
   {
-    rename<level>(expr.type(), irep_idt(), ns);
+    // only detach expr from other sharers if its type changes
+    if(requires_renaming(as_const(expr).type(), ns))
+      rename<level>(expr.type(), irep_idt(), ns);
 
     // do this recursively
     Forall_operands(it, expr)
@@ -11,6 +11,7 @@ Author: Michael Tautschnig, michael.tautschnig@cs.ox.ac.uk
 
 #include "memory_model.h"
 
+#include <util/optional.h>
 #include <util/std_expr.h>
 
 memory_model_baset::memory_model_baset(const namespacet &_ns)
@@ -46,6 +47,8 @@ void memory_model_baset::read_from(symex_target_equationt &equation)
   // make them match at least one
   // (internal or external) write.
 
+  std::size_t skipped = 0;
+
   for(const auto &address : address_map)
   {
     for(const auto &read_event : address.second.reads)
@@ -53,15 +56,41 @@ void memory_model_baset::read_from(symex_target_equationt &equation)
       exprt::operandst rf_choice_symbols;
       rf_choice_symbols.reserve(address.second.writes.size());
 
+      // Coherence: an unconditional write of the reading thread that
+      // precedes the read in program order hides all writes of that thread
+      // that precede it in turn.
+      optionalt<unsigned> last_unconditional_write;
+      for(const auto &write_event : address.second.writes)
+      {
+        if(
+          write_event->guard.is_true() &&
+          po(write_event, read_event) &&
+          (!last_unconditional_write.has_value() ||
+           numbering[write_event] > *last_unconditional_write))
+        {
+          last_unconditional_write = numbering[write_event];
+        }
+      }
+
       // this is quadratic in #events per address
       for(const auto &write_event : address.second.writes)
       {
         // rf cannot contradict program order
-        if(!po(read_event, write_event))
+        if(po(read_event, write_event))
+          continue;
+
+        if(
+          write_event->guard.is_false() ||
+          (last_unconditional_write.has_value() &&
+           write_event->source.thread_nr == read_event->source.thread_nr &&
+           numbering[write_event] < *last_unconditional_write))
         {
-          rf_choice_symbols.push_back(register_read_from_choice_symbol(
-            read_event, write_event, equation));
+          ++skipped;
+          continue;
         }
+
+        rf_choice_symbols.push_back(register_read_from_choice_symbol(
+          read_event, write_event, equation));
       }
 
       // uninitialised global symbol like symex_dynamic::dynamic_object*
@@ -78,6 +107,9 @@ void memory_model_baset::read_from(symex_target_equationt &equation)
       }
     }
   }
+
+  statistics() << "Skipped " << skipped << " read-from pairs that cannot occur"
+               << eom;
 }
 
 symbol_exprt memory_model_baset::register_read_from_choice_symbol(
@@ -104,7 +136,7 @@ symbol_exprt memory_model_baset::register_read_from_choice_symbol(
   if(!is_rfi)
   {
     // if r reads from w, then w must have happened before r
-    add_constraint(
+    add_ordering_constraint(
       equation, implies_exprt{s, before(w, r)}, "rf-order", r->source);
   }
 
@@ -11,6 +11,7 @@ Author: Michael Tautschnig, michael.tautschnig@cs.ox.ac.uk
 
 #include "memory_model_sc.h"
 
+#include <util/arith_tools.h>
 #include <util/std_expr.h>
 
 void memory_model_sct::operator()(symex_target_equationt &equation)
@@ -18,7 +19,11 @@ void memory_model_sct::operator()(symex_target_equationt &equation)
   statistics() << "Adding SC constraints" << eom;
 
   build_event_lists(equation);
-  build_clock_type();
+
+  if(context_bound != 0)
+    bound_rounds(equation);
+  else
+    build_clock_type();
 
   read_from(equation);
   write_serialization_external(equation);
@@ -28,10 +33,77 @@ void memory_model_sct::operator()(symex_target_equationt &equation)
 
 exprt memory_model_sct::before(event_it e1, event_it e2)
 {
+  if(context_bound != 0)
+    return before_in_rounds(e1, e2);
+
   return partial_order_concurrencyt::before(
     e1, e2, AX_PROPAGATION);
 }
 
+/// Context bounding in the style of Lal and Reps: the threads are run
+/// round-robin in order of their thread number, \ref context_bound times,
+/// and each thread may continue in any later round where it stopped in
+/// the previous one. The clock of an event then only holds its round, and
+/// the position of the event within the global order follows from the
+/// round, the thread number and the program order.
+void memory_model_sct::bound_rounds(symex_target_equationt &equation)
+{
+  statistics() << "Bounding interleavings to " << context_bound
+               << " round(s)" << eom;
+
+  clock_type = unsignedbv_typet(address_bits(context_bound));
+
+  // unused values of the clock type are not rounds
+  if(power(2, to_unsignedbv_type(clock_type).get_width()) == context_bound)
+    return;
+
+  const exprt bound = from_integer(context_bound, clock_type);
+
+  for(eventst::const_iterator e_it = equation.SSA_steps.begin();
+      e_it != equation.SSA_steps.end();
+      ++e_it)
+  {
+    if(!e_it->is_shared_read() && !e_it->is_shared_write() &&
+       !e_it->is_spawn())
+    {
+      continue;
+    }
+
+    add_constraint(
+      equation,
+      binary_relation_exprt(clock(e_it, AX_PROPAGATION), ID_lt, bound),
+      "context-bound",
+      e_it->source);
+  }
+}
+
+exprt memory_model_sct::before_in_rounds(event_it e1, event_it e2)
+{
+  const symbol_exprt r1 = clock(e1, AX_PROPAGATION);
+  const symbol_exprt r2 = clock(e2, AX_PROPAGATION);
+
+  // atomic sections are not split across rounds
+  if(e1->atomic_section_id != 0 &&
+     e1->atomic_section_id == e2->atomic_section_id)
+  {
+    return equal_exprt(r1, r2);
+  }
+
+  const unsigned t1 = e1->source.thread_nr;
+  const unsigned t2 = e2->source.thread_nr;
+
+  if(t1 == t2)
+  {
+    if(po(e1, e2))
+      return binary_relation_exprt(r1, ID_le, r2);
+    else
+      return false_exprt();
+  }
+
+  // within a round, lower thread numbers run first
+  return binary_relation_exprt(r1, t1 < t2 ? ID_le : ID_lt, r2);
+}
+
 bool memory_model_sct::program_order_is_relaxed(
   partial_order_concurrencyt::event_it e1,
   partial_order_concurrencyt::event_it e2) const
@@ -229,13 +301,13 @@ void memory_model_sct::write_serialization_external(
         symbol_exprt s=nondet_bool_symbol("ws-ext");
 
         // write-to-write edge
-        add_constraint(
+        add_ordering_constraint(
           equation,
           implies_exprt(s, before(*w_it1, *w_it2)),
           "ws-ext",
           (*w_it1)->source);
 
-        add_constraint(
+        add_ordering_constraint(
           equation,
           implies_exprt(not_exprt(s), before(*w_it2, *w_it1)),
           "ws-ext",
@@ -256,6 +328,20 @@ void memory_model_sct::from_read(symex_target_equationt &equation)
   {
     const a_rect &a_rec=a_it->second;
 
+    // the choice symbols of the reads from each write to this address
+    std::map<event_it, std::vector<std::pair<event_it, symbol_exprt>>>
+      reads_from;
+    for(const auto &r : a_rec.reads)
+    {
+      for(const auto &w : a_rec.writes)
+      {
+        choice_symbolst::const_iterator c_it =
+          choice_symbols.find(std::make_pair(r, w));
+        if(c_it != choice_symbols.end())
+          reads_from[w].emplace_back(r, c_it->second);
+      }
+    }
+
     // This is quadratic in the number of writes per address.
     for(event_listt::const_iterator
         w_prime=a_rec.writes.begin();
@@ -289,45 +375,44 @@ void memory_model_sct::from_read(symex_target_equationt &equation)
           ws2=before(*w, *w_prime);
         }
 
-        // smells like cubic
-        for(choice_symbolst::const_iterator
-            c_it=choice_symbols.begin();
-            c_it!=choice_symbols.end();
-            c_it++)
+        // only the reads from w_prime and w are constrained
+        for(const auto &r_rf : reads_from[*w_prime])
+        {
+          if(ws1.is_false())
+            break;
+
+          const event_it r = r_rf.first;
+          const exprt &rf = r_rf.second;
+
+          // the guard of w_prime follows from rf; with rfi
+          // optimisation such as the previous write_symbol_primed
+          // it would even be wrong to add this guard
+          add_ordering_constraint(
+            equation,
+            implies_exprt(
+              and_exprt(r->guard, (*w)->guard, ws1, rf), before(r, *w)),
+            "fr",
+            r->source);
+        }
+
+        for(const auto &r_rf : reads_from[*w])
         {
-          event_it r=c_it->first.first;
-          exprt rf=c_it->second;
-          exprt cond;
-          cond.make_nil();
-
-          if(c_it->first.second==*w_prime && !ws1.is_false())
-          {
-            exprt fr=before(r, *w);
-
-            // the guard of w_prime follows from rf; with rfi
-            // optimisation such as the previous write_symbol_primed
-            // it would even be wrong to add this guard
-            cond=
-              implies_exprt(
-                and_exprt(r->guard, (*w)->guard, ws1, rf),
-                fr);
-          }
-          else if(c_it->first.second==*w && !ws2.is_false())
-          {
-            exprt fr=before(r, *w_prime);
-
-            // the guard of w follows from rf; with rfi
-            // optimisation such as the previous write_symbol_primed
-            // it would even be wrong to add this guard
-            cond=
-              implies_exprt(
-                and_exprt(r->guard, (*w_prime)->guard, ws2, rf),
-                fr);
-          }
-
-          if(cond.is_not_nil())
-            add_constraint(equation,
-              cond, "fr", r->source);
+          if(ws2.is_false())
+            break;
+
+          const event_it r = r_rf.first;
+          const exprt &rf = r_rf.second;
+
+          // the guard of w follows from rf; with rfi
+          // optimisation such as the previous write_symbol_primed
+          // it would even be wrong to add this guard
+          add_ordering_constraint(
+            equation,
+            implies_exprt(
+              and_exprt(r->guard, (*w_prime)->guard, ws2, rf),
+              before(r, *w_prime)),
+            "fr",
+            r->source);
         }
       }
     }
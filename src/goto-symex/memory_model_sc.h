@@ -17,15 +17,25 @@ Author: Michael Tautschnig, michael.tautschnig@cs.ox.ac.uk
 class memory_model_sct:public memory_model_baset
 {
 public:
-  explicit memory_model_sct(const namespacet &_ns):
-    memory_model_baset(_ns)
+  /// \param _ns: namespace
+  /// \param _context_bound: if non-zero, only executions that schedule the
+  ///   threads round-robin in at most this many rounds are considered
+  explicit memory_model_sct(
+    const namespacet &_ns,
+    unsigned _context_bound = 0)
+    : memory_model_baset(_ns), context_bound(_context_bound)
   {
   }
 
   virtual void operator()(symex_target_equationt &equation);
 
 protected:
+  /// number of round-robin rounds, or 0 for unbounded interleavings
+  const unsigned context_bound;
+
   virtual exprt before(event_it e1, event_it e2);
+  exprt before_in_rounds(event_it e1, event_it e2);
+  void bound_rounds(symex_target_equationt &equation);
   virtual bool program_order_is_relaxed(
     partial_order_concurrencyt::event_it e1,
     partial_order_concurrencyt::event_it e2) const;
@@ -152,7 +152,7 @@ void memory_model_tsot::program_order(
             ordering=partial_order_concurrencyt::before(
               *e_it, *e_it2, AX_PROPAGATION);
 
-          add_constraint(
+          add_ordering_constraint(
             equation,
             implies_exprt(cond, ordering),
             "po",
@@ -69,7 +69,7 @@ void partial_order_concurrencyt::add_init_writes(
     init_done.insert(a);
   }
 
-  equation.SSA_steps.splice(equation.SSA_steps.begin(), init_steps);
+  equation.SSA_steps.prepend(std::move(init_steps));
 }
 
 void partial_order_concurrencyt::build_event_lists(
@@ -210,3 +210,21 @@ void partial_order_concurrencyt::add_constraint(
 
   equation.constraint(tmp, msg, source);
 }
+
+void partial_order_concurrencyt::add_ordering_constraint(
+  symex_target_equationt &equation,
+  const exprt &cond,
+  const std::string &msg,
+  const symex_targett::sourcet &source) const
+{
+  if(!lazy)
+  {
+    add_constraint(equation, cond, msg, source);
+    return;
+  }
+
+  exprt tmp = cond;
+  simplify(tmp, ns);
+
+  equation.lazy_constraint(tmp, msg, source);
+}
@@ -46,9 +46,18 @@ public:
     event_it e,
     axiomt axiom=AX_PROPAGATION);
 
+  /// Defer the conditional ordering constraints until a model violates them,
+  /// see \ref add_ordering_constraint
+  void set_lazy(bool value)
+  {
+    lazy = value;
+  }
+
 protected:
   const namespacet &ns;
 
+  bool lazy = false;
+
   typedef std::vector<event_it> event_listt;
 
   // lists of reads and writes per address
@@ -117,6 +126,18 @@ protected:
     const std::string &msg,
     const symex_targett::sourcet &source) const;
 
+  /// Simplify and add a constraint that orders events to equation; in lazy
+  /// mode, it is only converted once a model of the equation violates it.
+  /// \param equation: target equation to be constrained with the \p cond
+  /// \param cond: condition expressing the constraint
+  /// \param msg: message for the constraint
+  /// \param source: the location of the constraint
+  void add_ordering_constraint(
+    symex_target_equationt &equation,
+    const exprt &cond,
+    const std::string &msg,
+    const symex_targett::sourcet &source) const;
+
   /// Build the partial order constraint for two events:
   /// if \p e1 and \p e2 are in the same atomic section then constrain with
   ///   equality between their clocks
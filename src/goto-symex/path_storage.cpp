@@ -8,8 +8,12 @@ Author: Kareem Khazem <karkhaz@karkhaz.com>
 
 #include "path_storage.h"
 
+#include <fstream>
+#include <limits>
 #include <sstream>
+#include <unordered_set>
 
+#include <util/exception_utils.h>
 #include <util/exit_codes.h>
 #include <util/make_unique.h>
 
@@ -53,6 +57,14 @@ void path_lifot::clear()
   paths.clear();
 }
 
+void path_lifot::retain_share(
+  std::size_t share_index,
+  std::size_t number_of_shares)
+{
+  ::retain_share(paths, share_index, number_of_shares);
+  last_peeked = paths.end();
+}
+
 // _____________________________________________________________________________
 // path_fifot
 
@@ -81,6 +93,263 @@ void path_fifot::clear()
   paths.clear();
 }
 
+void path_fifot::retain_share(
+  std::size_t share_index,
+  std::size_t number_of_shares)
+{
+  ::retain_share(paths, share_index, number_of_shares);
+}
+
+// _____________________________________________________________________________
+// path_priority_queuet
+
+path_storaget::patht &path_priority_queuet::private_peek()
+{
+  if(peeked)
+    return *last_peeked;
+
+  // search backwards, such that ties are resolved in favour of the most
+  // recently saved path
+  auto best = paths.end();
+  std::size_t best_cost = 0;
+  for(auto it = paths.end(); it != paths.begin();)
+  {
+    --it;
+    const std::size_t c = cost(*it);
+    if(best == paths.end() || c < best_cost)
+    {
+      best = it;
+      best_cost = c;
+    }
+  }
+
+  last_peeked = best;
+  peeked = true;
+  return *last_peeked;
+}
+
+void path_priority_queuet::push(const path_storaget::patht &path)
+{
+  paths.push_back(path);
+}
+
+void path_priority_queuet::private_pop()
+{
+  PRECONDITION(peeked);
+  paths.erase(last_peeked);
+  peeked = false;
+}
+
+std::size_t path_priority_queuet::size() const
+{
+  return paths.size();
+}
+
+void path_priority_queuet::clear()
+{
+  paths.clear();
+  peeked = false;
+}
+
+void path_priority_queuet::retain_share(
+  std::size_t share_index,
+  std::size_t number_of_shares)
+{
+  ::retain_share(paths, share_index, number_of_shares);
+  peeked = false;
+}
+
+// _____________________________________________________________________________
+// path_coveraget
+
+void path_coveraget::visit(goto_programt::const_targett instruction)
+{
+  ++visits[&*instruction];
+}
+
+std::size_t path_coveraget::cost(const path_storaget::patht &path)
+{
+  const auto entry = visits.find(&*path.state.saved_target);
+  return entry == visits.end() ? 0 : entry->second;
+}
+
+// _____________________________________________________________________________
+// path_distancet
+
+std::size_t path_distancet::cost(const path_storaget::patht &path)
+{
+  const goto_programt::const_targett start = path.state.saved_target;
+
+  const auto entry = distances.find(&*start);
+  if(entry != distances.end())
+    return entry->second;
+
+  // breadth-first search within the function; as every function body ends
+  // in END_FUNCTION, which has no successors, the search cannot run past
+  // the end of the instruction list
+  std::size_t distance = std::numeric_limits<std::size_t>::max();
+  std::vector<goto_programt::const_targett> current{start}, next;
+  std::unordered_set<const goto_programt::instructiont *> seen{&*start};
+
+  for(std::size_t d = 0; !current.empty(); ++d)
+  {
+    for(const auto &target : current)
+    {
+      if(target->is_assert())
+      {
+        distance = d;
+        break;
+      }
+
+      if(target->is_end_function())
+        continue;
+
+      if(target->is_goto())
+      {
+        for(const auto &successor : target->targets)
+        {
+          if(seen.insert(&*successor).second)
+            next.push_back(successor);
+        }
+
+        if(target->get_condition().is_true())
+          continue;
+      }
+
+      const auto successor = std::next(target);
+      if(seen.insert(&*successor).second)
+        next.push_back(successor);
+    }
+
+    if(distance != std::numeric_limits<std::size_t>::max())
+      break;
+
+    current.swap(next);
+    next.clear();
+  }
+
+  distances.emplace(&*start, distance);
+  return distance;
+}
+
+// _____________________________________________________________________________
+// path_randomt
+
+std::size_t path_randomt::cost(const path_storaget::patht &)
+{
+  return random_generator();
+}
+
+// _____________________________________________________________________________
+// utilities
+
+void retain_share(
+  std::list<path_storaget::patht> &paths,
+  std::size_t share_index,
+  std::size_t number_of_shares)
+{
+  PRECONDITION(share_index < number_of_shares);
+
+  std::size_t position = 0;
+  for(auto it = paths.begin(); it != paths.end(); ++position)
+  {
+    if(position % number_of_shares == share_index)
+      ++it;
+    else
+      it = paths.erase(it);
+  }
+}
+
+// _____________________________________________________________________________
+// path_concolict
+
+path_concolict::path_concolict(const std::string &seed_file)
+{
+  std::ifstream in(seed_file);
+  if(!in)
+  {
+    throw system_exceptiont(
+      "failed to open concolic seed file `" + seed_file + "'");
+  }
+
+  char c;
+  while(in >> c)
+  {
+    if(c != '0' && c != '1')
+    {
+      throw deserialization_exceptiont(
+        "concolic seed file `" + seed_file +
+        "' must only contain the characters 0 and 1");
+    }
+    seed.push_back(c == '1');
+  }
+}
+
+void path_concolict::push(const path_storaget::patht &path)
+{
+  path_priority_queuet::push(path);
+
+  std::vector<bool> &path_decisions = decisions[&paths.back()];
+  path_decisions = current;
+
+  // a saved path resumes at one of the successors of the goto it was saved at
+  const goto_programt::const_targett branch = path.state.source.pc;
+  if(
+    branch->is_goto() && (path.state.has_saved_jump_target ||
+                          path.state.has_saved_next_instruction))
+  {
+    path_decisions.push_back(path.state.saved_target == branch->get_target());
+  }
+}
+
+void path_concolict::clear()
+{
+  path_priority_queuet::clear();
+  decisions.clear();
+}
+
+void path_concolict::retain_share(
+  std::size_t share_index,
+  std::size_t number_of_shares)
+{
+  path_priority_queuet::retain_share(share_index, number_of_shares);
+
+  std::unordered_map<const patht *, std::vector<bool>> retained;
+  for(const auto &path : paths)
+    retained.emplace(&path, std::move(decisions[&path]));
+  decisions.swap(retained);
+}
+
+std::size_t path_concolict::cost(const path_storaget::patht &path)
+{
+  const auto entry = decisions.find(&path);
+  if(entry == decisions.end())
+    return 0;
+
+  std::size_t deviations = 0;
+  for(std::size_t i = 0; i < entry->second.size() && i < seed.size(); ++i)
+  {
+    if(entry->second[i] != seed[i])
+      ++deviations;
+  }
+  return deviations;
+}
+
+path_storaget::patht &path_concolict::private_peek()
+{
+  patht &path = path_priority_queuet::private_peek();
+  // symex is about to resume this path, which is where the paths it saves
+  // branch off
+  current = decisions[&path];
+  return path;
+}
+
+void path_concolict::private_pop()
+{
+  decisions.erase(&*last_peeked);
+  path_priority_queuet::private_pop();
+}
+
 // _____________________________________________________________________________
 // path_strategy_choosert
 
@@ -88,14 +357,14 @@ static const std::map<
   const std::string,
   std::pair<
     const std::string,
-    const std::function<std::unique_ptr<path_storaget>()>>>
+    const std::function<std::unique_ptr<path_storaget>(const optionst &)>>>
   path_strategies(
     {{"lifo",
       {" lifo                         next instruction is pushed before\n"
        "                              goto target; paths are popped in\n"
        "                              last-in, first-out order. Explores\n"
        "                              the program tree depth-first.\n",
-       []() { // NOLINT(whitespace/braces)
+       [](const optionst &) { // NOLINT(whitespace/braces)
          return util_make_unique<path_lifot>();
        }}},
      {"fifo",
@@ -103,8 +372,39 @@ static const std::map<
        "                              goto target; paths are popped in\n"
        "                              first-in, first-out order. Explores\n"
        "                              the program tree breadth-first.\n",
-       []() { // NOLINT(whitespace/braces)
+       [](const optionst &) { // NOLINT(whitespace/braces)
          return util_make_unique<path_fifot>();
+       }}},
+     {"coverage",
+      {" coverage                     resume the path whose next instruction\n"
+       "                              has been executed least often so far;\n"
+       "                              ties are broken as for lifo.\n",
+       [](const optionst &) { // NOLINT(whitespace/braces)
+         return util_make_unique<path_coveraget>();
+       }}},
+     {"distance",
+      {" distance                     resume the path with the fewest\n"
+       "                              instructions to an assertion in its\n"
+       "                              function; ties are broken as for lifo.\n",
+       [](const optionst &) { // NOLINT(whitespace/braces)
+         return util_make_unique<path_distancet>();
+       }}},
+     {"random",
+      {" random                       resume a path chosen at random, with a\n"
+       "                              fixed seed such that runs are\n"
+       "                              reproducible.\n",
+       [](const optionst &) { // NOLINT(whitespace/braces)
+         return util_make_unique<path_randomt>();
+       }}},
+     {"concolic",
+      {" concolic                     first follow the branch decisions of a\n"
+       "                              concrete execution given by\n"
+       "                              --concolic-seed, then resume the paths\n"
+       "                              deviating from them at the fewest\n"
+       "                              branches.\n",
+       [](const optionst &options) { // NOLINT(whitespace/braces)
+         return util_make_unique<path_concolict>(
+           options.get_option("concolic-seed"));
        }}}});
 
 std::string show_path_strategies()
@@ -125,12 +425,13 @@ bool is_valid_path_strategy(const std::string strategy)
   return path_strategies.find(strategy) != path_strategies.end();
 }
 
-std::unique_ptr<path_storaget> get_path_strategy(const std::string strategy)
+std::unique_ptr<path_storaget>
+get_path_strategy(const std::string strategy, const optionst &options)
 {
   auto found = path_strategies.find(strategy);
   INVARIANT(
     found != path_strategies.end(), "Unknown strategy '" + strategy + "'.");
-  return found->second.second();
+  return found->second.second(options);
 }
 
 void parse_path_strategy_options(
@@ -152,6 +453,17 @@ void parse_path_strategy_options(
       exit(CPROVER_EXIT_USAGE_ERROR);
     }
     options.set_option("exploration-strategy", strategy);
+
+    if(strategy == "concolic")
+    {
+      if(!cmdline.isset("concolic-seed"))
+      {
+        log.error() << "The concolic strategy requires --concolic-seed"
+                    << messaget::eom;
+        exit(CPROVER_EXIT_USAGE_ERROR);
+      }
+      options.set_option("concolic-seed", cmdline.get_value("concolic-seed"));
+    }
   }
   else
   {
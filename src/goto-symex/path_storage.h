@@ -12,8 +12,11 @@
 
 #include <analyses/dirty.h>
 #include <analyses/local_safe_pointers.h>
+#include <analyses/sese_regions.h>
 
+#include <list>
 #include <memory>
+#include <random>
 
 #include "goto_symex_state.h"
 #include "symex_target_equation.h"
@@ -38,6 +41,11 @@ class path_storaget
 {
 public:
   /// \brief Information saved at a conditional goto to resume execution
+  ///
+  /// Saving a path does not copy the steps of the equation, the value set or
+  /// the renaming: the chunks of \ref symex_target_equationt::SSA_steps and
+  /// the sharing maps of the state are shared with the path that was being
+  /// executed until either of them modifies them.
   struct patht
   {
     symex_target_equationt equation;
@@ -84,12 +92,45 @@ public:
   /// \brief How many paths does this storage contain?
   virtual std::size_t size() const = 0;
 
+  /// \brief Drop all paths except for a share of them
+  ///
+  /// Splitting the saved paths into \p number_of_shares disjoint shares, keep
+  /// only those that belong to share number \p share_index. This is used to
+  /// distribute the paths across several workers that continue exploration
+  /// independently. Must not be called between peek() and pop().
+  virtual void
+  retain_share(std::size_t share_index, std::size_t number_of_shares) = 0;
+
+  /// \brief Inform the storage that symex executes the given instruction on
+  /// the current path, which strategies may use to rank the saved paths
+  virtual void visit(goto_programt::const_targett)
+  {
+  }
+
   /// \brief Is this storage empty?
   bool empty() const
   {
     return size() == 0;
   };
 
+  /// Whether symex should save paths that exceed the unwinding bound of a
+  /// loop to \ref deferred_paths, instead of cutting the loop, such that the
+  /// loop can be continued once the bound has been raised
+  bool defer_exceeded_loops = false;
+
+  /// Paths that exceeded the unwinding bound of a loop while
+  /// \ref defer_exceeded_loops was set. Each of them resumes at the head of
+  /// that loop, for one more iteration.
+  std::list<patht> deferred_paths;
+
+  /// \brief Move the \ref deferred_paths into the storage
+  void resume_deferred_paths()
+  {
+    for(const patht &path : deferred_paths)
+      push(path);
+    deferred_paths.clear();
+  }
+
   /// Counter for nondet objects, which require unique names
   symex_nondet_generatort build_symex_nondet;
 
@@ -133,6 +174,21 @@ public:
     return loop_analysis_map.at(function_id);
   }
 
+  /// Computes the single-entry, single-exit regions of \p body, unless this
+  /// has been done for \p identifier already.
+  void
+  add_function_regions(const irep_idt &identifier, const goto_programt &body)
+  {
+    auto entry = sese_regions.emplace(identifier, sese_region_analysist{});
+    if(entry.second)
+      entry.first->second(body);
+  }
+
+  /// Single-entry, single-exit regions of the functions added by
+  /// \ref add_function_regions, used to merge small regions in path
+  /// exploration
+  std::unordered_map<irep_idt, sese_region_analysist> sese_regions;
+
 private:
   std::unordered_map<irep_idt, std::shared_ptr<lexical_loopst>>
     loop_analysis_map;
@@ -169,6 +225,7 @@ public:
   void push(const patht &) override;
   std::size_t size() const override;
   void clear() override;
+  void retain_share(std::size_t, std::size_t) override;
 
 protected:
   std::list<path_storaget::patht>::iterator last_peeked;
@@ -186,6 +243,7 @@ public:
   void push(const patht &) override;
   std::size_t size() const override;
   void clear() override;
+  void retain_share(std::size_t, std::size_t) override;
 
 protected:
   std::list<patht> paths;
@@ -195,6 +253,111 @@ private:
   void private_pop() override;
 };
 
+/// \brief Priority queue: the saved path of the lowest cost is resumed first
+///
+/// Subclasses rank paths by implementing \ref cost. Costs are computed anew
+/// each time the next path is chosen, such that they can take into account
+/// what has been explored since a path was saved; choosing thus takes time
+/// linear in the number of saved paths. Among paths of equal cost, the most
+/// recently saved one is chosen, as \ref path_lifot would.
+class path_priority_queuet : public path_storaget
+{
+public:
+  void push(const patht &) override;
+  std::size_t size() const override;
+  void clear() override;
+  void retain_share(std::size_t, std::size_t) override;
+
+protected:
+  /// Cost of resuming \p path, lower costs are resumed first
+  virtual std::size_t cost(const patht &path) = 0;
+
+  std::list<patht> paths;
+  /// Path returned by the last peek, as long as \ref peeked is set
+  std::list<patht>::iterator last_peeked;
+  bool peeked = false;
+
+  patht &private_peek() override;
+  void private_pop() override;
+};
+
+/// \brief Coverage-guided: resume the path whose next instruction has been
+/// executed least often on the paths explored so far
+class path_coveraget : public path_priority_queuet
+{
+public:
+  void visit(goto_programt::const_targett instruction) override;
+
+protected:
+  std::size_t cost(const patht &path) override;
+
+  std::unordered_map<const goto_programt::instructiont *, std::size_t> visits;
+};
+
+/// \brief Resume the path that is closest to an assertion, measured as the
+/// number of instructions from its next instruction to the nearest assertion
+/// of the same function in the control-flow graph
+class path_distancet : public path_priority_queuet
+{
+protected:
+  std::size_t cost(const patht &path) override;
+
+  /// Cache of the distances of the instructions seen so far
+  std::unordered_map<const goto_programt::instructiont *, std::size_t>
+    distances;
+};
+
+/// \brief Random restarts: resume a saved path chosen uniformly at random,
+/// using a random number generator with a fixed seed
+class path_randomt : public path_priority_queuet
+{
+protected:
+  std::size_t cost(const patht &) override;
+
+  std::mt19937 random_generator;
+};
+
+/// \brief Concolic: follow the branch decisions of a concrete execution first,
+/// then resume the paths that deviate from them at the fewest branches
+///
+/// The decisions, whether or not each conditional goto reached by the
+/// concrete execution jumped, are read from a file of `0` and `1` characters.
+/// The path agreeing with all of them is explored first, followed by the paths
+/// negating a single one of them, and so on, such that tests are generated in
+/// the neighbourhood of the concrete execution. Among paths of equal cost the
+/// deepest deviation is explored first.
+class path_concolict : public path_priority_queuet
+{
+public:
+  explicit path_concolict(const std::string &seed_file);
+
+  void push(const patht &) override;
+  void clear() override;
+  void retain_share(std::size_t, std::size_t) override;
+
+protected:
+  /// Number of decisions on the way to \p path that differ from \ref seed
+  std::size_t cost(const patht &path) override;
+
+  /// Branch decisions of the concrete execution
+  std::vector<bool> seed;
+  /// Branch decisions on the way to each of the saved paths
+  std::unordered_map<const patht *, std::vector<bool>> decisions;
+  /// Branch decisions on the way to the path that is being executed
+  std::vector<bool> current;
+
+private:
+  patht &private_peek() override;
+  void private_pop() override;
+};
+
+/// \brief Keep every \p number_of_shares-th element of \p paths, starting
+/// with the one at position \p share_index
+void retain_share(
+  std::list<path_storaget::patht> &paths,
+  std::size_t share_index,
+  std::size_t number_of_shares);
+
 /// \brief suitable for displaying as a front-end help message
 std::string show_path_strategies();
 
@@ -203,7 +366,8 @@ bool is_valid_path_strategy(const std::string strategy);
 
 /// Ensure that is_valid_strategy() returns true for a
 /// particular string before calling this function on that string.
-std::unique_ptr<path_storaget> get_path_strategy(const std::string strategy);
+std::unique_ptr<path_storaget>
+get_path_strategy(const std::string strategy, const optionst &options);
 
 /// \brief add `paths` and `exploration-strategy` option, suitable to be
 /// invoked from front-ends.
@@ -0,0 +1,194 @@
+/*******************************************************************\
+
+Module: Constant and Copy Propagation on the SSA Equation
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Constant and Copy Propagation on the SSA Equation
+
+#include "propagate_assignments.h"
+
+#include <util/arith_tools.h>
+#include <util/replace_symbol.h>
+#include <util/simplify_expr.h>
+#include <util/std_expr.h>
+
+#include <unordered_map>
+
+#include "symex_target_equation.h"
+
+/// Substitute the values in \p values into \p expr, and simplify it if
+/// anything was substituted
+/// \return true if \p expr changed
+static bool
+substitute(exprt &expr, const replace_symbolt &values, const namespacet &ns)
+{
+  if(values.replace(expr))
+    return false;
+
+  simplify(expr, ns);
+  return true;
+}
+
+/// If \p expr rebuilds a struct or array from the components of a compound
+/// of the same type, or updates a compound with the value it already holds,
+/// replace \p expr by that compound
+/// \return true if \p expr changed
+static bool collapse_copy(exprt &expr, const namespacet &ns)
+{
+  if(expr.id() == ID_with && expr.operands().size() == 3)
+  {
+    // x with [i := x[i]] and x with [.c := x.c] are x
+    const with_exprt &with_expr = to_with_expr(expr);
+    const exprt &new_value = with_expr.new_value();
+    const bool writes_back =
+      (new_value.id() == ID_index &&
+       to_index_expr(new_value).array() == with_expr.old() &&
+       to_index_expr(new_value).index() == with_expr.where()) ||
+      (new_value.id() == ID_member &&
+       to_member_expr(new_value).compound() == with_expr.old() &&
+       to_member_expr(new_value).get_component_name() ==
+         with_expr.where().get(ID_component_name));
+
+    if(!writes_back)
+      return false;
+
+    exprt old = with_expr.old();
+    expr.swap(old);
+    return true;
+  }
+
+  if(expr.operands().empty())
+    return false;
+
+  const exprt *compound = nullptr;
+
+  if(expr.id() == ID_struct)
+  {
+    // {x.c1, x.c2, ...} is x
+    const struct_typet::componentst &components =
+      to_struct_type(ns.follow(expr.type())).components();
+    if(components.size() != expr.operands().size())
+      return false;
+
+    for(std::size_t i = 0; i < components.size(); ++i)
+    {
+      const exprt &op = expr.operands()[i];
+      if(
+        op.id() != ID_member ||
+        to_member_expr(op).get_component_name() != components[i].get_name() ||
+        (compound != nullptr && to_member_expr(op).compound() != *compound))
+      {
+        return false;
+      }
+      compound = &to_member_expr(op).compound();
+    }
+  }
+  else if(expr.id() == ID_array)
+  {
+    // {x[0], x[1], ...} is x
+    for(std::size_t i = 0; i < expr.operands().size(); ++i)
+    {
+      const exprt &op = expr.operands()[i];
+      if(
+        op.id() != ID_index ||
+        numeric_cast<std::size_t>(to_index_expr(op).index()) != i ||
+        (compound != nullptr && to_index_expr(op).array() != *compound))
+      {
+        return false;
+      }
+      compound = &to_index_expr(op).array();
+    }
+  }
+  else
+    return false;
+
+  if(compound->type() != expr.type())
+    return false;
+
+  exprt copied = *compound;
+  expr.swap(copied);
+  return true;
+}
+
+std::size_t
+propagate_assignments(symex_target_equationt &equation, const namespacet &ns)
+{
+  replace_symbolt values;
+  // the symbol that holds each term assigned so far, such that assignments
+  // of a congruent term become copies of that symbol
+  std::unordered_map<exprt, symbol_exprt, irep_hash> terms;
+  std::size_t changed_steps = 0;
+
+  for(auto &step : equation.SSA_steps)
+  {
+    if(step.ignore)
+      continue;
+
+    if(!step.converted)
+    {
+      bool changed = !values.empty() && substitute(step.guard, values, ns);
+
+      if(step.is_assignment())
+      {
+        bool rhs_changed =
+          !values.empty() && substitute(step.ssa_rhs, values, ns);
+
+        while(collapse_copy(step.ssa_rhs, ns))
+          rhs_changed = true;
+
+        const auto term_it = terms.find(step.ssa_rhs);
+        if(term_it != terms.end())
+        {
+          step.ssa_rhs = term_it->second;
+          rhs_changed = true;
+        }
+
+        if(rhs_changed)
+        {
+          step.cond_expr = equal_exprt{step.ssa_lhs, step.ssa_rhs};
+          changed = true;
+        }
+      }
+      else if(!values.empty() && substitute(step.cond_expr, values, ns))
+        changed = true;
+
+      if(!values.empty())
+      {
+        for(auto &argument : step.ssa_function_arguments)
+        {
+          if(substitute(argument, values, ns))
+            changed = true;
+        }
+
+        for(auto &io_arg : step.io_args)
+        {
+          if(substitute(io_arg, values, ns))
+            changed = true;
+        }
+      }
+
+      if(changed)
+        ++changed_steps;
+    }
+
+    if(!step.is_assignment())
+      continue;
+
+    // the right-hand side has been substituted already, so chains of copies
+    // are resolved to their first element
+    if(
+      (step.ssa_rhs.id() == ID_constant || step.ssa_rhs.id() == ID_symbol) &&
+      step.ssa_rhs.type() == step.ssa_lhs.type())
+    {
+      values.set(step.ssa_lhs, step.ssa_rhs);
+    }
+    else
+      terms.emplace(step.ssa_rhs, step.ssa_lhs);
+  }
+
+  return changed_steps;
+}
@@ -0,0 +1,42 @@
+/*******************************************************************\
+
+Module: Constant and Copy Propagation on the SSA Equation
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Constant and Copy Propagation on the SSA Equation
+
+#ifndef CPROVER_GOTO_SYMEX_PROPAGATE_ASSIGNMENTS_H
+#define CPROVER_GOTO_SYMEX_PROPAGATE_ASSIGNMENTS_H
+
+#include <cstddef>
+
+class namespacet;
+class symex_target_equationt;
+
+/// Replace uses of SSA symbols that are assigned a constant or another SSA
+/// symbol by that value in all subsequent steps of \p equation, and simplify
+/// the expressions that changed. This is done on the word level, before the
+/// equation is converted, to save the flattening of expressions that are
+/// constant or that are equal to expressions that have been flattened
+/// already.
+///
+/// The pass also merges congruent terms: once their operands have been
+/// replaced by their representatives, an assignment of a term that an
+/// earlier assignment computed already becomes a copy of the symbol that
+/// holds it, and so do assignments that rebuild a struct or array from the
+/// components of another one or write back the value that a compound holds
+/// already. Chains of copies through structs and arrays thus collapse to a
+/// single symbol.
+///
+/// The assignments themselves are kept, such that traces still show the
+/// values of all variables. Steps that are ignored or have been converted
+/// already are not changed, and nothing is propagated from ignored steps.
+/// \return the number of steps that changed
+std::size_t
+propagate_assignments(symex_target_equationt &equation, const namespacet &ns);
+
+#endif // CPROVER_GOTO_SYMEX_PROPAGATE_ASSIGNMENTS_H
@@ -0,0 +1,193 @@
+/*******************************************************************\
+
+Module: Grouping of Properties by their Cones of Influence
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Grouping of Properties by their Cones of Influence
+
+#include "property_groups.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+
+#include <util/find_symbols.h>
+#include <util/union_find.h>
+
+#include "symex_target_equation.h"
+
+/// Number of hash functions, and thus of values, of a signature
+static constexpr std::size_t signature_size = 16;
+
+/// Number of values of a signature that are compared at once to find the
+/// candidates for a group, see \ref group_properties_by_cone
+static constexpr std::size_t band_size = 2;
+
+/// The minimum, over the assignments in a cone, of each hash function
+typedef std::array<std::uint32_t, signature_size> signaturet;
+
+static signaturet empty_signature()
+{
+  signaturet signature;
+  signature.fill(std::numeric_limits<std::uint32_t>::max());
+  return signature;
+}
+
+/// Add the signature of \p other to \p signature, giving the signature of
+/// the union of the two cones
+static void merge(signaturet &signature, const signaturet &other)
+{
+  for(std::size_t i = 0; i < signature_size; ++i)
+    signature[i] = std::min(signature[i], other[i]);
+}
+
+/// The \p i'th hash function, applied to the number of a step
+static std::uint32_t step_hash(std::size_t step, std::size_t i)
+{
+  // the finalizer of splitmix64
+  std::uint64_t x = static_cast<std::uint64_t>(step) * 0x9e3779b97f4a7c15u +
+                    (i + 1) * 0xbf58476d1ce4e5b9u;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9u;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebu;
+  return static_cast<std::uint32_t>(x ^ (x >> 31));
+}
+
+/// The estimated similarity of two cones, the fraction of equal values
+static double similarity(const signaturet &a, const signaturet &b)
+{
+  std::size_t equal = 0;
+  for(std::size_t i = 0; i < signature_size; ++i)
+  {
+    if(a[i] == b[i])
+      ++equal;
+  }
+  return static_cast<double>(equal) / signature_size;
+}
+
+/// Hashes a band of \ref band_size values of a signature
+struct band_hasht
+{
+  std::size_t operator()(const std::array<std::uint32_t, band_size> &band) const
+  {
+    std::size_t hash = 0;
+    for(const auto value : band)
+      hash = hash * 0x9e3779b1u + value;
+    return hash;
+  }
+};
+
+std::vector<std::vector<irep_idt>> group_properties_by_cone(
+  const symex_target_equationt &equation,
+  const std::vector<irep_idt> &property_ids,
+  double min_similarity)
+{
+  std::unordered_map<irep_idt, std::size_t> property_numbers;
+  for(const auto &property_id : property_ids)
+    property_numbers.emplace(property_id, property_numbers.size());
+
+  std::vector<signaturet> property_signatures(
+    property_ids.size(), empty_signature());
+
+  // each symbol is assigned once, before it is used, such that the signature
+  // of the cone of an assignment is complete when it is merged into the
+  // cones of the steps that use the symbol
+  std::unordered_map<irep_idt, signaturet> symbol_signatures;
+
+  auto merge_symbols = [&symbol_signatures](
+                         const exprt &expr, signaturet &signature) {
+    find_symbols_sett symbols;
+    find_symbols(expr, symbols, true, false);
+    for(const auto &symbol : symbols)
+    {
+      const auto symbol_signature = symbol_signatures.find(symbol);
+      if(symbol_signature != symbol_signatures.end())
+        merge(signature, symbol_signature->second);
+    }
+  };
+
+  std::size_t step_number = 0;
+  for(const auto &step : equation.SSA_steps)
+  {
+    ++step_number;
+
+    if(step.ignore)
+      continue;
+
+    if(step.is_assignment())
+    {
+      signaturet signature;
+      for(std::size_t i = 0; i < signature_size; ++i)
+        signature[i] = step_hash(step_number, i);
+      merge_symbols(step.guard, signature);
+      merge_symbols(step.ssa_rhs, signature);
+      symbol_signatures[step.ssa_lhs.get_identifier()] = signature;
+    }
+    else if(step.is_assert())
+    {
+      const auto property_number =
+        property_numbers.find(step.get_property_id());
+      if(property_number != property_numbers.end())
+      {
+        signaturet &signature = property_signatures[property_number->second];
+        merge_symbols(step.guard, signature);
+        merge_symbols(step.cond_expr, signature);
+      }
+    }
+  }
+
+  // Properties with similar cones are likely to share all values of some
+  // band of their signatures. Only those that do are compared to the first
+  // property that had the same band.
+  unsigned_union_find groups;
+  groups.resize(property_ids.size());
+
+  typedef std::array<std::uint32_t, band_size> bandt;
+  for(std::size_t offset = 0; offset < signature_size; offset += band_size)
+  {
+    std::unordered_map<bandt, std::size_t, band_hasht> first_with_band;
+    for(std::size_t property = 0; property < property_ids.size(); ++property)
+    {
+      const signaturet &signature = property_signatures[property];
+      bandt band;
+      std::copy(
+        signature.begin() + offset,
+        signature.begin() + offset + band_size,
+        band.begin());
+
+      const auto first = first_with_band.emplace(band, property);
+      if(
+        !first.second &&
+        similarity(signature, property_signatures[first.first->second]) >=
+          min_similarity)
+      {
+        groups.make_union(property, first.first->second);
+      }
+    }
+  }
+
+  std::unordered_map<std::size_t, std::size_t> group_numbers;
+  std::vector<std::vector<irep_idt>> result;
+  for(std::size_t property = 0; property < property_ids.size(); ++property)
+  {
+    const auto group_number =
+      group_numbers.emplace(groups.find(property), result.size());
+    if(group_number.second)
+      result.emplace_back();
+    result[group_number.first->second].push_back(property_ids[property]);
+  }
+
+  std::stable_sort(
+    result.begin(),
+    result.end(),
+    [](const std::vector<irep_idt> &a, const std::vector<irep_idt> &b) {
+      return a.size() > b.size();
+    });
+
+  return result;
+}
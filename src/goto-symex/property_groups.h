@@ -0,0 +1,40 @@
+/*******************************************************************\
+
+Module: Grouping of Properties by their Cones of Influence
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Grouping of Properties by their Cones of Influence
+
+#ifndef CPROVER_GOTO_SYMEX_PROPERTY_GROUPS_H
+#define CPROVER_GOTO_SYMEX_PROPERTY_GROUPS_H
+
+#include <vector>
+
+#include <util/irep.h>
+
+class symex_target_equationt;
+
+/// Partition \p property_ids into groups of properties whose cones of
+/// influence in \p equation overlap heavily, such that each group can be
+/// decided by a solver instance of its own on the equation sliced to the
+/// group. The cone of a property is the set of assignments that its
+/// assertions depend on, through their conditions and guards.
+///
+/// The cones are not computed: a MinHash signature of each is propagated
+/// forward over the equation in a single pass, from which the similarity
+/// of two cones, the size of their intersection relative to their union, is
+/// estimated. Properties whose cones are at least \p min_similarity similar
+/// end up in the same group. Assumptions are ignored, as the slicer keeps
+/// them for all groups.
+/// \return The groups, largest first, with the properties of each in the
+///   order of \p property_ids
+std::vector<std::vector<irep_idt>> group_properties_by_cone(
+  const symex_target_equationt &equation,
+  const std::vector<irep_idt> &property_ids,
+  double min_similarity = 0.5);
+
+#endif // CPROVER_GOTO_SYMEX_PROPERTY_GROUPS_H
@@ -0,0 +1,213 @@
+/*******************************************************************\
+
+Module: Static Pre-Pass for Slicing During Symbolic Execution
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Static Pre-Pass for Slicing During Symbolic Execution
+
+#include "relevant_symbols.h"
+
+#include <util/find_symbols.h>
+#include <util/std_expr.h>
+
+#include <goto-programs/goto_functions.h>
+
+#include <unordered_map>
+#include <vector>
+
+const irep_idt &assigned_symbol(const exprt &lhs)
+{
+  static const irep_idt empty;
+
+  if(lhs.id() == ID_symbol)
+    return to_symbol_expr(lhs).get_identifier();
+  else if(lhs.id() == ID_member)
+    return assigned_symbol(to_member_expr(lhs).compound());
+  else if(lhs.id() == ID_index)
+    return assigned_symbol(to_index_expr(lhs).array());
+  else
+    return empty;
+}
+
+namespace
+{
+class relevant_symbolst
+{
+public:
+  std::unordered_set<irep_idt> relevant;
+
+  explicit relevant_symbolst(const goto_functionst &goto_functions)
+    : goto_functions(goto_functions)
+  {
+    for(const auto &function : goto_functions.function_map)
+    {
+      for(const auto &instruction : function.second.body.instructions)
+        add_instruction(instruction);
+    }
+
+    propagate();
+  }
+
+private:
+  const goto_functionst &goto_functions;
+
+  /// Symbols read when assigning to the key
+  std::unordered_map<irep_idt, std::vector<irep_idt>> dependencies;
+
+  /// Symbols found relevant, but whose dependencies are yet to be visited
+  std::vector<irep_idt> worklist;
+
+  void add_root(const irep_idt &identifier)
+  {
+    if(relevant.insert(identifier).second)
+      worklist.push_back(identifier);
+  }
+
+  void add_roots(const exprt &expr)
+  {
+    find_symbols_sett symbols;
+    find_type_and_expr_symbols(expr, symbols);
+    for(const auto &identifier : symbols)
+      add_root(identifier);
+  }
+
+  void add_dependencies(const irep_idt &identifier, const exprt &expr)
+  {
+    find_symbols_sett symbols;
+    find_type_and_expr_symbols(expr, symbols);
+    auto &entry = dependencies[identifier];
+    entry.insert(entry.end(), symbols.begin(), symbols.end());
+  }
+
+  /// Make the roots of all objects whose address is taken in \p expr
+  /// relevant, as they may be read or written through pointers
+  void add_address_taken(const exprt &expr)
+  {
+    expr.visit_pre([this](const exprt &subexpr) {
+      if(subexpr.id() == ID_address_of)
+        add_roots(to_address_of_expr(subexpr).object());
+    });
+  }
+
+  /// \p lhs is assigned a value computed from \p rhs
+  void add_assignment(const exprt &lhs, const exprt &rhs)
+  {
+    const irep_idt &identifier = assigned_symbol(lhs);
+    if(identifier.empty())
+    {
+      add_roots(lhs);
+      add_roots(rhs);
+    }
+    else
+    {
+      add_dependencies(identifier, lhs);
+      add_dependencies(identifier, rhs);
+    }
+  }
+
+  void add_function_call(const goto_programt::instructiont &instruction)
+  {
+    const code_function_callt &call = instruction.get_function_call();
+    const exprt &function = call.function();
+    const exprt::operandst &arguments = call.arguments();
+
+    if(call.lhs().is_not_nil())
+      add_assignment(call.lhs(), nil_exprt());
+
+    const goto_functionst::function_mapt::const_iterator callee =
+      function.id() == ID_symbol
+        ? goto_functions.function_map.find(
+            to_symbol_expr(function).get_identifier())
+        : goto_functions.function_map.end();
+
+    if(
+      callee == goto_functions.function_map.end() ||
+      !callee->second.body_available())
+    {
+      add_roots(function);
+      for(const auto &argument : arguments)
+        add_roots(argument);
+      return;
+    }
+
+    const auto &parameters = callee->second.parameter_identifiers;
+    for(std::size_t i = 0; i < arguments.size(); ++i)
+    {
+      if(i < parameters.size() && !parameters[i].empty())
+        add_dependencies(parameters[i], arguments[i]);
+      else
+        add_roots(arguments[i]);
+    }
+  }
+
+  void add_instruction(const goto_programt::instructiont &instruction)
+  {
+    instruction.apply([this](const exprt &expr) { add_address_taken(expr); });
+
+    switch(instruction.type)
+    {
+    case ASSIGN:
+      add_assignment(
+        instruction.get_assign().lhs(), instruction.get_assign().rhs());
+      break;
+
+    case DECL:
+      add_dependencies(
+        instruction.get_decl().get_identifier(), instruction.get_decl().symbol());
+      break;
+
+    case DEAD:
+      break;
+
+    case FUNCTION_CALL:
+      add_function_call(instruction);
+      break;
+
+    case GOTO:
+    case ASSUME:
+    case ASSERT:
+    case RETURN:
+    case OTHER:
+    case THROW:
+    case CATCH:
+    case START_THREAD:
+    case END_THREAD:
+    case ATOMIC_BEGIN:
+    case ATOMIC_END:
+    case LOCATION:
+    case SKIP:
+    case END_FUNCTION:
+    case INCOMPLETE_GOTO:
+    case NO_INSTRUCTION_TYPE:
+      instruction.apply([this](const exprt &expr) { add_roots(expr); });
+      break;
+    }
+  }
+
+  void propagate()
+  {
+    while(!worklist.empty())
+    {
+      const irep_idt identifier = worklist.back();
+      worklist.pop_back();
+
+      const auto entry = dependencies.find(identifier);
+      if(entry == dependencies.end())
+        continue;
+
+      for(const auto &dependency : entry->second)
+        add_root(dependency);
+    }
+  }
+};
+} // namespace
+
+std::unordered_set<irep_idt>
+compute_relevant_symbols(const goto_functionst &goto_functions)
+{
+  return relevant_symbolst(goto_functions).relevant;
+}
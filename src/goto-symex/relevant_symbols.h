@@ -0,0 +1,40 @@
+/*******************************************************************\
+
+Module: Static Pre-Pass for Slicing During Symbolic Execution
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Static Pre-Pass for Slicing During Symbolic Execution
+
+#ifndef CPROVER_GOTO_SYMEX_RELEVANT_SYMBOLS_H
+#define CPROVER_GOTO_SYMEX_RELEVANT_SYMBOLS_H
+
+#include <util/irep.h>
+
+#include <unordered_set>
+
+class exprt;
+class goto_functionst;
+
+/// Flow-insensitive over-approximation of the symbols whose values may
+/// affect a property of \p goto_functions. These are the symbols read by
+/// assertions, assumptions and branch conditions, symbols whose address is
+/// taken, symbols read by instructions other than assignments, declarations
+/// and function calls, and, transitively, the symbols read when assigning to
+/// a relevant symbol or when passing an argument to a relevant parameter.
+///
+/// Symbolic execution need not execute an assignment whose left-hand side
+/// is (a member or element of) a symbol that is not relevant: the value
+/// assigned is only ever read by other such assignments.
+std::unordered_set<irep_idt>
+compute_relevant_symbols(const goto_functionst &goto_functions);
+
+/// \return the symbol written by an assignment to \p lhs, i.e., \p lhs with
+///   any member and index expressions removed, or an empty identifier if
+///   the assignment writes through a pointer or to some other expression
+const irep_idt &assigned_symbol(const exprt &lhs);
+
+#endif // CPROVER_GOTO_SYMEX_RELEVANT_SYMBOLS_H
@@ -53,6 +53,10 @@ void symex_slicet::slice(symex_target_equationt &equation)
 
 void symex_slicet::slice(SSA_stept &SSA_step)
 {
+  // steps that are ignored are not converted, and thus keep nothing alive
+  if(SSA_step.ignore)
+    return;
+
   get_symbols(SSA_step.guard);
 
   switch(SSA_step.type)
@@ -169,6 +169,10 @@ public:
   // for incremental conversion
   bool converted = false;
 
+  // for CONSTRAINT: only converted once a model violates it, see
+  // symex_target_equationt::convert_violated_constraints
+  bool lazy = false;
+
   SSA_stept(
     const symex_targett::sourcet &_source,
     goto_trace_stept::typet _type)
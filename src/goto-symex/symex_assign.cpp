@@ -12,11 +12,14 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "symex_assign.h"
 
 #include "expr_skeleton.h"
+#include "formula_cost.h"
 #include "goto_symex.h"
 #include "goto_symex_state.h"
 #include <util/byte_operators.h>
 #include <util/expr_util.h>
 #include <util/format_expr.h>
+#include <util/pointer_predicates.h>
+#include <util/prefix.h>
 
 // We can either use with_exprt or update_exprt when building expressions that
 // modify components of an array or a struct. Set USE_UPDATE to use
@@ -142,23 +145,60 @@ void symex_assignt::assign_from_struct(
       lhs_field.id() == ID_symbol,
       "member of symbol should be susceptible to field-sensitivity");
 
+    // fields that keep their value do not need a new version
+    if(guard.empty() && keeps_value(to_ssa_expr(lhs_field), comp_rhs.second))
+      continue;
+
     assign_symbol(to_ssa_expr(lhs_field), full_lhs, comp_rhs.second, guard);
   }
 }
 
+bool symex_assignt::keeps_value(const ssa_exprt &lhs, const exprt &rhs)
+{
+  // writes to shared variables are events that other threads may observe
+  if(
+    state.write_is_shared(lhs, ns) !=
+    goto_symex_statet::write_is_shared_resultt::NOT_SHARED)
+  {
+    return false;
+  }
+
+  state.record_events.push(false);
+  const exprt current_value = state.rename(lhs, ns).get();
+  exprt l2_rhs = state.rename(rhs, ns).get();
+  state.record_events.pop();
+
+  if(symex_config.simplify_opt)
+    l2_rhs = simplify_expr(std::move(l2_rhs), ns);
+
+  return current_value == l2_rhs;
+}
+
 void symex_assignt::assign_non_struct_symbol(
   const ssa_exprt &lhs, // L1
   const expr_skeletont &full_lhs,
   const exprt &rhs,
   const exprt::operandst &guard)
 {
+  // A summary object stands for several allocated objects, of which the
+  // assignment updates any one: it may keep its previous value.
+  exprt weak_rhs = rhs;
+  if(has_prefix(id2string(lhs.get_object_name()), SYMEX_SUMMARY_OBJECT_PREFIX))
+  {
+    const std::string choice_name =
+      "symex::weak_update!" + id2string(lhs.get_identifier()) + "#" +
+      std::to_string(state.get_level2().latest_index(lhs.get_identifier()));
+    weak_rhs =
+      if_exprt{nondet_symbol_exprt{choice_name, bool_typet{}}, rhs, lhs};
+  }
+
   exprt l2_rhs =
     state
       .rename(
         // put assignment guard into the rhs
         guard.empty()
-          ? rhs
-          : static_cast<exprt>(if_exprt{conjunction(guard), rhs, lhs}),
+          ? weak_rhs
+          : static_cast<exprt>(if_exprt{conjunction(guard), weak_rhs, lhs}),
         ns)
       .get();
 
@@ -177,6 +217,19 @@ void symex_assignt::assign_non_struct_symbol(
                                symex_config.allow_pointer_unsoundness)
                              .get();
 
+  if(symex_config.complexity_limits_active)
+    state.formula_cost += estimate_formula_cost(assignment.rhs, ns);
+
+  // A constant that has been recorded for propagation replaces the symbol in
+  // all its uses, and is kept when merging states.
+  if(
+    symex_config.omit_constant_assignments &&
+    !state.field_sensitivity.is_divisible(assignment.lhs) &&
+    state.propagation.find(assignment.lhs.get_identifier()).has_value())
+  {
+    return;
+  }
+
   state.record_events.push(false);
   // Note any other symbols mentioned in the skeleton are rvalues -- for example
   // array indices -- and were renamed to L2 at the start of
@@ -254,7 +307,8 @@ void symex_assignt::assign_array(
   const exprt &lhs_index=lhs.index();
   const typet &lhs_index_type = lhs_array.type();
 
-  PRECONDITION(lhs_index_type.id() == ID_array);
+  PRECONDITION(
+    lhs_index_type.id() == ID_array || lhs_index_type.id() == ID_vector);
 
   if(use_update)
   {
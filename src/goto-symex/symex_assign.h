@@ -68,6 +68,10 @@ private:
     const struct_exprt &rhs,
     const exprt::operandst &guard);
 
+  /// \return True if the value of \p lhs, which is renamed to L1, is
+  ///   \p rhs already, such that assigning \p rhs would not change it
+  bool keeps_value(const ssa_exprt &lhs, const exprt &rhs);
+
   void assign_non_struct_symbol(
     const ssa_exprt &lhs, // L1
     const expr_skeletont &full_lhs,
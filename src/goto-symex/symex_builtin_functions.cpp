@@ -157,17 +157,63 @@ void goto_symext::symex_allocate(
     }
   }
 
+  typet value_type = *object_type;
+  value_type.set(ID_C_dynamic, true);
+
+  // With a bounded heap, allocations at this site beyond the bound share a
+  // summary object of the same type. Assignments to it are weak updates, see
+  // symex_assignt::assign_non_struct_symbol.
+  optionalt<symbol_exprt> summary_object;
+  if(symex_config.allocation_site_bound != 0)
+  {
+    const unsigned caller =
+      state.call_stack().size() > 1
+        ? state.call_stack().top().calling_location.pc->location_number
+        : 0;
+    allocation_sitet &site =
+      allocation_sites[{state.source.pc->location_number, caller}];
+    if(site.count < symex_config.allocation_site_bound)
+      ++site.count;
+    else if(!site.summary_object.has_value())
+    {
+      symbolt summary_symbol;
+      summary_symbol.base_name =
+        "summary_object" + std::to_string(dynamic_counter);
+      summary_symbol.name =
+        SYMEX_SUMMARY_OBJECT_PREFIX + std::to_string(dynamic_counter);
+      summary_symbol.is_lvalue = true;
+      summary_symbol.type = value_type;
+      summary_symbol.mode = mode;
+      state.symbol_table.add(summary_symbol);
+      site.summary_object = summary_symbol.symbol_expr();
+      summary_object = site.summary_object;
+    }
+    else if(site.summary_object->type() == value_type)
+    {
+      // the type of a variable-length array differs between allocations, in
+      // which case we fall back to a fresh object
+      summary_object = site.summary_object;
+    }
+  }
+
   // value
   symbolt value_symbol;
 
-  value_symbol.base_name="dynamic_object"+std::to_string(dynamic_counter);
-  value_symbol.name = SYMEX_DYNAMIC_PREFIX + id2string(value_symbol.base_name);
-  value_symbol.is_lvalue=true;
-  value_symbol.type = *object_type;
-  value_symbol.type.set(ID_C_dynamic, true);
-  value_symbol.mode = mode;
+  if(summary_object.has_value())
+  {
+    value_symbol =
+      state.symbol_table.lookup_ref(summary_object->get_identifier());
+  }
+  else
+  {
+    value_symbol.base_name="dynamic_object"+std::to_string(dynamic_counter);
+    value_symbol.name = SYMEX_DYNAMIC_PREFIX + id2string(value_symbol.base_name);
+    value_symbol.is_lvalue=true;
+    value_symbol.type = value_type;
+    value_symbol.mode = mode;
 
-  state.symbol_table.add(value_symbol);
+    state.symbol_table.add(value_symbol);
+  }
 
   // to allow constant propagation
   exprt zero_init = state.rename(to_binary_expr(code).op1(), ns).get();
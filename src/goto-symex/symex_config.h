@@ -22,14 +22,40 @@ struct symex_configt final
 
   bool doing_path_exploration;
 
+  /// In path exploration, merge the branches of single-entry, single-exit
+  /// regions of at most this many instructions, or zero to never merge
+  std::size_t merge_region_size;
+
   bool allow_pointer_unsoundness;
 
   bool constant_propagation;
 
+  /// Do not record assignments of values that constant propagation
+  /// substitutes wherever the assigned symbol is read. These steps only serve
+  /// to show the values in traces.
+  bool omit_constant_assignments;
+
   bool self_loops_to_assumptions;
 
   bool simplify_opt;
 
+  /// Maximum number of simplification results to cache during symex, or zero
+  /// to disable caching
+  std::size_t simplify_cache_size;
+
+  /// Reuse the case split built for a pointer whose L2 name has been
+  /// dereferenced before, and share the case splits that are read through
+  /// symbols, see \ref goto_symext::dereference_rec
+  bool cache_dereferences;
+
+  /// Number of objects allocated at each allocation site before further
+  /// allocations at that site share a summary object, or zero for no bound
+  std::size_t allocation_site_bound;
+
+  /// Number of BDD nodes up to which guards are kept as BDDs, or zero for
+  /// guards that are always expressions, see \ref guard_hybridt
+  std::size_t guard_bdd_nodes;
+
   bool unwinding_assertions;
 
   bool partial_loops;
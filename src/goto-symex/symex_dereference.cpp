@@ -17,11 +17,14 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/exception_utils.h>
 #include <util/expr_iterator.h>
 #include <util/expr_util.h>
+#include <util/fresh_symbol.h>
 #include <util/invariant.h>
 #include <util/pointer_offset_size.h>
 
 #include <pointer-analysis/value_set_dereference.h>
 
+#include "expr_skeleton.h"
+#include "symex_assign.h"
 #include "symex_dereference_state.h"
 
 /// Transforms an lvalue expression by replacing any dereference operations it
@@ -36,11 +39,14 @@ Author: Daniel Kroening, kroening@kroening.com
 /// \param keep_array: if true and an underlying object is an array, return
 ///   its address (`&array`); otherwise return the address of its first element
 ///   (`&array[0]).
+/// \param is_in_quantifier: whether \p expr is within the scope of a
+///   quantifier, see \ref goto_symext::dereference_rec
 /// \return the transformed lvalue expression
 exprt goto_symext::address_arithmetic(
   const exprt &expr,
   statet &state,
-  bool keep_array)
+  bool keep_array,
+  bool is_in_quantifier)
 {
   exprt result;
 
@@ -53,7 +59,7 @@ exprt goto_symext::address_arithmetic(
     const byte_extract_exprt &be=to_byte_extract_expr(expr);
 
     // recursive call
-    result = address_arithmetic(be.op(), state, keep_array);
+    result = address_arithmetic(be.op(), state, keep_array, is_in_quantifier);
 
     if(be.op().type().id() == ID_array && result.id() == ID_address_of)
     {
@@ -71,7 +77,7 @@ exprt goto_symext::address_arithmetic(
 
     // there could be further dereferencing in the offset
     exprt offset=be.offset();
-    dereference_rec(offset, state, false);
+    dereference_rec(offset, state, false, is_in_quantifier);
 
     result=plus_exprt(result, offset);
 
@@ -96,7 +102,7 @@ exprt goto_symext::address_arithmetic(
       byte_extract_id(), ode.root_object(), ode.offset(), expr.type());
 
     // recursive call
-    result = address_arithmetic(be, state, keep_array);
+    result = address_arithmetic(be, state, keep_array, is_in_quantifier);
 
     do_simplify(result);
   }
@@ -107,20 +113,22 @@ exprt goto_symext::address_arithmetic(
     // just grab the pointer, but be wary of further dereferencing
     // in the pointer itself
     result=to_dereference_expr(expr).pointer();
-    dereference_rec(result, state, false);
+    dereference_rec(result, state, false, is_in_quantifier);
   }
   else if(expr.id()==ID_if)
   {
     if_exprt if_expr=to_if_expr(expr);
 
     // the condition is not an address
-    dereference_rec(if_expr.cond(), state, false);
+    dereference_rec(if_expr.cond(), state, false, is_in_quantifier);
 
     // recursive call
     if_expr.true_case() =
-      address_arithmetic(if_expr.true_case(), state, keep_array);
+      address_arithmetic(
+        if_expr.true_case(), state, keep_array, is_in_quantifier);
     if_expr.false_case() =
-      address_arithmetic(if_expr.false_case(), state, keep_array);
+      address_arithmetic(
+        if_expr.false_case(), state, keep_array, is_in_quantifier);
 
     result=if_expr;
   }
@@ -131,7 +139,7 @@ exprt goto_symext::address_arithmetic(
   {
     // give up, just dereference
     result=expr;
-    dereference_rec(result, state, false);
+    dereference_rec(result, state, false, is_in_quantifier);
 
     // turn &array into &array[0]
     if(result.type().id() == ID_array && !keep_array)
@@ -155,7 +163,7 @@ exprt goto_symext::address_arithmetic(
         from_integer(offset, index_type()),
         expr.type());
 
-      result = address_arithmetic(be, state, keep_array);
+      result = address_arithmetic(be, state, keep_array, is_in_quantifier);
 
       do_simplify(result);
     }
@@ -166,7 +174,8 @@ exprt goto_symext::address_arithmetic(
   {
     const typecast_exprt &tc_expr = to_typecast_expr(expr);
 
-    result = address_arithmetic(tc_expr.op(), state, keep_array);
+    result =
+      address_arithmetic(tc_expr.op(), state, keep_array, is_in_quantifier);
 
     // treat &array as &array[0]
     const typet &expr_type = expr.type();
@@ -199,7 +208,18 @@ exprt goto_symext::address_arithmetic(
 /// such as `&struct.flexible_array[0]` (see inline comments in code).
 /// For full details of this method's pointer replacement and potential side-
 /// effects see \ref goto_symext::dereference
-void goto_symext::dereference_rec(exprt &expr, statet &state, bool write)
+///
+/// With the `symex-cache-dereferences` option the case split built for a
+/// pointer is kept by the L2 name of the pointer and reused for later
+/// dereferences of it, and case splits that are read are assigned to a symbol
+/// that all reads of the same case split share, see
+/// \ref goto_symext::cache_dereference. \p is_in_quantifier tells whether
+/// \p expr is within the scope of a quantifier, where the latter is not done.
+void goto_symext::dereference_rec(
+  exprt &expr,
+  statet &state,
+  bool write,
+  bool is_in_quantifier)
 {
   if(expr.id()==ID_dereference)
   {
@@ -222,7 +242,7 @@ void goto_symext::dereference_rec(exprt &expr, statet &state, bool write)
     tmp1.swap(to_dereference_expr(expr).pointer());
 
     // first make sure there are no dereferences in there
-    dereference_rec(tmp1, state, false);
+    dereference_rec(tmp1, state, false, is_in_quantifier);
 
     // Depending on the nature of the pointer expression, the recursive deref
     // operation might have introduced a construct such as
@@ -256,24 +276,59 @@ void goto_symext::dereference_rec(exprt &expr, statet &state, bool write)
 
     tmp1 = state.field_sensitivity.apply(ns, state, std::move(tmp1), false);
 
-    // we need to set up some elaborate call-backs
-    symex_dereference_statet symex_dereference_state(state, ns);
+    // The value set of an L1 pointer only changes together with its L2
+    // name, hence dereferencing the same L2 pointer again yields the same
+    // case split over the same L1 objects.
+    optionalt<dereference_result_keyt> result_key;
+    if(symex_config.cache_dereferences)
+    {
+      result_key =
+        dereference_result_keyt{state.rename(tmp1, ns).get(), expr_is_not_null};
+    }
 
-    value_set_dereferencet dereference(
-      ns,
-      state.symbol_table,
-      symex_dereference_state,
-      language_mode,
-      expr_is_not_null);
+    const auto result_it = result_key.has_value()
+                             ? dereference_results.find(*result_key)
+                             : dereference_results.end();
 
-    // std::cout << "**** " << format(tmp1) << '\n';
-    exprt tmp2 = dereference.dereference(tmp1);
-    // std::cout << "**** " << format(tmp2) << '\n';
+    exprt tmp2;
 
-    expr.swap(tmp2);
+    if(result_it != dereference_results.end())
+      tmp2 = result_it->second;
+    else
+    {
+      // we need to set up some elaborate call-backs
+      symex_dereference_statet symex_dereference_state(state, ns);
+
+      value_set_dereferencet dereference(
+        ns,
+        state.symbol_table,
+        symex_dereference_state,
+        language_mode,
+        expr_is_not_null);
+
+      // std::cout << "**** " << format(tmp1) << '\n';
+      tmp2 = dereference.dereference(tmp1);
+      // std::cout << "**** " << format(tmp2) << '\n';
+
+      if(result_key.has_value())
+        dereference_results.emplace(std::move(*result_key), tmp2);
+    }
 
     // this may yield a new auto-object
-    trigger_auto_object(expr, state);
+    trigger_auto_object(tmp2, state);
+
+    // Only case splits are worth sharing, and the symbol they are assigned
+    // to must neither be written to nor depend on bound variables, including
+    // those of let expressions, which are lifted later.
+    if(
+      symex_config.cache_dereferences && !write && !is_in_quantifier &&
+      state.threads.size() == 1 && tmp2.id() == ID_if &&
+      !has_subexpr(tmp2, ID_let))
+    {
+      expr = cache_dereference(tmp2, state);
+    }
+    else
+      expr.swap(tmp2);
   }
   else if(
     expr.id() == ID_index && to_index_expr(expr).array().id() == ID_member &&
@@ -292,7 +347,7 @@ void goto_symext::dereference_rec(exprt &expr, statet &state, bool write)
     tmp.add_source_location()=expr.source_location();
 
     // recursive call
-    dereference_rec(tmp, state, write);
+    dereference_rec(tmp, state, write, is_in_quantifier);
 
     expr.swap(tmp);
   }
@@ -311,7 +366,8 @@ void goto_symext::dereference_rec(exprt &expr, statet &state, bool write)
     expr = address_arithmetic(
       object,
       state,
-      to_pointer_type(expr.type()).subtype().id() == ID_array);
+      to_pointer_type(expr.type()).subtype().id() == ID_array,
+      is_in_quantifier);
   }
   else if(expr.id()==ID_typecast)
   {
@@ -330,20 +386,56 @@ void goto_symext::dereference_rec(exprt &expr, statet &state, bool write)
             to_address_of_expr(tc_op).object(),
             from_integer(0, index_type())));
 
-      dereference_rec(expr, state, write);
+      dereference_rec(expr, state, write, is_in_quantifier);
     }
     else
     {
-      dereference_rec(tc_op, state, write);
+      dereference_rec(tc_op, state, write, is_in_quantifier);
     }
   }
   else
   {
+    const bool is_quantifier =
+      expr.id() == ID_forall || expr.id() == ID_exists;
+
     Forall_operands(it, expr)
-      dereference_rec(*it, state, write);
+      dereference_rec(*it, state, write, is_in_quantifier || is_quantifier);
   }
 }
 
+symbol_exprt
+goto_symext::cache_dereference(const exprt &dereference_result, statet &state)
+{
+  // the L2 names identify the values of the objects in the case split
+  exprt cache_key = state.rename(dereference_result, ns).get();
+
+  const auto cached = state.dereference_cache.find(cache_key);
+  if(cached)
+    return cached->get();
+
+  const symbolt &cache_symbol = get_fresh_aux_symbol(
+    dereference_result.type(),
+    "symex",
+    "dereference_cache",
+    dereference_result.source_location(),
+    language_mode,
+    ns,
+    state.symbol_table);
+  const symbol_exprt cache_symbol_expr = cache_symbol.symbol_expr();
+
+  exprt::operandst guard;
+  symex_assignt{
+    state, symex_targett::assignment_typet::HIDDEN, ns, symex_config, target}
+    .assign_symbol(
+      to_ssa_expr(state.rename<L1>(cache_symbol_expr, ns).get()),
+      expr_skeletont{},
+      cache_key,
+      guard);
+
+  state.dereference_cache.insert(std::move(cache_key), cache_symbol_expr);
+  return cache_symbol_expr;
+}
+
 static exprt
 apply_to_objects_in_dereference(exprt e, const std::function<exprt(exprt)> &f)
 {
@@ -408,7 +500,7 @@ void goto_symext::dereference(exprt &expr, statet &state, bool write)
   });
 
   // start the recursion!
-  dereference_rec(expr, state, write);
+  dereference_rec(expr, state, write, false);
   // dereferencing may introduce new symbol_exprt
   // (like __CPROVER_memory)
   expr = state.rename<L1>(std::move(expr), ns).get();
@@ -305,6 +305,13 @@ void goto_symext::symex_function_call_code(
   PRECONDITION(!state.call_stack().empty());
   framet &frame = state.call_stack().new_frame(state.source, state.guard);
 
+  if(
+    symex_config.doing_path_exploration &&
+    symex_config.merge_region_size != 0)
+  {
+    path_storage.add_function_regions(identifier, goto_function.body);
+  }
+
   // Only enable loop analysis when complexity is enabled.
   if(symex_config.complexity_limits_active)
   {
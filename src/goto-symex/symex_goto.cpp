@@ -11,8 +11,10 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "goto_symex.h"
 #include "goto_symex_is_constant.h"
+#include "symex_telemetry.h"
 
 #include <algorithm>
+#include <vector>
 
 #include <util/exception_utils.h>
 #include <util/expr_util.h>
@@ -268,15 +270,41 @@ void goto_symext::symex_goto(statet &state)
       return;
     }
 
-    const auto loop_id =
-      goto_programt::loop_id(state.source.function_id, *state.source.pc);
+    const irep_idt loop_id =
+      get_loop_id(state.source.function_id, *state.source.pc);
 
     unsigned &unwind = state.call_stack().top().loop_iterations[loop_id].count;
     unwind++;
 
+    if(get_symex_telemetry().is_enabled())
+      get_symex_telemetry().loop_unwound(loop_id, unwind);
+
     if(should_stop_unwind(state.source, state.call_stack(), unwind))
     {
-      loop_bound_exceeded(state, new_guard);
+      if(
+        symex_config.doing_path_exploration &&
+        path_storage.defer_exceeded_loops)
+      {
+        // Save the path to continue the loop once the bound has been raised.
+        // Resuming it executes this goto, and counts the iteration, again.
+        path_storage.deferred_paths.emplace_back(target, state);
+        goto_symex_statet &deferred = path_storage.deferred_paths.back().state;
+        --deferred.call_stack().top().loop_iterations[loop_id].count;
+        deferred.saved_target = goto_target;
+        deferred.has_saved_jump_target = false;
+        deferred.has_saved_next_instruction = true;
+
+        log.debug() << "Deferring iterations of loop " << loop_id
+                    << " beyond the unwinding bound" << log.eom;
+
+        // this path leaves the loop, without an unwinding assertion
+        if(new_guard.is_true())
+          symex_assume_l2(state, false_exprt());
+        else
+          symex_assume_l2(state, not_exprt(new_guard));
+      }
+      else
+        loop_bound_exceeded(state, new_guard);
 
       // next instruction
       symex_transition(state);
@@ -298,8 +326,9 @@ void goto_symext::symex_goto(statet &state)
     // around this GOTO instruction)
     (state.guard.is_true() ||
      // or there is another block, but we're doing path exploration so
-     // we're going to skip over it for now and return to it later.
-     symex_config.doing_path_exploration))
+     // we're going to skip over it for now and return to it later, unless
+     // the branches of this region are merged.
+     (symex_config.doing_path_exploration && !should_merge_branches(state))))
   {
     DATA_INVARIANT(
       instruction.targets.size() > 0,
@@ -366,7 +395,8 @@ void goto_symext::symex_goto(statet &state)
     log.debug() << "Resuming from next instruction '"
                 << state_pc->source_location << "'" << log.eom;
   }
-  else if(symex_config.doing_path_exploration)
+  else if(
+    symex_config.doing_path_exploration && !should_merge_branches(state))
   {
     // We should save both the instruction after this goto, and the target of
     // the goto.
@@ -398,16 +428,21 @@ void goto_symext::symex_goto(statet &state)
     return;
   }
 
-  // put a copy of the current state into the state-queue, to be used by
-  // merge_gotos when we visit new_state_pc
-  framet::goto_state_listt &goto_state_list =
-    state.call_stack().top().goto_state_map[new_state_pc];
+  // A resumed path only continues with the branch that was saved, as the
+  // other one is explored by a path of its own.
+  const bool resuming =
+    state.has_saved_jump_target || state.has_saved_next_instruction;
 
   // On an unconditional GOTO we don't need our state, as it will be overwritten
   // by merge_goto. Therefore we move it onto goto_state_list instead of copying
   // as usual.
   if(new_guard.is_true())
   {
+    // put the current state into the state-queue, to be used by merge_gotos
+    // when we visit new_state_pc
+    framet::goto_state_listt &goto_state_list =
+      state.call_stack().top().goto_state_map[new_state_pc];
+
     // The move here only moves goto_statet, the base class of goto_symex_statet
     // and not the entire thing.
     goto_state_list.emplace_back(state.source, std::move(state));
@@ -419,7 +454,16 @@ void goto_symext::symex_goto(statet &state)
   }
   else
   {
-    goto_state_list.emplace_back(state.source, state);
+    // put a copy of the current state into the state-queue, to be used by
+    // merge_gotos when we visit new_state_pc
+    goto_statet *new_state = nullptr;
+    if(!resuming)
+    {
+      framet::goto_state_listt &goto_state_list =
+        state.call_stack().top().goto_state_map[new_state_pc];
+      goto_state_list.emplace_back(state.source, state);
+      new_state = &goto_state_list.back().second;
+    }
 
     symex_transition(state, state_pc, backward);
 
@@ -427,9 +471,9 @@ void goto_symext::symex_goto(statet &state)
     {
       // This doesn't work for --paths (single-path mode) yet, as in multi-path
       // mode we remove the implied constants at a control-flow merge, but in
-      // single-path mode we don't run merge_gotos.
-      auto &taken_state = backward ? state : goto_state_list.back().second;
-      auto &not_taken_state = backward ? goto_state_list.back().second : state;
+      // single-path mode we only run merge_gotos for some regions.
+      auto &taken_state = backward ? state : *new_state;
+      auto &not_taken_state = backward ? *new_state : state;
 
       apply_goto_condition(
         state,
@@ -490,21 +534,45 @@ void goto_symext::symex_goto(statet &state)
     }
     else
     {
-      goto_statet &new_state = goto_state_list.back().second;
       if(!backward)
       {
-        new_state.guard.add(guard_expr);
+        if(new_state != nullptr)
+          new_state->guard.add(guard_expr);
         state.guard.add(boolean_negate(guard_expr));
       }
       else
       {
         state.guard.add(guard_expr);
-        new_state.guard.add(boolean_negate(guard_expr));
+        if(new_state != nullptr)
+          new_state->guard.add(boolean_negate(guard_expr));
       }
     }
   }
 }
 
+bool goto_symext::should_merge_branches(const statet &state) const
+{
+  if(symex_config.merge_region_size == 0)
+    return false;
+
+  // within a region that is being merged
+  for(const auto &frame : state.call_stack())
+  {
+    if(!frame.goto_state_map.empty())
+      return true;
+  }
+
+  const auto regions = path_storage.sese_regions.find(state.source.function_id);
+  if(regions == path_storage.sese_regions.end())
+    return false;
+
+  const auto exit = regions->second.get_region_exit(state.source.pc);
+  return exit.has_value() &&
+         (*exit)->location_number > state.source.pc->location_number &&
+         (*exit)->location_number - state.source.pc->location_number <=
+           symex_config.merge_region_size;
+}
+
 void goto_symext::symex_unreachable_goto(statet &state)
 {
   PRECONDITION(!state.reachable);
@@ -666,8 +734,30 @@ void goto_symext::merge_goto(
       // merge value sets
       state.value_set.make_union(goto_state.value_set);
 
+      // keep the cached dereferences that both branches agree on
+      sharing_mapt<exprt, symbol_exprt, false, irep_hash>::delta_viewt
+        delta_view;
+      state.dereference_cache.get_delta_view(
+        goto_state.dereference_cache, delta_view, false);
+      std::vector<exprt> disagreeing;
+      for(const auto &delta_item : delta_view)
+      {
+        if(
+          !delta_item.is_in_both_maps() ||
+          delta_item.m != delta_item.get_other_map_value())
+        {
+          disagreeing.push_back(delta_item.k);
+        }
+      }
+      for(const auto &key : disagreeing)
+        state.dereference_cache.erase(key);
+
       // adjust depth
       state.depth = std::min(state.depth, goto_state.depth);
+
+      // keep the cost of the more expensive branch
+      state.formula_cost =
+        std::max(state.formula_cost, goto_state.formula_cost);
     }
   }
 
@@ -680,7 +770,8 @@ void goto_symext::merge_goto(
 /// \param goto_state: first state
 /// \param [in, out] dest_state: second state
 /// \param ns: namespace
-/// \param diff_guard: difference between the guards of the two states
+/// \param diff_guard: difference between the guards of the two states, as an
+///   expression
 /// \param [out] log: logger for debug messages
 /// \param do_simplify: should the right-hand-side of the assignment that is
 ///   added to the target be simplified
@@ -694,7 +785,7 @@ static void merge_names(
   const goto_statet &goto_state,
   goto_symext::statet &dest_state,
   const namespacet &ns,
-  const guardt &diff_guard,
+  const exprt &diff_guard,
   messaget &log,
   const bool do_simplify,
   symex_target_equationt &target,
@@ -747,23 +838,27 @@ static void merge_names(
 
   exprt goto_state_rhs = ssa, dest_state_rhs = ssa;
 
-  {
-    const auto p_it = goto_state.propagation.find(l1_identifier);
+  const auto goto_p_it = goto_state.propagation.find(l1_identifier);
+  const auto dest_p_it = dest_state.propagation.find(l1_identifier);
 
-    if(p_it.has_value())
-      goto_state_rhs = *p_it;
-    else
-      to_ssa_expr(goto_state_rhs).set_level_2(goto_count);
+  // the same constant on both branches: reads of the merged state are
+  // replaced by the constant anyway, no new name is needed
+  if(
+    goto_p_it.has_value() && dest_p_it.has_value() &&
+    goto_p_it->get() == dest_p_it->get())
+  {
+    return;
   }
 
-  {
-    const auto p_it = dest_state.propagation.find(l1_identifier);
+  if(goto_p_it.has_value())
+    goto_state_rhs = *goto_p_it;
+  else
+    to_ssa_expr(goto_state_rhs).set_level_2(goto_count);
 
-    if(p_it.has_value())
-      dest_state_rhs = *p_it;
-    else
-      to_ssa_expr(dest_state_rhs).set_level_2(dest_count);
-  }
+  if(dest_p_it.has_value())
+    dest_state_rhs = *dest_p_it;
+  else
+    to_ssa_expr(dest_state_rhs).set_level_2(dest_count);
 
   exprt rhs;
 
@@ -783,7 +878,7 @@ static void merge_names(
     rhs = goto_state_rhs;
   else
   {
-    rhs = if_exprt(diff_guard.as_expr(), goto_state_rhs, dest_state_rhs);
+    rhs = if_exprt(diff_guard, goto_state_rhs, dest_state_rhs);
     if(do_simplify)
       simplify(rhs, ns);
   }
@@ -819,34 +914,31 @@ void goto_symext::phi_function(
     dest_state.get_level2().current_names.empty())
     return;
 
-  guardt diff_guard = goto_state.guard;
-  // this gets the diff between the guards
-  diff_guard -= dest_state.guard;
-
+  // Collect the names that differ between the two states first: the delta
+  // views share the unchanged parts of the renaming maps, and merging must
+  // not modify the maps while they are being traversed.
   symex_renaming_levelt::delta_viewt delta_view;
   goto_state.get_level2().current_names.get_delta_view(
     dest_state.get_level2().current_names, delta_view, false);
 
+  struct changed_namet
+  {
+    ssa_exprt ssa;
+    std::size_t goto_count;
+    std::size_t dest_count;
+  };
+  std::vector<changed_namet> changed_names;
+  changed_names.reserve(delta_view.size());
+
   for(const auto &delta_item : delta_view)
   {
-    const ssa_exprt &ssa = delta_item.m.first;
-    unsigned goto_count = delta_item.m.second;
-    unsigned dest_count = !delta_item.is_in_both_maps()
-                            ? 0
-                            : delta_item.get_other_map_value().second;
+    const std::size_t goto_count = delta_item.m.second;
+    const std::size_t dest_count = !delta_item.is_in_both_maps()
+                                     ? 0
+                                     : delta_item.get_other_map_value().second;
 
-    merge_names(
-      goto_state,
-      dest_state,
-      ns,
-      diff_guard,
-      log,
-      symex_config.simplify_opt,
-      target,
-      path_storage.dirty,
-      ssa,
-      goto_count,
-      dest_count);
+    if(goto_count != dest_count)
+      changed_names.push_back({delta_item.m.first, goto_count, dest_count});
   }
 
   delta_view.clear();
@@ -855,25 +947,32 @@ void goto_symext::phi_function(
 
   for(const auto &delta_item : delta_view)
   {
-    if(delta_item.is_in_both_maps())
-      continue;
+    if(!delta_item.is_in_both_maps() && delta_item.m.second != 0)
+      changed_names.push_back({delta_item.m.first, 0, delta_item.m.second});
+  }
 
-    const ssa_exprt &ssa = delta_item.m.first;
-    unsigned goto_count = 0;
-    unsigned dest_count = delta_item.m.second;
+  if(changed_names.empty())
+    return;
 
+  guardt diff_guard = goto_state.guard;
+  // this gets the diff between the guards
+  diff_guard -= dest_state.guard;
+  const exprt diff_guard_expr = diff_guard.as_expr();
+
+  for(const auto &changed_name : changed_names)
+  {
     merge_names(
       goto_state,
       dest_state,
       ns,
-      diff_guard,
+      diff_guard_expr,
       log,
       symex_config.simplify_opt,
       target,
       path_storage.dirty,
-      ssa,
-      goto_count,
-      dest_count);
+      changed_name.ssa,
+      changed_name.goto_count,
+      changed_name.dest_count);
   }
 }
 
@@ -920,3 +1019,17 @@ bool goto_symext::should_stop_unwind(
   // by default, we keep going
   return false;
 }
+
+const irep_idt &goto_symext::get_loop_id(
+  const irep_idt &function_id,
+  const goto_programt::instructiont &instruction)
+{
+  std::vector<irep_idt> &ids = loop_ids[function_id];
+  if(instruction.loop_number >= ids.size())
+    ids.resize(instruction.loop_number + 1);
+
+  irep_idt &id = ids[instruction.loop_number];
+  if(id.empty())
+    id = goto_programt::loop_id(function_id, instruction);
+  return id;
+}
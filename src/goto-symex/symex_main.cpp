@@ -10,6 +10,7 @@ Author: Daniel Kroening, kroening@kroening.com
 /// Symbolic Execution
 
 #include "goto_symex.h"
+#include "symex_telemetry.h"
 
 #include <memory>
 
@@ -21,6 +22,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/invariant.h>
 #include <util/make_unique.h>
 #include <util/mathematical_expr.h>
+#include <util/profiler.h>
 #include <util/replace_symbol.h>
 #include <util/std_expr.h>
 #include <util/string2int.h>
@@ -34,12 +36,20 @@ Author: Daniel Kroening, kroening@kroening.com
 symex_configt::symex_configt(const optionst &options)
   : max_depth(options.get_unsigned_int_option("depth")),
     doing_path_exploration(options.is_set("paths")),
+    merge_region_size(options.get_unsigned_int_option("paths-merge-regions")),
     allow_pointer_unsoundness(
       options.get_bool_option("allow-pointer-unsoundness")),
     constant_propagation(options.get_bool_option("propagation")),
+    omit_constant_assignments(
+      options.get_bool_option("omit-constant-assignments")),
     self_loops_to_assumptions(
       options.get_bool_option("self-loops-to-assumptions")),
     simplify_opt(options.get_bool_option("simplify")),
+    simplify_cache_size(options.get_unsigned_int_option("simplify-cache-size")),
+    cache_dereferences(options.get_bool_option("symex-cache-dereferences")),
+    allocation_site_bound(
+      options.get_unsigned_int_option("allocation-site-bound")),
+    guard_bdd_nodes(options.get_unsigned_int_option("symex-guard-bdd-nodes")),
     unwinding_assertions(options.get_bool_option("unwinding-assertions")),
     partial_loops(options.get_bool_option("partial-loops")),
     debug_level(unsafe_string2int(options.get_option("debug-level"))),
@@ -53,7 +63,8 @@ symex_configt::symex_configt(const optionst &options)
                 "max-field-sensitivity-array-size")
             : DEFAULT_MAX_FIELD_SENSITIVITY_ARRAY_SIZE),
     complexity_limits_active(
-      options.get_signed_int_option("symex-complexity-limit") > 0)
+      options.get_signed_int_option("symex-complexity-limit") > 0 ||
+      options.get_unsigned_int_option("symex-complexity-cost-limit") > 0)
 {
 }
 
@@ -351,6 +362,11 @@ void goto_symext::symex_with_state(
   // goto-program.
   ns = namespacet(outer_symbol_table, state.symbol_table);
 
+  // cached simplification results may refer to the previous namespace
+  if(simplify_cache)
+    simplify_cache->clear();
+  dereference_results.clear();
+
   // whichever way we exit this method, reset the namespace back to a sane state
   // as state.symbol_table might go out of scope
   reset_namespacet reset_ns(ns);
@@ -369,6 +385,12 @@ void goto_symext::symex_with_state(
       return;
   }
 
+  if(simplify_cache)
+  {
+    simplify_cache->output_statistics(log.statistics());
+    log.statistics() << messaget::eom;
+  }
+
   // Clients may need to construct a namespace with both the names in
   // the original goto-program and the names generated during symbolic
   // execution, so return the names generated through symbolic execution
@@ -449,6 +471,13 @@ std::unique_ptr<goto_symext::statet> goto_symext::initialize_entry_point_state(
     entry_point_id, *start_function);
   state->dirty = &path_storage.dirty;
 
+  if(
+    symex_config.doing_path_exploration &&
+    symex_config.merge_region_size != 0)
+  {
+    path_storage.add_function_regions(entry_point_id, start_function->body);
+  }
+
   // Only enable loop analysis when complexity is enabled.
   if(symex_config.complexity_limits_active)
   {
@@ -591,9 +620,22 @@ void goto_symext::symex_step(
   const get_goto_functiont &get_goto_function,
   statet &state)
 {
+  profile_scopet profile_scope("symex", state.source.function_id, false);
+
   // Print debug statements if they've been enabled.
   print_symex_step(state);
-  execute_next_instruction(get_goto_function, state);
+
+  symex_telemetryt &telemetry = get_symex_telemetry();
+  if(telemetry.is_enabled())
+  {
+    const symex_targett::sourcet source = state.source;
+    const std::size_t SSA_steps = target.SSA_steps.size();
+    execute_next_instruction(get_goto_function, state);
+    telemetry.step(source, target.SSA_steps.size() - SSA_steps, state);
+  }
+  else
+    execute_next_instruction(get_goto_function, state);
+
   kill_instruction_local_symbols(state);
 }
 
@@ -606,8 +648,12 @@ void goto_symext::execute_next_instruction(
 
   const goto_programt::instructiont &instruction=*state.source.pc;
 
-  if(!symex_config.doing_path_exploration)
-    merge_gotos(state);
+  // with --paths, only the branches of regions chosen by
+  // should_merge_branches are merged
+  merge_gotos(state);
+
+  if(symex_config.doing_path_exploration)
+    path_storage.visit(state.source.pc);
 
   // depth exceeded?
   if(symex_config.max_depth != 0 && state.depth > symex_config.max_depth)
@@ -664,7 +710,7 @@ void goto_symext::execute_next_instruction(
     break;
 
   case ASSIGN:
-    if(state.reachable)
+    if(state.reachable && !is_sliced_assignment(instruction.get_assign()))
       symex_assign(state, instruction.get_assign());
 
     symex_transition(state);
@@ -739,7 +785,16 @@ void goto_symext::execute_next_instruction(
   complexity_violationt complexity_result =
     complexity_module.check_complexity(state);
   if(complexity_result != complexity_violationt::NONE)
+  {
     complexity_module.run_transformations(complexity_result, state);
+
+    // no further simplifications are worth caching once memory runs short
+    if(complexity_module.memory_limit_reached())
+    {
+      simplify_cache.reset();
+      dereference_results.clear();
+    }
+  }
 }
 
 void goto_symext::kill_instruction_local_symbols(statet &state)
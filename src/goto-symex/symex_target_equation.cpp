@@ -13,6 +13,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "symex_target_equation.h"
 
 #include <util/format_expr.h>
+#include <util/profiler.h>
+#include <util/simplify_expr.h>
 #include <util/std_expr.h>
 
 #include <solvers/decision_procedure.h>
@@ -122,9 +124,27 @@ void symex_target_equationt::assignment(
                                               ssa_rhs,
                                               assignment_type});
 
+  if(on_the_fly_decision_procedure)
+    convert_assignment_on_the_fly(SSA_steps.back());
+
   merge_ireps(SSA_steps.back());
 }
 
+void symex_target_equationt::convert_assignment_on_the_fly(
+  SSA_stept &SSA_step)
+{
+  on_the_fly_decision_procedure->set_to_true(SSA_step.cond_expr);
+  SSA_step.converted = true;
+  SSA_step.ssa_rhs.make_nil();
+  SSA_step.cond_expr = true_exprt();
+
+  // The caches of the decision procedure would keep the right-hand sides
+  // alive. Clearing them only now and then preserves most of the sharing
+  // between the conversions of nearby steps.
+  if(++on_the_fly_conversions % 0x10000 == 0)
+    on_the_fly_decision_procedure->clear_cache();
+}
+
 void symex_target_equationt::decl(
   const exprt &guard,
   const ssa_exprt &ssa_lhs,
@@ -318,8 +338,19 @@ void symex_target_equationt::constraint(
   merge_ireps(SSA_step);
 }
 
+void symex_target_equationt::lazy_constraint(
+  const exprt &cond,
+  const std::string &msg,
+  const sourcet &source)
+{
+  constraint(cond, msg, source);
+  SSA_steps.back().lazy = true;
+}
+
 void symex_target_equationt::convert(decision_proceduret &decision_procedure)
 {
+  profile_scopet profile_scope("convert-ssa", "equation");
+
   convert_guards(decision_procedure);
   convert_assignments(decision_procedure);
   convert_decls(decision_procedure);
@@ -367,6 +398,11 @@ void symex_target_equationt::convert_decls(
 void symex_target_equationt::convert_guards(
   decision_proceduret &decision_procedure)
 {
+  // Runs of steps usually have the same guard, which merge_ireps makes share
+  // a single irep, so the handle of the previous step can be reused without
+  // asking the decision procedure to look the guard up again.
+  const SSA_stept *previous = nullptr;
+
   for(auto &step : SSA_steps)
   {
     if(step.ignore)
@@ -378,7 +414,12 @@ void symex_target_equationt::convert_guards(
         mstream << messaget::eom;
       });
 
-      step.guard_handle = decision_procedure.handle(step.guard);
+      if(previous != nullptr && &previous->guard.read() == &step.guard.read())
+        step.guard_handle = previous->guard_handle;
+      else
+        step.guard_handle = decision_procedure.handle(step.guard);
+
+      previous = &step;
     }
   }
 }
@@ -434,7 +475,7 @@ void symex_target_equationt::convert_constraints(
 {
   for(auto &step : SSA_steps)
   {
-    if(step.is_constraint() && !step.ignore && !step.converted)
+    if(step.is_constraint() && !step.ignore && !step.converted && !step.lazy)
     {
       log.conditional_output(log.debug(), [&step](messaget::mstreamt &mstream) {
         step.output(mstream);
@@ -447,6 +488,31 @@ void symex_target_equationt::convert_constraints(
   }
 }
 
+std::size_t symex_target_equationt::convert_violated_constraints(
+  decision_proceduret &decision_procedure,
+  const namespacet &ns)
+{
+  std::vector<SSA_stept *> violated;
+
+  // evaluate all of them in the same model before converting any
+  for(auto &step : SSA_steps)
+  {
+    if(step.is_constraint() && !step.ignore && !step.converted && step.lazy)
+    {
+      if(!simplify_expr(decision_procedure.get(step.cond_expr), ns).is_true())
+        violated.push_back(&step);
+    }
+  }
+
+  for(SSA_stept *step : violated)
+  {
+    decision_procedure.set_to_true(step->cond_expr);
+    step->converted = true;
+  }
+
+  return violated.size();
+}
+
 void symex_target_equationt::convert_assertions(
   decision_proceduret &decision_procedure)
 {
@@ -485,7 +551,13 @@ void symex_target_equationt::convert_assertions(
   or_exprt::operandst disjuncts;
   disjuncts.reserve(number_of_assertions);
 
+  // The assumptions preceding an assertion are encoded as a chain of
+  // conjunctions, each of which extends the previous one by the assumptions
+  // since. Assertions with the same preceding assumptions thus share one
+  // literal for them, and each assumption takes part in a single
+  // conjunction rather than in one per subsequent assertion.
   exprt assumption=true_exprt();
+  exprt::operandst new_assumptions;
 
   for(auto &step : SSA_steps)
   {
@@ -497,6 +569,14 @@ void symex_target_equationt::convert_assertions(
     {
       step.converted = true;
 
+      if(!new_assumptions.empty())
+      {
+        if(!assumption.is_true())
+          new_assumptions.push_back(assumption);
+        assumption = decision_procedure.handle(conjunction(new_assumptions));
+        new_assumptions.clear();
+      }
+
       log.conditional_output(log.debug(), [&step](messaget::mstreamt &mstream) {
         step.output(mstream);
         mstream << messaget::eom;
@@ -515,11 +595,7 @@ void symex_target_equationt::convert_assertions(
     else if(step.is_assume())
     {
       // the assumptions have been converted before
-      // avoid deep nesting of ID_and expressions
-      if(assumption.id()==ID_and)
-        assumption.copy_to_operands(step.cond_handle);
-      else
-        assumption = and_exprt(assumption, step.cond_handle);
+      new_assumptions.push_back(step.cond_handle);
     }
   }
 
@@ -16,6 +16,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <iosfwd>
 #include <list>
 
+#include <util/chunked_vector.h>
 #include <util/invariant.h>
 #include <util/merge_irep.h>
 #include <util/message.h>
@@ -150,6 +151,14 @@ public:
     const std::string &msg,
     const sourcet &source);
 
+  /// Record a constraint like \ref constraint, but only convert it once a
+  /// model of the other constraints violates it, see
+  /// \ref convert_violated_constraints
+  void lazy_constraint(
+    const exprt &cond,
+    const std::string &msg,
+    const sourcet &source);
+
   /// \copydoc symex_targett::spawn()
   virtual void spawn(
     const exprt &guard,
@@ -178,6 +187,17 @@ public:
   /// \param decision_procedure: A handle to a decision procedure interface
   void convert(decision_proceduret &decision_procedure);
 
+  /// Convert each assignment with \p decision_procedure as soon as it is
+  /// recorded, rather than in \ref convert, and drop its right-hand side.
+  /// Only the assignments' left-hand sides, for traces, and the other steps
+  /// are then kept in memory, which bounds the size of the equation for deep
+  /// unwindings. Slicing, propagation of assignments and witnesses no longer
+  /// see the right-hand sides of assignments.
+  void convert_assignments_on_the_fly(decision_proceduret &decision_procedure)
+  {
+    on_the_fly_decision_procedure = &decision_procedure;
+  }
+
   /// Converts assignments: set the equality _lhs==rhs_ to _True_.
   /// \param decision_procedure: A handle to a decision procedure
   ///  interface
@@ -197,10 +217,23 @@ public:
   /// \param decision_procedure: A handle to a decision procedure interface
   void convert_assertions(decision_proceduret &decision_procedure);
 
-  /// Converts constraints: set the represented condition to _True_.
+  /// Converts constraints: set the represented condition to _True_. Lazy
+  /// constraints are left to \ref convert_violated_constraints.
   /// \param decision_procedure: A handle to a decision procedure interface
   void convert_constraints(decision_proceduret &decision_procedure);
 
+  /// Converts the lazy constraints that do not evaluate to _True_ in the
+  /// current model of \p decision_procedure, whatever the values of the
+  /// symbols it has not seen so far.
+  /// \param decision_procedure: A handle to a decision procedure interface
+  ///   that has just found a model
+  /// \param ns: Namespace to simplify the evaluated constraints with
+  /// \return The number of constraints converted; if 0, the model satisfies
+  ///   all constraints
+  std::size_t convert_violated_constraints(
+    decision_proceduret &decision_procedure,
+    const namespacet &ns);
+
   /// Converts goto instructions: convert the expression representing the
   /// condition of this goto.
   /// \param decision_procedure: A handle to a decision procedure interface
@@ -238,18 +271,15 @@ public:
       }));
   }
 
-  typedef std::list<SSA_stept> SSA_stepst;
+  /// Steps are stored in chunks: appending a step does not move any of the
+  /// existing ones, and steps can be looked up by index in constant time.
+  typedef chunked_vectort<SSA_stept> SSA_stepst;
   SSA_stepst SSA_steps;
 
   SSA_stepst::iterator get_SSA_step(std::size_t s)
   {
-    SSA_stepst::iterator it=SSA_steps.begin();
-    for(; s!=0; s--)
-    {
-      PRECONDITION(it != SSA_steps.end());
-      it++;
-    }
-    return it;
+    PRECONDITION(s <= SSA_steps.size());
+    return SSA_steps.begin() + narrow_cast<std::ptrdiff_t>(s);
   }
 
   void output(std::ostream &out) const;
@@ -257,6 +287,7 @@ public:
   void clear()
   {
     SSA_steps.clear();
+    merge_irep.clear();
   }
 
   bool has_threads() const
@@ -280,6 +311,11 @@ protected:
   merge_irept merge_irep;
   void merge_ireps(SSA_stept &SSA_step);
 
+  /// See \ref convert_assignments_on_the_fly
+  decision_proceduret *on_the_fly_decision_procedure = nullptr;
+  std::size_t on_the_fly_conversions = 0;
+  void convert_assignment_on_the_fly(SSA_stept &SSA_step);
+
   // for unique I/O identifiers
   std::size_t io_count = 0;
 
@@ -287,11 +323,4 @@ protected:
   std::size_t argument_count = 0;
 };
 
-inline bool operator<(
-  const symex_target_equationt::SSA_stepst::const_iterator a,
-  const symex_target_equationt::SSA_stepst::const_iterator b)
-{
-  return &(*a)<&(*b);
-}
-
 #endif // CPROVER_GOTO_SYMEX_SYMEX_TARGET_EQUATION_H
@@ -0,0 +1,209 @@
+/*******************************************************************\
+
+Module: Symbolic Execution Telemetry
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Symbolic Execution Telemetry
+
+#include "symex_telemetry.h"
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include <util/cmdline.h>
+#include <util/exception_utils.h>
+#include <util/invariant.h>
+#include <util/json.h>
+#include <util/json_irep.h>
+#include <util/memory_info.h>
+#include <util/message.h>
+#include <util/string2int.h>
+
+#include "goto_symex_state.h"
+
+constexpr std::size_t symex_telemetryt::hot_spots;
+
+bool symex_telemetryt::enable(
+  const std::string &file_name,
+  clockt::duration _interval)
+{
+  out.open(file_name);
+  if(!out)
+    return false;
+
+  enabled = true;
+  interval = _interval;
+  enabled_at = clockt::now();
+  next_sample = enabled_at + interval;
+  last_memory = allocated_memory();
+  return true;
+}
+
+void symex_telemetryt::step(
+  const symex_targett::sourcet &source,
+  std::size_t SSA_steps,
+  const goto_symex_statet &state)
+{
+  PRECONDITION(enabled);
+
+  ++steps;
+  total_SSA_steps += SSA_steps;
+  countst &counts = instruction_counts[&*source.pc];
+  ++counts.steps;
+  counts.SSA_steps += SSA_steps;
+
+  if(clockt::now() >= next_sample)
+  {
+    sample(&source, &state);
+    next_sample = clockt::now() + interval;
+  }
+}
+
+void symex_telemetryt::loop_unwound(const irep_idt &loop_id, unsigned unwind)
+{
+  current_loop = loop_id;
+  unsigned &max_unwind = unwindings[loop_id];
+  max_unwind = std::max(max_unwind, unwind);
+}
+
+void symex_telemetryt::disable()
+{
+  if(!enabled)
+    return;
+
+  sample(nullptr, nullptr);
+  out.close();
+  enabled = false;
+}
+
+static json_numbert json_number(std::size_t n)
+{
+  return json_numbert(std::to_string(n));
+}
+
+void symex_telemetryt::sample(
+  const symex_targett::sourcet *source,
+  const goto_symex_statet *state)
+{
+  json_objectt json_sample{
+    {"milliseconds",
+     json_number(std::chrono::duration_cast<std::chrono::milliseconds>(
+                   clockt::now() - enabled_at)
+                   .count())},
+    {"steps", json_number(steps)},
+    {"ssaSteps", json_number(total_SSA_steps)}};
+
+  if(source != nullptr)
+  {
+    json_sample["function"] = json_stringt(source->function_id);
+    const source_locationt &source_location = source->pc->source_location;
+    if(source_location.is_not_nil())
+      json_sample["sourceLocation"] = json(source_location);
+  }
+
+  if(state != nullptr)
+    json_sample["callDepth"] = json_number(state->call_stack().size());
+
+  if(!current_loop.empty())
+    json_sample["loop"] = json_stringt(current_loop);
+
+  // loops in the order of their identifiers, for samples to be comparable
+  std::map<irep_idt, unsigned> sorted_unwindings(
+    unwindings.begin(), unwindings.end());
+  json_objectt &json_unwindings = json_sample["unwindings"].make_object();
+  for(const auto &unwinding : sorted_unwindings)
+  {
+    json_unwindings[id2string(unwinding.first)] =
+      json_number(unwinding.second);
+  }
+
+  // sum up the instructions by source location, and list those that
+  // produced the most SSA steps
+  std::map<std::string, countst> location_counts;
+  for(const auto &instruction_count : instruction_counts)
+  {
+    const source_locationt &source_location =
+      instruction_count.first->source_location;
+    countst &counts =
+      location_counts[source_location.is_nil() ? std::string()
+                                               : source_location.as_string()];
+    counts.steps += instruction_count.second.steps;
+    counts.SSA_steps += instruction_count.second.SSA_steps;
+  }
+
+  std::vector<std::map<std::string, countst>::const_iterator> sorted;
+  sorted.reserve(location_counts.size());
+  for(auto it = location_counts.begin(); it != location_counts.end(); ++it)
+    sorted.push_back(it);
+  const auto end = sorted.begin() + std::min(hot_spots, sorted.size());
+  std::partial_sort(
+    sorted.begin(),
+    end,
+    sorted.end(),
+    [](
+      std::map<std::string, countst>::const_iterator a,
+      std::map<std::string, countst>::const_iterator b) {
+      return a->second.SSA_steps > b->second.SSA_steps ||
+             (a->second.SSA_steps == b->second.SSA_steps &&
+              a->second.steps > b->second.steps);
+    });
+
+  json_arrayt &json_hot_spots = json_sample["hotSpots"].make_array();
+  for(auto it = sorted.begin(); it != end; ++it)
+  {
+    json_hot_spots.push_back(json_objectt(
+      {{"sourceLocation", json_stringt((*it)->first)},
+       {"steps", json_number((*it)->second.steps)},
+       {"ssaSteps", json_number((*it)->second.SSA_steps)}}));
+  }
+
+  const std::size_t memory = allocated_memory();
+  json_sample["memory"] = json_number(memory);
+  json_sample["memoryDelta"] = json_numbert(std::to_string(
+    static_cast<long long>(memory) - static_cast<long long>(last_memory)));
+  last_memory = memory;
+
+  // flush, for the sample to be seen while symbolic execution goes on
+  out << json_sample << std::endl;
+}
+
+symex_telemetry_outputt::symex_telemetry_outputt(
+  const cmdlinet &cmdline,
+  message_handlert &message_handler)
+{
+  if(!cmdline.isset("symex-telemetry"))
+    return;
+
+  std::size_t interval = 1000;
+  if(cmdline.isset("symex-telemetry-interval"))
+  {
+    const auto value =
+      string2optional_size_t(cmdline.get_value("symex-telemetry-interval"));
+    if(!value.has_value() || *value == 0)
+    {
+      throw invalid_command_line_argument_exceptiont(
+        "interval must be a positive number of milliseconds",
+        "--symex-telemetry-interval");
+    }
+    interval = *value;
+  }
+
+  const std::string file_name = cmdline.get_value("symex-telemetry");
+  if(!get_symex_telemetry().enable(
+       file_name, std::chrono::milliseconds(interval)))
+  {
+    messaget(message_handler).error()
+      << "failed to open symex telemetry file '" << file_name << "'"
+      << messaget::eom;
+  }
+}
+
+symex_telemetry_outputt::~symex_telemetry_outputt()
+{
+  get_symex_telemetry().disable();
+}
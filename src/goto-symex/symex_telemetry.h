@@ -0,0 +1,133 @@
+/*******************************************************************\
+
+Module: Symbolic Execution Telemetry
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Symbolic Execution Telemetry
+
+#ifndef CPROVER_GOTO_SYMEX_SYMEX_TELEMETRY_H
+#define CPROVER_GOTO_SYMEX_SYMEX_TELEMETRY_H
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+
+#include <util/irep.h>
+
+#include "symex_target.h"
+
+#define OPT_SYMEX_TELEMETRY "(symex-telemetry):(symex-telemetry-interval):"
+
+#define HELP_SYMEX_TELEMETRY                                                   \
+  " --symex-telemetry file       while running symbolic execution, write\n"    \
+  "                              its progress to file in JSON at regular\n"    \
+  "                              intervals\n"                                  \
+  " --symex-telemetry-interval ms\n"                                           \
+  "                              time between two telemetry samples\n"         \
+  "                              (default: 1000)\n"
+
+class cmdlinet;
+class goto_symex_statet;
+class message_handlert;
+
+/// Samples the progress of symbolic execution while it is running: each
+/// interval, a JSON object holding the current function, call depth and
+/// loop, the unwinding count of each loop so far, the source locations that
+/// produced the most SSA steps and the allocated memory is written, and
+/// flushed, such that the file can be followed as it grows, or be a named
+/// pipe. There is a single, global instance, see
+/// \ref get_symex_telemetry. Unless it is enabled, a step costs a single
+/// test.
+class symex_telemetryt
+{
+public:
+  typedef std::chrono::steady_clock clockt;
+
+  /// Number of source locations listed in each sample
+  static constexpr std::size_t hot_spots = 10;
+
+  bool is_enabled() const
+  {
+    return enabled;
+  }
+
+  /// Start sampling to \p file_name every \p interval
+  /// \return false if the file cannot be opened
+  bool enable(const std::string &file_name, clockt::duration interval);
+
+  /// Record that the instruction at \p source has been executed in
+  /// \p state, producing \p SSA_steps steps of the equation, and take a
+  /// sample if the interval has passed
+  void step(
+    const symex_targett::sourcet &source,
+    std::size_t SSA_steps,
+    const goto_symex_statet &state);
+
+  /// Record that the loop \p loop_id has been entered for the
+  /// \p unwind'th time
+  void loop_unwound(const irep_idt &loop_id, unsigned unwind);
+
+  /// Write a last sample, and stop
+  void disable();
+
+protected:
+  bool enabled = false;
+  std::ofstream out;
+  clockt::duration interval;
+  clockt::time_point enabled_at;
+  clockt::time_point next_sample;
+  std::size_t last_memory = 0;
+
+  std::size_t steps = 0;
+  std::size_t total_SSA_steps = 0;
+
+  /// The loop most recently unwound
+  irep_idt current_loop;
+
+  /// Highest unwinding count of each loop so far
+  std::unordered_map<irep_idt, unsigned> unwindings;
+
+  struct countst
+  {
+    std::size_t steps = 0;
+    std::size_t SSA_steps = 0;
+  };
+
+  /// Counts by instruction, which are summed up by source location when
+  /// taking a sample, as the instructions are cheaper to hash
+  std::unordered_map<const goto_programt::instructiont *, countst>
+    instruction_counts;
+
+  /// Write a sample, describing the instruction at \p source as the current
+  /// one if it is given
+  void sample(
+    const symex_targett::sourcet *source,
+    const goto_symex_statet *state);
+};
+
+/// Get a reference to the global symbolic execution telemetry.
+inline symex_telemetryt &get_symex_telemetry()
+{
+  static symex_telemetryt telemetry;
+  return telemetry;
+}
+
+/// Enables the global symbolic execution telemetry if requested by the
+/// `--symex-telemetry` option, see \ref HELP_SYMEX_TELEMETRY, and writes the
+/// last sample when it is destroyed.
+class symex_telemetry_outputt
+{
+public:
+  symex_telemetry_outputt(const cmdlinet &, message_handlert &);
+  ~symex_telemetry_outputt();
+
+  symex_telemetry_outputt(const symex_telemetry_outputt &) = delete;
+  symex_telemetry_outputt &operator=(const symex_telemetry_outputt &) = delete;
+};
+
+#endif // CPROVER_GOTO_SYMEX_SYMEX_TELEMETRY_H
@@ -11,6 +11,7 @@ Author: Chris Smowton, chris.smowton@diffblue.com
 
 #include <util/exception_utils.h>
 #include <util/json.h>
+#include <util/merge_irep.h>
 #include <util/symbol_table.h>
 
 void symbol_table_from_json(const jsont &in, symbol_tablet &symbol_table)
@@ -37,17 +38,26 @@ void symbol_table_from_json(const jsont &in, symbol_tablet &symbol_table)
   }
 
   const json_objectt &json_symbol_table = to_json_object(it->second);
+  symbol_table.reserve(symbol_table.symbols.size() + json_symbol_table.size());
+
+  // Types in particular are repeated across many symbols: share the
+  // identical subtrees rather than keeping one copy per symbol.
+  merge_full_irept merge;
 
   for(const auto &pair : json_symbol_table)
   {
     const jsont &json_symbol = pair.second;
 
     symbolt symbol = symbol_from_json(json_symbol);
+    merge(symbol.type);
+    merge(symbol.value);
+    merge(symbol.location);
 
-    if(symbol_table.add(symbol))
+    const irep_idt name = symbol.name;
+    if(!symbol_table.insert(std::move(symbol)).second)
       throw deserialization_exceptiont(
-        "symbol_table_from_json: duplicate symbol name `" +
-        id2string(symbol.name) + "`");
+        "symbol_table_from_json: duplicate symbol name `" + id2string(name) +
+        "`");
   }
 
   symbol_table.validate(validation_modet::EXCEPTION);
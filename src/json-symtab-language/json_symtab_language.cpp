@@ -41,6 +41,8 @@ bool json_symtab_languaget::typecheck(
   try
   {
     symbol_table_from_json(parsed_json_file, new_symbol_table);
+    // the symbols hold all that is needed from here on
+    parsed_json_file = jsont();
     return linking(symbol_table, new_symbol_table, get_message_handler());
   }
   catch(const std::string &str)
@@ -32,9 +32,9 @@ public:
     return yyjsonparse()!=0;
   }
 
-  void push(const jsont &x)
+  void push(jsont &&x)
   {
-    stack.push(x);
+    stack.push(std::move(x));
   }
 
   void pop(jsont &dest)
@@ -132,7 +132,7 @@ array_value:
         {
           jsont tmp;
           json_parser.pop(tmp);
-          to_json_array(json_parser.top()).push_back(tmp);
+          to_json_array(json_parser.top()).push_back(std::move(tmp));
         }
         ;
 
@@ -1350,20 +1350,21 @@ void linkingt::copy_symbols()
   // Move over all the non-colliding ones
   std::unordered_set<irep_idt> collisions;
 
-  for(const auto &named_symbol : src_symbols)
+  // Symbols that do not collide are not needed any longer and can be moved
+  for(auto &named_symbol : src_symbols)
   {
     // renamed?
     if(named_symbol.first!=named_symbol.second.name)
     {
       // new
-      main_symbol_table.add(named_symbol.second);
+      main_symbol_table.insert(std::move(named_symbol.second));
     }
     else
     {
       if(!main_symbol_table.has_symbol(named_symbol.first))
       {
         // new
-        main_symbol_table.add(named_symbol.second);
+        main_symbol_table.insert(std::move(named_symbol.second));
       }
       else
         collisions.insert(named_symbol.first);
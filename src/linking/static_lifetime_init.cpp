@@ -98,6 +98,15 @@ static_lifetime_init(const irep_idt &identifier, symbol_tablet &symbol_table)
 void static_lifetime_init(
   symbol_tablet &symbol_table,
   const source_locationt &source_location)
+{
+  static_lifetime_init(
+    symbol_table, source_location, [](const irep_idt &) { return true; });
+}
+
+void static_lifetime_init(
+  symbol_tablet &symbol_table,
+  const source_locationt &source_location,
+  const std::function<bool(const irep_idt &)> &is_used)
 {
   PRECONDITION(symbol_table.has_symbol(INITIALIZE_FUNCTION));
 
@@ -134,7 +143,7 @@ void static_lifetime_init(
 
   // now all other variables
   for(const std::string &id : symbols)
-    if(!has_prefix(id, CPROVER_PREFIX))
+    if(!has_prefix(id, CPROVER_PREFIX) && is_used(id))
     {
       auto code = static_lifetime_init(id, symbol_table);
       if(code.has_value())
@@ -11,6 +11,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_LINKING_STATIC_LIFETIME_INIT_H
 
 #include <util/cprover_prefix.h>
+#include <util/irep.h>
+
+#include <functional>
 
 class message_handlert;
 class source_locationt;
@@ -20,6 +23,13 @@ void static_lifetime_init(
   symbol_tablet &symbol_table,
   const source_locationt &source_location);
 
+/// Like the above, but only initialize the variables \p is_used holds for,
+/// and those with prefix `__CPROVER_`
+void static_lifetime_init(
+  symbol_tablet &symbol_table,
+  const source_locationt &source_location,
+  const std::function<bool(const irep_idt &)> &is_used);
+
 #define INITIALIZE_FUNCTION CPROVER_PREFIX "initialize"
 
 #endif // CPROVER_LINKING_STATIC_LIFETIME_INIT_H
@@ -7,10 +7,12 @@ Author: Malte Mues <mail.mues@gmail.com>
 
 \*******************************************************************/
 
+#include <algorithm>
 #include <cstdlib>
 
 #include "analyze_symbol.h"
 
+#include <util/arith_tools.h>
 #include <util/c_types.h>
 #include <util/c_types_util.h>
 #include <util/config.h>
@@ -100,9 +102,71 @@ optionalt<std::string> gdb_value_extractort::get_malloc_pointee(
 
 mp_integer gdb_value_extractort::get_type_size(const typet &type) const
 {
+  const auto entry = type_sizes.find(type);
+  if(entry != type_sizes.end())
+    return entry->second;
+
   const auto maybe_size = pointer_offset_bits(type, ns);
   CHECK_RETURN(maybe_size.has_value());
-  return *maybe_size / 8;
+  return type_sizes.emplace(type, *maybe_size / 8).first->second;
+}
+
+const std::vector<optionalt<mp_integer>> &
+gdb_value_extractort::get_struct_layout(const struct_tag_typet &struct_tag_type)
+{
+  const auto entry = struct_layouts.find(struct_tag_type.get_identifier());
+  if(entry != struct_layouts.end())
+    return entry->second;
+
+  const struct_typet &struct_type = ns.follow_tag(struct_tag_type);
+
+  std::vector<optionalt<mp_integer>> layout;
+  layout.reserve(struct_type.components().size());
+  for(const auto &component : struct_type.components())
+    layout.push_back(member_offset(struct_type, component.get_name(), ns));
+
+  return struct_layouts
+    .emplace(struct_tag_type.get_identifier(), std::move(layout))
+    .first->second;
+}
+
+std::vector<unsigned char>
+gdb_value_extractort::read_object_bytes(const exprt &expr)
+{
+  const auto size = pointer_offset_size(expr.type(), ns);
+  if(!size.has_value() || *size <= 0)
+    return {};
+
+  return gdb_api.read_memory(
+    c_converter.convert(address_of_exprt{expr}),
+    numeric_cast_v<std::size_t>(*size));
+}
+
+optionalt<exprt> gdb_value_extractort::get_integral_value_from_bytes(
+  const std::vector<unsigned char> &bytes,
+  const mp_integer &offset,
+  const typet &type) const
+{
+  if(!is_c_integral_type(type))
+    return {};
+
+  const std::size_t width = to_bitvector_type(type).get_width();
+  if(width % 8 != 0 || offset < 0 || offset + width / 8 > bytes.size())
+    return {};
+
+  const std::size_t begin = numeric_cast_v<std::size_t>(offset);
+  const std::size_t size = width / 8;
+  const bool big_endian =
+    config.ansi_c.endianness == configt::ansi_ct::endiannesst::IS_BIG_ENDIAN;
+
+  mp_integer value = 0;
+  for(std::size_t i = 0; i < size; ++i)
+    value = value * 256 + bytes[big_endian ? begin + i : begin + size - 1 - i];
+
+  if(type.id() == ID_signedbv && value >= power(2, width - 1))
+    value -= power(2, width);
+
+  return from_integer(value, type);
 }
 
 void gdb_value_extractort::analyze_symbols(const std::vector<irep_idt> &symbols)
@@ -576,12 +640,29 @@ exprt gdb_value_extractort::get_array_value(
 
   exprt new_array(array);
 
+  // values of integral type are decoded from the bytes of the whole array
+  // rather than queried one by one
+  const typet &element_type = expr.type().subtype();
+  const std::vector<unsigned char> bytes = is_c_integral_type(element_type)
+                                             ? read_object_bytes(expr)
+                                             : std::vector<unsigned char>{};
+
   for(size_t i = 0; i < new_array.operands().size(); ++i)
   {
-    const index_exprt index_expr(expr, from_integer(i, index_type()));
-
     exprt &operand = new_array.operands()[i];
 
+    if(!bytes.empty())
+    {
+      const auto value = get_integral_value_from_bytes(
+        bytes, i * get_type_size(element_type), element_type);
+      if(value.has_value())
+      {
+        operand = *value;
+        continue;
+      }
+    }
+
+    const index_exprt index_expr(expr, from_integer(i, index_type()));
     operand = get_expr_value(index_expr, operand, location);
   }
 
@@ -686,9 +767,23 @@ exprt gdb_value_extractort::get_struct_value(
   const struct_tag_typet &struct_tag_type = to_struct_tag_type(expr.type());
   const struct_typet &struct_type = ns.follow_tag(struct_tag_type);
 
+  // members of integral type are decoded from the bytes of the whole struct
+  // rather than queried one by one
+  const auto &components = struct_type.components();
+  const std::vector<unsigned char> bytes =
+    std::any_of(
+      components.begin(),
+      components.end(),
+      [](const struct_typet::componentt &component) {
+        return is_c_integral_type(component.type());
+      })
+      ? read_object_bytes(expr)
+      : std::vector<unsigned char>{};
+  const auto &layout = get_struct_layout(struct_tag_type);
+
   for(size_t i = 0; i < new_expr.operands().size(); ++i)
   {
-    const struct_typet::componentt &component = struct_type.components()[i];
+    const struct_typet::componentt &component = components[i];
 
     if(component.get_is_padding() || component.type().id() == ID_code)
     {
@@ -696,6 +791,18 @@ exprt gdb_value_extractort::get_struct_value(
     }
 
     exprt &operand = new_expr.operands()[i];
+
+    if(!bytes.empty() && layout[i].has_value())
+    {
+      const auto value =
+        get_integral_value_from_bytes(bytes, *layout[i], component.type());
+      if(value.has_value())
+      {
+        operand = *value;
+        continue;
+      }
+    }
+
     member_exprt member_expr(expr, component);
 
     operand = get_expr_value(member_expr, operand, location);
@@ -15,6 +15,7 @@ Author: Malte Mues <mail.mues@gmail.com>
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "gdb_api.h"
 
@@ -93,6 +94,12 @@ private:
   ///   value of `symbol`.
   std::map<memory_addresst, exprt> values;
 
+  /// Cache of \ref get_type_size
+  mutable std::map<typet, mp_integer> type_sizes;
+
+  /// Cache of \ref get_struct_layout, indexed by struct tag
+  std::map<irep_idt, std::vector<optionalt<mp_integer>>> struct_layouts;
+
   struct memory_scopet
   {
   private:
@@ -195,6 +202,31 @@ private:
   /// \return the size of the type in bytes
   mp_integer get_type_size(const typet &type) const;
 
+  /// Compute the byte offset of each of the components of a struct
+  /// \param struct_tag_type: tag of the struct
+  /// \return the offsets, in the order of the components, with an empty
+  ///   offset for components that do not start at a byte boundary
+  const std::vector<optionalt<mp_integer>> &
+  get_struct_layout(const struct_tag_typet &struct_tag_type);
+
+  /// Read all the bytes of the object \p expr with a single call to
+  ///   \ref gdb_apit::read_memory
+  /// \param expr: the expression to be read
+  /// \return the bytes, or an empty vector if they could not be read
+  std::vector<unsigned char> read_object_bytes(const exprt &expr);
+
+  /// Decode a value of integral type from bytes previously obtained from
+  ///   \ref read_object_bytes
+  /// \param bytes: the bytes of the enclosing object
+  /// \param offset: byte offset of the value within \p bytes
+  /// \param type: type of the value
+  /// \return the value, or an empty optional if \p type is not an integral
+  ///   type or its value is not covered by \p bytes
+  optionalt<exprt> get_integral_value_from_bytes(
+    const std::vector<unsigned char> &bytes,
+    const mp_integer &offset,
+    const typet &type) const;
+
   /// Assign the gdb-extracted value for \p symbol_name to its symbol
   ///   expression and then process outstanding assignments that this
   ///   extraction introduced.
@@ -208,7 +240,8 @@ private:
   void add_assignment(const exprt &lhs, const exprt &value);
 
   /// Iterate over \p array and fill its operands with the results of calling
-  ///   \ref get_expr_value on index expressions into \p expr.
+  ///   \ref get_expr_value on index expressions into \p expr. Arrays of
+  ///   integral type are read with a single query to gdb.
   /// \param expr: the expression to be analysed
   /// \param array: array with zero-initialised elements
   /// \param location: the source location
@@ -232,7 +265,9 @@ private:
     const exprt &zero_expr,
     const source_locationt &location);
 
-  /// For each of the members of the struct: call \ref get_expr_value
+  /// For each of the members of the struct: call \ref get_expr_value, except
+  ///   for members of integral type, which are decoded from the bytes of the
+  ///   struct as read by a single query to gdb
   /// \param expr: struct expression to be analysed
   /// \param zero_expr: struct with zero-initialised members
   /// \param location: the source location
@@ -74,6 +74,7 @@ void gdb_apit::create_gdb_process()
   PRECONDITION(gdb_state == gdb_statet::NOT_CREATED);
 
   command_log.clear();
+  value_cache.clear();
 
   pid_t gdb_process;
 
@@ -403,30 +404,30 @@ bool gdb_apit::run_gdb_to_breakpoint(const std::string &breakpoint)
 
 std::string gdb_apit::eval_expr(const std::string &expr)
 {
+  const auto cached = value_cache.find(expr);
+  if(cached != value_cache.end())
+    return cached->second;
+
+  // the response to -var-create already contains the value of the variable,
+  // hence there is no need for a separate -var-evaluate-expression
   write_to_gdb("-var-create tmp * " + expr);
 
-  if(!was_command_accepted())
+  gdb_output_recordt record;
+  try
+  {
+    record = get_most_recent_record("^done");
+  }
+  catch(const gdb_interaction_exceptiont &)
   {
     throw gdb_interaction_exceptiont(
       "could not create variable for expression `" + expr + "`");
   }
 
-  write_to_gdb("-var-evaluate-expression tmp");
-  gdb_output_recordt record = get_most_recent_record("^done", true);
-
   write_to_gdb("-var-delete tmp");
   check_command_accepted();
 
-  const auto it = record.find("value");
-  CHECK_RETURN(it != record.end());
-
-  const std::string value = it->second;
-
-  INVARIANT(
-    value.back() != '"' ||
-      (value.length() >= 2 && value[value.length() - 2] == '\\'),
-    "quotes should have been stripped off from value");
-  INVARIANT(value.back() != '\n', "value should not end in a newline");
+  const std::string value = get_value_from_record(record, "value");
+  value_cache.emplace(expr, value);
 
   return value;
 }
@@ -482,6 +483,61 @@ gdb_apit::pointer_valuet gdb_apit::get_memory(const std::string &expr)
   return pointer_valuet(result[1], result[2], result[3], opt_string, true);
 }
 
+std::vector<unsigned char>
+gdb_apit::read_memory(const std::string &expr, const std::size_t size)
+{
+  PRECONDITION(gdb_state == gdb_statet::STOPPED);
+
+  // the address expression is passed as a c-string as it may contain spaces
+  std::string address;
+  for(const char c : expr)
+  {
+    if(c == '"' || c == '\\')
+      address += '\\';
+    address += c;
+  }
+
+  write_to_gdb(
+    "-data-read-memory-bytes \"" + address + "\" " + std::to_string(size));
+
+  gdb_output_recordt record;
+  try
+  {
+    record = get_most_recent_record("^done");
+  }
+  catch(const gdb_interaction_exceptiont &)
+  {
+    return {};
+  }
+
+  // memory that is only partly readable is reported as several blocks, of
+  // which we only accept the one covering all of the requested bytes, e.g.
+  // [{begin="0x601040",offset="0x0",end="0x601044",contents="08000000"}]
+  const std::string memory = get_value_from_record(record, "memory");
+  if(std::count(memory.begin(), memory.end(), '{') != 1)
+    return {};
+
+  std::regex regex("contents=\"([0-9a-f]*)\"");
+  std::smatch result;
+  if(
+    !std::regex_search(memory, result, regex) ||
+    result[1].length() != 2 * static_cast<std::ptrdiff_t>(size))
+  {
+    return {};
+  }
+
+  const std::string contents = result[1];
+  std::vector<unsigned char> bytes;
+  bytes.reserve(size);
+  for(std::size_t i = 0; i < contents.length(); i += 2)
+  {
+    bytes.push_back(static_cast<unsigned char>(
+      std::stoul(contents.substr(i, 2), nullptr, 16)));
+  }
+
+  return bytes;
+}
+
 optionalt<std::string> gdb_apit::get_value(const std::string &expr)
 {
   PRECONDITION(gdb_state == gdb_statet::STOPPED);
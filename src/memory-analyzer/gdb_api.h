@@ -23,6 +23,8 @@ Author: Malte Mues <mail.mues@gmail.com>
 #include <exception>
 #include <forward_list>
 #include <map>
+#include <string>
+#include <vector>
 
 #include <util/exception_utils.h>
 
@@ -135,6 +137,16 @@ public:
   /// \return the \p pointer_valuet filled with data gdb produced for \p expr
   pointer_valuet get_memory(const std::string &expr);
 
+  /// Read \p size bytes of memory starting at the address \p expr evaluates
+  /// to, using a single gdb command. This is much cheaper than querying the
+  /// values of the parts of an object one by one.
+  /// \param expr: an expression of pointer type (e.g., `&s`)
+  /// \param size: the number of bytes to read
+  /// \return the bytes read, or an empty vector if (part of) the memory could
+  ///   not be read
+  std::vector<unsigned char>
+  read_memory(const std::string &expr, const std::size_t size);
+
   /// Return the vector of commands that have been written to gdb so far
   /// \return the list of commands
   const commandst &get_command_log();
@@ -162,6 +174,10 @@ protected:
   /// maps hexadecimal address to the number of bytes
   std::map<std::string, size_t> allocated_memory;
 
+  /// values of the expressions evaluated by \ref eval_expr so far; the state
+  /// of the program does not change once it has been stopped
+  std::map<std::string, std::string> value_cache;
+
   typedef std::map<std::string, std::string> gdb_output_recordt;
   static gdb_output_recordt parse_gdb_output_record(const std::string &s);
 
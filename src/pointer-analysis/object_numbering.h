@@ -18,6 +18,9 @@ Author: Daniel Kroening, kroening@kroening.com
 /// Then any users that agree to use the same object_numberingt instance as a
 /// common reference source can use '1' and '2' as shorthands for "Hello" and
 /// "World" respectively.
+///
+/// Objects are never moved once numbered, hence references to them remain
+/// valid while further objects are numbered.
 
 #ifndef CPROVER_POINTER_ANALYSIS_OBJECT_NUMBERING_H
 #define CPROVER_POINTER_ANALYSIS_OBJECT_NUMBERING_H
@@ -25,6 +28,6 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/expr.h>
 #include <util/numbering.h>
 
-typedef hash_numbering<exprt, irep_hash> object_numberingt;
+typedef stable_hash_numbering<exprt, irep_hash> object_numberingt;
 
 #endif // CPROVER_POINTER_ANALYSIS_OBJECT_NUMBERING_H
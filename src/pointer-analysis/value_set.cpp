@@ -242,6 +242,14 @@ exprt value_sett::to_expr(const object_map_dt::value_type &it) const
 
 bool value_sett::make_union(const value_sett::valuest &new_values)
 {
+  if(values.empty())
+  {
+    // nothing to merge with: share all entries
+    const bool result = !new_values.empty();
+    values = new_values;
+    return result;
+  }
+
   bool result=false;
 
   value_sett::valuest::delta_viewt delta_view;
@@ -252,12 +260,13 @@ bool value_sett::make_union(const value_sett::valuest &new_values)
   {
     if(delta_entry.is_in_both_maps())
     {
-      if(make_union_would_change(
-           delta_entry.get_other_map_value().object_map,
-           delta_entry.m.object_map))
+      // merge into a copy that shares the existing set, which is only
+      // detached, and written back, if the merge changes it
+      object_mapt merged = delta_entry.get_other_map_value().object_map;
+      if(make_union(merged, delta_entry.m.object_map))
       {
-        values.update(delta_entry.k, [&](entryt &existing_entry) {
-          make_union(existing_entry.object_map, delta_entry.m.object_map);
+        values.update(delta_entry.k, [&merged](entryt &existing_entry) {
+          existing_entry.object_map.swap(merged);
         });
         result = true;
       }
@@ -272,37 +281,103 @@ bool value_sett::make_union(const value_sett::valuest &new_values)
   return result;
 }
 
-bool value_sett::make_union_would_change(
-  const object_mapt &dest,
-  const object_mapt &src) const
+/// Whether merging an element with offset \p src into an existing element
+/// with offset \p dest changes the latter
+static bool offset_would_change(
+  const value_sett::offsett &dest,
+  const value_sett::offsett &src)
 {
-  for(const auto &number_and_offset : src.read())
+  return dest && !(src && *dest == *src);
+}
+
+/// Find the first element of \p src that would change \p dest when merged
+/// into it. If \p src is much smaller than \p dest, its elements are looked
+/// up one by one, otherwise both maps are traversed in order.
+static value_sett::object_map_dt::const_iterator first_change(
+  const value_sett::object_map_dt &dest,
+  const value_sett::object_map_dt &src)
+{
+  if(src.size() * 8 < dest.size())
+  {
+    for(auto src_it = src.begin(); src_it != src.end(); ++src_it)
+    {
+      const auto dest_it = dest.find(src_it->first);
+      if(
+        dest_it == dest.end() ||
+        offset_would_change(dest_it->second, src_it->second))
+      {
+        return src_it;
+      }
+    }
+
+    return src.end();
+  }
+
+  auto dest_it = dest.begin();
+  for(auto src_it = src.begin(); src_it != src.end(); ++src_it)
   {
+    while(dest_it != dest.end() && dest_it->first < src_it->first)
+      ++dest_it;
+
     if(
-      get_insert_action(
-        dest, number_and_offset.first, number_and_offset.second) !=
-      insert_actiont::NONE)
+      dest_it == dest.end() || dest_it->first != src_it->first ||
+      offset_would_change(dest_it->second, src_it->second))
     {
-      return true;
+      return src_it;
     }
   }
 
-  return false;
+  return src.end();
+}
+
+bool value_sett::make_union_would_change(
+  const object_mapt &dest,
+  const object_mapt &src) const
+{
+  if(src.get_d() == dest.get_d())
+    return false;
+
+  return first_change(dest.read(), src.read()) != src.read().end();
 }
 
 bool value_sett::make_union(object_mapt &dest, const object_mapt &src) const
 {
-  bool result=false;
+  if(src.get_d() == dest.get_d() || src.read().empty())
+    return false;
 
-  for(object_map_dt::const_iterator it=src.read().begin();
-      it!=src.read().end();
-      it++)
+  if(dest.read().empty())
   {
-    if(insert(dest, *it))
-      result=true;
+    // share the set rather than copying its elements
+    dest = src;
+    return true;
   }
 
-  return result;
+  auto src_it = first_change(dest.read(), src.read());
+  if(src_it == src.read().end())
+    return false;
+
+  // the elements of src before src_it would not change dest
+  object_map_dt &dest_map = dest.write();
+  auto dest_it = dest_map.lower_bound(src_it->first);
+  const bool lookup = src.read().size() * 8 < dest_map.size();
+
+  for(; src_it != src.read().end(); ++src_it)
+  {
+    if(lookup)
+      dest_it = dest_map.lower_bound(src_it->first);
+    else
+    {
+      while(dest_it != dest_map.end() && dest_it->first < src_it->first)
+        ++dest_it;
+    }
+
+    if(dest_it == dest_map.end() || dest_it->first != src_it->first)
+      dest_it = dest_map.emplace_hint(dest_it, *src_it);
+    else if(offset_would_change(dest_it->second, src_it->second))
+      dest_it->second.reset();
+  }
+
+  return true;
 }
 
 bool value_sett::eval_pointer_offset(
@@ -566,9 +641,7 @@ void value_sett::get_value_set_rec(
           it1!=object_map.end();
           it1++)
       {
-        /// Do not take a reference to object_numbering's storage as we may call
-        /// object_numbering.number(), which may reallocate it.
-        const exprt object=object_numbering[it1->first];
+        const exprt &object=object_numbering[it1->first];
         get_value_set_rec(object, dest, suffix, original_type, ns);
       }
     }
@@ -1389,9 +1462,7 @@ void value_sett::assign_rec(
         it!=reference_set.read().end();
         it++)
     {
-      /// Do not take a reference to object_numbering's storage as we may call
-      /// object_numbering.number(), which may reallocate it.
-      const exprt object=object_numbering[it->first];
+      const exprt &object=object_numbering[it->first];
 
       if(object.id()!=ID_unknown)
         assign_rec(object, values_rhs, suffix, ns, add_to_sets);
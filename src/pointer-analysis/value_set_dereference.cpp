@@ -344,6 +344,74 @@ bool value_set_dereferencet::should_ignore_value(
   return false;
 }
 
+/// Limit on the number of cases \ref aligned_subexpression_case_split
+/// generates, above which extracting bytes is preferred.
+static const std::size_t max_aligned_subexpression_cases = 64;
+
+/// Dereferencing a pointer with an unknown offset into \p root_object (for
+/// example, after `p += i`) would otherwise extract \p dereference_type from
+/// the bytes of the whole object. As the pointer is required to be suitably
+/// aligned, only offsets that are multiples of the size of
+/// \p dereference_type need to be considered, and only those within the
+/// object. If a member or element of type \p dereference_type exists at each
+/// of these, we build `offset == 0 ? x.a : offset == 4 ? x.b : x.c` instead.
+/// The last case is not guarded: any other offset is out of bounds or
+/// misaligned, which is undefined.
+/// \param root_object: object the pointer points into
+/// \param offset: offset of the pointer relative to \p root_object
+/// \param dereference_type: type of the dereferenced value
+/// \param ns: namespace
+/// \return the case split, or an empty optional if any aligned offset does
+///   not correspond to a subexpression of type \p dereference_type
+static optionalt<exprt> aligned_subexpression_case_split(
+  const exprt &root_object,
+  const exprt &offset,
+  const typet &dereference_type,
+  const namespacet &ns)
+{
+  if(
+    root_object.type().id() != ID_struct_tag &&
+    root_object.type().id() != ID_struct &&
+    root_object.type().id() != ID_array)
+  {
+    return {};
+  }
+
+  const auto object_size = pointer_offset_size(root_object.type(), ns);
+  const auto element_size = pointer_offset_size(dereference_type, ns);
+  if(
+    !object_size.has_value() || !element_size.has_value() ||
+    *element_size <= 0 || *object_size < *element_size ||
+    *object_size / *element_size > max_aligned_subexpression_cases)
+  {
+    return {};
+  }
+
+  std::vector<std::pair<mp_integer, exprt>> cases;
+  for(mp_integer k = 0; k + *element_size <= *object_size; k += *element_size)
+  {
+    auto subexpr =
+      get_subexpression_at_offset(root_object, k, dereference_type, ns);
+    if(!subexpr.has_value())
+      return {};
+    simplify(*subexpr, ns);
+    if(subexpr->id() == byte_extract_id())
+      return {};
+    cases.emplace_back(k, std::move(*subexpr));
+  }
+
+  exprt result = cases.back().second;
+  for(auto it = std::next(cases.rbegin()); it != cases.rend(); ++it)
+  {
+    result = if_exprt(
+      equal_exprt(offset, from_integer(it->first, offset.type())),
+      it->second,
+      result);
+  }
+
+  return result;
+}
+
 /// \param what: value set entry to convert to an expression: either
 ///   ID_unknown, ID_invalid, or an object_descriptor_exprt giving a referred
 ///   object and offset.
@@ -564,6 +632,18 @@ value_set_dereferencet::valuet value_set_dereferencet::build_reference_to(
       else
         offset=o.offset();
 
+      if(o.offset().id() == ID_unknown)
+      {
+        // only consider the in-range, aligned members or elements
+        auto case_split = aligned_subexpression_case_split(
+          o.root_object(), offset, dereference_type, ns);
+        if(case_split.has_value())
+        {
+          result.value = std::move(*case_split);
+          return result;
+        }
+      }
+
       if(memory_model(result.value, dereference_type, offset, ns))
       {
         // ok, done
@@ -192,6 +192,9 @@ public:
 
   mini_bddt operator()(const mini_bddt &x, const mini_bddt &y)
   {
+    PRECONDITION_WITH_DIAGNOSTICS(
+      x.is_initialized(), "apply can only be called on initialized BDDs");
+    x.node->mgr->resize_computed_table();
     return APP_non_rec(x, y);
   }
 
@@ -200,7 +203,19 @@ protected:
   mini_bddt APP_rec(const mini_bddt &x, const mini_bddt &y);
   mini_bddt APP_non_rec(const mini_bddt &x, const mini_bddt &y);
 
-  typedef std::map<std::pair<unsigned, unsigned>, mini_bddt> Gt;
+  struct key_hasht
+  {
+    std::size_t operator()(const std::pair<unsigned, unsigned> &key) const
+    {
+      return static_cast<std::size_t>(key.first) * 31 + key.second;
+    }
+  };
+
+  // results of this call, which the computed table of the manager may have
+  // lost to collisions
+  typedef std::
+    unordered_map<std::pair<unsigned, unsigned>, mini_bddt, key_hasht>
+      Gt;
   Gt G;
 };
 
@@ -285,11 +300,21 @@ mini_bddt mini_bdd_applyt::APP_non_rec(const mini_bddt &_x, const mini_bddt &_y)
     {
       // dynamic programming
       Gt::const_iterator G_it = G.find(t.key);
+      mini_bdd_mgrt::computed_entryt *entry = nullptr;
       if(G_it != G.end())
       {
         t.result = G_it->second;
         stack.pop();
       }
+      else if(
+        !(x.is_constant() && y.is_constant()) &&
+        (entry = &x.node->mgr->computed_entry(fkt, x, y))->fkt == fkt &&
+        entry->x.node == x.node && entry->y.node == y.node)
+      {
+        t.result = entry->result;
+        G[t.key] = t.result;
+        stack.pop();
+      }
       else
       {
         if(x.is_constant() && y.is_constant())
@@ -351,6 +376,13 @@ mini_bddt mini_bdd_applyt::APP_non_rec(const mini_bddt &_x, const mini_bddt &_y)
       mini_bdd_mgrt *mgr = x.node->mgr;
       t.result = mgr->mk(t.var, t.lr, t.hr);
       G[t.key] = t.result;
+
+      mini_bdd_mgrt::computed_entryt &entry = mgr->computed_entry(fkt, x, y);
+      entry.fkt = fkt;
+      entry.x = x;
+      entry.y = y;
+      entry.result = t.result;
+
       stack.pop();
     }
     break;
@@ -421,6 +453,38 @@ mini_bdd_mgrt::mini_bdd_mgrt()
 
 mini_bdd_mgrt::~mini_bdd_mgrt()
 {
+  // release the references to nodes before the nodes are destroyed
+  computed_table.clear();
+}
+
+mini_bdd_mgrt::computed_entryt &mini_bdd_mgrt::computed_entry(
+  bool (*fkt)(bool, bool),
+  const mini_bddt &x,
+  const mini_bddt &y)
+{
+  PRECONDITION(!computed_table.empty());
+  const std::size_t hash = (reinterpret_cast<std::size_t>(fkt) * 31 +
+                            x.node_number()) *
+                             31 +
+                           y.node_number();
+  return computed_table[hash & (computed_table.size() - 1)];
+}
+
+void mini_bdd_mgrt::resize_computed_table()
+{
+  static const std::size_t initial_size = 1 << 10;
+  static const std::size_t max_size = 1 << 22;
+
+  if(computed_table.empty())
+    computed_table.resize(initial_size);
+  else if(
+    computed_table.size() < max_size &&
+    number_of_nodes() > computed_table.size())
+  {
+    const std::size_t new_size = 2 * computed_table.size();
+    computed_table.clear();
+    computed_table.resize(new_size);
+  }
 }
 
 mini_bddt
@@ -26,6 +26,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <map>
 #include <stack>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class mini_bddt
@@ -102,6 +103,7 @@ public:
   const mini_bddt &False() const;
 
   friend class mini_bdd_nodet;
+  friend class mini_bdd_applyt;
 
   // create a node (consulting the reverse-map)
   mini_bddt mk(unsigned var, const mini_bddt &low, const mini_bddt &high);
@@ -129,13 +131,47 @@ protected:
     reverse_keyt(unsigned _var, const mini_bddt &_low, const mini_bddt &_high);
 
     bool operator<(const reverse_keyt &) const;
+    bool operator==(const reverse_keyt &) const;
   };
 
-  typedef std::map<reverse_keyt, mini_bdd_nodet *> reverse_mapt;
+  struct reverse_key_hasht
+  {
+    std::size_t operator()(const reverse_keyt &) const;
+  };
+
+  typedef std::unordered_map<reverse_keyt, mini_bdd_nodet *, reverse_key_hasht>
+    reverse_mapt;
   reverse_mapt reverse_map;
 
   typedef std::stack<mini_bdd_nodet *> freet;
   freet free;
+
+  /// Entry of the computed table, which caches the results of binary
+  /// operations across calls. The entry holds references to its operands,
+  /// such that their nodes, and thus their numbers, are not reused while
+  /// the entry exists.
+  struct computed_entryt
+  {
+    bool (*fkt)(bool, bool) = nullptr;
+    mini_bddt x, y, result;
+  };
+
+  /// Direct-mapped computed table, whose size is a power of two that grows
+  /// with the number of nodes; colliding entries are overwritten. Declared
+  /// after the nodes, as the entries refer to them.
+  std::vector<computed_entryt> computed_table;
+
+  /// \return the entry of the computed table for applying \p fkt to \p x
+  ///   and \p y, which holds a different operation or operands on a miss
+  computed_entryt &computed_entry(
+    bool (*fkt)(bool, bool),
+    const mini_bddt &x,
+    const mini_bddt &y);
+
+  /// Grow the computed table when the number of nodes has outgrown it, which
+  /// drops all cached results. Must not be called while an operation is in
+  /// progress, as dropping results may free nodes.
+  void resize_computed_table();
 };
 
 mini_bddt restrict(const mini_bddt &u, unsigned var, const bool value);
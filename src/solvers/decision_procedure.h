@@ -64,6 +64,13 @@ public:
   /// Return the number of incremental solver calls
   virtual std::size_t get_number_of_solver_calls() const = 0;
 
+  /// Drop the expressions cached during conversion, which keeps them from
+  /// being freed. Expressions converted after this are converted afresh,
+  /// even if they have been converted before.
+  virtual void clear_cache()
+  {
+  }
+
   virtual ~decision_proceduret();
 
 protected:
@@ -248,11 +248,8 @@ void arrayst::add_array_constraint(const lazy_constraintt &lazy, bool refine)
     // lazily add the constraint
     if(incremental_cache)
     {
-      if(expr_map.find(lazy.lazy) == expr_map.end())
-      {
+      if(lazy_constraint_exprs.insert(lazy.lazy).second)
         lazy_array_constraints.push_back(lazy);
-        expr_map[lazy.lazy] = true;
-      }
     }
     else
     {
@@ -351,9 +348,17 @@ void arrayst::add_array_Ackermann_constraints()
           const equal_exprt indices_equal(
             *i1, typecast_exprt::conditional_cast(*i2, i1->type()));
 
-          literalt indices_equal_lit=convert(indices_equal);
-
-          if(indices_equal_lit!=const_literal(false))
+          // When adding constraints lazily, the index equality is only
+          // converted once the current model shows that it is needed, as the
+          // number of pairs of indices is quadratic.
+          exprt indices_equal_expr = indices_equal;
+          if(!lazy_arrays)
+            indices_equal_expr = literal_exprt(convert(indices_equal));
+
+          if(
+            indices_equal_expr.id() != ID_literal ||
+            to_literal_expr(indices_equal_expr).get_literal() !=
+              const_literal(false))
           {
             const typet &subtype = arrays[i].type().subtype();
             index_exprt index_expr1(arrays[i], *i1, subtype);
@@ -365,7 +370,7 @@ void arrayst::add_array_Ackermann_constraints()
 
             // add constraint
             lazy_constraintt lazy(lazy_typet::ARRAY_ACKERMANN,
-              implies_exprt(literal_exprt(indices_equal_lit), values_equal));
+              implies_exprt(indices_equal_expr, values_equal));
             add_array_constraint(lazy, true); // added lazily
 
 #if 0 // old code for adding, not significantly faster
@@ -105,7 +105,7 @@ protected:
   bool incremental_cache;
   std::list<lazy_constraintt> lazy_array_constraints;
   void add_array_constraint(const lazy_constraintt &lazy, bool refine = true);
-  std::map<exprt, bool> expr_map;
+  std::unordered_set<exprt, irep_hash> lazy_constraint_exprs;
 
   // adds all the constraints eagerly
   void add_array_constraints();
@@ -13,9 +13,11 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <set>
 
 #include <util/arith_tools.h>
+#include <util/expr_util.h>
 #include <util/magic.h>
 #include <util/mp_arith.h>
 #include <util/prefix.h>
+#include <util/profiler.h>
 #include <util/replace_expr.h>
 #include <util/std_expr.h>
 #include <util/std_types.h>
@@ -126,6 +128,17 @@ boolbvt::convert_bv(const exprt &expr, optionalt<std::size_t> expected_width)
     return cache_result.first->second;
   }
 
+  // a + b has the same encoding as b + a
+  if(const auto commuted = commute_operands(expr))
+  {
+    const auto commuted_entry = bv_cache.find(*commuted);
+    if(commuted_entry != bv_cache.end())
+    {
+      cache_result.first->second = commuted_entry->second;
+      return cache_result.first->second;
+    }
+  }
+
   // Iterators into hash_maps supposedly stay stable
   // even though we are inserting more elements recursively.
 
@@ -173,6 +186,8 @@ bvt boolbvt::conversion_failed(const exprt &expr)
 ///   circuit
 bvt boolbvt::convert_bitvector(const exprt &expr)
 {
+  profile_scopet profile_scope("flatten", expr.id(), false);
+
   if(expr.type().id()==ID_bool)
   {
     bvt bv;
@@ -648,6 +663,26 @@ void boolbvt::print_assignment(std::ostream &out) const
     out << pair.first << "=" << pair.second.get_value(prop) << '\n';
 }
 
+void boolbvt::identify_variables(
+  const std::unordered_set<literalt::var_not> &variables,
+  std::unordered_map<literalt::var_not, irep_idt> &identifiers) const
+{
+  arrayst::identify_variables(variables, identifiers);
+
+  for(const auto &pair : map.mapping)
+  {
+    for(const auto &bit : pair.second.literal_map)
+    {
+      if(
+        bit.is_set && !bit.l.is_constant() &&
+        variables.find(bit.l.var_no()) != variables.end())
+      {
+        identifiers.emplace(bit.l.var_no(), pair.first);
+      }
+    }
+  }
+}
+
 boolbvt::offset_mapt boolbvt::build_offset_map(const struct_typet &src)
 {
   const struct_typet::componentst &components = src.components();
@@ -14,6 +14,8 @@ Author: Daniel Kroening, kroening@kroening.com
 // convert expression to boolean formula
 //
 
+#include <functional>
+
 #include <util/byte_operators.h>
 #include <util/expr.h>
 #include <util/mp_arith.h>
@@ -55,9 +57,24 @@ public:
 
   // overloading
   exprt get(const exprt &expr) const override;
+
+  /// Solves until the model satisfies all instances of the lazily
+  /// instantiated quantifiers that it is checked against, see
+  /// \ref refine_lazy_quantifiers
+  decision_proceduret::resultt dec_solve() override;
+
+  /// Get the values of all \p exprs in the current model. The model bits of
+  /// all symbols among \p exprs are read in one pass into a packed buffer
+  /// before the values are reconstructed from it.
+  std::vector<exprt> get_values(const std::vector<exprt> &exprs) const;
   void set_to(const exprt &expr, bool value) override;
   void print_assignment(std::ostream &out) const override;
 
+  void identify_variables(
+    const std::unordered_set<literalt::var_not> &variables,
+    std::unordered_map<literalt::var_not, irep_idt> &identifiers)
+    const override;
+
   void clear_cache() override
   {
     SUB::clear_cache();
@@ -80,6 +97,19 @@ public:
   enum class unbounded_arrayt { U_NONE, U_ALL, U_AUTO };
   unbounded_arrayt unbounded_array;
 
+  void set_multiplier_encoding(bv_utilst::multiplier_encodingt encoding)
+  {
+    bv_utils.multiplier_encoding = encoding;
+  }
+
+  /// Freeze the literals of symbols (but not those of intermediate results),
+  /// such that constraints over symbols can be added after solving without
+  /// giving up on SAT preprocessing altogether, see \ref set_all_frozen
+  void set_symbols_frozen()
+  {
+    map.freeze_literals = true;
+  }
+
   mp_integer get_value(const bvt &bv)
   {
     return get_value(bv, 0, bv.size());
@@ -146,6 +176,13 @@ protected:
   virtual bvt convert_struct(const struct_exprt &expr);
   virtual bvt convert_array(const exprt &expr);
   virtual bvt convert_vector(const vector_exprt &expr);
+
+  /// Convert the binary operation \p expr on vectors lane by lane, using
+  /// \p convert_lane on the literals of the lanes of both operands. Lanes
+  /// with the same operand literals share one circuit.
+  bvt convert_vector_lanes(
+    const exprt &expr,
+    const std::function<bvt(const bvt &, const bvt &)> &convert_lane);
   virtual bvt convert_complex(const complex_exprt &expr);
   virtual bvt convert_complex_real(const complex_real_exprt &expr);
   virtual bvt convert_complex_imag(const complex_imag_exprt &expr);
@@ -235,6 +272,14 @@ protected:
     const typet &type) const;
 
   exprt bv_get(const bvt &bv, const typet &type) const;
+
+  /// Value of \p l in the current model, without asking the SAT solver for
+  /// constant literals
+  tvt bv_get_bit(literalt l) const
+  {
+    return l.is_constant() ? tvt(l.is_true()) : prop.l_get(l);
+  }
+
   exprt bv_get_cache(const exprt &expr) const;
 
   // unbounded arrays
@@ -256,6 +301,52 @@ protected:
   typedef std::list<quantifiert> quantifier_listt;
   quantifier_listt quantifier_list;
 
+  /// A quantifier whose body reads arrays at indices that depend on the
+  /// quantified variable, which is instantiated on demand rather than by
+  /// expanding it over its range. For a forall, the direction from
+  /// \ref l being false to the body being false in some instance is encoded
+  /// by a Skolem constant right away; instances that make \ref l imply the
+  /// body are added for the terms of the array index sets, and for the
+  /// values at which the current model violates the body. Existential
+  /// quantifiers are handled dually.
+  struct lazy_quantifiert
+  {
+    bool is_forall;
+    symbol_exprt var;
+    /// The simplified body
+    exprt where;
+    literalt l;
+    /// The constant bounds of \ref var, if they can be determined
+    optionalt<std::pair<mp_integer, mp_integer>> range;
+    /// The array reads `a[var + offset]` in \ref where, with their offsets
+    std::vector<std::pair<index_exprt, mp_integer>> triggers;
+    /// The terms that \ref var has been instantiated with
+    std::unordered_set<exprt, irep_hash> instances;
+  };
+
+  typedef std::list<lazy_quantifiert> lazy_quantifierst;
+  lazy_quantifierst lazy_quantifiers;
+
+  literalt convert_lazy_quantifier(
+    const quantifier_exprt &src,
+    const exprt &where,
+    const optionalt<std::pair<mp_integer, mp_integer>> &range,
+    std::vector<std::pair<index_exprt, mp_integer>> triggers);
+
+  /// Adds the instance of \p quantifier for \p term, unless it has been
+  /// added before
+  void instantiate_lazy_quantifier(
+    lazy_quantifiert &quantifier,
+    const exprt &term);
+
+  /// Checks the lazily instantiated quantifiers against the current model,
+  /// for all values of their range if it is small enough, and otherwise for
+  /// the indices of the bounded arrays they read, and adds the instances
+  /// that the model violates
+  /// \return true if instances were added, such that the formula has to be
+  ///   solved again
+  bool refine_lazy_quantifiers();
+
   void post_process_quantifiers();
 
   typedef std::vector<std::size_t> offset_mapt;
@@ -12,6 +12,23 @@ Author: Daniel Kroening, kroening@kroening.com
 
 bvt boolbvt::convert_div(const div_exprt &expr)
 {
+  if(expr.type().id() == ID_vector)
+  {
+    const typet &lane_type = expr.type().subtype();
+    if(lane_type.id() != ID_unsignedbv && lane_type.id() != ID_signedbv)
+      return conversion_failed(expr);
+
+    const bv_utilst::representationt rep =
+      lane_type.id() == ID_signedbv ? bv_utilst::representationt::SIGNED
+                                    : bv_utilst::representationt::UNSIGNED;
+
+    return convert_vector_lanes(expr, [this, rep](const bvt &a, const bvt &b) {
+      bvt res, rem;
+      bv_utils.divider(a, b, res, rem, rep);
+      return res;
+    });
+  }
+
   if(expr.type().id()!=ID_unsignedbv &&
      expr.type().id()!=ID_signedbv &&
      expr.type().id()!=ID_fixedbv)
@@ -68,6 +68,80 @@ exprt boolbvt::get(const exprt &expr) const
   return SUB::get(expr);
 }
 
+std::vector<exprt>
+boolbvt::get_values(const std::vector<exprt> &exprs) const
+{
+  // the map entries of the symbols, null for anything else
+  std::vector<const boolbv_mapt::map_entryt *> map_entries;
+  map_entries.reserve(exprs.size());
+  std::size_t total_width = 0;
+
+  for(const auto &expr : exprs)
+  {
+    const boolbv_mapt::map_entryt *map_entry = nullptr;
+
+    if(expr.id() == ID_symbol || expr.id() == ID_nondet_symbol)
+    {
+      const auto it = map.mapping.find(expr.get(ID_identifier));
+
+      if(it != map.mapping.end())
+      {
+        PRECONDITION(
+          expr.type() == typet() || expr.type() == it->second.type);
+        map_entry = &it->second;
+        total_width += map_entry->width;
+      }
+    }
+
+    map_entries.push_back(map_entry);
+  }
+
+  // read the model bits of all symbols in one pass; bits without a literal
+  // are taken to be false, as in get
+  std::vector<bool> model;
+  model.reserve(total_width);
+
+  for(const auto map_entry : map_entries)
+  {
+    if(map_entry == nullptr)
+      continue;
+
+    for(std::size_t bit_nr = 0; bit_nr < map_entry->width; bit_nr++)
+    {
+      const auto &literal_map = map_entry->literal_map[bit_nr];
+      model.push_back(
+        literal_map.is_set && bv_get_bit(literal_map.l).is_true());
+    }
+  }
+
+  // reconstruct the values from the buffer, which now holds constants only
+  std::vector<exprt> values;
+  values.reserve(exprs.size());
+  std::size_t model_offset = 0;
+
+  for(std::size_t i = 0; i < exprs.size(); i++)
+  {
+    const boolbv_mapt::map_entryt *map_entry = map_entries[i];
+
+    if(map_entry == nullptr)
+    {
+      values.push_back(get(exprs[i]));
+      continue;
+    }
+
+    bvt bv;
+    bv.reserve(map_entry->width);
+    for(std::size_t bit_nr = 0; bit_nr < map_entry->width; bit_nr++)
+      bv.push_back(const_literal(model[model_offset + bit_nr]));
+    model_offset += map_entry->width;
+
+    const std::vector<bool> unknown(bv.size(), false);
+    values.push_back(bv_get_rec(exprs[i], bv, unknown, 0, map_entry->type));
+  }
+
+  return values;
+}
+
 exprt boolbvt::bv_get_rec(
   const exprt &expr,
   const bvt &bv,
@@ -85,7 +159,7 @@ exprt boolbvt::bv_get_rec(
     if(!unknown[offset])
     {
       // clang-format off
-      switch(prop.l_get(bv[offset]).get_value())
+      switch(bv_get_bit(bv[offset]).get_value())
       {
       case tvt::tv_enumt::TV_FALSE: return false_exprt();
       case tvt::tv_enumt::TV_TRUE:  return true_exprt();
@@ -225,25 +299,15 @@ exprt boolbvt::bv_get_rec(
     }
   }
 
-  // most significant bit first
-  std::string value;
+  // least significant bit first
+  std::vector<bool> bits;
+  bits.reserve(width);
 
   for(std::size_t bit_nr=offset; bit_nr<offset+width; bit_nr++)
-  {
-    char ch = '0';
-    if(!unknown[bit_nr])
-    {
-      switch(prop.l_get(bv[bit_nr]).get_value())
-      {
-       case tvt::tv_enumt::TV_FALSE: ch='0'; break;
-       case tvt::tv_enumt::TV_TRUE:  ch='1'; break;
-       case tvt::tv_enumt::TV_UNKNOWN: ch='0'; break;
-       default: UNREACHABLE;
-      }
-    }
+    bits.push_back(!unknown[bit_nr] && bv_get_bit(bv[bit_nr]).is_true());
 
-    value=ch+value;
-  }
+  const irep_idt bvrep =
+    make_bvrep(width, [&bits](std::size_t i) { return bits[i]; });
 
   switch(bvtype)
   {
@@ -251,7 +315,7 @@ exprt boolbvt::bv_get_rec(
     PRECONDITION(type.id() == ID_string || type.id() == ID_empty);
     if(type.id()==ID_string)
     {
-      mp_integer int_value=binary2integer(value, false);
+      mp_integer int_value = bvrep2integer(bvrep, width, false);
       irep_idt s;
       if(int_value>=string_numbering.size())
         s=irep_idt();
@@ -268,7 +332,7 @@ exprt boolbvt::bv_get_rec(
 
   case bvtypet::IS_RANGE:
   {
-    mp_integer int_value = binary2integer(value, false);
+    mp_integer int_value = bvrep2integer(bvrep, width, false);
     mp_integer from = string2integer(type.get_string(ID_from));
 
     return constant_exprt(integer2string(int_value + from), type);
@@ -285,12 +349,8 @@ exprt boolbvt::bv_get_rec(
   case bvtypet::IS_SIGNED:
   case bvtypet::IS_BV:
   case bvtypet::IS_C_ENUM:
-  {
-    const irep_idt bvrep = make_bvrep(
-      width, [&value](size_t i) { return value[value.size() - i - 1] == '1'; });
     return constant_exprt(bvrep, type);
   }
-  }
 
   UNREACHABLE;
 }
@@ -272,6 +272,42 @@ bvt boolbvt::convert_index(const index_exprt &expr)
       }
     }
   }
+  else if(array_op_type.id() == ID_vector)
+  {
+    // vectors are of small constant size and always flattened
+    std::size_t width = boolbv_width(expr.type());
+
+    if(width == 0)
+      return conversion_failed(expr);
+
+    const std::size_t size =
+      numeric_cast_v<std::size_t>(to_vector_type(array_op_type).size());
+
+    const bvt &vector_bv = convert_bv(array, size * width);
+
+    // out-of-bounds accesses yield an unconstrained value
+    if(const auto index_value = numeric_cast<mp_integer>(index))
+    {
+      if(*index_value < 0 || *index_value >= size)
+        return prop.new_variables(width);
+
+      const std::size_t offset =
+        numeric_cast_v<std::size_t>(*index_value) * width;
+      return bvt(
+        vector_bv.begin() + offset, vector_bv.begin() + offset + width);
+    }
+
+    bv = prop.new_variables(width);
+
+    for(std::size_t i = 0; i < size; ++i)
+    {
+      const literalt e =
+        convert(equal_exprt(index, from_integer(i, index.type())));
+
+      for(std::size_t j = 0; j < width; ++j)
+        bv[j] = prop.lselect(e, vector_bv[i * width + j], bv[j]);
+    }
+  }
   else
     return conversion_failed(expr);
 
@@ -110,6 +110,9 @@ void boolbv_mapt::get_literals(
 
     l=prop.new_variable();
 
+    if(freeze_literals)
+      prop.set_frozen(l);
+
     mb.is_set=true;
     mb.l=l;
 
@@ -149,6 +152,9 @@ void boolbv_mapt::set_literals(
 
     mb.is_set=true;
     mb.l=literal;
+
+    if(freeze_literals && !literal.is_constant())
+      prop.set_frozen(literal);
   }
 }
 
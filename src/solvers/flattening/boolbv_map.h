@@ -76,6 +76,10 @@ public:
     const irep_idt &identifier,
     const typet &type);
 
+  /// Freeze the literals of all symbols, such that a SAT preprocessor keeps
+  /// them and constraints over them can still be added after solving
+  bool freeze_literals = false;
+
 protected:
   propt &prop;
   const boolbv_widtht &boolbv_width;
@@ -12,6 +12,21 @@ Author: Daniel Kroening, kroening@kroening.com
 
 bvt boolbvt::convert_mult(const mult_exprt &expr)
 {
+  if(expr.type().id() == ID_vector)
+  {
+    const typet &lane_type = expr.type().subtype();
+    if(lane_type.id() != ID_unsignedbv && lane_type.id() != ID_signedbv)
+      return conversion_failed(expr);
+
+    const bv_utilst::representationt rep =
+      lane_type.id() == ID_signedbv ? bv_utilst::representationt::SIGNED
+                                    : bv_utilst::representationt::UNSIGNED;
+
+    return convert_vector_lanes(expr, [this, rep](const bvt &a, const bvt &b) {
+      return bv_utils.multiplier(a, b, rep);
+    });
+  }
+
   std::size_t width=boolbv_width(expr.type());
 
   if(width==0)
@@ -15,6 +15,14 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/replace_expr.h>
 #include <util/simplify_expr.h>
 
+/// Quantifiers with a range of at most this many values are expanded right
+/// away rather than instantiated lazily
+static const std::size_t max_eager_quantifier_range = 16;
+
+/// The current model is checked against all values in the range of a lazily
+/// instantiated quantifier if it has at most this many values
+static const std::size_t max_model_checked_quantifier_range = 4096;
+
 /// A method to detect equivalence between experts that can contain typecast
 static bool expr_eq(const exprt &expr1, const exprt &expr2)
 {
@@ -123,34 +131,72 @@ get_quantifier_var_max(const exprt &var_expr, const exprt &quantifier_expr)
   return {};
 }
 
-static optionalt<exprt>
-instantiate_quantifier(const quantifier_exprt &expr, const namespacet &ns)
+/// The constant bounds of the quantifier variable in the simplified body
+/// \p re of a quantifier, if they can be determined
+static optionalt<std::pair<mp_integer, mp_integer>>
+get_quantifier_var_range(const symbol_exprt &var_expr, const exprt &re)
 {
-  const symbol_exprt &var_expr = expr.symbol();
+  const optionalt<constant_exprt> min_i = get_quantifier_var_min(var_expr, re);
+  const optionalt<constant_exprt> max_i = get_quantifier_var_max(var_expr, re);
 
-  /**
-   * We need to rewrite the forall/exists quantifier into
-   * an OR/AND expr.
-   **/
+  if(!min_i.has_value() || !max_i.has_value())
+    return nullopt;
 
-  const exprt re = simplify_expr(expr.where(), ns);
+  return std::make_pair(
+    numeric_cast_v<mp_integer>(min_i.value()),
+    numeric_cast_v<mp_integer>(max_i.value()));
+}
 
-  if(re.is_true() || re.is_false())
+/// The offset c if \p index is of the form `var_expr + c` or `var_expr - c`
+/// for a constant c, possibly with type casts
+static optionalt<mp_integer>
+get_trigger_offset(const symbol_exprt &var_expr, const exprt &index)
+{
+  const exprt &stripped = skip_typecast(index);
+
+  if(expr_eq(stripped, var_expr))
+    return mp_integer(0);
+
+  if(
+    (stripped.id() == ID_plus || stripped.id() == ID_minus) &&
+    stripped.operands().size() == 2 && expr_eq(stripped.op0(), var_expr))
   {
-    return re;
+    const auto offset = numeric_cast<mp_integer>(skip_typecast(stripped.op1()));
+    if(offset.has_value())
+      return stripped.id() == ID_plus ? *offset : -*offset;
   }
 
-  const optionalt<constant_exprt> min_i = get_quantifier_var_min(var_expr, re);
-  const optionalt<constant_exprt> max_i = get_quantifier_var_max(var_expr, re);
+  return nullopt;
+}
 
-  if(!min_i.has_value() || !max_i.has_value())
-    return nullopt;
+/// The array reads in \p re at indices of the form `var_expr + c`, which
+/// serve as triggers for instantiating the quantifier lazily
+static std::vector<std::pair<index_exprt, mp_integer>>
+get_triggers(const symbol_exprt &var_expr, const exprt &re)
+{
+  std::vector<std::pair<index_exprt, mp_integer>> triggers;
 
-  mp_integer lb = numeric_cast_v<mp_integer>(min_i.value());
-  mp_integer ub = numeric_cast_v<mp_integer>(max_i.value());
+  re.visit_pre([&var_expr, &triggers](const exprt &e) {
+    if(e.id() != ID_index)
+      return;
 
-  if(lb>ub)
-    return nullopt;
+    const index_exprt &index_expr = to_index_expr(e);
+    const auto offset = get_trigger_offset(var_expr, index_expr.index());
+    if(offset.has_value())
+      triggers.emplace_back(index_expr, *offset);
+  });
+
+  return triggers;
+}
+
+static exprt instantiate_quantifier(
+  const quantifier_exprt &expr,
+  const exprt &re,
+  const mp_integer &lb,
+  const mp_integer &ub,
+  const namespacet &ns)
+{
+  const symbol_exprt &var_expr = expr.symbol();
 
   std::vector<exprt> expr_insts;
   for(mp_integer i=lb; i<=ub; ++i)
@@ -198,10 +244,41 @@ literalt boolbvt::convert_quantifier(const quantifier_exprt &src)
 {
   PRECONDITION(src.id() == ID_forall || src.id() == ID_exists);
 
-  const auto res = instantiate_quantifier(src, ns);
+  const symbol_exprt &var_expr = src.symbol();
 
-  if(res)
-    return convert_bool(*res);
+  /**
+   * We need to rewrite the forall/exists quantifier into
+   * an OR/AND expr.
+   **/
+
+  const exprt re = simplify_expr(src.where(), ns);
+
+  if(re.is_true() || re.is_false())
+    return convert_bool(re);
+
+  const auto range = get_quantifier_var_range(var_expr, re);
+
+  if(!range.has_value() || range->first <= range->second)
+  {
+    const bool small_range =
+      range.has_value() &&
+      range->second - range->first < max_eager_quantifier_range;
+
+    if(
+      !small_range && (var_expr.type().id() == ID_signedbv ||
+                       var_expr.type().id() == ID_unsignedbv))
+    {
+      auto triggers = get_triggers(var_expr, re);
+      if(!triggers.empty())
+        return convert_lazy_quantifier(src, re, range, std::move(triggers));
+    }
+
+    if(range.has_value())
+    {
+      return convert_bool(
+        instantiate_quantifier(src, re, range->first, range->second, ns));
+    }
+  }
 
   // we failed to instantiate here, need to pass to post-processing
   quantifier_list.emplace_back(quantifiert(src, prop.new_variable()));
@@ -209,8 +286,214 @@ literalt boolbvt::convert_quantifier(const quantifier_exprt &src)
   return quantifier_list.back().l;
 }
 
+literalt boolbvt::convert_lazy_quantifier(
+  const quantifier_exprt &src,
+  const exprt &where,
+  const optionalt<std::pair<mp_integer, mp_integer>> &range,
+  std::vector<std::pair<index_exprt, mp_integer>> triggers)
+{
+  const symbol_exprt &var_expr = src.symbol();
+
+  lazy_quantifiers.push_back(lazy_quantifiert{src.id() == ID_forall,
+                                              var_expr,
+                                              where,
+                                              prop.new_variable(),
+                                              range,
+                                              std::move(triggers),
+                                              {}});
+  const lazy_quantifiert &quantifier = lazy_quantifiers.back();
+
+  // A Skolem constant gives the instance that falsifies a forall, or that
+  // satisfies an exists.
+  const symbol_exprt skolem(
+    "boolbvt::quantifier_skolem$" + std::to_string(lazy_quantifiers.size()),
+    var_expr.type());
+
+  exprt witness = where;
+  replace_expr(var_expr, skolem, witness);
+  if(quantifier.is_forall)
+    witness = not_exprt(witness);
+
+  if(range.has_value())
+  {
+    witness = and_exprt(
+      binary_predicate_exprt(
+        skolem, ID_ge, from_integer(range->first, var_expr.type())),
+      binary_predicate_exprt(
+        skolem, ID_le, from_integer(range->second, var_expr.type())),
+      witness);
+  }
+
+  const literalt witness_literal = convert_bool(witness);
+
+  if(quantifier.is_forall)
+    prop.lcnf(quantifier.l, witness_literal);
+  else
+    prop.lcnf(!quantifier.l, witness_literal);
+
+  return quantifier.l;
+}
+
+void boolbvt::instantiate_lazy_quantifier(
+  lazy_quantifiert &quantifier,
+  const exprt &term)
+{
+  if(!quantifier.instances.insert(term).second)
+    return;
+
+  exprt instance = quantifier.where;
+  replace_expr(quantifier.var, term, instance);
+
+  // the quantifier only ranges over its bounds, if they are known
+  if(quantifier.range.has_value())
+  {
+    const typet &type = quantifier.var.type();
+    const and_exprt in_range(
+      binary_predicate_exprt(
+        term, ID_ge, from_integer(quantifier.range->first, type)),
+      binary_predicate_exprt(
+        term, ID_le, from_integer(quantifier.range->second, type)));
+
+    if(quantifier.is_forall)
+      instance = implies_exprt(in_range, instance);
+    else
+      instance = and_exprt(in_range, instance);
+  }
+
+  const literalt instance_literal = convert_bool(simplify_expr(instance, ns));
+
+  // a forall implies each instance, each instance implies an exists
+  if(quantifier.is_forall)
+    prop.lcnf(!quantifier.l, instance_literal);
+  else
+    prop.lcnf(quantifier.l, !instance_literal);
+}
+
+decision_proceduret::resultt boolbvt::dec_solve()
+{
+  while(true)
+  {
+    const decision_proceduret::resultt result = SUB::dec_solve();
+
+    if(
+      result != decision_proceduret::resultt::D_SATISFIABLE ||
+      !refine_lazy_quantifiers())
+    {
+      return result;
+    }
+  }
+}
+
+bool boolbvt::refine_lazy_quantifiers()
+{
+  bool refined = false;
+
+  for(auto &quantifier : lazy_quantifiers)
+  {
+    // only a true forall or a false exists constrains every instance
+    if(prop.l_get(quantifier.l).is_true() != quantifier.is_forall)
+      continue;
+
+    std::set<mp_integer> candidates;
+
+    if(
+      quantifier.range.has_value() &&
+      quantifier.range->second - quantifier.range->first <
+        max_model_checked_quantifier_range)
+    {
+      for(mp_integer i = quantifier.range->first;
+          i <= quantifier.range->second;
+          ++i)
+      {
+        candidates.insert(i);
+      }
+    }
+    else
+    {
+      for(const auto &trigger : quantifier.triggers)
+      {
+        const typet &array_type = trigger.first.array().type();
+        if(array_type.id() != ID_array || is_unbounded_array(array_type))
+          continue;
+
+        const auto size =
+          numeric_cast<mp_integer>(to_array_type(array_type).size());
+        if(!size.has_value())
+          continue;
+
+        for(mp_integer i = 0; i < *size; ++i)
+        {
+          const mp_integer candidate = i - trigger.second;
+          if(
+            !quantifier.range.has_value() ||
+            (candidate >= quantifier.range->first &&
+             candidate <= quantifier.range->second))
+          {
+            candidates.insert(candidate);
+          }
+        }
+      }
+    }
+
+    for(const auto &candidate : candidates)
+    {
+      const exprt term = from_integer(candidate, quantifier.var.type());
+      if(quantifier.instances.count(term) != 0)
+        continue;
+
+      exprt instance = quantifier.where;
+      replace_expr(quantifier.var, term, instance);
+      const exprt value = simplify_expr(get(instance), ns);
+
+      if(quantifier.is_forall ? value.is_true() : value.is_false())
+        continue;
+
+      instantiate_lazy_quantifier(quantifier, term);
+      refined = true;
+    }
+  }
+
+  return refined;
+}
+
 void boolbvt::post_process_quantifiers()
 {
+  // Instantiate the lazy quantifiers with the array index sets, before
+  // the array constraints are generated from them. The index sets are not
+  // separated by array, which only adds instances.
+  if(!lazy_quantifiers.empty())
+  {
+    std::vector<exprt> index_set;
+    for(const auto &index_entry : index_map)
+    {
+      index_set.insert(
+        index_set.end(), index_entry.second.begin(), index_entry.second.end());
+    }
+
+    for(auto &quantifier : lazy_quantifiers)
+    {
+      const typet &type = quantifier.var.type();
+
+      for(const auto &index : index_set)
+      {
+        if(has_subexpr(index, [&quantifier](const exprt &e) {
+             return e == quantifier.var;
+           }))
+        {
+          continue;
+        }
+
+        for(const auto &trigger : quantifier.triggers)
+        {
+          exprt term = typecast_exprt::conditional_cast(index, type);
+          if(trigger.second != 0)
+            term = minus_exprt(term, from_integer(trigger.second, type));
+          instantiate_lazy_quantifier(quantifier, simplify_expr(term, ns));
+        }
+      }
+    }
+  }
+
   if(quantifier_list.empty())
     return;
 
@@ -95,6 +95,23 @@ bool boolbvt::type_conversion(
     }
   }
 
+  if(dest_type.id() == ID_vector && src_type.id() != ID_vector)
+  {
+    // (vector-type) x ==> { x, x, ..., x }
+    bvt lane;
+    if(type_conversion(src_type, src, dest_type.subtype(), lane))
+      return true;
+
+    INVARIANT(
+      !lane.empty() && dest_width % lane.size() == 0,
+      "total vector bit width shall be a multiple of the element bit width");
+
+    for(std::size_t i = 0; i < dest_width; i += lane.size())
+      dest.insert(dest.end(), lane.begin(), lane.end());
+
+    return false;
+  }
+
   if(src_type.id()==ID_complex)
   {
     INVARIANT(
@@ -526,7 +543,7 @@ bool boolbvt::type_conversion(
   case bvtypet::IS_C_BIT_FIELD:
   case bvtypet::IS_UNKNOWN:
   case bvtypet::IS_VERILOG_SIGNED:
-    if(dest_type.id()==ID_array)
+    if(dest_type.id() == ID_array || dest_type.id() == ID_vector)
     {
       if(src_width==dest_width)
       {
@@ -6,9 +6,10 @@ Author: Daniel Kroening, kroening@kroening.com
 
 \*******************************************************************/
 
-
 #include "boolbv.h"
 
+#include <map>
+
 bvt boolbvt::convert_vector(const vector_exprt &expr)
 {
   std::size_t width=boolbv_width(expr.type());
@@ -36,3 +37,54 @@ bvt boolbvt::convert_vector(const vector_exprt &expr)
 
   return bv;
 }
+
+bvt boolbvt::convert_vector_lanes(
+  const exprt &expr,
+  const std::function<bvt(const bvt &, const bvt &)> &convert_lane)
+{
+  PRECONDITION(expr.type().id() == ID_vector);
+
+  if(expr.operands().size() != 2)
+    return conversion_failed(expr);
+
+  const std::size_t width = boolbv_width(expr.type());
+  const std::size_t lane_width = boolbv_width(expr.type().subtype());
+
+  if(width == 0 || lane_width == 0)
+    return conversion_failed(expr);
+
+  INVARIANT(
+    width % lane_width == 0,
+    "total vector bit width shall be a multiple of the element bit width");
+
+  const bvt &op0 = convert_bv(expr.operands()[0], width);
+  const bvt &op1 = convert_bv(expr.operands()[1], width);
+
+  // lanes with equal operands, e.g., of a vector and a broadcast constant,
+  // get the same circuit
+  std::map<std::pair<bvt, bvt>, bvt> lane_cache;
+
+  bvt bv;
+  bv.reserve(width);
+
+  for(std::size_t offset = 0; offset < width; offset += lane_width)
+  {
+    std::pair<bvt, bvt> lane_ops(
+      bvt(op0.begin() + offset, op0.begin() + offset + lane_width),
+      bvt(op1.begin() + offset, op1.begin() + offset + lane_width));
+
+    auto cache_it = lane_cache.find(lane_ops);
+    if(cache_it == lane_cache.end())
+    {
+      bvt lane = convert_lane(lane_ops.first, lane_ops.second);
+      INVARIANT(
+        lane.size() == lane_width,
+        "lane-wise operations shall not change the element bit width");
+      cache_it = lane_cache.emplace(std::move(lane_ops), std::move(lane)).first;
+    }
+
+    bv.insert(bv.end(), cache_it->second.begin(), cache_it->second.end());
+  }
+
+  return bv;
+}
@@ -57,12 +57,23 @@ void boolbvt::convert_with(
   const bvt &prev_bv,
   bvt &next_bv)
 {
-  // we only do that on arrays, bitvectors, structs, and unions
+  // we only do that on arrays, vectors, bitvectors, structs, and unions
 
   next_bv.resize(prev_bv.size());
 
   if(type.id()==ID_array)
     return convert_with_array(to_array_type(type), op1, op2, prev_bv, next_bv);
+  else if(type.id() == ID_vector)
+  {
+    // vectors are laid out like arrays of constant size
+    const vector_typet &vector_type = to_vector_type(type);
+    return convert_with_array(
+      array_typet(vector_type.subtype(), vector_type.size()),
+      op1,
+      op2,
+      prev_bv,
+      next_bv);
+  }
   else if(type.id()==ID_bv ||
           type.id()==ID_unsignedbv ||
           type.id()==ID_signedbv)
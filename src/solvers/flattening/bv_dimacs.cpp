@@ -18,6 +18,14 @@ Author: Daniel Kroening, kroening@kroening.com
 
 bool bv_dimacst::write_dimacs()
 {
+  // the clauses have been written while they were generated
+  if(auto dimacs_stream = dynamic_cast<dimacs_cnf_streamt *>(&prop))
+  {
+    dimacs_stream->finish();
+    write_mapping(dimacs_stream->stream());
+    return false;
+  }
+
   if(filename.empty() || filename == "-")
     return write_dimacs(std::cout);
 
@@ -35,7 +43,12 @@ bool bv_dimacst::write_dimacs()
 bool bv_dimacst::write_dimacs(std::ostream &out)
 {
   dynamic_cast<dimacs_cnft &>(prop).write_dimacs_cnf(out);
+  write_mapping(out);
+  return false;
+}
 
+void bv_dimacst::write_mapping(std::ostream &out)
+{
   // we dump the mapping variable<->literals
   for(const auto &s : get_symbols())
   {
@@ -67,6 +80,4 @@ bool bv_dimacst::write_dimacs(std::ostream &out)
 
     out << "\n";
   }
-
-  return false;
 }
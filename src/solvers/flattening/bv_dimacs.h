@@ -32,9 +32,14 @@ public:
   }
 
 protected:
+  /// File to write to, unless the clauses were streamed to it by a
+  /// \ref dimacs_cnf_streamt during conversion
   const std::string filename;
   bool write_dimacs();
   bool write_dimacs(std::ostream &);
+
+  /// Write the mapping of symbols and bit-vectors to literals as comments
+  void write_mapping(std::ostream &);
 };
 
 #endif // CPROVER_SOLVERS_FLATTENING_BV_DIMACS_H
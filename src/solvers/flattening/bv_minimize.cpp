@@ -52,19 +52,21 @@ void bv_minimizet::add_objective(
   }
 }
 
+void bv_minimizet::add_objectives(
+  prop_minimizet &prop_minimize,
+  const minimization_listt &symbols)
+{
+  for(const auto &symbol : symbols)
+    add_objective(prop_minimize, symbol);
+}
+
 void bv_minimizet::operator()(const minimization_listt &symbols)
 {
   // build bit-wise objective function
 
   prop_minimizet prop_minimize(boolbv, log.get_message_handler());
 
-  for(minimization_listt::const_iterator
-      l_it=symbols.begin();
-      l_it!=symbols.end();
-      l_it++)
-  {
-    add_objective(prop_minimize, *l_it);
-  }
+  add_objectives(prop_minimize, symbols);
 
   // now solve
   prop_minimize();
@@ -32,6 +32,12 @@ public:
 
   void operator()(const minimization_listt &objectives);
 
+  /// Add the bit-wise objective functions of \p objectives to
+  /// \p prop_minimize, for callers that configure the minimizer themselves
+  void add_objectives(
+    class prop_minimizet &prop_minimize,
+    const minimization_listt &objectives);
+
 protected:
   boolbvt &boolbv;
   messaget log;
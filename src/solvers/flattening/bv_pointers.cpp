@@ -603,7 +603,7 @@ exprt bv_pointerst::bv_get_rec(
       ch='0';
     else
     {
-      switch(prop.l_get(bv[bit_nr]).get_value())
+      switch(bv_get_bit(bv[bit_nr]).get_value())
       {
        case tvt::tv_enumt::TV_FALSE: ch='0'; break;
        case tvt::tv_enumt::TV_TRUE:  ch='1'; break;
@@ -724,6 +724,54 @@ void bv_pointerst::add_addr(const exprt &expr, bvt &bv)
   encode(a, bv);
 }
 
+const bvt &bv_pointerst::decode_object(const bvt &bv)
+{
+  const bvt object_bv(bv.begin() + offset_bits, bv.end());
+
+  auto entry = decoded_objects.emplace(object_bv, bvt());
+  if(!entry.second)
+    return entry.first->second;
+
+  const std::size_t number_of_objects = pointer_logic.objects.size();
+
+  // the bits above those that are needed to number the objects are zero
+  std::size_t needed_bits = 0;
+  while(needed_bits < object_bits &&
+        (std::size_t(1) << needed_bits) < number_of_objects)
+  {
+    ++needed_bits;
+  }
+
+  bvt high_bits_zero;
+  for(std::size_t i = needed_bits; i < object_bits; i++)
+    high_bits_zero.push_back(!object_bv[i]);
+
+  // prefixes[j] holds iff the bits of the object part from bit i upwards
+  // are those of j, hence after the last bit iff the object part is j
+  bvt prefixes(1, prop.land(high_bits_zero));
+  for(std::size_t i = needed_bits; i > 0; i--)
+  {
+    const std::size_t bit = i - 1;
+    const std::size_t width = std::size_t(1) << bit;
+    const std::size_t size = (number_of_objects + width - 1) / width;
+
+    bvt next;
+    next.reserve(size);
+    for(std::size_t j = 0; j < size; j++)
+    {
+      const literalt prefix = prefixes[j / 2];
+      next.push_back(
+        prop.land(prefix, j % 2 == 0 ? !object_bv[bit] : object_bv[bit]));
+    }
+
+    prefixes.swap(next);
+  }
+
+  prefixes.resize(number_of_objects, const_literal(false));
+  entry.first->second.swap(prefixes);
+  return entry.first->second;
+}
+
 void bv_pointerst::do_postponed(
   const postponedt &postponed)
 {
@@ -738,19 +786,10 @@ void bv_pointerst::do_postponed(
 
       bool is_dynamic=pointer_logic.is_dynamic_object(expr);
 
-      // only compare object part
-      bvt bv;
-      encode(number, bv);
-
-      bv.erase(bv.begin(), bv.begin()+offset_bits);
-
-      bvt saved_bv=postponed.op;
-      saved_bv.erase(saved_bv.begin(), saved_bv.begin()+offset_bits);
-
-      POSTCONDITION(bv.size()==saved_bv.size());
       PRECONDITION(postponed.bv.size()==1);
 
-      literalt l1=bv_utils.equal(bv, saved_bv);
+      // only compare object part
+      literalt l1 = decode_object(postponed.op)[number];
       literalt l2=postponed.bv.front();
 
       if(!is_dynamic)
@@ -779,22 +818,13 @@ void bv_pointerst::do_postponed(
       const exprt object_size = typecast_exprt::conditional_cast(
         size_expr.value(), postponed.expr.type());
 
-      // only compare object part
-      bvt bv;
-      encode(number, bv);
-
-      bv.erase(bv.begin(), bv.begin()+offset_bits);
-
-      bvt saved_bv=postponed.op;
-      saved_bv.erase(saved_bv.begin(), saved_bv.begin()+offset_bits);
-
       bvt size_bv = convert_bv(object_size);
 
-      POSTCONDITION(bv.size()==saved_bv.size());
       PRECONDITION(postponed.bv.size()>=1);
       PRECONDITION(size_bv.size() == postponed.bv.size());
 
-      literalt l1=bv_utils.equal(bv, saved_bv);
+      // only compare object part
+      literalt l1 = decode_object(postponed.op)[number];
       literalt l2=bv_utils.equal(postponed.bv, size_bv);
 
       prop.l_set_to_true(prop.limplies(l1, l2));
@@ -817,4 +847,6 @@ void bv_pointerst::post_process()
 
   // Clear the list to avoid re-doing in case of incremental usage.
   postponed_list.clear();
+  // Further objects may be numbered in an incremental use.
+  decoded_objects.clear();
 }
@@ -11,6 +11,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_SOLVERS_FLATTENING_BV_POINTERS_H
 
 
+#include <map>
+
 #include "boolbv.h"
 #include "pointer_logic.h"
 
@@ -67,6 +69,14 @@ protected:
   typedef std::list<postponedt> postponed_listt;
   postponed_listt postponed_list;
 
+  /// For each numbered object, the literal that is true iff the object
+  /// part of the pointer \p bv is its number. The object parts of postponed
+  /// expressions are decoded once per pointer, sharing the comparisons of
+  /// common prefixes of the numbers, rather than compared to every object
+  /// number bit by bit.
+  const bvt &decode_object(const bvt &bv);
+  std::map<bvt, bvt> decoded_objects;
+
   void do_postponed(const postponedt &postponed);
 };
 
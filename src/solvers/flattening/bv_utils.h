@@ -30,6 +30,20 @@ public:
 
   enum class representationt { SIGNED, UNSIGNED };
 
+  /// Circuits that \ref unsigned_multiplier can use to sum up the partial
+  /// products
+  enum class multiplier_encodingt
+  {
+    /// add one partial product after the other
+    SHIFT_ADD,
+    /// reduce groups of three partial products by carry-save adders
+    WALLACE_TREE,
+    /// reduce the bits of each weight to two by as few adders as possible
+    DADDA_TREE
+  };
+
+  multiplier_encodingt multiplier_encoding = multiplier_encodingt::SHIFT_ADD;
+
   bvt build_constant(const mp_integer &i, std::size_t width);
 
   bvt incrementer(const bvt &op, literalt carry_in);
@@ -242,7 +256,16 @@ protected:
 
   bvt cond_negate_no_overflow(const bvt &bv, const literalt cond);
 
+  /// Multiply \p op by \p constant, which must be of the same width, by
+  /// adding and subtracting shifted copies of \p op according to the
+  /// canonical signed digit representation of \p constant. A run of ones
+  /// thus takes one addition and one subtraction instead of one addition per
+  /// bit. The result is truncated to the width of \p op, and is therefore
+  /// the same for signed and unsigned operands.
+  bvt constant_multiplier(const bvt &op, const bvt &constant);
+
   bvt wallace_tree(const std::vector<bvt> &pps);
+  bvt dadda_tree(const std::vector<bvt> &pps);
 };
 
 #endif // CPROVER_SOLVERS_FLATTENING_BV_UTILS_H
@@ -897,6 +897,294 @@ static optionalt<exprt> lower_byte_extract_complex(
     ns);
 }
 
+/// Maximum number of constant values of a non-constant offset for which a
+/// byte operator is lowered once per value rather than for any offset
+static const std::size_t max_offset_cases = 16;
+
+/// A constant value that an offset takes when its guard holds
+typedef std::vector<std::pair<exprt, exprt>> offset_casest;
+
+/// Determine the constant values that \p offset can take, as for offsets
+/// that symex merged from several paths, which are conditionals over
+/// constants. The guards of the cases are mutually exclusive and exhaustive.
+/// \return false if \p offset is not built from conditionals, constants and
+///   arithmetic, or has more than \ref max_offset_cases values
+static bool offset_cases(
+  const exprt &offset,
+  const exprt &guard,
+  offset_casest &dest,
+  const namespacet &ns)
+{
+  if(dest.size() > max_offset_cases)
+    return false;
+
+  if(offset.is_constant())
+  {
+    dest.emplace_back(guard, offset);
+    return true;
+  }
+  else if(offset.id() == ID_if)
+  {
+    const if_exprt &if_expr = to_if_expr(offset);
+    return offset_cases(
+             if_expr.true_case(),
+             simplify_expr(and_exprt{guard, if_expr.cond()}, ns),
+             dest,
+             ns) &&
+           offset_cases(
+             if_expr.false_case(),
+             simplify_expr(and_exprt{guard, not_exprt{if_expr.cond()}}, ns),
+             dest,
+             ns);
+  }
+  else if(
+    offset.id() != ID_typecast && offset.id() != ID_plus &&
+    offset.id() != ID_minus && offset.id() != ID_mult)
+  {
+    return false;
+  }
+
+  // the cases of the operation are the combinations of those of its operands
+  offset_casest cases{{guard, offset}};
+  for(std::size_t i = 0; i < offset.operands().size(); ++i)
+  {
+    offset_casest next;
+    for(const auto &c : cases)
+    {
+      offset_casest operand_cases;
+      if(!offset_cases(
+           c.second.operands()[i], c.first, operand_cases, ns))
+        return false;
+
+      for(auto &operand_case : operand_cases)
+      {
+        exprt value = c.second;
+        value.operands()[i] = std::move(operand_case.second);
+        next.emplace_back(std::move(operand_case.first), std::move(value));
+      }
+
+      if(next.size() > max_offset_cases)
+        return false;
+    }
+    cases.swap(next);
+  }
+
+  for(auto &c : cases)
+  {
+    exprt value = simplify_expr(std::move(c.second), ns);
+    if(!value.is_constant())
+      return false;
+    dest.emplace_back(std::move(c.first), std::move(value));
+  }
+
+  return dest.size() <= max_offset_cases;
+}
+
+/// Lower the byte operator \p src once for each constant value that its
+/// non-constant offset can take, and select among the results by the guards
+/// of these values. This avoids a case for every possible byte position of
+/// the object when the offset can only take few values.
+/// \return nullopt if the offset is not one of few constant values
+template <typename byte_operatort>
+static optionalt<exprt> lower_byte_operator_offset_cases(
+  const byte_operatort &src,
+  exprt (*lower)(const byte_operatort &, const namespacet &),
+  const namespacet &ns)
+{
+  offset_casest cases;
+  if(
+    !offset_cases(src.offset(), true_exprt{}, cases, ns) || cases.size() < 2)
+  {
+    return {};
+  }
+
+  byte_operatort case_src = src;
+  case_src.offset() = cases.back().second;
+  exprt result = lower(case_src, ns);
+  for(auto it = std::next(cases.rbegin()); it != cases.rend(); ++it)
+  {
+    case_src.offset() = it->second;
+    result = if_exprt{it->first, lower(case_src, ns), std::move(result)};
+  }
+
+  return std::move(result);
+}
+
+/// Find the member of a struct-typed \p src that completely contains the
+/// \p size_bits bits starting at byte \p offset_bytes.
+/// \param [out] offset_in_member: the offset relative to the member
+/// \return nullptr if there is no byte-aligned member of known size that
+///   contains these bits
+static const struct_union_typet::componentt *containing_member(
+  const struct_typet &struct_type,
+  const mp_integer &offset_bytes,
+  const mp_integer &size_bits,
+  mp_integer &offset_in_member,
+  const namespacet &ns)
+{
+  mp_integer member_offset_bits = 0;
+  for(const auto &component : struct_type.components())
+  {
+    const auto member_bits = pointer_offset_bits(component.type(), ns);
+    if(!member_bits.has_value())
+      return nullptr;
+
+    if(
+      member_offset_bits % 8 == 0 && offset_bytes * 8 >= member_offset_bits &&
+      offset_bytes * 8 + size_bits <= member_offset_bits + *member_bits)
+    {
+      offset_in_member = offset_bytes - member_offset_bits / 8;
+      return &component;
+    }
+
+    member_offset_bits += *member_bits;
+  }
+
+  return nullptr;
+}
+
+/// Find the element of an array-typed \p src that completely contains the
+/// \p size_bits bits starting at byte \p offset_bytes.
+/// \param [out] offset_in_element: the offset relative to the element
+/// \return the index of the element, or nullopt if the array has no constant
+///   size, its elements are not byte-aligned, or the bits are out of bounds
+///   or span several elements
+static optionalt<mp_integer> containing_element(
+  const array_typet &array_type,
+  const mp_integer &offset_bytes,
+  const mp_integer &size_bits,
+  mp_integer &offset_in_element,
+  const namespacet &ns)
+{
+  const auto element_bits = pointer_offset_bits(array_type.subtype(), ns);
+  const auto num_elements = numeric_cast<mp_integer>(array_type.size());
+  if(
+    !element_bits.has_value() || *element_bits == 0 || *element_bits % 8 != 0 ||
+    !num_elements.has_value())
+  {
+    return {};
+  }
+
+  const mp_integer element_bytes = *element_bits / 8;
+  const mp_integer index = offset_bytes / element_bytes;
+  offset_in_element = offset_bytes % element_bytes;
+  if(index >= *num_elements || offset_in_element * 8 + size_bits > *element_bits)
+    return {};
+
+  return index;
+}
+
+/// Rewrite an extraction of \p target_type at the constant \p offset_bytes of
+/// \p src into member and index expressions, if a sub-object of exactly this
+/// type starts at this offset. As the sub-object is read as a whole, the
+/// result does not depend on endianness.
+/// \return nullopt if there is no such sub-object, in which case the
+///   general lowering applies
+static optionalt<exprt> lower_aligned_byte_extract(
+  const exprt &src,
+  const mp_integer &offset_bytes,
+  const typet &target_type,
+  const mp_integer &target_bits,
+  const namespacet &ns)
+{
+  if(offset_bytes == 0 && src.type() == target_type)
+    return src;
+
+  const typet &src_type = ns.follow(src.type());
+  mp_integer offset_in_sub;
+
+  if(src_type.id() == ID_struct)
+  {
+    const auto component = containing_member(
+      to_struct_type(src_type), offset_bytes, target_bits, offset_in_sub, ns);
+    if(component == nullptr)
+      return {};
+
+    return lower_aligned_byte_extract(
+      member_exprt{src, component->get_name(), component->type()},
+      offset_in_sub,
+      target_type,
+      target_bits,
+      ns);
+  }
+  else if(src_type.id() == ID_array)
+  {
+    const array_typet &array_type = to_array_type(src_type);
+    const auto index = containing_element(
+      array_type, offset_bytes, target_bits, offset_in_sub, ns);
+    if(!index.has_value())
+      return {};
+
+    return lower_aligned_byte_extract(
+      index_exprt{src, from_integer(*index, array_type.size().type())},
+      offset_in_sub,
+      target_type,
+      target_bits,
+      ns);
+  }
+
+  return {};
+}
+
+/// Rewrite an update of \p src at the constant \p offset_bytes by \p value
+/// into `with` expressions, if a sub-object of exactly the type of \p value
+/// starts at this offset. As the sub-object is replaced as a whole, the
+/// result does not depend on endianness.
+/// \return nullopt if there is no such sub-object, in which case the
+///   general lowering applies
+static optionalt<exprt> lower_aligned_byte_update(
+  const exprt &src,
+  const mp_integer &offset_bytes,
+  const exprt &value,
+  const mp_integer &value_bits,
+  const namespacet &ns)
+{
+  if(offset_bytes == 0 && src.type() == value.type())
+    return value;
+
+  const typet &src_type = ns.follow(src.type());
+  mp_integer offset_in_sub;
+
+  if(src_type.id() == ID_struct)
+  {
+    const auto component = containing_member(
+      to_struct_type(src_type), offset_bytes, value_bits, offset_in_sub, ns);
+    if(component == nullptr)
+      return {};
+
+    const auto updated_member = lower_aligned_byte_update(
+      member_exprt{src, component->get_name(), component->type()},
+      offset_in_sub,
+      value,
+      value_bits,
+      ns);
+    if(!updated_member.has_value())
+      return {};
+
+    with_exprt result{src, exprt{ID_member_name}, *updated_member};
+    result.where().set(ID_component_name, component->get_name());
+    return std::move(result);
+  }
+  else if(src_type.id() == ID_array)
+  {
+    const array_typet &array_type = to_array_type(src_type);
+    const auto index = containing_element(
+      array_type, offset_bytes, value_bits, offset_in_sub, ns);
+    if(!index.has_value())
+      return {};
+
+    const exprt index_expr = from_integer(*index, array_type.size().type());
+    const auto updated_element = lower_aligned_byte_update(
+      index_exprt{src, index_expr}, offset_in_sub, value, value_bits, ns);
+    if(!updated_element.has_value())
+      return {};
+
+    return with_exprt{src, index_expr, *updated_element};
+  }
+
+  return {};
+}
+
 /// rewrite byte extraction from an array to byte extraction from a
 /// concatenation of array index expressions
 exprt lower_byte_extract(const byte_extract_exprt &src, const namespacet &ns)
@@ -951,6 +1239,24 @@ exprt lower_byte_extract(const byte_extract_exprt &src, const namespacet &ns)
     src.id() == ID_byte_extract_big_endian);
   const bool little_endian = src.id() == ID_byte_extract_little_endian;
 
+  // an aligned access to a sub-object of the requested type, as in copying
+  // whole elements, is just that sub-object
+  const auto offset_bytes = numeric_cast<mp_integer>(src.offset());
+  const auto target_bits = pointer_offset_bits(src.type(), ns);
+  if(offset_bytes.has_value() && target_bits.has_value() && *target_bits > 0)
+  {
+    auto aligned = lower_aligned_byte_extract(
+      src.op(), *offset_bytes, src.type(), *target_bits, ns);
+    if(aligned.has_value())
+      return std::move(*aligned);
+  }
+  else if(!offset_bytes.has_value())
+  {
+    auto cases = lower_byte_operator_offset_cases(src, lower_byte_extract, ns);
+    if(cases.has_value())
+      return std::move(*cases);
+  }
+
   // determine an upper bound of the number of bytes we might need
   auto upper_bound_opt = size_of_expr(src.type(), ns);
   if(upper_bound_opt.has_value())
@@ -2191,6 +2497,26 @@ exprt lower_byte_update(const byte_update_exprt &src, const namespacet &ns)
   if(src.type().id() == ID_empty || src.value().type().id() == ID_empty)
     return src.op();
 
+  // an aligned update of a sub-object by a value of its type replaces that
+  // sub-object
+  const auto offset_bytes = numeric_cast<mp_integer>(src.offset());
+  const auto value_bits = pointer_offset_bits(src.value().type(), ns);
+  if(offset_bytes.has_value() && value_bits.has_value() && *value_bits > 0)
+  {
+    auto aligned = lower_aligned_byte_update(
+      src.op(), *offset_bytes, src.value(), *value_bits, ns);
+    if(aligned.has_value())
+      return std::move(*aligned);
+  }
+  else if(!offset_bytes.has_value())
+  {
+    exprt (*lower)(const byte_update_exprt &, const namespacet &) =
+      lower_byte_update;
+    auto cases = lower_byte_operator_offset_cases(src, lower, ns);
+    if(cases.has_value())
+      return std::move(*cases);
+  }
+
   // byte_update lowering proceeds as follows:
   // 1) Determine the size of the update, with the size of the object to be
   // updated as an upper bound. We fail if neither can be determined.
@@ -0,0 +1,507 @@
+/*******************************************************************\
+
+Module: And-Inverter Graph in Front of a Propositional Solver
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// And-Inverter Graph in Front of a Propositional Solver
+
+#include "aig_prop.h"
+
+#include <unordered_set>
+
+#include <util/invariant.h>
+
+aig_prop_solvert::aig_prop_solvert(
+  std::unique_ptr<propt> _solver,
+  message_handlert &message_handler)
+  : propt(message_handler), solver(std::move(_solver))
+{
+  PRECONDITION(solver);
+}
+
+literalt aig_prop_solvert::land(literalt a, literalt b)
+{
+  if(a.is_false() || b.is_false())
+    return const_literal(false);
+  if(a.is_true())
+    return b;
+  if(b.is_true())
+    return a;
+  if(a == b)
+    return a;
+  if(a == !b)
+    return const_literal(false);
+
+  literalt result;
+  if(rewrite_and(a, b, result))
+    return result;
+
+  return new_and_node(a, b);
+}
+
+bool aig_prop_solvert::rewrite_and(literalt a, literalt b, literalt &result)
+{
+  for(int i = 0; i < 2; ++i, std::swap(a, b))
+  {
+    if(is_positive_and(a))
+    {
+      // the children are copied, as land may add nodes
+      const literalt x = node(a).a, y = node(a).b;
+
+      // contradiction: (x & y) & !x = false
+      if(b == !x || b == !y)
+      {
+        result = const_literal(false);
+        return true;
+      }
+
+      // idempotence: (x & y) & x = x & y
+      if(b == x || b == y)
+      {
+        result = a;
+        return true;
+      }
+
+      // contradiction: (x & y) & (!x & z) = false
+      if(is_positive_and(b))
+      {
+        const literalt z = node(b).a, w = node(b).b;
+        if(x == !z || x == !w || y == !z || y == !w)
+        {
+          result = const_literal(false);
+          return true;
+        }
+      }
+    }
+    else if(is_negative_and(a))
+    {
+      const literalt x = node(a).a, y = node(a).b;
+
+      // subsumption: !(x & y) & !x = !x
+      if(b == !x || b == !y)
+      {
+        result = b;
+        return true;
+      }
+
+      // substitution: !(x & y) & x = x & !y
+      if(b == x)
+      {
+        result = land(b, !y);
+        return true;
+      }
+      if(b == y)
+      {
+        result = land(b, !x);
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+literalt aig_prop_solvert::new_and_node(literalt a, literalt b)
+{
+  if(b < a)
+    std::swap(a, b);
+
+  const auto entry = and_nodes.emplace(
+    std::make_pair(a, b), narrow_cast<literalt::var_not>(nodes.size()));
+
+  if(entry.second)
+  {
+    ++nodes[a.var_no()].fanout;
+    ++nodes[b.var_no()].fanout;
+
+    nodes.emplace_back();
+    nodes.back().a = a;
+    nodes.back().b = b;
+  }
+
+  return literalt(entry.first->second, false);
+}
+
+literalt aig_prop_solvert::lor(literalt a, literalt b)
+{
+  return !land(!a, !b);
+}
+
+literalt aig_prop_solvert::land(const bvt &bv)
+{
+  literalt result = const_literal(true);
+
+  for(const auto l : bv)
+    result = land(result, l);
+
+  return result;
+}
+
+literalt aig_prop_solvert::lor(const bvt &bv)
+{
+  literalt result = const_literal(false);
+
+  for(const auto l : bv)
+    result = lor(result, l);
+
+  return result;
+}
+
+literalt aig_prop_solvert::lxor(literalt a, literalt b)
+{
+  if(a.is_constant())
+    return a.sign() ? !b : b;
+  if(b.is_constant())
+    return b.sign() ? !a : a;
+  if(a == b)
+    return const_literal(false);
+  if(a == !b)
+    return const_literal(true);
+
+  return lor(land(a, !b), land(!a, b));
+}
+
+literalt aig_prop_solvert::lxor(const bvt &bv)
+{
+  literalt result = const_literal(false);
+
+  for(const auto l : bv)
+    result = lxor(result, l);
+
+  return result;
+}
+
+literalt aig_prop_solvert::lnand(literalt a, literalt b)
+{
+  return !land(a, b);
+}
+
+literalt aig_prop_solvert::lnor(literalt a, literalt b)
+{
+  return !lor(a, b);
+}
+
+literalt aig_prop_solvert::lequal(literalt a, literalt b)
+{
+  return !lxor(a, b);
+}
+
+literalt aig_prop_solvert::limplies(literalt a, literalt b)
+{
+  return lor(!a, b);
+}
+
+literalt aig_prop_solvert::lselect(literalt a, literalt b, literalt c)
+{
+  // a?b:c = (a AND b) OR (/a AND c)
+  if(a.is_constant())
+    return a.sign() ? b : c;
+  if(b == c)
+    return b;
+
+  if(b.is_constant())
+    return b.sign() ? lor(a, c) : land(!a, c);
+  if(c.is_constant())
+    return c.sign() ? lor(!a, b) : land(a, b);
+
+  return lor(land(a, b), land(!a, c));
+}
+
+literalt aig_prop_solvert::new_variable()
+{
+  nodes.emplace_back();
+  nodes.back().converted = solver->new_variable();
+  ++converted_nodes;
+  return literalt(narrow_cast<literalt::var_not>(nodes.size() - 1), false);
+}
+
+void aig_prop_solvert::set_variable_name(literalt a, const irep_idt &name)
+{
+  if(!a.is_constant() && node(a).is_converted())
+    solver->set_variable_name(node(a).converted ^ a.sign(), name);
+}
+
+void aig_prop_solvert::and_leaves(
+  literalt l,
+  bool only_unshared,
+  bvt &dest) const
+{
+  PRECONDITION(is_positive_and(l));
+
+  std::vector<literalt> stack{l};
+  std::unordered_set<literalt::var_not> expanded{l.var_no()};
+
+  while(!stack.empty())
+  {
+    const nodet &n = node(stack.back());
+    stack.pop_back();
+
+    for(const literalt child : {n.a, n.b})
+    {
+      if(
+        is_positive_and(child) && !node(child).is_converted() &&
+        (!only_unshared || is_unshared(child)))
+      {
+        if(expanded.insert(child.var_no()).second)
+          stack.push_back(child);
+      }
+      else
+        dest.push_back(child);
+    }
+  }
+}
+
+aig_prop_solvert::gatet
+aig_prop_solvert::decompose(literalt::var_not n, bvt &inputs) const
+{
+  inputs.clear();
+  const nodet &gate = nodes[n];
+
+  // !(c & t) & !(!c & e) = !(c ? t : e), which includes exclusive-or when
+  // e = !t, as long as the inner conjunctions are not needed on their own.
+  // As for the conjunctions that are merged below, unshared nodes cannot be
+  // converted while converting the inputs, which keeps the result stable.
+  if(
+    is_negative_and(gate.a) && is_negative_and(gate.b) &&
+    is_unshared(gate.a) && is_unshared(gate.b))
+  {
+    const nodet &p = node(gate.a);
+    const nodet &q = node(gate.b);
+
+    for(const literalt c : {p.a, p.b})
+    {
+      for(const literalt not_c : {q.a, q.b})
+      {
+        if(c != !not_c)
+          continue;
+
+        const literalt t = c == p.a ? p.b : p.a;
+        const literalt e = not_c == q.a ? q.b : q.a;
+
+        inputs.push_back(c);
+        inputs.push_back(t);
+        if(t == !e)
+          return gatet::XOR;
+
+        inputs.push_back(e);
+        return gatet::SELECT;
+      }
+    }
+  }
+
+  and_leaves(literalt(n, false), true, inputs);
+  return gatet::AND;
+}
+
+void aig_prop_solvert::convert_node(literalt::var_not n)
+{
+  bvt inputs;
+  const gatet gate = decompose(n, inputs);
+
+  for(auto &l : inputs)
+  {
+    if(!l.is_constant())
+    {
+      INVARIANT(node(l).is_converted(), "inputs are converted first");
+      l = node(l).converted ^ l.sign();
+    }
+  }
+
+  literalt converted;
+  switch(gate)
+  {
+  case gatet::AND:
+    converted = solver->land(inputs);
+    break;
+  case gatet::XOR:
+    converted = solver->lxor(inputs[0], inputs[1]);
+    break;
+  case gatet::SELECT:
+    converted = !solver->lselect(inputs[0], inputs[1], inputs[2]);
+    break;
+  }
+
+  nodes[n].converted = converted;
+  ++converted_nodes;
+}
+
+literalt aig_prop_solvert::convert(literalt l)
+{
+  if(l.is_constant())
+    return l;
+
+  // depth-first, without recursion as the graph may be very deep
+  std::vector<std::pair<literalt::var_not, bool>> stack{{l.var_no(), false}};
+  bvt inputs;
+
+  while(!stack.empty())
+  {
+    const literalt::var_not n = stack.back().first;
+
+    if(nodes[n].is_converted())
+      stack.pop_back();
+    else if(stack.back().second)
+    {
+      stack.pop_back();
+      convert_node(n);
+    }
+    else
+    {
+      stack.back().second = true;
+      decompose(n, inputs);
+
+      for(const auto input : inputs)
+      {
+        if(!input.is_constant() && !node(input).is_converted())
+          stack.emplace_back(input.var_no(), false);
+      }
+    }
+  }
+
+  return node(l).converted ^ l.sign();
+}
+
+void aig_prop_solvert::l_set_to(literalt a, bool value)
+{
+  // a conjunction that is set to true is split into its conjuncts, and one
+  // that is set to false into a clause, without converting the conjunction
+  bvt stack{a ^ !value};
+  std::unordered_set<literalt::var_not> done;
+  bvt leaves, clause;
+
+  while(!stack.empty())
+  {
+    const literalt l = stack.back();
+    stack.pop_back();
+
+    if(l.is_true())
+      continue;
+
+    if(l.is_constant() || node(l).is_converted() || !node(l).is_and())
+      solver->l_set_to_true(convert(l));
+    else if(!l.sign())
+    {
+      if(done.insert(l.var_no()).second)
+      {
+        stack.push_back(node(l).a);
+        stack.push_back(node(l).b);
+      }
+    }
+    else
+    {
+      leaves.clear();
+      and_leaves(!l, false, leaves);
+
+      clause.clear();
+      for(const auto leaf : leaves)
+        clause.push_back(convert(!leaf));
+
+      solver->lcnf(clause);
+    }
+  }
+}
+
+void aig_prop_solvert::lcnf(const bvt &bv)
+{
+  bvt clause;
+  clause.reserve(bv.size());
+
+  for(const auto l : bv)
+    clause.push_back(convert(l));
+
+  solver->lcnf(clause);
+}
+
+void aig_prop_solvert::set_assumptions(const bvt &bv)
+{
+  bvt assumptions;
+  assumptions.reserve(bv.size());
+
+  for(const auto l : bv)
+    assumptions.push_back(convert(l));
+
+  solver->set_assumptions(assumptions);
+}
+
+void aig_prop_solvert::set_frozen(literalt a)
+{
+  if(!a.is_constant())
+    solver->set_frozen(convert(a));
+}
+
+const std::string aig_prop_solvert::solver_text()
+{
+  return "AIG with " + solver->solver_text();
+}
+
+tvt aig_prop_solvert::l_get(literalt a) const
+{
+  if(a.is_constant())
+    return tvt(a.is_true());
+
+  // evaluate the nodes that have not been converted
+  std::unordered_map<literalt::var_not, tvt> values;
+  std::vector<literalt::var_not> stack{a.var_no()};
+
+  auto value = [this, &values](literalt l, tvt &result) {
+    if(l.is_constant())
+      result = tvt(l.is_true());
+    else if(node(l).is_converted())
+      result = solver->l_get(node(l).converted ^ l.sign());
+    else
+    {
+      const auto entry = values.find(l.var_no());
+      if(entry == values.end())
+        return false;
+      result = l.sign() ? !entry->second : entry->second;
+    }
+    return true;
+  };
+
+  while(!stack.empty())
+  {
+    const nodet &n = nodes[stack.back()];
+    tvt a_value, b_value;
+
+    if(n.is_converted() || !n.is_and())
+      stack.pop_back();
+    else if(!value(n.a, a_value))
+      stack.push_back(n.a.var_no());
+    else if(!value(n.b, b_value))
+      stack.push_back(n.b.var_no());
+    else
+    {
+      values.emplace(stack.back(), a_value && b_value);
+      stack.pop_back();
+    }
+  }
+
+  tvt result;
+  if(!value(a, result))
+    return tvt::unknown();
+  return result;
+}
+
+void aig_prop_solvert::set_assignment(literalt a, bool value)
+{
+  if(!a.is_constant() && node(a).is_converted())
+    solver->set_assignment(node(a).converted ^ a.sign(), value);
+}
+
+bool aig_prop_solvert::is_in_conflict(literalt l) const
+{
+  PRECONDITION(!l.is_constant() && node(l).is_converted());
+  return solver->is_in_conflict(node(l).converted ^ l.sign());
+}
+
+propt::resultt aig_prop_solvert::do_prop_solve()
+{
+  log.statistics() << nodes.size() << " AIG nodes, " << converted_nodes
+                   << " converted" << messaget::eom;
+
+  return solver->prop_solve();
+}
@@ -0,0 +1,218 @@
+/*******************************************************************\
+
+Module: And-Inverter Graph in Front of a Propositional Solver
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// And-Inverter Graph in Front of a Propositional Solver
+
+#ifndef CPROVER_SOLVERS_PROP_AIG_PROP_H
+#define CPROVER_SOLVERS_PROP_AIG_PROP_H
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "prop.h"
+
+/// Builds the formula as an and-inverter graph (AIG) and passes it to another
+/// solver only when it is constrained, by \ref lcnf, \ref l_set_to or when
+/// literals are frozen or used as assumptions.
+///
+/// All gates are expressed as conjunctions of two possibly negated literals.
+/// The gates are hashed structurally, such that each conjunction exists
+/// once, and simplified by local rewriting rules that look at the children
+/// of both operands. Gates that are never constrained are never converted.
+/// Conversion recovers multi-input conjunctions, exclusive-or and
+/// if-then-else gates from the graph, and uses the gates of the other solver
+/// to encode them.
+///
+/// The literals returned by this class refer to nodes of the graph; they are
+/// meaningless to the other solver. Asking for the value of a literal after
+/// solving evaluates the graph if its node has not been converted.
+class aig_prop_solvert : public propt
+{
+public:
+  aig_prop_solvert(
+    std::unique_ptr<propt> solver,
+    message_handlert &message_handler);
+
+  literalt land(literalt a, literalt b) override;
+  literalt lor(literalt a, literalt b) override;
+  literalt land(const bvt &bv) override;
+  literalt lor(const bvt &bv) override;
+  literalt lxor(literalt a, literalt b) override;
+  literalt lxor(const bvt &bv) override;
+  literalt lnand(literalt a, literalt b) override;
+  literalt lnor(literalt a, literalt b) override;
+  literalt lequal(literalt a, literalt b) override;
+  literalt limplies(literalt a, literalt b) override;
+  literalt lselect(literalt a, literalt b, literalt c) override; // a?b:c
+
+  void l_set_to(literalt a, bool value) override;
+  void lcnf(const bvt &bv) override;
+  using propt::lcnf;
+
+  bool cnf_handled_well() const override
+  {
+    return false;
+  }
+
+  void set_assumptions(const bvt &) override;
+  bool has_set_assumptions() const override
+  {
+    return solver->has_set_assumptions();
+  }
+
+  literalt new_variable() override;
+  void set_variable_name(literalt, const irep_idt &) override;
+  size_t no_variables() const override
+  {
+    return nodes.size();
+  }
+
+  const std::string solver_text() override;
+
+  tvt l_get(literalt a) const override;
+  void set_assignment(literalt a, bool value) override;
+
+  bool is_in_conflict(literalt l) const override;
+  bool has_is_in_conflict() const override
+  {
+    return solver->has_is_in_conflict();
+  }
+
+  void set_frozen(literalt) override;
+
+  void set_time_limit_seconds(uint32_t lim) override
+  {
+    solver->set_time_limit_seconds(lim);
+  }
+
+  void set_memory_limit_bytes(std::size_t bytes) override
+  {
+    solver->set_memory_limit_bytes(bytes);
+  }
+
+  /// Number of conjunctions in the graph
+  std::size_t number_of_and_nodes() const
+  {
+    return and_nodes.size();
+  }
+
+  /// Number of nodes that have been passed to the other solver
+  std::size_t number_of_converted_nodes() const
+  {
+    return converted_nodes;
+  }
+
+protected:
+  resultt do_prop_solve() override;
+
+  /// A node is either a variable, which has no children, or the conjunction
+  /// of its two children
+  struct nodet
+  {
+    literalt a, b;
+    /// Number of conjunctions that have this node as child
+    std::size_t fanout = 0;
+    /// Literal of the other solver that represents the node, if converted
+    literalt converted;
+
+    bool is_and() const
+    {
+      return a.var_no() != literalt::unused_var_no();
+    }
+
+    bool is_converted() const
+    {
+      return converted.var_no() != literalt::unused_var_no();
+    }
+  };
+
+  std::unique_ptr<propt> solver;
+  std::vector<nodet> nodes;
+
+  struct literal_pair_hasht
+  {
+    std::size_t operator()(const std::pair<literalt, literalt> &p) const
+    {
+      return std::hash<literalt::var_not>{}(p.first.get()) * 31 +
+             p.second.get();
+    }
+  };
+
+  /// Structural hashing of the conjunctions by their (ordered) children
+  std::unordered_map<
+    std::pair<literalt, literalt>,
+    literalt::var_not,
+    literal_pair_hasht>
+    and_nodes;
+
+  std::size_t converted_nodes = 0;
+
+  const nodet &node(literalt l) const
+  {
+    return nodes[l.var_no()];
+  }
+
+  /// \return True if \p l is a conjunction that is not negated
+  bool is_positive_and(literalt l) const
+  {
+    return !l.is_constant() && !l.sign() && node(l).is_and();
+  }
+
+  /// \return True if \p l is a negated conjunction
+  bool is_negative_and(literalt l) const
+  {
+    return !l.is_constant() && l.sign() && node(l).is_and();
+  }
+
+  /// \return True if \p l is a conjunction that has not been converted and
+  ///   that is the child of a single conjunction
+  bool is_unshared(literalt l) const
+  {
+    return node(l).fanout == 1 && !node(l).is_converted();
+  }
+
+  /// Try to simplify the conjunction of \p a and \p b, which are not
+  /// constant, by looking at the children of either of them.
+  /// \return True if the result has been stored in \p result
+  bool rewrite_and(literalt a, literalt b, literalt &result);
+
+  literalt new_and_node(literalt a, literalt b);
+
+  /// Collect the leaves of the tree of conjunctions rooted in the positive
+  /// literal \p l into \p dest. If \p only_unshared is set, nodes that are
+  /// shared or converted already are not expanded.
+  void and_leaves(literalt l, bool only_unshared, bvt &dest) const;
+
+  /// \return The literal of the other solver that is equivalent to \p l,
+  ///   converting the nodes it depends on as needed
+  literalt convert(literalt l);
+
+  /// Convert \p n, whose inputs have all been converted already
+  void convert_node(literalt::var_not n);
+
+  /// Gates of the other solver that nodes are converted to
+  enum class gatet
+  {
+    AND,
+    XOR,
+    SELECT
+  };
+
+  /// Determine the gate that encodes \p n, and the literals that need to be
+  /// converted before \p n
+  /// \param n: node to convert
+  /// \param [out] inputs: the inputs of the gate
+  /// \return The kind of gate
+  gatet decompose(literalt::var_not n, bvt &inputs) const;
+};
+
+#endif // CPROVER_SOLVERS_PROP_AIG_PROP_H
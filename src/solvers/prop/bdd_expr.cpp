@@ -11,6 +11,9 @@ Author: Michael Tautschnig, michael.tautschnig@qmul.ac.uk
 
 #include "bdd_expr.h"
 
+#include <unordered_set>
+#include <vector>
+
 #include <util/expr_util.h>
 #include <util/format_expr.h>
 #include <util/invariant.h>
@@ -176,3 +179,23 @@ exprt bdd_exprt::as_expr(const bddt &root) const
   bdd_nodet node = bdd_mgr.bdd_node(root);
   return as_expr(node, cache);
 }
+
+std::size_t bdd_exprt::node_count(const bddt &root, std::size_t limit) const
+{
+  std::unordered_set<bdd_nodet::idt> seen;
+  std::vector<bdd_nodet> stack{bdd_mgr.bdd_node(root)};
+
+  while(!stack.empty() && seen.size() <= limit)
+  {
+    const bdd_nodet node = stack.back();
+    stack.pop_back();
+
+    if(node.is_constant() || !seen.insert(node.id()).second)
+      continue;
+
+    stack.push_back(node.then_branch());
+    stack.push_back(node.else_branch());
+  }
+
+  return seen.size();
+}
@@ -36,6 +36,11 @@ public:
   bddt from_expr(const exprt &expr);
   exprt as_expr(const bddt &root) const;
 
+  /// Count the nodes of \p root that are not constant, stopping as soon as
+  /// more than \p limit have been found
+  /// \return number of nodes, or `limit + 1` if there are more than \p limit
+  std::size_t node_count(const bddt &root, std::size_t limit) const;
+
 protected:
   bdd_managert bdd_mgr;
 
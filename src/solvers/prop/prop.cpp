@@ -8,6 +8,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "prop.h"
 
+#include <chrono>
+
 /// asserts a==b in the propositional formula
 void propt::set_equal(literalt a, literalt b)
 {
@@ -29,7 +31,16 @@ bvt propt::new_variables(std::size_t width)
 propt::resultt propt::prop_solve()
 {
   ++number_of_solver_calls;
-  return do_prop_solve();
+
+  const auto solver_start = std::chrono::steady_clock::now();
+  const resultt result = do_prop_solve();
+  const std::chrono::duration<double> solver_time =
+    std::chrono::steady_clock::now() - solver_start;
+
+  log.statistics() << "Runtime of SAT solver call " << number_of_solver_calls
+                   << ": " << solver_time.count() << "s" << messaget::eom;
+
+  return result;
 }
 
 std::size_t propt::get_number_of_solver_calls() const
@@ -13,6 +13,8 @@ Author: Daniel Kroening, kroening@kroening.com
 // decision procedure wrapper for boolean propositional logics
 
 #include <cstdint>
+#include <utility>
+#include <vector>
 
 #include <util/message.h>
 #include <util/threeval.h>
@@ -119,8 +121,28 @@ public:
     log.warning() << "CPU limit ignored (not implemented)" << messaget::eom;
   }
 
+  virtual void set_memory_limit_bytes(std::size_t)
+  {
+    log.warning() << "memory limit ignored (not implemented)"
+                  << messaget::eom;
+  }
+
   std::size_t get_number_of_solver_calls() const;
 
+  /// A variable and its activity, the score by which the solver picks the
+  /// variables to decide on, which grows with their use in conflicts
+  typedef std::pair<literalt::var_not, double> variable_activityt;
+
+  /// Return up to \p n variables with the highest activity, most active
+  /// first, or nothing if the solver does not keep activities. After
+  /// solving, these are the variables that the search struggled with.
+  virtual std::vector<variable_activityt>
+  most_active_variables(std::size_t n) const
+  {
+    (void)n; // unused parameter
+    return {};
+  }
+
 protected:
   virtual resultt do_prop_solve() = 0;
 
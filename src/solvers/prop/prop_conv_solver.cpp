@@ -8,6 +8,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "prop_conv_solver.h"
 
+#include <util/expr_util.h>
+#include <util/profiler.h>
 #include <util/range.h>
 
 #include <algorithm>
@@ -181,6 +183,17 @@ literalt prop_conv_solvert::convert(const exprt &expr)
   if(!result.second)
     return result.first->second;
 
+  // a = b has the same encoding as b = a
+  if(const auto commuted = commute_operands(expr))
+  {
+    const auto commuted_entry = cache.find(*commuted);
+    if(commuted_entry != cache.end())
+    {
+      result.first->second = commuted_entry->second;
+      return commuted_entry->second;
+    }
+  }
+
   literalt literal = convert_bool(expr);
 
   // insert into cache
@@ -200,6 +213,8 @@ literalt prop_conv_solvert::convert_bool(const exprt &expr)
 {
   PRECONDITION(expr.type().id() == ID_bool);
 
+  profile_scopet profile_scope("flatten", expr.id(), false);
+
   const exprt::operandst &op = expr.operands();
 
   if(expr.is_constant())
@@ -492,6 +507,8 @@ decision_proceduret::resultt prop_conv_solvert::dec_solve()
 
   log.statistics() << "Solving with " << prop.solver_text() << messaget::eom;
 
+  profile_scopet profile_scope("solve", prop.solver_text());
+
   switch(prop.prop_solve())
   {
   case propt::resultt::P_SATISFIABLE:
@@ -540,6 +557,21 @@ std::size_t prop_conv_solvert::get_number_of_solver_calls() const
   return prop.get_number_of_solver_calls();
 }
 
+void prop_conv_solvert::identify_variables(
+  const std::unordered_set<literalt::var_not> &variables,
+  std::unordered_map<literalt::var_not, irep_idt> &identifiers) const
+{
+  for(const auto &symbol : symbols)
+  {
+    if(
+      !symbol.second.is_constant() &&
+      variables.find(symbol.second.var_no()) != variables.end())
+    {
+      identifiers.emplace(symbol.second.var_no(), symbol.first);
+    }
+  }
+}
+
 const char *prop_conv_solvert::context_prefix = "prop_conv::context$";
 
 void prop_conv_solvert::set_to(const exprt &expr, bool value)
@@ -562,7 +594,13 @@ void prop_conv_solvert::push(const std::vector<exprt> &assumptions)
   // We push the given assumptions as a single context onto the stack.
   assumption_stack.reserve(assumption_stack.size() + assumptions.size());
   for(const auto &assumption : assumptions)
-    assumption_stack.push_back(to_literal_expr(assumption).get_literal());
+  {
+    const literalt literal = to_literal_expr(assumption).get_literal();
+    // assumptions are used across solver calls, hence must not be eliminated
+    if(!literal.is_constant())
+      prop.set_frozen(literal);
+    assumption_stack.push_back(literal);
+  }
   context_size_stack.push_back(assumptions.size());
 
   prop.set_assumptions(assumption_stack);
@@ -573,6 +611,7 @@ void prop_conv_solvert::push()
   // We create a new context literal.
   literalt context_literal = convert(symbol_exprt(
     context_prefix + std::to_string(context_literal_counter++), bool_typet()));
+  set_frozen(context_literal);
 
   assumption_stack.push_back(context_literal);
   context_size_stack.push_back(1);
@@ -11,6 +11,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <util/expr.h>
 #include <util/message.h>
@@ -75,7 +77,7 @@ public:
   bool equality_propagation = true;
   bool freeze_all = false; // freezing variables (for incremental solving)
 
-  virtual void clear_cache()
+  void clear_cache() override
   {
     cache.clear();
   }
@@ -97,8 +99,20 @@ public:
     prop.set_time_limit_seconds(lim);
   }
 
+  void set_memory_limit_bytes(std::size_t bytes) override
+  {
+    prop.set_memory_limit_bytes(bytes);
+  }
+
   std::size_t get_number_of_solver_calls() const override;
 
+  /// Add the identifier of each symbol that is encoded by, or has a bit
+  /// encoded by, one of \p variables to \p identifiers, keyed by the
+  /// variable. The other variables encode intermediate results.
+  virtual void identify_variables(
+    const std::unordered_set<literalt::var_not> &variables,
+    std::unordered_map<literalt::var_not, irep_idt> &identifiers) const;
+
 protected:
   virtual void post_process();
 
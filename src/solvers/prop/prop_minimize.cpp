@@ -11,8 +11,12 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "prop_minimize.h"
 
+#include <algorithm>
+
 #include <util/threeval.h>
 
+#include <solvers/conflict_provider.h>
+
 #include "literal_expr.h"
 
 prop_minimizet::prop_minimizet(
@@ -51,7 +55,11 @@ void prop_minimizet::fix_objectives()
     {
       _number_satisfied++;
       _value += current->first;
-      prop_conv.set_to(literal_exprt(o_it->condition), false); // fix it
+      // fix it
+      if(incremental)
+        fixed_assumptions.push_back(literal_exprt(!o_it->condition));
+      else
+        prop_conv.set_to(literal_exprt(o_it->condition), false);
       o_it->fixed = true;
       found = true;
     }
@@ -92,22 +100,129 @@ literalt prop_minimizet::constraint()
   }
 }
 
+/// Solve with the requirement to achieve \p improvement
+decision_proceduret::resultt prop_minimizet::solve(literalt improvement)
+{
+  if(!incremental)
+  {
+    prop_conv.push({literal_exprt{improvement}});
+    return prop_conv();
+  }
+
+  std::vector<exprt> assumptions = fixed_assumptions;
+  assumptions.push_back(literal_exprt{improvement});
+
+  prop_conv.push(assumptions);
+  const decision_proceduret::resultt dec_result = prop_conv();
+  prop_conv.pop();
+
+  return dec_result;
+}
+
+/// Check whether the deadline has passed, and record if it has
+bool prop_minimizet::deadline_passed()
+{
+  if(deadline.has_value() && std::chrono::steady_clock::now() >= *deadline)
+    _timed_out = true;
+
+  return _timed_out;
+}
+
+/// Assume all unfixed objectives of the current weight, dropping one
+/// objective of the conflict for as long as that is unsatisfiable, and fix
+/// the objectives once it is satisfiable.
+/// \param [out] last_was_SAT: whether the last solver call was satisfiable
+/// \return false if the decision procedure failed
+bool prop_minimizet::satisfy_all_but_cores(bool &last_was_SAT)
+{
+  const auto conflict_provider =
+    dynamic_cast<const conflict_providert *>(&prop_conv);
+  if(conflict_provider == nullptr)
+    return true;
+
+  std::vector<literalt> candidates;
+  for(const auto &objective : current->second)
+  {
+    if(!objective.fixed)
+      candidates.push_back(!objective.condition);
+  }
+
+  while(!candidates.empty() && !deadline_passed())
+  {
+    std::vector<exprt> assumptions = fixed_assumptions;
+    for(const auto &candidate : candidates)
+      assumptions.push_back(literal_exprt(candidate));
+
+    _iterations++;
+
+    prop_conv.push(assumptions);
+    const decision_proceduret::resultt dec_result = prop_conv();
+
+    switch(dec_result)
+    {
+    case decision_proceduret::resultt::D_SATISFIABLE:
+      last_was_SAT = true;
+      fix_objectives();
+      prop_conv.pop();
+      return true;
+
+    case decision_proceduret::resultt::D_UNSATISFIABLE:
+    {
+      last_was_SAT = false;
+
+      const auto in_conflict = std::find_if(
+        candidates.begin(), candidates.end(), [&](const literalt &candidate) {
+          return conflict_provider->is_in_conflict(literal_exprt(candidate));
+        });
+
+      prop_conv.pop();
+
+      // without a conflict among the objectives we leave it to the greedy
+      // search
+      if(in_conflict == candidates.end())
+        return true;
+
+      candidates.erase(in_conflict);
+      break;
+    }
+
+    case decision_proceduret::resultt::D_ERROR:
+      prop_conv.pop();
+      log.error() << "decision procedure failed" << messaget::eom;
+      last_was_SAT = false;
+      return false;
+    }
+  }
+
+  return true;
+}
+
 /// Try to cover all objectives
 void prop_minimizet::operator()()
 {
   _iterations = 0;
   _number_satisfied = 0;
   _value = 0;
+  _timed_out = false;
+  fixed_assumptions.clear();
   bool last_was_SAT = false;
 
   // go from high weights to low ones
-  for(current = objectives.rbegin(); current != objectives.rend(); current++)
+  for(current = objectives.rbegin();
+      current != objectives.rend() && !_timed_out;
+      current++)
   {
     log.status() << "weight " << current->first << messaget::eom;
 
+    if(core_guided && !satisfy_all_but_cores(last_was_SAT))
+      return;
+
     decision_proceduret::resultt dec_result;
     do
     {
+      if(deadline_passed())
+        break;
+
       // We want to improve on one of the objectives, please!
       literalt c = constraint();
 
@@ -117,8 +232,7 @@ void prop_minimizet::operator()()
       {
         _iterations++;
 
-        prop_conv.push({literal_exprt{c}});
-        dec_result = prop_conv();
+        dec_result = solve(c);
 
         switch(dec_result)
         {
@@ -140,7 +254,15 @@ void prop_minimizet::operator()()
     } while(dec_result != decision_proceduret::resultt::D_UNSATISFIABLE);
   }
 
-  if(!last_was_SAT)
+  if(incremental)
+  {
+    // keep what we got for the caller, and get a model that satisfies it
+    prop_conv.push(fixed_assumptions);
+
+    if(!last_was_SAT)
+      (void)prop_conv();
+  }
+  else if(!last_was_SAT)
   {
     // We don't have a satisfying assignment to work with.
     // Run solver again to get one.
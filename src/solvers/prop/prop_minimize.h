@@ -12,9 +12,11 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_SOLVERS_PROP_PROP_MINIMIZE_H
 #define CPROVER_SOLVERS_PROP_PROP_MINIMIZE_H
 
+#include <chrono>
 #include <map>
 
 #include <util/message.h>
+#include <util/optional.h>
 
 #include "literal.h"
 #include "prop_conv.h"
@@ -45,6 +47,41 @@ public:
     return _number_objectives;
   }
 
+  /// Whether the last run stopped because the deadline had passed
+  bool timed_out() const
+  {
+    return _timed_out;
+  }
+
+  // configuration
+
+  /// Keep the satisfied objectives as assumptions instead of adding them as
+  /// clauses, which leaves the formula unchanged. The run then ends with one
+  /// context holding these assumptions pushed onto \p prop_conv, which the
+  /// caller pops once the model is no longer needed.
+  void set_incremental(bool value)
+  {
+    incremental = value;
+  }
+
+  /// Start each weight by assuming all of its objectives at once and, while
+  /// that is unsatisfiable, dropping one objective of the conflict reported
+  /// by the solver, before improving greedily on the remaining objectives.
+  /// This replaces one solver call per improvement by one per conflict, and
+  /// requires a solver that reports conflicts, see \ref conflict_providert;
+  /// otherwise only the greedy search is done.
+  void set_core_guided(bool value)
+  {
+    core_guided = value;
+  }
+
+  /// Stop improving on the objectives once \p value has passed; the model
+  /// is then the best one found so far
+  void set_deadline(std::chrono::steady_clock::time_point value)
+  {
+    deadline = value;
+  }
+
   // managing the objectives
 
   typedef long long signed int weightt;
@@ -72,11 +109,21 @@ protected:
   std::size_t _number_satisfied = 0;
   std::size_t _number_objectives = 0;
   weightt _value = 0;
+  bool _timed_out = false;
+  bool incremental = false;
+  bool core_guided = false;
+  optionalt<std::chrono::steady_clock::time_point> deadline;
   prop_convt &prop_conv;
   messaget log;
 
+  /// Assumptions that keep the satisfied objectives in incremental mode
+  std::vector<exprt> fixed_assumptions;
+
   literalt constraint();
   void fix_objectives();
+  decision_proceduret::resultt solve(literalt improvement);
+  bool deadline_passed();
+  bool satisfy_all_but_cores(bool &last_was_SAT);
 
   objectivest::reverse_iterator current;
 };
@@ -12,12 +12,18 @@ Author: Peter Schrammel
 #ifndef CPROVER_SOLVERS_PROP_SOLVER_RESOURCE_LIMITS_H
 #define CPROVER_SOLVERS_PROP_SOLVER_RESOURCE_LIMITS_H
 
+#include <cstddef>
+
 class solver_resource_limitst
 {
 public:
   /// Set the limit for the solver to time out in seconds
   virtual void set_time_limit_seconds(uint32_t) = 0;
 
+  /// Set the number of bytes that the process may have allocated before the
+  /// solver gives up, see \ref allocated_memory
+  virtual void set_memory_limit_bytes(std::size_t) = 0;
+
   virtual ~solver_resource_limitst() = default;
 };
 
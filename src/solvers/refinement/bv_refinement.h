@@ -18,6 +18,18 @@ Author: Daniel Kroening, kroening@kroening.com
 
 class bv_refinementt:public bv_pointerst
 {
+public:
+  /// The order in which the approximations that a refinement iteration
+  /// found to be inadequate are refined
+  enum class schedulet
+  {
+    /// in the order the approximated operations were encoded
+    IN_ORDER,
+    /// by increasing size of their full encoding, so that a cheap
+    /// refinement gets the chance to make an expensive one unnecessary
+    CHEAPEST_FIRST
+  };
+
 private:
   struct configt
   {
@@ -28,6 +40,10 @@ private:
     bool refine_arrays=true;
     /// Enable arithmetic refinement
     bool refine_arithmetic=true;
+    /// Order of the arithmetic refinements of an iteration
+    schedulet schedule = schedulet::IN_ORDER;
+    /// Max number of arithmetic refinements per iteration, or 0 for no limit
+    std::size_t max_refinements_per_iteration = 0;
   };
 public:
   struct infot:public configt
@@ -84,6 +100,9 @@ private:
 
     std::string as_string() const;
 
+    /// Rough estimate of the size of the full encoding of the operation
+    std::size_t cost() const;
+
     void add_over_assumption(literalt l);
     void add_under_assumption(literalt l);
 
@@ -93,8 +112,9 @@ private:
   resultt prop_solve();
   approximationt &add_approximation(const exprt &expr, bvt &bv);
   bool conflicts_with(approximationt &approximation);
-  void check_SAT(approximationt &approximation);
-  void check_UNSAT(approximationt &approximation);
+  bool check_SAT(approximationt &approximation);
+  bool check_UNSAT(approximationt &approximation);
+  std::vector<approximationt *> schedule();
   void initialize(approximationt &approximation);
   void get_values(approximationt &approximation);
   void check_SAT();
@@ -107,6 +127,15 @@ private:
   bool progress;
   std::list<approximationt> approximations;
 
+  struct statisticst
+  {
+    std::size_t iterations = 0;
+    std::size_t arithmetic_refinements = 0;
+    std::size_t array_refinements = 0;
+  };
+  /// Accumulated over all calls to `dec_solve`
+  statisticst statistics;
+
 protected:
   // use gui format
   configt config_;
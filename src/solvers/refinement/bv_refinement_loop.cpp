@@ -10,6 +10,9 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <util/xml.h>
 
+#include <algorithm>
+#include <chrono>
+
 bv_refinementt::bv_refinementt(const infot &info)
   : bv_pointerst(*info.ns, *info.prop, *info.message_handler),
     progress(false),
@@ -30,11 +33,25 @@ decision_proceduret::resultt bv_refinementt::dec_solve()
   log.debug() << "Solving with " << prop.solver_text() << messaget::eom;
 
   unsigned iteration=0;
+  const statisticst statistics_before = statistics;
+  const auto finish = [&](resultt result) {
+    log.status() << "Total iterations: " << iteration << messaget::eom;
+    log.statistics() << "BV-Refinement: "
+                     << statistics.arithmetic_refinements -
+                          statistics_before.arithmetic_refinements
+                     << " arithmetic and "
+                     << statistics.array_refinements -
+                          statistics_before.array_refinements
+                     << " array refinements" << messaget::eom;
+    return result;
+  };
 
   // now enter the loop
   while(true)
   {
     iteration++;
+    statistics.iterations++;
+    const statisticst statistics_iteration = statistics;
 
     log.status() << "BV-Refinement: iteration " << iteration << messaget::eom;
 
@@ -46,7 +63,12 @@ decision_proceduret::resultt bv_refinementt::dec_solve()
       log.status() << xml << '\n';
     }
 
-    switch(prop_solve())
+    const auto solve_start = std::chrono::steady_clock::now();
+    const resultt result = prop_solve();
+    const std::chrono::duration<double> solve_time =
+      std::chrono::steady_clock::now() - solve_start;
+
+    switch(result)
     {
     case resultt::D_SATISFIABLE:
       check_SAT();
@@ -54,8 +76,7 @@ decision_proceduret::resultt bv_refinementt::dec_solve()
       {
         log.status() << "BV-Refinement: got SAT, and it simulates => SAT"
                      << messaget::eom;
-        log.status() << "Total iterations: " << iteration << messaget::eom;
-        return resultt::D_SATISFIABLE;
+        return finish(resultt::D_SATISFIABLE);
       }
       else
         log.status() << "BV-Refinement: got SAT, and it is spurious, refining"
@@ -69,8 +90,7 @@ decision_proceduret::resultt bv_refinementt::dec_solve()
         log.status()
           << "BV-Refinement: got UNSAT, and the proof passes => UNSAT"
           << messaget::eom;
-        log.status() << "Total iterations: " << iteration << messaget::eom;
-        return resultt::D_UNSATISFIABLE;
+        return finish(resultt::D_UNSATISFIABLE);
       }
       else
         log.status()
@@ -81,6 +101,15 @@ decision_proceduret::resultt bv_refinementt::dec_solve()
     case resultt::D_ERROR:
       return resultt::D_ERROR;
     }
+
+    log.statistics() << "BV-Refinement: iteration " << iteration << ": "
+                     << statistics.arithmetic_refinements -
+                          statistics_iteration.arithmetic_refinements
+                     << " arithmetic and "
+                     << statistics.array_refinements -
+                          statistics_iteration.array_refinements
+                     << " array refinements, " << solve_time.count()
+                     << "s in the SAT solver" << messaget::eom;
   }
 }
 
@@ -117,20 +146,70 @@ decision_proceduret::resultt bv_refinementt::prop_solve()
   UNREACHABLE;
 }
 
+/// The approximations in the order the configured schedule refines them
+std::vector<bv_refinementt::approximationt *> bv_refinementt::schedule()
+{
+  std::vector<approximationt *> result;
+  result.reserve(approximations.size());
+
+  for(approximationt &approximation : approximations)
+    result.push_back(&approximation);
+
+  if(config_.schedule == schedulet::CHEAPEST_FIRST)
+  {
+    std::stable_sort(
+      result.begin(),
+      result.end(),
+      [](const approximationt *a, const approximationt *b) {
+        return a->cost() < b->cost();
+      });
+  }
+
+  return result;
+}
+
 void bv_refinementt::check_SAT()
 {
   progress=false;
 
   arrays_overapproximated();
 
-  for(approximationt &approximation : this->approximations)
-    check_SAT(approximation);
+  std::size_t refinements = 0;
+
+  for(approximationt *approximation : schedule())
+  {
+    if(
+      config_.max_refinements_per_iteration != 0 &&
+      refinements == config_.max_refinements_per_iteration)
+    {
+      break;
+    }
+
+    if(check_SAT(*approximation))
+      refinements++;
+  }
+
+  statistics.arithmetic_refinements += refinements;
 }
 
 void bv_refinementt::check_UNSAT()
 {
   progress=false;
 
-  for(approximationt &approximation : this->approximations)
-    check_UNSAT(approximation);
+  std::size_t refinements = 0;
+
+  for(approximationt *approximation : schedule())
+  {
+    if(
+      config_.max_refinements_per_iteration != 0 &&
+      refinements == config_.max_refinements_per_iteration)
+    {
+      break;
+    }
+
+    if(check_UNSAT(*approximation))
+      refinements++;
+  }
+
+  statistics.arithmetic_refinements += refinements;
 }
@@ -42,7 +42,58 @@ bvt bv_refinementt::convert_floatbv_op(const exprt &expr)
     return SUB::convert_floatbv_op(expr);
 
   bvt bv;
-  add_approximation(expr, bv);
+  approximationt &a = add_approximation(expr, bv);
+
+  // initially, we have a partial interpretation of the cases that do not
+  // depend on rounding
+  float_utilst float_utils(prop, to_floatbv_type(expr.type()));
+
+  // NaN operands yield NaN
+  const literalt op0_nan = float_utils.is_NaN(a.op0_bv);
+  const literalt op1_nan = float_utils.is_NaN(a.op1_bv);
+  const literalt res_nan = float_utils.is_NaN(a.result_bv);
+  prop.l_set_to_true(prop.limplies(prop.lor(op0_nan, op1_nan), res_nan));
+
+  if(expr.id() == ID_floatbv_mult || expr.id() == ID_floatbv_div)
+  {
+    // the sign of products and quotients is that of the operands
+    prop.l_set_to_true(prop.limplies(
+      !res_nan,
+      prop.lequal(
+        float_utils.sign_bit(a.result_bv),
+        prop.lxor(
+          float_utils.sign_bit(a.op0_bv), float_utils.sign_bit(a.op1_bv)))));
+
+    // x*1==x, 1*x==x and x/1==x
+    ieee_floatt one(float_utils.spec);
+    one.from_integer(1);
+    const bvt one_bv = float_utils.build_constant(one);
+    const literalt res_op0 = bv_utils.equal(a.op0_bv, a.result_bv);
+    prop.l_set_to_true(prop.limplies(
+      prop.land(bv_utils.equal(a.op1_bv, one_bv), !op0_nan), res_op0));
+    if(expr.id() == ID_floatbv_mult)
+    {
+      const literalt res_op1 = bv_utils.equal(a.op1_bv, a.result_bv);
+      prop.l_set_to_true(prop.limplies(
+        prop.land(bv_utils.equal(a.op0_bv, one_bv), !op1_nan), res_op1));
+    }
+  }
+  else if(expr.id() == ID_floatbv_plus || expr.id() == ID_floatbv_minus)
+  {
+    // x+0==x and x-0==x unless x is zero, whose sign depends on rounding
+    const literalt op0_zero = float_utils.is_zero(a.op0_bv);
+    const literalt op1_zero = float_utils.is_zero(a.op1_bv);
+    const literalt res_op0 = bv_utils.equal(a.op0_bv, a.result_bv);
+    prop.l_set_to_true(prop.limplies(
+      prop.land({op1_zero, !op0_zero, !op0_nan}), res_op0));
+    if(expr.id() == ID_floatbv_plus)
+    {
+      const literalt res_op1 = bv_utils.equal(a.op1_bv, a.result_bv);
+      prop.l_set_to_true(prop.limplies(
+        prop.land({op0_zero, !op1_zero, !op1_nan}), res_op1));
+    }
+  }
+
   return bv;
 }
 
@@ -155,7 +206,8 @@ void bv_refinementt::get_values(approximationt &a)
 
 /// inspect if satisfying assignment extends to original formula, otherwise
 /// refine overapproximation
-void bv_refinementt::check_SAT(approximationt &a)
+/// \return true if the approximation was refined
+bool bv_refinementt::check_SAT(approximationt &a)
 {
   // get values
   get_values(a);
@@ -169,7 +221,7 @@ void bv_refinementt::check_SAT(approximationt &a)
     const auto &float_op = to_ieee_float_op_expr(a.expr);
 
     if(a.over_state==MAX_STATE)
-      return;
+      return false;
 
     ieee_float_spect spec(to_floatbv_type(type));
     ieee_floatt o0(spec), o1(spec);
@@ -202,7 +254,7 @@ void bv_refinementt::check_SAT(approximationt &a)
       UNREACHABLE;
 
     if(result.pack()==a.result_value) // ok
-      return;
+      return false;
 
 #ifdef DEBUG
     ieee_floatt rr(spec);
@@ -282,7 +334,7 @@ void bv_refinementt::check_SAT(approximationt &a)
 
     // already full interpretation?
     if(a.over_state>0)
-      return;
+      return false;
 
     bv_spect spec(type);
     bv_arithmetict o0(spec), o1(spec);
@@ -293,7 +345,7 @@ void bv_refinementt::check_SAT(approximationt &a)
 
     if((a.expr.id()==ID_div || a.expr.id()==ID_mod) &&
        o1==0)
-      return;
+      return false;
 
     if(a.expr.id()==ID_mult)
       o0*=o1;
@@ -305,7 +357,7 @@ void bv_refinementt::check_SAT(approximationt &a)
       UNREACHABLE;
 
     if(o0.pack()==a.result_value) // ok
-      return;
+      return false;
 
     if(a.over_state==0)
     {
@@ -359,15 +411,18 @@ void bv_refinementt::check_SAT(approximationt &a)
   progress=true;
   if(a.over_state<MAX_STATE)
     a.over_state++;
+
+  return true;
 }
 
 /// inspect if proof holds on original formula, otherwise refine
 /// underapproximation
-void bv_refinementt::check_UNSAT(approximationt &a)
+/// \return true if the approximation was refined
+bool bv_refinementt::check_UNSAT(approximationt &a)
 {
   // part of the conflict?
   if(!this->conflicts_with(a))
-    return;
+    return false;
 
   log.status() << "Found assumption for '" << a.as_string()
                << "' in proof (state " << a.under_state << ")" << messaget::eom;
@@ -412,16 +467,13 @@ void bv_refinementt::check_UNSAT(approximationt &a)
       }
       else
       {
-        // set x bits of both exponent and mantissa free
-        // need to start with most-significant bits
-
-        #if 0
+        // set the x most-significant bits of the fractions free, which
+        // solves with operands of reduced precision
         for(std::size_t i=x; i<fraction0.size(); i++)
           a.add_under_assumption(!fraction0[fraction0.size()-i-1]);
 
         for(std::size_t i=x; i<fraction1.size(); i++)
           a.add_under_assumption(!fraction1[fraction1.size()-i-1]);
-        #endif
       }
     }
   }
@@ -448,6 +500,8 @@ void bv_refinementt::check_UNSAT(approximationt &a)
 
   a.under_state++;
   progress=true;
+
+  return true;
 }
 
 /// check if an under-approximation is part of the conflict
@@ -530,3 +584,11 @@ std::string bv_refinementt::approximationt::as_string() const
 {
   return std::to_string(id_nr)+"/"+id2string(expr.id());
 }
+
+std::size_t bv_refinementt::approximationt::cost() const
+{
+  // multipliers and dividers are quadratic in the width, and floating-point
+  // operations add unpacking, alignment and rounding
+  const std::size_t width = result_bv.size();
+  return expr.type().id() == ID_floatbv ? 4 * width * width : width * width;
+}
@@ -12,8 +12,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <iostream>
 #endif
 
-#include <util/std_expr.h>
 #include <util/find_symbols.h>
+#include <util/simplify_expr.h>
+#include <util/std_expr.h>
 
 #include <solvers/sat/satcheck.h>
 
@@ -43,10 +44,6 @@ void bv_refinementt::arrays_overapproximated()
   std::list<lazy_constraintt>::iterator it=lazy_array_constraints.begin();
   while(it!=lazy_array_constraints.end())
   {
-    satcheck_no_simplifiert sat_check{log.get_message_handler()};
-    bv_pointerst solver{ns, sat_check, log.get_message_handler()};
-    solver.unbounded_array=bv_pointerst::unbounded_arrayt::U_ALL;
-
     exprt current=(*it).lazy;
 
     // some minor simplifications
@@ -54,7 +51,7 @@ void bv_refinementt::arrays_overapproximated()
     if(current.id()==ID_implies)
     {
       implies_exprt imp=to_implies_expr(current);
-      exprt implies_simplified=get(imp.op0());
+      exprt implies_simplified=simplify_expr(get(imp.op0()), ns);
       if(implies_simplified==false_exprt())
       {
         ++it;
@@ -77,6 +74,26 @@ void bv_refinementt::arrays_overapproximated()
     }
 
     exprt simplified=get(current);
+
+    // Usually, the model fixes all values in the constraint, and we can tell
+    // whether it is violated without another solver.
+    simplify(simplified, ns);
+    if(simplified.is_true())
+    {
+      ++it;
+      continue;
+    }
+    else if(simplified.is_false())
+    {
+      prop.l_set_to_true(convert(current));
+      nb_active++;
+      lazy_array_constraints.erase(it++);
+      continue;
+    }
+
+    satcheck_no_simplifiert sat_check{log.get_message_handler()};
+    bv_pointerst solver{ns, sat_check, log.get_message_handler()};
+    solver.unbounded_array=bv_pointerst::unbounded_arrayt::U_ALL;
     solver << simplified;
 
     switch(static_cast<decision_proceduret::resultt>(sat_check.prop_solve()))
@@ -98,6 +115,7 @@ void bv_refinementt::arrays_overapproximated()
               << " array expressions become active" << messaget::eom;
   log.debug() << "BV-Refinement: " << lazy_array_constraints.size()
               << " inactive array expressions" << messaget::eom;
+  statistics.array_refinements += nb_active;
   if(nb_active > 0)
     progress=true;
 }
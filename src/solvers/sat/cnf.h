@@ -79,6 +79,20 @@ public:
     return clause_counter;
   }
 
+  /// Literals that hold in every model of the clauses, such as those of unit
+  /// clauses that the solver has learnt, as far as the solver tracks them
+  virtual bvt get_fixed_literals() const
+  {
+    return {};
+  }
+
+  /// \return true if the solver has removed the variable of the literal
+  ///   from the formula, such that it must not be used in new clauses
+  virtual bool is_eliminated(literalt) const
+  {
+    return false;
+  }
+
 protected:
   enum class statust { INIT, SAT, UNSAT, ERROR };
   statust status;
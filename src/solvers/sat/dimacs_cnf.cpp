@@ -102,3 +102,52 @@ void dimacs_cnf_dumpt::lcnf(const bvt &bv)
 {
   write_dimacs_clause(bv, out, true);
 }
+
+dimacs_cnf_streamt::dimacs_cnf_streamt(
+  std::ostream &_out,
+  message_handlert &message_handler)
+  : cnft(message_handler), out(_out), problem_line_position(_out.tellp())
+{
+  write_problem_line();
+}
+
+void dimacs_cnf_streamt::set_assignment(literalt, bool)
+{
+  UNIMPLEMENTED;
+}
+
+bool dimacs_cnf_streamt::is_in_conflict(literalt) const
+{
+  UNREACHABLE;
+  return false;
+}
+
+void dimacs_cnf_streamt::write_problem_line()
+{
+  // The counts are padded to the width of the largest 64-bit number, such
+  // that the final line has the same length as the one written first.
+  // We start counting at 1, thus there is one variable fewer.
+  const std::string variables = std::to_string(no_variables() - 1);
+  const std::string clauses = std::to_string(clause_count);
+  const std::size_t width = 20;
+
+  out << "p cnf " << variables << std::string(width - variables.size(), ' ')
+      << ' ' << clauses << std::string(width - clauses.size(), ' ') << '\n';
+}
+
+void dimacs_cnf_streamt::lcnf(const bvt &bv)
+{
+  if(process_clause(bv, clause))
+    return;
+
+  write_dimacs_clause(clause, out, false);
+  ++clause_count;
+}
+
+void dimacs_cnf_streamt::finish()
+{
+  const std::ostream::pos_type end = out.tellp();
+  out.seekp(problem_line_position);
+  write_problem_line();
+  out.seekp(end);
+}
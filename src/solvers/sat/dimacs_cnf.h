@@ -71,4 +71,57 @@ protected:
   std::ostream &out;
 };
 
+/// Writes clauses to a seekable stream as they are generated, such that the
+/// formula is never held in memory. The problem line is written first, with
+/// room for the largest counts, and is overwritten by \ref finish.
+class dimacs_cnf_streamt : public cnft
+{
+public:
+  dimacs_cnf_streamt(std::ostream &_out, message_handlert &message_handler);
+
+  const std::string solver_text() override
+  {
+    return "DIMACS CNF";
+  }
+
+  void lcnf(const bvt &bv) override;
+
+  tvt l_get(literalt) const override
+  {
+    return tvt::unknown();
+  }
+
+  void set_assignment(literalt a, bool value) override;
+  bool is_in_conflict(literalt l) const override;
+
+  size_t no_clauses() const override
+  {
+    return clause_count;
+  }
+
+  /// Write the final numbers of variables and clauses into the problem line,
+  /// and return to the end of the stream
+  void finish();
+
+  std::ostream &stream()
+  {
+    return out;
+  }
+
+protected:
+  resultt do_prop_solve() override
+  {
+    return resultt::P_ERROR;
+  }
+
+  void write_problem_line();
+
+  std::ostream &out;
+  std::ostream::pos_type problem_line_position;
+  std::size_t clause_count = 0;
+
+  /// Buffer for the clauses after simplification by \ref process_clause
+  bvt clause;
+};
+
 #endif // CPROVER_SOLVERS_SAT_DIMACS_CNF_H
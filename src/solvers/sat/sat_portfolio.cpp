@@ -0,0 +1,205 @@
+/*******************************************************************\
+
+Module: Portfolio of SAT Solvers
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Portfolio of SAT Solvers
+
+#include "sat_portfolio.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+#include <util/invariant.h>
+
+sat_portfoliot::sat_portfoliot(message_handlert &message_handler)
+  : cnf_solvert(message_handler)
+{
+}
+
+void sat_portfoliot::add_solver(std::unique_ptr<cnf_solvert> solver)
+{
+  PRECONDITION(solver);
+  PRECONDITION(solver->no_variables() == no_variables());
+  solvers.push_back(std::move(solver));
+  failed.push_back(false);
+}
+
+const std::string sat_portfoliot::solver_text()
+{
+  std::string result = "portfolio of";
+
+  for(std::size_t i = 0; i < solvers.size(); ++i)
+    result += (i == 0 ? " " : ", ") + solvers[i]->solver_text();
+
+  return result;
+}
+
+literalt sat_portfoliot::new_variable()
+{
+  const literalt l = cnf_solvert::new_variable();
+
+  for(auto &solver : solvers)
+  {
+    const literalt solver_l = solver->new_variable();
+    INVARIANT(solver_l == l, "solvers should agree on variable numbers");
+  }
+
+  return l;
+}
+
+void sat_portfoliot::lcnf(const bvt &bv)
+{
+  for(auto &solver : solvers)
+    solver->lcnf(bv);
+
+  clause_counter++;
+}
+
+tvt sat_portfoliot::l_get(literalt a) const
+{
+  PRECONDITION(!solvers.empty());
+  return solvers[winner]->l_get(a);
+}
+
+void sat_portfoliot::set_assignment(literalt a, bool value)
+{
+  for(auto &solver : solvers)
+    solver->set_assignment(a, value);
+}
+
+void sat_portfoliot::set_assumptions(const bvt &bv)
+{
+  for(auto &solver : solvers)
+    solver->set_assumptions(bv);
+}
+
+bool sat_portfoliot::has_set_assumptions() const
+{
+  return std::all_of(
+    solvers.begin(),
+    solvers.end(),
+    [](const std::unique_ptr<cnf_solvert> &solver) {
+      return solver->has_set_assumptions();
+    });
+}
+
+bool sat_portfoliot::is_in_conflict(literalt a) const
+{
+  PRECONDITION(!solvers.empty());
+  return solvers[winner]->is_in_conflict(a);
+}
+
+bool sat_portfoliot::has_is_in_conflict() const
+{
+  return std::all_of(
+    solvers.begin(),
+    solvers.end(),
+    [](const std::unique_ptr<cnf_solvert> &solver) {
+      return solver->has_is_in_conflict();
+    });
+}
+
+void sat_portfoliot::set_frozen(literalt a)
+{
+  for(auto &solver : solvers)
+    solver->set_frozen(a);
+}
+
+void sat_portfoliot::share_units(std::size_t from)
+{
+  shared_units.resize(no_variables(), false);
+  std::size_t count = 0;
+
+  for(const literalt l : solvers[from]->get_fixed_literals())
+  {
+    if(l.var_no() >= shared_units.size() || shared_units[l.var_no()])
+      continue;
+
+    shared_units[l.var_no()] = true;
+    ++count;
+
+    for(std::size_t i = 0; i < solvers.size(); ++i)
+    {
+      if(i != from && !failed[i] && !solvers[i]->is_eliminated(l))
+        solvers[i]->lcnf({l});
+    }
+  }
+
+  log.statistics() << "SAT portfolio: " << count << " unit clauses shared by "
+                   << solvers[from]->solver_text() << messaget::eom;
+}
+
+propt::resultt sat_portfoliot::do_prop_solve()
+{
+  PRECONDITION(!solvers.empty());
+
+  log.statistics() << (no_variables() - 1) << " variables, " << clause_counter
+                   << " clauses" << messaget::eom;
+
+  const auto start = std::chrono::steady_clock::now();
+
+  for(uint32_t slice = std::max<uint32_t>(time_slice_seconds, 1);;
+      slice = slice > UINT32_MAX / 2 ? UINT32_MAX : slice * 2)
+  {
+    bool tried_any = false;
+
+    for(std::size_t i = 0; i < solvers.size(); ++i)
+    {
+      if(failed[i])
+        continue;
+
+      uint32_t limit = slice;
+      if(time_limit_seconds != 0)
+      {
+        const auto elapsed =
+          std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now() - start)
+            .count();
+        if(elapsed >= time_limit_seconds)
+        {
+          log.status() << "SAT portfolio: time limit reached"
+                       << messaget::eom;
+          return resultt::P_ERROR;
+        }
+        limit = std::min<uint32_t>(limit, time_limit_seconds - elapsed);
+      }
+
+      tried_any = true;
+      solvers[i]->set_time_limit_seconds(limit);
+
+      const auto solver_start = std::chrono::steady_clock::now();
+      const resultt result = solvers[i]->prop_solve();
+
+      if(result != resultt::P_ERROR)
+      {
+        log.status() << "SAT portfolio: answer by "
+                     << solvers[i]->solver_text() << messaget::eom;
+        winner = i;
+        return result;
+      }
+
+      // a solver that stopped before its time was up has failed, rather than
+      // run out of time
+      if(std::chrono::steady_clock::now() - solver_start <
+         std::chrono::seconds(limit))
+      {
+        failed[i] = true;
+      }
+      else
+        share_units(i);
+    }
+
+    if(!tried_any)
+    {
+      log.error() << "SAT portfolio: all solvers failed" << messaget::eom;
+      status = statust::ERROR;
+      return resultt::P_ERROR;
+    }
+  }
+}
@@ -0,0 +1,93 @@
+/*******************************************************************\
+
+Module: Portfolio of SAT Solvers
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Portfolio of SAT Solvers
+
+#ifndef CPROVER_SOLVERS_SAT_SAT_PORTFOLIO_H
+#define CPROVER_SOLVERS_SAT_SAT_PORTFOLIO_H
+
+#include <memory>
+#include <vector>
+
+#include "cnf.h"
+
+/// Passes the same CNF to several SAT solvers and takes the answer of the
+/// first one that solves it. The solvers are run one after the other, each
+/// with a time limit, and the time limit is doubled after each round; a
+/// solver resumes where it was interrupted if it supports that. Solvers that
+/// fail, rather than running out of time, are not asked again.
+///
+/// All solvers start out with the same number of variables and are given
+/// the same clauses, such that they agree on the numbering of variables.
+/// This permits passing the unit clauses that one solver has learnt before
+/// running out of time on to the others.
+class sat_portfoliot : public cnf_solvert
+{
+public:
+  explicit sat_portfoliot(message_handlert &message_handler);
+
+  /// Add \p solver to the portfolio, which has to be done before any
+  /// variable is created
+  void add_solver(std::unique_ptr<cnf_solvert> solver);
+
+  /// Set the time limit of the solvers in the first round
+  void set_time_slice_seconds(uint32_t seconds)
+  {
+    time_slice_seconds = seconds;
+  }
+
+  const std::string solver_text() override;
+
+  literalt new_variable() override;
+  void lcnf(const bvt &bv) override;
+
+  tvt l_get(literalt a) const override;
+  void set_assignment(literalt a, bool value) override;
+
+  void set_assumptions(const bvt &bv) override;
+  bool has_set_assumptions() const override;
+  bool is_in_conflict(literalt a) const override;
+  bool has_is_in_conflict() const override;
+
+  void set_frozen(literalt a) override;
+
+  /// Limits the total time that the solvers are run for
+  void set_time_limit_seconds(uint32_t seconds) override
+  {
+    time_limit_seconds = seconds;
+  }
+
+  /// Passes the memory limit on to each of the solvers added so far
+  void set_memory_limit_bytes(std::size_t bytes) override
+  {
+    for(auto &solver : solvers)
+      solver->set_memory_limit_bytes(bytes);
+  }
+
+protected:
+  resultt do_prop_solve() override;
+
+  std::vector<std::unique_ptr<cnf_solvert>> solvers;
+  /// Solvers that failed and are not asked again
+  std::vector<bool> failed;
+  /// Index of the solver that gave the most recent answer
+  std::size_t winner = 0;
+
+  /// Variables whose value has been passed on to all solvers
+  std::vector<bool> shared_units;
+
+  /// Pass the literals that solver \p from has found to be fixed on to the
+  /// other solvers
+  void share_units(std::size_t from);
+
+  uint32_t time_slice_seconds = 1;
+  uint32_t time_limit_seconds = 0;
+};
+
+#endif // CPROVER_SOLVERS_SAT_SAT_PORTFOLIO_H
@@ -8,6 +8,8 @@ Author: Michael Tautschnig
 
 #include "satcheck_cadical.h"
 
+#include <algorithm>
+
 #include <util/exception_utils.h>
 #include <util/invariant.h>
 #include <util/threeval.h>
@@ -76,28 +78,43 @@ propt::resultt satcheck_cadicalt::do_prop_solve()
   {
     log.status() << "SAT checker inconsistent: instance is UNSATISFIABLE"
                  << messaget::eom;
+    return resultt::P_UNSATISFIABLE;
   }
-  else
+
+  if(std::any_of(assumptions.begin(), assumptions.end(), is_false))
   {
-    switch(solver->solve())
-    {
-      case 10:
-        log.status() << "SAT checker: instance is SATISFIABLE" << messaget::eom;
-        status = statust::SAT;
-        return resultt::P_SATISFIABLE;
-      case 20:
-        log.status() << "SAT checker: instance is UNSATISFIABLE"
-                     << messaget::eom;
-        break;
-      default:
-        log.status() << "SAT checker: solving returned without solution"
-                     << messaget::eom;
-        throw analysis_exceptiont(
-          "solving inside CaDiCaL SAT solver has been interrupted");
-    }
+    log.status() << "got FALSE as assumption: instance is UNSATISFIABLE"
+                 << messaget::eom;
+    return resultt::P_UNSATISFIABLE;
   }
 
-  status = statust::UNSAT;
+  // assumptions only hold for the next call to solve
+  for(const auto &lit : assumptions)
+  {
+    if(!lit.is_true())
+      solver->assume(lit.dimacs());
+  }
+
+  switch(solver->solve())
+  {
+    case 10:
+      log.status() << "SAT checker: instance is SATISFIABLE" << messaget::eom;
+      status = statust::SAT;
+      return resultt::P_SATISFIABLE;
+    case 20:
+      log.status() << "SAT checker: instance is UNSATISFIABLE"
+                   << messaget::eom;
+      break;
+    default:
+      log.status() << "SAT checker: solving returned without solution"
+                   << messaget::eom;
+      throw analysis_exceptiont(
+        "solving inside CaDiCaL SAT solver has been interrupted");
+  }
+
+  // without assumptions, the clauses themselves are inconsistent, and will
+  // remain so when more clauses are added
+  status = assumptions.empty() ? statust::UNSAT : statust::INIT;
   return resultt::P_UNSATISFIABLE;
 }
 
@@ -107,8 +124,8 @@ void satcheck_cadicalt::set_assignment(literalt a, bool value)
   INVARIANT(false, "method not supported");
 }
 
-satcheck_cadicalt::satcheck_cadicalt() :
-  solver(new CaDiCaL::Solver())
+satcheck_cadicalt::satcheck_cadicalt(message_handlert &message_handler)
+  : cnf_solvert(message_handler), solver(new CaDiCaL::Solver())
 {
   solver->set("quiet", 1);
 }
@@ -120,13 +137,31 @@ satcheck_cadicalt::~satcheck_cadicalt()
 
 void satcheck_cadicalt::set_assumptions(const bvt &bv)
 {
-  INVARIANT(false, "method not supported");
+  for(const auto &lit : bv)
+  {
+    if(!lit.is_constant())
+      INVARIANT(lit.var_no() < no_variables(), "reject out of bound variables");
+  }
+
+  assumptions = bv;
 }
 
 bool satcheck_cadicalt::is_in_conflict(literalt a) const
 {
-  INVARIANT(false, "method not supported");
-  return false;
+  PRECONDITION(!a.is_constant());
+  return solver->failed(a.dimacs());
+}
+
+void satcheck_cadicalt::set_frozen(literalt a)
+{
+  if(!a.is_constant())
+    solver->freeze(a.dimacs());
+}
+
+bool satcheck_cadicalt::set_preset(const std::string &preset)
+{
+  PRECONDITION(clause_counter == 0);
+  return solver->configure(preset.c_str());
 }
 
 #endif
@@ -20,7 +20,7 @@ namespace CaDiCaL // NOLINT(readability/namespace)
 class satcheck_cadicalt:public cnf_solvert
 {
 public:
-  satcheck_cadicalt();
+  explicit satcheck_cadicalt(message_handlert &message_handler);
   virtual ~satcheck_cadicalt();
 
   const std::string solver_text() override;
@@ -32,19 +32,31 @@ public:
   void set_assumptions(const bvt &_assumptions) override;
   bool has_set_assumptions() const override
   {
-    return false;
+    return true;
   }
   bool has_is_in_conflict() const override
   {
-    return false;
+    return true;
   }
   bool is_in_conflict(literalt a) const override;
 
+  /// Keep CaDiCaL from eliminating the variable of \p a, as it is going to
+  /// be used in clauses or assumptions that are added later
+  void set_frozen(literalt a) override;
+
+  /// Tune CaDiCaL for formulas that are expected to be satisfiable ("sat"),
+  /// unsatisfiable ("unsat"), or disable preprocessing and inprocessing
+  /// ("plain"). This has to be done before any clause is added.
+  /// \return false if \p preset is not known to CaDiCaL
+  bool set_preset(const std::string &preset);
+
 protected:
   resultt do_prop_solve() override;
 
   // NOLINTNEXTLINE(readability/identifiers)
   CaDiCaL::Solver * solver;
+
+  bvt assumptions;
 };
 
 #endif // CPROVER_SOLVERS_SAT_SATCHECK_CADICAL_H
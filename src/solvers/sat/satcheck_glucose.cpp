@@ -249,6 +249,26 @@ bool satcheck_glucose_baset<T>::is_in_conflict(literalt a) const
   return false;
 }
 
+template <typename T>
+bvt satcheck_glucose_baset<T>::get_fixed_literals() const
+{
+  using Glucose::lbool;
+
+  // after solving, only the assignments at decision level 0 remain, which
+  // are implied by the clauses
+  bvt result;
+  for(int v = 1; v < solver->nVars(); ++v)
+  {
+    const lbool value = solver->value(v);
+    if(value == l_True)
+      result.push_back(literalt(v, false));
+    else if(value == l_False)
+      result.push_back(literalt(v, true));
+  }
+
+  return result;
+}
+
 template<typename T>
 void satcheck_glucose_baset<T>::set_assumptions(const bvt &bv)
 {
@@ -42,6 +42,8 @@ public:
   void set_polarity(literalt a, bool value);
 
   bool is_in_conflict(literalt a) const override;
+
+  bvt get_fixed_literals() const override;
   bool has_set_assumptions() const override
   {
     return true;
@@ -75,7 +77,7 @@ public:
   explicit satcheck_glucose_simplifiert(message_handlert &message_handler);
   const std::string solver_text() override;
   void set_frozen(literalt a) override;
-  bool is_eliminated(literalt a) const;
+  bool is_eliminated(literalt a) const override;
 };
 
 #endif // CPROVER_SOLVERS_SAT_SATCHECK_GLUCOSE_H
@@ -0,0 +1,264 @@
+/*******************************************************************\
+
+Module: IPASIR SAT Solvers Loaded at Runtime
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// IPASIR SAT Solvers Loaded at Runtime
+
+#include "satcheck_ipasir_dynamic.h"
+
+#include <algorithm>
+
+#include <util/exception_utils.h>
+#include <util/invariant.h>
+#include <util/threeval.h>
+
+#ifdef _WIN32
+#include <util/pragma_push.def>
+#ifdef _MSC_VER
+#pragma warning(disable:4668)
+  // using #if/#elif on undefined macro
+#pragma warning(disable : 5039)
+// pointer or reference to potentially throwing function passed to extern C
+#endif
+#include <windows.h>
+#include <util/pragma_pop.def>
+#include <util/unicode.h>
+#else
+#include <dlfcn.h>
+#endif
+
+/// The functions of the IPASIR interface, as resolved in the library
+struct satcheck_ipasir_dynamict::ipasir_apit
+{
+  const char *(*signature)();
+  void *(*init)();
+  void (*release)(void *solver);
+  void (*add)(void *solver, int lit_or_zero);
+  void (*assume)(void *solver, int lit);
+  int (*solve)(void *solver);
+  int (*val)(void *solver, int lit);
+  int (*failed)(void *solver, int lit);
+  void (*set_terminate)(void *solver, void *data, int (*terminate)(void *));
+};
+
+static void *open_library(const std::string &library)
+{
+#ifdef _WIN32
+  return LoadLibraryW(widen(library).c_str());
+#else
+  return dlopen(library.c_str(), RTLD_NOW | RTLD_LOCAL);
+#endif
+}
+
+static void close_library(void *library)
+{
+#ifdef _WIN32
+  FreeLibrary(static_cast<HMODULE>(library));
+#else
+  dlclose(library);
+#endif
+}
+
+static std::string library_error()
+{
+#ifdef _WIN32
+  return "error code " + std::to_string(GetLastError());
+#else
+  const char *error = dlerror();
+  return error == nullptr ? "unknown error" : error;
+#endif
+}
+
+/// Look up the function \p name in \p library and store it in \p function
+template <typename functiont>
+static void resolve(void *library, const char *name, functiont &function)
+{
+#ifdef _WIN32
+  auto address = GetProcAddress(static_cast<HMODULE>(library), name);
+#else
+  void *address = dlsym(library, name);
+#endif
+  if(address == nullptr)
+  {
+    throw system_exceptiont(
+      std::string("IPASIR library does not provide ") + name);
+  }
+  function = reinterpret_cast<functiont>(address);
+}
+
+satcheck_ipasir_dynamict::satcheck_ipasir_dynamict(
+  const std::string &library_path,
+  message_handlert &message_handler)
+  : cnf_solvert(message_handler), api(new ipasir_apit())
+{
+  library = open_library(library_path);
+  if(library == nullptr)
+  {
+    throw system_exceptiont(
+      "failed to load IPASIR library " + library_path + ": " +
+      library_error());
+  }
+
+  try
+  {
+    resolve(library, "ipasir_signature", api->signature);
+    resolve(library, "ipasir_init", api->init);
+    resolve(library, "ipasir_release", api->release);
+    resolve(library, "ipasir_add", api->add);
+    resolve(library, "ipasir_assume", api->assume);
+    resolve(library, "ipasir_solve", api->solve);
+    resolve(library, "ipasir_val", api->val);
+    resolve(library, "ipasir_failed", api->failed);
+    resolve(library, "ipasir_set_terminate", api->set_terminate);
+  }
+  catch(...)
+  {
+    close_library(library);
+    throw;
+  }
+
+  solver = api->init();
+}
+
+satcheck_ipasir_dynamict::~satcheck_ipasir_dynamict()
+{
+  if(solver != nullptr)
+    api->release(solver);
+  close_library(library);
+}
+
+const std::string satcheck_ipasir_dynamict::solver_text()
+{
+  return std::string(api->signature());
+}
+
+tvt satcheck_ipasir_dynamict::l_get(literalt a) const
+{
+  if(a.is_constant())
+    return tvt(a.sign());
+
+  // IPASIR only defines values of variables that occur in the formula
+  if(a.var_no() > max_variable)
+    return tvt::unknown();
+
+  const int val = api->val(solver, a.dimacs());
+
+  if(val > 0)
+    return tvt(true);
+  else if(val < 0)
+    return tvt(false);
+  else
+    return tvt::unknown();
+}
+
+void satcheck_ipasir_dynamict::lcnf(const bvt &bv)
+{
+  for(const auto &lit : bv)
+  {
+    if(lit.is_true())
+      return;
+    else if(!lit.is_false())
+      INVARIANT(lit.var_no() < no_variables(), "reject out of bound variables");
+  }
+
+  for(const auto &lit : bv)
+  {
+    if(!lit.is_false())
+    {
+      api->add(solver, lit.dimacs());
+      max_variable = std::max(max_variable, lit.var_no());
+    }
+  }
+  api->add(solver, 0); // terminate clause
+
+  clause_counter++;
+}
+
+int satcheck_ipasir_dynamict::terminate(void *data)
+{
+  const auto &deadline =
+    *static_cast<const std::chrono::steady_clock::time_point *>(data);
+  return std::chrono::steady_clock::now() >= deadline;
+}
+
+propt::resultt satcheck_ipasir_dynamict::do_prop_solve()
+{
+  INVARIANT(status != statust::ERROR, "there cannot be an error");
+
+  log.statistics() << (no_variables() - 1) << " variables, " << clause_counter
+                   << " clauses" << messaget::eom;
+
+  if(status == statust::UNSAT)
+  {
+    log.status() << "SAT checker inconsistent: instance is UNSATISFIABLE"
+                 << messaget::eom;
+    return resultt::P_UNSATISFIABLE;
+  }
+
+  if(std::any_of(assumptions.begin(), assumptions.end(), is_false))
+  {
+    log.status() << "got FALSE as assumption: instance is UNSATISFIABLE"
+                 << messaget::eom;
+    return resultt::P_UNSATISFIABLE;
+  }
+
+  for(const auto &lit : assumptions)
+  {
+    if(!lit.is_true())
+    {
+      api->assume(solver, lit.dimacs());
+      max_variable = std::max(max_variable, lit.var_no());
+    }
+  }
+
+  if(time_limit_seconds != 0)
+  {
+    deadline = std::chrono::steady_clock::now() +
+               std::chrono::seconds(time_limit_seconds);
+    api->set_terminate(solver, &deadline, terminate);
+  }
+  else
+    api->set_terminate(solver, nullptr, nullptr);
+
+  // 10 = SAT, 20 = UNSAT, 0 = interrupted
+  const int solver_state = api->solve(solver);
+
+  if(solver_state == 10)
+  {
+    log.status() << "SAT checker: instance is SATISFIABLE" << messaget::eom;
+    status = statust::SAT;
+    return resultt::P_SATISFIABLE;
+  }
+  else if(solver_state == 20)
+  {
+    log.status() << "SAT checker: instance is UNSATISFIABLE" << messaget::eom;
+    // only final if the formula itself, not the assumptions, is the reason
+    status = assumptions.empty() ? statust::UNSAT : statust::INIT;
+    return resultt::P_UNSATISFIABLE;
+  }
+
+  log.status() << "SAT checker: solving returned without solution"
+               << messaget::eom;
+  return resultt::P_ERROR;
+}
+
+void satcheck_ipasir_dynamict::set_assignment(literalt a, bool)
+{
+  INVARIANT(!a.is_constant(), "cannot set an assignment for a constant");
+  INVARIANT(false, "method not supported");
+}
+
+void satcheck_ipasir_dynamict::set_assumptions(const bvt &bv)
+{
+  assumptions = bv;
+}
+
+bool satcheck_ipasir_dynamict::is_in_conflict(literalt a) const
+{
+  return api->failed(solver, a.dimacs()) != 0;
+}
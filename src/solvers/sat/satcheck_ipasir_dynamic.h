@@ -0,0 +1,82 @@
+/*******************************************************************\
+
+Module: IPASIR SAT Solvers Loaded at Runtime
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// IPASIR SAT Solvers Loaded at Runtime
+
+#ifndef CPROVER_SOLVERS_SAT_SATCHECK_IPASIR_DYNAMIC_H
+#define CPROVER_SOLVERS_SAT_SATCHECK_IPASIR_DYNAMIC_H
+
+#include <chrono>
+#include <memory>
+
+#include "cnf.h"
+
+/// Binds to any SAT solver that implements the IPASIR interface (see
+/// https://github.com/biotomas/ipasir/blob/master/ipasir.h) in a shared
+/// library, which is loaded when the solver is constructed. Unlike
+/// \ref satcheck_ipasirt this does not require linking the solver into the
+/// binary.
+class satcheck_ipasir_dynamict : public cnf_solvert
+{
+public:
+  /// Load the shared library \p library and create a solver instance
+  /// \throws system_exceptiont if the library cannot be loaded or does not
+  ///   provide all of the IPASIR functions
+  satcheck_ipasir_dynamict(
+    const std::string &library,
+    message_handlert &message_handler);
+  ~satcheck_ipasir_dynamict() override;
+
+  const std::string solver_text() override;
+  tvt l_get(literalt a) const override;
+
+  void lcnf(const bvt &bv) override;
+
+  /// Not supported by IPASIR
+  void set_assignment(literalt a, bool value) override;
+
+  void set_assumptions(const bvt &_assumptions) override;
+  bool has_set_assumptions() const override
+  {
+    return true;
+  }
+  bool has_is_in_conflict() const override
+  {
+    return true;
+  }
+  bool is_in_conflict(literalt a) const override;
+
+  /// Stop solving after \p seconds of wall-clock time, using the IPASIR
+  /// termination callback
+  void set_time_limit_seconds(uint32_t seconds) override
+  {
+    time_limit_seconds = seconds;
+  }
+
+protected:
+  resultt do_prop_solve() override;
+
+  struct ipasir_apit;
+  std::unique_ptr<ipasir_apit> api;
+
+  void *library = nullptr;
+  void *solver = nullptr;
+
+  bvt assumptions;
+
+  /// Largest variable number that has been passed to the solver
+  unsigned max_variable = 0;
+
+  uint32_t time_limit_seconds = 0;
+  std::chrono::steady_clock::time_point deadline;
+
+  static int terminate(void *data);
+};
+
+#endif // CPROVER_SOLVERS_SAT_SATCHECK_IPASIR_DYNAMIC_H
@@ -14,10 +14,13 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <unistd.h>
 #endif
 
+#include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <stack>
 
 #include <util/invariant.h>
+#include <util/memory_info.h>
 #include <util/threeval.h>
 
 #include <minisat/core/Solver.h>
@@ -153,10 +156,12 @@ void satcheck_minisat2_baset<T>::lcnf(const bvt &bv)
 #ifndef _WIN32
 
 static Minisat::Solver *solver_to_interrupt=nullptr;
+static volatile sig_atomic_t solver_interrupted = 0;
 
 static void interrupt_solver(int signum)
 {
   (void)signum; // unused parameter -- just removing the name trips up cpplint
+  solver_interrupted = 1;
   solver_to_interrupt->interrupt();
 }
 
@@ -199,9 +204,15 @@ propt::resultt satcheck_minisat2_baset<T>::do_prop_solve()
 
     using Minisat::lbool;
 
+    // the counters of the solver add up over all calls
+    const uint64_t conflicts = solver->conflicts;
+    const uint64_t decisions = solver->decisions;
+    const uint64_t propagations = solver->propagations;
+
 #ifndef _WIN32
 
     void (*old_handler)(int) = SIG_ERR;
+    solver_interrupted = 0;
 
     if(time_limit_seconds != 0)
     {
@@ -213,7 +224,31 @@ propt::resultt satcheck_minisat2_baset<T>::do_prop_solve()
         alarm(time_limit_seconds);
     }
 
-    lbool solver_result = solver->solveLimited(solver_assumptions);
+    // With a memory limit, solve in slices of a bounded number of conflicts
+    // and check the memory use in between; the learnt clauses are kept.
+    bool memory_limit_reached = false;
+    lbool solver_result = l_Undef;
+    while(true)
+    {
+      if(memory_limit_bytes != 0)
+        solver->setConfBudget(conflicts_between_memory_checks);
+
+      solver_result = solver->solveLimited(solver_assumptions);
+
+      if(
+        solver_result != l_Undef || memory_limit_bytes == 0 ||
+        solver_interrupted)
+      {
+        break;
+      }
+
+      if(allocated_memory() >= memory_limit_bytes)
+      {
+        memory_limit_reached = true;
+        break;
+      }
+    }
+    solver->budgetOff();
 
     if(old_handler != SIG_ERR)
     {
@@ -230,10 +265,29 @@ propt::resultt satcheck_minisat2_baset<T>::do_prop_solve()
                     << messaget::eom;
     }
 
+    if(memory_limit_bytes != 0)
+    {
+      log.warning() << "Memory limit ignored (not supported on Win32 yet)"
+                    << messaget::eom;
+    }
+
     lbool solver_result = solver->solve(solver_assumptions) ? l_True : l_False;
 
 #endif
 
+    log.statistics() << (solver->conflicts - conflicts) << " conflicts, "
+                     << (solver->decisions - decisions) << " decisions, "
+                     << (solver->propagations - propagations)
+                     << " propagations, " << solver->nLearnts()
+                     << " learnt clauses";
+    if(solver->nLearnts() > 0)
+    {
+      log.statistics() << " of average size "
+                       << static_cast<double>(solver->learnts_literals) /
+                            solver->nLearnts();
+    }
+    log.statistics() << messaget::eom;
+
     if(solver_result == l_True)
     {
       log.status() << "SAT checker: instance is SATISFIABLE" << messaget::eom;
@@ -249,7 +303,27 @@ propt::resultt satcheck_minisat2_baset<T>::do_prop_solve()
       return resultt::P_UNSATISFIABLE;
     }
 
+#ifndef _WIN32
+    if(memory_limit_reached)
+    {
+      log.error() << "SAT checker: memory limit reached" << messaget::eom;
+      status = statust::ERROR;
+      return resultt::P_ERROR;
+    }
+#endif
+
     log.status() << "SAT checker: timed out or other error" << messaget::eom;
+
+#ifndef _WIN32
+    // an interrupted query can be resumed by solving again
+    if(old_handler != SIG_ERR)
+    {
+      solver->clearInterrupt();
+      status = statust::INIT;
+      return resultt::P_ERROR;
+    }
+#endif
+
     status = statust::ERROR;
     return resultt::P_ERROR;
   }
@@ -316,6 +390,62 @@ bool satcheck_minisat2_baset<T>::is_in_conflict(literalt a) const
   return false;
 }
 
+template <typename T>
+bvt satcheck_minisat2_baset<T>::get_fixed_literals() const
+{
+  using Minisat::lbool;
+
+  // after solving, only the assignments at decision level 0 remain, which
+  // are implied by the clauses
+  bvt result;
+  for(int v = 1; v < solver->nVars(); ++v)
+  {
+    const lbool value = solver->value(v);
+    if(value == l_True)
+      result.push_back(literalt(v, false));
+    else if(value == l_False)
+      result.push_back(literalt(v, true));
+  }
+
+  return result;
+}
+
+/// Reads the activities of the variables, which MiniSat does not make
+/// public, through a pointer to the protected member of a derived class
+struct minisat_activityt : public Minisat::Solver
+{
+  static const Minisat::vec<double> &get(const Minisat::Solver &solver)
+  {
+    return solver.*(&minisat_activityt::activity);
+  }
+};
+
+template <typename T>
+std::vector<propt::variable_activityt>
+satcheck_minisat2_baset<T>::most_active_variables(std::size_t n) const
+{
+  const Minisat::vec<double> &activity = minisat_activityt::get(*solver);
+
+  std::vector<variable_activityt> result;
+  for(int v = 1; v < activity.size(); ++v)
+  {
+    if(activity[v] > 0)
+      result.emplace_back(v, activity[v]);
+  }
+
+  const auto end = result.begin() + std::min(n, result.size());
+  std::partial_sort(
+    result.begin(),
+    end,
+    result.end(),
+    [](const variable_activityt &a, const variable_activityt &b) {
+      return a.second > b.second;
+    });
+  result.erase(end, result.end());
+
+  return result;
+}
+
 template<typename T>
 void satcheck_minisat2_baset<T>::set_assumptions(const bvt &bv)
 {
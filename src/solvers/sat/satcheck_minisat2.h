@@ -48,6 +48,12 @@ public:
   void clear_interrupt();
 
   bool is_in_conflict(literalt a) const override;
+
+  bvt get_fixed_literals() const override;
+
+  std::vector<variable_activityt>
+  most_active_variables(std::size_t n) const override;
+
   bool has_set_assumptions() const override final
   {
     return true;
@@ -62,11 +68,21 @@ public:
     time_limit_seconds=lim;
   }
 
+  /// The limit is checked after every \ref conflicts_between_memory_checks
+  /// conflicts
+  void set_memory_limit_bytes(std::size_t bytes) override
+  {
+    memory_limit_bytes = bytes;
+  }
+
 protected:
   resultt do_prop_solve() override;
 
   T *solver;
   uint32_t time_limit_seconds;
+  std::size_t memory_limit_bytes = 0;
+
+  static const int conflicts_between_memory_checks = 10000;
 
   void add_variables();
   bvt assumptions;
@@ -87,7 +103,7 @@ public:
   explicit satcheck_minisat_simplifiert(message_handlert &message_handler);
   const std::string solver_text() override final;
   void set_frozen(literalt a) override final;
-  bool is_eliminated(literalt a) const;
+  bool is_eliminated(literalt a) const override;
 };
 
 #endif // CPROVER_SOLVERS_SAT_SATCHECK_MINISAT2_H
@@ -14,6 +14,29 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/irep_hash_container.h>
 #include <util/std_expr.h>
 
+bool letifyt::can_share_operands(const exprt &expr)
+{
+  // Binders introduce symbols that must not escape, and the remaining
+  // expressions are looked up by smt2_convt as they were given to
+  // find_symbols.
+  return expr.id() != ID_exists && expr.id() != ID_forall &&
+         expr.id() != ID_let && expr.id() != ID_array_comprehension &&
+         expr.id() != ID_address_of &&
+         expr.id() != ID_array && expr.id() != ID_array_of &&
+         expr.id() != ID_string_constant && expr.id() != ID_object_size;
+}
+
+bool letifyt::can_share(const exprt &expr)
+{
+  if(expr.operands().empty())
+    return false;
+
+  const irep_idt &type_id = expr.type().id();
+  return type_id == ID_bool || type_id == ID_signedbv ||
+         type_id == ID_unsignedbv || type_id == ID_bv ||
+         type_id == ID_floatbv || type_id == ID_fixedbv;
+}
+
 void letifyt::collect_bindings(
   const exprt &expr,
   seen_expressionst &map,
@@ -35,8 +58,11 @@ void letifyt::collect_bindings(
   }
 
   // not seen before
-  for(auto &op : expr.operands())
-    collect_bindings(op, map, let_order);
+  if(can_share_operands(expr))
+  {
+    for(auto &op : expr.operands())
+      collect_bindings(op, map, let_order);
+  }
 
   INVARIANT(
     map.find(expr) == map.end(), "expression should not have been seen yet");
@@ -54,7 +80,7 @@ void letifyt::collect_bindings(
 exprt letifyt::letify(
   const exprt &expr,
   const std::vector<exprt> &let_order,
-  const seen_expressionst &map)
+  const seen_expressionst &map) const
 {
   exprt result = substitute_let(expr, map);
 
@@ -66,8 +92,8 @@ exprt letifyt::letify(
     auto m_it = map.find(current);
     PRECONDITION(m_it != map.end());
 
-    // Used more than once? Then a let pays off.
-    if(m_it->second.count > 1)
+    // Used often enough? Then a let pays off.
+    if(m_it->second.count >= let_threshold && can_share(current))
     {
       result = let_exprt(
         m_it->second.let_symbol, substitute_let(current, map), result);
@@ -79,6 +105,9 @@ exprt letifyt::letify(
 
 exprt letifyt::operator()(const exprt &expr)
 {
+  if(let_threshold == 0)
+    return expr;
+
   seen_expressionst map;
   std::vector<exprt> let_order;
 
@@ -87,23 +116,41 @@ exprt letifyt::operator()(const exprt &expr)
   return letify(expr, let_order, map);
 }
 
-exprt letifyt::substitute_let(const exprt &expr, const seen_expressionst &map)
+exprt letifyt::substitute_let(
+  const exprt &expr,
+  const seen_expressionst &map) const
 {
-  if(expr.operands().empty())
-    return expr;
-
   exprt tmp = expr;
 
-  for(auto &op : tmp.operands())
+  if(can_share_operands(tmp))
   {
-    op.visit_pre([&map](exprt &expr) {
-      seen_expressionst::const_iterator it = map.find(expr);
-
-      // replace subexpression by let symbol if used more than once
-      if(it != map.end() && it->second.count > 1)
-        expr = it->second.let_symbol;
-    });
+    for(auto &op : tmp.operands())
+      substitute_let_rec(op, map);
   }
 
   return tmp;
 }
+
+void letifyt::substitute_let_rec(
+  exprt &expr,
+  const seen_expressionst &map) const
+{
+  if(expr.operands().empty())
+    return;
+
+  seen_expressionst::const_iterator it = map.find(expr);
+
+  // replace subexpression by let symbol if used often enough
+  if(
+    it != map.end() && it->second.count >= let_threshold && can_share(expr))
+  {
+    expr = it->second.let_symbol;
+    return;
+  }
+
+  if(can_share_operands(expr))
+  {
+    for(auto &op : expr.operands())
+      substitute_let_rec(op, map);
+  }
+}
@@ -16,9 +16,27 @@ Author: Daniel Kroening, kroening@kroening.com
 class letifyt
 {
 public:
+  /// \param _let_threshold: the number of occurrences from which a
+  ///   subexpression is bound by a let, where zero disables letification
+  explicit letifyt(std::size_t _let_threshold = 2)
+    : let_threshold(_let_threshold)
+  {
+  }
+
   exprt operator()(const exprt &);
 
+  /// Return true if the subexpressions of \p expr may be replaced by a
+  /// symbol, which is not the case below binders and for expressions that
+  /// smt2_convt identifies by their operands
+  static bool can_share_operands(const exprt &expr);
+
+  /// Return true if \p expr itself may be replaced by a symbol, which
+  /// is restricted to Boolean and bit-vector expressions with operands
+  static bool can_share(const exprt &expr);
+
 protected:
+  std::size_t let_threshold;
+
   // to produce a fresh ID for each new let
   std::size_t let_id_count = 0;
 
@@ -44,12 +62,13 @@ protected:
     seen_expressionst &map,
     std::vector<exprt> &let_order);
 
-  static exprt letify(
+  exprt letify(
     const exprt &expr,
     const std::vector<exprt> &let_order,
-    const seen_expressionst &map);
+    const seen_expressionst &map) const;
 
-  static exprt substitute_let(const exprt &expr, const seen_expressionst &map);
+  exprt substitute_let(const exprt &expr, const seen_expressionst &map) const;
+  void substitute_let_rec(exprt &expr, const seen_expressionst &map) const;
 };
 
 #endif // CPROVER_SOLVERS_SMT2_LETIFY_H
@@ -54,6 +54,10 @@ smt2_convt::smt2_convt(
     use_datatypes(false),
     use_array_of_bool(false),
     emit_set_logic(true),
+    use_as_const(false),
+    use_lambda_for_array(false),
+    let_threshold(2),
+    define_fun_threshold(2),
     ns(_ns),
     out(_out),
     benchmark(_benchmark),
@@ -84,6 +88,7 @@ smt2_convt::smt2_convt(
     break;
 
   case solvert::CVC4:
+    use_as_const = true;
     break;
 
   case solvert::MATHSAT:
@@ -96,6 +101,8 @@ smt2_convt::smt2_convt(
     use_array_of_bool = true;
     emit_set_logic = false;
     use_datatypes = true;
+    use_as_const = true;
+    use_lambda_for_array = true;
     break;
   }
 
@@ -712,7 +719,7 @@ literalt smt2_convt::convert(const exprt &expr)
 
   out << "\n";
 
-  exprt prepared_expr = prepare_for_convert_expr(expr);
+  exprt prepared_expr = share_subterms(prepare_for_convert_expr(expr));
 
   literalt l(no_boolean_variables, false);
   no_boolean_variables++;
@@ -1286,6 +1293,21 @@ void smt2_convt::convert_expr(const exprt &expr)
     CHECK_RETURN(it != defined_expressions.end());
     out << it->second;
   }
+  else if(expr.id() == ID_array_comprehension)
+  {
+    const array_comprehension_exprt &array_comprehension =
+      to_array_comprehension_expr(expr);
+
+    if(use_lambda_for_array)
+      convert_array_comprehension(array_comprehension);
+    else
+    {
+      defined_expressionst::const_iterator it =
+        defined_expressions.find(array_comprehension);
+      CHECK_RETURN(it != defined_expressions.end());
+      out << it->second;
+    }
+  }
   else if(expr.id()==ID_index)
   {
     convert_index(to_index_expr(expr));
@@ -3787,6 +3809,56 @@ void smt2_convt::convert_with(const with_exprt &expr)
       expr.type().id_string());
 }
 
+/// Convert \p expr to a `lambda` expression, whose parameter has the index
+/// sort of the array.
+void smt2_convt::convert_array_comprehension(
+  const array_comprehension_exprt &expr)
+{
+  const symbol_exprt &arg = expr.arg();
+  const typet &index_type = expr.type().size().type();
+
+  out << "(lambda ((";
+  if(arg.type() == index_type)
+  {
+    convert_expr(arg);
+    out << ' ';
+    convert_type(index_type);
+    out << ")) ";
+    convert_array_element(expr.body(), expr.type().subtype());
+  }
+  else
+  {
+    // bind the argument to the index converted to its type
+    const smt2_symbolt index("?index", index_type);
+    out << "?index ";
+    convert_type(index_type);
+    out << ")) (let ((";
+    convert_expr(arg);
+    out << ' ';
+    convert_expr(typecast_exprt(index, arg.type()));
+    out << ")) ";
+    convert_array_element(expr.body(), expr.type().subtype());
+    out << ')'; // let
+  }
+  out << ')'; // lambda
+}
+
+/// Convert \p value, an element of an array with element type
+/// \p subtype, to the sort of the elements of the array.
+void smt2_convt::convert_array_element(
+  const exprt &value,
+  const typet &subtype)
+{
+  if(subtype.id() == ID_bool && !use_array_of_bool)
+  {
+    out << "(ite ";
+    convert_expr(value);
+    out << " #b1 #b0)";
+  }
+  else
+    convert_expr(value);
+}
+
 void smt2_convt::convert_update(const exprt &expr)
 {
   PRECONDITION(expr.operands().size() == 3);
@@ -3812,7 +3884,7 @@ void smt2_convt::convert_index(const index_exprt &expr)
         out << " ";
         convert_expr(typecast_exprt(expr.index(), array_type.size().type()));
         out << ")";
-        out << " #b1 #b0)";
+        out << " #b1)";
       }
       else
       {
@@ -4190,7 +4262,8 @@ void smt2_convt::set_to(const exprt &expr, bool value)
 
         id.type=equal_expr.lhs().type();
         find_symbols(id.type);
-        exprt prepared_rhs = prepare_for_convert_expr(equal_expr.rhs());
+        exprt prepared_rhs =
+          share_subterms(prepare_for_convert_expr(equal_expr.rhs()));
 
         std::string smt2_identifier=convert_identifier(identifier);
         smt2_identifiers.insert(smt2_identifier);
@@ -4208,7 +4281,7 @@ void smt2_convt::set_to(const exprt &expr, bool value)
     }
   }
 
-  exprt prepared_expr = prepare_for_convert_expr(expr);
+  exprt prepared_expr = share_subterms(prepare_for_convert_expr(expr));
 
 #if 0
   out << "; CONV: "
@@ -4285,6 +4358,114 @@ exprt smt2_convt::prepare_for_convert_expr(const exprt &expr)
   return lowered_expr;
 }
 
+/// Replace the subterms of \p expr that occur in \ref define_fun_threshold
+/// assertions, counting \p expr as one of them, by symbols that are
+/// defined by `define-fun` ahead of the current assertion, and bind those
+/// that occur \ref let_threshold times within \p expr by `let`.
+/// \param expr: expression prepared by \ref prepare_for_convert_expr
+/// \return equivalent expression suitable for convert_expr.
+exprt smt2_convt::share_subterms(const exprt &expr)
+{
+  exprt result = expr;
+
+  if(define_fun_threshold != 0)
+  {
+    // The traversals are linear in the size of the DAG, as nodes are
+    // identified by their address.
+    ++number_of_assertions;
+    std::unordered_set<const void *> visited;
+    count_subterms(result, visited);
+    std::unordered_map<const void *, exprt> replaced;
+    result = replace_shared_subterms(expr, replaced);
+  }
+
+  if(let_threshold != 0)
+    result = letifyt(let_threshold)(result);
+
+  return result;
+}
+
+void smt2_convt::count_subterms(
+  const exprt &expr,
+  std::unordered_set<const void *> &visited)
+{
+  if(expr.operands().empty() || !visited.insert(&expr.read()).second)
+    return;
+
+  if(letifyt::can_share(expr))
+  {
+    shared_subtermt &shared = shared_subterms[expr];
+
+    // Each subterm counts once per assertion; subterms with a definition
+    // are replaced as a whole.
+    if(
+      shared.assertion == number_of_assertions || !shared.identifier.empty())
+    {
+      return;
+    }
+
+    shared.assertion = number_of_assertions;
+    ++shared.count;
+  }
+
+  if(letifyt::can_share_operands(expr))
+  {
+    for(const auto &op : expr.operands())
+      count_subterms(op, visited);
+  }
+}
+
+exprt smt2_convt::replace_shared_subterms(
+  const exprt &expr,
+  std::unordered_map<const void *, exprt> &replaced)
+{
+  if(expr.operands().empty())
+    return expr;
+
+  auto cached = replaced.find(&expr.read());
+  if(cached != replaced.end())
+    return cached->second;
+
+  shared_subtermt *shared = nullptr;
+  if(letifyt::can_share(expr))
+  {
+    auto entry = shared_subterms.find(expr);
+    if(entry != shared_subterms.end())
+    {
+      shared = &entry->second;
+      if(!shared->identifier.empty())
+        return smt2_symbolt(shared->identifier, expr.type());
+    }
+  }
+
+  exprt result = expr;
+
+  if(letifyt::can_share_operands(expr))
+  {
+    for(auto &op : result.operands())
+      op = replace_shared_subterms(op, replaced);
+  }
+
+  if(shared != nullptr && shared->count >= define_fun_threshold)
+  {
+    // The operands are defined by now, as they were replaced above.
+    shared->identifier =
+      "shared." + std::to_string(number_of_shared_subterms++);
+
+    out << "; shared subterm\n";
+    out << "(define-fun " << shared->identifier << " () ";
+    convert_type(expr.type());
+    out << ' ';
+    convert_expr(letifyt(let_threshold)(result));
+    out << ")\n";
+
+    result = smt2_symbolt(shared->identifier, expr.type());
+  }
+
+  replaced.emplace(&expr.read(), result);
+  return result;
+}
+
 void smt2_convt::find_symbols(const exprt &expr)
 {
   // recursive call on type
@@ -4303,6 +4484,46 @@ void smt2_convt::find_symbols(const exprt &expr)
     return;
   }
 
+  if(expr.id() == ID_array_comprehension)
+  {
+    // the argument is bound like the symbol of a quantifier
+    const auto &array_comprehension = to_array_comprehension_expr(expr);
+    const auto identifier = array_comprehension.arg().get_identifier();
+    identifiert &id = identifier_map[identifier];
+    id.type = array_comprehension.arg().type();
+    id.is_bound = true;
+    find_symbols(array_comprehension.type());
+    find_symbols(array_comprehension.body());
+
+    if(
+      !use_lambda_for_array &&
+      defined_expressions.find(expr) == defined_expressions.end())
+    {
+      const irep_idt id =
+        "array_comprehension." + std::to_string(defined_expressions.size());
+      out << "; the following is a substitute for an array comprehension\n";
+      out << "(declare-fun " << id << " () ";
+      convert_type(array_comprehension.type());
+      out << ")\n";
+
+      out << "(assert (forall ((";
+      convert_expr(array_comprehension.arg());
+      out << ' ';
+      convert_type(array_comprehension.arg().type());
+      out << ")) (= (select " << id << ' ';
+      convert_expr(typecast_exprt::conditional_cast(
+        array_comprehension.arg(), array_comprehension.type().size().type()));
+      out << ") ";
+      convert_array_element(
+        array_comprehension.body(), array_comprehension.type().subtype());
+      out << ")))\n"; // =, forall, assert
+
+      defined_expressions[expr] = id;
+    }
+
+    return;
+  }
+
   // recursive call on operands
   forall_operands(it, expr)
     find_symbols(*it);
@@ -4345,19 +4566,33 @@ void smt2_convt::find_symbols(const exprt &expr)
     {
       const irep_idt id =
         "array_of." + std::to_string(defined_expressions.size());
-      out << "; the following is a substitute for lambda i. x" << "\n";
-      out << "(declare-fun " << id << " () ";
-      convert_type(expr.type());
-      out << ")" << "\n";
+      if(use_as_const)
+      {
+        out << "(define-fun " << id << " () ";
+        convert_type(expr.type());
+        out << " ((as const ";
+        convert_type(expr.type());
+        out << ") ";
+        convert_array_element(
+          to_array_of_expr(expr).what(), expr.type().subtype());
+        out << "))\n";
+      }
+      else
+      {
+        out << "; the following is a substitute for lambda i. x" << "\n";
+        out << "(declare-fun " << id << " () ";
+        convert_type(expr.type());
+        out << ")" << "\n";
 
-      // use a quantifier instead of the lambda
-      #if 0 // not really working in any solver yet!
-      out << "(assert (forall ((i ";
-      convert_type(array_index_type());
-      out << ")) (= (select " << id << " i) ";
-      convert_expr(expr.op0());
-      out << ")))" << "\n";
-      #endif
+        // use a quantifier instead of the lambda
+        #if 0 // not really working in any solver yet!
+        out << "(assert (forall ((i ";
+        convert_type(array_index_type());
+        out << ")) (= (select " << id << " i) ";
+        convert_expr(expr.op0());
+        out << ")))" << "\n";
+        #endif
+      }
 
       defined_expressions[expr]=id;
     }
@@ -10,8 +10,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_SOLVERS_SMT2_SMT2_CONV_H
 #define CPROVER_SOLVERS_SMT2_SMT2_CONV_H
 
-#include <sstream>
 #include <set>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <util/std_expr.h>
 #include <util/byte_operators.h>
@@ -60,6 +62,20 @@ public:
   bool use_datatypes;
   bool use_array_of_bool;
   bool emit_set_logic;
+  /// define array_of expressions as constant arrays `((as const T) v)`
+  /// rather than declaring them without constraints
+  bool use_as_const;
+  /// convert array comprehensions to `lambda` expressions rather than
+  /// arrays that are constrained by a quantifier
+  bool use_lambda_for_array;
+
+  /// Subterms that occur this often within one assertion are bound by a
+  /// `let`; zero disables this
+  std::size_t let_threshold;
+
+  /// Subterms that occur in this many assertions are defined once by a
+  /// `define-fun` and referred to by name from then on; zero disables this
+  std::size_t define_fun_threshold;
 
   exprt handle(const exprt &expr) override;
   void set_to(const exprt &expr, bool value) override;
@@ -120,6 +136,8 @@ protected:
   void convert_member(const member_exprt &expr);
 
   void convert_with(const with_exprt &expr);
+  void convert_array_comprehension(const array_comprehension_exprt &expr);
+  void convert_array_element(const exprt &value, const typet &subtype);
   void convert_update(const exprt &expr);
 
   std::string convert_identifier(const irep_idt &identifier);
@@ -141,6 +159,33 @@ protected:
   // letification
   letifyt letify;
 
+  // sharing of subterms across assertions
+  struct shared_subtermt
+  {
+    /// number of assertions the subterm occurs in
+    std::size_t count = 0;
+    /// the last assertion the subterm was counted in
+    std::size_t assertion = 0;
+    /// the define-fun of the subterm, if any
+    irep_idt identifier;
+  };
+#if HASH_CODE
+  using shared_subtermst = std::unordered_map<exprt, shared_subtermt, irep_hash>;
+#else
+  using shared_subtermst = irep_hash_mapt<exprt, shared_subtermt>;
+#endif
+  shared_subtermst shared_subterms;
+  std::size_t number_of_assertions = 0;
+  std::size_t number_of_shared_subterms = 0;
+
+  exprt share_subterms(const exprt &expr);
+  void count_subterms(
+    const exprt &expr,
+    std::unordered_set<const void *> &visited);
+  exprt replace_shared_subterms(
+    const exprt &expr,
+    std::unordered_map<const void *, exprt> &replaced);
+
   // Parsing solver responses
   constant_exprt parse_literal(const irept &, const typet &type);
   struct_exprt parse_struct(const irept &s, const struct_typet &type);
@@ -215,6 +260,7 @@ protected:
   //
   // ID_array_of
   // ID_array
+  // ID_array_comprehension, unless use_lambda_for_array is set
   // ID_string_constant
 
   typedef std::map<exprt, irep_idt> defined_expressionst;
@@ -11,6 +11,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/arith_tools.h>
 #include <util/ieee_float.h>
 #include <util/invariant.h>
+#include <util/make_unique.h>
 #include <util/run.h>
 #include <util/std_expr.h>
 #include <util/std_types.h>
@@ -34,50 +35,50 @@ std::string smt2_dect::decision_procedure_text() const
   // clang-format on
 }
 
-decision_proceduret::resultt smt2_dect::dec_solve()
+void smt2_dect::set_to(const exprt &expr, bool value)
 {
-  ++number_of_solver_calls;
-
-  temporary_filet temp_file_problem("smt2_dec_problem_", ""),
-    temp_file_stdout("smt2_dec_stdout_", ""),
-    temp_file_stderr("smt2_dec_stderr_", "");
+  smt2_convt::set_to(expr, value);
 
+  // stream large problems to the solver while they are being generated
+  if(
+    !solver_process && piped_processt::is_supported() &&
+    stringstream.tellp() >= streaming_threshold)
   {
-    // we write the problem into a file
-    std::ofstream problem_out(
-      temp_file_problem(), std::ios_base::out | std::ios_base::trunc);
-    problem_out << stringstream.str();
-    write_footer(problem_out);
+    start_solver_process();
   }
 
+  if(solver_process)
+    send_pending_problem();
+}
+
+bool smt2_dect::solver_reads_stdin() const
+{
+  return solver == solvert::CPROVER_SMT2 || solver == solvert::MATHSAT;
+}
+
+std::vector<std::string>
+smt2_dect::solver_command(const std::string &problem_file) const
+{
   std::vector<std::string> argv;
-  std::string stdin_filename;
 
   switch(solver)
   {
   case solvert::BOOLECTOR:
-    argv = {"boolector", "--smt2", temp_file_problem(), "-m"};
+    argv = {"boolector", "--smt2", "-m"};
     break;
 
   case solvert::CPROVER_SMT2:
     argv = {"smt2_solver"};
-    stdin_filename = temp_file_problem();
     break;
 
   case solvert::CVC3:
-    argv = {"cvc3",
-            "+model",
-            "-lang",
-            "smtlib",
-            "-output-lang",
-            "smtlib",
-            temp_file_problem()};
+    argv = {"cvc3", "+model", "-lang", "smtlib", "-output-lang", "smtlib"};
     break;
 
   case solvert::CVC4:
     // The flags --bitblast=eager --bv-div-zero-const help but only
     // work for pure bit-vector formulas.
-    argv = {"cvc4", "-L", "smt2", temp_file_problem()};
+    argv = {"cvc4", "-L", "smt2"};
     break;
 
   case solvert::MATHSAT:
@@ -99,24 +100,110 @@ decision_proceduret::resultt smt2_dect::dec_solve()
             "-theory.fp.mode=1",
             "-theory.fp.bit_blast_mode=2",
             "-theory.arr.mode=1"};
-
-    stdin_filename = temp_file_problem();
     break;
 
   case solvert::YICES:
     //    command = "yices -smt -e "   // Calling convention for older versions
     // Convention for 2.2.1
-    argv = {"yices-smt2", temp_file_problem()};
+    argv = {"yices-smt2"};
     break;
 
   case solvert::Z3:
-    argv = {"z3", "-smt2", temp_file_problem()};
+    argv = {"z3", "-smt2"};
+    if(problem_file.empty())
+      argv.push_back("-in");
     break;
 
   case solvert::GENERIC:
     UNREACHABLE;
   }
 
+  if(!problem_file.empty() && !solver_reads_stdin())
+    argv.push_back(problem_file);
+
+  return argv;
+}
+
+void smt2_dect::start_solver_process()
+{
+  solver_process =
+    util_make_unique<piped_processt>(solver_command(""), "/dev/null");
+
+  stringstream.seekg(0);
+  send_pending_problem();
+}
+
+void smt2_dect::send_pending_problem()
+{
+  char buffer[1 << 12];
+  std::streamsize n;
+  while((n = stringstream.rdbuf()->sgetn(buffer, sizeof(buffer))) > 0)
+    solver_process->input().write(buffer, n);
+
+  if(!keep_problem)
+  {
+    stringstream.str(std::string());
+    stringstream.clear();
+  }
+}
+
+decision_proceduret::resultt smt2_dect::dec_solve()
+{
+  ++number_of_solver_calls;
+
+  if(!piped_processt::is_supported())
+    return dec_solve_using_files();
+
+  if(!solver_process)
+    start_solver_process();
+
+  if(!solver_process->started())
+  {
+    error() << "error running SMT2 solver" << eom;
+    solver_process.reset();
+    return decision_proceduret::resultt::D_ERROR;
+  }
+
+  send_pending_problem();
+
+  // The footer is specific to this call and must not become part of the
+  // problem replayed to later solver processes.
+  std::streambuf *problem_buffer =
+    stringstream.std::ios::rdbuf(solver_process->input().rdbuf());
+  write_footer(stringstream);
+  stringstream.std::ios::rdbuf(problem_buffer);
+
+  solver_process->close_input();
+
+  const resultt result = read_result(solver_process->output());
+  solver_process.reset();
+
+  return result;
+}
+
+decision_proceduret::resultt smt2_dect::dec_solve_using_files()
+{
+  temporary_filet temp_file_problem("smt2_dec_problem_", ""),
+    temp_file_stdout("smt2_dec_stdout_", ""),
+    temp_file_stderr("smt2_dec_stderr_", "");
+
+  {
+    // we write the problem into a file
+    std::ofstream problem_out(
+      temp_file_problem(), std::ios_base::out | std::ios_base::trunc);
+    problem_out << stringstream.str();
+
+    // the footer is not part of the problem kept for later calls
+    std::streambuf *problem_buffer =
+      stringstream.std::ios::rdbuf(problem_out.rdbuf());
+    write_footer(stringstream);
+    stringstream.std::ios::rdbuf(problem_buffer);
+  }
+
+  const std::vector<std::string> argv = solver_command(temp_file_problem());
+  const std::string stdin_filename =
+    solver_reads_stdin() ? temp_file_problem() : std::string();
+
   int res =
     run(argv[0], argv, stdin_filename, temp_file_stdout(), temp_file_stderr());
 
@@ -132,13 +219,7 @@ decision_proceduret::resultt smt2_dect::dec_solve()
 
 decision_proceduret::resultt smt2_dect::read_result(std::istream &in)
 {
-  std::string line;
   decision_proceduret::resultt res=resultt::D_ERROR;
-
-  boolean_assignment.clear();
-  boolean_assignment.resize(no_boolean_variables, false);
-
-  typedef std::unordered_map<irep_idt, irept> valuest;
   valuest values;
 
   while(in)
@@ -148,42 +229,61 @@ decision_proceduret::resultt smt2_dect::read_result(std::istream &in)
     if(!parsed_opt.has_value())
       break;
 
-    const auto &parsed = parsed_opt.value();
+    if(!read_response(parsed_opt.value(), res, values))
+      return decision_proceduret::resultt::D_ERROR;
+  }
 
-    if(parsed.id()=="sat")
-      res=resultt::D_SATISFIABLE;
-    else if(parsed.id()=="unsat")
-      res=resultt::D_UNSATISFIABLE;
-    else if(
-      parsed.id().empty() && parsed.get_sub().size() == 1 &&
-      parsed.get_sub().front().get_sub().size() == 2)
-    {
-      const irept &s0=parsed.get_sub().front().get_sub()[0];
-      const irept &s1=parsed.get_sub().front().get_sub()[1];
+  set_assignment(values);
 
-      // Examples:
-      // ( (B0 true) )
-      // ( (|__CPROVER_pipe_count#1| (_ bv0 32)) )
-      // ( (|some_integer| 0) )
-      // ( (|some_integer| (- 10)) )
+  return res;
+}
 
-      values[s0.id()]=s1;
-    }
-    else if(
-      parsed.id().empty() && parsed.get_sub().size() == 2 &&
-      parsed.get_sub().front().id() == "error")
+bool smt2_dect::read_response(
+  const irept &parsed,
+  resultt &res,
+  valuest &values)
+{
+  if(parsed.id()=="sat")
+    res=resultt::D_SATISFIABLE;
+  else if(parsed.id()=="unsat")
+    res=resultt::D_UNSATISFIABLE;
+  else if(
+    parsed.id().empty() && parsed.get_sub().size() == 1 &&
+    parsed.get_sub().front().get_sub().size() == 2)
+  {
+    const irept &s0=parsed.get_sub().front().get_sub()[0];
+    const irept &s1=parsed.get_sub().front().get_sub()[1];
+
+    // Examples:
+    // ( (B0 true) )
+    // ( (|__CPROVER_pipe_count#1| (_ bv0 32)) )
+    // ( (|some_integer| 0) )
+    // ( (|some_integer| (- 10)) )
+
+    values[s0.id()]=s1;
+  }
+  else if(
+    parsed.id().empty() && parsed.get_sub().size() == 2 &&
+    parsed.get_sub().front().id() == "error")
+  {
+    // We ignore errors after UNSAT because get-value after check-sat
+    // returns unsat will give an error.
+    if(res!=resultt::D_UNSATISFIABLE)
     {
-      // We ignore errors after UNSAT because get-value after check-sat
-      // returns unsat will give an error.
-      if(res!=resultt::D_UNSATISFIABLE)
-      {
-        error() << "SMT2 solver returned error message:\n"
-                << "\t\"" << parsed.get_sub()[1].id() <<"\"" << eom;
-        return decision_proceduret::resultt::D_ERROR;
-      }
+      error() << "SMT2 solver returned error message:\n"
+              << "\t\"" << parsed.get_sub()[1].id() <<"\"" << eom;
+      return false;
     }
   }
 
+  return true;
+}
+
+void smt2_dect::set_assignment(valuest &values)
+{
+  boolean_assignment.clear();
+  boolean_assignment.resize(no_boolean_variables, false);
+
   for(auto &assignment : identifier_map)
   {
     std::string conv_id=convert_identifier(assignment.first);
@@ -197,6 +297,4 @@ decision_proceduret::resultt smt2_dect::read_result(std::istream &in)
     const irept &value=values["B"+std::to_string(v)];
     boolean_assignment[v]=(value.id()==ID_true);
   }
-
-  return res;
 }
@@ -13,8 +13,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "smt2_conv.h"
 
 #include <util/message.h>
+#include <util/piped_process.h>
 
 #include <fstream>
+#include <memory>
 
 class smt2_stringstreamt
 {
@@ -42,8 +44,51 @@ public:
   resultt dec_solve() override;
   std::string decision_procedure_text() const override;
 
+  void set_to(const exprt &expr, bool value) override;
+
 protected:
+  typedef std::unordered_map<irep_idt, irept> valuest;
+
   resultt read_result(std::istream &in);
+
+  /// Process a single response of the solver: a check-sat result is stored
+  /// in \p res and the values of a get-value response are added to
+  /// \p values.
+  /// \return false if the solver reported an error
+  bool read_response(const irept &parsed, resultt &res, valuest &values);
+
+  /// Store the model given by \p values for use by \ref get
+  void set_assignment(valuest &values);
+
+  /// Write the problem to a file, run the solver on it and read the result
+  /// from another file. Used where pipes are not supported.
+  resultt dec_solve_using_files();
+
+  /// Return the command line that runs the solver on \p problem_file, or
+  /// on its standard input if \p problem_file is empty.
+  virtual std::vector<std::string>
+  solver_command(const std::string &problem_file) const;
+
+  /// Return true if the solver only reads problems from its standard input
+  bool solver_reads_stdin() const;
+
+  /// Solver process the problem is streamed to while it is being generated.
+  /// Streaming starts once the problem exceeds \ref streaming_threshold
+  /// characters, or when the solver is called. Each call to \ref dec_solve
+  /// uses up the process; later calls replay the problem to a new one.
+  std::unique_ptr<piped_processt> solver_process;
+
+  static const std::streamoff streaming_threshold = 1 << 20;
+
+  /// Keep the problem after sending it to the solver, so that it can be
+  /// replayed to a new solver process
+  bool keep_problem = true;
+
+  /// Start \ref solver_process and send all of the problem so far
+  void start_solver_process();
+
+  /// Send the part of the problem that has not been sent yet
+  void send_pending_problem();
 };
 
 #endif // CPROVER_SOLVERS_SMT2_SMT2_DEC_H
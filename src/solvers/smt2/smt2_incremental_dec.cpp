@@ -0,0 +1,177 @@
+/*******************************************************************\
+
+Module: Incremental SMT2 Solver Session
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Incremental SMT2 Solver Session
+
+#include "smt2_incremental_dec.h"
+
+#include <util/std_expr.h>
+
+#include <solvers/prop/literal_expr.h>
+
+#include "smt2irep.h"
+
+smt2_incremental_dect::smt2_incremental_dect(
+  const namespacet &_ns,
+  const std::string &_benchmark,
+  const std::string &_notes,
+  const std::string &_logic,
+  solvert _solver)
+  : smt2_dect(_ns, _benchmark, _notes, _logic, _solver)
+{
+  // the solver keeps what it has been sent
+  keep_problem = false;
+}
+
+bool smt2_incremental_dect::is_supported(solvert solver)
+{
+  return piped_processt::is_supported() &&
+         (solver == solvert::CVC4 || solver == solvert::YICES ||
+          solver == solvert::Z3);
+}
+
+std::string smt2_incremental_dect::decision_procedure_text() const
+{
+  return smt2_dect::decision_procedure_text() + " (incremental)";
+}
+
+std::vector<std::string>
+smt2_incremental_dect::solver_command(const std::string &problem_file) const
+{
+  std::vector<std::string> argv = smt2_dect::solver_command(problem_file);
+
+  if(solver == solvert::CVC4 || solver == solvert::YICES)
+    argv.insert(std::next(argv.begin()), "--incremental");
+
+  return argv;
+}
+
+void smt2_incremental_dect::set_to(const exprt &expr, bool value)
+{
+  if(assumption_stack.empty())
+  {
+    // We are in the root context.
+    smt2_dect::set_to(expr, value);
+  }
+  else
+  {
+    // We have a child context. We add context_literal ==> expr.
+    smt2_dect::set_to(
+      or_exprt(
+        literal_exprt(!assumption_stack.back()),
+        value ? expr : not_exprt(expr)),
+      true);
+  }
+}
+
+void smt2_incremental_dect::push()
+{
+  literalt context_literal = convert(symbol_exprt(
+    "smt2_incremental::context$" + std::to_string(context_literal_counter++),
+    bool_typet()));
+
+  assumption_stack.push_back(context_literal);
+  context_size_stack.push_back(1);
+}
+
+void smt2_incremental_dect::push(const std::vector<exprt> &assumptions)
+{
+  assumption_stack.reserve(assumption_stack.size() + assumptions.size());
+  for(const auto &assumption : assumptions)
+    assumption_stack.push_back(to_literal_expr(assumption).get_literal());
+  context_size_stack.push_back(assumptions.size());
+}
+
+void smt2_incremental_dect::pop()
+{
+  PRECONDITION(!context_size_stack.empty());
+  assumption_stack.resize(assumption_stack.size() - context_size_stack.back());
+  context_size_stack.pop_back();
+}
+
+optionalt<irept> smt2_incremental_dect::read_next_response()
+{
+  return smt2irep(solver_process->output(), get_message_handler());
+}
+
+decision_proceduret::resultt smt2_incremental_dect::dec_solve()
+{
+  ++number_of_solver_calls;
+
+  if(!solver_process)
+    start_solver_process();
+
+  if(!solver_process->started())
+  {
+    error() << "error running SMT2 solver" << eom;
+    return decision_proceduret::resultt::D_ERROR;
+  }
+
+  // pointer objects may have been added since object sizes were defined
+  const std::pair<std::size_t, std::size_t> object_sizes_state{
+    object_sizes.size(), pointer_logic.objects.size()};
+  if(object_sizes_state != defined_object_sizes)
+  {
+    for(const auto &object : object_sizes)
+      define_object_size(object.second, object.first);
+    defined_object_sizes = object_sizes_state;
+  }
+
+  bvt assumptions;
+  for(const literalt &l : assumption_stack)
+  {
+    if(l.is_false())
+      return decision_proceduret::resultt::D_UNSATISFIABLE;
+    if(!l.is_true())
+      assumptions.push_back(l);
+  }
+
+  if(assumptions.empty())
+    out << "(check-sat)\n";
+  else
+  {
+    out << "(check-sat-assuming (";
+    for(const literalt &l : assumptions)
+    {
+      out << ' ';
+      convert_literal(l);
+    }
+    out << "))\n";
+  }
+
+  send_pending_problem();
+  solver_process->input().flush();
+
+  resultt res = resultt::D_ERROR;
+  valuest values;
+
+  auto response = read_next_response();
+  if(!response.has_value() || !read_response(*response, res, values))
+    return decision_proceduret::resultt::D_ERROR;
+
+  if(res == resultt::D_SATISFIABLE)
+  {
+    for(const auto &id : smt2_identifiers)
+      out << "(get-value (|" << id << "|))\n";
+
+    send_pending_problem();
+    solver_process->input().flush();
+
+    for(std::size_t i = 0; i < smt2_identifiers.size(); ++i)
+    {
+      response = read_next_response();
+      if(!response.has_value() || !read_response(*response, res, values))
+        return decision_proceduret::resultt::D_ERROR;
+    }
+
+    set_assignment(values);
+  }
+
+  return res;
+}
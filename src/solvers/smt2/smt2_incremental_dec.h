@@ -0,0 +1,70 @@
+/*******************************************************************\
+
+Module: Incremental SMT2 Solver Session
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Incremental SMT2 Solver Session
+
+#ifndef CPROVER_SOLVERS_SMT2_SMT2_INCREMENTAL_DEC_H
+#define CPROVER_SOLVERS_SMT2_SMT2_INCREMENTAL_DEC_H
+
+#include <solvers/prop/literal.h>
+
+#include "smt2_dec.h"
+
+/// Decision procedure that keeps a single interactive SMT2 solver process
+/// for all calls. Each call only sends the assertions added since the
+/// previous one, followed by `check-sat-assuming` and `get-value` commands.
+///
+/// Contexts are implemented like in \ref prop_conv_solvert: \ref push()
+/// creates a fresh context literal, assertions made in a context are
+/// guarded by it, and the literals of all open contexts are passed to
+/// `check-sat-assuming`. Native SMT2 `push`/`pop` is not used, as `pop`
+/// would discard declarations that \ref smt2_convt does not emit again.
+class smt2_incremental_dect : public smt2_dect
+{
+public:
+  smt2_incremental_dect(
+    const namespacet &_ns,
+    const std::string &_benchmark,
+    const std::string &_notes,
+    const std::string &_logic,
+    solvert _solver);
+
+  /// Return true if \p solver can be used interactively
+  static bool is_supported(solvert solver);
+
+  resultt dec_solve() override;
+  std::string decision_procedure_text() const override;
+
+  void set_to(const exprt &expr, bool value) override;
+
+  void push() override;
+  void push(const std::vector<exprt> &assumptions) override;
+  void pop() override;
+
+protected:
+  std::vector<std::string>
+  solver_command(const std::string &problem_file) const override;
+
+  /// Read the next response of the solver
+  optionalt<irept> read_next_response();
+
+  /// Literals of all contexts, passed to `check-sat-assuming`
+  bvt assumption_stack;
+
+  /// Number of literals each context contributes to \ref assumption_stack
+  std::vector<std::size_t> context_size_stack;
+
+  std::size_t context_literal_counter = 0;
+
+  /// Number of object sizes and pointer objects when object sizes were last
+  /// defined
+  std::pair<std::size_t, std::size_t> defined_object_sizes{0, 0};
+};
+
+#endif // CPROVER_SOLVERS_SMT2_SMT2_INCREMENTAL_DEC_H
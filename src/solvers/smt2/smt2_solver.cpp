@@ -25,21 +25,34 @@ Author: Daniel Kroening, kroening@kroening.com
 class smt2_solvert:public smt2_parsert
 {
 public:
-  smt2_solvert(std::istream &_in, decision_proceduret &_solver)
+  smt2_solvert(std::istream &_in, stack_decision_proceduret &_solver)
     : smt2_parsert(_in), solver(_solver), status(NOT_SOLVED)
   {
     setup_commands();
   }
 
 protected:
-  decision_proceduret &solver;
+  stack_decision_proceduret &solver;
 
   void setup_commands();
   void define_constants();
   void expand_function_applications(exprt &);
+  void check_sat();
+  std::size_t optional_numeral();
 
   std::set<irep_idt> constants_done;
 
+  /// The identifiers of an enclosing assertion level, restored by `pop`;
+  /// the assertions of the level are retracted by popping the context of
+  /// the solver, which keeps everything it has learnt
+  struct assertion_levelt
+  {
+    id_mapt id_map;
+    named_termst named_terms;
+    std::set<irep_idt> constants_done;
+  };
+  std::vector<assertion_levelt> assertion_levels;
+
   enum
   {
     NOT_SOLVED,
@@ -119,6 +132,39 @@ void smt2_solvert::expand_function_applications(exprt &expr)
   }
 }
 
+void smt2_solvert::check_sat()
+{
+  // add constant definitions as constraints
+  define_constants();
+
+  switch(solver())
+  {
+  case decision_proceduret::resultt::D_SATISFIABLE:
+    std::cout << "sat\n";
+    status = SAT;
+    break;
+
+  case decision_proceduret::resultt::D_UNSATISFIABLE:
+    std::cout << "unsat\n";
+    status = UNSAT;
+    break;
+
+  case decision_proceduret::resultt::D_ERROR:
+    std::cout << "error\n";
+    status = NOT_SOLVED;
+  }
+}
+
+/// Read the numeral argument of `push` and `pop`, which defaults to one
+std::size_t smt2_solvert::optional_numeral()
+{
+  if(smt2_tokenizer.peek() != smt2_tokenizert::NUMERAL)
+    return 1;
+
+  next_token();
+  return std::stoul(smt2_tokenizer.get_buffer());
+}
+
 void smt2_solvert::setup_commands()
 {
   {
@@ -131,30 +177,59 @@ void smt2_solvert::setup_commands()
       }
     };
 
-    commands["check-sat"] = [this]() {
-      // add constant definitions as constraints
-      define_constants();
+    commands["check-sat"] = [this]() { check_sat(); };
+
+    commands["check-sat-assuming"] = [this]() {
+      if(next_token() != smt2_tokenizert::OPEN)
+        throw error("check-sat-assuming expects list as argument");
+
+      std::vector<exprt> assumptions;
 
-      switch(solver())
+      while(smt2_tokenizer.peek() != smt2_tokenizert::CLOSE &&
+            smt2_tokenizer.peek() != smt2_tokenizert::END_OF_FILE)
       {
-      case decision_proceduret::resultt::D_SATISFIABLE:
-        std::cout << "sat\n";
-        status = SAT;
-        break;
-
-      case decision_proceduret::resultt::D_UNSATISFIABLE:
-        std::cout << "unsat\n";
-        status = UNSAT;
-        break;
-
-      case decision_proceduret::resultt::D_ERROR:
-        std::cout << "error\n";
-        status = NOT_SOLVED;
+        exprt e = expression();
+        if(e.type().id() != ID_bool)
+          throw error("check-sat-assuming expects Boolean terms");
+        expand_function_applications(e);
+        assumptions.push_back(solver.handle(e));
       }
+
+      if(next_token() != smt2_tokenizert::CLOSE)
+        throw error("check-sat-assuming expects ')' at end of list");
+
+      // the assumptions only hold for this check
+      solver.push(assumptions);
+      check_sat();
+      solver.pop();
     };
 
-    commands["check-sat-assuming"] = [this]() {
-      throw error("not yet implemented");
+    commands["push"] = [this]() {
+      for(std::size_t n = optional_numeral(); n != 0; n--)
+      {
+        assertion_levels.push_back({id_map, named_terms, constants_done});
+        solver.push();
+      }
+
+      status = NOT_SOLVED;
+    };
+
+    commands["pop"] = [this]() {
+      std::size_t n = optional_numeral();
+
+      if(n > assertion_levels.size())
+        throw error() << "cannot pop " << n << " assertion levels";
+
+      for(; n != 0; n--)
+      {
+        solver.pop();
+        id_map = std::move(assertion_levels.back().id_map);
+        named_terms = std::move(assertion_levels.back().named_terms);
+        constants_done = std::move(assertion_levels.back().constants_done);
+        assertion_levels.pop_back();
+      }
+
+      status = NOT_SOLVED;
     };
 
     commands["display"] = [this]() {
@@ -325,8 +400,6 @@ void smt2_solvert::setup_commands()
     | ( get-proof )
     | ( get-unsat-assumptions )
     | ( get-unsat-core )
-    | ( pop hnumerali )
-    | ( push hnumerali )
     | ( reset )
     | ( reset-assertions )
     | ( set-info hattributei )
@@ -31,19 +31,11 @@ smt2_tokenizert::tokent smt2_tokenizert::get_simple_symbol()
 
   buffer.clear();
 
-  char ch;
-  while(in->get(ch))
+  for(int ch = in_buf->sgetc();
+      ch != eof && is_simple_symbol_character(static_cast<char>(ch));
+      ch = in_buf->snextc())
   {
-    if(is_simple_symbol_character(ch))
-    {
-      buffer+=ch;
-    }
-    else
-    {
-      in->unget(); // put back
-      quoted_symbol = false;
-      return SYMBOL;
-    }
+    buffer += static_cast<char>(ch);
   }
 
   // eof -- this is ok here
@@ -62,18 +54,10 @@ smt2_tokenizert::tokent smt2_tokenizert::get_decimal_numeral()
 
   buffer.clear();
 
-  char ch;
-  while(in->get(ch))
+  for(int ch = in_buf->sgetc(); ch != eof && (isdigit(ch) || ch == '.');
+      ch = in_buf->snextc())
   {
-    if(isdigit(ch) || ch=='.')
-    {
-      buffer+=ch;
-    }
-    else
-    {
-      in->unget(); // put back
-      return NUMERAL;
-    }
+    buffer += static_cast<char>(ch);
   }
 
   // eof -- this is ok here
@@ -91,25 +75,10 @@ smt2_tokenizert::tokent smt2_tokenizert::get_bin_numeral()
   buffer+='#';
   buffer+='b';
 
-  char ch;
-  while(in->get(ch))
-  {
-    if(ch=='0' || ch=='1')
-    {
-      buffer+=ch;
-    }
-    else
-    {
-      in->unget(); // put back
-      return NUMERAL;
-    }
-  }
+  for(int ch = in_buf->sgetc(); ch == '0' || ch == '1'; ch = in_buf->snextc())
+    buffer += static_cast<char>(ch);
 
-  // eof -- this is ok here
-  if(buffer.empty())
-    return END_OF_FILE;
-  else
-    return NUMERAL;
+  return NUMERAL;
 }
 
 smt2_tokenizert::tokent smt2_tokenizert::get_hex_numeral()
@@ -120,25 +89,13 @@ smt2_tokenizert::tokent smt2_tokenizert::get_hex_numeral()
   buffer+='#';
   buffer+='x';
 
-  char ch;
-  while(in->get(ch))
+  for(int ch = in_buf->sgetc(); ch != eof && isxdigit(ch);
+      ch = in_buf->snextc())
   {
-    if(isxdigit(ch))
-    {
-      buffer+=ch;
-    }
-    else
-    {
-      in->unget(); // put back
-      return NUMERAL;
-    }
+    buffer += static_cast<char>(ch);
   }
 
-  // eof -- this is ok here
-  if(buffer.empty())
-    return END_OF_FILE;
-  else
-    return NUMERAL;
+  return NUMERAL;
 }
 
 smt2_tokenizert::tokent smt2_tokenizert::get_quoted_symbol()
@@ -151,7 +108,7 @@ smt2_tokenizert::tokent smt2_tokenizert::get_quoted_symbol()
   buffer.clear();
 
   char ch;
-  while(in->get(ch))
+  while(get_char(ch))
   {
     if(ch=='|')
     {
@@ -174,22 +131,13 @@ smt2_tokenizert::tokent smt2_tokenizert::get_string_literal()
   buffer.clear();
 
   char ch;
-  while(in->get(ch))
+  while(get_char(ch))
   {
     if(ch=='"')
     {
       // quotes may be escaped by repeating
-      if(in->get(ch))
-      {
-        if(ch=='"')
-        {
-        }
-        else
-        {
-          in->unget();
-          return STRING_LITERAL; // done
-        }
-      }
+      if(in_buf->sgetc() == '"')
+        in_buf->sbumpc();
       else
         return STRING_LITERAL; // done
     }
@@ -212,10 +160,24 @@ smt2_tokenizert::tokent smt2_tokenizert::next_token()
 
 void smt2_tokenizert::get_token_from_stream()
 {
-  char ch;
-
-  while(in->get(ch))
+  for(int c = in_buf->sgetc(); c != eof; c = in_buf->sgetc())
   {
+    char ch = static_cast<char>(c);
+
+    // numerals and simple symbols are read from their first character
+    if(isdigit(ch))
+    {
+      token = get_decimal_numeral();
+      return;
+    }
+    else if(is_simple_symbol_character(ch))
+    {
+      token = get_simple_symbol();
+      return;
+    }
+
+    in_buf->sbumpc();
+
     switch(ch)
     {
     case '\n':
@@ -231,7 +193,7 @@ void smt2_tokenizert::get_token_from_stream()
 
     case ';': // comment
       // skip until newline
-      while(in->get(ch))
+      while(get_char(ch))
       {
         if(ch=='\n')
         {
@@ -270,7 +232,7 @@ void smt2_tokenizert::get_token_from_stream()
         throw error("expecting symbol after colon");
 
     case '#':
-      if(in->get(ch))
+      if(get_char(ch))
       {
         if(ch=='b')
         {
@@ -289,24 +251,9 @@ void smt2_tokenizert::get_token_from_stream()
         throw error("unexpected EOF in numeral token");
       break;
 
-    default: // likely a simple symbol or a numeral
-      if(isdigit(ch))
-      {
-        in->unget();
-        token = get_decimal_numeral();
-        return;
-      }
-      else if(is_simple_symbol_character(ch))
-      {
-        in->unget();
-        token = get_simple_symbol();
-        return;
-      }
-      else
-      {
-        // illegal character, error
-        throw error() << "unexpected character '" << ch << '\'';
-      }
+    default:
+      // illegal character, error
+      throw error() << "unexpected character '" << ch << '\'';
     }
   }
 
@@ -12,6 +12,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/exception_utils.h>
 
 #include <sstream>
+#include <streambuf>
 #include <string>
 
 class smt2_tokenizert
@@ -20,6 +21,7 @@ public:
   explicit smt2_tokenizert(std::istream &_in) : peeked(false), token(NONE)
   {
     in=&_in;
+    in_buf = _in.rdbuf();
     line_no=1;
   }
 
@@ -105,6 +107,10 @@ public:
 
 protected:
   std::istream *in;
+  /// The characters are read from the buffer of \ref in directly, which
+  /// avoids the sentry and state handling of std::istream::get for each
+  /// of them.
+  std::streambuf *in_buf;
   unsigned line_no;
   std::string buffer;
   bool quoted_symbol = false;
@@ -116,6 +122,17 @@ protected:
   void skip_to_end_of_list();
 
 private:
+  static constexpr int eof = std::char_traits<char>::eof();
+
+  bool get_char(char &ch)
+  {
+    const int c = in_buf->sbumpc();
+    if(c == eof)
+      return false;
+    ch = static_cast<char>(c);
+    return true;
+  }
+
   tokent get_decimal_numeral();
   tokent get_hex_numeral();
   tokent get_bin_numeral();
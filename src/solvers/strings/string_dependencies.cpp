@@ -130,6 +130,8 @@ void string_dependenciest::clear()
   builtin_function_nodes.clear();
   string_nodes.clear();
   node_index_pool.clear();
+  nodes_with_constraints.clear();
+  nodes_with_length_constraint.clear();
   clean_cache();
 }
 
@@ -345,14 +347,20 @@ void string_dependenciest::output_dot(std::ostream &stream) const
   stream << '}' << std::endl;
 }
 
-string_constraintst
-string_dependenciest::add_constraints(string_constraint_generatort &generator)
+string_constraintst string_dependenciest::add_constraints(
+  string_constraint_generatort &generator,
+  const std::function<bool(const exprt &)> &is_relevant_result)
 {
   std::unordered_set<nodet, node_hash> test_dependencies;
   for(const auto &builtin : builtin_function_nodes)
   {
-    if(builtin.data->maybe_testing_function())
+    if(
+      builtin.data->maybe_testing_function() &&
+      (builtin.data->string_result().has_value() ||
+       is_relevant_result(builtin.data->return_code)))
+    {
       test_dependencies.insert(nodet(builtin));
+    }
   }
 
   get_reachable(
@@ -366,12 +374,16 @@ string_dependenciest::add_constraints(string_constraint_generatort &generator)
   string_constraintst constraints;
   for(const auto &node : builtin_function_nodes)
   {
+    if(nodes_with_constraints.count(node.index))
+      continue;
+
     if(test_dependencies.count(nodet(node)))
     {
       const auto &builtin = builtin_function_nodes[node.index];
       merge(constraints, builtin.data->constraints(generator));
+      nodes_with_constraints.insert(node.index);
     }
-    else
+    else if(nodes_with_length_constraint.insert(node.index).second)
       constraints.existential.push_back(node.data->length_constraint());
   }
   return constraints;
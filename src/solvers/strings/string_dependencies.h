@@ -13,6 +13,7 @@ Author: Diffblue Ltd.
 #define CPROVER_SOLVERS_STRINGS_STRING_DEPENDENCIES_H
 
 #include <memory>
+#include <unordered_set>
 
 #include <util/nodiscard.h>
 
@@ -115,8 +116,14 @@ public:
   /// For all builtin call on which a test (or an unsupported buitin)
   /// result depends, add the corresponding constraints. For the other builtin
   /// only add constraints on the length.
-  NODISCARD string_constraintst
-  add_constraints(string_constraint_generatort &generatort);
+  /// Tests that do not produce a string and whose return code does not
+  /// satisfy \p is_relevant_result are not considered, as the properties do
+  /// not depend on their result.
+  /// Constraints that were returned by a previous call are not returned again.
+  NODISCARD string_constraintst add_constraints(
+    string_constraint_generatort &generatort,
+    const std::function<bool(const exprt &)> &is_relevant_result =
+      [](const exprt &) { return true; });
 
   /// Clear the content of the dependency graph
   void clear();
@@ -133,6 +140,11 @@ private:
   std::unordered_map<array_string_exprt, std::size_t, irep_hash>
     node_index_pool;
 
+  /// Indexes of the builtin function nodes for which `add_constraints` already
+  /// returned all constraints, or only the length constraint
+  std::unordered_set<std::size_t> nodes_with_constraints;
+  std::unordered_set<std::size_t> nodes_with_length_constraint;
+
   class nodet
   {
   public:
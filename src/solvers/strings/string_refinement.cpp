@@ -19,6 +19,7 @@ Author: Alberto Griggio, alberto.griggio@gmail.com
 
 #include "string_refinement.h"
 
+#include <chrono>
 #include <iomanip>
 #include <numeric>
 #include <solvers/sat/satcheck.h>
@@ -99,6 +100,11 @@ static void update_index_set(
   const namespacet &ns,
   const exprt &formula);
 
+static void add_bounded_indices(
+  index_set_pairt &index_set,
+  const namespacet &ns,
+  std::size_t bound);
+
 static std::vector<exprt> instantiate(
   const string_not_contains_constraintt &axiom,
   const index_set_pairt &index_set,
@@ -156,7 +162,6 @@ static bool validate(const string_refinementt::infot &info)
 string_refinementt::string_refinementt(const infot &info, bool)
   : supert(info),
     config_(info),
-    loop_bound_(info.refinement_bound),
     generator(*info.ns)
 {
 }
@@ -216,25 +221,48 @@ display_index_set(messaget::mstreamt &stream, const index_set_pairt &index_set)
 // NOLINTNEXTLINE(whitespace/line_length)
 ///     (See `instantiate(const string_not_contains_constraintt&,const index_set_pairt&,const std::map<string_not_contains_constraintt, symbol_exprt>&)`
 ///      for details)
+///
+/// Axioms at positions from \p first_new_universal and
+/// \p first_new_not_contains on are instantiated with all the indices of the
+/// index set, the other ones only with the indices that are newly added.
 static std::vector<exprt> generate_instantiations(
   const index_set_pairt &index_set,
   const string_axiomst &axioms,
+  std::size_t first_new_universal,
+  std::size_t first_new_not_contains,
   const std::unordered_map<string_not_contains_constraintt, symbol_exprt>
     &not_contain_witnesses)
 {
   std::vector<exprt> lemmas;
-  for(const auto &i : index_set.current)
+  for(std::size_t n = 0; n < axioms.universal.size(); ++n)
   {
-    for(const auto &univ_axiom : axioms.universal)
+    // Axioms that have been instantiated before only need to be instantiated
+    // with the new indices
+    const auto &indices =
+      n < first_new_universal ? index_set.current : index_set.cumulative;
+    for(const auto &i : indices)
     {
       for(const auto &j : i.second)
-        lemmas.push_back(instantiate(univ_axiom, i.first, j));
+        lemmas.push_back(instantiate(axioms.universal[n], i.first, j));
     }
   }
-  for(const auto &nc_axiom : axioms.not_contains)
+  if(first_new_not_contains < axioms.not_contains.size())
+  {
+    const index_set_pairt all_indices{index_set.cumulative,
+                                      index_set.cumulative};
+    for(std::size_t n = first_new_not_contains;
+        n < axioms.not_contains.size();
+        ++n)
+    {
+      for(const auto &instance : instantiate(
+            axioms.not_contains[n], all_indices, not_contain_witnesses))
+        lemmas.push_back(instance);
+    }
+  }
+  for(std::size_t n = 0; n < first_new_not_contains; ++n)
   {
     for(const auto &instance :
-        instantiate(nc_axiom, index_set, not_contain_witnesses))
+        instantiate(axioms.not_contains[n], index_set, not_contain_witnesses))
       lemmas.push_back(instance);
   }
   return lemmas;
@@ -279,6 +307,46 @@ replace_expr_copy(const union_find_replacet &symbol_resolve, exprt expr)
 /// the boolean is true and false otherwise.
 /// \param expr: an expression of type `bool`
 /// \param value: the boolean value to set it to
+exprt string_refinementt::handle(const exprt &expr)
+{
+  find_symbols_or_nexts(expr, relevance_roots);
+  return supert::handle(expr);
+}
+
+/// The symbols that the relevance roots depend on through the definitions.
+/// Symbols with several definitions are roots themselves, as their
+/// definitions constrain each other.
+find_symbols_sett string_refinementt::relevant_symbols() const
+{
+  find_symbols_sett relevant = relevance_roots;
+  for(const auto &definition : definitions)
+  {
+    if(definitions.count(definition.first) > 1)
+      relevant.insert(definition.first);
+  }
+
+  std::vector<irep_idt> worklist(relevant.begin(), relevant.end());
+  while(!worklist.empty())
+  {
+    const irep_idt symbol = worklist.back();
+    worklist.pop_back();
+
+    const auto range = definitions.equal_range(symbol);
+    for(auto it = range.first; it != range.second; ++it)
+    {
+      find_symbols_sett read;
+      find_symbols_or_nexts(it->second, read);
+      for(const auto &identifier : read)
+      {
+        if(relevant.insert(identifier).second)
+          worklist.push_back(identifier);
+      }
+    }
+  }
+
+  return relevant;
+}
+
 void string_refinementt::set_to(const exprt &expr, bool value)
 {
   PRECONDITION(expr.type().id() == ID_bool);
@@ -600,9 +668,15 @@ output_equations(std::ostream &output, const std::vector<exprt> &equations)
 ///   return ERROR;
 /// }
 /// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+///
+/// When called again after more constraints were added, for instance when
+/// properties are checked one after the other, the lemmas, the index set and
+/// the quantified axioms of the previous calls are kept. Only the axioms that
+/// are new are then instantiated with the whole index set, and the other ones
+/// with the indices that are new.
 /// \return `resultt::D_SATISFIABLE` if the constraints are satisfiable,
 ///   `resultt::D_UNSATISFIABLE` if they are unsatisfiable,
-///   `resultt::D_ERROR` if the limit of iteration was reached.
+///   `resultt::D_ERROR` if the limit of iterations or time was reached.
 decision_proceduret::resultt string_refinementt::dec_solve()
 {
 #ifdef DEBUG
@@ -695,6 +769,18 @@ decision_proceduret::resultt string_refinementt::dec_solve()
       local_equations.push_back(*new_equation);
     else
       local_equations.push_back(eq);
+
+    const exprt &local_equation = local_equations.back();
+    if(
+      can_cast_expr<equal_exprt>(local_equation) &&
+      to_equal_expr(local_equation).lhs().id() == ID_symbol)
+    {
+      const equal_exprt &definition = to_equal_expr(local_equation);
+      definitions.emplace(
+        to_symbol_expr(definition.lhs()).get_identifier(), definition.rhs());
+    }
+    else
+      find_symbols_or_nexts(local_equation, relevance_roots);
   }
   equations.clear();
 
@@ -703,7 +789,13 @@ decision_proceduret::resultt string_refinementt::dec_solve()
 #endif
 
   log.debug() << "dec_solve: add constraints" << messaget::eom;
-  merge(constraints, dependencies.add_constraints(generator));
+  const find_symbols_sett relevant = relevant_symbols();
+  merge(
+    constraints,
+    dependencies.add_constraints(generator, [&](const exprt &return_code) {
+      return return_code.id() != ID_symbol ||
+             relevant.count(to_symbol_expr(return_code).get_identifier()) != 0;
+    }));
 
 #ifdef DEBUG
   output_equations(log.debug(), equations);
@@ -750,10 +842,10 @@ decision_proceduret::resultt string_refinementt::dec_solve()
     });
 
   // Used to store information about witnesses for not_contains constraints
-  std::unordered_map<string_not_contains_constraintt, symbol_exprt>
-    not_contain_witnesses;
   for(const auto &nc_axiom : axioms.not_contains)
   {
+    if(not_contain_witnesses.count(nc_axiom))
+      continue;
     const auto &witness_type = [&] {
       const auto &rtype = to_array_type(nc_axiom.s0.type());
       const typet &index_type = rtype.size().type();
@@ -776,6 +868,31 @@ decision_proceduret::resultt string_refinementt::dec_solve()
       binary_relation_exprt{length, ID_ge, from_integer(0, length.type())});
   }
 
+  const auto start_time = std::chrono::steady_clock::now();
+  const statisticst statistics_before = statistics;
+  const auto finish = [&](resultt result) {
+    const std::chrono::duration<double> solve_time =
+      std::chrono::steady_clock::now() - start_time;
+    std::size_t indices = 0;
+    for(const auto &i : index_sets.cumulative)
+      indices += i.second.size();
+    log.statistics() << "String refinement: "
+                     << statistics.rounds - statistics_before.rounds
+                     << " rounds, "
+                     << statistics.lemmas - statistics_before.lemmas
+                     << " lemmas ("
+                     << statistics.instances - statistics_before.instances
+                     << " instances of "
+                     << axioms.universal.size() + axioms.not_contains.size()
+                     << " quantified axioms), " << indices
+                     << " indices, " << solve_time.count() << "s"
+                     << messaget::eom;
+    log.statistics() << "String refinement in total: " << statistics.rounds
+                     << " rounds, " << statistics.lemmas << " lemmas"
+                     << messaget::eom;
+    return result;
+  };
+
   // Initial try without index set
   const auto get = [this](const exprt &expr) { return this->get(expr); };
   dependencies.clean_cache();
@@ -796,7 +913,7 @@ decision_proceduret::resultt string_refinementt::dec_solve()
     if(satisfied)
     {
       log.debug() << "check_SAT: the model is correct" << messaget::eom;
-      return resultt::D_SATISFIABLE;
+      return finish(resultt::D_SATISFIABLE);
     }
     log.debug() << "check_SAT: got SAT but the model is not correct"
                 << messaget::eom;
@@ -804,21 +921,41 @@ decision_proceduret::resultt string_refinementt::dec_solve()
   else
   {
     log.debug() << "check_SAT: got UNSAT or ERROR" << messaget::eom;
-    return initial_result;
+    return finish(initial_result);
   }
 
-  initial_index_set(index_sets, ns, axioms);
+  // Indices and lemmas of previous calls are kept: only the axioms added by
+  // this call contribute initial indices, and the indices that were added in
+  // the last round of a previous call have already been instantiated.
+  index_sets.current.clear();
+  string_axiomst new_axioms;
+  new_axioms.universal.assign(
+    std::next(axioms.universal.begin(), instantiated_universal_axioms),
+    axioms.universal.end());
+  new_axioms.not_contains.assign(
+    std::next(axioms.not_contains.begin(), instantiated_not_contains_axioms),
+    axioms.not_contains.end());
+  initial_index_set(index_sets, ns, new_axioms);
   update_index_set(index_sets, ns, current_constraints);
   current_constraints.clear();
-  const auto initial_instances =
-    generate_instantiations(index_sets, axioms, not_contain_witnesses);
-  for(const auto &instance : initial_instances)
-  {
-    add_lemma(substitute_array_access(instance, generator.fresh_symbol, true));
-  }
+  if(config_.eager_instantiation_bound != 0)
+    add_bounded_indices(index_sets, ns, config_.eager_instantiation_bound);
+  instantiate_axioms();
 
-  while((loop_bound_--) > 0)
+  for(std::size_t rounds = 0; rounds < config_.refinement_bound; ++rounds)
   {
+    if(config_.refinement_time_limit != 0)
+    {
+      const auto elapsed = std::chrono::steady_clock::now() - start_time;
+      if(elapsed >= std::chrono::seconds(config_.refinement_time_limit))
+      {
+        log.debug() << "string_refinementt::dec_solve reached the time limit"
+                    << messaget::eom;
+        return finish(resultt::D_ERROR);
+      }
+    }
+
+    ++statistics.rounds;
     dependencies.clean_cache();
     const decision_proceduret::resultt refined_result = supert::dec_solve();
 
@@ -838,7 +975,7 @@ decision_proceduret::resultt string_refinementt::dec_solve()
       if(satisfied)
       {
         log.debug() << "check_SAT: the model is correct" << messaget::eom;
-        return resultt::D_SATISFIABLE;
+        return finish(resultt::D_SATISFIABLE);
       }
 
       log.debug()
@@ -860,7 +997,7 @@ decision_proceduret::resultt string_refinementt::dec_solve()
         {
           log.error() << "dec_solve: current index set is empty, "
                       << "this should not happen" << messaget::eom;
-          return resultt::D_ERROR;
+          return finish(resultt::D_ERROR);
         }
         else
         {
@@ -871,23 +1008,39 @@ decision_proceduret::resultt string_refinementt::dec_solve()
         }
       }
       current_constraints.clear();
-      const auto instances =
-        generate_instantiations(index_sets, axioms, not_contain_witnesses);
-      for(const auto &instance : instances)
-        add_lemma(
-          substitute_array_access(instance, generator.fresh_symbol, true));
+      instantiate_axioms();
     }
     else
     {
       log.debug() << "check_SAT: default return "
                   << static_cast<int>(refined_result) << messaget::eom;
-      return refined_result;
+      return finish(refined_result);
     }
   }
   log.debug() << "string_refinementt::dec_solve reached the maximum number"
               << "of steps allowed" << messaget::eom;
-  return resultt::D_ERROR;
+  return finish(resultt::D_ERROR);
 }
+
+/// Instantiate the axioms with the indices of the index set, see
+/// `generate_instantiations`, and add the instances as lemmas. Afterwards, all
+/// axioms count as instantiated with the indices of the index set.
+void string_refinementt::instantiate_axioms()
+{
+  const auto instances = generate_instantiations(
+    index_sets,
+    axioms,
+    instantiated_universal_axioms,
+    instantiated_not_contains_axioms,
+    not_contain_witnesses);
+  instantiated_universal_axioms = axioms.universal.size();
+  instantiated_not_contains_axioms = axioms.not_contains.size();
+  statistics.instances += instances.size();
+
+  for(const auto &instance : instances)
+    add_lemma(substitute_array_access(instance, generator.fresh_symbol, true));
+}
+
 /// Add the given lemma to the solver.
 /// \param lemma: a Boolean expression
 /// \param simplify_lemma: whether the lemma should be simplified before being
@@ -899,6 +1052,7 @@ void string_refinementt::add_lemma(
   if(!seen_instances.insert(lemma).second)
     return;
 
+  ++statistics.lemmas;
   current_constraints.push_back(lemma);
 
   exprt simple_lemma = lemma;
@@ -1583,6 +1737,32 @@ static void add_to_index_set(
   }
 }
 
+/// Add the indices from 0 to \p bound - 1 to the index set of each array in
+/// \p index_set. When the strings are no longer than \p bound, instantiating
+/// the axioms with these indices gives all the lemmas that refinement could
+/// find, so that no refinement round has to discover indices one by one.
+/// \param index_set: the index set to extend
+/// \param ns: namespace
+/// \param bound: the number of indices to add
+static void add_bounded_indices(
+  index_set_pairt &index_set,
+  const namespacet &ns,
+  std::size_t bound)
+{
+  std::vector<exprt> arrays;
+  for(const auto &pair : index_set.cumulative)
+    arrays.push_back(pair.first);
+
+  for(const exprt &s : arrays)
+  {
+    if(s.type().id() != ID_array)
+      continue;
+    const typet &index_type = to_array_type(s.type()).size().type();
+    for(std::size_t j = 0; j < bound; ++j)
+      add_to_index_set(index_set, ns, s, from_integer(j, index_type));
+  }
+}
+
 /// Given an array access of the form \a s[i] assumed to be part of a formula
 /// \f$ \forall q < u. charconstraint \f$, initialize the index set of \a s
 /// so that:
@@ -21,6 +21,7 @@ Author: Alberto Griggio, alberto.griggio@gmail.com
 #define CPROVER_SOLVERS_REFINEMENT_STRING_REFINEMENT_H
 
 #include <limits>
+#include <util/find_symbols.h>
 #include <util/magic.h>
 #include <util/replace_expr.h>
 #include <util/string_expr.h>
@@ -38,7 +39,9 @@ Author: Alberto Griggio, alberto.griggio@gmail.com
   "(string-printable)" \
   "(string-input-value):" \
   "(string-non-empty)" \
-  "(max-nondet-string-length):"
+  "(max-nondet-string-length):" \
+  "(max-string-refinement-rounds):" \
+  "(string-refinement-time-limit):"
 
 #define HELP_STRING_REFINEMENT \
   " --no-refine-strings          turn off string refinement\n" \
@@ -50,7 +53,15 @@ Author: Alberto Griggio, alberto.griggio@gmail.com
   " --max-nondet-string-length n bound the length of nondet (e.g. input) strings.\n" /* NOLINT(*) */ \
   "                              Default is " + std::to_string(MAX_CONCRETE_STRING_SIZE - 1) + "; note that\n" /* NOLINT(*) */ \
   "                              setting the value higher than this does not work\n" /* NOLINT(*) */ \
-  "                              with --trace or --validate-trace.\n" /* NOLINT(*) */
+  "                              with --trace or --validate-trace.\n" /* NOLINT(*) */ \
+  "                              For n up to " + std::to_string(MAX_EAGER_STRING_INSTANTIATION_LENGTH) + ", string constraints are\n" /* NOLINT(*) */ \
+  "                              instantiated for all positions up front.\n" /* NOLINT(*) */ \
+  " --max-string-refinement-rounds n\n" \
+  "                              give up on a check after n rounds of\n" /* NOLINT(*) */ \
+  "                              instantiating string constraints\n" /* NOLINT(*) */ \
+  " --string-refinement-time-limit s\n" \
+  "                              give up on a check after instantiating string\n" /* NOLINT(*) */ \
+  "                              constraints for s seconds\n" /* NOLINT(*) */
 
 // The integration of the string solver into CBMC is incomplete. Therefore,
 // it is not turned on by default and not all options are available.
@@ -70,7 +81,14 @@ class string_refinementt final : public bv_refinementt
 private:
   struct configt
   {
+    /// Maximal number of refinement rounds in each call to `dec_solve`
     std::size_t refinement_bound = 0;
+    /// Maximal number of seconds spent in the refinement rounds of each call
+    /// to `dec_solve`, or 0 for no limit
+    std::size_t refinement_time_limit = 0;
+    /// If not 0, quantified constraints are instantiated with all indices
+    /// below this bound before the first refinement round
+    std::size_t eager_instantiation_bound = 0;
     bool use_counter_example = true;
   };
 
@@ -88,6 +106,7 @@ public:
   }
 
   exprt get(const exprt &expr) const override;
+  exprt handle(const exprt &expr) override;
   void set_to(const exprt &expr, bool value) override;
   decision_proceduret::resultt dec_solve() override;
 
@@ -98,7 +117,6 @@ private:
   string_refinementt(const infot &, bool);
 
   const configt config_;
-  std::size_t loop_bound_;
   string_constraint_generatort generator;
 
   // Simple constraints that have been given to the solver
@@ -106,6 +124,37 @@ private:
 
   string_axiomst axioms;
 
+  // Number of axioms of each kind at the beginning of `axioms` that have been
+  // instantiated with all indices of the index set so far. The axioms that
+  // follow them were added by the current call to `dec_solve`.
+  std::size_t instantiated_universal_axioms = 0;
+  std::size_t instantiated_not_contains_axioms = 0;
+
+  // Symbols read by the expressions given to `handle`, such as properties,
+  // and by the equations that do not define a symbol. The builtin functions
+  // that are tests only need constraints if these depend on their result.
+  find_symbols_sett relevance_roots;
+
+  // Right-hand sides of the equations `symbol = rhs`, for each symbol
+  std::unordered_multimap<irep_idt, exprt> definitions;
+
+  find_symbols_sett relevant_symbols() const;
+
+  // Witnesses of the not_contains axioms, which are kept between calls to
+  // `dec_solve` so that earlier instances stay relevant
+  std::unordered_map<string_not_contains_constraintt, symbol_exprt>
+    not_contain_witnesses;
+
+  struct statisticst
+  {
+    std::size_t rounds = 0;
+    std::size_t lemmas = 0;
+    std::size_t instances = 0;
+  };
+
+  // Totals over all calls to `dec_solve`
+  statisticst statistics;
+
   // Unquantified lemmas that have newly been added
   std::vector<exprt> current_constraints;
 
@@ -120,6 +169,7 @@ private:
   string_dependenciest dependencies;
 
   void add_lemma(const exprt &lemma, bool simplify_lemma = true);
+  void instantiate_axioms();
 };
 
 exprt substitute_array_lists(exprt expr, std::size_t string_max_length);
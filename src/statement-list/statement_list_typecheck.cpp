@@ -12,8 +12,15 @@ Author: Matthias Weiss, matthias.weiss@diffblue.com
 #include "statement_list_typecheck.h"
 #include "converters/statement_list_types.h"
 
+#include <algorithm>
 #include <iostream>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <util/forked_workers.h>
 #include <util/ieee_float.h>
+#include <util/irep_hash.h>
+#include <util/irep_serialization.h>
 #include <util/message.h>
 #include <util/namespace.h>
 #include <util/simplify_expr.h>
@@ -35,6 +42,9 @@ Author: Matthias Weiss, matthias.weiss@diffblue.com
 #define CPROVER_ASSUME CPROVER_PREFIX "assume"
 /// Name of the RLO symbol used in some operations.
 #define CPROVER_TEMP_RLO CPROVER_PREFIX "temp_rlo"
+/// Minimum number of TIA modules per worker when generating their bodies in
+/// parallel, to amortise the cost of the workers.
+#define STATEMENT_LIST_MODULES_PER_WORKER 64
 
 /// Creates the artificial data block parameter with a generic name and the
 /// specified type.
@@ -100,16 +110,163 @@ void statement_list_typecheckt::typecheck()
   add_temp_rlo();
 
   // Iterate through all networks to generate the function bodies.
+  std::vector<const statement_list_parse_treet::tia_modulet *> tia_modules;
   for(const statement_list_parse_treet::function_blockt &fb :
       parse_tree.function_blocks)
+    tia_modules.push_back(&fb);
+  for(const statement_list_parse_treet::functiont &fc : parse_tree.functions)
+    tia_modules.push_back(&fc);
+  typecheck_tia_module_bodies(tia_modules);
+}
+
+/// Bodies of TIA modules converted before in this process, by the hash of the
+/// module and of the declarations it was checked against. They are reused
+/// when a project is loaded again, for example by a long-running server after
+/// a change to some of its blocks.
+static std::unordered_map<std::size_t, exprt> &converted_tia_module_bodies()
+{
+  static std::unordered_map<std::size_t, exprt> bodies;
+  return bodies;
+}
+
+/// Hash of everything the body of \p tia_module is generated from, including
+/// source locations.
+static std::size_t
+tia_module_hash(const statement_list_parse_treet::tia_modulet &tia_module)
+{
+  std::size_t hash = std::hash<irep_idt>{}(tia_module.name);
+  for(const auto &declaration : tia_module.var_temp)
+    hash = hash_combine(hash, declaration.variable.full_hash());
+  for(const auto &network : tia_module.networks)
   {
-    symbolt &fb_sym{symbol_table.get_writeable_ref(fb.name)};
-    typecheck_statement_list_networks(fb, fb_sym);
+    hash = hash_combine(hash, network.instructions.size());
+    for(const auto &instruction : network.instructions)
+    {
+      for(const codet &token : instruction.tokens)
+        hash = hash_combine(hash, token.full_hash());
+    }
   }
-  for(const statement_list_parse_treet::functiont &fc : parse_tree.functions)
+  return hash;
+}
+
+std::size_t statement_list_typecheckt::declarations_hash() const
+{
+  // independent of the order of the symbols
+  std::size_t hash = 0;
+  for(const auto &symbol_pair : symbol_table.symbols)
   {
-    symbolt &function_sym{symbol_table.get_writeable_ref(fc.name)};
-    typecheck_statement_list_networks(fc, function_sym);
+    hash += hash_combine(
+      std::hash<irep_idt>{}(symbol_pair.first),
+      symbol_pair.second.type.hash());
+  }
+  return hash;
+}
+
+void statement_list_typecheckt::typecheck_tia_module_bodies(
+  const std::vector<const statement_list_parse_treet::tia_modulet *>
+    &tia_modules)
+{
+  const std::size_t declarations = declarations_hash();
+  auto &converted_bodies = converted_tia_module_bodies();
+
+  // the modules whose bodies need to be generated, with their hashes
+  std::vector<std::pair<const statement_list_parse_treet::tia_modulet *,
+                        std::size_t>>
+    todo;
+
+  for(const auto tia_module : tia_modules)
+  {
+    // Leave value empty if there are no networks to iterate through.
+    if(tia_module->networks.empty())
+      continue;
+
+    symbolt &tia_symbol{symbol_table.get_writeable_ref(tia_module->name)};
+    if(tia_symbol.value.is_nil())
+      tia_symbol.value = code_blockt{};
+    typecheck_temp_var_decls(*tia_module, tia_symbol);
+
+    const std::size_t hash =
+      hash_combine(declarations, tia_module_hash(*tia_module));
+    const auto body_it = converted_bodies.find(hash);
+    if(body_it != converted_bodies.end())
+      tia_symbol.value = body_it->second;
+    else
+      todo.emplace_back(tia_module, hash);
+  }
+
+  const std::size_t number_of_workers = std::min<std::size_t>(
+    std::thread::hardware_concurrency(),
+    todo.size() / STATEMENT_LIST_MODULES_PER_WORKER);
+
+  bool converted = false;
+
+  if(number_of_workers > 1 && forked_workers_supported())
+  {
+    const unsigned verbosity = get_message_handler().get_verbosity();
+
+    const auto results = run_forked_workers(
+      number_of_workers, [&](std::size_t worker) -> std::string {
+        // errors are reported when the parent checks the modules again
+        get_message_handler().set_verbosity(0);
+
+        std::ostringstream out;
+        irep_serializationt::ireps_containert ireps_container;
+        irep_serializationt serializer(ireps_container);
+
+        try
+        {
+          for(std::size_t i = worker; i < todo.size(); i += number_of_workers)
+          {
+            symbolt &tia_symbol{
+              symbol_table.get_writeable_ref(todo[i].first->name)};
+            typecheck_statement_list_networks(*todo[i].first, tia_symbol);
+            serializer.reference_convert(tia_symbol.value, out);
+          }
+        }
+        catch(...)
+        {
+          return "";
+        }
+
+        return out.str();
+      });
+
+    get_message_handler().set_verbosity(verbosity);
+
+    converted = std::all_of(
+      results.begin(), results.end(), [](const optionalt<std::string> &r) {
+        return r.has_value() && !r->empty();
+      });
+
+    for(std::size_t worker = 0; converted && worker < number_of_workers;
+        ++worker)
+    {
+      std::istringstream in(*results[worker]);
+      irep_serializationt::ireps_containert ireps_container;
+      irep_serializationt serializer(ireps_container);
+
+      for(std::size_t i = worker; i < todo.size(); i += number_of_workers)
+      {
+        symbol_table.get_writeable_ref(todo[i].first->name).value =
+          static_cast<const exprt &>(serializer.reference_convert(in));
+      }
+    }
+  }
+
+  if(!converted)
+  {
+    for(const auto &module_hash : todo)
+    {
+      symbolt &tia_symbol{
+        symbol_table.get_writeable_ref(module_hash.first->name)};
+      typecheck_statement_list_networks(*module_hash.first, tia_symbol);
+    }
+  }
+
+  for(const auto &module_hash : todo)
+  {
+    converted_bodies[module_hash.second] =
+      symbol_table.lookup_ref(module_hash.first->name).value;
   }
 }
 
@@ -299,13 +456,12 @@ void statement_list_typecheckt::typecheck_statement_list_networks(
   const statement_list_parse_treet::tia_modulet &tia_module,
   symbolt &tia_symbol)
 {
-  // Leave value empty if there are no networks to iterate through.
-  if(tia_module.networks.empty())
-    return;
-  if(tia_symbol.value.is_nil())
-    tia_symbol.value = code_blockt{};
-
-  typecheck_temp_var_decls(tia_module, tia_symbol);
+  // Each module starts from a clean state, such that its body does not depend
+  // on the modules converted before, which may happen in another worker.
+  accumulator.clear();
+  nesting_stack.clear();
+  fc_bit = false;
+  or_bit = false;
 
   for(const auto &network : tia_module.networks)
   {
@@ -174,8 +174,23 @@ private:
     const statement_list_parse_treet::tia_modulet &tia_module,
     symbolt &tia_symbol);
 
+  /// Generates the bodies of the given TIA modules after their declarations
+  /// have been added to the symbol table. Bodies converted before in this
+  /// process against the same declarations are reused, and if there are
+  /// many others, they are generated in parallel by forked workers.
+  /// \param tia_modules: Modules whose bodies shall be generated.
+  void typecheck_tia_module_bodies(
+    const std::vector<const statement_list_parse_treet::tia_modulet *>
+      &tia_modules);
+
+  /// Computes a hash of the names and types of all symbols in the symbol
+  /// table, which the bodies of TIA modules are checked against.
+  /// \return: Hash that does not depend on the order of the symbols.
+  std::size_t declarations_hash() const;
+
   /// Performs a typecheck on the networks of a TIA module and saves the
-  /// result to the given symbol.
+  /// result to the given symbol, whose value and temp variables must have
+  /// been set up already.
   /// \param tia_module: Module containing the networks that shall be checked.
   /// \param [out] tia_symbol: Symbol representation of the given TIA module.
   void typecheck_statement_list_networks(
@@ -82,7 +82,7 @@ static void run_symtab2gb(
         "failed to typecheck symbol table from file '" + symtab_filename + "'"};
     }
     goto_modelt goto_model{};
-    goto_model.symbol_table = symtab;
+    goto_model.symbol_table = std::move(symtab);
     goto_convert(goto_model, message_handler);
     link_goto_model(linked_goto_model, goto_model, message_handler);
   }
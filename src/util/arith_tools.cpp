@@ -378,6 +378,26 @@ irep_idt bvrep_bitwise_op(
 /// If the value is out of range, it is 'wrapped around'.
 irep_idt integer2bvrep(const mp_integer &src, std::size_t width)
 {
+  // Values of up to 64 bits are formatted directly.
+  if(width <= 64 && src.is_ulong())
+  {
+    uint64_t value = src.to_ulong();
+    if(src.is_negative())
+      value = ~value + 1;
+    if(width < 64)
+      value &= (uint64_t(1) << width) - 1;
+
+    if(value == 0)
+      return ID_0;
+
+    char buffer[16];
+    char *p = buffer + sizeof(buffer);
+    for(; value != 0; value >>= 4)
+      *--p = nibble2hex(value & 0xf);
+
+    return std::string(p, buffer + sizeof(buffer) - p);
+  }
+
   const mp_integer p = power(2, width);
 
   if(src.is_negative())
@@ -400,6 +420,46 @@ irep_idt integer2bvrep(const mp_integer &src, std::size_t width)
 /// convert a bit-vector representation (possibly signed) to integer
 mp_integer bvrep2integer(const irep_idt &src, std::size_t width, bool is_signed)
 {
+  // Values of up to 64 bits are parsed directly.
+  const std::string &digits = id2string(src);
+  if(width <= 64 && !digits.empty() && digits.size() <= 16)
+  {
+    uint64_t value = 0;
+    bool is_hex = true;
+    for(const char c : digits)
+    {
+      if(c >= '0' && c <= '9')
+        value = (value << 4) | (c - '0');
+      else if(c >= 'A' && c <= 'F')
+        value = (value << 4) | (c - 'A' + 10);
+      else
+      {
+        is_hex = false;
+        break;
+      }
+    }
+
+    if(is_hex && (width == 64 || (value >> width) == 0))
+    {
+      if(is_signed)
+      {
+        PRECONDITION(width >= 1);
+        if((value >> (width - 1)) != 0)
+        {
+          // the magnitude of the negative value
+          uint64_t magnitude = ~value + 1;
+          if(width < 64)
+            magnitude &= (uint64_t(1) << width) - 1;
+          mp_integer result = mp_integer::ullong_t(magnitude);
+          result.negate();
+          return result;
+        }
+      }
+
+      return mp_integer::ullong_t(value);
+    }
+  }
+
   if(is_signed)
   {
     PRECONDITION(width >= 1);
@@ -0,0 +1,453 @@
+/*******************************************************************\
+
+Module: Chunked Vector
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Chunked Vector
+
+#ifndef CPROVER_UTIL_CHUNKED_VECTOR_H
+#define CPROVER_UTIL_CHUNKED_VECTOR_H
+
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "invariant.h"
+#include "make_unique.h"
+
+/// A sequence container that stores its elements in fixed-size chunks.
+/// Like `std::list`, appending an element never moves any of the existing
+/// ones, so references and iterators remain valid, and iterators refer to
+/// the container that a container is moved to. Like `std::vector`, elements
+/// are allocated in bulk and can be accessed by index in constant time, and
+/// iterators are random-access.
+/// Operations that insert at the front or remove all elements
+/// (\ref prepend, \ref clear) invalidate all references and iterators.
+///
+/// Copies share their chunks, such that copying takes time linear in the
+/// number of chunks rather than elements. A shared chunk is copied on the
+/// first mutable access by either container. Hence copying a container
+/// invalidates references (but not iterators) into it: they may not be used
+/// to modify elements, and may refer to the other copy once this container
+/// has modified the chunk.
+/// \tparam T: element type, which must be move constructible
+/// \tparam chunk_size: number of elements allocated at a time
+template <typename T, std::size_t chunk_size = 256>
+class chunked_vectort
+{
+  static_assert(chunk_size > 0, "chunks must hold at least one element");
+
+  using chunkt = std::vector<T>;
+  using chunkst = std::vector<std::shared_ptr<chunkt>>;
+
+public:
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef T value_type;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef std::size_t size_type;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef std::ptrdiff_t difference_type;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef T &reference;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef const T &const_reference;
+
+  /// Iterators are a pair of the chunks of a container and an index, and thus
+  /// remain valid while elements are appended and when the container is
+  /// moved.
+  template <bool is_const>
+  class iterator_templatet
+  {
+  public:
+    typedef std::random_access_iterator_tag iterator_category; // NOLINT
+    typedef T value_type;                                      // NOLINT
+    typedef std::ptrdiff_t difference_type;                    // NOLINT
+    typedef typename std::conditional<is_const, const T *, T *>::type
+      pointer; // NOLINT
+    typedef typename std::conditional<is_const, const T &, T &>::type
+      reference; // NOLINT
+
+    using chunks_typet =
+      typename std::conditional<is_const, const chunkst, chunkst>::type;
+
+    iterator_templatet() = default;
+
+    iterator_templatet(chunks_typet *_chunks, std::size_t _index)
+      : chunks(_chunks), index(_index)
+    {
+    }
+
+    /// Mutable iterators convert to const iterators
+    template <
+      bool other_is_const,
+      typename = typename std::enable_if<is_const && !other_is_const>::type>
+    // NOLINTNEXTLINE(runtime/explicit)
+    iterator_templatet(const iterator_templatet<other_is_const> &other)
+      : chunks(other.chunks), index(other.index)
+    {
+    }
+
+    reference operator*() const
+    {
+      return element(*chunks, index);
+    }
+
+    pointer operator->() const
+    {
+      return &element(*chunks, index);
+    }
+
+    reference operator[](difference_type n) const
+    {
+      return element(*chunks, index + n);
+    }
+
+    iterator_templatet &operator++()
+    {
+      ++index;
+      return *this;
+    }
+
+    iterator_templatet operator++(int)
+    {
+      iterator_templatet tmp = *this;
+      ++index;
+      return tmp;
+    }
+
+    iterator_templatet &operator--()
+    {
+      --index;
+      return *this;
+    }
+
+    iterator_templatet operator--(int)
+    {
+      iterator_templatet tmp = *this;
+      --index;
+      return tmp;
+    }
+
+    iterator_templatet &operator+=(difference_type n)
+    {
+      index += n;
+      return *this;
+    }
+
+    iterator_templatet &operator-=(difference_type n)
+    {
+      index -= n;
+      return *this;
+    }
+
+    iterator_templatet operator+(difference_type n) const
+    {
+      return iterator_templatet(chunks, index + n);
+    }
+
+    friend iterator_templatet
+    operator+(difference_type n, const iterator_templatet &it)
+    {
+      return it + n;
+    }
+
+    iterator_templatet operator-(difference_type n) const
+    {
+      return iterator_templatet(chunks, index - n);
+    }
+
+    difference_type operator-(const iterator_templatet &other) const
+    {
+      return static_cast<difference_type>(index) -
+             static_cast<difference_type>(other.index);
+    }
+
+    bool operator==(const iterator_templatet &other) const
+    {
+      return index == other.index && chunks == other.chunks;
+    }
+
+    bool operator!=(const iterator_templatet &other) const
+    {
+      return !(*this == other);
+    }
+
+    /// Iterators are ordered by position; both must point into the same
+    /// container.
+    bool operator<(const iterator_templatet &other) const
+    {
+      return index < other.index;
+    }
+
+    bool operator>(const iterator_templatet &other) const
+    {
+      return other < *this;
+    }
+
+    bool operator<=(const iterator_templatet &other) const
+    {
+      return !(other < *this);
+    }
+
+    bool operator>=(const iterator_templatet &other) const
+    {
+      return !(*this < other);
+    }
+
+    /// Position of the element this iterator refers to
+    std::size_t get_index() const
+    {
+      return index;
+    }
+
+  private:
+    template <bool>
+    friend class iterator_templatet;
+
+    chunks_typet *chunks = nullptr;
+    std::size_t index = 0;
+  };
+
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef iterator_templatet<false> iterator;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef iterator_templatet<true> const_iterator;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef std::reverse_iterator<iterator> reverse_iterator;
+  // NOLINTNEXTLINE(readability/identifiers)
+  typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+  chunked_vectort() : chunks(util_make_unique<chunkst>())
+  {
+  }
+
+  chunked_vectort(const chunked_vectort &other)
+    : chunks(util_make_unique<chunkst>(*other.chunks))
+  {
+  }
+
+  /// The chunks are handed over, hence iterators into \p other refer to
+  /// this container, and \p other is empty afterwards
+  chunked_vectort(chunked_vectort &&other)
+    : chunks(std::move(other.chunks))
+  {
+    other.chunks = util_make_unique<chunkst>();
+  }
+
+  chunked_vectort &operator=(const chunked_vectort &other)
+  {
+    *chunks = *other.chunks;
+    return *this;
+  }
+
+  /// The chunks are handed over, hence iterators into \p other refer to
+  /// this container, and \p other is empty afterwards
+  chunked_vectort &operator=(chunked_vectort &&other)
+  {
+    std::swap(chunks, other.chunks);
+    other.clear();
+    return *this;
+  }
+
+  size_type size() const
+  {
+    return chunks->empty() ? 0
+                           : (chunks->size() - 1) * chunk_size +
+                               chunks->back()->size();
+  }
+
+  bool empty() const
+  {
+    return chunks->empty();
+  }
+
+  T &operator[](size_type n)
+  {
+    PRECONDITION(n < size());
+    return element(*chunks, n);
+  }
+
+  const T &operator[](size_type n) const
+  {
+    PRECONDITION(n < size());
+    return element(static_cast<const chunkst &>(*chunks), n);
+  }
+
+  T &front()
+  {
+    PRECONDITION(!empty());
+    return mutable_chunk(*chunks, 0).front();
+  }
+
+  const T &front() const
+  {
+    PRECONDITION(!empty());
+    return chunks->front()->front();
+  }
+
+  T &back()
+  {
+    PRECONDITION(!empty());
+    return mutable_chunk(*chunks, chunks->size() - 1).back();
+  }
+
+  const T &back() const
+  {
+    PRECONDITION(!empty());
+    return chunks->back()->back();
+  }
+
+  iterator begin()
+  {
+    return iterator(chunks.get(), 0);
+  }
+
+  const_iterator begin() const
+  {
+    return const_iterator(chunks.get(), 0);
+  }
+
+  const_iterator cbegin() const
+  {
+    return begin();
+  }
+
+  iterator end()
+  {
+    return iterator(chunks.get(), size());
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator(chunks.get(), size());
+  }
+
+  const_iterator cend() const
+  {
+    return end();
+  }
+
+  reverse_iterator rbegin()
+  {
+    return reverse_iterator(end());
+  }
+
+  const_reverse_iterator rbegin() const
+  {
+    return const_reverse_iterator(end());
+  }
+
+  reverse_iterator rend()
+  {
+    return reverse_iterator(begin());
+  }
+
+  const_reverse_iterator rend() const
+  {
+    return const_reverse_iterator(begin());
+  }
+
+  /// Construct a new element at the end; existing elements are not moved.
+  template <typename... argumentst>
+  void emplace_back(argumentst &&... arguments)
+  {
+    make_room().emplace_back(std::forward<argumentst>(arguments)...);
+  }
+
+  void push_back(const T &t)
+  {
+    make_room().push_back(t);
+  }
+
+  void push_back(T &&t)
+  {
+    make_room().push_back(std::move(t));
+  }
+
+  void pop_back()
+  {
+    PRECONDITION(!empty());
+    if(chunks->back()->size() == 1)
+      chunks->pop_back();
+    else
+      mutable_chunk(*chunks, chunks->size() - 1).pop_back();
+  }
+
+  /// Remove all elements and release the memory they occupied
+  void clear()
+  {
+    chunks->clear();
+  }
+
+  /// Move all elements of \p other to the front of this container, keeping
+  /// their order. \p other is empty afterwards.
+  void prepend(chunked_vectort &&other)
+  {
+    if(other.empty())
+      return;
+
+    for(auto &element : *this)
+      other.push_back(std::move(element));
+
+    chunks->swap(*other.chunks);
+    other.clear();
+  }
+
+private:
+  /// The chunks are kept on the heap, such that iterators, which point to
+  /// them, remain valid when the container is moved
+  std::unique_ptr<chunkst> chunks;
+
+  /// Element number \p n of \p chunks, whose chunk is copied first if it is
+  /// shared with another container
+  static T &element(chunkst &chunks, size_type n)
+  {
+    return mutable_chunk(chunks, n / chunk_size)[n % chunk_size];
+  }
+
+  static const T &element(const chunkst &chunks, size_type n)
+  {
+    return (*chunks[n / chunk_size])[n % chunk_size];
+  }
+
+  /// Chunk number \p c of \p chunks, which is copied first if it is shared
+  /// with another container
+  static chunkt &mutable_chunk(chunkst &chunks, std::size_t c)
+  {
+    std::shared_ptr<chunkt> &chunk = chunks[c];
+    if(chunk.use_count() > 1)
+      chunk = copy_chunk(*chunk);
+    return *chunk;
+  }
+
+  /// Copy of \p chunk that can be appended to without reallocation, which
+  /// a plain copy of a `std::vector` does not ensure
+  static std::shared_ptr<chunkt> copy_chunk(const chunkt &chunk)
+  {
+    auto copy = std::make_shared<chunkt>();
+    copy->reserve(chunk_size);
+    copy->insert(copy->end(), chunk.begin(), chunk.end());
+    return copy;
+  }
+
+  /// Make sure the last chunk can hold one more element without
+  /// reallocation, and is not shared.
+  /// \return the last chunk
+  chunkt &make_room()
+  {
+    if(chunks->empty() || chunks->back()->size() == chunk_size)
+    {
+      chunks->push_back(std::make_shared<chunkt>());
+      chunks->back()->reserve(chunk_size);
+    }
+    return mutable_chunk(*chunks, chunks->size() - 1);
+  }
+};
+
+#endif // CPROVER_UTIL_CHUNKED_VECTOR_H
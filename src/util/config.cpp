@@ -9,6 +9,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "config.h"
 
 #include <cstdlib>
+#include <sstream>
 
 #include "arith_tools.h"
 #include "cmdline.h"
@@ -23,6 +24,37 @@ Author: Daniel Kroening, kroening@kroening.com
 
 configt config;
 
+std::string configt::ansi_ct::fingerprint() const
+{
+  std::ostringstream result;
+
+  result << int_width << ' ' << long_int_width << ' ' << bool_width << ' '
+         << char_width << ' ' << short_int_width << ' ' << long_long_int_width
+         << ' ' << pointer_width << ' ' << single_width << ' ' << double_width
+         << ' ' << long_double_width << ' ' << wchar_t_width << '\n'
+         << char_is_unsigned << wchar_t_is_unsigned << for_has_scope
+         << ts_18661_3_Floatn_types << gcc__float128_type
+         << single_precision_constant << NULL_is_zero << string_abstraction
+         << '\n'
+         << static_cast<int>(c_standard) << ' '
+         << static_cast<int>(rounding_mode) << ' ' << alignment << ' '
+         << memory_operand_size << ' ' << static_cast<int>(endianness) << ' '
+         << static_cast<int>(os) << ' ' << arch << ' '
+         << static_cast<int>(mode) << ' ' << static_cast<int>(preprocessor)
+         << ' ' << static_cast<int>(lib) << '\n';
+
+  for(const auto &list :
+      {&defines, &undefines, &preprocessor_options, &include_paths,
+       &include_files})
+  {
+    for(const auto &item : *list)
+      result << ' ' << item;
+    result << '\n';
+  }
+
+  return result.str();
+}
+
 void configt::ansi_ct::set_16()
 {
   set_LP32();
@@ -1050,6 +1082,9 @@ bool configt::set(const cmdlinet &cmdline)
   if(cmdline.isset("no-library"))
     ansi_c.lib=configt::ansi_ct::libt::LIB_NONE;
 
+  if(cmdline.isset("library-cache"))
+    ansi_c.library_cache=cmdline.get_value("library-cache");
+
   if(cmdline.isset("little-endian"))
     ansi_c.endianness=configt::ansi_ct::endiannesst::IS_LITTLE_ENDIAN;
 
@@ -11,6 +11,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_UTIL_CONFIG_H
 
 #include <list>
+#include <string>
 
 #include "ieee_float.h"
 #include "irep.h"
@@ -128,8 +129,16 @@ public:
     enum class libt { LIB_NONE, LIB_FULL };
     libt lib;
 
+    /// Directory of the cache of type-checked library models, or empty if
+    /// no cache is to be used
+    std::string library_cache;
+
     bool string_abstraction;
 
+    /// Text that identifies the configuration that C sources are
+    /// preprocessed, parsed and type checked in, for keying caches
+    std::string fingerprint() const;
+
     static const std::size_t default_object_bits=8;
   } ansi_c;
 
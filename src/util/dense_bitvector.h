@@ -0,0 +1,157 @@
+/*******************************************************************\
+
+Module: Dense Bit Vectors
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Dense Bit Vectors
+
+#ifndef CPROVER_UTIL_DENSE_BITVECTOR_H
+#define CPROVER_UTIL_DENSE_BITVECTOR_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/// A set of small non-negative integers, stored as a vector of 64-bit words
+/// in which bit `i` is set iff `i` is in the set. Set operations work on
+/// whole words at a time, in loops that compilers can vectorize.
+class dense_bitvectort
+{
+public:
+  /// Add \p index to the set
+  /// \return True iff \p index was not in the set before
+  bool insert(std::size_t index)
+  {
+    const std::size_t word = index / bits_per_word;
+    if(word >= words.size())
+      words.resize(word + 1, 0);
+
+    const wordt mask = wordt(1) << (index % bits_per_word);
+    if(words[word] & mask)
+      return false;
+
+    words[word] |= mask;
+    return true;
+  }
+
+  /// Remove \p index from the set
+  /// \return True iff \p index was in the set before
+  bool erase(std::size_t index)
+  {
+    const std::size_t word = index / bits_per_word;
+    const wordt mask = wordt(1) << (index % bits_per_word);
+    if(word >= words.size() || !(words[word] & mask))
+      return false;
+
+    words[word] &= ~mask;
+    return true;
+  }
+
+  bool contains(std::size_t index) const
+  {
+    const std::size_t word = index / bits_per_word;
+    return word < words.size() &&
+           (words[word] & (wordt(1) << (index % bits_per_word))) != 0;
+  }
+
+  bool empty() const
+  {
+    for(const wordt w : words)
+    {
+      if(w != 0)
+        return false;
+    }
+    return true;
+  }
+
+  void clear()
+  {
+    words.clear();
+  }
+
+  /// Add all elements of \p other to the set
+  /// \return True iff any of them was not in the set before
+  bool union_with(const dense_bitvectort &other)
+  {
+    if(other.words.size() > words.size())
+      words.resize(other.words.size(), 0);
+
+    wordt added = 0;
+    for(std::size_t i = 0; i < other.words.size(); ++i)
+    {
+      added |= other.words[i] & ~words[i];
+      words[i] |= other.words[i];
+    }
+
+    return added != 0;
+  }
+
+  /// Remove all elements of \p other from the set
+  void subtract(const dense_bitvectort &other)
+  {
+    const std::size_t size = std::min(words.size(), other.words.size());
+    for(std::size_t i = 0; i < size; ++i)
+      words[i] &= ~other.words[i];
+  }
+
+  /// Call \p f with each element of the set in ascending order. The set must
+  /// not be changed by \p f.
+  template <typename F>
+  void for_each(F f) const
+  {
+    for(std::size_t i = 0; i < words.size(); ++i)
+    {
+      for(wordt w = words[i]; w != 0; w &= w - 1)
+        f(i * bits_per_word + count_trailing_zeros(w));
+    }
+  }
+
+  bool operator==(const dense_bitvectort &other) const
+  {
+    const std::size_t size = std::min(words.size(), other.words.size());
+    for(std::size_t i = 0; i < size; ++i)
+    {
+      if(words[i] != other.words[i])
+        return false;
+    }
+
+    const auto &longer = words.size() > size ? words : other.words;
+    for(std::size_t i = size; i < longer.size(); ++i)
+    {
+      if(longer[i] != 0)
+        return false;
+    }
+
+    return true;
+  }
+
+  bool operator!=(const dense_bitvectort &other) const
+  {
+    return !(*this == other);
+  }
+
+protected:
+  typedef std::uint64_t wordt;
+  static const std::size_t bits_per_word = 64;
+
+  std::vector<wordt> words;
+
+  /// \pre \p w is not zero
+  static std::size_t count_trailing_zeros(wordt w)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<std::size_t>(__builtin_ctzll(w));
+#else
+    std::size_t result = 0;
+    for(; !(w & 1); w >>= 1)
+      ++result;
+    return result;
+#endif
+  }
+};
+
+#endif // CPROVER_UTIL_DENSE_BITVECTOR_H
@@ -134,21 +134,23 @@ optionalt<exprt> expr_initializert<nondet>::expr_initializer_rec(
         return {};
 
       const auto array_size = numeric_cast<mp_integer>(array_type.size());
+      if(array_size.has_value() && *array_size < 0)
+        return {};
+
+      // One nondeterministic array rather than one value per element, which
+      // symex would have to introduce a symbol for each.
+      if(nondet)
+        return side_effect_expr_nondett(type, source_location);
+
       if(
         array_type.size().id() == ID_infinity || !array_size.has_value() ||
         *array_size > MAX_FLATTENED_ARRAY_SIZE)
       {
-        if(nondet)
-          return side_effect_expr_nondett(type, source_location);
-
         array_of_exprt value(*tmpval, array_type);
         value.add_source_location()=source_location;
         return std::move(value);
       }
 
-      if(*array_size < 0)
-        return {};
-
       array_exprt value({}, array_type);
       value.operands().resize(
         numeric_cast_v<std::size_t>(*array_size), *tmpval);
@@ -9,11 +9,12 @@ Author: Diffblue Ltd.
 #ifndef CPROVER_UTIL_EXPR_ITERATOR_H
 #define CPROVER_UTIL_EXPR_ITERATOR_H
 
-#include <deque>
+#include <array>
 #include <iterator>
 #include <functional>
-#include <set>
+#include <unordered_set>
 #include <algorithm>
+#include <vector>
 #include "expr.h"
 #include "invariant.h"
 
@@ -41,21 +42,98 @@ class const_unique_depth_iteratort;
 /// Helper class for depth_iterator_baset
 struct depth_iterator_expr_statet final
 {
-  typedef exprt::operandst::const_iterator operands_iteratort;
-  explicit depth_iterator_expr_statet(const exprt &expr) : expr(expr), op_idx(0)
+  depth_iterator_expr_statet() = default;
+  explicit depth_iterator_expr_statet(const exprt &expr)
+    : expr(&expr), op_idx(0)
   {
   }
-  std::reference_wrapper<const exprt> expr;
-  std::size_t op_idx;
+  const exprt *expr = nullptr;
+  std::size_t op_idx = 0;
 };
 
 inline bool operator==(
   const depth_iterator_expr_statet &left,
   const depth_iterator_expr_statet &right)
 {
-  return left.op_idx == right.op_idx && left.expr.get() == right.expr.get();
+  return left.op_idx == right.op_idx && left.expr == right.expr;
 }
 
+/// Stack of the states of depth_iterator_baset. The states of the first
+/// \ref inline_capacity levels are kept within the iterator, such that
+/// traversing expressions of usual depth does not allocate.
+class depth_iterator_stackt final
+{
+public:
+  static constexpr std::size_t inline_capacity = 16;
+
+  bool empty() const
+  {
+    return inline_size == 0;
+  }
+
+  std::size_t size() const
+  {
+    return inline_size + overflow.size();
+  }
+
+  depth_iterator_expr_statet &operator[](std::size_t i)
+  {
+    return i < inline_capacity ? inline_states[i]
+                               : overflow[i - inline_capacity];
+  }
+
+  const depth_iterator_expr_statet &operator[](std::size_t i) const
+  {
+    return i < inline_capacity ? inline_states[i]
+                               : overflow[i - inline_capacity];
+  }
+
+  depth_iterator_expr_statet &back()
+  {
+    return overflow.empty() ? inline_states[inline_size - 1] : overflow.back();
+  }
+
+  const depth_iterator_expr_statet &back() const
+  {
+    return overflow.empty() ? inline_states[inline_size - 1] : overflow.back();
+  }
+
+  const depth_iterator_expr_statet &front() const
+  {
+    return inline_states[0];
+  }
+
+  void emplace_back(const exprt &expr)
+  {
+    if(inline_size < inline_capacity)
+      inline_states[inline_size++] = depth_iterator_expr_statet(expr);
+    else
+      overflow.emplace_back(expr);
+  }
+
+  void pop_back()
+  {
+    if(overflow.empty())
+      --inline_size;
+    else
+      overflow.pop_back();
+  }
+
+  bool operator==(const depth_iterator_stackt &other) const
+  {
+    return inline_size == other.inline_size && overflow == other.overflow &&
+           std::equal(
+             inline_states.begin(),
+             inline_states.begin() + inline_size,
+             other.inline_states.begin());
+  }
+
+private:
+  std::array<depth_iterator_expr_statet, inline_capacity> inline_states;
+  std::size_t inline_size = 0;
+  std::vector<depth_iterator_expr_statet> overflow;
+};
+
 /// Depth first search iterator base - iterates over supplied expression
 /// and all its operands recursively.
 /// Base class using CRTP
@@ -96,7 +174,7 @@ public:
     PRECONDITION(!m_stack.empty());
     while(true)
     {
-      if(m_stack.back().op_idx == m_stack.back().expr.get().operands().size())
+      if(m_stack.back().op_idx == m_stack.back().expr->operands().size())
       {
         m_stack.pop_back();
         if(m_stack.empty())
@@ -104,7 +182,7 @@ public:
       }
       // Check eg. if we haven't seen this node before
       else if(this->downcast().push_expr(
-                m_stack.back().expr.get().operands()[m_stack.back().op_idx]))
+                m_stack.back().expr->operands()[m_stack.back().op_idx]))
       {
         break;
       }
@@ -139,7 +217,7 @@ public:
   const exprt &operator*() const
   {
     PRECONDITION(!m_stack.empty());
-    return m_stack.back().expr.get();
+    return *m_stack.back().expr;
   }
 
   /// Dereference operator (member access)
@@ -164,11 +242,14 @@ protected:
   { m_stack=std::move(other.m_stack); }
   depth_iterator_baset &operator=(const depth_iterator_baset&)=default;
   depth_iterator_baset &operator=(depth_iterator_baset &&other)
-  { m_stack=std::move(other.m_stack); }
+  {
+    m_stack = std::move(other.m_stack);
+    return *this;
+  }
 
   const exprt &get_root()
   {
-    return m_stack.front().expr.get();
+    return *m_stack.front().expr;
   }
 
   /// Obtain non-const exprt reference. Performs a copy-on-write on the root
@@ -181,13 +262,14 @@ protected:
     PRECONDITION(!m_stack.empty());
     // Cast the root expr to non-const
     exprt *expr = &const_cast<exprt &>(get_root());
-    for(auto &state : m_stack)
+    for(std::size_t i = 0; i < m_stack.size(); ++i)
     {
+      auto &state = m_stack[i];
       // This deliberately breaks sharing as expr is now non-const
       (void)expr->write();
-      state.expr = *expr;
+      state.expr = expr;
       // Get the expr for the next level down to use in the next iteration
-      if(!(state == m_stack.back()))
+      if(i + 1 < m_stack.size())
         expr = &expr->operands()[state.op_idx];
     }
     return *expr;
@@ -205,7 +287,7 @@ protected:
   }
 
 private:
-  std::deque<depth_iterator_expr_statet> m_stack;
+  depth_iterator_stackt m_stack;
 
   depth_iterator_t &downcast()
   { return static_cast<depth_iterator_t &>(*this); }
@@ -294,12 +376,14 @@ private:
   /// Push expression onto the stack and add to the set of traversed exprts
   bool push_expr(const exprt &expr) // "override" - hide base class method
   {
+    // hashes are cached in the nodes, and shared nodes compare equal without
+    // a structural comparison
     const bool inserted=this->m_traversed.insert(expr).second;
     if(inserted)
       depth_iterator_baset::push_expr(expr);
     return inserted;
   }
-  std::set<exprt> m_traversed;
+  std::unordered_set<exprt, irep_hash> m_traversed;
 };
 
 #endif
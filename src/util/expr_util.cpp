@@ -312,3 +312,26 @@ exprt make_and(exprt a, exprt b)
   }
   return and_exprt{std::move(a), std::move(b)};
 }
+
+optionalt<exprt> commute_operands(const exprt &expr)
+{
+  if(
+    expr.operands().size() != 2 ||
+    expr.operands()[0].type() != expr.operands()[1].type())
+  {
+    return {};
+  }
+
+  const irep_idt &id = expr.id();
+  if(
+    id != ID_plus && id != ID_mult && id != ID_bitand && id != ID_bitor &&
+    id != ID_bitxor && id != ID_and && id != ID_or && id != ID_xor &&
+    id != ID_equal && id != ID_notequal)
+  {
+    return {};
+  }
+
+  exprt result = expr;
+  std::swap(result.operands()[0], result.operands()[1]);
+  return std::move(result);
+}
@@ -18,6 +18,7 @@ Author: Daniel Kroening, kroening@kroening.com
 */
 
 #include "irep.h"
+#include "optional.h"
 
 #include <functional>
 
@@ -105,4 +106,11 @@ constant_exprt make_boolean_expr(bool);
 /// return the other expression. If one is `false` returns `false`.
 exprt make_and(exprt a, exprt b);
 
+/// If \p expr applies a commutative operator to two operands of the same
+/// type, return it with the operands swapped, for looking up another
+/// expression with the same value in a cache.
+/// \return The swapped expression, or an empty optional if the operator
+///   is not known to be commutative
+optionalt<exprt> commute_operands(const exprt &expr);
+
 #endif // CPROVER_UTIL_EXPR_UTIL_H
@@ -0,0 +1,201 @@
+/*******************************************************************\
+
+Module: Process-Level Parallelism
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Process-Level Parallelism
+
+#include "forked_workers.h"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <cstdio>
+
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <iostream>
+#include <new>
+
+#include "invariant.h"
+
+#ifndef _WIN32
+/// Write all of \p data to \p fd, retrying on partial writes
+static bool write_all(int fd, const std::string &data)
+{
+  const char *p = data.data();
+  std::size_t remaining = data.size();
+
+  while(remaining > 0)
+  {
+    ssize_t written = write(fd, p, remaining);
+    if(written < 0)
+    {
+      if(errno == EINTR)
+        continue;
+      return false;
+    }
+    p += written;
+    remaining -= static_cast<std::size_t>(written);
+  }
+
+  return true;
+}
+
+/// Read from \p fd until end of file
+static std::string read_all(int fd)
+{
+  std::string result;
+  char buffer[4096];
+
+  while(true)
+  {
+    ssize_t n = read(fd, buffer, sizeof(buffer));
+    if(n < 0)
+    {
+      if(errno == EINTR)
+        continue;
+      break;
+    }
+    if(n == 0)
+      break;
+    result.append(buffer, static_cast<std::size_t>(n));
+  }
+
+  return result;
+}
+#endif
+
+bool forked_workers_supported()
+{
+#ifdef _WIN32
+  return false;
+#else
+  return true;
+#endif
+}
+
+std::vector<optionalt<std::string>> run_forked_workers(
+  std::size_t number_of_workers,
+  std::function<std::string(std::size_t)> worker)
+{
+  PRECONDITION(forked_workers_supported());
+  std::vector<optionalt<std::string>> results(number_of_workers);
+
+#ifndef _WIN32
+  // anything still buffered would otherwise be printed by every child
+  std::cout.flush();
+  std::cerr.flush();
+  fflush(nullptr);
+
+  struct childt
+  {
+    pid_t pid;
+    int fd;
+  };
+  std::vector<childt> children(number_of_workers, childt{-1, -1});
+
+  for(std::size_t i = 0; i < number_of_workers; ++i)
+  {
+    int fds[2];
+    if(pipe(fds) != 0)
+      continue;
+
+    pid_t pid = fork();
+
+    if(pid == 0)
+    {
+      close(fds[0]);
+      bool success = write_all(fds[1], worker(i));
+      close(fds[1]);
+      std::cout.flush();
+      std::cerr.flush();
+      // skip destructors and atexit handlers of the parent's state
+      _exit(success ? 0 : 1);
+    }
+
+    close(fds[1]);
+
+    if(pid < 0)
+    {
+      close(fds[0]);
+      continue;
+    }
+
+    children[i] = childt{pid, fds[0]};
+  }
+
+  for(std::size_t i = 0; i < number_of_workers; ++i)
+  {
+    const childt &child = children[i];
+    if(child.pid < 0)
+      continue;
+
+    // drain the pipe before waiting to avoid blocking the child
+    std::string data = read_all(child.fd);
+    close(child.fd);
+
+    int status;
+    while(waitpid(child.pid, &status, 0) == -1)
+    {
+      if(errno != EINTR)
+      {
+        status = -1;
+        break;
+      }
+    }
+
+    if(status != -1 && WIFEXITED(status) && WEXITSTATUS(status) == 0)
+      results[i] = std::move(data);
+  }
+#endif
+
+  return results;
+}
+
+shared_flagst::shared_flagst(std::size_t size)
+  : _size(size), flags(nullptr), is_mapped(false)
+{
+  const std::size_t bytes = std::max<std::size_t>(1, size) * sizeof(*flags);
+  void *memory = nullptr;
+
+#ifndef _WIN32
+  memory =
+    mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANON, -1, 0);
+  if(memory == MAP_FAILED)
+    memory = nullptr;
+  else
+    is_mapped = true;
+#endif
+
+  if(memory == nullptr)
+    memory = ::operator new(bytes);
+
+  flags = static_cast<std::atomic<bool> *>(memory);
+  for(std::size_t i = 0; i < size; ++i)
+    new(&flags[i]) std::atomic<bool>(false);
+}
+
+shared_flagst::~shared_flagst()
+{
+  const std::size_t bytes = std::max<std::size_t>(1, _size) * sizeof(*flags);
+
+#ifndef _WIN32
+  if(is_mapped)
+  {
+    munmap(flags, bytes);
+    return;
+  }
+#endif
+
+  (void)bytes;
+  ::operator delete(flags);
+}
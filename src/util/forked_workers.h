@@ -0,0 +1,83 @@
+/*******************************************************************\
+
+Module: Process-Level Parallelism
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Process-Level Parallelism
+///
+/// Ireps are reference counted without synchronisation, hence threads must
+/// not share any expressions, and most state, such as the symbol table, is
+/// not synchronised either. The string table is safe for concurrent use, but
+/// that alone does not make threads practical. Instead, the process forks
+/// into workers that inherit a copy-on-write image of the parent's state
+/// (for example, a symex equation) and report back a serialised result.
+
+#ifndef CPROVER_UTIL_FORKED_WORKERS_H
+#define CPROVER_UTIL_FORKED_WORKERS_H
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "optional.h"
+
+/// Return true if \ref run_forked_workers is supported on this platform.
+bool forked_workers_supported();
+
+/// Run \p number_of_workers instances of \p worker, each in its own forked
+/// child process, and collect their results. Worker `i` is called with
+/// argument `i`. The string it returns is sent back to the parent. Any
+/// changes the worker makes to the program state are confined to the child.
+/// All standard output streams are flushed before forking to avoid
+/// duplicated output.
+/// Requires \ref forked_workers_supported.
+/// \param number_of_workers: number of child processes to create
+/// \param worker: function computing the result of one worker
+/// \return one entry per worker, which is empty if the worker could not be
+///   started or failed to report a result (for example, because it crashed)
+std::vector<optionalt<std::string>> run_forked_workers(
+  std::size_t number_of_workers,
+  std::function<std::string(std::size_t)> worker);
+
+/// A fixed number of flags in memory that is shared between the process
+/// that creates them and the workers it forks afterwards with
+/// \ref run_forked_workers, such that a flag set by one worker is seen by
+/// the others and by the parent. Where shared memory is not available, the
+/// flags are local to each process.
+class shared_flagst
+{
+public:
+  /// Create \p size flags, all unset
+  explicit shared_flagst(std::size_t size);
+  ~shared_flagst();
+
+  shared_flagst(const shared_flagst &) = delete;
+  shared_flagst &operator=(const shared_flagst &) = delete;
+
+  void set(std::size_t i)
+  {
+    flags[i].store(true, std::memory_order_relaxed);
+  }
+
+  bool get(std::size_t i) const
+  {
+    return flags[i].load(std::memory_order_relaxed);
+  }
+
+  std::size_t size() const
+  {
+    return _size;
+  }
+
+protected:
+  std::size_t _size;
+  std::atomic<bool> *flags;
+  bool is_mapped;
+};
+
+#endif // CPROVER_UTIL_FORKED_WORKERS_H
@@ -150,6 +150,9 @@ bool irept::operator==(const irept &other) const
     return true;
   #endif
 
+  if(hash_codes_differ(other))
+    return false;
+
   if(id() != other.id() || get_sub() != other.get_sub()) // recursive call
   {
     #ifdef IREP_HASH_STATS
@@ -206,6 +209,10 @@ bool irept::full_eq(const irept &other) const
     return true;
   #endif
 
+  // the hash ignores comments, hence differing hashes rule out full equality
+  if(hash_codes_differ(other))
+    return false;
+
   if(id()!=other.id())
     return false;
 
@@ -310,6 +317,11 @@ bool irept::ordering(const irept &other) const
 /// comments are ignored
 int irept::compare(const irept &i) const
 {
+#ifdef SHARING
+  if(data == i.data)
+    return 0;
+#endif
+
   int r;
 
   r=id().compare(i.id());
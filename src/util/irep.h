@@ -21,9 +21,21 @@ Author: Daniel Kroening, kroening@kroening.com
 #  define HASH_CODE 1
 #endif
 // #define NAMED_SUB_IS_FORWARD_LIST
+// #define NAMED_SUB_IS_SMALL_SORTED_MAP
+// Allocate tree nodes and the nodes of named_sub from per-thread pools,
+// disable (e.g., when using memory checkers) with -DIREP_POOL_ALLOCATOR=0
+#ifndef IREP_POOL_ALLOCATOR
+#  define IREP_POOL_ALLOCATOR 1
+#endif
+
+#if IREP_POOL_ALLOCATOR
+#  include "pool_allocator.h"
+#endif
 
 #ifdef NAMED_SUB_IS_FORWARD_LIST
 #  include "forward_list_as_map.h"
+#elif defined(NAMED_SUB_IS_SMALL_SORTED_MAP)
+#  include "small_sorted_map.h"
 #else
 #include <map>
 #endif
@@ -171,6 +183,20 @@ public:
       sub(std::move(_sub))
   {
   }
+
+#if IREP_POOL_ALLOCATOR
+  static void *operator new(std::size_t size)
+  {
+    PRECONDITION(size == sizeof(tree_nodet));
+    return fixed_size_poolt<sizeof(tree_nodet), alignof(tree_nodet)>::
+      allocate();
+  }
+
+  static void operator delete(void *p)
+  {
+    fixed_size_poolt<sizeof(tree_nodet), alignof(tree_nodet)>::deallocate(p);
+  }
+#endif
 };
 
 /// Base class for tree-like data structures with sharing
@@ -388,8 +414,26 @@ class irept
 #endif
 #ifdef NAMED_SUB_IS_FORWARD_LIST
       forward_list_as_mapt<irep_namet, irept>>
+#elif defined(NAMED_SUB_IS_SMALL_SORTED_MAP)
+#  if IREP_POOL_ALLOCATOR
+      small_sorted_mapt<
+        irep_namet,
+        irept,
+        2,
+        pool_allocatort<std::pair<const irep_namet, irept>>>>
+#  else
+      small_sorted_mapt<irep_namet, irept>>
+#  endif
 #else
+#  if IREP_POOL_ALLOCATOR
+      std::map<
+        irep_namet,
+        irept,
+        std::less<irep_namet>,
+        pool_allocatort<std::pair<const irep_namet, irept>>>>
+#  else
       std::map<irep_namet, irept>>
+#  endif
 #endif
 {
 public:
@@ -491,6 +535,23 @@ public:
 
   /// count the number of named_sub elements that are not comments
   static std::size_t number_of_non_comments(const named_subt &);
+
+protected:
+  /// Cheap test whether the hashes of both ireps are known and differ, in
+  /// which case the ireps are not equal, not even when ignoring comments.
+  /// This does not compute any hashes.
+  bool hash_codes_differ(const irept &other) const
+  {
+#if HASH_CODE
+    const std::size_t hash_code = read().hash_code;
+    const std::size_t other_hash_code = other.read().hash_code;
+    return hash_code != 0 && other_hash_code != 0 &&
+           hash_code != other_hash_code;
+#else
+    (void)other;
+    return false;
+#endif
+  }
 };
 
 // NOLINTNEXTLINE(readability/identifiers)
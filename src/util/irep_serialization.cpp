@@ -66,22 +66,26 @@ const irept &irep_serializationt::reference_convert(std::istream &in)
 
 irept irep_serializationt::read_irep(std::istream &in)
 {
+  // read from the stream buffer directly, as each get() on the stream has to
+  // construct a sentry
+  std::streambuf &buffer = *in.rdbuf();
+
   irep_idt id = read_string_ref(in);
   irept::subt sub;
   irept::named_subt named_sub;
 
-  while(in.peek()=='S')
+  while(buffer.sgetc() == 'S')
   {
-    in.get();
+    buffer.sbumpc();
     sub.push_back(reference_convert(in));
   }
 
 #ifdef NAMED_SUB_IS_FORWARD_LIST
   irept::named_subt::iterator before = named_sub.before_begin();
 #endif
-  while(in.peek()=='N')
+  while(buffer.sgetc() == 'N')
   {
-    in.get();
+    buffer.sbumpc();
     irep_idt id = read_string_ref(in);
 #ifdef NAMED_SUB_IS_FORWARD_LIST
     named_sub.emplace_after(before, id, reference_convert(in));
@@ -91,9 +95,9 @@ irept irep_serializationt::read_irep(std::istream &in)
 #endif
   }
 
-  while(in.peek()=='C')
+  while(buffer.sgetc() == 'C')
   {
-    in.get();
+    buffer.sbumpc();
     irep_idt id = read_string_ref(in);
 #ifdef NAMED_SUB_IS_FORWARD_LIST
     named_sub.emplace_after(before, id, reference_convert(in));
@@ -103,7 +107,7 @@ irept irep_serializationt::read_irep(std::istream &in)
 #endif
   }
 
-  if(in.get()!=0)
+  if(buffer.sbumpc() != 0)
   {
     throw deserialization_exceptiont("irep not terminated");
   }
@@ -120,12 +124,19 @@ void irep_serializationt::reference_convert(
 {
   std::size_t h=ireps_container.irep_full_hash_container.number(irep);
 
-  const auto res = ireps_container.ireps_on_write.insert(
-    {h, ireps_container.ireps_on_write.size()});
+  // the numbers of the hash container are dense
+  auto &ireps_on_write = ireps_container.ireps_on_write;
+  if(h >= ireps_on_write.size())
+    ireps_on_write.resize(h + 1, 0);
 
-  write_gb_word(out, res.first->second);
-  if(res.second)
+  if(ireps_on_write[h] != 0)
+    write_gb_word(out, ireps_on_write[h] - 1);
+  else
+  {
+    ireps_on_write[h] = ++ireps_container.ireps_written;
+    write_gb_word(out, ireps_on_write[h] - 1);
     write_irep(out, irep);
+  }
 }
 
 /// Write 7 bits of `u` each time, least-significant byte first, until we have
@@ -134,6 +145,10 @@ void irep_serializationt::reference_convert(
 /// \param u: number to write
 void write_gb_word(std::ostream &out, std::size_t u)
 {
+  // collect the bytes first, as each put() on the stream has to construct a
+  // sentry
+  char buffer[(sizeof(u) * 8 + 6) / 7];
+  std::size_t length = 0;
 
   while(true)
   {
@@ -142,12 +157,14 @@ void write_gb_word(std::ostream &out, std::size_t u)
 
     if(u==0)
     {
-      out.put(value);
+      buffer[length++] = static_cast<char>(value);
       break;
     }
 
-    out.put(value | 0x80);
+    buffer[length++] = static_cast<char>(value | 0x80);
   }
+
+  out.write(buffer, length);
 }
 
 /// Interpret a stream of byte as a 7-bit encoded unsigned number.
@@ -155,25 +172,35 @@ void write_gb_word(std::ostream &out, std::size_t u)
 /// \return decoded number
 std::size_t irep_serializationt::read_gb_word(std::istream &in)
 {
+  if(!in.good())
+    throw deserialization_exceptiont("unexpected end of input stream");
+
+  // read from the stream buffer directly, as each get() on the stream has to
+  // construct a sentry
+  std::streambuf &buffer = *in.rdbuf();
+
   std::size_t res=0;
 
   unsigned shift_distance=0;
 
-  while(in.good())
+  while(true)
   {
     if(shift_distance >= sizeof(res) * 8)
       throw deserialization_exceptiont("input number too large");
 
-    unsigned char ch=static_cast<unsigned char>(in.get());
+    const auto ch = buffer.sbumpc();
+    if(ch == std::char_traits<char>::eof())
+    {
+      in.setstate(std::ios::eofbit | std::ios::failbit);
+      throw deserialization_exceptiont("unexpected end of input stream");
+    }
+
     res|=(size_t(ch&0x7f))<<shift_distance;
     shift_distance+=7;
     if((ch&0x80)==0)
       break;
   }
 
-  if(!in.good())
-    throw deserialization_exceptiont("unexpected end of input stream");
-
   return res;
 }
 
@@ -182,16 +209,19 @@ std::size_t irep_serializationt::read_gb_word(std::istream &in)
 /// \param s: string to output
 void write_gb_string(std::ostream &out, const std::string &s)
 {
-  for(std::string::const_iterator it=s.begin();
-      it!=s.end();
-      ++it)
+  // escape into a buffer that is written in one go
+  std::string escaped;
+  escaped.reserve(s.size() + 1);
+
+  for(const char c : s)
   {
-    if(*it==0 || *it=='\\')
-      out.put('\\'); // escape specials
-    out << *it;
+    if(c==0 || c=='\\')
+      escaped.push_back('\\'); // escape specials
+    escaped.push_back(c);
   }
 
-  out.put(0);
+  escaped.push_back(0);
+  out.write(escaped.data(), escaped.size());
 }
 
 /// reads a string from the stream
@@ -199,18 +229,33 @@ void write_gb_string(std::ostream &out, const std::string &s)
 /// \return a string
 irep_idt irep_serializationt::read_gb_string(std::istream &in)
 {
-  char c;
+  // read from the stream buffer directly, as each get() on the stream has to
+  // construct a sentry
+  std::streambuf &buffer = *in.rdbuf();
+  const auto eof = std::char_traits<char>::eof();
+
   size_t length=0;
 
-  while((c=static_cast<char>(in.get()))!=0)
+  while(true)
   {
+    auto c = buffer.sbumpc();
+    if(c == 0)
+      break;
+
+    if(c == '\\') // escaped chars
+      c = buffer.sbumpc();
+
+    if(c == eof)
+    {
+      // as with get(), the string ends at the end of the stream
+      in.setstate(std::ios::eofbit | std::ios::failbit);
+      break;
+    }
+
     if(length>=read_buffer.size())
       read_buffer.resize(read_buffer.size()*2, 0);
 
-    if(c=='\\') // escaped chars
-      read_buffer[length]=static_cast<char>(in.get());
-    else
-      read_buffer[length]=c;
+    read_buffer[length] = static_cast<char>(c);
 
     length++;
   }
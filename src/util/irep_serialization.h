@@ -14,7 +14,6 @@ Date: May 2007
 #ifndef CPROVER_UTIL_IREP_SERIALIZATION_H
 #define CPROVER_UTIL_IREP_SERIALIZATION_H
 
-#include <map>
 #include <iosfwd>
 #include <string>
 #include <vector>
@@ -35,8 +34,12 @@ public:
     ireps_on_readt ireps_on_read;
 
     irep_full_hash_containert irep_full_hash_container;
-    typedef std::map<std::size_t, std::size_t> ireps_on_writet;
+    /// By the number that \ref irep_full_hash_container assigns to an irep,
+    /// one plus the reference under which the irep was written, or zero if it
+    /// has not been written yet
+    typedef std::vector<std::size_t> ireps_on_writet;
     ireps_on_writet ireps_on_write;
+    std::size_t ireps_written = 0;
 
     typedef std::vector<bool> string_mapt;
     string_mapt string_map;
@@ -48,6 +51,7 @@ public:
     {
       irep_full_hash_container.clear();
       ireps_on_write.clear();
+      ireps_written = 0;
       ireps_on_read.clear();
       string_map.clear();
       string_rev_map.clear();
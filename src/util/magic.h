@@ -12,6 +12,9 @@ const std::size_t MAX_FLATTENED_ARRAY_SIZE=1000;
 const std::size_t STRING_REFINEMENT_MAX_CHAR_WIDTH = 16;
 // Limit the size of strings in traces to 64M chars to avoid memout
 const std::size_t MAX_CONCRETE_STRING_SIZE = 1 << 26;
+// Up to this bound on the length of nondet strings, string refinement
+// instantiates quantified constraints with all indices up front
+const std::size_t MAX_EAGER_STRING_INSTANTIATION_LENGTH = 32;
 
 // The top end of the range of integers for which dstrings are precomputed
 constexpr std::size_t DSTRING_NUMBERS_MAX = 64;
@@ -18,6 +18,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <malloc.h>
 #endif
 
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
 #ifdef _WIN32
 #include <util/pragma_push.def>
 #ifdef _MSC_VER
@@ -72,3 +76,43 @@ void memory_info(std::ostream &out)
       << static_cast<double>(t.size_allocated)/1000000 << "m\n";
 #endif
 }
+
+std::size_t allocated_memory()
+{
+#if defined(__linux__) && defined(__GLIBC__)
+  // NOLINTNEXTLINE(readability/identifiers)
+  struct mallinfo m = mallinfo();
+  // the fields are int and wrap around beyond 2GB
+  return static_cast<std::size_t>(static_cast<unsigned>(m.uordblks)) +
+         static_cast<std::size_t>(static_cast<unsigned>(m.hblkhd));
+#elif defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS pmc;
+  if(GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+    return pmc.WorkingSetSize;
+  return 0;
+#elif defined(__APPLE__)
+  malloc_statistics_t t;
+  malloc_zone_statistics(NULL, &t);
+  return t.size_in_use;
+#else
+  return 0;
+#endif
+}
+
+bool set_memory_limit(std::size_t bytes)
+{
+#ifndef _WIN32
+  // NOLINTNEXTLINE(readability/identifiers)
+  struct rlimit limit;
+  if(getrlimit(RLIMIT_AS, &limit) != 0)
+    return false;
+  // an unprivileged process cannot raise the hard limit
+  if(limit.rlim_max != RLIM_INFINITY && bytes > limit.rlim_max)
+    bytes = limit.rlim_max;
+  limit.rlim_cur = bytes;
+  return setrlimit(RLIMIT_AS, &limit) == 0;
+#else
+  (void)bytes;
+  return false;
+#endif
+}
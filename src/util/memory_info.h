@@ -10,8 +10,19 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_UTIL_MEMORY_INFO_H
 #define CPROVER_UTIL_MEMORY_INFO_H
 
+#include <cstddef>
 #include <iosfwd>
 
 void memory_info(std::ostream &);
 
+/// Return the number of bytes currently allocated by the process, or zero
+/// if this is not known on this platform
+std::size_t allocated_memory();
+
+/// Limit the address space of the process to \p bytes, such that allocations
+/// beyond the limit fail with std::bad_alloc rather than the operating
+/// system killing the process. The limit is inherited by child processes.
+/// \return false if this is not supported on this platform
+bool set_memory_limit(std::size_t bytes);
+
 #endif // CPROVER_UTIL_MEMORY_INFO_H
@@ -107,6 +107,17 @@ class merge_irept
 public:
   void operator()(irept &);
 
+  /// Number of distinct ireps in the container
+  std::size_t size() const
+  {
+    return irep_store.size();
+  }
+
+  void clear()
+  {
+    irep_store.clear();
+  }
+
 protected:
   typedef std::unordered_set<irept, irep_hash> irep_storet;
   irep_storet irep_store;
@@ -119,6 +130,17 @@ class merge_full_irept
 public:
   void operator()(irept &);
 
+  /// Number of distinct ireps in the container
+  std::size_t size() const
+  {
+    return irep_store.size();
+  }
+
+  void clear()
+  {
+    irep_store.clear();
+  }
+
 protected:
   typedef std::unordered_set<irept, irep_full_hash, irep_full_eq> irep_storet;
   irep_storet irep_store;
@@ -141,26 +141,28 @@ bool namespacet::lookup(
   const irep_idt &name,
   const symbolt *&symbol) const
 {
-  symbol_tablet::symbolst::const_iterator it;
-
   if(symbol_table1!=nullptr)
   {
-    it=symbol_table1->symbols.find(name);
+    if(indexed_table1 == nullptr)
+      indexed_table1 = &symbol_table1->get_symbol_table();
 
-    if(it!=symbol_table1->symbols.end())
+    const symbolt *found = indexed_table1->lookup_indexed(name);
+    if(found != nullptr)
     {
-      symbol=&(it->second);
+      symbol = found;
       return false;
     }
   }
 
   if(symbol_table2!=nullptr)
   {
-    it=symbol_table2->symbols.find(name);
+    if(indexed_table2 == nullptr)
+      indexed_table2 = &symbol_table2->get_symbol_table();
 
-    if(it!=symbol_table2->symbols.end())
+    const symbolt *found = indexed_table2->lookup_indexed(name);
+    if(found != nullptr)
     {
-      symbol=&(it->second);
+      symbol = found;
       return false;
     }
   }
@@ -128,6 +128,12 @@ public:
 
 protected:
   const symbol_table_baset *symbol_table1, *symbol_table2;
+
+  /// The symbol tables that \ref symbol_table1 and \ref symbol_table2 wrap,
+  /// which are resolved on first lookup as the symbol tables may still be
+  /// under construction when the namespace is
+  mutable const symbol_tablet *indexed_table1 = nullptr;
+  mutable const symbol_tablet *indexed_table2 = nullptr;
 };
 
 /// A multi namespace is essentially a namespace,
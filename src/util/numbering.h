@@ -9,6 +9,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_UTIL_NUMBERING_H
 #define CPROVER_UTIL_NUMBERING_H
 
+#include <deque>
 #include <map>
 #include <unordered_map>
 #include <vector>
@@ -17,7 +18,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "optional.h"
 
 /// \tparam Map: a map from a key type to some numeric type
-template <typename Map>
+/// \tparam Data: a random-access sequence of keys, indexed by their numbers
+template <typename Map, typename Data = std::vector<typename Map::key_type>>
 class template_numberingt final
 {
 public:
@@ -25,7 +27,7 @@ public:
   using key_type = typename Map::key_type;       // NOLINT
 
 private:
-  using data_typet = std::vector<key_type>; // NOLINT
+  using data_typet = Data; // NOLINT
   data_typet data_;
   Map numbers_;
 
@@ -116,4 +118,13 @@ template <typename Key, typename Hash>
 using hash_numbering = // NOLINT
   template_numberingt<std::unordered_map<Key, std::size_t, Hash>>;
 
+/// A numbering that never moves keys once they have been numbered: numbers
+/// are only ever appended, and references obtained via `operator[]` or `at`
+/// remain valid across calls to `number`.
+template <typename Key, typename Hash>
+using stable_hash_numbering = // NOLINT
+  template_numberingt<
+    std::unordered_map<Key, std::size_t, Hash>,
+    std::deque<Key>>;
+
 #endif // CPROVER_UTIL_NUMBERING_H
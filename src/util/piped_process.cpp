@@ -0,0 +1,413 @@
+/*******************************************************************\
+
+Module: Subprocess Communication via Pipes
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Subprocess Communication via Pipes
+
+#include "piped_process.h"
+
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+
+#include "invariant.h"
+#include "signal_catcher.h"
+
+/// Buffers writes to the standard input of the process
+class piped_processt::input_buffert : public std::streambuf
+{
+public:
+  explicit input_buffert(piped_processt &_process)
+    : process(_process), buffer(1 << 16)
+  {
+    setp(buffer.data(), buffer.data() + buffer.size());
+  }
+
+protected:
+  int_type overflow(int_type c) override
+  {
+    if(!flush_buffer())
+      return traits_type::eof();
+
+    if(!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+      *pptr() = traits_type::to_char_type(c);
+      pbump(1);
+    }
+
+    return traits_type::not_eof(c);
+  }
+
+  int sync() override
+  {
+    return flush_buffer() ? 0 : -1;
+  }
+
+private:
+  piped_processt &process;
+  std::vector<char> buffer;
+
+  bool flush_buffer()
+  {
+    const std::size_t size = static_cast<std::size_t>(pptr() - pbase());
+    setp(buffer.data(), buffer.data() + buffer.size());
+    return size == 0 || process.write_input(buffer.data(), size);
+  }
+};
+
+/// Buffers reads from the standard output of the process
+class piped_processt::output_buffert : public std::streambuf
+{
+public:
+  explicit output_buffert(piped_processt &_process)
+    : process(_process), buffer(1 << 12)
+  {
+    setg(buffer.data(), buffer.data(), buffer.data());
+  }
+
+protected:
+  int_type underflow() override
+  {
+    if(gptr() < egptr())
+      return traits_type::to_int_type(*gptr());
+
+    const std::size_t size =
+      process.read_output(buffer.data(), buffer.size());
+    if(size == 0)
+      return traits_type::eof();
+
+    setg(buffer.data(), buffer.data(), buffer.data() + size);
+    return traits_type::to_int_type(*gptr());
+  }
+
+private:
+  piped_processt &process;
+  std::vector<char> buffer;
+};
+
+#ifndef _WIN32
+static void set_close_on_exec(int fd)
+{
+  fcntl(fd, F_SETFD, fcntl(fd, F_GETFD) | FD_CLOEXEC);
+}
+#endif
+
+piped_processt::piped_processt(
+  const std::vector<std::string> &argv,
+  const std::string &std_error)
+  : input_buffer(new input_buffert(*this)),
+    output_buffer(new output_buffert(*this)),
+    input_stream(input_buffer.get()),
+    output_stream(output_buffer.get())
+{
+  PRECONDITION(!argv.empty());
+
+#ifdef _WIN32
+  input_stream.setstate(std::ios::badbit);
+#else
+  // [0] is the read end, [1] the write end
+  int input_pipe[2], output_pipe[2], exec_status_pipe[2];
+
+  if(pipe(input_pipe) != 0)
+  {
+    input_stream.setstate(std::ios::badbit);
+    return;
+  }
+
+  if(pipe(output_pipe) != 0)
+  {
+    close(input_pipe[0]);
+    close(input_pipe[1]);
+    input_stream.setstate(std::ios::badbit);
+    return;
+  }
+
+  if(pipe(exec_status_pipe) != 0)
+  {
+    close(input_pipe[0]);
+    close(input_pipe[1]);
+    close(output_pipe[0]);
+    close(output_pipe[1]);
+    input_stream.setstate(std::ios::badbit);
+    return;
+  }
+
+  // no other process we start must keep any of these open
+  for(int fd : {input_pipe[0],
+                input_pipe[1],
+                output_pipe[0],
+                output_pipe[1],
+                exec_status_pipe[0],
+                exec_status_pipe[1]})
+  {
+    set_close_on_exec(fd);
+  }
+
+  std::vector<char *> _argv(argv.size() + 1);
+  for(std::size_t i = 0; i < argv.size(); i++)
+    _argv[i] = strdup(argv[i].c_str());
+  _argv[argv.size()] = nullptr;
+
+  pid_t pid = fork();
+
+  if(pid == 0)
+  {
+    remove_signal_catcher();
+
+    dup2(input_pipe[0], STDIN_FILENO);
+    dup2(output_pipe[1], STDOUT_FILENO);
+
+    if(!std_error.empty())
+    {
+      int stderr_fd =
+        open(std_error.c_str(), O_CREAT | O_WRONLY | O_TRUNC, 0600);
+      if(stderr_fd != -1)
+        dup2(stderr_fd, STDERR_FILENO);
+    }
+
+    execvp(argv[0].c_str(), _argv.data());
+
+    // report the failure to the parent
+    int error = errno;
+    if(write(exec_status_pipe[1], &error, sizeof(error)) < 0)
+    {
+      // there is nobody left to report to
+    }
+    _exit(127);
+  }
+
+  for(char *arg : _argv)
+    free(arg);
+
+  close(input_pipe[0]);
+  close(output_pipe[1]);
+  close(exec_status_pipe[1]);
+
+  if(pid < 0)
+  {
+    close(input_pipe[1]);
+    close(output_pipe[0]);
+    close(exec_status_pipe[0]);
+    input_stream.setstate(std::ios::badbit);
+    return;
+  }
+
+  // the status pipe is closed by a successful exec
+  int error;
+  ssize_t n;
+  do
+    n = read(exec_status_pipe[0], &error, sizeof(error));
+  while(n < 0 && errno == EINTR);
+  close(exec_status_pipe[0]);
+
+  if(n > 0)
+  {
+    close(input_pipe[1]);
+    close(output_pipe[0]);
+    while(waitpid(pid, nullptr, 0) == -1 && errno == EINTR)
+    {
+    }
+    input_stream.setstate(std::ios::badbit);
+    return;
+  }
+
+  child_pid = pid;
+  input_fd = input_pipe[1];
+  output_fd = output_pipe[0];
+
+  // writes must not block while the process waits for us to read its output
+  fcntl(input_fd, F_SETFL, fcntl(input_fd, F_GETFL) | O_NONBLOCK);
+#endif
+}
+
+piped_processt::~piped_processt()
+{
+  wait();
+}
+
+bool piped_processt::is_supported()
+{
+#ifdef _WIN32
+  return false;
+#else
+  return true;
+#endif
+}
+
+void piped_processt::close_input()
+{
+  if(input_fd == -1)
+    return;
+
+  input_stream.flush();
+
+#ifndef _WIN32
+  close(input_fd);
+#endif
+  input_fd = -1;
+}
+
+int piped_processt::wait()
+{
+  if(child_pid == -1)
+    return exit_status;
+
+  close_input();
+
+#ifndef _WIN32
+  // keep the remaining output, the process may block until it is read
+  while(output_fd != -1)
+    buffer_output();
+
+  int status;
+  while(waitpid(child_pid, &status, 0) == -1)
+  {
+    if(errno != EINTR)
+    {
+      status = -1;
+      break;
+    }
+  }
+
+  if(status != -1 && WIFEXITED(status))
+    exit_status = WEXITSTATUS(status);
+#endif
+
+  child_pid = -1;
+  return exit_status;
+}
+
+bool piped_processt::write_input(const char *data, std::size_t size)
+{
+#ifdef _WIN32
+  return false;
+#else
+  // a write to a process that exited must not raise SIGPIPE
+  sigset_t sigpipe_mask, old_mask;
+  sigemptyset(&sigpipe_mask);
+  sigaddset(&sigpipe_mask, SIGPIPE);
+  sigprocmask(SIG_BLOCK, &sigpipe_mask, &old_mask);
+
+  while(size > 0 && input_fd != -1)
+  {
+    pollfd fds[2] = {{input_fd, POLLOUT, 0}, {output_fd, POLLIN, 0}};
+
+    if(poll(fds, 2, -1) < 0)
+    {
+      if(errno == EINTR)
+        continue;
+      break;
+    }
+
+    if(fds[1].revents != 0)
+      buffer_output();
+
+    if(fds[0].revents & POLLOUT)
+    {
+      ssize_t written = write(input_fd, data, size);
+      if(written >= 0)
+      {
+        data += written;
+        size -= static_cast<std::size_t>(written);
+      }
+      else if(errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK)
+      {
+        close(input_fd);
+        input_fd = -1;
+      }
+    }
+    else if(fds[0].revents & (POLLERR | POLLHUP | POLLNVAL))
+    {
+      close(input_fd);
+      input_fd = -1;
+    }
+  }
+
+  // discard the SIGPIPE raised by a failed write, if any
+  sigset_t pending;
+  sigpending(&pending);
+  if(sigismember(&pending, SIGPIPE))
+  {
+    int signal_number;
+    sigwait(&sigpipe_mask, &signal_number);
+  }
+
+  sigprocmask(SIG_SETMASK, &old_mask, nullptr);
+
+  return size == 0;
+#endif
+}
+
+std::size_t piped_processt::read_output(char *data, std::size_t size)
+{
+  if(pending_output_position < pending_output.size())
+  {
+    const std::size_t n =
+      std::min(size, pending_output.size() - pending_output_position);
+    std::copy_n(pending_output.data() + pending_output_position, n, data);
+    pending_output_position += n;
+
+    if(pending_output_position == pending_output.size())
+    {
+      pending_output.clear();
+      pending_output_position = 0;
+    }
+
+    return n;
+  }
+
+#ifndef _WIN32
+  while(output_fd != -1)
+  {
+    ssize_t n = read(output_fd, data, size);
+    if(n > 0)
+      return static_cast<std::size_t>(n);
+    if(n < 0 && errno == EINTR)
+      continue;
+
+    // end of file or error
+    close(output_fd);
+    output_fd = -1;
+  }
+#endif
+
+  return 0;
+}
+
+void piped_processt::buffer_output()
+{
+#ifndef _WIN32
+  if(output_fd == -1)
+    return;
+
+  char buffer[1 << 12];
+  ssize_t n;
+  do
+    n = read(output_fd, buffer, sizeof(buffer));
+  while(n < 0 && errno == EINTR);
+
+  if(n > 0)
+    pending_output.append(buffer, static_cast<std::size_t>(n));
+  else
+  {
+    close(output_fd);
+    output_fd = -1;
+  }
+#endif
+}
@@ -0,0 +1,109 @@
+/*******************************************************************\
+
+Module: Subprocess Communication via Pipes
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Subprocess Communication via Pipes
+
+#ifndef CPROVER_UTIL_PIPED_PROCESS_H
+#define CPROVER_UTIL_PIPED_PROCESS_H
+
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/// A child process whose standard input and standard output are connected
+/// to the parent by pipes, so that the child can consume input while the
+/// parent is still producing it.
+/// Whatever the child writes to its standard output while the parent is
+/// blocked writing to its standard input is buffered, hence a child that
+/// interleaves reading and writing cannot cause a deadlock.
+class piped_processt
+{
+public:
+  /// Start the executable `argv[0]`, which is searched for in the `PATH`.
+  /// Use \ref started to check whether this succeeded.
+  /// \param argv: command line of the process
+  /// \param std_error: name of a file the standard error of the process is
+  ///   redirected to; the empty string retains the parent's standard error
+  explicit piped_processt(
+    const std::vector<std::string> &argv,
+    const std::string &std_error = "");
+
+  piped_processt(const piped_processt &) = delete;
+  piped_processt &operator=(const piped_processt &) = delete;
+
+  /// Closes the standard input of the process and waits for it to exit
+  ~piped_processt();
+
+  /// Return true if pipes to processes are supported on this platform
+  static bool is_supported();
+
+  /// Return true if the executable could be started
+  bool started() const
+  {
+    return child_pid != -1;
+  }
+
+  /// The standard input of the process. The stream goes bad once the
+  /// process stops reading.
+  std::ostream &input()
+  {
+    return input_stream;
+  }
+
+  /// The standard output of the process
+  std::istream &output()
+  {
+    return output_stream;
+  }
+
+  /// Flush and close the standard input, signalling end of file to the
+  /// process
+  void close_input();
+
+  /// Close the standard input and wait for the process to exit. Output of
+  /// the process that has not been read remains available.
+  /// \return exit status of the process, or -1 if it did not exit normally
+  ///   or was never started
+  int wait();
+
+protected:
+  class input_buffert;
+  class output_buffert;
+
+  /// Write all of \p size bytes at \p data to the standard input of the
+  /// process, meanwhile buffering any output the process produces.
+  /// \return false if the process stopped reading
+  bool write_input(const char *data, std::size_t size);
+
+  /// Read up to \p size bytes of output into \p data, blocking until at
+  /// least one byte is available.
+  /// \return number of bytes read, zero at end of file
+  std::size_t read_output(char *data, std::size_t size);
+
+  /// Move whatever output is available into \ref pending_output
+  void buffer_output();
+
+  int child_pid = -1;
+  int input_fd = -1;
+  int output_fd = -1;
+  int exit_status = -1;
+
+  /// Output the process produced while input was written
+  std::string pending_output;
+  std::size_t pending_output_position = 0;
+
+  std::unique_ptr<std::streambuf> input_buffer;
+  std::unique_ptr<std::streambuf> output_buffer;
+  std::ostream input_stream;
+  std::istream output_stream;
+};
+
+#endif // CPROVER_UTIL_PIPED_PROCESS_H
@@ -15,6 +15,7 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "std_expr.h"
 
 #define SYMEX_DYNAMIC_PREFIX "symex_dynamic::"
+#define SYMEX_SUMMARY_OBJECT_PREFIX SYMEX_DYNAMIC_PREFIX "summary_object"
 
 exprt same_object(const exprt &p1, const exprt &p2);
 exprt deallocated(const exprt &pointer, const namespacet &);
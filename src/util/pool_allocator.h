@@ -0,0 +1,175 @@
+/*******************************************************************\
+
+Module: Pool Allocator for Fixed-Size Blocks
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Pool Allocator for Fixed-Size Blocks
+
+#ifndef CPROVER_UTIL_POOL_ALLOCATOR_H
+#define CPROVER_UTIL_POOL_ALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+
+/// A per-thread pool of blocks of `block_size` bytes. Blocks are carved out
+/// of chunks of about 64KiB, and freed blocks are kept in a free list for
+/// reuse, such that allocating and freeing a block usually only takes a
+/// couple of pointer operations.
+///
+/// The state of the pool is trivially destructible: chunks are not returned
+/// when a thread ends, which permits objects with static storage duration to
+/// free their blocks during program exit. For the same reason a block may be
+/// freed by a thread other than the one that allocated it: it is then reused
+/// from the free list of the freeing thread, and only \ref live_blocks of
+/// both threads is off.
+template <std::size_t block_size, std::size_t alignment = alignof(void *)>
+class fixed_size_poolt
+{
+  static_assert(
+    alignment <= alignof(std::max_align_t),
+    "chunks are only aligned for fundamental types");
+
+public:
+  /// Size of a block, taking into account that a free block holds a pointer
+  static constexpr std::size_t size =
+    ((block_size < sizeof(void *) ? sizeof(void *) : block_size) + alignment -
+     1) /
+    alignment * alignment;
+
+  static constexpr std::size_t blocks_per_chunk =
+    size >= (1 << 16) / 4 ? 4 : (1 << 16) / size;
+
+  static void *allocate()
+  {
+    statet &s = state;
+    ++s.live_blocks;
+
+    if(s.free_list != nullptr)
+    {
+      free_blockt *block = s.free_list;
+      s.free_list = block->next;
+      return block;
+    }
+
+    if(s.unused == s.unused_end)
+      new_chunk(s);
+
+    void *block = s.unused;
+    s.unused += size;
+    return block;
+  }
+
+  static void deallocate(void *p)
+  {
+    statet &s = state;
+    --s.live_blocks;
+
+    free_blockt *block = static_cast<free_blockt *>(p);
+    block->next = s.free_list;
+    s.free_list = block;
+  }
+
+  /// Number of blocks allocated by this thread minus those freed by it
+  static std::size_t live_blocks()
+  {
+    return state.live_blocks;
+  }
+
+protected:
+  struct free_blockt
+  {
+    free_blockt *next;
+  };
+
+  struct chunkt
+  {
+    chunkt *next;
+  };
+
+  /// Blocks start behind the chunk header, with the required alignment
+  static constexpr std::size_t chunk_header_size =
+    (sizeof(chunkt) + alignment - 1) / alignment * alignment;
+
+  struct statet
+  {
+    free_blockt *free_list;
+    /// Part of the most recent chunk that has not been handed out yet
+    char *unused;
+    char *unused_end;
+    chunkt *chunks;
+    std::size_t live_blocks;
+  };
+
+  static thread_local statet state;
+
+  static void new_chunk(statet &s)
+  {
+    char *memory = static_cast<char *>(
+      ::operator new(chunk_header_size + blocks_per_chunk * size));
+    chunkt *chunk = reinterpret_cast<chunkt *>(memory);
+    chunk->next = s.chunks;
+    s.chunks = chunk;
+    s.unused = memory + chunk_header_size;
+    s.unused_end = s.unused + blocks_per_chunk * size;
+  }
+};
+
+template <std::size_t block_size, std::size_t alignment>
+thread_local typename fixed_size_poolt<block_size, alignment>::statet
+  fixed_size_poolt<block_size, alignment>::state;
+
+/// Allocator for node-based containers such as `std::map`, which takes single
+/// objects from a \ref fixed_size_poolt and falls back to `operator new` for
+/// arrays.
+template <typename T>
+class pool_allocatort
+{
+public:
+  typedef T value_type;
+
+  pool_allocatort() = default;
+
+  template <typename U>
+  // NOLINTNEXTLINE(runtime/explicit)
+  pool_allocatort(const pool_allocatort<U> &)
+  {
+  }
+
+  T *allocate(std::size_t n)
+  {
+    if(n == 1)
+      return static_cast<T *>(poolt<T>::allocate());
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T *p, std::size_t n)
+  {
+    if(n == 1)
+      poolt<T>::deallocate(p);
+    else
+      ::operator delete(p);
+  }
+
+  template <typename U>
+  bool operator==(const pool_allocatort<U> &) const
+  {
+    return true;
+  }
+
+  template <typename U>
+  bool operator!=(const pool_allocatort<U> &) const
+  {
+    return false;
+  }
+
+protected:
+  // not a typedef, as T may be incomplete when the allocator is instantiated
+  template <typename U>
+  using poolt = fixed_size_poolt<sizeof(U), alignof(U)>;
+};
+
+#endif // CPROVER_UTIL_POOL_ALLOCATOR_H
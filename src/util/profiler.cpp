@@ -0,0 +1,177 @@
+/*******************************************************************\
+
+Module: Time and Memory Profiling of Phases
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Time and Memory Profiling of Phases
+
+#include "profiler.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include "cmdline.h"
+#include "invariant.h"
+#include "json.h"
+#include "memory_info.h"
+#include "message.h"
+
+constexpr std::chrono::microseconds profilert::min_event_duration;
+
+void profilert::enable(bool _record_events)
+{
+  if(!enabled)
+    enabled_at = clockt::now();
+
+  enabled = true;
+  record_events = record_events || _record_events;
+}
+
+void profilert::begin(
+  const char *category,
+  const irep_idt &name,
+  bool measure_memory)
+{
+  PRECONDITION(enabled);
+  open_phases.push_back(
+    {category,
+     name,
+     clockt::now(),
+     measure_memory,
+     measure_memory ? allocated_memory() : 0});
+}
+
+void profilert::end()
+{
+  PRECONDITION(!open_phases.empty());
+  const open_phaset &phase = open_phases.back();
+
+  const clockt::duration duration = clockt::now() - phase.start;
+  const long long memory_delta =
+    phase.measure_memory ? static_cast<long long>(allocated_memory()) -
+                             static_cast<long long>(phase.memory)
+                         : 0;
+
+  statisticst &phase_statistics =
+    statistics[std::make_pair(phase.category, phase.name)];
+  ++phase_statistics.count;
+  phase_statistics.duration += duration;
+  phase_statistics.memory_delta += memory_delta;
+
+  if(record_events && duration >= min_event_duration)
+  {
+    events.push_back(
+      {phase.category,
+       phase.name,
+       phase.start - enabled_at,
+       duration,
+       memory_delta});
+  }
+
+  open_phases.pop_back();
+}
+
+static std::string to_microseconds(profilert::clockt::duration duration)
+{
+  return std::to_string(
+    std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+}
+
+void profilert::output_json(std::ostream &out) const
+{
+  // longest phases first
+  std::vector<statistics_mapt::const_iterator> sorted;
+  sorted.reserve(statistics.size());
+  for(auto it = statistics.begin(); it != statistics.end(); ++it)
+    sorted.push_back(it);
+  std::stable_sort(
+    sorted.begin(),
+    sorted.end(),
+    [](statistics_mapt::const_iterator a, statistics_mapt::const_iterator b) {
+      return a->second.duration > b->second.duration;
+    });
+
+  json_arrayt phases;
+  for(const auto &entry : sorted)
+  {
+    phases.push_back(json_objectt(
+      {{"category", json_stringt(entry->first.first)},
+       {"name", json_stringt(entry->first.second)},
+       {"count", json_numbert(std::to_string(entry->second.count))},
+       {"microseconds", json_numbert(to_microseconds(entry->second.duration))},
+       {"memoryDelta",
+        json_numbert(std::to_string(entry->second.memory_delta))}}));
+  }
+
+  out << json_objectt({{"phases", phases}}) << '\n';
+}
+
+void profilert::output_trace(std::ostream &out) const
+{
+  json_arrayt trace_events;
+  for(const auto &event : events)
+  {
+    trace_events.push_back(json_objectt(
+      {{"name", json_stringt(event.name)},
+       {"cat", json_stringt(event.category)},
+       {"ph", json_stringt("X")},
+       {"ts", json_numbert(to_microseconds(event.start))},
+       {"dur", json_numbert(to_microseconds(event.duration))},
+       {"pid", json_numbert("0")},
+       {"tid", json_numbert("0")},
+       {"args",
+        json_objectt(
+          {{"memoryDelta",
+            json_numbert(std::to_string(event.memory_delta))}})}}));
+  }
+
+  out << json_objectt({{"traceEvents", trace_events},
+                       {"displayTimeUnit", json_stringt("ms")}})
+      << '\n';
+}
+
+profile_outputt::profile_outputt(
+  const cmdlinet &cmdline,
+  message_handlert &_message_handler)
+  : json_file(cmdline.get_value("profile-json")),
+    trace_file(cmdline.get_value("profile-trace")),
+    message_handler(_message_handler)
+{
+  if(!json_file.empty() || !trace_file.empty())
+    get_profiler().enable(!trace_file.empty());
+}
+
+/// Write \p profiler to \p file_name using \p output
+static void write_profile(
+  const std::string &file_name,
+  const profilert &profiler,
+  void (profilert::*output)(std::ostream &) const,
+  message_handlert &message_handler)
+{
+  std::ofstream out(file_name);
+  if(!out)
+  {
+    messaget(message_handler).error()
+      << "failed to write profile to '" << file_name << "'" << messaget::eom;
+    return;
+  }
+
+  (profiler.*output)(out);
+}
+
+profile_outputt::~profile_outputt()
+{
+  const profilert &profiler = get_profiler();
+
+  if(!json_file.empty())
+    write_profile(
+      json_file, profiler, &profilert::output_json, message_handler);
+
+  if(!trace_file.empty())
+    write_profile(
+      trace_file, profiler, &profilert::output_trace, message_handler);
+}
@@ -0,0 +1,197 @@
+/*******************************************************************\
+
+Module: Time and Memory Profiling of Phases
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Time and Memory Profiling of Phases
+
+#ifndef CPROVER_UTIL_PROFILER_H
+#define CPROVER_UTIL_PROFILER_H
+
+#include <chrono>
+#include <cstring>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "irep.h"
+
+#define OPT_PROFILE "(profile-json):(profile-trace):"
+
+#define HELP_PROFILE                                                           \
+  " --profile-json file          write the time and memory used by each\n"    \
+  "                              phase to file in JSON\n"                      \
+  " --profile-trace file         write the phases to file in Chrome trace\n"   \
+  "                              format\n"
+
+class cmdlinet;
+class message_handlert;
+
+/// Collects the duration of, and the change in allocated memory during,
+/// nested phases of a run, such as parsing, symbolic execution of a function
+/// or flattening an expression. Phases are identified by a category and a
+/// name, and are measured using \ref profile_scopet. There is a single,
+/// global profiler, see \ref get_profiler. Unless it is enabled, measuring a
+/// phase costs a single test.
+class profilert
+{
+public:
+  typedef std::chrono::steady_clock clockt;
+
+  /// Phases shorter than this are included in the statistics, but not
+  /// recorded as events, to keep traces of a reasonable size
+  static constexpr std::chrono::microseconds min_event_duration{100};
+
+  /// A completed phase
+  struct eventt
+  {
+    const char *category;
+    irep_idt name;
+    /// Start, relative to when the profiler was enabled
+    clockt::duration start;
+    clockt::duration duration;
+    /// Change in allocated memory, in bytes
+    long long memory_delta;
+  };
+
+  /// Totals for all phases with the same category and name
+  struct statisticst
+  {
+    std::size_t count = 0;
+    clockt::duration duration{0};
+    long long memory_delta = 0;
+  };
+
+  bool is_enabled() const
+  {
+    return enabled;
+  }
+
+  /// Start collecting measurements
+  /// \param record_events: keep the individual phases, and not only their
+  ///   statistics
+  void enable(bool record_events);
+
+  /// Start a phase, which is nested in the phase most recently begun but not
+  /// yet ended
+  /// \param category: kind of the phase, which must be a string literal
+  /// \param name: name of the phase
+  /// \param measure_memory: determine the change in allocated memory, which
+  ///   is too costly for phases that are very frequent
+  void begin(const char *category, const irep_idt &name, bool measure_memory);
+
+  /// End the innermost phase
+  void end();
+
+  const std::vector<eventt> &get_events() const
+  {
+    return events;
+  }
+
+  typedef std::pair<const char *, irep_idt> phase_keyt;
+
+  /// Orders categories by their contents, as the same string literal may
+  /// have several addresses
+  struct phase_key_lesst
+  {
+    bool operator()(const phase_keyt &a, const phase_keyt &b) const
+    {
+      const int c = std::strcmp(a.first, b.first);
+      return c < 0 || (c == 0 && a.second < b.second);
+    }
+  };
+
+  typedef std::map<phase_keyt, statisticst, phase_key_lesst> statistics_mapt;
+
+  const statistics_mapt &get_statistics() const
+  {
+    return statistics;
+  }
+
+  /// Write the statistics as JSON
+  void output_json(std::ostream &) const;
+
+  /// Write the events in the Chrome trace event format, as understood by
+  /// chrome://tracing and similar viewers
+  void output_trace(std::ostream &) const;
+
+protected:
+  bool enabled = false;
+  bool record_events = false;
+  clockt::time_point enabled_at;
+
+  struct open_phaset
+  {
+    const char *category;
+    irep_idt name;
+    clockt::time_point start;
+    bool measure_memory;
+    std::size_t memory;
+  };
+
+  std::vector<open_phaset> open_phases;
+  std::vector<eventt> events;
+  statistics_mapt statistics;
+};
+
+/// Get a reference to the global profiler.
+inline profilert &get_profiler()
+{
+  static profilert profiler;
+  return profiler;
+}
+
+/// Measures the lifetime of this object as a phase of the global profiler
+class profile_scopet
+{
+public:
+  /// \param category: kind of the phase, which must be a string literal
+  /// \param name: name of the phase
+  /// \param measure_memory: determine the change in allocated memory
+  profile_scopet(
+    const char *category,
+    const irep_idt &name,
+    bool measure_memory = true)
+    : active(get_profiler().is_enabled())
+  {
+    if(active)
+      get_profiler().begin(category, name, measure_memory);
+  }
+
+  profile_scopet(const profile_scopet &) = delete;
+  profile_scopet &operator=(const profile_scopet &) = delete;
+
+  ~profile_scopet()
+  {
+    if(active)
+      get_profiler().end();
+  }
+
+private:
+  const bool active;
+};
+
+/// Enables the global profiler if requested by the `--profile-json` or
+/// `--profile-trace` option, see \ref HELP_PROFILE, and writes the requested
+/// files when it is destroyed.
+class profile_outputt
+{
+public:
+  profile_outputt(const cmdlinet &, message_handlert &);
+  ~profile_outputt();
+
+  profile_outputt(const profile_outputt &) = delete;
+  profile_outputt &operator=(const profile_outputt &) = delete;
+
+private:
+  std::string json_file;
+  std::string trace_file;
+  message_handlert &message_handler;
+};
+
+#endif // CPROVER_UTIL_PROFILER_H
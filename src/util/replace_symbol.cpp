@@ -52,8 +52,38 @@ bool replace_symbolt::replace_symbol_expr(symbol_exprt &s) const
   return false;
 }
 
+replace_symbolt::replace_scopet::replace_scopet(
+  const replace_symbolt &replace_symbol)
+  : replace_symbol(replace_symbol)
+{
+  ++replace_symbol.replace_depth;
+}
+
+replace_symbolt::replace_scopet::~replace_scopet()
+{
+  if(--replace_symbol.replace_depth == 0 &&
+     !replace_symbol.unchanged_nodes.empty())
+  {
+    replace_symbol.unchanged_nodes.clear();
+    replace_symbol.unchanged_nodes_owners.clear();
+  }
+}
+
+bool replace_symbolt::is_unchanged(const irept &irep) const
+{
+  return replace_depth != 0 && unchanged_nodes.count(&irep.read()) != 0;
+}
+
+void replace_symbolt::mark_unchanged(const irept &irep) const
+{
+  if(replace_depth != 0 && unchanged_nodes.insert(&irep.read()).second)
+    unchanged_nodes_owners.push_back(irep);
+}
+
 bool replace_symbolt::replace(exprt &dest) const
 {
+  const replace_scopet scope(*this);
+
   bool result=true; // unchanged
 
   // first look at type
@@ -135,9 +165,15 @@ bool replace_symbolt::have_to_replace(const exprt &dest) const
     return replaces_symbol(identifier);
   }
 
-  forall_operands(it, dest)
-    if(have_to_replace(*it))
-      return true;
+  if(dest.has_operands())
+  {
+    if(is_unchanged(dest))
+      return false;
+
+    forall_operands(it, dest)
+      if(have_to_replace(*it))
+        return true;
+  }
 
   const irept &c_sizeof_type=dest.find(ID_C_c_sizeof_type);
 
@@ -151,11 +187,16 @@ bool replace_symbolt::have_to_replace(const exprt &dest) const
     if(have_to_replace(static_cast<const typet &>(va_arg_type)))
       return true;
 
+  if(dest.has_operands())
+    mark_unchanged(dest);
+
   return false;
 }
 
 bool replace_symbolt::replace(typet &dest) const
 {
+  const replace_scopet scope(*this);
+
   if(!have_to_replace(dest))
     return true;
 
@@ -203,6 +244,12 @@ bool replace_symbolt::have_to_replace(const typet &dest) const
   if(expr_map.empty())
     return false;
 
+  // types without subtypes or components are not worth remembering
+  const bool memoize = dest.has_subtype() || dest.id() == ID_struct ||
+                       dest.id() == ID_union || dest.id() == ID_code;
+  if(memoize && is_unchanged(dest))
+    return false;
+
   if(dest.has_subtype())
     if(have_to_replace(dest.subtype()))
       return true;
@@ -232,7 +279,13 @@ bool replace_symbolt::have_to_replace(const typet &dest) const
         return true;
   }
   else if(dest.id()==ID_array)
-    return have_to_replace(to_array_type(dest).size());
+  {
+    if(have_to_replace(to_array_type(dest).size()))
+      return true;
+  }
+
+  if(memoize)
+    mark_unchanged(dest);
 
   return false;
 }
@@ -258,6 +311,8 @@ bool unchecked_replace_symbolt::replace_symbol_expr(symbol_exprt &s) const
 
 bool address_of_aware_replace_symbolt::replace(exprt &dest) const
 {
+  const replace_scopet scope(*this);
+
   const exprt &const_dest(dest);
   if(!require_lvalue && const_dest.id() != ID_address_of)
     return unchecked_replace_symbolt::replace(dest);
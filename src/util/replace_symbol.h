@@ -18,6 +18,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "expr.h"
 
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 /// Replace expression or type symbols by an expression or type, respectively.
 /// The resolved type of the symbol must match the type of the replacement.
@@ -93,6 +95,32 @@ protected:
 
   bool have_to_replace(const exprt &dest) const;
   bool have_to_replace(const typet &type) const;
+
+  /// Marks the outermost call to \ref replace, within which
+  /// \ref have_to_replace remembers the nodes it found to contain no symbol
+  /// to replace. Such nodes are never written to while replacing, and
+  /// remembering them avoids traversing them again from each enclosing
+  /// level as well as once per occurrence in an expression with sharing.
+  class replace_scopet
+  {
+  public:
+    explicit replace_scopet(const replace_symbolt &replace_symbol);
+    ~replace_scopet();
+
+  private:
+    const replace_symbolt &replace_symbol;
+  };
+
+private:
+  mutable std::size_t replace_depth = 0;
+  /// addresses of the nodes known to contain no symbol to replace
+  mutable std::unordered_set<const void *> unchanged_nodes;
+  /// keeps the nodes in \ref unchanged_nodes alive such that their addresses
+  /// are not reused within the outermost call to \ref replace
+  mutable std::vector<irept> unchanged_nodes_owners;
+
+  bool is_unchanged(const irept &) const;
+  void mark_unchanged(const irept &) const;
 };
 
 class unchecked_replace_symbolt : public replace_symbolt
@@ -16,6 +16,7 @@ Author: Daniel Poetzl
 #include <iostream>
 #endif
 
+#include <algorithm>
 #include <functional>
 #include <map>
 #include <memory>
@@ -302,6 +303,21 @@ public:
   ///   unsure if you need to make a change, use \ref find beforehand)
   void update(const key_type &k, std::function<void(mapped_type &)> mutator);
 
+  /// Replace the contents of the map by the key-value pairs in the range from
+  /// \p begin to \p end, which must not contain duplicate keys. The trie is
+  /// built bottom-up from the pairs ordered by their hash codes, such that
+  /// each node is created exactly once, whereas inserting the pairs one by
+  /// one walks the tree from the root for each of them and repeatedly moves
+  /// leaves further down. Pass `std::move_iterator`s to move the values into
+  /// the map.
+  ///
+  /// Complexity: O(N * log(N))
+  ///
+  /// \param begin: begin iterator over key-value pairs
+  /// \param end: end iterator over key-value pairs
+  template <class Iterator>
+  void assign(Iterator begin, Iterator end);
+
   /// Find element
   ///
   /// Complexity:
@@ -552,6 +568,23 @@ protected:
     const nodet &n,
     std::function<void(const key_type &k, const mapped_type &m)> f) const;
 
+  /// Create the children of the inner node \p inner at depth \p level for
+  /// the elements in the range from \p first to \p last. This method is
+  /// called by `assign()`.
+  ///
+  /// \param inner: empty inner node
+  /// \param level: depth of \p inner in the tree
+  /// \param first: begin iterator over pairs of the path of an element
+  ///   through the tree (see `assign()`) and an iterator to the element
+  /// \param last: end iterator over such pairs, which must be ordered by
+  ///   their paths and all share the first \p level chunks of their paths
+  template <class ItemIterator>
+  void build(
+    nodet &inner,
+    const std::size_t level,
+    ItemIterator first,
+    ItemIterator last);
+
   /// Add a delta item to the delta view if the value in the \p container (which
   /// must only contain a single leaf) is not shared with any of the values in
   /// the subtree below \p inner. This method is called by `get_delta_view()`
@@ -1307,7 +1340,7 @@ SHARING_MAPT4(valueU, void)
       if(level < levels - 1)
       {
         // Create leaf
-        child.make_leaf(k, m);
+        child.make_leaf(k, std::forward<valueU>(m));
       }
       else
       {
@@ -1382,6 +1415,84 @@ SHARING_MAPT(void)
     "method to check if an update is needed beforehand");
 }
 
+SHARING_MAPT4(Iterator, void)::assign(Iterator begin, Iterator end)
+{
+  clear();
+
+  // The path of an element through the tree is given by the chunks of its
+  // hash code, starting from the least significant one. We reverse the order
+  // of the chunks such that ordering the paths as numbers groups the elements
+  // below each node together.
+  std::vector<std::pair<std::size_t, Iterator>> items;
+
+  for(Iterator it = begin; it != end; it++)
+  {
+    std::size_t key = hash()((*it).first);
+    std::size_t path = 0;
+
+    for(std::size_t level = 0; level < levels; level++)
+    {
+      path = (path << chunk) | (key & mask);
+      key >>= chunk;
+    }
+
+    items.emplace_back(path, it);
+  }
+
+  if(items.empty())
+    return;
+
+  std::sort(
+    items.begin(),
+    items.end(),
+    [](
+      const std::pair<std::size_t, Iterator> &a,
+      const std::pair<std::size_t, Iterator> &b) { return a.first < b.first; });
+
+  build(map, 0, items.begin(), items.end());
+
+  num = items.size();
+}
+
+SHARING_MAPT4(ItemIterator, void)
+::build(
+  nodet &inner,
+  const std::size_t level,
+  ItemIterator first,
+  ItemIterator last)
+{
+  const std::size_t shift = chunk * (levels - 1 - level);
+
+  while(first != last)
+  {
+    const std::size_t bit = (first->first >> shift) & mask;
+
+    ItemIterator group_end = std::next(first);
+    while(group_end != last && ((group_end->first >> shift) & mask) == bit)
+      group_end++;
+
+    nodet &child = inner.add_child(bit);
+    SM_ASSERT(child.empty());
+
+    if(level == levels - 1)
+    {
+      // Hash collision, all remaining elements go into a container
+      for(; first != group_end; first++)
+        child.place_leaf((*first->second).first, (*first->second).second);
+    }
+    else if(std::next(first) == group_end)
+    {
+      child.make_leaf((*first->second).first, (*first->second).second);
+      first++;
+    }
+    else
+    {
+      build(child, level + 1, first, group_end);
+      first = group_end;
+    }
+  }
+}
+
 SHARING_MAPT2(optionalt<std::reference_wrapper<const, mapped_type>>)::find(
   const key_type &k) const
 {
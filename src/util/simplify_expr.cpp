@@ -38,32 +38,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <iostream>
 #endif
 
+#include "simplify_expr_cache.h"
 #include "simplify_expr_class.h"
 
-// #define USE_CACHE
-
-#ifdef USE_CACHE
-struct simplify_expr_cachet
-{
-public:
-  #if 1
-  typedef std::unordered_map<
-    exprt, exprt, irep_full_hash, irep_full_eq> containert;
-  #else
-  typedef std::unordered_map<exprt, exprt, irep_hash> containert;
-  #endif
-
-  containert container_normal;
-
-  containert &container()
-  {
-    return container_normal;
-  }
-};
-
-simplify_expr_cachet simplify_expr_cache;
-#endif
-
 simplify_exprt::resultt<> simplify_exprt::simplify_abs(const abs_exprt &expr)
 {
   if(expr.op().is_constant())
@@ -1963,18 +1940,25 @@ simplify_exprt::simplify_byte_extract(const byte_extract_exprt &expr)
     if(!const_bits_opt.has_value())
       return unchanged(expr);
 
-    std::string const_bits=const_bits_opt.value();
+    const std::string &const_bits = const_bits_opt.value();
 
     DATA_INVARIANT(!const_bits.empty(), "bit representation must be non-empty");
 
-    // double the string until we have sufficiently many bits
-    while(mp_integer(const_bits.size()) < *offset * 8 + *el_size)
-      const_bits+=const_bits;
-
-    std::string el_bits = std::string(
-      const_bits,
-      numeric_cast_v<std::size_t>(*offset * 8),
-      numeric_cast_v<std::size_t>(*el_size));
+    // The bits of the array repeat those of the element, take the ones at the
+    // offset from that pattern rather than building the array up to there,
+    // which is huge for large zero-initialized buffers.
+    const std::size_t el_bits_size = numeric_cast_v<std::size_t>(*el_size);
+    std::size_t bit = numeric_cast_v<std::size_t>(
+      (*offset * 8) % mp_integer(const_bits.size()));
+    std::string el_bits;
+    el_bits.reserve(el_bits_size);
+    while(el_bits.size() < el_bits_size)
+    {
+      const std::size_t chunk =
+        std::min(el_bits_size - el_bits.size(), const_bits.size() - bit);
+      el_bits.append(const_bits, bit, chunk);
+      bit = 0;
+    }
 
     auto tmp = bits2expr(
       el_bits, expr.type(), expr.id() == ID_byte_extract_little_endian);
@@ -2602,25 +2586,6 @@ simplify_exprt::resultt<> simplify_exprt::simplify_node(exprt node)
 
 simplify_exprt::resultt<> simplify_exprt::simplify_rec(const exprt &expr)
 {
-  // look up in cache
-
-  #ifdef USE_CACHE
-  std::pair<simplify_expr_cachet::containert::iterator, bool>
-    cache_result=simplify_expr_cache.container().
-      insert(std::pair<exprt, exprt>(expr, exprt()));
-
-  if(!cache_result.second) // found!
-  {
-    const exprt &new_expr=cache_result.first->second;
-
-    if(new_expr.id().empty())
-      return true; // no change
-
-    expr=new_expr;
-    return false;
-  }
-  #endif
-
   // We work on a copy to prevent unnecessary destruction of sharing.
   exprt tmp=expr;
   bool no_change = simplify_node_preorder(tmp);
@@ -2659,11 +2624,6 @@ simplify_exprt::resultt<> simplify_exprt::simplify_rec(const exprt &expr)
   {
     POSTCONDITION(as_const(tmp).type() == expr.type());
 
-#ifdef USE_CACHE
-    // save in cache
-    cache_result.first->second = tmp;
-#endif
-
     return std::move(tmp);
   }
 }
@@ -2675,7 +2635,23 @@ bool simplify_exprt::simplify(exprt &expr)
   if(debug_on)
     std::cout << "TO-SIMP " << format(expr) << "\n";
 #endif
+  if(cache != nullptr)
+  {
+    if(const exprt *cached = cache->find(expr))
+    {
+      if(cached->full_eq(expr))
+        return true; // no change
+
+      expr = *cached;
+      return false; // change
+    }
+  }
+
   auto result = simplify_rec(expr);
+
+  if(cache != nullptr)
+    cache->insert(expr, result.expr);
+
 #ifdef DEBUG_ON_DEMAND
   if(debug_on)
     std::cout << "FULLSIMP " << format(result.expr) << "\n";
@@ -2695,6 +2671,13 @@ bool simplify(exprt &expr, const namespacet &ns)
   return simplify_exprt(ns).simplify(expr);
 }
 
+bool simplify(exprt &expr, const namespacet &ns, simplify_expr_cachet &cache)
+{
+  simplify_exprt simplifier(ns);
+  simplifier.set_cache(cache);
+  return simplifier.simplify(expr);
+}
+
 exprt simplify_expr(exprt src, const namespacet &ns)
 {
   simplify_exprt(ns).simplify(src);
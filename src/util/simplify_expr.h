@@ -14,6 +14,7 @@ class array_exprt;
 class exprt;
 class namespacet;
 class refined_string_exprt;
+class simplify_expr_cachet;
 
 #include <util/optional.h>
 
@@ -28,6 +29,10 @@ bool simplify(
   exprt &expr,
   const namespacet &ns);
 
+/// Simplify \p expr, looking up and recording the result in \p cache
+/// \return true if \p expr was not changed
+bool simplify(exprt &expr, const namespacet &ns, simplify_expr_cachet &cache);
+
 // this is the preferred interface
 exprt simplify_expr(exprt src, const namespacet &ns);
 
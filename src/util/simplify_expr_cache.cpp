@@ -0,0 +1,73 @@
+/*******************************************************************\
+
+Module: Simplifier Result Cache
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Simplifier Result Cache
+
+#include "simplify_expr_cache.h"
+
+#include <ostream>
+
+#include "invariant.h"
+
+simplify_expr_cachet::simplify_expr_cachet(std::size_t capacity)
+  : max_size(capacity)
+{
+  PRECONDITION(capacity > 0);
+}
+
+const exprt *simplify_expr_cachet::find(const exprt &expr)
+{
+  auto index_it = index.find(expr);
+  if(index_it == index.end())
+  {
+    ++statistics.misses;
+    return nullptr;
+  }
+
+  ++statistics.hits;
+
+  // move to the front of the usage list
+  entries.splice(entries.begin(), entries, index_it->second);
+
+  return &index_it->second->second;
+}
+
+void simplify_expr_cachet::insert(const exprt &expr, const exprt &simplified)
+{
+  auto index_it = index.find(expr);
+  if(index_it != index.end())
+  {
+    index_it->second->second = simplified;
+    entries.splice(entries.begin(), entries, index_it->second);
+    return;
+  }
+
+  if(entries.size() >= max_size)
+  {
+    index.erase(entries.back().first);
+    entries.pop_back();
+    ++statistics.evictions;
+  }
+
+  entries.emplace_front(expr, simplified);
+  index.emplace(expr, entries.begin());
+}
+
+void simplify_expr_cachet::clear()
+{
+  index.clear();
+  entries.clear();
+}
+
+void simplify_expr_cachet::output_statistics(std::ostream &out) const
+{
+  out << "simplifier cache: " << statistics.hits << " hits, "
+      << statistics.misses << " misses, " << statistics.evictions
+      << " evictions";
+}
@@ -0,0 +1,92 @@
+/*******************************************************************\
+
+Module: Simplifier Result Cache
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Simplifier Result Cache
+
+#ifndef CPROVER_UTIL_SIMPLIFY_EXPR_CACHE_H
+#define CPROVER_UTIL_SIMPLIFY_EXPR_CACHE_H
+
+#include <iosfwd>
+#include <list>
+#include <unordered_map>
+
+#include "expr.h"
+#include "irep_hash.h"
+
+/// A bounded cache of simplification results with least-recently-used
+/// eviction. Entries are keyed on the full structure of the expression,
+/// including comments such as source locations, so that a cache hit yields
+/// exactly the expression the simplifier would have produced.
+///
+/// Simplification results depend on the namespace, hence a cache must only be
+/// shared by simplifier invocations that use the same namespace (or one that
+/// only differs by symbols that none of the cached expressions refers to).
+class simplify_expr_cachet
+{
+public:
+  /// \param capacity: maximum number of entries before the least recently
+  ///   used one is evicted; must be positive
+  explicit simplify_expr_cachet(std::size_t capacity);
+
+  /// Look up the simplified form of \p expr.
+  /// \return pointer to the cached result, or nullptr if there is none; the
+  ///   pointer is invalidated by the next call to \ref insert or \ref clear
+  const exprt *find(const exprt &expr);
+
+  /// Record that \p expr simplifies to \p simplified
+  void insert(const exprt &expr, const exprt &simplified);
+
+  /// Remove all entries, but keep the statistics
+  void clear();
+
+  std::size_t size() const
+  {
+    return entries.size();
+  }
+
+  std::size_t capacity() const
+  {
+    return max_size;
+  }
+
+  struct statisticst
+  {
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+    std::size_t evictions = 0;
+  };
+
+  const statisticst &get_statistics() const
+  {
+    return statistics;
+  }
+
+  /// Print hits, misses and evictions
+  void output_statistics(std::ostream &out) const;
+
+protected:
+  using entryt = std::pair<exprt, exprt>;
+  using entry_listt = std::list<entryt>;
+
+  std::size_t max_size;
+
+  /// Most recently used entry first
+  entry_listt entries;
+
+  std::unordered_map<
+    exprt,
+    entry_listt::iterator,
+    irep_full_hash,
+    irep_full_eq>
+    index;
+
+  statisticst statistics;
+};
+
+#endif // CPROVER_UTIL_SIMPLIFY_EXPR_CACHE_H
@@ -57,6 +57,7 @@ class plus_exprt;
 class popcount_exprt;
 class refined_string_exprt;
 class shift_exprt;
+class simplify_expr_cachet;
 class sign_exprt;
 class tvt;
 class typecast_exprt;
@@ -92,6 +93,12 @@ public:
 
   bool do_simplify_if;
 
+  /// Look up results of \ref simplify in \p _cache and record new ones there
+  void set_cache(simplify_expr_cachet &_cache)
+  {
+    cache = &_cache;
+  }
+
   template <typename T = exprt>
   struct resultt
   {
@@ -244,6 +251,7 @@ public:
 
 protected:
   const namespacet &ns;
+  simplify_expr_cachet *cache = nullptr;
 #ifdef DEBUG_ON_DEMAND
   bool debug_on;
 #endif
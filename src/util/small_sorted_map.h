@@ -0,0 +1,449 @@
+/*******************************************************************\
+
+Module: Small Sorted Map
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Small Sorted Map
+
+#ifndef CPROVER_UTIL_SMALL_SORTED_MAP_H
+#define CPROVER_UTIL_SMALL_SORTED_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <utility>
+
+/// Map with a `std::map`-like interface that is optimised for few elements.
+/// The keys are kept in a sorted array, which is stored within the map
+/// itself for up to `inline_capacity` elements and on the heap otherwise.
+/// Looking up a key thus scans contiguous memory. The key-value pairs are
+/// allocated separately, such that references and pointers to them remain
+/// valid until the element is erased, just as for `std::map`. Iterators are
+/// invalidated by insertion and erasure. The allocator for the key-value
+/// pairs has to be stateless.
+template <
+  typename keyt,
+  typename mappedt,
+  std::size_t inline_capacity = 2,
+  typename allocatort = std::allocator<std::pair<const keyt, mappedt>>>
+class small_sorted_mapt
+{
+  static_assert(inline_capacity > 0, "there is at least one inline entry");
+
+public:
+  typedef keyt key_type;
+  typedef mappedt mapped_type;
+  typedef std::pair<const keyt, mappedt> value_type;
+  typedef std::size_t size_type;
+
+protected:
+  struct entryt
+  {
+    keyt key;
+    value_type *value;
+  };
+
+  template <typename valuet>
+  class iteratort
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef valuet value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef valuet *pointer;
+    typedef valuet &reference;
+
+    iteratort() : entry(nullptr)
+    {
+    }
+
+    explicit iteratort(const entryt *_entry) : entry(_entry)
+    {
+    }
+
+    /// Conversion from iterator to const_iterator
+    template <typename othert>
+    // NOLINTNEXTLINE(runtime/explicit)
+    iteratort(const iteratort<othert> &other) : entry(other.entry)
+    {
+    }
+
+    reference operator*() const
+    {
+      return *entry->value;
+    }
+
+    pointer operator->() const
+    {
+      return entry->value;
+    }
+
+    iteratort &operator++()
+    {
+      ++entry;
+      return *this;
+    }
+
+    iteratort operator++(int)
+    {
+      iteratort old = *this;
+      ++entry;
+      return old;
+    }
+
+    template <typename othert>
+    bool operator==(const iteratort<othert> &other) const
+    {
+      return entry == other.entry;
+    }
+
+    template <typename othert>
+    bool operator!=(const iteratort<othert> &other) const
+    {
+      return entry != other.entry;
+    }
+
+  protected:
+    template <typename>
+    friend class iteratort;
+    friend class small_sorted_mapt;
+
+    const entryt *entry;
+  };
+
+public:
+  typedef iteratort<value_type> iterator;
+  typedef iteratort<const value_type> const_iterator;
+
+  small_sorted_mapt() = default;
+
+  small_sorted_mapt(std::initializer_list<value_type> list)
+  {
+    reserve(list.size());
+    for(const value_type &value : list)
+      emplace(value);
+  }
+
+  small_sorted_mapt(const small_sorted_mapt &other)
+  {
+    reserve(other.count);
+    for(const value_type &value : other)
+    {
+      new(entries() + count) entryt{value.first, new_value(value)};
+      ++count;
+    }
+  }
+
+  small_sorted_mapt(small_sorted_mapt &&other) noexcept
+  {
+    take(other);
+  }
+
+  small_sorted_mapt &operator=(const small_sorted_mapt &other)
+  {
+    if(this != &other)
+    {
+      small_sorted_mapt copy(other);
+      swap(copy);
+    }
+    return *this;
+  }
+
+  small_sorted_mapt &operator=(small_sorted_mapt &&other) noexcept
+  {
+    if(this != &other)
+    {
+      destroy();
+      take(other);
+    }
+    return *this;
+  }
+
+  ~small_sorted_mapt()
+  {
+    destroy();
+  }
+
+  iterator begin()
+  {
+    return iterator(entries());
+  }
+
+  iterator end()
+  {
+    return iterator(entries() + count);
+  }
+
+  const_iterator begin() const
+  {
+    return const_iterator(entries());
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator(entries() + count);
+  }
+
+  std::size_t size() const
+  {
+    return count;
+  }
+
+  bool empty() const
+  {
+    return count == 0;
+  }
+
+  iterator find(const keyt &key)
+  {
+    return iterator(find_entry(key));
+  }
+
+  const_iterator find(const keyt &key) const
+  {
+    return const_iterator(find_entry(key));
+  }
+
+  /// Construct a key-value pair from \p args and insert it, unless the key
+  /// is already present
+  /// \return iterator to the element with the key, and whether it was
+  ///   inserted
+  template <typename... argst>
+  std::pair<iterator, bool> emplace(argst &&... args)
+  {
+    value_type *value = new_value(std::forward<argst>(args)...);
+    entryt *entry = lower_bound(value->first);
+
+    if(entry != entries() + count && entry->key == value->first)
+    {
+      delete_value(value);
+      return {iterator(entry), false};
+    }
+
+    return {iterator(insert_entry(entry, value)), true};
+  }
+
+  mappedt &operator[](const keyt &key)
+  {
+    entryt *entry = lower_bound(key);
+
+    if(entry == entries() + count || entry->key != key)
+    {
+      entry = insert_entry(
+        entry,
+        new_value(
+          std::piecewise_construct,
+          std::forward_as_tuple(key),
+          std::forward_as_tuple()));
+    }
+
+    return entry->value->second;
+  }
+
+  /// \return number of elements erased
+  std::size_t erase(const keyt &key)
+  {
+    entryt *entry = lower_bound(key);
+
+    if(entry == entries() + count || entry->key != key)
+      return 0;
+
+    delete_value(entry->value);
+    entryt *last = entries() + count - 1;
+    std::move(entry + 1, last + 1, entry);
+    last->~entryt();
+    --count;
+    return 1;
+  }
+
+  void clear()
+  {
+    destroy();
+    count = 0;
+    capacity = inline_capacity;
+  }
+
+  void swap(small_sorted_mapt &other)
+  {
+    small_sorted_mapt tmp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(tmp);
+  }
+
+protected:
+  std::uint32_t count = 0;
+  std::uint32_t capacity = inline_capacity;
+
+  union storaget
+  {
+    entryt inline_entries[inline_capacity];
+    entryt *heap_entries;
+
+    storaget()
+    {
+    }
+
+    ~storaget()
+    {
+    }
+  } storage;
+
+  typedef std::allocator_traits<allocatort> allocator_traitst;
+
+  bool is_inline() const
+  {
+    return capacity == inline_capacity;
+  }
+
+  entryt *entries()
+  {
+    return is_inline() ? storage.inline_entries : storage.heap_entries;
+  }
+
+  const entryt *entries() const
+  {
+    return is_inline() ? storage.inline_entries : storage.heap_entries;
+  }
+
+  template <typename... argst>
+  value_type *new_value(argst &&... args)
+  {
+    allocatort allocator;
+    value_type *value = allocator_traitst::allocate(allocator, 1);
+    try
+    {
+      allocator_traitst::construct(
+        allocator, value, std::forward<argst>(args)...);
+    }
+    catch(...)
+    {
+      allocator_traitst::deallocate(allocator, value, 1);
+      throw;
+    }
+    return value;
+  }
+
+  void delete_value(value_type *value)
+  {
+    allocatort allocator;
+    allocator_traitst::destroy(allocator, value);
+    allocator_traitst::deallocate(allocator, value, 1);
+  }
+
+  entryt *lower_bound(const keyt &key)
+  {
+    return std::lower_bound(
+      entries(), entries() + count, key, [](const entryt &e, const keyt &k) {
+        return e.key < k;
+      });
+  }
+
+  const entryt *find_entry(const keyt &key) const
+  {
+    const entryt *last = entries() + count;
+    const entryt *entry =
+      std::lower_bound(entries(), last, key, [](const entryt &e, const keyt &k) {
+        return e.key < k;
+      });
+    return entry != last && entry->key == key ? entry : last;
+  }
+
+  /// Make room for at least \p n entries
+  void reserve(std::size_t n)
+  {
+    if(n <= capacity)
+      return;
+
+    std::size_t new_capacity = 2 * static_cast<std::size_t>(capacity);
+    if(new_capacity < n)
+      new_capacity = n;
+
+    entryt *new_entries =
+      static_cast<entryt *>(::operator new(new_capacity * sizeof(entryt)));
+    entryt *old_entries = entries();
+    for(std::size_t i = 0; i < count; ++i)
+    {
+      new(new_entries + i) entryt(std::move(old_entries[i]));
+      old_entries[i].~entryt();
+    }
+
+    if(!is_inline())
+      ::operator delete(old_entries);
+
+    storage.heap_entries = new_entries;
+    capacity = static_cast<std::uint32_t>(new_capacity);
+  }
+
+  /// Insert a new entry at \p position
+  /// \return the new entry
+  entryt *insert_entry(entryt *position, value_type *value)
+  {
+    if(count == capacity)
+    {
+      const std::ptrdiff_t index = position - entries();
+      reserve(count + 1);
+      position = entries() + index;
+    }
+
+    entryt *last = entries() + count;
+    if(position == last)
+      new(last) entryt{value->first, value};
+    else
+    {
+      new(last) entryt(std::move(*(last - 1)));
+      std::move_backward(position, last - 1, last);
+      *position = entryt{value->first, value};
+    }
+
+    ++count;
+    return position;
+  }
+
+  /// Free the elements and the storage for the entries
+  void destroy()
+  {
+    entryt *e = entries();
+    for(std::size_t i = 0; i < count; ++i)
+    {
+      delete_value(e[i].value);
+      e[i].~entryt();
+    }
+
+    if(!is_inline())
+      ::operator delete(storage.heap_entries);
+  }
+
+  /// Move the contents of \p other, which has been destroyed or not yet
+  /// been initialised, into this map, and leave \p other empty
+  void take(small_sorted_mapt &other)
+  {
+    count = other.count;
+    capacity = other.capacity;
+
+    if(other.is_inline())
+    {
+      for(std::size_t i = 0; i < count; ++i)
+      {
+        new(storage.inline_entries + i)
+          entryt(std::move(other.storage.inline_entries[i]));
+        other.storage.inline_entries[i].~entryt();
+      }
+    }
+    else
+      storage.heap_entries = other.storage.heap_entries;
+
+    other.count = 0;
+    other.capacity = inline_capacity;
+  }
+};
+
+#endif // CPROVER_UTIL_SMALL_SORTED_MAP_H
@@ -8,33 +8,39 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "ssa_expr.h"
 
-#include <sstream>
 #include <cassert>
 
 #include <util/arith_tools.h>
 
 /// If \p expr is:
-/// - a symbol_exprt "s" add "s" to the stream \p os
+/// - a symbol_exprt "s" add "s" to \p dest
 ///   - a member_exprt, apply recursively and add "..component_name"
 ///   - an index_exprt where the index is a constant, apply recursively on the
 ///     array and add "[[index]]"
-/// \return the stream \p os
-static std::ostream &
-initialize_ssa_identifier(std::ostream &os, const exprt &expr)
+static void initialize_ssa_identifier(std::string &dest, const exprt &expr)
 {
   if(auto member = expr_try_dynamic_cast<member_exprt>(expr))
   {
-    return initialize_ssa_identifier(os, member->struct_op())
-           << ".." << member->get_component_name();
+    initialize_ssa_identifier(dest, member->struct_op());
+    dest += "..";
+    dest += id2string(member->get_component_name());
+    return;
   }
   if(auto index = expr_try_dynamic_cast<index_exprt>(expr))
   {
     const auto idx =
       numeric_cast_v<mp_integer>(to_constant_expr(index->index()));
-    return initialize_ssa_identifier(os, index->array()) << "[[" << idx << "]]";
+    initialize_ssa_identifier(dest, index->array());
+    dest += "[[";
+    dest += integer2string(idx);
+    dest += "]]";
+    return;
   }
   if(auto symbol = expr_try_dynamic_cast<symbol_exprt>(expr))
-    return os << symbol->get_identifier();
+  {
+    dest += id2string(symbol->get_identifier());
+    return;
+  }
 
   UNREACHABLE;
 }
@@ -43,69 +49,78 @@ ssa_exprt::ssa_exprt(const exprt &expr) : symbol_exprt(expr.type())
 {
   set(ID_C_SSA_symbol, true);
   add(ID_expression, expr);
-  std::ostringstream os;
-  initialize_ssa_identifier(os, expr);
-  const std::string id = os.str();
-  set_identifier(id);
-  set(ID_L1_object_identifier, id);
+  std::string id;
+  initialize_ssa_identifier(id, expr);
+  const irep_idt identifier = id;
+  set_identifier(identifier);
+  set(ID_L1_object_identifier, identifier);
 }
 
-/// If \p expr is a symbol "s" add to \p os "s!l0@l1#l2" and to \p l1_object_os
-/// "s!l0@l1".
+/// If \p expr is a symbol "s" add to \p id "s!l0@l1#l2" and to
+/// \p l1_object_id "s!l0@l1".
 /// If \p expr is a member or index expression, recursively apply the procedure
-/// and add "..component_name" or "[[index]]" to \p os.
+/// and add "..component_name" or "[[index]]" to both.
 static void build_ssa_identifier_rec(
   const exprt &expr,
   const irep_idt &l0,
   const irep_idt &l1,
   const irep_idt &l2,
-  std::ostream &os,
-  std::ostream &l1_object_os)
+  std::string &id,
+  std::string &l1_object_id)
 {
   if(expr.id()==ID_member)
   {
     const member_exprt &member=to_member_expr(expr);
 
-    build_ssa_identifier_rec(member.struct_op(), l0, l1, l2, os, l1_object_os);
+    build_ssa_identifier_rec(member.struct_op(), l0, l1, l2, id, l1_object_id);
 
-    os << ".." << member.get_component_name();
-    l1_object_os << ".." << member.get_component_name();
+    const std::string &component_name =
+      id2string(member.get_component_name());
+    id += "..";
+    id += component_name;
+    l1_object_id += "..";
+    l1_object_id += component_name;
   }
   else if(expr.id()==ID_index)
   {
     const index_exprt &index=to_index_expr(expr);
 
-    build_ssa_identifier_rec(index.array(), l0, l1, l2, os, l1_object_os);
+    build_ssa_identifier_rec(index.array(), l0, l1, l2, id, l1_object_id);
 
-    const mp_integer idx =
-      numeric_cast_v<mp_integer>(to_constant_expr(index.index()));
-    os << "[[" << idx << "]]";
-    l1_object_os << "[[" << idx << "]]";
+    const std::string idx = integer2string(
+      numeric_cast_v<mp_integer>(to_constant_expr(index.index())));
+    id += "[[";
+    id += idx;
+    id += "]]";
+    l1_object_id += "[[";
+    l1_object_id += idx;
+    l1_object_id += "]]";
   }
   else if(expr.id()==ID_symbol)
   {
-    auto symid=to_symbol_expr(expr).get_identifier();
-    os << symid;
-    l1_object_os << symid;
+    l1_object_id += id2string(to_symbol_expr(expr).get_identifier());
 
     if(!l0.empty())
     {
       // Distinguish different threads of execution
-      os << '!' << l0;
-      l1_object_os << '!' << l0;
+      l1_object_id += '!';
+      l1_object_id += id2string(l0);
     }
 
     if(!l1.empty())
     {
       // Distinguish different calls to the same function (~stack frame)
-      os << '@' << l1;
-      l1_object_os << '@' << l1;
+      l1_object_id += '@';
+      l1_object_id += id2string(l1);
     }
 
+    id += l1_object_id;
+
     if(!l2.empty())
     {
       // Distinguish SSA steps for the same variable
-      os << '#' << l2;
+      id += '#';
+      id += id2string(l2);
     }
   }
   else
@@ -118,12 +133,12 @@ static std::pair<irep_idt, irep_idt> build_identifier(
   const irep_idt &l1,
   const irep_idt &l2)
 {
-  std::ostringstream oss;
-  std::ostringstream l1_object_oss;
+  std::string id;
+  std::string l1_object_id;
 
-  build_ssa_identifier_rec(expr, l0, l1, l2, oss, l1_object_oss);
+  build_ssa_identifier_rec(expr, l0, l1, l2, id, l1_object_id);
 
-  return std::make_pair(irep_idt(oss.str()), irep_idt(l1_object_oss.str()));
+  return std::make_pair(irep_idt(id), irep_idt(l1_object_id));
 }
 
 static void update_identifier(ssa_exprt &ssa)
@@ -195,7 +210,18 @@ void ssa_exprt::set_level_1(std::size_t i)
 void ssa_exprt::set_level_2(std::size_t i)
 {
   set(ID_L2, i);
-  ::update_identifier(*this);
+
+  // This is by far the most frequent renaming. The L1 object identifier does
+  // not change, and for symbols the L2 index is its only suffix, hence only
+  // the latter needs to be appended rather than building both again.
+  if(get_original_expr().id() == ID_symbol)
+  {
+    set_identifier(
+      id2string(get_l1_object_identifier()) + '#' +
+      id2string(get_level_2()));
+  }
+  else
+    ::update_identifier(*this);
 }
 
 void ssa_exprt::remove_level_2()
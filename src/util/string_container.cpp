@@ -27,50 +27,50 @@ bool string_ptrt::operator==(const string_ptrt &other) const
 
 string_containert::~string_containert()
 {
+  for(size_t i = 0; i < number_of_chunks; i++)
+    delete[] chunks[i].load(std::memory_order_relaxed);
 }
 
 unsigned string_containert::get(const char *s)
 {
-  string_ptrt string_ptr(s);
-
-  hash_tablet::iterator it=hash_table.find(string_ptr);
-
-  if(it!=hash_table.end())
-    return it->second;
-
-  size_t r=hash_table.size();
-
-  // these are stable
-  string_list.push_back(std::string(s));
-  string_ptrt result(string_list.back());
-
-  hash_table[result]=r;
-
-  // these are not
-  string_vector.push_back(&string_list.back());
-
-  return r;
+  return get(string_ptrt(s));
 }
 
 unsigned string_containert::get(const std::string &s)
 {
-  string_ptrt string_ptr(s);
+  return get(string_ptrt(s));
+}
+
+unsigned string_containert::get(const string_ptrt &string_ptr)
+{
+  const hashed_string_ptrt key{string_ptr, string_ptr_hash()(string_ptr)};
+
+  shardt &shard = shards[key.hash % number_of_shards];
+  std::lock_guard<std::mutex> shard_lock(shard.mutex);
 
-  hash_tablet::iterator it=hash_table.find(string_ptr);
+  hash_tablet::iterator it=shard.hash_table.find(key);
 
-  if(it!=hash_table.end())
+  if(it!=shard.hash_table.end())
     return it->second;
 
-  size_t r=hash_table.size();
+  const unsigned r = next_number.fetch_add(1, std::memory_order_relaxed);
 
   // these are stable
-  string_list.push_back(s);
-  string_ptrt result(string_list.back());
-
-  hash_table[result]=r;
-
-  // these are not
-  string_vector.push_back(&string_list.back());
+  shard.string_list.emplace_back(string_ptr.s, string_ptr.len);
+  const std::string &result = shard.string_list.back();
+
+  std::atomic<const std::string **> &chunk = chunks[r >> chunk_bits];
+  if(chunk.load(std::memory_order_acquire) == nullptr)
+  {
+    std::lock_guard<std::mutex> chunks_lock(chunks_mutex);
+    if(chunk.load(std::memory_order_relaxed) == nullptr)
+      chunk.store(
+        new const std::string *[chunk_size], std::memory_order_release);
+  }
+  chunk.load(std::memory_order_relaxed)[r & (chunk_size - 1)] = &result;
+
+  shard.hash_table.emplace(
+    hashed_string_ptrt{string_ptrt(result), key.hash}, r);
 
   return r;
 }
@@ -12,9 +12,11 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_UTIL_STRING_CONTAINER_H
 #define CPROVER_UTIL_STRING_CONTAINER_H
 
+#include <atomic>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
-#include <vector>
 
 #include "string_hash.h"
 
@@ -44,6 +46,16 @@ public:
   size_t operator()(const string_ptrt s) const { return hash_string(s.s); }
 };
 
+/// Interns strings, that is, maps each string to a unique number that does
+/// not change over the lifetime of the container, and back.
+///
+/// The container can be used from several threads at once: the table that
+/// maps strings to numbers is split into shards, each of which is protected
+/// by its own mutex, and numbers are mapped back to strings without any
+/// locking. Strings are never removed, and neither strings nor the table of
+/// pointers to them ever move. Numbers are handed out in the order strings
+/// are first added, hence single-threaded use numbers strings exactly like
+/// a plain hash table would.
 class string_containert
 {
 public:
@@ -61,32 +73,87 @@ public:
   string_containert();
   ~string_containert();
 
+  string_containert(const string_containert &) = delete;
+  string_containert &operator=(const string_containert &) = delete;
+
   // the pointer is guaranteed to be stable
   const char *c_str(size_t no) const
   {
-    return string_vector[no]->c_str();
+    return get_string(no).c_str();
   }
 
   // the reference is guaranteed to be stable
   const std::string &get_string(size_t no) const
   {
-    return *string_vector[no];
+    return *chunks[no >> chunk_bits].load(std::memory_order_acquire)
+              [no & (chunk_size - 1)];
+  }
+
+  /// Number of strings in the container
+  size_t size() const
+  {
+    return next_number.load(std::memory_order_acquire);
   }
 
 protected:
+  /// A string together with its hash, such that the hash is computed only
+  /// once per lookup
+  struct hashed_string_ptrt
+  {
+    string_ptrt string_ptr;
+    size_t hash;
+
+    bool operator==(const hashed_string_ptrt &other) const
+    {
+      return hash == other.hash && string_ptr == other.string_ptr;
+    }
+  };
+
+  // NOLINTNEXTLINE(readability/identifiers)
+  struct hashed_string_ptr_hash
+  {
+    size_t operator()(const hashed_string_ptrt &s) const
+    {
+      return s.hash;
+    }
+  };
+
   // the 'unsigned' ought to be size_t
-  typedef std::unordered_map<string_ptrt, unsigned, string_ptr_hash>
-    hash_tablet;
-  hash_tablet hash_table;
+  typedef std::
+    unordered_map<hashed_string_ptrt, unsigned, hashed_string_ptr_hash>
+      hash_tablet;
+
+  typedef std::list<std::string> string_listt;
+
+  /// Part of the table mapping strings to numbers
+  struct shardt
+  {
+    std::mutex mutex;
+    hash_tablet hash_table;
+    // these are stable
+    string_listt string_list;
+  };
+
+  static const size_t number_of_shards = 16;
+  shardt shards[number_of_shards];
 
   unsigned get(const char *s);
   unsigned get(const std::string &s);
+  unsigned get(const string_ptrt &string_ptr);
 
-  typedef std::list<std::string> string_listt;
-  string_listt string_list;
+  /// Numbers are mapped to strings by a two-level table: the upper bits of a
+  /// number select a chunk, which is allocated when its first number is
+  /// handed out, and the lower bits select the entry in that chunk.
+  static const unsigned chunk_bits = 16;
+  static const size_t chunk_size = size_t(1) << chunk_bits;
+  static const size_t number_of_chunks = size_t(1) << (32 - chunk_bits);
+  std::unique_ptr<std::atomic<const std::string **>[]> chunks{
+    new std::atomic<const std::string **>[number_of_chunks]()};
+
+  /// Protects the allocation of chunks
+  std::mutex chunks_mutex;
 
-  typedef std::vector<std::string *> string_vectort;
-  string_vectort string_vector;
+  std::atomic<unsigned> next_number{0};
 };
 
 /// Get a reference to the global string container.
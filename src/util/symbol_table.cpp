@@ -47,6 +47,14 @@ std::pair<symbolt &, bool> symbol_tablet::insert(symbolt symbol)
       internal_symbols.erase(result.first);
       throw;
     }
+
+    if(symbol_index_built)
+    {
+      const std::size_t no = new_symbol.name.get_no();
+      if(no >= symbol_index.size())
+        symbol_index.resize(no + 1, nullptr);
+      symbol_index[no] = &new_symbol;
+    }
   }
   return std::make_pair(std::ref(new_symbol), result.second);
 }
@@ -123,9 +131,27 @@ void symbol_tablet::erase(const symbolst::const_iterator &entry)
     internal_symbol_module_map.erase(module_it);
   }
 
+  if(symbol_index_built && symbol.name.get_no() < symbol_index.size())
+    symbol_index[symbol.name.get_no()] = nullptr;
+
   internal_symbols.erase(entry);
 }
 
+void symbol_tablet::build_symbol_index() const
+{
+  symbol_index.clear();
+
+  for(const auto &named_symbol : internal_symbols)
+  {
+    const std::size_t no = named_symbol.first.get_no();
+    if(no >= symbol_index.size())
+      symbol_index.resize(no + 1, nullptr);
+    symbol_index[no] = &named_symbol.second;
+  }
+
+  symbol_index_built = true;
+}
+
 /// Check whether the symbol table is in a valid state
 /// \param vm: Determine whether to throw exceptions or trigger INVARIANT
 ///   when validation fails.
@@ -6,6 +6,8 @@
 #ifndef CPROVER_UTIL_SYMBOL_TABLE_H
 #define CPROVER_UTIL_SYMBOL_TABLE_H
 
+#include <vector>
+
 #include "symbol_table_base.h"
 
 #define forall_symbol_base_map(it, expr, base_name) \
@@ -25,6 +27,12 @@ private:
   symbol_base_mapt internal_symbol_base_map;
   /// Value referenced by \ref symbol_table_baset::symbol_module_map.
   symbol_module_mapt internal_symbol_module_map;
+  /// Symbols by the number of their name, see \ref lookup_indexed. It is
+  /// only built on first use and kept up to date from then on.
+  mutable std::vector<const symbolt *> symbol_index;
+  mutable bool symbol_index_built = false;
+
+  void build_symbol_index() const;
 
 public:
   symbol_tablet()
@@ -62,8 +70,12 @@ public:
         internal_symbol_module_map),
       internal_symbols(std::move(other.internal_symbols)),
       internal_symbol_base_map(std::move(other.internal_symbol_base_map)),
-      internal_symbol_module_map(std::move(other.internal_symbol_module_map))
+      internal_symbol_module_map(std::move(other.internal_symbol_module_map)),
+      symbol_index(std::move(other.symbol_index)),
+      symbol_index_built(other.symbol_index_built)
   {
+    other.symbol_index.clear();
+    other.symbol_index_built = false;
   }
 
   /// Move assignment operator.
@@ -72,6 +84,10 @@ public:
     internal_symbols = std::move(other.internal_symbols);
     internal_symbol_base_map = std::move(other.internal_symbol_base_map);
     internal_symbol_module_map = std::move(other.internal_symbol_module_map);
+    symbol_index = std::move(other.symbol_index);
+    symbol_index_built = other.symbol_index_built;
+    other.symbol_index.clear();
+    other.symbol_index_built = false;
     return *this;
   }
 
@@ -82,6 +98,8 @@ public:
     internal_symbols.swap(other.internal_symbols);
     internal_symbol_base_map.swap(other.internal_symbol_base_map);
     internal_symbol_module_map.swap(other.internal_symbol_module_map);
+    symbol_index.swap(other.symbol_index);
+    std::swap(symbol_index_built, other.symbol_index_built);
   }
 
 public:
@@ -99,16 +117,39 @@ public:
     return it != internal_symbols.end() ? &it->second : nullptr;
   }
 
+  /// Find a symbol by indexing a vector with the number of its name rather
+  /// than by hashing, which is what \ref namespacet uses for its lookups.
+  /// \param name: The name of the symbol to look for
+  /// \return A pointer to the found symbol if it exists, nullptr otherwise.
+  const symbolt *lookup_indexed(const irep_idt &name) const
+  {
+    if(!symbol_index_built)
+      build_symbol_index();
+    const std::size_t no = name.get_no();
+    return no < symbol_index.size() ? symbol_index[no] : nullptr;
+  }
+
   virtual std::pair<symbolt &, bool> insert(symbolt symbol) override;
   virtual bool move(symbolt &symbol, symbolt *&new_symbol) override;
 
   virtual void erase(const symbolst::const_iterator &entry) override;
+
+  /// Make room for at least \p count symbols, such that inserting that many
+  /// symbols does not rehash the table repeatedly.
+  /// \param count: The total number of symbols expected
+  void reserve(std::size_t count)
+  {
+    internal_symbols.reserve(count);
+  }
+
   /// Wipe internal state of the symbol table.
   virtual void clear() override
   {
     internal_symbols.clear();
     internal_symbol_base_map.clear();
     internal_symbol_module_map.clear();
+    symbol_index.clear();
+    symbol_index_built = false;
   }
 
   virtual iteratort begin() override
@@ -0,0 +1 @@
+const char *CBMC_VERSION="5.12 (9519c5f-dirty)";
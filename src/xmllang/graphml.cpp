@@ -480,67 +480,88 @@ bool write_graphml(const graphmlt &src, std::ostream &os)
     key.set_attribute("id", "witness-type");
   }
 
-  xmlt &graph=graphml.new_element("graph");
-  graph.set_attribute("edgedefault", "directed");
-
-  for(const auto &kv : src.key_values)
+  // The nodes and edges make up the bulk of a witness: write them out one at
+  // a time rather than copying all edges into a single tree first.
+  os << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n";
+  os << "<graphml";
+  for(const auto &attribute : graphml.attributes)
   {
-    xmlt &data=graph.new_element("data");
-    data.set_attribute("key", kv.first);
-    data.data=kv.second;
+    os << ' ' << attribute.first << "=\"";
+    xmlt::escape_attribute(attribute.second, os);
+    os << '"';
   }
+  os << ">\n";
 
-  bool entry_done=false;
-  for(graphmlt::node_indext i=0; i<src.size(); ++i)
-  {
-    const graphmlt::nodet &n=src[i];
+  for(const auto &key : graphml.elements)
+    key.output(os, 2);
 
-    // <node id="A12"/>
-    xmlt &node=graph.new_element("node");
-    node.set_attribute("id", n.node_name);
+  if(src.key_values.empty() && src.size() == 0)
+    os << "  <graph edgedefault=\"directed\"/>\n";
+  else
+  {
+    os << "  <graph edgedefault=\"directed\">\n";
 
-    // <node id="A1">
-    //     <data key="entry">true</data>
-    // </node>
-    if(!entry_done && n.node_name!="sink")
+    for(const auto &kv : src.key_values)
     {
-      xmlt &entry=node.new_element("data");
-      entry.set_attribute("key", "entry");
-      entry.data="true";
-
-      entry_done=true;
+      xmlt data("data");
+      data.set_attribute("key", kv.first);
+      data.data = kv.second;
+      data.output(os, 4);
     }
 
-    // <node id="A14">
-    //     <data key="violation">true</data>
-    // </node>
-    if(n.is_violation)
+    bool entry_done = false;
+    for(graphmlt::node_indext i = 0; i < src.size(); ++i)
     {
-      xmlt &entry=node.new_element("data");
-      entry.set_attribute("key", "violation");
-      entry.data="true";
-    }
+      const graphmlt::nodet &n = src[i];
 
-    if(n.has_invariant)
-    {
-      xmlt &val=node.new_element("data");
-      val.set_attribute("key", "invariant");
-      val.data=n.invariant;
+      // <node id="A12"/>
+      xmlt node("node");
+      node.set_attribute("id", n.node_name);
+
+      // <node id="A1">
+      //     <data key="entry">true</data>
+      // </node>
+      if(!entry_done && n.node_name != "sink")
+      {
+        xmlt &entry = node.new_element("data");
+        entry.set_attribute("key", "entry");
+        entry.data = "true";
+
+        entry_done = true;
+      }
+
+      // <node id="A14">
+      //     <data key="violation">true</data>
+      // </node>
+      if(n.is_violation)
+      {
+        xmlt &entry = node.new_element("data");
+        entry.set_attribute("key", "violation");
+        entry.data = "true";
+      }
+
+      if(n.has_invariant)
+      {
+        xmlt &val = node.new_element("data");
+        val.set_attribute("key", "invariant");
+        val.data = n.invariant;
 
-      xmlt &val_s=node.new_element("data");
-      val_s.set_attribute("key", "invariant.scope");
-      val_s.data=n.invariant_scope;
+        xmlt &val_s = node.new_element("data");
+        val_s.set_attribute("key", "invariant.scope");
+        val_s.data = n.invariant_scope;
+      }
+
+      node.output(os, 4);
+
+      // each edge is written out along with its source node
+      for(const auto &edge : n.out)
+        edge.second.xml_node.output(os, 4);
     }
 
-    for(graphmlt::edgest::const_iterator
-        e_it=n.out.begin();
-        e_it!=n.out.end();
-        ++e_it)
-      graph.new_element(e_it->second.xml_node);
+    os << "  </graph>\n";
   }
 
-  os << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n";
-  os << graphml;
+  os << "</graphml>\n";
 
   return !os.good();
 }
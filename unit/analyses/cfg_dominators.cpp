@@ -0,0 +1,91 @@
+/*******************************************************************\
+
+Module: Unit tests for cfg_dominators.h
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/std_expr.h>
+
+#include <analyses/cfg_dominators.h>
+
+SCENARIO("cfg_dominators", "[core][analyses][cfg_dominators]")
+{
+  GIVEN("A program with a branch and an unreachable instruction")
+  {
+    // 0: IF c THEN GOTO 4
+    // 1: SKIP
+    // 2: GOTO 5
+    // 3: SKIP
+    // 4: SKIP
+    // 5: END_FUNCTION
+    goto_programt program;
+    const symbol_exprt c("c", bool_typet());
+    const auto i0 = program.add(goto_programt::make_incomplete_goto(c));
+    const auto i1 = program.add(goto_programt::make_skip());
+    const auto i2 = program.add(goto_programt::make_incomplete_goto());
+    const auto i3 = program.add(goto_programt::make_skip());
+    const auto i4 = program.add(goto_programt::make_skip());
+    const auto i5 = program.add(goto_programt::make_end_function());
+    i0->complete_goto(i4);
+    i2->complete_goto(i5);
+    program.update();
+
+    WHEN("Computing dominators")
+    {
+      cfg_dominatorst dominators;
+      dominators(program);
+
+      THEN("The entry dominates all reachable instructions")
+      {
+        REQUIRE(dominators.dominates(i0, i1));
+        REQUIRE(dominators.dominates(i0, i4));
+        REQUIRE(dominators.dominates(i0, i5));
+        REQUIRE(dominators.dominates(i1, i2));
+        REQUIRE(dominators.dominates(i5, i5));
+        REQUIRE_FALSE(dominators.dominates(i1, i5));
+        REQUIRE_FALSE(dominators.dominates(i4, i5));
+        REQUIRE_FALSE(dominators.dominates(i2, i1));
+      }
+
+      THEN("Dominator sets list the node itself and its dominators")
+      {
+        const auto &doms = dominators.get_node(i2).dominators;
+        REQUIRE(doms.size() == 3);
+        const std::set<goto_programt::const_targett> expected{i0, i1, i2};
+        REQUIRE(
+          std::set<goto_programt::const_targett>(doms.begin(), doms.end()) ==
+          expected);
+        REQUIRE(*doms.begin() == i2);
+        REQUIRE(doms.count(i1) == 1);
+        REQUIRE(doms.find(i4) == doms.end());
+      }
+
+      THEN("Unreachable instructions have no dominators")
+      {
+        REQUIRE_FALSE(dominators.program_point_reachable(i3));
+        REQUIRE(dominators.get_node(i3).dominators.empty());
+        REQUIRE_FALSE(dominators.dominates(i3, i4));
+        REQUIRE_FALSE(dominators.dominates(i0, i3));
+      }
+    }
+
+    WHEN("Computing post-dominators")
+    {
+      cfg_post_dominatorst post_dominators;
+      post_dominators(program);
+
+      THEN("The end of the function post-dominates everything")
+      {
+        REQUIRE(post_dominators.dominates(i5, i0));
+        REQUIRE(post_dominators.dominates(i2, i1));
+        REQUIRE_FALSE(post_dominators.dominates(i1, i0));
+        REQUIRE_FALSE(post_dominators.dominates(i4, i0));
+        REQUIRE(post_dominators.get_node(i0).dominators.size() == 2);
+      }
+    }
+  }
+}
@@ -0,0 +1,128 @@
+/*******************************************************************\
+
+Module: Unit tests for custom_bitvector_domaint
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <analyses/custom_bitvector_analysis.h>
+
+typedef custom_bitvector_domaint::bit_vectort bit_vectort;
+
+static bit_vectort bits(std::initializer_list<unsigned> bit_numbers)
+{
+  bit_vectort result;
+  for(const auto bit_nr : bit_numbers)
+    result.set(bit_nr);
+  return result;
+}
+
+static bool
+merge(custom_bitvector_domaint &a, const custom_bitvector_domaint &b)
+{
+  const custom_bitvector_domaint::locationt no_location{};
+  return a.merge(b, no_location, no_location);
+}
+
+SCENARIO(
+  "Bit vectors of arbitrary width",
+  "[core][analyses][custom_bitvector_analysis]")
+{
+  GIVEN("A vector with bits in different words")
+  {
+    bit_vectort a = bits({3, 64, 200});
+
+    THEN("The bits are set")
+    {
+      REQUIRE(a.get(3));
+      REQUIRE(a.get(64));
+      REQUIRE(a.get(200));
+      REQUIRE_FALSE(a.get(4));
+      REQUIRE_FALSE(a.get(1000));
+      REQUIRE(a.get_bit_numbers() == std::vector<unsigned>{3, 64, 200});
+    }
+
+    THEN("Clearing the highest bit gives the vector without it")
+    {
+      a.clear(200);
+      REQUIRE(a == bits({3, 64}));
+      a.clear(3);
+      a.clear(64);
+      REQUIRE(a.empty());
+    }
+
+    THEN("Union and intersection combine all words")
+    {
+      bit_vectort b = bits({64, 65});
+
+      bit_vectort u = a;
+      u |= b;
+      REQUIRE(u == bits({3, 64, 65, 200}));
+
+      bit_vectort i = a;
+      i &= b;
+      REQUIRE(i == bits({64}));
+    }
+  }
+}
+
+SCENARIO(
+  "Custom bitvector domain join",
+  "[core][analyses][custom_bitvector_analysis]")
+{
+  custom_bitvector_domaint::vectorst x_vectors;
+  x_vectors.may_bits = bits({1, 100});
+  x_vectors.must_bits = bits({1, 100});
+
+  custom_bitvector_domaint a;
+  a.make_top();
+  a.assign_lhs(irep_idt("x"), x_vectors);
+
+  GIVEN("A state with other bits")
+  {
+    custom_bitvector_domaint::vectorst vectors;
+    vectors.may_bits = bits({2, 100});
+    vectors.must_bits = bits({100});
+
+    custom_bitvector_domaint b;
+    b.make_top();
+    b.assign_lhs(irep_idt("x"), vectors);
+    b.assign_lhs(irep_idt("y"), vectors);
+
+    THEN("May bits are joined and must bits are met")
+    {
+      REQUIRE(merge(a, b));
+
+      const auto x = a.get_rhs(irep_idt("x"));
+      REQUIRE(x.may_bits == bits({1, 2, 100}));
+      REQUIRE(x.must_bits == bits({100}));
+
+      const auto y = a.get_rhs(irep_idt("y"));
+      REQUIRE(y.may_bits == bits({2, 100}));
+      REQUIRE(y.must_bits.empty());
+
+      REQUIRE_FALSE(merge(a, b));
+    }
+  }
+
+  GIVEN("A bottom state")
+  {
+    custom_bitvector_domaint b;
+
+    THEN("Joining into it gives the other state")
+    {
+      REQUIRE(merge(b, a));
+      REQUIRE(b.get_rhs(irep_idt("x")).may_bits == bits({1, 100}));
+      REQUIRE(b.get_rhs(irep_idt("x")).must_bits == bits({1, 100}));
+    }
+
+    THEN("Joining it changes nothing")
+    {
+      REQUIRE_FALSE(merge(a, b));
+      REQUIRE(a.get_rhs(irep_idt("x")).may_bits == bits({1, 100}));
+    }
+  }
+}
@@ -0,0 +1,127 @@
+/*******************************************************************\
+
+Module: Unit tests for goto_check_function
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <analyses/goto_check.h>
+#include <analyses/local_bitvector_analysis.h>
+
+#include <ansi-c/ansi_c_language.h>
+
+#include <langapi/mode.h>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/cprover_prefix.h>
+#include <util/make_unique.h>
+#include <util/options.h>
+#include <util/symbol_table.h>
+
+static std::size_t count_assertions(const goto_programt &goto_program)
+{
+  std::size_t assertions = 0;
+  for(const auto &instruction : goto_program.instructions)
+  {
+    if(instruction.is_assert())
+      ++assertions;
+  }
+  return assertions;
+}
+
+SCENARIO(
+  "goto_check_function takes the pointer analysis from a provider",
+  "[core][analyses][goto_check]")
+{
+  register_language(new_ansi_c_language);
+
+  GIVEN("A function that dereferences a pointer")
+  {
+    symbol_tablet symbol_table;
+    const namespacet ns(symbol_table);
+
+    const symbol_exprt p("f::p", pointer_type(signed_int_type()));
+    const symbol_exprt x("f::x", signed_int_type());
+    // the function and the variables that pointer checks refer to
+    const symbol_exprt symbols[] = {
+      p,
+      x,
+      symbol_exprt("f", code_typet({}, empty_typet())),
+      symbol_exprt(CPROVER_PREFIX "malloc_object", pointer_type(void_type())),
+      symbol_exprt(CPROVER_PREFIX "deallocated", pointer_type(void_type())),
+      symbol_exprt(CPROVER_PREFIX "dead_object", pointer_type(void_type())),
+      symbol_exprt(CPROVER_PREFIX "malloc_size", size_type())};
+    for(const symbol_exprt &symbol_expr : symbols)
+    {
+      symbolt symbol;
+      symbol.name = symbol_expr.get_identifier();
+      symbol.base_name = symbol.name;
+      symbol.type = symbol_expr.type();
+      symbol.mode = ID_C;
+      symbol_table.insert(std::move(symbol));
+    }
+
+    goto_modelt goto_model;
+    auto &function = goto_model.goto_functions.function_map["f"];
+    function.body.add(goto_programt::make_assignment(x, dereference_exprt(p)));
+    function.body.add(goto_programt::make_end_function());
+    function.body.update();
+
+    std::size_t provided = 0;
+    std::unique_ptr<local_bitvector_analysist> analysis;
+    const local_bitvector_analysis_providert provider =
+      [&](const irep_idt &, const goto_functionst::goto_functiont &function)
+      -> const local_bitvector_analysist & {
+      ++provided;
+      analysis = util_make_unique<local_bitvector_analysist>(function, ns);
+      return *analysis;
+    };
+
+    optionst options;
+
+    WHEN("No check needs the analysis")
+    {
+      options.set_option("bounds-check", true);
+      goto_check_function(ns, options, goto_model.goto_functions, provider)(
+        "f", function);
+
+      THEN("It is not requested")
+      {
+        REQUIRE(provided == 0);
+      }
+    }
+
+    WHEN("Pointer checks are enabled")
+    {
+      options.set_option("pointer-check", true);
+      goto_check_function(ns, options, goto_model.goto_functions, provider)(
+        "f", function);
+
+      THEN("It is requested once and the dereference is checked")
+      {
+        REQUIRE(provided == 1);
+        REQUIRE(count_assertions(function.body) > 0);
+      }
+    }
+
+    WHEN("The function asserts that the pointer can be read")
+    {
+      function.body.insert_before(
+        function.body.instructions.begin(),
+        goto_programt::make_assertion(binary_predicate_exprt(
+          p, ID_r_ok, from_integer(4, size_type()))));
+      function.body.update();
+      goto_check_function(ns, options, goto_model.goto_functions, provider)(
+        "f", function);
+
+      THEN("It is requested for the check of r_ok")
+      {
+        REQUIRE(provided == 1);
+      }
+    }
+  }
+}
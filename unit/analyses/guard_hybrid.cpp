@@ -0,0 +1,66 @@
+/*******************************************************************\
+
+Module: Unit tests for guard_hybridt
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <analyses/guard_hybrid.h>
+#include <util/std_expr.h>
+
+SCENARIO("guard_hybridt", "[core][analyses][guard_hybrid]")
+{
+  const symbol_exprt a{"a", bool_typet()};
+  const symbol_exprt b{"b", bool_typet()};
+  const symbol_exprt c{"c", bool_typet()};
+
+  GIVEN("A manager that permits BDDs")
+  {
+    guard_hybrid_managert manager{64};
+    guard_hybridt guard{true_exprt(), manager};
+    guard.add(a);
+    guard.add(b);
+
+    THEN("Small guards are BDDs and thus simplified")
+    {
+      REQUIRE(guard.is_bdd());
+
+      guard_hybridt other{a, manager};
+      other.add(not_exprt{b});
+      guard |= other;
+      REQUIRE(guard.is_bdd());
+      REQUIRE(guard.as_expr() == a);
+
+      guard.add(not_exprt{a});
+      REQUIRE(guard.is_false());
+    }
+
+    THEN("Guards whose BDD becomes too large become expressions")
+    {
+      manager.max_bdd_nodes = 2;
+      guard.add(c);
+      REQUIRE_FALSE(guard.is_bdd());
+
+      guard_hybridt other{a, manager};
+      guard |= other;
+      REQUIRE_FALSE(guard.is_bdd());
+      REQUIRE(other.is_bdd());
+    }
+  }
+
+  GIVEN("A manager that does not permit BDDs")
+  {
+    guard_hybrid_managert manager;
+    guard_hybridt guard{a, manager};
+    guard.add(b);
+
+    THEN("Guards are expressions")
+    {
+      REQUIRE_FALSE(guard.is_bdd());
+      REQUIRE(guard.as_expr() == and_exprt{a, b});
+    }
+  }
+}
@@ -0,0 +1,126 @@
+/*******************************************************************\
+
+Module: Unit tests for interval_domaint
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <analyses/interval_domain.h>
+
+#include <util/arith_tools.h>
+#include <util/namespace.h>
+#include <util/std_expr.h>
+#include <util/std_types.h>
+#include <util/symbol_table.h>
+
+static exprt range(const symbol_exprt &x, int lower, int upper)
+{
+  return and_exprt(
+    binary_relation_exprt(x, ID_ge, from_integer(lower, x.type())),
+    binary_relation_exprt(x, ID_le, from_integer(upper, x.type())));
+}
+
+/// The expression that interval_domaint::make_expression yields for an
+/// interval
+static exprt bounds(const symbol_exprt &x, int lower, int upper)
+{
+  return and_exprt(
+    binary_relation_exprt(x, ID_le, from_integer(upper, x.type())),
+    binary_relation_exprt(from_integer(lower, x.type()), ID_le, x));
+}
+
+static bool merge(interval_domaint &a, const interval_domaint &b)
+{
+  const interval_domaint::locationt no_location{};
+  return a.merge(b, no_location, no_location);
+}
+
+SCENARIO("Interval domain join", "[core][analyses][interval_domain]")
+{
+  symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+
+  const symbol_exprt x("x", signedbv_typet(32));
+  const symbol_exprt y("y", signedbv_typet(32));
+
+  interval_domaint a;
+  a.make_top();
+  a.assume(range(x, 0, 10), ns);
+  a.assume(range(y, 1, 2), ns);
+
+  GIVEN("Two states with different intervals")
+  {
+    interval_domaint b;
+    b.make_top();
+    b.assume(range(x, 5, 20), ns);
+
+    THEN("Joining widens the common intervals and drops the others")
+    {
+      REQUIRE(merge(a, b));
+      REQUIRE(a.make_expression(x) == bounds(x, 0, 20));
+      REQUIRE(a.make_expression(y) == true_exprt());
+      REQUIRE(!merge(a, b));
+    }
+  }
+
+  GIVEN("A copy of a state")
+  {
+    interval_domaint b = a;
+
+    THEN("Joining does not change anything")
+    {
+      REQUIRE(!merge(a, b));
+      REQUIRE(a.make_expression(x) == bounds(x, 0, 10));
+      REQUIRE(a.make_expression(y) == bounds(y, 1, 2));
+    }
+
+    THEN("Joining takes changes to the copy into account")
+    {
+      b.assume(binary_relation_exprt(y, ID_le, from_integer(1, y.type())), ns);
+      REQUIRE(!merge(a, b));
+      REQUIRE(merge(b, a));
+      REQUIRE(b.make_expression(x) == a.make_expression(x));
+      REQUIRE(b.make_expression(y) == a.make_expression(y));
+    }
+  }
+
+  GIVEN("A bottom state")
+  {
+    interval_domaint b;
+    b.make_bottom();
+
+    THEN("Joining keeps the state")
+    {
+      REQUIRE(!merge(a, b));
+      REQUIRE(merge(b, a));
+      REQUIRE(b.make_expression(x) == a.make_expression(x));
+      REQUIRE(b.make_expression(y) == a.make_expression(y));
+    }
+  }
+
+  GIVEN("A state with a wider interval")
+  {
+    interval_domaint b;
+    b.make_top();
+    b.assume(range(x, -1, 11), ns);
+    b.assume(range(y, 1, 2), ns);
+
+    THEN("Widening without thresholds drops the bounds that grew")
+    {
+      REQUIRE(a.widen(b, {}));
+      REQUIRE(a.make_expression(x) == true_exprt());
+      REQUIRE(a.make_expression(y) == bounds(y, 1, 2));
+    }
+
+    THEN("Widening moves the bounds that grew to the nearest thresholds")
+    {
+      REQUIRE(a.widen(b, {-5, 0, 10, 100}));
+      REQUIRE(a.make_expression(x) == bounds(x, -5, 100));
+      REQUIRE(a.make_expression(y) == bounds(y, 1, 2));
+      REQUIRE(!a.widen(b, {-5, 0, 10, 100}));
+    }
+  }
+}
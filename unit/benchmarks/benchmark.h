@@ -0,0 +1,40 @@
+/*******************************************************************\
+
+Module: Benchmarks of core data structures
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Benchmarks of core data structures
+
+#ifndef CPROVER_BENCHMARKS_BENCHMARK_H
+#define CPROVER_BENCHMARKS_BENCHMARK_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+/// A named workload. `run(n)` performs the workload n times and returns a
+/// value computed from its results, such that the compiler cannot optimise
+/// the work away. `iterations` is chosen such that a run takes in the order
+/// of a second on current hardware.
+struct benchmarkt
+{
+  std::string name;
+  std::size_t iterations;
+  std::function<std::size_t(std::size_t)> run;
+};
+
+typedef std::vector<benchmarkt> benchmarkst;
+
+void add_irep_benchmarks(benchmarkst &);
+void add_sharing_map_benchmarks(benchmarkst &);
+void add_string_container_benchmarks(benchmarkst &);
+void add_simplify_expr_benchmarks(benchmarkst &);
+void add_value_set_benchmarks(benchmarkst &);
+void add_bv_utils_benchmarks(benchmarkst &);
+
+#endif // CPROVER_BENCHMARKS_BENCHMARK_H
@@ -0,0 +1,65 @@
+/*******************************************************************\
+
+Module: Benchmarks of core data structures
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Runs the benchmarks whose names contain the (optional) command-line
+/// argument and prints their timings as JSON.
+
+#include "benchmark.h"
+
+#include <util/json.h>
+
+#include <chrono>
+#include <iostream>
+
+int main(int argc, const char **argv)
+{
+  const std::string filter = argc > 1 ? argv[1] : "";
+
+  benchmarkst benchmarks;
+  add_irep_benchmarks(benchmarks);
+  add_sharing_map_benchmarks(benchmarks);
+  add_string_container_benchmarks(benchmarks);
+  add_simplify_expr_benchmarks(benchmarks);
+  add_value_set_benchmarks(benchmarks);
+  add_bv_utils_benchmarks(benchmarks);
+
+  json_arrayt json_benchmarks;
+  std::size_t checksum = 0;
+
+  for(const auto &benchmark : benchmarks)
+  {
+    if(benchmark.name.find(filter) == std::string::npos)
+      continue;
+
+    // warm up caches and any lazily initialised global state
+    checksum += benchmark.run(1);
+
+    const auto start = std::chrono::steady_clock::now();
+    checksum += benchmark.run(benchmark.iterations);
+    const auto end = std::chrono::steady_clock::now();
+
+    const auto total_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+        .count();
+
+    json_benchmarks.push_back(json_objectt{
+      {"name", json_stringt(benchmark.name)},
+      {"iterations", json_numbert(std::to_string(benchmark.iterations))},
+      {"totalNs", json_numbert(std::to_string(total_ns))},
+      {"nsPerIteration",
+       json_numbert(std::to_string(total_ns / benchmark.iterations))}});
+  }
+
+  std::cout << json_objectt{{"benchmarks", std::move(json_benchmarks)},
+                            {"checksum",
+                             json_numbert(std::to_string(checksum))}}
+            << '\n';
+
+  return 0;
+}
@@ -0,0 +1,35 @@
+/*******************************************************************\
+
+Module: Benchmarks of bv_utilst
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include "benchmark.h"
+
+#include <util/message.h>
+
+#include <solvers/flattening/bv_utils.h>
+#include <solvers/sat/satcheck.h>
+
+void add_bv_utils_benchmarks(benchmarkst &benchmarks)
+{
+  benchmarks.push_back(
+    {"bv_utils/adders-and-multipliers", 100, [](std::size_t iterations) {
+       null_message_handlert message_handler;
+       std::size_t result = 0;
+       for(std::size_t i = 0; i < iterations; ++i)
+       {
+         satcheckt satcheck{message_handler};
+         bv_utilst bv_utils{satcheck};
+         const bvt a = satcheck.new_variables(64);
+         const bvt b = satcheck.new_variables(64);
+         const bvt sum = bv_utils.add(a, b);
+         bv_utils.multiplier(
+           sum, b, bv_utilst::representationt::UNSIGNED);
+         result += satcheck.no_variables();
+       }
+       return result;
+     }});
+}
@@ -0,0 +1,58 @@
+/*******************************************************************\
+
+Module: Benchmarks of irept
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include "benchmark.h"
+
+#include <util/arith_tools.h>
+#include <util/std_types.h>
+#include <util/std_expr.h>
+
+/// A sum of products over \p size symbols, similar in shape to the
+/// expressions that symex builds for array-heavy code
+static exprt make_expression(std::size_t size)
+{
+  const signedbv_typet type{32};
+  exprt result = from_integer(0, type);
+  for(std::size_t i = 0; i < size; ++i)
+  {
+    const symbol_exprt symbol{"x" + std::to_string(i), type};
+    result =
+      plus_exprt{std::move(result), mult_exprt{symbol, from_integer(i, type)}};
+  }
+  return result;
+}
+
+void add_irep_benchmarks(benchmarkst &benchmarks)
+{
+  benchmarks.push_back({"irep/construct", 200, [](std::size_t iterations) {
+                          std::size_t result = 0;
+                          for(std::size_t i = 0; i < iterations; ++i)
+                            result += make_expression(1000).operands().size();
+                          return result;
+                        }});
+
+  benchmarks.push_back({"irep/hash", 200, [](std::size_t iterations) {
+                          std::size_t result = 0;
+                          for(std::size_t i = 0; i < iterations; ++i)
+                          {
+                            // hashes are cached, so hash fresh trees
+                            result += make_expression(1000).hash();
+                          }
+                          return result;
+                        }});
+
+  benchmarks.push_back(
+    {"irep/compare-unshared", 200, [](std::size_t iterations) {
+       const exprt a = make_expression(1000);
+       const exprt b = make_expression(1000);
+       std::size_t result = 0;
+       for(std::size_t i = 0; i < iterations; ++i)
+         result += a == b;
+       return result;
+     }});
+}
@@ -0,0 +1,51 @@
+/*******************************************************************\
+
+Module: Benchmarks of sharing_mapt
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include "benchmark.h"
+
+#include <util/sharing_map.h>
+
+typedef sharing_mapt<std::size_t, std::size_t> mapt;
+
+static mapt make_map(std::size_t size)
+{
+  mapt map;
+  for(std::size_t i = 0; i < size; ++i)
+    map.insert(i, i);
+  return map;
+}
+
+void add_sharing_map_benchmarks(benchmarkst &benchmarks)
+{
+  benchmarks.push_back(
+    {"sharing_map/insert", 20, [](std::size_t iterations) {
+       std::size_t result = 0;
+       for(std::size_t i = 0; i < iterations; ++i)
+         result += make_map(100000).size();
+       return result;
+     }});
+
+  benchmarks.push_back(
+    {"sharing_map/delta-view", 10000, [](std::size_t iterations) {
+       // two copies of a large map that differ in a few entries, as the
+       // states of an abstract interpreter at a merge point do
+       const mapt base = make_map(100000);
+       mapt changed = base;
+       for(std::size_t k = 0; k < 100000; k += 10000)
+         changed.replace(k, k + 1);
+
+       std::size_t result = 0;
+       for(std::size_t i = 0; i < iterations; ++i)
+       {
+         mapt::delta_viewt delta_view;
+         changed.get_delta_view(base, delta_view);
+         result += delta_view.size();
+       }
+       return result;
+     }});
+}
@@ -0,0 +1,49 @@
+/*******************************************************************\
+
+Module: Benchmarks of simplify_expr
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include "benchmark.h"
+
+#include <util/arith_tools.h>
+#include <util/std_types.h>
+#include <util/namespace.h>
+#include <util/simplify_expr.h>
+#include <util/std_expr.h>
+#include <util/symbol_table.h>
+
+/// Nested conditionals over comparisons with constants, as produced by
+/// symex when merging the states of many branches
+static exprt make_expression(std::size_t depth)
+{
+  const signedbv_typet type{32};
+  const symbol_exprt x{"x", type};
+  exprt result = x;
+  for(std::size_t i = 0; i < depth; ++i)
+  {
+    const exprt c = from_integer(i, type);
+    result = if_exprt{
+      equal_exprt{x, c},
+      plus_exprt{c, from_integer(1, type)},
+      plus_exprt{std::move(result), from_integer(0, type)}};
+  }
+  return result;
+}
+
+void add_simplify_expr_benchmarks(benchmarkst &benchmarks)
+{
+  benchmarks.push_back(
+    {"simplify_expr/nested-if", 100, [](std::size_t iterations) {
+       symbol_tablet symbol_table;
+       const namespacet ns{symbol_table};
+       const exprt expr = make_expression(500);
+
+       std::size_t result = 0;
+       for(std::size_t i = 0; i < iterations; ++i)
+         result += simplify_expr(expr, ns).operands().size();
+       return result;
+     }});
+}
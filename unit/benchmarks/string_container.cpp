@@ -0,0 +1,29 @@
+/*******************************************************************\
+
+Module: Benchmarks of string interning
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include "benchmark.h"
+
+#include <util/irep.h>
+
+void add_string_container_benchmarks(benchmarkst &benchmarks)
+{
+  benchmarks.push_back(
+    {"string_container/intern-existing", 20, [](std::size_t iterations) {
+       std::vector<std::string> names;
+       for(std::size_t i = 0; i < 100000; ++i)
+         names.push_back("main::1::some_local_variable!0@" + std::to_string(i));
+
+       std::size_t result = 0;
+       for(std::size_t i = 0; i < iterations; ++i)
+       {
+         for(const auto &name : names)
+           result += irep_idt(name).get_no();
+       }
+       return result;
+     }});
+}
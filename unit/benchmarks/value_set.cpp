@@ -0,0 +1,40 @@
+/*******************************************************************\
+
+Module: Benchmarks of value_sett
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include "benchmark.h"
+
+#include <util/c_types.h>
+#include <util/std_expr.h>
+
+#include <pointer-analysis/value_set.h>
+
+void add_value_set_benchmarks(benchmarkst &benchmarks)
+{
+  benchmarks.push_back(
+    {"value_set/merge-object-maps", 1000, [](std::size_t iterations) {
+       const value_sett value_set;
+       const signedbv_typet type{32};
+
+       // two overlapping points-to sets of a few hundred objects each
+       value_sett::object_mapt a, b;
+       for(std::size_t i = 0; i < 300; ++i)
+       {
+         const symbol_exprt object{"object" + std::to_string(i), type};
+         value_set.insert(a, object, mp_integer{0});
+         value_set.insert(b, object, mp_integer{i % 2 == 0 ? 0 : 4});
+       }
+
+       std::size_t result = 0;
+       for(std::size_t i = 0; i < iterations; ++i)
+       {
+         value_sett::object_mapt dest = a;
+         result += value_set.make_union(dest, b);
+       }
+       return result;
+     }});
+}
@@ -253,4 +253,38 @@ TEST_CASE("arbitrary precision integers", "[core][big-int][bigint]")
     N += 2; // 2
     REQUIRE(N.floorPow2() == 1);
   }
+
+  SECTION("inline and allocated digits")
+  {
+    BigInt small(12345);
+    BigInt large = pow(BigInt(2), 200) + 7;
+    const BigInt small_copy = small;
+    const BigInt large_copy = large;
+
+    // Swapping and moving between inline and allocated digits.
+    small.swap(large);
+    REQUIRE(small == large_copy);
+    REQUIRE(large == small_copy);
+    BigInt moved(std::move(small));
+    REQUIRE(moved == large_copy);
+    small = std::move(large);
+    REQUIRE(small == small_copy);
+
+    // Growing out of the inline digits and shrinking back into a copy.
+    BigInt N = small;
+    for(int i = 0; i < 8; ++i)
+      N *= N;
+    REQUIRE(N == pow(small_copy, 256));
+    N /= pow(small_copy, 255);
+    REQUIRE(N == small_copy);
+    N = large_copy;
+    REQUIRE(N == large_copy);
+    N = small_copy;
+    REQUIRE(N == small_copy);
+
+    // Products that just fit the inline digits.
+    BigInt M = pow(BigInt(2), 60) + 1;
+    M *= pow(BigInt(2), 60) - 1;
+    REQUIRE(M == pow(BigInt(2), 120) - 1);
+  }
 }
@@ -0,0 +1,103 @@
+/*******************************************************************\
+
+Module: Tests for the goto program transformation pass manager
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+#include <goto-instrument/goto_pass_manager.h>
+#include <testing-utils/use_catch.h>
+
+#include <util/message.h>
+
+#include <goto-programs/goto_model.h>
+
+namespace
+{
+/// Counts how often it is computed
+struct counting_analysist
+{
+  explicit counting_analysist(const goto_functionst::goto_functiont &function)
+    : instructions(function.body.instructions.size())
+  {
+    ++computed;
+  }
+
+  std::size_t instructions;
+
+  static std::size_t computed;
+};
+
+std::size_t counting_analysist::computed = 0;
+
+/// Takes an extra constructor argument
+struct offset_analysist
+{
+  offset_analysist(
+    const goto_functionst::goto_functiont &function,
+    std::size_t offset)
+    : instructions(function.body.instructions.size() + offset)
+  {
+  }
+
+  std::size_t instructions;
+};
+} // namespace
+
+TEST_CASE("goto_pass_manager caches function analyses", "[core]")
+{
+  null_message_handlert message_handler;
+  goto_pass_managert pass_manager(1, message_handler);
+
+  goto_modelt goto_model;
+  auto &function = goto_model.goto_functions.function_map["f"];
+  function.body.add(goto_programt::make_skip());
+  function.body.add(goto_programt::make_end_function());
+
+  counting_analysist::computed = 0;
+
+  const auto &first =
+    pass_manager.get_function_analysis<counting_analysist>("f", function);
+  REQUIRE(first.instructions == 2);
+  REQUIRE(counting_analysist::computed == 1);
+
+  SECTION("Unchanged bodies reuse the result")
+  {
+    function.body.update();
+    const auto &second =
+      pass_manager.get_function_analysis<counting_analysist>("f", function);
+    REQUIRE(&second == &first);
+    REQUIRE(counting_analysist::computed == 1);
+  }
+
+  SECTION("Changed bodies invalidate the result")
+  {
+    pass_manager.add_function_local_pass(
+      "add skip",
+      [](const irep_idt &, goto_functionst::goto_functiont &function) {
+        function.body.insert_before(
+          function.body.instructions.begin(), goto_programt::make_skip());
+      });
+    pass_manager.run(goto_model);
+
+    const auto &second =
+      pass_manager.get_function_analysis<counting_analysist>("f", function);
+    REQUIRE(second.instructions == 3);
+    REQUIRE(counting_analysist::computed == 2);
+  }
+}
+
+TEST_CASE("goto_pass_manager passes arguments to function analyses", "[core]")
+{
+  null_message_handlert message_handler;
+  goto_pass_managert pass_manager(1, message_handler);
+
+  goto_modelt goto_model;
+  auto &function = goto_model.goto_functions.function_map["f"];
+  function.body.add(goto_programt::make_end_function());
+
+  const auto &analysis =
+    pass_manager.get_function_analysis<offset_analysist>("f", function, 10);
+  REQUIRE(analysis.instructions == 11);
+}
@@ -0,0 +1,138 @@
+/*******************************************************************\
+
+Module: Unit tests for writing and reading binary goto traces
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/exception_utils.h>
+
+#include <goto-programs/binary_goto_trace.h>
+#include <goto-programs/goto_functions.h>
+
+#include <sstream>
+
+SCENARIO(
+  "Writing and reading binary goto traces",
+  "[core][goto-programs][binary_goto_trace]")
+{
+  goto_functionst goto_functions;
+  for(const irep_idt name : {"f", "g"})
+  {
+    goto_programt &body = goto_functions.function_map[name].body;
+    body.add(goto_programt::make_skip(source_locationt()));
+    body.add(goto_programt::make_skip(source_locationt()));
+    body.add(goto_programt::make_end_function());
+  }
+  goto_functions.update();
+
+  const goto_programt &g = goto_functions.function_map.at("g").body;
+  const goto_programt &f = goto_functions.function_map.at("f").body;
+
+  const signedbv_typet type(32);
+  const symbol_exprt x("x", type);
+
+  goto_tracet goto_trace;
+  for(std::size_t i = 0; i < 3; ++i)
+  {
+    goto_trace_stept step;
+    step.step_nr = i + 1;
+    step.type = goto_trace_stept::typet::ASSIGNMENT;
+    step.function_id = "g";
+    step.pc = std::next(g.instructions.begin(), i % 2);
+    step.full_lhs = x;
+    step.full_lhs_value = from_integer(i, type);
+    goto_trace.add_step(step);
+  }
+
+  goto_trace_stept assertion;
+  assertion.step_nr = 4;
+  assertion.type = goto_trace_stept::typet::ASSERT;
+  assertion.hidden = true;
+  assertion.function_id = "f";
+  assertion.pc = f.instructions.begin();
+  assertion.cond_expr = equal_exprt(x, from_integer(0, type));
+  assertion.property_id = "f.assertion.1";
+  assertion.comment = "x == 0";
+  assertion.thread_nr = 1;
+  goto_trace.add_step(assertion);
+
+  goto_trace_stept output;
+  output.step_nr = 5;
+  output.type = goto_trace_stept::typet::OUTPUT;
+  output.function_id = "f";
+  output.pc = std::next(f.instructions.begin());
+  output.format_string = "%d";
+  output.io_id = "out";
+  output.io_args.push_back(x);
+  output.formatted = true;
+  goto_trace.add_step(output);
+
+  std::stringstream binary;
+  write_binary_goto_trace(goto_trace, binary);
+
+  WHEN("The trace is read back")
+  {
+    goto_tracet read_trace;
+    read_binary_goto_trace(binary, goto_functions, read_trace);
+
+    THEN("All steps are the same")
+    {
+      REQUIRE(read_trace.steps.size() == goto_trace.steps.size());
+
+      auto read_step = read_trace.steps.begin();
+      for(const auto &step : goto_trace.steps)
+      {
+        REQUIRE(read_step->step_nr == step.step_nr);
+        REQUIRE(read_step->type == step.type);
+        REQUIRE(read_step->hidden == step.hidden);
+        REQUIRE(read_step->formatted == step.formatted);
+        REQUIRE(read_step->thread_nr == step.thread_nr);
+        REQUIRE(read_step->function_id == step.function_id);
+        REQUIRE(read_step->pc == step.pc);
+        REQUIRE(read_step->cond_expr == step.cond_expr);
+        REQUIRE(read_step->property_id == step.property_id);
+        REQUIRE(read_step->comment == step.comment);
+        REQUIRE(read_step->full_lhs == step.full_lhs);
+        REQUIRE(read_step->full_lhs_value == step.full_lhs_value);
+        REQUIRE(read_step->format_string == step.format_string);
+        REQUIRE(read_step->io_id == step.io_id);
+        REQUIRE(read_step->io_args == step.io_args);
+        ++read_step;
+      }
+    }
+  }
+
+  WHEN("The trace is read against other goto functions")
+  {
+    goto_functionst other_functions;
+    other_functions.function_map["f"].body.add(
+      goto_programt::make_end_function());
+
+    THEN("Reading fails")
+    {
+      goto_tracet read_trace;
+      REQUIRE_THROWS_AS(
+        read_binary_goto_trace(binary, other_functions, read_trace),
+        deserialization_exceptiont);
+    }
+  }
+
+  WHEN("The stream is not a binary trace")
+  {
+    std::stringstream text("trace");
+
+    THEN("Reading fails")
+    {
+      goto_tracet read_trace;
+      REQUIRE_THROWS_AS(
+        read_binary_goto_trace(text, goto_functions, read_trace),
+        deserialization_exceptiont);
+    }
+  }
+}
@@ -0,0 +1,72 @@
+/*******************************************************************\
+
+Module: Unit tests for frozen_goto_programt
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <goto-programs/frozen_goto_program.h>
+
+SCENARIO(
+  "Freezing and thawing goto programs",
+  "[core][goto-programs][frozen_goto_program]")
+{
+  GIVEN("A program with a loop")
+  {
+    // 0: SKIP
+    // 1: IF true GOTO 0
+    // 2: END_FUNCTION
+    goto_programt goto_program;
+    const auto head = goto_program.add(goto_programt::make_skip());
+    const auto back_edge =
+      goto_program.add(goto_programt::make_goto(head, true_exprt()));
+    const auto end = goto_program.add(goto_programt::make_end_function());
+    goto_program.update();
+
+    WHEN("The program is frozen")
+    {
+      const frozen_goto_programt frozen(goto_program);
+
+      THEN("Instructions are indexed in program order")
+      {
+        REQUIRE(frozen.size() == 3);
+        REQUIRE(frozen.index_of(head) == 0);
+        REQUIRE(frozen.index_of(back_edge) == 1);
+        REQUIRE(frozen.index_of(end) == 2);
+        REQUIRE(frozen[1].is_goto());
+      }
+
+      THEN("Targets, successors and predecessors are indices")
+      {
+        REQUIRE(frozen.targets(0).empty());
+        REQUIRE(frozen.targets(1).size() == 1);
+        REQUIRE(frozen.targets(1)[0] == 0);
+
+        REQUIRE(frozen.successors(0).size() == 1);
+        REQUIRE(frozen.successors(0)[0] == 1);
+        REQUIRE(frozen.successors(1).size() == 2);
+        REQUIRE(frozen.successors(2).empty());
+
+        REQUIRE(frozen.predecessors(0).size() == 1);
+        REQUIRE(frozen.predecessors(0)[0] == 1);
+        REQUIRE(frozen.predecessors(1).size() == 1);
+        REQUIRE(frozen.predecessors(1)[0] == 0);
+        REQUIRE(frozen.predecessors(2).size() == 1);
+        REQUIRE(frozen.predecessors(2)[0] == 1);
+      }
+
+      THEN("Thawing yields an equivalent program")
+      {
+        const goto_programt thawed = frozen.thaw();
+        REQUIRE(thawed.instructions.size() == 3);
+        const auto thawed_goto = std::next(thawed.instructions.begin());
+        REQUIRE(thawed_goto->get_target() == thawed.instructions.begin());
+        REQUIRE(thawed.instructions.begin()->is_target());
+        REQUIRE(thawed.equals(goto_program));
+      }
+    }
+  }
+}
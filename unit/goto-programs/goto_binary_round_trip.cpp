@@ -0,0 +1,125 @@
+/*******************************************************************\
+
+Module: Unit tests for writing and reading goto binaries
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/message.h>
+#include <util/tempfile.h>
+
+#include <goto-programs/goto_model.h>
+#include <goto-programs/read_bin_goto_object.h>
+#include <goto-programs/write_goto_binary.h>
+
+#include <fstream>
+#include <sstream>
+
+static void add_function(goto_modelt &goto_model, const irep_idt &name)
+{
+  const code_typet type({}, empty_typet());
+
+  symbolt symbol;
+  symbol.name = name;
+  symbol.base_name = name;
+  symbol.mode = ID_C;
+  symbol.type = type;
+  symbol.value = code_skipt();
+  goto_model.symbol_table.add(symbol);
+
+  goto_functiont &function = goto_model.goto_functions.function_map[name];
+  function.type = type;
+
+  // a loop, such that branch targets are written as well
+  goto_programt::targett loop =
+    function.body.add(goto_programt::make_skip(source_locationt()));
+  const exprt one = from_integer(1, signed_int_type());
+  function.body.add(goto_programt::make_goto(loop, equal_exprt(one, one)));
+  function.body.add(goto_programt::make_end_function());
+  function.body.update();
+}
+
+static void require_function(const goto_functiont &function)
+{
+  REQUIRE(function.body_available());
+  REQUIRE(function.body.instructions.size() == 3);
+  const auto &backward_goto = *std::next(function.body.instructions.begin());
+  REQUIRE(backward_goto.is_goto());
+  REQUIRE(backward_goto.get_target() == function.body.instructions.begin());
+  REQUIRE(backward_goto.get_condition().id() == ID_equal);
+}
+
+SCENARIO(
+  "Writing and reading goto binaries",
+  "[core][goto-programs][goto_binary]")
+{
+  GIVEN("A goto model with two functions")
+  {
+    goto_modelt goto_model;
+    add_function(goto_model, "f");
+    add_function(goto_model, "g");
+
+    null_message_handlert message_handler;
+
+    WHEN("It is written and read back")
+    {
+      std::stringstream binary;
+      REQUIRE(!write_goto_binary(binary, goto_model));
+
+      symbol_tablet symbol_table;
+      goto_functionst goto_functions;
+      REQUIRE(!read_bin_goto_object(
+        binary, "", symbol_table, goto_functions, message_handler));
+
+      THEN("All function bodies are read")
+      {
+        REQUIRE(symbol_table.has_symbol("f"));
+        REQUIRE(symbol_table.has_symbol("g"));
+        require_function(goto_functions.function_map.at("f"));
+        require_function(goto_functions.function_map.at("g"));
+      }
+    }
+
+    WHEN("It is written to a file and read lazily")
+    {
+      temporary_filet file("goto-binary", ".gb");
+      {
+        std::ofstream out(file(), std::ios::binary);
+        REQUIRE(!write_goto_binary(out, goto_model));
+      }
+
+      std::ifstream in(file(), std::ios::binary);
+      symbol_tablet symbol_table;
+      goto_functionst goto_functions;
+      lazy_goto_binary_functionst lazy_functions;
+      REQUIRE(!read_bin_goto_object(
+        in,
+        file(),
+        symbol_table,
+        goto_functions,
+        lazy_functions,
+        message_handler));
+
+      THEN("Function bodies are read on demand")
+      {
+        REQUIRE(goto_functions.function_map.count("f") == 0);
+        REQUIRE(goto_functions.function_map.count("g") == 0);
+        REQUIRE(lazy_functions.has_function("f"));
+        REQUIRE(lazy_functions.has_function("g"));
+
+        goto_functiont g;
+        lazy_functions.load("g", symbol_table, g);
+        require_function(g);
+
+        goto_functiont f;
+        lazy_functions.load("f", symbol_table, f);
+        require_function(f);
+      }
+    }
+  }
+}
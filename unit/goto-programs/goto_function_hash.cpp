@@ -0,0 +1,66 @@
+/*******************************************************************\
+
+Module: Unit tests for goto_function_hash
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+
+#include <goto-programs/goto_function.h>
+#include <goto-programs/goto_function_hash.h>
+
+static goto_functiont
+make_function(const irep_idt &local, int value, const irep_idt &file)
+{
+  const symbol_exprt x(local, signed_int_type());
+  source_locationt source_location;
+  source_location.set_file(file);
+
+  goto_functiont goto_function;
+  goto_function.body.add(goto_programt::make_decl(x, source_location));
+  goto_function.body.add(goto_programt::make_assignment(
+    x, from_integer(value, signed_int_type()), source_location));
+  goto_function.body.add(goto_programt::make_dead(x, source_location));
+  goto_function.body.add(goto_programt::make_end_function(source_location));
+  return goto_function;
+}
+
+SCENARIO("Hashing goto functions", "[core][goto-programs][goto_function_hash]")
+{
+  const goto_functiont f = make_function("f::1::x", 1, "a.c");
+
+  GIVEN("A function that only differs in source locations and local names")
+  {
+    const goto_functiont g = make_function("f::2::y", 1, "b.c");
+
+    THEN("The hashes are equal")
+    {
+      REQUIRE(goto_function_hash("f", f) == goto_function_hash("f", g));
+    }
+  }
+
+  GIVEN("A function that assigns a different value")
+  {
+    const goto_functiont g = make_function("f::1::x", 2, "a.c");
+
+    THEN("The hashes differ")
+    {
+      REQUIRE(goto_function_hash("f", f) != goto_function_hash("f", g));
+    }
+  }
+
+  GIVEN("A function that assigns to a global variable instead")
+  {
+    const goto_functiont g = make_function("x", 1, "a.c");
+
+    THEN("The hashes differ")
+    {
+      REQUIRE(goto_function_hash("f", f) != goto_function_hash("f", g));
+    }
+  }
+}
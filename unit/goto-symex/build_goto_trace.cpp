@@ -0,0 +1,135 @@
+/*******************************************************************\
+
+Module: Unit tests for build_goto_trace
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/namespace.h>
+#include <util/symbol_table.h>
+
+#include <goto-symex/build_goto_trace.h>
+
+#include <solvers/decision_procedure.h>
+
+/// Decision procedure that evaluates constants to themselves, assigns 42 to
+/// anything else and records which expressions were asked for
+class recording_decision_proceduret : public decision_proceduret
+{
+public:
+  mutable std::vector<exprt> queried;
+
+  exprt get(const exprt &expr) const override
+  {
+    if(expr.is_constant())
+      return expr;
+    queried.push_back(expr);
+    return from_integer(42, expr.type());
+  }
+
+  exprt handle(const exprt &expr) override
+  {
+    return expr;
+  }
+  void set_to(const exprt &, bool) override
+  {
+  }
+  void print_assignment(std::ostream &) const override
+  {
+  }
+  std::string decision_procedure_text() const override
+  {
+    return "recording decision procedure";
+  }
+  std::size_t get_number_of_solver_calls() const override
+  {
+    return 0;
+  }
+
+protected:
+  resultt dec_solve() override
+  {
+    return resultt::D_ERROR;
+  }
+};
+
+static void add_assignment(
+  symex_target_equationt &equation,
+  const symex_targett::sourcet &source,
+  const irep_idt &identifier,
+  bool hidden)
+{
+  equation.SSA_steps.emplace_back(source, goto_trace_stept::typet::ASSIGNMENT);
+  SSA_stept &step = equation.SSA_steps.back();
+  step.guard_handle = true_exprt();
+  step.hidden = hidden;
+  step.original_full_lhs = symbol_exprt(identifier, signed_int_type());
+  step.ssa_full_lhs =
+    symbol_exprt(id2string(identifier) + "#1", signed_int_type());
+}
+
+SCENARIO("Values of trace steps", "[core][goto-symex][build_goto_trace]")
+{
+  GIVEN("A hidden and a visible assignment, a failing assertion and an "
+        "assignment after it")
+  {
+    symbol_tablet symbol_table;
+    const namespacet ns(symbol_table);
+    goto_programt goto_program;
+    goto_program.add(goto_programt::make_assertion(false_exprt()));
+    const symex_targett::sourcet source("main", goto_program);
+
+    symex_target_equationt equation(null_message_handler);
+    add_assignment(equation, source, "hidden", true);
+    add_assignment(equation, source, "visible", false);
+    equation.SSA_steps.emplace_back(source, goto_trace_stept::typet::ASSERT);
+    equation.SSA_steps.back().guard_handle = true_exprt();
+    equation.SSA_steps.back().cond_handle = false_exprt();
+    add_assignment(equation, source, "after", false);
+
+    recording_decision_proceduret decision_procedure;
+    goto_tracet goto_trace;
+
+    WHEN("The values of all steps are needed")
+    {
+      build_goto_trace(equation, decision_procedure, ns, goto_trace);
+
+      THEN("The trace ends at the assertion and has all values")
+      {
+        REQUIRE(goto_trace.steps.size() == 3);
+        REQUIRE(
+          goto_trace.steps.front().full_lhs_value ==
+          from_integer(42, signed_int_type()));
+        REQUIRE(decision_procedure.queried.size() == 2);
+        REQUIRE_FALSE(goto_trace.steps.back().cond_value);
+      }
+    }
+
+    WHEN("Only the values of visible steps are needed")
+    {
+      build_goto_trace(
+        equation,
+        decision_procedure,
+        ns,
+        goto_trace,
+        [](const goto_trace_stept &step) { return !step.hidden; });
+
+      THEN("The hidden step is kept without its value")
+      {
+        REQUIRE(goto_trace.steps.size() == 3);
+        REQUIRE(goto_trace.steps.front().full_lhs_value.is_nil());
+        REQUIRE(
+          decision_procedure.queried ==
+          std::vector<exprt>{symbol_exprt("visible#1", signed_int_type())});
+        REQUIRE(goto_trace.steps.back().is_assert());
+        REQUIRE_FALSE(goto_trace.steps.back().cond_value);
+      }
+    }
+  }
+}
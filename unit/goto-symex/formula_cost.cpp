@@ -0,0 +1,70 @@
+/*******************************************************************\
+
+Module: Unit tests for estimate_formula_cost
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <goto-symex/formula_cost.h>
+#include <util/arith_tools.h>
+#include <util/namespace.h>
+#include <util/std_expr.h>
+#include <util/std_types.h>
+#include <util/symbol_table.h>
+
+SCENARIO("estimate_formula_cost", "[core][goto-symex][formula_cost]")
+{
+  const symbol_tablet symbol_table;
+  const namespacet ns(symbol_table);
+
+  const unsignedbv_typet int_type{32};
+  const symbol_exprt x{"x", int_type};
+  const symbol_exprt y{"y", int_type};
+  const exprt one = from_integer(1, int_type);
+
+  GIVEN("Symbols and constants")
+  {
+    THEN("They cost nothing")
+    {
+      REQUIRE(estimate_formula_cost(x, ns) == 0);
+      REQUIRE(estimate_formula_cost(one, ns) == 0);
+    }
+  }
+
+  GIVEN("Arithmetic on 32-bit operands")
+  {
+    const std::size_t plus_cost = estimate_formula_cost(plus_exprt{x, y}, ns);
+    const std::size_t mult_cost = estimate_formula_cost(mult_exprt{x, y}, ns);
+    const std::size_t div_cost = estimate_formula_cost(div_exprt{x, y}, ns);
+
+    THEN("Multiplication and division cost more than addition")
+    {
+      REQUIRE(plus_cost > 0);
+      REQUIRE(mult_cost > 32 * plus_cost / 2);
+      REQUIRE(div_cost > mult_cost);
+    }
+
+    THEN("Shifts by a constant distance cost nothing")
+    {
+      REQUIRE(estimate_formula_cost(shl_exprt{x, one}, ns) == 0);
+      REQUIRE(estimate_formula_cost(shl_exprt{x, y}, ns) > 0);
+    }
+  }
+
+  GIVEN("An expression with a shared sub-expression")
+  {
+    const mult_exprt product{x, y};
+    const plus_exprt sum{product, product};
+
+    THEN("The shared sub-expression is counted once")
+    {
+      REQUIRE(
+        estimate_formula_cost(sum, ns) ==
+        estimate_formula_cost(product, ns) +
+          estimate_formula_cost(plus_exprt{x, y}, ns));
+    }
+  }
+}
@@ -0,0 +1,160 @@
+/*******************************************************************\
+
+Module: Unit tests for propagate_assignments
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <goto-symex/propagate_assignments.h>
+#include <goto-symex/symex_target_equation.h>
+#include <util/arith_tools.h>
+#include <util/namespace.h>
+#include <util/simplify_expr.h>
+#include <util/symbol_table.h>
+
+static ssa_exprt ssa_symbol(const irep_idt &identifier, std::size_t level_2)
+{
+  ssa_exprt ssa{symbol_exprt{identifier, signedbv_typet{32}}};
+  ssa.set_level_2(level_2);
+  return ssa;
+}
+
+SCENARIO(
+  "Propagation of assignments in the SSA equation",
+  "[core][goto-symex][propagate_assignments]")
+{
+  symbol_tablet symbol_table;
+  const namespacet ns{symbol_table};
+  goto_programt goto_program;
+  goto_program.add_instruction(SKIP);
+  const symex_targett::sourcet source{"f", goto_program};
+  symex_target_equationt equation{null_message_handler};
+
+  const signedbv_typet int_type{32};
+  const ssa_exprt x = ssa_symbol("x", 1);
+  const ssa_exprt y = ssa_symbol("y", 1);
+  const ssa_exprt z = ssa_symbol("z", 1);
+  const ssa_exprt input = ssa_symbol("input", 0);
+  const exprt one = from_integer(1, int_type);
+
+  auto assign = [&](const ssa_exprt &lhs, const exprt &rhs) {
+    equation.assignment(
+      true_exprt{},
+      lhs,
+      lhs,
+      lhs.get_original_expr(),
+      rhs,
+      source,
+      symex_targett::assignment_typet::STATE);
+  };
+
+  GIVEN("A chain of constant assignments")
+  {
+    assign(x, from_integer(5, int_type));
+    assign(y, plus_exprt{x, one});
+    equation.assertion(
+      true_exprt{},
+      equal_exprt{y, from_integer(6, int_type)},
+      "property",
+      source);
+
+    THEN("Constants are propagated into later steps")
+    {
+      REQUIRE(propagate_assignments(equation, ns) == 2);
+
+      const SSA_stept &y_step = *std::next(equation.SSA_steps.begin());
+      REQUIRE(y_step.ssa_rhs == from_integer(6, int_type));
+      REQUIRE(y_step.cond_expr == equal_exprt{y, y_step.ssa_rhs});
+      REQUIRE(y_step.ssa_lhs == y);
+      REQUIRE(equation.SSA_steps.back().cond_expr.is_true());
+    }
+  }
+
+  GIVEN("A chain of copies of an unconstrained symbol")
+  {
+    assign(x, input);
+    assign(y, x);
+    assign(z, plus_exprt{y, one});
+
+    THEN("Uses refer to the first symbol of the chain")
+    {
+      REQUIRE(propagate_assignments(equation, ns) == 2);
+      REQUIRE(
+        equation.SSA_steps.back().ssa_rhs ==
+        simplify_expr(plus_exprt{input, one}, ns));
+    }
+  }
+
+  GIVEN("Two assignments of the same term")
+  {
+    assign(x, plus_exprt{input, one});
+    assign(y, plus_exprt{input, one});
+    assign(z, mult_exprt{y, y});
+
+    THEN("The second one becomes a copy of the first one")
+    {
+      REQUIRE(propagate_assignments(equation, ns) == 2);
+
+      const SSA_stept &y_step = *std::next(equation.SSA_steps.begin());
+      REQUIRE(y_step.ssa_rhs == x);
+      REQUIRE(y_step.cond_expr == equal_exprt{y, x});
+      REQUIRE(equation.SSA_steps.back().ssa_rhs == mult_exprt{x, x});
+    }
+  }
+
+  GIVEN("An array update that writes back the element it reads")
+  {
+    const array_typet array_type{int_type, from_integer(4, int_type)};
+    ssa_exprt a{symbol_exprt{"a", array_type}};
+    a.set_level_2(0);
+    ssa_exprt b{symbol_exprt{"b", array_type}};
+    b.set_level_2(1);
+    assign(b, with_exprt{a, input, index_exprt{a, input}});
+    assign(x, index_exprt{b, one});
+
+    THEN("The update collapses to a copy of the array")
+    {
+      REQUIRE(propagate_assignments(equation, ns) == 2);
+      REQUIRE(equation.SSA_steps.front().ssa_rhs == a);
+      REQUIRE(equation.SSA_steps.back().ssa_rhs == index_exprt{a, one});
+    }
+  }
+
+  GIVEN("A struct that is rebuilt from the members of another one")
+  {
+    const struct_typet struct_type{
+      {{"c1", int_type}, {"c2", int_type}}};
+    ssa_exprt s{symbol_exprt{"s", struct_type}};
+    s.set_level_2(0);
+    ssa_exprt t{symbol_exprt{"t", struct_type}};
+    t.set_level_2(1);
+    assign(
+      t,
+      struct_exprt{{member_exprt{s, "c1", int_type},
+                    member_exprt{s, "c2", int_type}},
+                   struct_type});
+
+    THEN("The struct collapses to a copy of the other one")
+    {
+      REQUIRE(propagate_assignments(equation, ns) == 1);
+      REQUIRE(equation.SSA_steps.front().ssa_rhs == s);
+    }
+  }
+
+  GIVEN("An assignment that is ignored")
+  {
+    assign(x, from_integer(5, int_type));
+    equation.SSA_steps.back().ignore = true;
+    assign(y, plus_exprt{x, one});
+
+    THEN("Its value is not propagated")
+    {
+      REQUIRE(propagate_assignments(equation, ns) == 0);
+      REQUIRE(equation.SSA_steps.back().ssa_rhs == plus_exprt{x, one});
+    }
+  }
+}
@@ -0,0 +1,79 @@
+/*******************************************************************\
+
+Module: Unit tests for group_properties_by_cone
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+
+#include <goto-symex/property_groups.h>
+#include <goto-symex/symex_target_equation.h>
+
+SCENARIO(
+  "Properties are grouped by their cones of influence",
+  "[core][goto-symex][property_groups]")
+{
+  const typet type = signed_int_type();
+
+  goto_programt goto_program;
+  const auto skip = goto_program.add(goto_programt::make_skip());
+  std::vector<goto_programt::const_targett> asserts;
+  for(const char *property_id : {"p1", "p2", "p3"})
+  {
+    source_locationt source_location;
+    source_location.set_property_id(property_id);
+    asserts.push_back(goto_program.add(
+      goto_programt::make_assertion(true_exprt(), source_location)));
+  }
+
+  symex_target_equationt equation(null_message_handler);
+
+  auto ssa = [&type](const irep_idt &identifier) {
+    ssa_exprt result(symbol_exprt(identifier, type));
+    result.set_level_2(1);
+    return result;
+  };
+
+  auto assign = [&](const ssa_exprt &lhs, const exprt &rhs) {
+    equation.SSA_steps.emplace_back(
+      symex_targett::sourcet("main", skip),
+      goto_trace_stept::typet::ASSIGNMENT);
+    equation.SSA_steps.back().ssa_lhs = lhs;
+    equation.SSA_steps.back().ssa_rhs = rhs;
+  };
+
+  auto assert_that = [&](std::size_t property, const exprt &condition) {
+    equation.SSA_steps.emplace_back(
+      symex_targett::sourcet("main", asserts[property]),
+      goto_trace_stept::typet::ASSERT);
+    equation.SSA_steps.back().cond_expr = condition;
+  };
+
+  const ssa_exprt a = ssa("a");
+  const ssa_exprt b = ssa("b");
+  const ssa_exprt c = ssa("c");
+  const ssa_exprt d = ssa("d");
+  const exprt zero = from_integer(0, type);
+
+  assign(a, symbol_exprt("x", type));
+  assign(b, plus_exprt(a, from_integer(1, type)));
+  assign(c, symbol_exprt("y", type));
+  assign(d, mult_exprt(c, from_integer(2, type)));
+
+  // p1 and p2 depend on a and b, p3 on c and d
+  assert_that(0, binary_relation_exprt(b, ID_gt, zero));
+  assert_that(1, notequal_exprt(b, a));
+  assert_that(2, binary_relation_exprt(d, ID_gt, zero));
+
+  const auto groups = group_properties_by_cone(equation, {"p1", "p2", "p3"});
+
+  REQUIRE(groups.size() == 2);
+  REQUIRE(groups[0] == std::vector<irep_idt>{"p1", "p2"});
+  REQUIRE(groups[1] == std::vector<irep_idt>{"p3"});
+}
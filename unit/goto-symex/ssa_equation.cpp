@@ -13,6 +13,8 @@ Author: Diffblue Ltd.
 
 #include <goto-symex/symex_target_equation.h>
 
+#include <solvers/decision_procedure.h>
+
 SCENARIO("Validation of well-formed SSA steps", "[core][goto-symex][validate]")
 {
   GIVEN("A program with one function return")
@@ -59,3 +61,80 @@ SCENARIO("Validation of well-formed SSA steps", "[core][goto-symex][validate]")
     }
   }
 }
+
+/// Decision procedure that only counts the calls to `handle`
+class handle_countert : public decision_proceduret
+{
+public:
+  std::size_t handle_calls = 0;
+
+  exprt handle(const exprt &expr) override
+  {
+    ++handle_calls;
+    return symbol_exprt("handle" + std::to_string(handle_calls), expr.type());
+  }
+
+  void set_to(const exprt &, bool) override
+  {
+  }
+  exprt get(const exprt &expr) const override
+  {
+    return expr;
+  }
+  void print_assignment(std::ostream &) const override
+  {
+  }
+  std::string decision_procedure_text() const override
+  {
+    return "handle counter";
+  }
+  std::size_t get_number_of_solver_calls() const override
+  {
+    return 0;
+  }
+
+protected:
+  resultt dec_solve() override
+  {
+    return resultt::D_ERROR;
+  }
+};
+
+SCENARIO("Conversion of SSA step guards", "[core][goto-symex][convert]")
+{
+  GIVEN("Steps whose guards are shared, equal or ignored")
+  {
+    goto_programt goto_program;
+    goto_program.add_instruction(SKIP);
+    symex_targett::sourcet source("foo", goto_program);
+    symex_target_equationt equation(null_message_handler);
+
+    const symbol_exprt guard("g", bool_typet());
+    for(std::size_t i = 0; i < 4; ++i)
+    {
+      equation.SSA_steps.emplace_back(source, goto_trace_stept::typet::ASSUME);
+      equation.SSA_steps.back().guard = guard;
+    }
+    // equal to the other guards, but not the same irep
+    equation.SSA_steps[2].guard = symbol_exprt("g", bool_typet());
+    equation.SSA_steps[3].ignore = true;
+
+    WHEN("The guards are converted")
+    {
+      handle_countert decision_procedure;
+      equation.convert_guards(decision_procedure);
+
+      THEN("Consecutive steps sharing a guard irep share its handle")
+      {
+        REQUIRE(decision_procedure.handle_calls == 2);
+        REQUIRE(
+          equation.SSA_steps[1].guard_handle ==
+          equation.SSA_steps[0].guard_handle);
+        REQUIRE(
+          equation.SSA_steps[2].guard_handle !=
+          equation.SSA_steps[0].guard_handle);
+        REQUIRE(equation.SSA_steps[3].guard_handle == false_exprt());
+      }
+    }
+  }
+}
@@ -284,4 +284,40 @@ SCENARIO(
       }
     }
   }
+  GIVEN(
+    "A symbol `struct2` with two fields, and constant propagation activated")
+  {
+    exprt::operandst guard;
+    symex_config.constant_propagation = true;
+    struct_union_typet::componentst components{{"field1", int_type},
+                                               {"field2", int_type}};
+    const struct_typet struct_type{components};
+    const symbol_exprt struct2_sym{"struct2", struct_type};
+    add_to_symbol_table(symbol_table, struct2_sym);
+    const ssa_exprt struct2_ssa{struct2_sym};
+    symex_target_equationt target_equation{null_message_handler};
+    symex_assignt symex_assign{state,
+                               symex_targett::assignment_typet::STATE,
+                               ns,
+                               symex_config,
+                               target_equation};
+
+    WHEN("It is assigned `{1, 2}` and then `{1, 3}`")
+    {
+      const struct_exprt rhs1{
+        {from_integer(1, int_type), from_integer(2, int_type)}, struct_type};
+      const struct_exprt rhs2{
+        {from_integer(1, int_type), from_integer(3, int_type)}, struct_type};
+      symex_assign.assign_symbol(struct2_ssa, expr_skeletont{}, rhs1, guard);
+      symex_assign.assign_symbol(struct2_ssa, expr_skeletont{}, rhs2, guard);
+
+      THEN("The second assignment only assigns the field that changes")
+      {
+        REQUIRE(target_equation.SSA_steps.size() == 3);
+        const SSA_stept &step = target_equation.SSA_steps.back();
+        REQUIRE(step.ssa_lhs.get_identifier() == "struct2!0#2..field2");
+        REQUIRE(step.ssa_rhs == from_integer(3, int_type));
+      }
+    }
+  }
 }
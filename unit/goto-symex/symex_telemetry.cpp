@@ -0,0 +1,44 @@
+/*******************************************************************\
+
+Module: Unit tests for symex_telemetryt
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <goto-symex/symex_telemetry.h>
+#include <util/tempfile.h>
+
+#include <fstream>
+#include <sstream>
+
+SCENARIO(
+  "Symex telemetry records the unwindings of loops",
+  "[core][goto-symex][symex_telemetry]")
+{
+  temporary_filet file("cbmc_unit_symex_telemetry", ".json");
+
+  symex_telemetryt telemetry;
+  REQUIRE(!telemetry.is_enabled());
+  REQUIRE(telemetry.enable(file(), std::chrono::hours(1)));
+  REQUIRE(telemetry.is_enabled());
+
+  telemetry.loop_unwound("f.0", 1);
+  telemetry.loop_unwound("f.0", 3);
+  telemetry.loop_unwound("f.0", 2);
+  telemetry.loop_unwound("g.1", 1);
+  telemetry.disable();
+  REQUIRE(!telemetry.is_enabled());
+
+  // the last sample is written when disabling
+  std::ifstream in(file());
+  std::ostringstream sample;
+  sample << in.rdbuf();
+
+  REQUIRE(sample.str().find("\"f.0\": 3") != std::string::npos);
+  REQUIRE(sample.str().find("\"g.1\": 1") != std::string::npos);
+  REQUIRE(sample.str().find("\"loop\": \"g.1\"") != std::string::npos);
+  REQUIRE(sample.str().find("\"steps\": 0") != std::string::npos);
+}
@@ -10,6 +10,7 @@ Author: Diffblue Ltd.
 
 #include <goto-programs/goto_functions.h>
 #include <goto-programs/interpreter_class.h>
+#include <util/arith_tools.h>
 #include <util/message.h>
 #include <util/mp_arith.h>
 #include <util/namespace.h>
@@ -68,3 +69,19 @@ SCENARIO("interpreter evaluation null pointer expressions")
     REQUIRE_THAT(mp_vector, Catch::Equals(null_vector));
   }
 }
+
+SCENARIO("interpreter evaluation of repeated constants")
+{
+  interpreter_testt interpreter_test;
+  mp_vectort minus_three = {-3};
+
+  THEN("constants evaluate to the same value every time")
+  {
+    const exprt constant_expr = from_integer(-3, signedbv_typet(32));
+
+    REQUIRE_THAT(
+      interpreter_test.evaluate(constant_expr), Catch::Equals(minus_three));
+    REQUIRE_THAT(
+      interpreter_test.evaluate(constant_expr), Catch::Equals(minus_three));
+  }
+}
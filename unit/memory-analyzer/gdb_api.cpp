@@ -10,6 +10,7 @@ Author: Malte Mues <mail.mues@gmail.com>
 #include <testing-utils/use_catch.h>
 
 #include <cstdio>
+#include <cstring>
 #include <regex>
 #include <string>
 #include <vector>
@@ -245,4 +246,23 @@ TEST_CASE("gdb api test", "[core][memory-analyzer]")
       REQUIRE(!value.string);
     }
   }
+
+  SECTION("read memory")
+  {
+    const bool r = gdb_api.run_gdb_to_breakpoint("checkpoint");
+    REQUIRE(r);
+
+    {
+      const auto bytes = gdb_api.read_memory("&x", sizeof(int));
+      REQUIRE(bytes.size() == sizeof(int));
+      int x;
+      std::memcpy(&x, bytes.data(), sizeof(int));
+      REQUIRE(x == 8);
+    }
+
+    {
+      const auto bytes = gdb_api.read_memory("np", sizeof(int));
+      REQUIRE(bytes.empty());
+    }
+  }
 }
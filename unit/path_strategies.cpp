@@ -95,6 +95,33 @@ SCENARIO("path strategies")
        symex_eventt::resume(symex_eventt::enumt::NEXT, 5),
        symex_eventt::resume(symex_eventt::enumt::JUMP, 7),
        symex_eventt::result(symex_eventt::enumt::SUCCESS)});
+    check_with_strategy(
+      "coverage",
+      opts_callback,
+      c,
+      {// Entry state is line 0
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 0),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 7),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 5),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS)});
+    check_with_strategy(
+      "distance",
+      opts_callback,
+      c,
+      {// Entry state is line 0
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 0),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 7),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 5),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS)});
+    check_with_strategy(
+      "random",
+      opts_callback,
+      c,
+      {// Entry state is line 0
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 0),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 7),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 5),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS)});
   }
 
   GIVEN("a program with nested conditionals")
@@ -156,6 +183,21 @@ SCENARIO("path strategies")
        symex_eventt::resume(symex_eventt::enumt::NEXT, 14),
        symex_eventt::resume(symex_eventt::enumt::JUMP, 16),
        symex_eventt::result(symex_eventt::enumt::SUCCESS)});
+
+    check_with_strategy(
+      "random",
+      opts_callback,
+      c,
+      {// Entry state is line 0
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 0),
+       // The order follows from the fixed seed of the generator
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 13),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 14),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 6),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 16),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 7),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 9),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS)});
   }
 
   GIVEN("a loop program to test functional correctness")
@@ -293,6 +335,146 @@ SCENARIO("path strategies")
          symex_eventt::result(symex_eventt::enumt::FAILURE)});
     }
   }
+
+  GIVEN("a program with consecutive conditionals")
+  {
+    std::function<void(optionst &)> opts_callback = [](optionst &) {};
+
+    c =
+      "/*  1 */  int main()      \n"
+      "/*  2 */  {               \n"
+      "/*  3 */    int x, y, z;  \n"
+      "/*  4 */    if(x)         \n"
+      "/*  5 */      y = 1;      \n"
+      "/*  6 */    else          \n"
+      "/*  7 */      y = 0;      \n"
+      "/*  8 */    if(z)         \n"
+      "/*  9 */      y = 2;      \n"
+      "/* 10 */    x = 3;        \n"
+      "/* 11 */  }               \n";
+
+    check_with_strategy(
+      "lifo",
+      opts_callback,
+      c,
+      {// Entry state is line 0
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 0),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 7),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 10),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 9),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 5),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 10),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 9),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS)});
+
+    check_with_strategy(
+      "coverage",
+      opts_callback,
+      c,
+      {// Entry state is line 0
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 0),
+       // Nothing has been visited yet, so proceed as lifo does
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 7),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 10),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 9),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 5),
+       // Line 10 has been executed twice and line 9 once
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 9),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 10),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS)});
+  }
+
+  GIVEN("a program with an assertion in one branch")
+  {
+    std::function<void(optionst &)> opts_callback = [](optionst &) {};
+
+    c =
+      "/*  1 */  int main()         \n"
+      "/*  2 */  {                  \n"
+      "/*  3 */    int x;           \n"
+      "/*  4 */    if(x)            \n"
+      "/*  5 */      assert(x == 2);\n"
+      "/*  6 */    else             \n"
+      "/*  7 */      x = 0;         \n"
+      "/*  8 */  }                  \n";
+
+    check_with_strategy(
+      "lifo",
+      opts_callback,
+      c,
+      {// Entry state is line 0
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 0),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 7),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 5),
+       symex_eventt::result(symex_eventt::enumt::FAILURE),
+       // Overall result
+       symex_eventt::result(symex_eventt::enumt::FAILURE)});
+
+    check_with_strategy(
+      "distance",
+      opts_callback,
+      c,
+      {// Entry state is line 0
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 0),
+       // The assertion is reached first
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 5),
+       symex_eventt::result(symex_eventt::enumt::FAILURE),
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 7),
+       // Overall result
+       symex_eventt::result(symex_eventt::enumt::FAILURE)});
+  }
+
+  GIVEN("branch decisions of a concrete execution")
+  {
+    temporary_filet seed_file("concolic-seed_", ".txt");
+    std::function<void(optionst &)> opts_callback =
+      [&seed_file](optionst &opts) {
+        opts.set_option("concolic-seed", seed_file());
+      };
+
+    c =
+      "/*  1 */  int main()            \n"
+      "/*  2 */  {                     \n"
+      "/*  3 */    int x, y;           \n"
+      "/*  4 */    if(x)               \n"
+      "/*  5 */    {                   \n"
+      "/*  6 */      if(y)             \n"
+      "/*  7 */        y = 1;          \n"
+      "/*  8 */      else              \n"
+      "/*  9 */        y = 0;          \n"
+      "/* 10 */    }                   \n"
+      "/* 11 */    else                \n"
+      "/* 12 */    {                   \n"
+      "/* 13 */      if(y)             \n"
+      "/* 14 */        y = 1;          \n"
+      "/* 15 */      else              \n"
+      "/* 16 */        y = 0;          \n"
+      "/* 17 */    }                   \n"
+      "/* 18 */  }                     \n";
+
+    {
+      // the concrete execution jumped to the outer else, with y != 0
+      std::ofstream of(seed_file().c_str());
+      of << "1 0\n";
+    }
+
+    check_with_strategy(
+      "concolic",
+      opts_callback,
+      c,
+      {// Entry state is line 0
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 0),
+       // The path of the concrete execution
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 13),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 14),
+       // Paths negating one decision, the deepest one first
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 16),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 6),
+       symex_eventt::resume(symex_eventt::enumt::NEXT, 7),
+       // Negating both decisions
+       symex_eventt::resume(symex_eventt::enumt::JUMP, 9),
+       symex_eventt::result(symex_eventt::enumt::SUCCESS)});
+  }
 }
 
 // In theory, there should be no need to change the code below when adding new
@@ -402,7 +584,8 @@ void _check_with_strategy(
   symbol_tablet symex_symbol_table;
   namespacet ns(goto_model.get_symbol_table(), symex_symbol_table);
   propertiest properties(initialize_properties(goto_model));
-  std::unique_ptr<path_storaget> worklist = get_path_strategy(strategy);
+  std::unique_ptr<path_storaget> worklist =
+    get_path_strategy(strategy, options);
   guard_managert guard_manager;
 
   {
@@ -303,4 +303,99 @@ SCENARIO(
       }
     }
   }
+
+  GIVEN("Object maps with common and distinct objects")
+  {
+    const signedbv_typet int32_type(32);
+    const symbol_exprt o1("o1", int32_type);
+    const symbol_exprt o2("o2", int32_type);
+    const symbol_exprt o3("o3", int32_type);
+
+    value_sett::object_mapt a;
+    value_set.insert(a, o1, mp_integer(0));
+    value_set.insert(a, o2);
+
+    value_sett::object_mapt b;
+    value_set.insert(b, o1, mp_integer(4));
+    value_set.insert(b, o3, mp_integer(0));
+
+    THEN("The union resets differing offsets and adds missing objects")
+    {
+      REQUIRE(value_set.make_union_would_change(a, b));
+      REQUIRE(value_set.make_union(a, b));
+      REQUIRE(a.read().size() == 3);
+      REQUIRE(!a.read().at(value_sett::object_numbering.number(o1)));
+      REQUIRE(!a.read().at(value_sett::object_numbering.number(o2)));
+      REQUIRE(*a.read().at(value_sett::object_numbering.number(o3)) == 0);
+
+      REQUIRE(!value_set.make_union_would_change(a, b));
+      REQUIRE(!value_set.make_union(a, b));
+    }
+
+    THEN("The union into an empty map shares the other map")
+    {
+      value_sett::object_mapt c;
+      REQUIRE(value_set.make_union(c, a));
+      REQUIRE(c.get_d() == a.get_d());
+      REQUIRE(!value_set.make_union(c, a));
+    }
+
+    THEN("The union of a small map into a large one adds its objects")
+    {
+      value_sett::object_mapt large;
+      for(int i = 0; i < 100; ++i)
+      {
+        value_set.insert(
+          large, symbol_exprt("large" + std::to_string(i), int32_type));
+      }
+
+      REQUIRE(value_set.make_union(large, b));
+      REQUIRE(large.read().size() == 102);
+      REQUIRE(!value_set.make_union(large, b));
+      REQUIRE(value_set.make_union(large, a));
+      REQUIRE(large.read().size() == 103);
+      REQUIRE(!large.read().at(value_sett::object_numbering.number(o1)));
+      REQUIRE(value_set.make_union(a, large));
+      REQUIRE(a.read().size() == 103);
+    }
+  }
+
+  GIVEN("Value sets with common and distinct entries")
+  {
+    const signedbv_typet int32_type(32);
+    const symbol_exprt o1("o1", int32_type);
+    const symbol_exprt o2("o2", int32_type);
+
+    value_sett::entryt p("p", "");
+    value_set.insert(p.object_map, o1);
+    value_sett::entryt q("q", "");
+    value_set.insert(q.object_map, o2);
+    value_set.values.insert("p", p);
+    value_set.values.insert("q", q);
+
+    value_sett other;
+    other.values.insert("p", q);
+
+    THEN("Merging unions the common entries and keeps the others")
+    {
+      value_sett copy = value_set;
+      REQUIRE(copy.make_union(other));
+      REQUIRE(copy.values.size() == 2);
+      REQUIRE(copy.values.find("p")->get().object_map.read().size() == 2);
+      REQUIRE(copy.values.find("q")->get().object_map.read().size() == 1);
+      REQUIRE(!copy.make_union(other));
+      REQUIRE(!copy.make_union(value_set));
+
+      // the original value set is unchanged
+      REQUIRE(value_set.values.find("p")->get().object_map.read().size() == 1);
+    }
+
+    THEN("Merging into an empty value set copies all entries")
+    {
+      value_sett empty;
+      REQUIRE(empty.make_union(value_set));
+      REQUIRE(empty.values.size() == 2);
+      REQUIRE(!empty.make_union(value_set));
+    }
+  }
 }
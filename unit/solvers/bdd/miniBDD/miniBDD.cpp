@@ -325,6 +325,28 @@ SCENARIO("miniBDD", "[core][solver][miniBDD]")
     REQUIRE(oss.str() == dot_string);
   }
 
+  GIVEN("Operations that are repeated on the same manager")
+  {
+    mini_bdd_mgrt mgr;
+
+    mini_bddt x_bdd = mgr.Var("x");
+    mini_bddt y_bdd = mgr.Var("y");
+    mini_bddt z_bdd = mgr.Var("z");
+
+    const unsigned first = ((x_bdd | y_bdd) & z_bdd).node_number();
+    const unsigned second = ((x_bdd | y_bdd) & z_bdd).node_number();
+
+    THEN("Cached results are reused and remain correct")
+    {
+      REQUIRE(first == second);
+      REQUIRE(
+        ((x_bdd | y_bdd) & !x_bdd).node_number() ==
+        (y_bdd & !x_bdd).node_number());
+      REQUIRE((!(!z_bdd)).node_number() == z_bdd.node_number());
+      REQUIRE((x_bdd & !x_bdd).is_false());
+    }
+  }
+
   GIVEN("A bdd for (a&b)|!a")
   {
     symbol_exprt a("a", bool_typet());
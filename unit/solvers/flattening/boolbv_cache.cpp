@@ -0,0 +1,86 @@
+/*******************************************************************\
+
+Module: Unit tests for the caches of boolbvt
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for reusing the encodings of commuted expressions
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <solvers/flattening/boolbv.h>
+#include <solvers/sat/cnf_clause_list.h>
+
+#include <util/std_expr.h>
+#include <util/std_types.h>
+#include <util/symbol_table.h>
+
+/// Clause list that is never solved
+class unsolved_clause_listt : public cnf_clause_listt
+{
+public:
+  explicit unsolved_clause_listt(message_handlert &message_handler)
+    : cnf_clause_listt(message_handler)
+  {
+  }
+
+  void set_assignment(literalt, bool) override
+  {
+    UNREACHABLE;
+  }
+
+  bool is_in_conflict(literalt) const override
+  {
+    UNREACHABLE;
+  }
+};
+
+SCENARIO(
+  "boolbvt reuses the encodings of commuted expressions",
+  "[core][solvers][flattening][boolbv]")
+{
+  symbol_tablet symbol_table;
+  namespacet ns(symbol_table);
+  unsolved_clause_listt cnf(null_message_handler);
+  boolbvt boolbv(ns, cnf, null_message_handler);
+
+  const unsignedbv_typet type(8);
+  const symbol_exprt a("a", type);
+  const symbol_exprt b("b", type);
+
+  GIVEN("An encoded sum")
+  {
+    const bvt sum = boolbv.convert_bv(plus_exprt(a, b));
+    const std::size_t variables = cnf.no_variables();
+    const std::size_t clauses = cnf.no_clauses();
+
+    THEN("The commuted sum has the same encoding and adds no clauses")
+    {
+      REQUIRE(boolbv.convert_bv(plus_exprt(b, a)) == sum);
+      REQUIRE(cnf.no_variables() == variables);
+      REQUIRE(cnf.no_clauses() == clauses);
+    }
+
+    THEN("The difference is encoded anew")
+    {
+      REQUIRE(boolbv.convert_bv(minus_exprt(b, a)) != sum);
+      REQUIRE(cnf.no_variables() > variables);
+    }
+  }
+
+  GIVEN("An encoded equality")
+  {
+    const literalt equal = boolbv.convert(equal_exprt(a, b));
+    const std::size_t variables = cnf.no_variables();
+
+    THEN("The commuted equality has the same literal")
+    {
+      REQUIRE(boolbv.convert(equal_exprt(b, a)) == equal);
+      REQUIRE(cnf.no_variables() == variables);
+    }
+  }
+}
@@ -0,0 +1,76 @@
+/*******************************************************************\
+
+Module: Unit tests for boolbvt::get_values
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for boolbvt::get_values
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <solvers/flattening/boolbv.h>
+#include <solvers/sat/satcheck.h>
+
+#include <util/arith_tools.h>
+#include <util/c_types.h>
+#include <util/std_expr.h>
+#include <util/symbol_table.h>
+
+SCENARIO("boolbv_get_values", "[core][solvers][flattening][boolbv_get]")
+{
+  symbol_tablet symbol_table;
+  namespacet ns(symbol_table);
+  satcheckt satcheck(null_message_handler);
+  boolbvt boolbv(ns, satcheck, null_message_handler);
+
+  const unsignedbv_typet type(8);
+  const array_typet array_type(type, from_integer(3, size_type()));
+  const symbol_exprt x("x", type);
+  const symbol_exprt y("y", array_type);
+  const symbol_exprt b("b", bool_typet());
+
+  boolbv.set_to_true(equal_exprt(x, from_integer(42, type)));
+  boolbv.set_to_true(equal_exprt(
+    y,
+    array_exprt(
+      {from_integer(1, type), from_integer(200, type), x}, array_type)));
+  boolbv.set_to_true(b);
+
+  REQUIRE(boolbv() == decision_proceduret::resultt::D_SATISFIABLE);
+
+  GIVEN("Symbols of the formula")
+  {
+    const std::vector<exprt> values = boolbv.get_values({x, y, b});
+
+    THEN("The values match those obtained one by one")
+    {
+      REQUIRE(values.size() == 3);
+      REQUIRE(values[0] == from_integer(42, type));
+      REQUIRE(values[0] == boolbv.get(x));
+      REQUIRE(values[1] == boolbv.get(y));
+      REQUIRE(values[1].operands().size() == 3);
+      REQUIRE(values[1].operands()[1] == from_integer(200, type));
+      REQUIRE(values[1].operands()[2] == from_integer(42, type));
+      REQUIRE(values[2] == true_exprt());
+    }
+  }
+
+  GIVEN("Expressions that are not mapped symbols")
+  {
+    const symbol_exprt z("z", type);
+    const exprt constant = from_integer(7, type);
+    const std::vector<exprt> values = boolbv.get_values({z, constant, x});
+
+    THEN("They are obtained as by get")
+    {
+      REQUIRE(values.size() == 3);
+      REQUIRE(values[0] == boolbv.get(z));
+      REQUIRE(values[1] == constant);
+      REQUIRE(values[2] == from_integer(42, type));
+    }
+  }
+}
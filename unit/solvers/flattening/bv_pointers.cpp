@@ -0,0 +1,90 @@
+/*******************************************************************\
+
+Module: Unit tests for bv_pointerst
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for the decoding of object numbers in bv_pointerst
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <solvers/flattening/bv_pointers.h>
+#include <solvers/sat/satcheck.h>
+
+#include <util/config.h>
+#include <util/std_types.h>
+#include <util/symbol_table.h>
+
+/// Exposes the decoding of the object part of pointers
+class decoding_bv_pointerst : public bv_pointerst
+{
+public:
+  using bv_pointerst::bv_pointerst;
+
+  using bv_pointerst::bits;
+  using bv_pointerst::decode_object;
+  using bv_pointerst::object_bits;
+  using bv_pointerst::offset_bits;
+  using bv_pointerst::pointer_logic;
+};
+
+SCENARIO(
+  "bv_pointerst decodes object numbers",
+  "[core][solvers][flattening][bv_pointers]")
+{
+  config.ansi_c.set_LP64();
+  config.bv_encoding.object_bits = 8;
+
+  symbol_tablet symbol_table;
+  namespacet ns(symbol_table);
+  satcheck_no_simplifiert satcheck(null_message_handler);
+  decoding_bv_pointerst bv_pointers(ns, satcheck, null_message_handler);
+
+  // Besides NULL and INVALID
+  for(const char *name : {"a", "b", "c", "d", "e"})
+    bv_pointers.pointer_logic.add_object(symbol_exprt(name, signedbv_typet(8)));
+  const std::size_t number_of_objects = 7;
+
+  GIVEN("A pointer")
+  {
+    const bvt pointer = satcheck.new_variables(bv_pointers.bits);
+    const bvt &decoded = bv_pointers.decode_object(pointer);
+    REQUIRE(decoded.size() == number_of_objects);
+
+    THEN("Exactly the literal of the number of its object part holds")
+    {
+      for(const std::size_t number : {0, 1, 2, 5, 6, 7, 8, 12, 255})
+      {
+        bvt assumptions;
+        for(std::size_t i = 0; i < bv_pointers.object_bits; i++)
+        {
+          const literalt bit = pointer[bv_pointers.offset_bits + i];
+          assumptions.push_back(((number >> i) & 1) != 0 ? bit : !bit);
+        }
+        satcheck.set_assumptions(assumptions);
+        REQUIRE(satcheck.prop_solve() == propt::resultt::P_SATISFIABLE);
+
+        for(std::size_t j = 0; j < number_of_objects; j++)
+          REQUIRE(satcheck.l_get(decoded[j]).is_true() == (j == number));
+      }
+    }
+
+    THEN("Decoding it again reuses the literals")
+    {
+      const std::size_t variables = satcheck.no_variables();
+      REQUIRE(&bv_pointers.decode_object(pointer) == &decoded);
+      REQUIRE(satcheck.no_variables() == variables);
+    }
+
+    THEN("Pointers with the same object part share the decoding")
+    {
+      bvt other_pointer = pointer;
+      other_pointer[0] = !other_pointer[0];
+      REQUIRE(bv_pointers.decode_object(other_pointer) == decoded);
+    }
+  }
+}
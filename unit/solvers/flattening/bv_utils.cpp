@@ -0,0 +1,160 @@
+/*******************************************************************\
+
+Module: Unit tests for bv_utilst
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for the circuits bv_utilst builds for constant operands
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <solvers/flattening/bv_utils.h>
+#include <solvers/sat/cnf_clause_list.h>
+
+/// Clause list that is never solved
+class clause_listt : public cnf_clause_listt
+{
+public:
+  explicit clause_listt(message_handlert &message_handler)
+    : cnf_clause_listt(message_handler)
+  {
+  }
+
+  void set_assignment(literalt, bool) override
+  {
+    UNREACHABLE;
+  }
+
+  bool is_in_conflict(literalt) const override
+  {
+    UNREACHABLE;
+  }
+};
+
+/// Evaluate the circuit recorded in \p cnf for the inputs \p inputs set to
+/// \p value by unit propagation, which suffices for circuits without
+/// unconstrained variables, and return the value of \p outputs
+static unsigned evaluate(
+  cnf_clause_listt &cnf,
+  const bvt &inputs,
+  unsigned value,
+  const bvt &outputs)
+{
+  std::vector<tvt> assignment(cnf.no_variables(), tvt::unknown());
+  auto get = [&assignment](literalt l) {
+    if(l.is_constant())
+      return tvt(l.is_true());
+    const tvt v = assignment[l.var_no()];
+    return l.sign() ? !v : v;
+  };
+
+  for(std::size_t i = 0; i < inputs.size(); ++i)
+    assignment[inputs[i].var_no()] = tvt(((value >> i) & 1) != 0);
+
+  bool changed = true;
+  while(changed)
+  {
+    changed = false;
+    for(const auto &clause : cnf.get_clauses())
+    {
+      optionalt<literalt> unassigned;
+      bool satisfied = false;
+      std::size_t number_unassigned = 0;
+      for(const auto &l : clause)
+      {
+        const tvt v = get(l);
+        if(v.is_true())
+          satisfied = true;
+        else if(v.is_unknown())
+        {
+          unassigned = l;
+          ++number_unassigned;
+        }
+      }
+
+      if(!satisfied && number_unassigned == 1)
+      {
+        assignment[unassigned->var_no()] = tvt(!unassigned->sign());
+        changed = true;
+      }
+    }
+  }
+
+  unsigned result = 0;
+  for(std::size_t i = 0; i < outputs.size(); ++i)
+  {
+    const tvt v = get(outputs[i]);
+    REQUIRE(v.is_known());
+    if(v.is_true())
+      result |= 1u << i;
+  }
+  return result;
+}
+
+SCENARIO(
+  "bv_utilst multiplies by constants",
+  "[core][solvers][flattening][bv_utils]")
+{
+  const std::size_t width = 8;
+  const unsigned mask = (1u << width) - 1;
+
+  for(const unsigned factor : {0u, 1u, 3u, 6u, 7u, 10u, 0x55u, 0xf0u, 0xffu})
+  {
+    clause_listt cnf(null_message_handler);
+    bv_utilst bv_utils(cnf);
+    const bvt x = cnf.new_variables(width);
+    const bvt constant = bv_utils.build_constant(factor, width);
+
+    const bvt unsigned_product =
+      bv_utils.multiplier(x, constant, bv_utilst::representationt::UNSIGNED);
+    const bvt signed_product =
+      bv_utils.multiplier(constant, x, bv_utilst::representationt::SIGNED);
+
+    for(const unsigned value : {0u, 1u, 2u, 5u, 0x7fu, 0x80u, 0xa3u, 0xffu})
+    {
+      REQUIRE(
+        evaluate(cnf, x, value, unsigned_product) == ((value * factor) & mask));
+      REQUIRE(
+        evaluate(cnf, x, value, signed_product) == ((value * factor) & mask));
+    }
+  }
+}
+
+SCENARIO(
+  "bv_utilst shifts by constant distances",
+  "[core][solvers][flattening][bv_utils]")
+{
+  const std::size_t width = 8;
+
+  for(const unsigned distance : {0u, 1u, 3u, 7u, 8u, 9u, 13u})
+  {
+    clause_listt cnf(null_message_handler);
+    bv_utilst bv_utils(cnf);
+    const bvt x = cnf.new_variables(width);
+    const bvt constant = bv_utils.build_constant(distance, 4);
+
+    for(const auto s : {bv_utilst::shiftt::SHIFT_LEFT,
+                        bv_utilst::shiftt::SHIFT_LRIGHT,
+                        bv_utilst::shiftt::SHIFT_ARIGHT,
+                        bv_utilst::shiftt::ROTATE_LEFT,
+                        bv_utilst::shiftt::ROTATE_RIGHT})
+    {
+      const std::size_t variables = cnf.no_variables();
+      const bvt shifted = bv_utils.shift(x, s, constant);
+
+      // the bits of x are rewired
+      REQUIRE(cnf.no_variables() == variables);
+
+      const std::size_t expected_distance =
+        s == bv_utilst::shiftt::ROTATE_LEFT ||
+            s == bv_utilst::shiftt::ROTATE_RIGHT
+          ? distance % width
+          : std::min<std::size_t>(distance, width);
+      REQUIRE(shifted == bv_utils.shift(x, s, expected_distance));
+    }
+  }
+}
@@ -120,6 +120,60 @@ SCENARIO("byte_extract_lowering", "[core][solvers][lowering][byte_extract]")
     }
   }
 
+  GIVEN("An aligned byte_extract of an element of an array of structs")
+  {
+    const unsignedbv_typet u32(32);
+    const struct_typet s({{"a", u32}, {"b", u32}});
+    const symbol_exprt array(
+      "array", array_typet(s, from_integer(4, size_type())));
+    const byte_extract_exprt be1(
+      ID_byte_extract_little_endian,
+      array,
+      from_integer(20, index_type()),
+      u32);
+
+    THEN("byte_extract lowering yields the member of the element")
+    {
+      const member_exprt expected(
+        index_exprt(array, from_integer(2, size_type())), "b", u32);
+
+      REQUIRE(lower_byte_extract(be1, ns) == expected);
+
+      byte_extract_exprt be2 = be1;
+      be2.id(ID_byte_extract_big_endian);
+      REQUIRE(lower_byte_extract(be2, ns) == expected);
+    }
+
+    THEN("unaligned and out-of-bounds extracts use the general lowering")
+    {
+      byte_extract_exprt be2 = be1;
+      be2.offset() = from_integer(22, index_type());
+      const exprt lower_be2 = lower_byte_extract(be2, ns);
+      REQUIRE(!has_subexpr(lower_be2, ID_byte_extract_little_endian));
+      REQUIRE(lower_be2.id() != ID_member);
+
+      be2.offset() = from_integer(32, index_type());
+      REQUIRE(lower_byte_extract(be2, ns).id() != ID_index);
+    }
+
+    THEN("an offset that is one of two constants yields a case for each")
+    {
+      const symbol_exprt c("c", bool_typet());
+      byte_extract_exprt be2 = be1;
+      be2.offset() = if_exprt(
+        c, from_integer(4, index_type()), from_integer(20, index_type()));
+
+      const if_exprt expected(
+        c,
+        member_exprt(
+          index_exprt(array, from_integer(0, size_type())), "b", u32),
+        member_exprt(
+          index_exprt(array, from_integer(2, size_type())), "b", u32));
+
+      REQUIRE(lower_byte_extract(be2, ns) == expected);
+    }
+  }
+
   GIVEN("A collection of types")
   {
     unsignedbv_typet u8(8);
@@ -270,6 +324,52 @@ SCENARIO("byte_update_lowering", "[core][solvers][lowering][byte_update]")
     }
   }
 
+  GIVEN("An aligned byte_update of an element of an array of structs")
+  {
+    const unsignedbv_typet u32(32);
+    const struct_typet s({{"a", u32}, {"b", u32}});
+    const symbol_exprt array(
+      "array", array_typet(s, from_integer(4, size_type())));
+    const exprt value = from_integer(0x42, u32);
+    const byte_update_exprt bu1(
+      ID_byte_update_little_endian,
+      array,
+      from_integer(20, index_type()),
+      value);
+
+    THEN("byte_update lowering updates the member of the element")
+    {
+      const exprt index = from_integer(2, size_type());
+      with_exprt updated_element(
+        index_exprt(array, index), exprt(ID_member_name), value);
+      updated_element.where().set(ID_component_name, "b");
+      const with_exprt expected(array, index, updated_element);
+
+      REQUIRE(lower_byte_operators(bu1, ns) == expected);
+
+      byte_update_exprt bu2 = bu1;
+      bu2.id(ID_byte_update_big_endian);
+      REQUIRE(lower_byte_operators(bu2, ns) == expected);
+    }
+
+    THEN("an offset that is one of two constants yields a case for each")
+    {
+      const symbol_exprt c("c", bool_typet());
+      byte_update_exprt bu2 = bu1;
+      bu2.offset() = typecast_exprt(
+        if_exprt(c, from_integer(0, size_type()), from_integer(8, size_type())),
+        index_type());
+
+      const exprt lower_bu2 = lower_byte_operators(bu2, ns);
+
+      REQUIRE(lower_bu2.id() == ID_if);
+      REQUIRE(to_if_expr(lower_bu2).cond() == c);
+      REQUIRE(to_if_expr(lower_bu2).true_case().id() == ID_with);
+      REQUIRE(to_if_expr(lower_bu2).false_case().id() == ID_with);
+      REQUIRE(!has_subexpr(lower_bu2, ID_byte_update_little_endian));
+    }
+  }
+
   GIVEN("A collection of types")
   {
     unsignedbv_typet u8(8);
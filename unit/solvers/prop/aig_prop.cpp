@@ -0,0 +1,131 @@
+/*******************************************************************\
+
+Module: Unit tests for aig_prop_solvert
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for aig_prop_solvert
+
+#include <testing-utils/use_catch.h>
+
+#include <solvers/prop/aig_prop.h>
+#include <solvers/sat/cnf_clause_list.h>
+#include <util/make_unique.h>
+
+/// Clause list whose assignment is set by the test
+class clause_listt : public cnf_clause_list_assignmentt
+{
+public:
+  explicit clause_listt(message_handlert &message_handler)
+    : cnf_clause_list_assignmentt(message_handler)
+  {
+  }
+
+  void set_assignment(literalt a, bool value) override
+  {
+    assignment.resize(no_variables());
+    assignment[a.var_no()] = tvt(value != a.sign());
+  }
+
+  bool is_in_conflict(literalt) const override
+  {
+    UNREACHABLE;
+  }
+};
+
+SCENARIO("aig_prop_solvert", "[core][solvers][prop][aig_prop]")
+{
+  null_message_handlert message_handler;
+  auto clause_list_ptr = util_make_unique<clause_listt>(message_handler);
+  clause_listt &clause_list = *clause_list_ptr;
+  aig_prop_solvert aig(std::move(clause_list_ptr), message_handler);
+
+  const literalt a = aig.new_variable();
+  const literalt b = aig.new_variable();
+  const literalt c = aig.new_variable();
+
+  GIVEN("Structurally equal conjunctions")
+  {
+    THEN("They are represented by the same node")
+    {
+      REQUIRE(aig.land(a, b) == aig.land(b, a));
+      REQUIRE(aig.lor(a, !b) == !aig.land(!a, b));
+      REQUIRE(aig.number_of_and_nodes() == 2);
+    }
+  }
+
+  GIVEN("Conjunctions that can be rewritten")
+  {
+    const literalt a_and_b = aig.land(a, b);
+
+    THEN("Contradictions and repetitions are removed")
+    {
+      REQUIRE(aig.land(a_and_b, !a) == const_literal(false));
+      REQUIRE(aig.land(a_and_b, aig.land(!b, c)) == const_literal(false));
+      REQUIRE(aig.land(a_and_b, b) == a_and_b);
+      REQUIRE(aig.land(!a_and_b, !a) == !a);
+      REQUIRE(aig.land(!a_and_b, a) == aig.land(a, !b));
+    }
+  }
+
+  GIVEN("Gates that are not constrained")
+  {
+    const literalt x = aig.lxor(aig.land(a, b), c);
+    aig.lselect(a, b, x);
+
+    THEN("No clauses are generated")
+    {
+      REQUIRE(clause_list.no_clauses() == 0);
+      REQUIRE(aig.number_of_converted_nodes() == 3);
+    }
+
+    THEN("Constraining a gate only converts what it depends on")
+    {
+      aig.lcnf({x});
+      // a & b, and a single exclusive-or
+      REQUIRE(aig.number_of_converted_nodes() == 5);
+      REQUIRE(clause_list.no_clauses() == 3 + 4 + 1);
+    }
+  }
+
+  GIVEN("A conjunction that is set to true")
+  {
+    aig.l_set_to_true(aig.land(aig.land(a, b), c));
+
+    THEN("Each conjunct is set to true")
+    {
+      REQUIRE(aig.number_of_converted_nodes() == 3);
+      REQUIRE(clause_list.no_clauses() == 3);
+    }
+  }
+
+  GIVEN("A disjunction that is set to true")
+  {
+    aig.l_set_to_true(aig.lor(aig.lor(a, b), c));
+
+    THEN("A single clause is generated")
+    {
+      REQUIRE(aig.number_of_converted_nodes() == 3);
+      REQUIRE(clause_list.no_clauses() == 1);
+      REQUIRE(clause_list.get_clauses().front().size() == 3);
+    }
+  }
+
+  GIVEN("A satisfying assignment of the variables")
+  {
+    const literalt x = aig.lselect(a, aig.lxor(b, c), aig.land(b, c));
+    aig.set_assignment(a, true);
+    aig.set_assignment(b, true);
+    aig.set_assignment(c, false);
+
+    THEN("Gates that were not converted are evaluated")
+    {
+      REQUIRE(aig.l_get(x).is_true());
+      REQUIRE(aig.l_get(aig.land(b, c)).is_false());
+      REQUIRE(aig.l_get(!aig.lxor(b, c)).is_false());
+    }
+  }
+}
@@ -0,0 +1,111 @@
+/*******************************************************************\
+
+Module: Unit tests for prop_minimizet
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for prop_minimizet
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <solvers/prop/literal_expr.h>
+#include <solvers/prop/prop_conv_solver.h>
+#include <solvers/prop/prop_minimize.h>
+#include <solvers/sat/satcheck.h>
+
+SCENARIO("prop_minimize", "[core][solvers][prop][prop_minimize]")
+{
+  satcheckt satcheck(null_message_handler);
+  prop_conv_solvert solver(satcheck, null_message_handler);
+
+  // a || b, where a is the more expensive one
+  const literalt a = satcheck.new_variable();
+  const literalt b = satcheck.new_variable();
+  satcheck.l_set_to_true(satcheck.lor(a, b));
+
+  REQUIRE(solver() == decision_proceduret::resultt::D_SATISFIABLE);
+
+  prop_minimizet prop_minimize(solver, null_message_handler);
+  prop_minimize.objective(a, 2);
+  prop_minimize.objective(b, 1);
+
+  GIVEN("The incremental mode")
+  {
+    prop_minimize.set_incremental(true);
+    prop_minimize();
+
+    THEN("The cheapest model is found")
+    {
+      REQUIRE(!prop_minimize.timed_out());
+      REQUIRE(prop_minimize.number_satisfied() == 1);
+      REQUIRE(satcheck.l_get(a).is_false());
+      REQUIRE(satcheck.l_get(b).is_true());
+    }
+
+    THEN("The formula is unchanged once the assumptions are popped")
+    {
+      solver.pop();
+      solver.push({literal_exprt(a)});
+      REQUIRE(solver() == decision_proceduret::resultt::D_SATISFIABLE);
+    }
+  }
+
+  GIVEN("A deadline that has passed")
+  {
+    prop_minimize.set_incremental(true);
+    prop_minimize.set_deadline(std::chrono::steady_clock::now());
+    prop_minimize();
+
+    THEN("Minimization stops with a model of the formula")
+    {
+      REQUIRE(prop_minimize.timed_out());
+      REQUIRE(prop_minimize.iterations() == 0);
+      REQUIRE((satcheck.l_get(a).is_true() || satcheck.l_get(b).is_true()));
+      solver.pop();
+    }
+  }
+}
+
+SCENARIO(
+  "prop_minimize_core_guided",
+  "[core][solvers][prop][prop_minimize]")
+{
+  satcheckt satcheck(null_message_handler);
+  prop_conv_solvert solver(satcheck, null_message_handler);
+
+  // (a || b) && (c || d), with all of them equally expensive
+  const literalt a = satcheck.new_variable();
+  const literalt b = satcheck.new_variable();
+  const literalt c = satcheck.new_variable();
+  const literalt d = satcheck.new_variable();
+  satcheck.l_set_to_true(satcheck.lor(a, b));
+  satcheck.l_set_to_true(satcheck.lor(c, d));
+
+  REQUIRE(solver() == decision_proceduret::resultt::D_SATISFIABLE);
+
+  prop_minimizet prop_minimize(solver, null_message_handler);
+  prop_minimize.objective(a);
+  prop_minimize.objective(b);
+  prop_minimize.objective(c);
+  prop_minimize.objective(d);
+
+  GIVEN("The core-guided mode")
+  {
+    prop_minimize.set_incremental(true);
+    prop_minimize.set_core_guided(true);
+    prop_minimize();
+
+    THEN("A cheapest model is found")
+    {
+      REQUIRE(!prop_minimize.timed_out());
+      REQUIRE(prop_minimize.number_satisfied() == 2);
+      REQUIRE(satcheck.l_get(a) != satcheck.l_get(b));
+      REQUIRE(satcheck.l_get(c) != satcheck.l_get(d));
+      solver.pop();
+    }
+  }
+}
@@ -0,0 +1,59 @@
+/*******************************************************************\
+
+Module: Unit tests for dimacs_cnf_streamt
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for dimacs_cnf_streamt
+
+#include <testing-utils/use_catch.h>
+
+#include <solvers/sat/dimacs_cnf.h>
+#include <util/message.h>
+
+#include <sstream>
+
+SCENARIO("dimacs_cnf_streamt", "[core][solvers][sat][dimacs_cnf_stream]")
+{
+  null_message_handlert message_handler;
+  std::stringstream out;
+  dimacs_cnf_streamt dimacs(out, message_handler);
+
+  GIVEN("Clauses that are added one by one")
+  {
+    const literalt a = dimacs.new_variable();
+    const literalt b = dimacs.new_variable();
+    dimacs.lcnf(bvt{a, b});
+    dimacs.lcnf(bvt{!a, const_literal(false)});
+    dimacs.lcnf(bvt{a, const_literal(true)});
+
+    THEN("They are written immediately")
+    {
+      REQUIRE(dimacs.no_clauses() == 2);
+      REQUIRE(out.str().find("1 2 0\n-1 0\n") != std::string::npos);
+    }
+
+    THEN("The problem line is updated in place")
+    {
+      const std::size_t size = out.str().size();
+      dimacs.finish();
+      out << "c end\n";
+
+      std::string line;
+      std::getline(out.seekg(0), line);
+      std::istringstream problem_line(line);
+      std::string p, cnf;
+      std::size_t variables, clauses;
+      problem_line >> p >> cnf >> variables >> clauses;
+
+      REQUIRE(p == "p");
+      REQUIRE(cnf == "cnf");
+      REQUIRE(variables == 2);
+      REQUIRE(clauses == 2);
+      REQUIRE(out.str().size() == size + 6);
+    }
+  }
+}
@@ -0,0 +1,223 @@
+/*******************************************************************\
+
+Module: Unit tests for sat_portfoliot
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for sat_portfoliot
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <solvers/sat/sat_portfolio.h>
+#include <util/make_unique.h>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+#ifdef HAVE_MINISAT2
+#  include <solvers/sat/satcheck_minisat2.h>
+
+SCENARIO("sat_portfolio", "[core][solvers][sat][sat_portfolio]")
+{
+  null_message_handlert message_handler;
+  sat_portfoliot portfolio(message_handler);
+  portfolio.add_solver(
+    util_make_unique<satcheck_minisat_no_simplifiert>(message_handler));
+  portfolio.add_solver(
+    util_make_unique<satcheck_minisat_simplifiert>(message_handler));
+
+  const literalt a = portfolio.new_variable();
+  const literalt b = portfolio.new_variable();
+  portfolio.l_set_to_true(portfolio.lxor(a, b));
+
+  GIVEN("A satisfiable formula")
+  {
+    THEN("The model satisfies it")
+    {
+      REQUIRE(portfolio.prop_solve() == propt::resultt::P_SATISFIABLE);
+      REQUIRE(portfolio.l_get(a) != portfolio.l_get(b));
+    }
+  }
+
+  GIVEN("Assumptions that contradict the formula")
+  {
+    portfolio.set_frozen(a);
+    portfolio.set_frozen(b);
+    portfolio.set_assumptions({a, b});
+
+    THEN("It is unsatisfiable under the assumptions only")
+    {
+      REQUIRE(portfolio.prop_solve() == propt::resultt::P_UNSATISFIABLE);
+      REQUIRE((portfolio.is_in_conflict(a) || portfolio.is_in_conflict(b)));
+
+      portfolio.set_assumptions({});
+      REQUIRE(portfolio.prop_solve() == propt::resultt::P_SATISFIABLE);
+    }
+  }
+}
+
+SCENARIO(
+  "satcheck_minisat2 reports fixed literals",
+  "[core][solvers][sat][sat_portfolio]")
+{
+  satcheck_minisat_no_simplifiert solver(null_message_handler);
+  const literalt a = solver.new_variable();
+  const literalt b = solver.new_variable();
+  const literalt c = solver.new_variable();
+  solver.lcnf({!a});
+  solver.lcnf({a, b});
+  solver.lcnf({b, c});
+
+  REQUIRE(solver.prop_solve() == propt::resultt::P_SATISFIABLE);
+
+  // b follows from the clauses, c does not
+  const bvt fixed = solver.get_fixed_literals();
+  REQUIRE(std::find(fixed.begin(), fixed.end(), !a) != fixed.end());
+  REQUIRE(std::find(fixed.begin(), fixed.end(), b) != fixed.end());
+  REQUIRE(std::find(fixed.begin(), fixed.end(), c) == fixed.end());
+  REQUIRE(std::find(fixed.begin(), fixed.end(), !c) == fixed.end());
+}
+
+#endif
+
+/// Solver that records the clauses it is given. It either fails at once,
+/// runs out of time having fixed the literals in \ref fixed, or finds a
+/// model.
+class scripted_solvert : public cnf_solvert
+{
+public:
+  enum class behaviourt
+  {
+    FAIL,
+    TIME_OUT,
+    ANSWER
+  };
+
+  explicit scripted_solvert(behaviourt behaviour)
+    : cnf_solvert(null_message_handler), behaviour(behaviour)
+  {
+  }
+
+  const std::string solver_text() override
+  {
+    return "scripted solver";
+  }
+
+  void lcnf(const bvt &bv) override
+  {
+    clauses.push_back(bv);
+    clause_counter++;
+  }
+
+  tvt l_get(literalt) const override
+  {
+    return tvt::unknown();
+  }
+
+  void set_assignment(literalt, bool) override
+  {
+    UNREACHABLE;
+  }
+
+  bool is_in_conflict(literalt) const override
+  {
+    return false;
+  }
+
+  void set_time_limit_seconds(uint32_t seconds) override
+  {
+    time_limit_seconds = seconds;
+  }
+
+  bvt get_fixed_literals() const override
+  {
+    return fixed;
+  }
+
+  bool is_eliminated(literalt l) const override
+  {
+    return std::find(eliminated.begin(), eliminated.end(), l.var_no()) !=
+           eliminated.end();
+  }
+
+  behaviourt behaviour;
+  std::vector<bvt> clauses;
+  bvt fixed;
+  std::vector<unsigned> eliminated;
+
+protected:
+  uint32_t time_limit_seconds = 0;
+
+  resultt do_prop_solve() override
+  {
+    switch(behaviour)
+    {
+    case behaviourt::FAIL:
+      return resultt::P_ERROR;
+    case behaviourt::TIME_OUT:
+      std::this_thread::sleep_for(std::chrono::seconds(time_limit_seconds));
+      return resultt::P_ERROR;
+    case behaviourt::ANSWER:
+      return resultt::P_SATISFIABLE;
+    }
+
+    UNREACHABLE;
+  }
+};
+
+SCENARIO(
+  "sat_portfolio shares unit clauses",
+  "[core][solvers][sat][sat_portfolio]")
+{
+  sat_portfoliot portfolio(null_message_handler);
+
+  auto failing_solver =
+    util_make_unique<scripted_solvert>(scripted_solvert::behaviourt::FAIL);
+  auto timing_out_solver =
+    util_make_unique<scripted_solvert>(scripted_solvert::behaviourt::TIME_OUT);
+  auto answering_solver =
+    util_make_unique<scripted_solvert>(scripted_solvert::behaviourt::ANSWER);
+  scripted_solvert &failing = *failing_solver;
+  scripted_solvert &timing_out = *timing_out_solver;
+  scripted_solvert &answering = *answering_solver;
+  portfolio.add_solver(std::move(failing_solver));
+  portfolio.add_solver(std::move(timing_out_solver));
+  portfolio.add_solver(std::move(answering_solver));
+
+  const literalt a = portfolio.new_variable();
+  const literalt b = portfolio.new_variable();
+  const literalt c = portfolio.new_variable();
+  portfolio.lcnf({a, b, c});
+
+  GIVEN("A solver that runs out of time having fixed some literals")
+  {
+    timing_out.fixed = {a, !b, c};
+    answering.eliminated = {c.var_no()};
+    answering.clauses.clear();
+    failing.clauses.clear();
+
+    REQUIRE(portfolio.prop_solve() == propt::resultt::P_SATISFIABLE);
+
+    THEN("Those not eliminated are given to solvers that have not failed")
+    {
+      REQUIRE(answering.clauses == std::vector<bvt>{{a}, {!b}});
+      REQUIRE(failing.clauses.empty());
+    }
+
+    WHEN("The solvers are run again")
+    {
+      answering.clauses.clear();
+      REQUIRE(portfolio.prop_solve() == propt::resultt::P_SATISFIABLE);
+
+      THEN("The same unit clauses are not shared again")
+      {
+        REQUIRE(answering.clauses.empty());
+      }
+    }
+  }
+}
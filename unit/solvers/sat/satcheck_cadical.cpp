@@ -0,0 +1,66 @@
+/*******************************************************************\
+
+Module: Unit tests for satcheck_cadical
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for satcheck_cadical
+
+#ifdef HAVE_CADICAL
+
+#  include <testing-utils/use_catch.h>
+
+#  include <solvers/prop/literal.h>
+#  include <solvers/sat/satcheck_cadical.h>
+#  include <util/cout_message.h>
+
+SCENARIO("satcheck_cadical", "[core][solvers][sat][satcheck_cadical]")
+{
+  console_message_handlert message_handler;
+
+  GIVEN("An unsatisfiable formula false implied by a")
+  {
+    satcheck_cadicalt satcheck(message_handler);
+    literalt a = satcheck.new_variable();
+    literalt b = satcheck.new_variable();
+    satcheck.set_frozen(a);
+    satcheck.set_frozen(b);
+    satcheck.l_set_to_true(satcheck.lor(!a, const_literal(false)));
+
+    THEN("the failed assumption is in conflict, and lifting it helps")
+    {
+      satcheck.set_assumptions({a, b});
+      REQUIRE(satcheck.prop_solve() == propt::resultt::P_UNSATISFIABLE);
+      REQUIRE(satcheck.is_in_conflict(a));
+      REQUIRE_FALSE(satcheck.is_in_conflict(b));
+
+      satcheck.set_assumptions({b});
+      REQUIRE(satcheck.prop_solve() == propt::resultt::P_SATISFIABLE);
+      REQUIRE(satcheck.l_get(b).is_true());
+    }
+
+    THEN("frozen variables can be constrained after solving")
+    {
+      REQUIRE(satcheck.prop_solve() == propt::resultt::P_SATISFIABLE);
+      satcheck.l_set_to_true(b);
+      satcheck.l_set_to_true(!b);
+      REQUIRE(satcheck.prop_solve() == propt::resultt::P_UNSATISFIABLE);
+    }
+  }
+
+  GIVEN("A new solver")
+  {
+    satcheck_cadicalt satcheck(message_handler);
+
+    THEN("only presets known to CaDiCaL are accepted")
+    {
+      REQUIRE(satcheck.set_preset("plain"));
+      REQUIRE_FALSE(satcheck.set_preset("no-such-preset"));
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,74 @@
+/*******************************************************************\
+
+Module: Unit tests for satcheck_ipasir_dynamict
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for satcheck_ipasir_dynamict
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <solvers/sat/satcheck_ipasir_dynamic.h>
+#include <util/exception_utils.h>
+#include <util/tempdir.h>
+
+#include <fstream>
+
+SCENARIO(
+  "satcheck_ipasir_dynamic",
+  "[core][solvers][sat][satcheck_ipasir_dynamic]")
+{
+  GIVEN("A library that does not exist")
+  {
+    temp_dirt temp_dir("testXXXXXX");
+    const std::string library = temp_dir("no-such-library.so");
+
+    THEN("Constructing the solver fails and names the library")
+    {
+      REQUIRE_THROWS_MATCHES(
+        satcheck_ipasir_dynamict(library, null_message_handler),
+        system_exceptiont,
+        Catch::Matchers::Predicate<system_exceptiont>(
+          [&library](const system_exceptiont &e) {
+            return e.what().find(
+                     "failed to load IPASIR library " + library) !=
+                   std::string::npos;
+          }));
+    }
+  }
+
+  GIVEN("A file that is not a shared library")
+  {
+    temp_dirt temp_dir("testXXXXXX");
+    const std::string library = temp_dir("not-a-library.so");
+    std::ofstream(library) << "p cnf 0 0\n";
+
+    THEN("Constructing the solver fails")
+    {
+      REQUIRE_THROWS_AS(
+        satcheck_ipasir_dynamict(library, null_message_handler),
+        system_exceptiont);
+    }
+  }
+
+#ifdef __linux__
+  GIVEN("A shared library that does not implement IPASIR")
+  {
+    THEN("Constructing the solver fails and names the missing function")
+    {
+      REQUIRE_THROWS_MATCHES(
+        satcheck_ipasir_dynamict("libc.so.6", null_message_handler),
+        system_exceptiont,
+        Catch::Matchers::Predicate<system_exceptiont>(
+          [](const system_exceptiont &e) {
+            return e.what() ==
+                   "IPASIR library does not provide ipasir_signature";
+          }));
+    }
+  }
+#endif
+}
@@ -0,0 +1,140 @@
+/*******************************************************************\
+
+Module: Unit tests for smt2_convt
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <solvers/smt2/smt2_conv.h>
+#include <solvers/smt2/smt2_parser.h>
+
+#include <util/arith_tools.h>
+#include <util/mathematical_expr.h>
+#include <util/namespace.h>
+#include <util/symbol_table.h>
+
+#include <sstream>
+
+static std::size_t
+count_occurrences(const std::string &text, const std::string &pattern)
+{
+  std::size_t count = 0;
+  for(auto pos = text.find(pattern); pos != std::string::npos;
+      pos = text.find(pattern, pos + 1))
+  {
+    ++count;
+  }
+  return count;
+}
+
+TEST_CASE("smt2_convt shares subterms", "[core][solvers][smt2][smt2_conv]")
+{
+  symbol_tablet symbol_table;
+  namespacet ns(symbol_table);
+  std::ostringstream out;
+
+  const unsignedbv_typet type(32);
+  const symbol_exprt x("x", type);
+  const symbol_exprt y("y", type);
+  const symbol_exprt z("z", type);
+  const plus_exprt sum(x, y);
+  const mult_exprt product(sum, sum);
+
+  // a DAG whose tree is exponentially larger
+  exprt dag = product;
+  for(std::size_t i = 0; i < 10; ++i)
+    dag = plus_exprt(dag, dag);
+
+  {
+    smt2_convt smt2_conv(
+      ns, "", "", "QF_BV", smt2_convt::solvert::GENERIC, out);
+
+    smt2_conv.set_to_true(equal_exprt(dag, z));
+    smt2_conv.set_to_true(binary_relation_exprt(product, ID_lt, z));
+    smt2_conv.set_to_true(
+      binary_relation_exprt(sum, ID_gt, from_integer(3, type)));
+
+    const symbol_exprt bound("i", type);
+    smt2_conv.set_to_true(forall_exprt(
+      bound, binary_relation_exprt(plus_exprt(bound, x), ID_ge, sum)));
+  }
+
+  const std::string text = out.str();
+
+  SECTION("Subterms shared by assertions are defined once")
+  {
+    REQUIRE(count_occurrences(text, "(define-fun shared.") == 2);
+    REQUIRE(count_occurrences(text, "(bvadd |x| |y|)") == 3);
+  }
+
+  SECTION("Subterms shared within an assertion are bound by let")
+  {
+    REQUIRE(text.size() < 4096);
+    REQUIRE(count_occurrences(text, "(let ") > 10);
+  }
+
+  SECTION("The output is well-formed")
+  {
+    std::istringstream in(text);
+    smt2_parsert parser(in);
+    REQUIRE_NOTHROW(parser.parse());
+  }
+}
+
+TEST_CASE(
+  "smt2_convt keeps arrays in the array theory",
+  "[core][solvers][smt2][smt2_conv]")
+{
+  symbol_tablet symbol_table;
+  namespacet ns(symbol_table);
+  std::ostringstream out;
+
+  const unsignedbv_typet index_type(64);
+  const unsignedbv_typet element_type(8);
+  const array_typet array_type(element_type, from_integer(16, index_type));
+  const symbol_exprt index("index", index_type);
+  const symbol_exprt argument("argument", index_type);
+
+  const array_of_exprt array_of(from_integer(7, element_type), array_type);
+  const array_comprehension_exprt array_comprehension(
+    argument, typecast_exprt(argument, element_type), array_type);
+  const array_typet bool_array_type(bool_typet(), from_integer(4, index_type));
+
+  SECTION("Constant arrays and lambdas")
+  {
+    smt2_convt smt2_conv(ns, "", "", "", smt2_convt::solvert::Z3, out);
+    smt2_conv.set_to_true(equal_exprt(
+      index_exprt(array_of, index), from_integer(7, element_type)));
+    smt2_conv.set_to_true(equal_exprt(
+      index_exprt(array_comprehension, index), from_integer(3, element_type)));
+
+    const std::string text = out.str();
+    REQUIRE(
+      text.find("((as const (Array (_ BitVec 64) (_ BitVec 8))) (_ bv7 8))") !=
+      std::string::npos);
+    REQUIRE(
+      text.find("(lambda ((|argument| (_ BitVec 64))) ((_ extract 7 0) "
+                "|argument|))") != std::string::npos);
+    REQUIRE(text.find("declare-fun |argument|") == std::string::npos);
+  }
+
+  SECTION("Array comprehensions constrained by a quantifier")
+  {
+    smt2_convt smt2_conv(ns, "", "", "", smt2_convt::solvert::GENERIC, out);
+    smt2_conv.set_to_true(equal_exprt(
+      index_exprt(array_comprehension, index), from_integer(3, element_type)));
+    smt2_conv.set_to_true(
+      index_exprt(array_of_exprt(true_exprt(), bool_array_type), index));
+
+    const std::string text = out.str();
+    REQUIRE(
+      text.find("(assert (forall ((|argument| (_ BitVec 64))) (= (select "
+                "array_comprehension.0 |argument|)") != std::string::npos);
+    REQUIRE(text.find("(assert (= (select array_of.1 |index|) #b1))") !=
+            std::string::npos);
+    REQUIRE(text.find("declare-fun |argument|") == std::string::npos);
+  }
+}
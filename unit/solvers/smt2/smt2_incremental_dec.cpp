@@ -0,0 +1,128 @@
+/*******************************************************************\
+
+Module: Unit tests for smt2_incremental_dect
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for smt2_incremental_dect
+
+#include <testing-utils/message.h>
+#include <testing-utils/use_catch.h>
+
+#include <solvers/smt2/smt2_incremental_dec.h>
+
+#include <util/namespace.h>
+#include <util/symbol_table.h>
+#include <util/tempdir.h>
+
+#include <fstream>
+#include <sstream>
+
+/// Session that runs a shell script in place of a solver. The script logs
+/// each command it receives to \p log_file. It answers `unsat` to
+/// `check-sat-assuming`, `sat` to `check-sat` and `true` to `get-value`.
+class scripted_incremental_dect : public smt2_incremental_dect
+{
+public:
+  scripted_incremental_dect(const namespacet &ns, std::string log_file)
+    : smt2_incremental_dect(ns, "", "", "QF_AUFBV", solvert::Z3),
+      log_file(std::move(log_file))
+  {
+    set_message_handler(null_message_handler);
+  }
+
+protected:
+  std::string log_file;
+
+  std::vector<std::string> solver_command(const std::string &) const override
+  {
+    return {"sh",
+            "-c",
+            "echo started >> \"$0\"\n"
+            "while IFS= read -r line; do\n"
+            "  echo \"$line\" >> \"$0\"\n"
+            "  case \"$line\" in\n"
+            "  '(check-sat-assuming'*) echo unsat ;;\n"
+            "  '(check-sat)'*) echo sat ;;\n"
+            "  '(get-value ('*)\n"
+            "    id=${line#'(get-value ('}\n"
+            "    echo \"((${id%'))'} true))\" ;;\n"
+            "  esac\n"
+            "done",
+            log_file};
+  }
+};
+
+static std::size_t
+count_lines(const std::string &file_name, const std::string &prefix)
+{
+  std::ifstream in(file_name);
+  std::size_t count = 0;
+  for(std::string line; std::getline(in, line);)
+  {
+    if(line.compare(0, prefix.size(), prefix) == 0)
+      ++count;
+  }
+  return count;
+}
+
+SCENARIO(
+  "smt2_incremental_dect keeps one solver process",
+  "[core][solvers][smt2][smt2_incremental_dec]")
+{
+  if(!smt2_incremental_dect::is_supported(smt2_dect::solvert::Z3))
+    return;
+
+  temp_dirt temp_dir("testXXXXXX");
+  const std::string log_file = temp_dir("solver.log");
+  symbol_tablet symbol_table;
+  namespacet ns(symbol_table);
+  const symbol_exprt x("x", bool_typet());
+  const symbol_exprt y("y", bool_typet());
+
+  scripted_incremental_dect solver(ns, log_file);
+  solver.set_to_true(x);
+
+  GIVEN("A problem without contexts")
+  {
+    REQUIRE(solver() == decision_proceduret::resultt::D_SATISFIABLE);
+    REQUIRE(solver.get(x) == true_exprt());
+
+    WHEN("Another assertion is added and the solver is called again")
+    {
+      solver.set_to_true(y);
+      REQUIRE(solver() == decision_proceduret::resultt::D_SATISFIABLE);
+
+      THEN("The same process only receives the new assertion")
+      {
+        REQUIRE(count_lines(log_file, "started") == 1);
+        REQUIRE(count_lines(log_file, "(check-sat)") == 2);
+        REQUIRE(count_lines(log_file, "(assert |x|)") == 1);
+        REQUIRE(count_lines(log_file, "(assert |y|)") == 1);
+      }
+    }
+  }
+
+  GIVEN("An assertion made in a context")
+  {
+    solver.push();
+    solver.set_to_true(y);
+
+    THEN("The context literal is assumed until the context is popped")
+    {
+      REQUIRE(solver() == decision_proceduret::resultt::D_UNSATISFIABLE);
+      REQUIRE(count_lines(log_file, "(check-sat-assuming") == 1);
+
+      solver.pop();
+      REQUIRE(solver() == decision_proceduret::resultt::D_SATISFIABLE);
+      REQUIRE(count_lines(log_file, "(check-sat)") == 1);
+      REQUIRE(count_lines(log_file, "started") == 1);
+
+      // the assertion is guarded rather than asserted unconditionally
+      REQUIRE(count_lines(log_file, "(assert |y|)") == 0);
+    }
+  }
+}
@@ -242,5 +242,47 @@ SCENARIO("string refinement", "[core][solvers][strings][string_refinement]")
         REQUIRE(numeric_cast_v<char>(to_constant_expr(elements[9])) == 'c');
       }
     }
+
+    WHEN(
+      "length1 == 10 and 'b' == string_char_at({length1, pointer1}, 9)"
+      " is solved, and then 'c' == string_char_at({length1, pointer1}, 3)"
+      " is added")
+    {
+      solver.set_to(equal_exprt{length1, from_integer(10, int_type)}, true);
+      solver.set_to(
+        equal_exprt{
+          from_integer('b', char_type),
+          function_application_exprt{
+            char_at_function,
+            std::vector<exprt>{string_expr, from_integer(9, int_type)}}},
+        true);
+      REQUIRE(
+        solver.dec_solve() == decision_proceduret::resultt::D_SATISFIABLE);
+
+      solver.set_to(
+        equal_exprt{
+          from_integer('c', char_type),
+          function_application_exprt{
+            char_at_function,
+            std::vector<exprt>{string_expr, from_integer(3, int_type)}}},
+        true);
+
+      THEN(
+        "The second call also finds a model, in which array1 has length 10 and"
+        " contains 'c' at position 3 and 'b' at position 9")
+      {
+        auto result = solver.dec_solve();
+        REQUIRE(result == decision_proceduret::resultt::D_SATISFIABLE);
+        const exprt array_model = solver.get(array1);
+        REQUIRE(can_cast_expr<array_exprt>(array_model));
+        const std::vector<exprt> &elements =
+          to_array_expr(array_model).operands();
+        REQUIRE(elements.size() == 10);
+        REQUIRE(elements[3].is_constant());
+        REQUIRE(numeric_cast_v<char>(to_constant_expr(elements[3])) == 'c');
+        REQUIRE(elements[9].is_constant());
+        REQUIRE(numeric_cast_v<char>(to_constant_expr(elements[9])) == 'b');
+      }
+    }
   }
 }
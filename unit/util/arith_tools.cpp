@@ -0,0 +1,51 @@
+/*******************************************************************\
+
+Module: Unit tests for arith_tools.h
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/mp_arith.h>
+
+TEST_CASE(
+  "bit-vector representation of integers",
+  "[core][util][arith_tools]")
+{
+  REQUIRE(integer2bvrep(0, 8) == ID_0);
+  REQUIRE(integer2bvrep(255, 8) == "FF");
+  REQUIRE(integer2bvrep(256, 8) == ID_0);
+  REQUIRE(integer2bvrep(-1, 8) == "FF");
+  REQUIRE(integer2bvrep(-1, 64) == "FFFFFFFFFFFFFFFF");
+  REQUIRE(integer2bvrep(-1, 65) == "1FFFFFFFFFFFFFFFF");
+  REQUIRE(integer2bvrep(power(2, 64), 64) == ID_0);
+  REQUIRE(integer2bvrep(0x1234ABCD, 32) == "1234ABCD");
+
+  REQUIRE(bvrep2integer("FF", 8, false) == 255);
+  REQUIRE(bvrep2integer("FF", 8, true) == -1);
+  REQUIRE(bvrep2integer("80", 8, true) == -128);
+  REQUIRE(bvrep2integer("7F", 8, true) == 127);
+  REQUIRE(bvrep2integer("1", 1, true) == -1);
+  REQUIRE(
+    bvrep2integer("FFFFFFFFFFFFFFFF", 64, false) == power(2, 64) - 1);
+  REQUIRE(bvrep2integer("8000000000000000", 64, true) == -power(2, 63));
+  REQUIRE(bvrep2integer("1FFFFFFFFFFFFFFFF", 65, true) == -1);
+
+  // round trips at and around the boundary of 64 bits
+  for(std::size_t width : {1, 7, 8, 31, 32, 63, 64, 65, 128})
+  {
+    const mp_integer max_unsigned = power(2, width) - 1;
+    const mp_integer min_signed = -power(2, width - 1);
+    const mp_integer max_signed = power(2, width - 1) - 1;
+
+    for(const mp_integer &value : {mp_integer(0), max_unsigned})
+      REQUIRE(
+        bvrep2integer(integer2bvrep(value, width), width, false) == value);
+
+    for(const mp_integer &value : {min_signed, mp_integer(0), max_signed})
+      REQUIRE(bvrep2integer(integer2bvrep(value, width), width, true) == value);
+  }
+}
@@ -0,0 +1,163 @@
+/*******************************************************************\
+
+Module: Unit tests for chunked_vector
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/chunked_vector.h>
+
+#include <string>
+
+TEST_CASE("Chunked vector appends", "[core][util][chunked_vector]")
+{
+  chunked_vectort<std::string, 2> v;
+  REQUIRE(v.empty());
+  REQUIRE(v.begin() == v.end());
+
+  v.emplace_back("a");
+  const std::string *first = &v.front();
+  auto first_it = v.begin();
+
+  v.push_back("b");
+  v.emplace_back(1, 'c');
+
+  REQUIRE(v.size() == 3);
+  REQUIRE(v[0] == "a");
+  REQUIRE(v[1] == "b");
+  REQUIRE(v[2] == "c");
+  REQUIRE(v.back() == "c");
+
+  // appending neither moves existing elements nor invalidates iterators
+  REQUIRE(&v.front() == first);
+  REQUIRE(&*first_it == first);
+
+  REQUIRE(v.end() - v.begin() == 3);
+  REQUIRE(*(v.begin() + 2) == "c");
+  REQUIRE(v.begin() < v.end());
+
+  std::string reversed;
+  for(auto it = v.rbegin(); it != v.rend(); ++it)
+    reversed += *it;
+  REQUIRE(reversed == "cba");
+
+  v.pop_back();
+  REQUIRE(v.size() == 2);
+  REQUIRE(v.back() == "b");
+
+  v.clear();
+  REQUIRE(v.empty());
+}
+
+TEST_CASE("Chunked vector copies", "[core][util][chunked_vector]")
+{
+  chunked_vectort<int, 2> v;
+  for(int i = 0; i < 3; ++i)
+    v.push_back(i);
+
+  chunked_vectort<int, 2> copy = v;
+  copy.push_back(3);
+  const int *last = &copy.back();
+  copy.push_back(4);
+
+  REQUIRE(v.size() == 3);
+  REQUIRE(copy.size() == 5);
+  REQUIRE(&copy[3] == last);
+  for(int i = 0; i < 5; ++i)
+    REQUIRE(copy[i] == i);
+}
+
+TEST_CASE("Chunked vector prepend", "[core][util][chunked_vector]")
+{
+  chunked_vectort<int, 2> v;
+  v.push_back(2);
+  v.push_back(3);
+
+  chunked_vectort<int, 2> front;
+  front.push_back(0);
+  front.push_back(1);
+
+  v.prepend(std::move(front));
+
+  REQUIRE(front.empty());
+  REQUIRE(v.size() == 4);
+  for(int i = 0; i < 4; ++i)
+    REQUIRE(v[i] == i);
+}
+
+TEST_CASE("Chunked vector moves", "[core][util][chunked_vector]")
+{
+  chunked_vectort<int, 2> v;
+  for(int i = 0; i < 3; ++i)
+    v.push_back(i);
+
+  auto it = v.begin() + 1;
+  const int *element = &*it;
+
+  SECTION("Move construction")
+  {
+    chunked_vectort<int, 2> moved{std::move(v)};
+
+    // iterators and references now refer to the new container
+    REQUIRE(v.empty());
+    REQUIRE(moved.size() == 3);
+    REQUIRE(&*it == element);
+    REQUIRE(it - moved.begin() == 1);
+    REQUIRE(it + 2 == moved.end());
+  }
+
+  SECTION("Move assignment")
+  {
+    chunked_vectort<int, 2> moved;
+    moved.push_back(10);
+    moved = std::move(v);
+
+    REQUIRE(v.empty());
+    REQUIRE(moved.size() == 3);
+    REQUIRE(*it == 1);
+    REQUIRE(it + 2 == moved.end());
+
+    // the moved-from container can be used again
+    v.push_back(4);
+    REQUIRE(v.size() == 1);
+    REQUIRE(v.back() == 4);
+  }
+}
+
+TEST_CASE("Chunked vector copies share chunks", "[core][util][chunked_vector]")
+{
+  chunked_vectort<int, 2> v;
+  for(int i = 0; i < 5; ++i)
+    v.push_back(i);
+
+  chunked_vectort<int, 2> copy = v;
+  const auto &const_v = v;
+  const auto &const_copy = copy;
+
+  // elements are shared until they are modified
+  REQUIRE(&const_copy[0] == &const_v[0]);
+  REQUIRE(&const_copy[4] == &const_v[4]);
+
+  copy[1] = 10;
+  copy.push_back(5);
+
+  REQUIRE(v[1] == 1);
+  REQUIRE(v.size() == 5);
+  REQUIRE(copy[1] == 10);
+  REQUIRE(copy[5] == 5);
+
+  // only the modified chunks have been copied
+  REQUIRE(&const_copy[0] != &const_v[0]);
+  REQUIRE(&const_copy[2] == &const_v[2]);
+  REQUIRE(&const_copy[4] != &const_v[4]);
+
+  v.pop_back();
+  REQUIRE(copy[4] == 4);
+
+  v.clear();
+  REQUIRE(copy.size() == 6);
+  REQUIRE(copy[2] == 2);
+}
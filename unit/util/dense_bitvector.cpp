@@ -0,0 +1,69 @@
+/*******************************************************************\
+
+Module: Unit tests for dense_bitvectort
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/dense_bitvector.h>
+
+static std::vector<std::size_t> elements(const dense_bitvectort &bitvector)
+{
+  std::vector<std::size_t> result;
+  bitvector.for_each([&result](std::size_t i) { result.push_back(i); });
+  return result;
+}
+
+TEST_CASE("dense_bitvectort insert and erase", "[core][util][dense_bitvector]")
+{
+  dense_bitvectort bitvector;
+  REQUIRE(bitvector.empty());
+
+  REQUIRE(bitvector.insert(3));
+  REQUIRE(!bitvector.insert(3));
+  REQUIRE(bitvector.insert(64));
+  REQUIRE(bitvector.insert(130));
+
+  REQUIRE(bitvector.contains(64));
+  REQUIRE(!bitvector.contains(65));
+  REQUIRE(!bitvector.contains(1000));
+  REQUIRE(elements(bitvector) == std::vector<std::size_t>{3, 64, 130});
+
+  REQUIRE(bitvector.erase(64));
+  REQUIRE(!bitvector.erase(64));
+  REQUIRE(!bitvector.erase(1000));
+  REQUIRE(elements(bitvector) == std::vector<std::size_t>{3, 130});
+
+  bitvector.erase(3);
+  bitvector.erase(130);
+  REQUIRE(bitvector.empty());
+}
+
+TEST_CASE("dense_bitvectort set operations", "[core][util][dense_bitvector]")
+{
+  dense_bitvectort a;
+  a.insert(1);
+  a.insert(63);
+
+  dense_bitvectort b;
+  b.insert(63);
+  b.insert(200);
+
+  REQUIRE(a != b);
+
+  REQUIRE(a.union_with(b));
+  REQUIRE(!a.union_with(b));
+  REQUIRE(elements(a) == std::vector<std::size_t>{1, 63, 200});
+
+  a.subtract(b);
+  REQUIRE(elements(a) == std::vector<std::size_t>{1});
+
+  // trailing empty words do not matter for equality
+  dense_bitvectort c;
+  c.insert(1);
+  REQUIRE(a == c);
+  REQUIRE(c == a);
+}
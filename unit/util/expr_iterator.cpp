@@ -100,4 +100,46 @@ SCENARIO("expr_iterator", "[core][utils][expr_iterator]")
       }
     }
   }
+
+  GIVEN("An expression deeper than the iterator keeps inline")
+  {
+    const symbol_exprt symbol("x", bool_typet());
+    const std::size_t depth = 2 * depth_iterator_stackt::inline_capacity;
+    exprt top = symbol;
+    for(std::size_t i = 0; i < depth; ++i)
+      top = not_exprt(top);
+
+    WHEN("Walking the expression")
+    {
+      std::size_t count = 0;
+      for(auto it = top.depth_cbegin(), itend = top.depth_cend(); it != itend;
+          ++it)
+      {
+        ++count;
+      }
+
+      THEN("We expect to visit all nodes")
+      {
+        REQUIRE(count == depth + 1);
+      }
+    }
+
+    WHEN("Replacing the innermost node")
+    {
+      for(auto it = top.depth_begin(), itend = top.depth_end(); it != itend;
+          ++it)
+      {
+        if(it->id() == ID_symbol)
+          it.mutate() = true_exprt();
+      }
+
+      THEN("We expect the replacement below all the negations")
+      {
+        const exprt *expr = &top;
+        for(std::size_t i = 0; i < depth; ++i)
+          expr = &to_not_expr(*expr).op();
+        REQUIRE(expr->is_true());
+      }
+    }
+  }
 }
@@ -0,0 +1,55 @@
+/*******************************************************************\
+
+Module: Unit tests for expr_util
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for commute_operands
+
+#include <testing-utils/use_catch.h>
+
+#include <util/expr_util.h>
+#include <util/std_expr.h>
+#include <util/std_types.h>
+
+TEST_CASE("commute_operands", "[core][util][expr_util]")
+{
+  const unsignedbv_typet type(8);
+  const symbol_exprt a("a", type);
+  const symbol_exprt b("b", type);
+
+  SECTION("Commutative operators have their operands swapped")
+  {
+    const auto commuted = commute_operands(plus_exprt(a, b));
+    REQUIRE(commuted.has_value());
+    REQUIRE(*commuted == plus_exprt(b, a));
+
+    REQUIRE(*commute_operands(mult_exprt(a, b)) == mult_exprt(b, a));
+    REQUIRE(*commute_operands(bitand_exprt(a, b)) == bitand_exprt(b, a));
+    REQUIRE(*commute_operands(equal_exprt(a, b)) == equal_exprt(b, a));
+    REQUIRE(*commute_operands(notequal_exprt(a, b)) == notequal_exprt(b, a));
+  }
+
+  SECTION("Other operators are left alone")
+  {
+    REQUIRE_FALSE(commute_operands(minus_exprt(a, b)).has_value());
+    REQUIRE_FALSE(commute_operands(binary_relation_exprt(a, ID_lt, b))
+                    .has_value());
+  }
+
+  SECTION("Operands of different types are left alone")
+  {
+    const symbol_exprt c("c", signedbv_typet(8));
+    REQUIRE_FALSE(commute_operands(plus_exprt(a, c)).has_value());
+  }
+
+  SECTION("Operators with more than two operands are left alone")
+  {
+    exprt sum = plus_exprt(a, b);
+    sum.add_to_operands(a);
+    REQUIRE_FALSE(commute_operands(sum).has_value());
+  }
+}
@@ -35,7 +35,11 @@ SCENARIO("irept_memory", "[core][utils][irept]")
       REQUIRE(sizeof(std::vector<int>) == 3 * sizeof(void *));
 #endif
 
-#ifndef NAMED_SUB_IS_FORWARD_LIST
+#if defined(NAMED_SUB_IS_SMALL_SORTED_MAP)
+      // the counts and two inline entries of a key and a pointer
+      const std::size_t named_size = sizeof(irept::named_subt);
+      REQUIRE(named_size == 2 * sizeof(std::uint32_t) + 4 * sizeof(void *));
+#elif !defined(NAMED_SUB_IS_FORWARD_LIST)
       const std::size_t named_size = sizeof(std::map<int, int>);
 #  ifndef _GLIBCXX_DEBUG
 #    ifdef __APPLE__
@@ -300,5 +304,28 @@ SCENARIO("irept_memory", "[core][utils][irept]")
       REQUIRE(irep1 == irep2);
       REQUIRE(!irep1.full_eq(irep2));
     }
+
+    THEN("Comparison takes cached hashes into account")
+    {
+      irep1.id("id");
+      irep1.set("#a_comment", 1);
+      irep2.id("id");
+      irep2.set("#a_comment", 2);
+
+      // hashes ignore comments
+      REQUIRE(irep1.hash() == irep2.hash());
+      REQUIRE(irep1 == irep2);
+
+      irep2.set("value", 2);
+      REQUIRE(irep1.hash() != irep2.hash());
+      REQUIRE(irep1 != irep2);
+      REQUIRE(!irep1.full_eq(irep2));
+
+      // modifying an irep discards its cached hash
+      irep2.remove("value");
+      REQUIRE(irep1 == irep2);
+      REQUIRE(irep1.hash() == irep2.hash());
+      REQUIRE(irep1.compare(irep2) == 0);
+    }
   }
 }
@@ -0,0 +1,95 @@
+/*******************************************************************\
+
+Module: Unit tests for irep_serializationt
+
+Author: Diffblue Ltd
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/exception_utils.h>
+#include <util/irep_serialization.h>
+
+#include <sstream>
+
+TEST_CASE("write_gb_word encoding", "[core][util][irep_serialization]")
+{
+  std::ostringstream out;
+  write_gb_word(out, 0);
+  write_gb_word(out, 127);
+  write_gb_word(out, 300);
+  REQUIRE(out.str() == std::string("\x00\x7f\xac\x02", 4));
+
+  std::istringstream in(out.str());
+  REQUIRE(irep_serializationt::read_gb_word(in) == 0);
+  REQUIRE(irep_serializationt::read_gb_word(in) == 127);
+  REQUIRE(irep_serializationt::read_gb_word(in) == 300);
+}
+
+TEST_CASE("write_gb_string escaping", "[core][util][irep_serialization]")
+{
+  const std::string s("a\\b\0c", 5);
+
+  std::ostringstream out;
+  write_gb_string(out, s);
+  REQUIRE(out.str() == std::string("a\\\\b\\\0c\0", 8));
+
+  irep_serializationt::ireps_containert ireps_container;
+  irep_serializationt serialization(ireps_container);
+  std::istringstream in(out.str());
+  REQUIRE(serialization.read_gb_string(in) == s);
+  REQUIRE(in.good());
+}
+
+TEST_CASE("truncated input", "[core][util][irep_serialization]")
+{
+  irep_serializationt::ireps_containert ireps_container;
+  irep_serializationt serialization(ireps_container);
+
+  SECTION("A word without its last byte")
+  {
+    std::istringstream in(std::string("\xac", 1));
+    REQUIRE_THROWS_AS(
+      irep_serializationt::read_gb_word(in), deserialization_exceptiont);
+  }
+
+  SECTION("A string without its terminator")
+  {
+    std::istringstream in("abc");
+    REQUIRE(serialization.read_gb_string(in) == "abc");
+    REQUIRE(in.fail());
+  }
+}
+
+TEST_CASE("irep round trip", "[core][util][irep_serialization]")
+{
+  irept shared("shared");
+  shared.set("value", "a\\b");
+
+  irept irep("root");
+  irep.get_sub().push_back(shared);
+  irep.get_sub().push_back(shared);
+  irep.set("name", "x");
+  irep.add("child") = shared;
+
+  std::ostringstream out;
+  {
+    irep_serializationt::ireps_containert ireps_container;
+    irep_serializationt serialization(ireps_container);
+    serialization.reference_convert(irep, out);
+    serialization.reference_convert(shared, out);
+    // root, shared and the leaves "x" and "a\\b" are written once each
+    REQUIRE(ireps_container.ireps_written == 4);
+  }
+
+  irep_serializationt::ireps_containert ireps_container;
+  irep_serializationt serialization(ireps_container);
+  std::istringstream in(out.str());
+  const irept read = serialization.reference_convert(in);
+  const irept read_shared = serialization.reference_convert(in);
+
+  REQUIRE(read == irep);
+  REQUIRE(read_shared == shared);
+  REQUIRE(in.peek() == std::char_traits<char>::eof());
+}
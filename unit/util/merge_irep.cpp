@@ -0,0 +1,27 @@
+/*******************************************************************\
+
+Module: Unit tests for merge_irep
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/merge_irep.h>
+
+TEST_CASE("merge_irept shares equal ireps", "[core][util][merge_irep]")
+{
+  merge_irept merge_irep;
+
+  irept a("a");
+  a.add("x").id("b");
+  irept a_copy("a");
+  a_copy.add("x").id("b");
+
+  REQUIRE(&a.read() != &a_copy.read());
+  merge_irep(a);
+  merge_irep(a_copy);
+  REQUIRE(&a.read() == &a_copy.read());
+  REQUIRE(merge_irep.size() != 0);
+}
@@ -0,0 +1,76 @@
+/*******************************************************************\
+
+Module: Unit tests for piped_processt
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+/// \file
+/// Unit tests for piped_processt
+
+#include <testing-utils/use_catch.h>
+
+#include <util/piped_process.h>
+
+#include <iterator>
+
+SCENARIO("piped_processt", "[core][util][piped_process]")
+{
+  if(!piped_processt::is_supported())
+    return;
+
+  GIVEN("A process that copies its input to its output")
+  {
+    piped_processt process({"cat"});
+    REQUIRE(process.started());
+
+    THEN("Input larger than the pipe buffers comes back unchanged")
+    {
+      // cat writes while we are still writing, which must not deadlock
+      std::string input;
+      for(std::size_t i = 0; input.size() < 4 * 1024 * 1024; ++i)
+        input += std::to_string(i) + '\n';
+
+      process.input() << input;
+      process.close_input();
+      REQUIRE(process.input().good());
+
+      const std::string output{std::istreambuf_iterator<char>(process.output()),
+                               std::istreambuf_iterator<char>()};
+      REQUIRE(output == input);
+      REQUIRE(process.wait() == 0);
+    }
+
+    THEN("Output can be read before the input is closed")
+    {
+      process.input() << "line\n" << std::flush;
+      std::string line;
+      REQUIRE(std::getline(process.output(), line));
+      REQUIRE(line == "line");
+      REQUIRE(process.wait() == 0);
+    }
+  }
+
+  GIVEN("A process that exits with an error")
+  {
+    piped_processt process({"sh", "-c", "exit 3"});
+    REQUIRE(process.started());
+
+    THEN("Its exit status is returned")
+    {
+      REQUIRE(process.wait() == 3);
+    }
+  }
+
+  GIVEN("An executable that does not exist")
+  {
+    piped_processt process({"no-such-executable-for-piped-process"});
+
+    THEN("The process is not started")
+    {
+      REQUIRE_FALSE(process.started());
+      REQUIRE(process.wait() == -1);
+    }
+  }
+}
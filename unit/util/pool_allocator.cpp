@@ -0,0 +1,54 @@
+/*******************************************************************\
+
+Module: Unit tests for pool_allocator
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/pool_allocator.h>
+
+#include <map>
+#include <vector>
+
+TEST_CASE("Fixed-size pools reuse blocks", "[core][util][pool_allocator]")
+{
+  // a block size that nothing else uses, such that the pool starts empty
+  typedef fixed_size_poolt<3 * sizeof(void *) + 1> poolt;
+  REQUIRE(poolt::size % alignof(void *) == 0);
+  REQUIRE(poolt::live_blocks() == 0);
+
+  std::vector<void *> blocks;
+  for(std::size_t i = 0; i < 2 * poolt::blocks_per_chunk; ++i)
+    blocks.push_back(poolt::allocate());
+  REQUIRE(poolt::live_blocks() == blocks.size());
+
+  void *last = blocks.back();
+  poolt::deallocate(last);
+  blocks.pop_back();
+  REQUIRE(poolt::allocate() == last);
+  blocks.push_back(last);
+
+  for(void *block : blocks)
+    poolt::deallocate(block);
+  REQUIRE(poolt::live_blocks() == 0);
+}
+
+TEST_CASE("Maps with pool allocators", "[core][util][pool_allocator]")
+{
+  std::map<int, int, std::less<int>, pool_allocatort<std::pair<const int, int>>>
+    map;
+
+  for(int i = 0; i < 1000; ++i)
+    map.emplace(i, -i);
+
+  REQUIRE(map.size() == 1000);
+  REQUIRE(map.at(999) == -999);
+
+  auto copy = map;
+  map.clear();
+  REQUIRE(copy.size() == 1000);
+  REQUIRE(copy.at(500) == -500);
+}
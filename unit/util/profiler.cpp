@@ -0,0 +1,70 @@
+/*******************************************************************\
+
+Module: Unit tests for profiler
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/profiler.h>
+
+#include <sstream>
+
+TEST_CASE("Profiler collects nested phases", "[core][util][profiler]")
+{
+  profilert profiler;
+  REQUIRE(!profiler.is_enabled());
+
+  profiler.enable(true);
+  REQUIRE(profiler.is_enabled());
+
+  profiler.begin("outer", "a", true);
+  for(int i = 0; i < 3; ++i)
+  {
+    profiler.begin("inner", "b", false);
+    profiler.end();
+  }
+  const auto start = profilert::clockt::now();
+  while(profilert::clockt::now() - start < profilert::min_event_duration)
+  {
+  }
+  profiler.end();
+
+  const auto &statistics = profiler.get_statistics();
+  REQUIRE(statistics.size() == 2);
+
+  const auto &outer = statistics.at({"outer", "a"});
+  const auto &inner = statistics.at({"inner", "b"});
+  REQUIRE(outer.count == 1);
+  REQUIRE(inner.count == 3);
+  REQUIRE(outer.duration >= inner.duration);
+  REQUIRE(inner.memory_delta == 0);
+
+  // only phases that took long enough are recorded as events
+  REQUIRE(profiler.get_events().size() == 1);
+  REQUIRE(profiler.get_events().front().name == "a");
+
+  std::ostringstream json;
+  profiler.output_json(json);
+  REQUIRE(json.str().find("\"name\": \"b\"") != std::string::npos);
+  REQUIRE(json.str().find("\"count\": 3") != std::string::npos);
+
+  std::ostringstream trace;
+  profiler.output_trace(trace);
+  REQUIRE(trace.str().find("\"traceEvents\"") != std::string::npos);
+  REQUIRE(trace.str().find("\"ph\": \"X\"") != std::string::npos);
+}
+
+TEST_CASE("Profile scopes are no-ops when disabled", "[core][util][profiler]")
+{
+  if(get_profiler().is_enabled())
+    return;
+
+  {
+    profile_scopet scope("test", "disabled");
+  }
+
+  REQUIRE(get_profiler().get_statistics().empty());
+}
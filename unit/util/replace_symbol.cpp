@@ -104,3 +104,29 @@ TEST_CASE("Replace always", "[core][util][replace_symbol]")
   REQUIRE(to_array_type(index_expr.array().type()).size() == c);
   REQUIRE(index_expr.index() == c);
 }
+
+TEST_CASE("Replace in shared subexpressions", "[core][util][replace_symbol]")
+{
+  const symbol_exprt s1("a", typet("some_type"));
+  const symbol_exprt s2("b", typet("some_type"));
+  const exprt other_expr("other", typet("some_type"));
+
+  // a DAG whose unshared tree would have 2^depth leaves
+  const std::size_t depth = 64;
+  exprt unchanged = s2;
+  for(std::size_t i = 0; i < depth; ++i)
+    unchanged = binary_exprt(unchanged, "binary", unchanged, s2.type());
+
+  binary_exprt binary(unchanged, "binary", s1, s2.type());
+  const binary_exprt original = binary;
+
+  replace_symbolt r;
+  r.insert(s1, other_expr);
+
+  REQUIRE(!r.replace(binary));
+  REQUIRE(binary.op1() == other_expr);
+  REQUIRE(&binary.op0().read() == &unchanged.read());
+  REQUIRE(original.op1() == s1);
+
+  REQUIRE(r.replace(unchanged));
+}
@@ -10,6 +10,7 @@ Author: Daniel Poetzl
 #define SN_INTERNAL_CHECKS
 
 #include <climits>
+#include <map>
 #include <random>
 #include <set>
 
@@ -262,6 +263,31 @@ void sharing_map_internals_test()
       REQUIRE(delta_view[0].k == (1 << (2 * chunk)));
     }
   }
+
+  SECTION("bulk assignment shape")
+  {
+    std::set<const void *> marked;
+    const std::size_t chunk = sharing_map_unsignedt::chunk;
+
+    std::vector<std::pair<unsigned, std::string>> elements;
+    for(unsigned i = 0; i < 100; i++)
+      elements.emplace_back(i << chunk, std::to_string(i));
+    elements.emplace_back(1, "a");
+
+    sharing_map_unsignedt sm1;
+    for(const auto &element : elements)
+      sm1.insert(element.first, element.second);
+
+    sharing_map_unsignedt sm2;
+    sm2.assign(elements.begin(), elements.end());
+
+    REQUIRE(
+      sm1.count_unmarked_nodes(false, marked, false) ==
+      sm2.count_unmarked_nodes(false, marked, false));
+    REQUIRE(
+      sm1.count_unmarked_nodes(true, marked, false) ==
+      sm2.count_unmarked_nodes(true, marked, false));
+  }
 }
 
 TEST_CASE("Sharing map internals test", "[core][util]")
@@ -480,6 +506,64 @@ TEST_CASE("Sharing map collisions", "[core][util]")
   }
 }
 
+TEST_CASE("Sharing map bulk assignment", "[core][util]")
+{
+  typedef sharing_mapt<std::size_t, std::string, false, key_hasht>
+    sharing_map_collisionst;
+
+  std::map<std::size_t, std::string> elements;
+  for(std::size_t i = 0; i < 20; i++)
+    elements[i] = std::to_string(i);
+
+  SECTION("Collisions")
+  {
+    sharing_map_collisionst sm;
+    sm.insert(100, "x");
+
+    sm.assign(elements.begin(), elements.end());
+
+    REQUIRE(sm.size() == elements.size());
+    REQUIRE(!sm.has_key(100));
+
+    for(const auto &element : elements)
+    {
+      auto r = sm.find(element.first);
+      REQUIRE(r);
+      REQUIRE(r->get() == element.second);
+    }
+
+    sm.erase(4);
+    sm.insert(20, "20");
+    REQUIRE(sm.size() == elements.size());
+    REQUIRE(!sm.has_key(4));
+    REQUIRE(sm.has_key(20));
+  }
+
+  SECTION("Moving values")
+  {
+    std::vector<std::pair<irep_idt, std::string>> v{{"i", "0"}, {"j", "1"}};
+
+    sharing_map_standardt sm;
+    sm.assign(
+      std::make_move_iterator(v.begin()), std::make_move_iterator(v.end()));
+
+    REQUIRE(sm.size() == 2);
+    REQUIRE(sm.find("i")->get() == "0");
+    REQUIRE(sm.find("j")->get() == "1");
+  }
+
+  SECTION("Empty range")
+  {
+    sharing_map_standardt sm;
+    fill(sm);
+
+    std::vector<std::pair<irep_idt, std::string>> v;
+    sm.assign(v.begin(), v.end());
+
+    REQUIRE(sm.empty());
+  }
+}
+
 TEST_CASE("Sharing map views and iteration", "[core][util]")
 {
   SECTION("View of empty map")
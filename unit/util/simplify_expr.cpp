@@ -84,6 +84,32 @@ TEST_CASE("Simplify byte extract", "[core][util]")
   REQUIRE(simp == s);
 }
 
+TEST_CASE("Simplify byte extract from array_of", "[core][util]")
+{
+  cmdlinet cmdline;
+  config.set(cmdline);
+
+  symbol_tablet symbol_table;
+  namespacet ns(symbol_table);
+
+  // a zero-initialized buffer of 1MB, extracting from the end must not build
+  // the bits up to the offset
+  const array_typet buffer_type(
+    unsigned_char_type(), from_integer(1 << 20, size_type()));
+  const array_of_exprt buffer(
+    from_integer(0x12, unsigned_char_type()), buffer_type);
+
+  const byte_extract_exprt be(
+    byte_extract_id(),
+    buffer,
+    from_integer((1 << 20) - 2, index_type()),
+    unsignedbv_typet(16));
+
+  const exprt simp = simplify_expr(be, ns);
+
+  REQUIRE(simp == from_integer(0x1212, unsignedbv_typet(16)));
+}
+
 TEST_CASE("expr2bits and bits2expr respect bit order", "[core][util]")
 {
   symbol_tablet symbol_table;
@@ -0,0 +1,61 @@
+/*******************************************************************\
+
+Module: Unit tests of the simplifier result cache
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/arith_tools.h>
+#include <util/namespace.h>
+#include <util/simplify_expr.h>
+#include <util/simplify_expr_cache.h>
+#include <util/std_expr.h>
+#include <util/symbol_table.h>
+
+TEST_CASE("Simplifier results are cached", "[core][util][simplify_expr_cache]")
+{
+  symbol_tablet symbol_table;
+  namespacet ns(symbol_table);
+  simplify_expr_cachet cache(2);
+
+  const signedbv_typet type(32);
+  const symbol_exprt x("x", type);
+  const plus_exprt x_plus_zero(x, from_integer(0, type));
+
+  exprt expr = x_plus_zero;
+  REQUIRE_FALSE(simplify(expr, ns, cache));
+  REQUIRE(expr == x);
+  REQUIRE(cache.get_statistics().misses == 1);
+  REQUIRE(cache.get_statistics().hits == 0);
+
+  SECTION("A repeated simplification is answered from the cache")
+  {
+    exprt again = x_plus_zero;
+    REQUIRE_FALSE(simplify(again, ns, cache));
+    REQUIRE(again == x);
+    REQUIRE(cache.get_statistics().hits == 1);
+  }
+
+  SECTION("Unchanged expressions are reported as unchanged on a hit")
+  {
+    exprt symbol = x;
+    REQUIRE(simplify(symbol, ns, cache));
+    REQUIRE(simplify(symbol, ns, cache));
+    REQUIRE(symbol == x);
+    REQUIRE(cache.get_statistics().hits == 1);
+  }
+
+  SECTION("The least recently used entry is evicted")
+  {
+    exprt a = plus_exprt(x, from_integer(1, type));
+    exprt b = plus_exprt(x, from_integer(2, type));
+    simplify(a, ns, cache);
+    simplify(b, ns, cache);
+    REQUIRE(cache.size() == 2);
+    REQUIRE(cache.get_statistics().evictions == 1);
+    REQUIRE(cache.find(x_plus_zero) == nullptr);
+  }
+}
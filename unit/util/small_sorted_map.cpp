@@ -0,0 +1,67 @@
+/*******************************************************************\
+
+Module: Unit tests for small_sorted_map
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/small_sorted_map.h>
+
+#include <string>
+
+TEST_CASE("Small sorted map", "[core][util][small_sorted_map]")
+{
+  small_sorted_mapt<int, std::string> map;
+  REQUIRE(map.empty());
+
+  map[3] = "three";
+  const std::string &three = map[3];
+  REQUIRE(map.emplace(1, "one").second);
+  REQUIRE(!map.emplace(1, "uno").second);
+
+  // more elements than are stored inline
+  for(int i = 10; i > 3; --i)
+    map[i] = std::to_string(i);
+
+  REQUIRE(map.size() == 9);
+  REQUIRE(map.find(1)->second == "one");
+  REQUIRE(map.find(2) == map.end());
+  REQUIRE(map.find(7)->second == "7");
+
+  // references to elements are stable
+  REQUIRE(&three == &map[3]);
+  REQUIRE(three == "three");
+
+  // elements are ordered by key
+  int previous = 0;
+  for(const auto &entry : map)
+  {
+    REQUIRE(previous < entry.first);
+    previous = entry.first;
+  }
+
+  REQUIRE(map.erase(3) == 1);
+  REQUIRE(map.erase(3) == 0);
+  REQUIRE(map.size() == 8);
+  REQUIRE(map.find(3) == map.end());
+
+  small_sorted_mapt<int, std::string> copy = map;
+  REQUIRE(copy.size() == map.size());
+  REQUIRE(copy.find(10)->second == "10");
+  REQUIRE(&copy.find(10)->second != &map.find(10)->second);
+
+  small_sorted_mapt<int, std::string> small{{2, "two"}};
+  small.swap(copy);
+  REQUIRE(small.size() == 8);
+  REQUIRE(copy.size() == 1);
+  REQUIRE(copy.find(2)->second == "two");
+
+  copy = std::move(small);
+  REQUIRE(copy.size() == 8);
+  copy.clear();
+  REQUIRE(copy.empty());
+  REQUIRE(copy.find(1) == copy.end());
+}
@@ -83,6 +83,19 @@ TEST_CASE("Set level", "[unit][util][ssa_expr]")
       REQUIRE(ssa.get_identifier() == "sym#7");
       REQUIRE(ssa.get_l1_object_identifier() == "sym");
     }
+
+    WHEN("set_level_2 repeatedly after set_level_0 and set_level_1")
+    {
+      ssa.set_level_0(1);
+      ssa.set_level_1(3);
+      ssa.set_level_2(7);
+      ssa.set_level_2(8);
+      REQUIRE(ssa.get_level_2() == "8");
+      REQUIRE(ssa.get_identifier() == "sym!1@3#8");
+      REQUIRE(ssa.get_l1_object_identifier() == "sym!1@3");
+      ssa.remove_level_2();
+      REQUIRE(ssa.get_identifier() == "sym!1@3");
+    }
   }
 }
 
@@ -0,0 +1,54 @@
+/*******************************************************************\
+
+Module: Unit tests for string_container
+
+Author: Diffblue Ltd.
+
+\*******************************************************************/
+
+#include <testing-utils/use_catch.h>
+
+#include <util/dstring.h>
+#include <util/irep_ids.h>
+#include <util/string_container.h>
+
+#include <string>
+#include <vector>
+
+TEST_CASE("String container numbering", "[core][util][string_container]")
+{
+  string_containert &container = get_string_container();
+
+  // the empty string and the irep ids are numbered first
+  REQUIRE(container[""] == 0);
+  REQUIRE(container["nil"] == ID_nil.get_no());
+  REQUIRE(container.get_string(ID_nil.get_no()) == "nil");
+
+  const std::size_t size_before = container.size();
+
+  // enough strings to need further chunks of the number table
+  std::vector<unsigned> numbers;
+  for(unsigned i = 0; i < 100000; ++i)
+    numbers.push_back(container["string_container_test_" + std::to_string(i)]);
+
+  REQUIRE(container.size() == size_before + numbers.size());
+
+  for(unsigned i = 0; i < numbers.size(); ++i)
+  {
+    const std::string s = "string_container_test_" + std::to_string(i);
+    // numbers are handed out in order and do not change
+    REQUIRE(numbers[i] == size_before + i);
+    REQUIRE(container[s] == numbers[i]);
+    REQUIRE(container.get_string(numbers[i]) == s);
+  }
+
+  // strings do not move
+  const char *first = container.c_str(numbers.front());
+  container["string_container_test_x"];
+  REQUIRE(container.c_str(numbers.front()) == first);
+
+  // strings with embedded zeros are distinct from their prefixes
+  const std::string with_zero("string_container\0test", 21);
+  REQUIRE(container[with_zero] != container["string_container"]);
+  REQUIRE(container.get_string(container[with_zero]) == with_zero);
+}
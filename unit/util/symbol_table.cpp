@@ -411,3 +411,57 @@ TEST_CASE("symbol_tablet::lookup_ref invariant", "[core][utils][symbol_tablet]")
     invariant_failedt,
     invariant_failure_containing("`bar' must exist in the symbol table."));
 }
+
+TEST_CASE(
+  "symbol_tablet::lookup_indexed follows changes",
+  "[core][utils][symbol_tablet]")
+{
+  symbol_tablet symbol_table;
+  symbolt foo_symbol;
+  foo_symbol.name = "foo";
+  symbol_table.insert(foo_symbol);
+
+  REQUIRE(symbol_table.lookup_indexed("foo") == symbol_table.lookup("foo"));
+  REQUIRE(symbol_table.lookup_indexed("bar") == nullptr);
+
+  symbolt bar_symbol;
+  bar_symbol.name = "bar";
+  symbol_table.insert(bar_symbol);
+  REQUIRE(symbol_table.lookup_indexed("bar") == symbol_table.lookup("bar"));
+
+  symbol_table.remove("foo");
+  REQUIRE(symbol_table.lookup_indexed("foo") == nullptr);
+
+  symbol_tablet other;
+  other.swap(symbol_table);
+  REQUIRE(symbol_table.lookup_indexed("bar") == nullptr);
+  REQUIRE(other.lookup_indexed("bar") == other.lookup("bar"));
+
+  other.clear();
+  REQUIRE(other.lookup_indexed("bar") == nullptr);
+}
+
+TEST_CASE("symbol_tablet::reserve", "[core][utils][symbol_tablet]")
+{
+  symbol_tablet symbol_table;
+  symbolt first;
+  first.name = "first";
+  first.base_name = "first";
+  symbol_table.insert(first);
+
+  symbol_table.reserve(100);
+  const std::size_t bucket_count = symbol_table.symbols.bucket_count();
+
+  for(std::size_t i = 1; i < 100; ++i)
+  {
+    symbolt symbol;
+    symbol.name = "symbol" + std::to_string(i);
+    symbol.base_name = symbol.name;
+    symbol_table.insert(std::move(symbol));
+  }
+
+  REQUIRE(symbol_table.symbols.size() == 100);
+  REQUIRE(symbol_table.symbols.bucket_count() == bucket_count);
+  REQUIRE(symbol_table.symbol_base_map.count("symbol99") == 1);
+  REQUIRE(symbol_table.lookup_ref("first").base_name == "first");
+}